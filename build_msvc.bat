@@ -33,7 +33,12 @@ set SRC= ^
 ..\tools\vol2obj\main.c ^
 ..\lib\vol_av.c ^
 ..\lib\vol_basis.cpp ^
+..\lib\vol_cache.c ^
 ..\lib\vol_geom.c ^
+..\lib\vol_image.c ^
+..\lib\vol_mesh.c ^
+..\lib\vol_thread.c ^
+..\lib\vol_trace.c ^
 ..\thirdparty\basis_universal\transcoder\basisu_transcoder.cpp
 
 cl %COMPILER_FLAGS% %SRC% %I% /link %LINKER_FLAGS% %LIBS%
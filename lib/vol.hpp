@@ -0,0 +1,439 @@
+/**  @file vol.hpp
+ * Volograms C++ API
+ *
+ * vol.hpp   | Header-only C++17 wrapper of vol_geom and vol_av, with RAII handles and frame views.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C++17
+ * Files     | 1
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * `vol::Sequence` owns an opened vologram and `vol::VideoDecoder` owns an opened texture video.
+ * Both are move-only, and free their C resources in their destructors, so `vol_geom_free_file_info()` and `vol_av_close()` are never called by hand.
+ * Opening returns a `std::optional`, which is empty on failure, so the wrapper works with exceptions disabled.
+ *
+ *     auto seq = vol::Sequence::open( "counter.vols" );
+ *     if ( !seq ) { return; }
+ *     for ( const vol::FrameView& frame : seq->frames() ) {
+ *       upload( frame.positions(), frame.normals(), frame.uvs(), frame.indices16() );
+ *     }
+ *     if ( seq->failed() ) { ... }
+ *
+ * A `vol::FrameView` points into buffers owned by its Sequence, so it is valid until the next frame is read, or the Sequence is moved or destroyed.
+ * Every view is complete: frames that aren't keyframes have their keyframe's indices and UVs, which the Sequence keeps from the last keyframe read.
+ *
+ * Per-frame cost
+ * --------------
+ * The buffers are allocated when a Sequence is opened, so reading frames, and iterating, do no heap allocation of their own.
+ * Everything is inline and non-virtual, so a loop over `frames()` is the same `vol_geom_read_frame()` calls and pointer arithmetic as the C,
+ * plus the copies below.
+ * Playback containers (.volp) are kept open and read with `vol_geom_read_frame_from_io()`. Other volograms are read by `vol_geom_read_frame()`,
+ * which opens the sequence file for each frame when streaming, and the C library allocates its FILE. Open multi-file volograms with `preload`
+ * to avoid that.
+ *
+ * Alignment
+ * ---------
+ * Arrays in .vols frames start wherever the previous array ended, so are often not aligned for their type, e.g. a frame's positions start
+ * 13 bytes into its data. Spans of floats and indices must point at aligned memory, so the Sequence copies them where needed:
+ * each keyframe's arrays are copied to 16-byte aligned places in the Sequence's keyframe buffer, as it's kept anyway, and a tracked frame's
+ * positions and normals are copied to another aligned buffer only if they are misaligned where vol_geom read them.
+ *
+ * Spans
+ * -----
+ * `vol::Span` is `std::span` when building as C++20 or later. For C++17 it is a minimal stand-in with the same names for the parts used here.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#include "vol_av.h"
+#include "vol_geom.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#if __cplusplus >= 202002L && defined( __has_include )
+#if __has_include( <span>)
+#include <span>
+#define VOL_HPP_STD_SPAN
+#endif
+#endif
+
+namespace vol {
+
+#ifdef VOL_HPP_STD_SPAN
+template <typename T> using Span = std::span<T>;
+#else
+/** A pointer and a count of elements. The subset of `std::span` used by this header. */
+template <typename T> class Span {
+public:
+  constexpr Span() noexcept = default;
+  constexpr Span( T* data_ptr, std::size_t n ) noexcept : _data_ptr( data_ptr ), _n( n ) {}
+  constexpr T* data() const noexcept { return _data_ptr; }
+  constexpr std::size_t size() const noexcept { return _n; }
+  constexpr std::size_t size_bytes() const noexcept { return _n * sizeof( T ); }
+  constexpr bool empty() const noexcept { return 0 == _n; }
+  constexpr T* begin() const noexcept { return _data_ptr; }
+  constexpr T* end() const noexcept { return _data_ptr + _n; }
+  constexpr T& operator[]( std::size_t i ) const noexcept { return _data_ptr[i]; }
+
+private:
+  T* _data_ptr   = nullptr;
+  std::size_t _n = 0;
+};
+#endif
+
+/** One frame's mesh, as views into its Sequence's buffers. Valid until the Sequence reads another frame, or is moved or destroyed. */
+class FrameView {
+public:
+  /** Frame index, starting at 0. */
+  uint32_t index() const noexcept { return _index; }
+  /** True for keyframes, which carry the indices and UVs that the frames after them use. */
+  bool is_keyframe() const noexcept { return _keyframe; }
+  uint32_t vertex_count() const noexcept { return _positions_sz / ( 3 * sizeof( float ) ); }
+
+  /** x,y,z floats for each vertex. */
+  Span<const float> positions() const noexcept { return { reinterpret_cast<const float*>( _positions_ptr ), _positions_sz / sizeof( float ) }; }
+  /** x,y,z floats for each vertex, or empty if the vologram has no normals. */
+  Span<const float> normals() const noexcept { return { reinterpret_cast<const float*>( _normals_ptr ), _normals_sz / sizeof( float ) }; }
+  /** u,v floats for each vertex. From the frame's keyframe. */
+  Span<const float> uvs() const noexcept { return { reinterpret_cast<const float*>( _uvs_ptr ), _uvs_sz / sizeof( float ) }; }
+
+  /** Indices are 32-bit if the mesh has 65535 or more vertices, as in the .vols spec, otherwise 16-bit. */
+  bool has_32bit_indices() const noexcept { return vertex_count() >= 65535; }
+  /** Triangle list indices. From the frame's keyframe. Empty if the indices are 32-bit. */
+  Span<const uint16_t> indices16() const noexcept {
+    if ( has_32bit_indices() ) { return {}; }
+    return { reinterpret_cast<const uint16_t*>( _indices_ptr ), _indices_sz / sizeof( uint16_t ) };
+  }
+  /** Triangle list indices. From the frame's keyframe. Empty if the indices are 16-bit. */
+  Span<const uint32_t> indices32() const noexcept {
+    if ( !has_32bit_indices() ) { return {}; }
+    return { reinterpret_cast<const uint32_t*>( _indices_ptr ), _indices_sz / sizeof( uint32_t ) };
+  }
+
+  /** The frame's Basis Universal texture, for v1.3 volograms with per-frame textures. Otherwise empty. See vol_basis.h. */
+  Span<const uint8_t> texture() const noexcept { return { _texture_ptr, _texture_sz }; }
+
+private:
+  friend class Sequence;
+  const uint8_t *_positions_ptr = nullptr, *_normals_ptr = nullptr, *_uvs_ptr = nullptr, *_indices_ptr = nullptr, *_texture_ptr = nullptr;
+  uint32_t _positions_sz = 0, _normals_sz = 0, _uvs_sz = 0, _indices_sz = 0, _texture_sz = 0;
+  uint32_t _index        = 0;
+  bool _keyframe         = false;
+};
+
+/** An opened vologram. Move-only. Create with `Sequence::open()`. */
+class Sequence {
+public:
+  /** Open a single-file vologram: a v1.3 .vols, or a playback container.
+   * @returns Empty on failure. vol_geom logs the reason.
+   */
+  static std::optional<Sequence> open( const char* vols_filename ) {
+    Sequence seq;
+    if ( !vols_filename || !vol_geom_create_file_info_from_file( vols_filename, &seq._info ) ) { return std::nullopt; }
+    seq._opened = true;
+    if ( !seq._init( vols_filename ) ) { return std::nullopt; }
+    return std::optional<Sequence>( std::move( seq ) );
+  }
+
+  /** Open a multi-file vologram, from before v1.3.
+   * @param preload If true then the whole sequence file is read into memory now, so reading frames does no file I/O.
+   * @returns       Empty on failure. vol_geom logs the reason.
+   */
+  static std::optional<Sequence> open( const char* hdr_filename, const char* seq_filename, bool preload = false ) {
+    Sequence seq;
+    if ( !hdr_filename || !seq_filename || !vol_geom_create_file_info( hdr_filename, seq_filename, &seq._info, !preload ) ) { return std::nullopt; }
+    seq._opened = true;
+    if ( !seq._init( seq_filename ) ) { return std::nullopt; }
+    return std::optional<Sequence>( std::move( seq ) );
+  }
+
+  Sequence( const Sequence& )            = delete;
+  Sequence& operator=( const Sequence& ) = delete;
+  Sequence( Sequence&& other ) noexcept { _take( other ); }
+  Sequence& operator=( Sequence&& other ) noexcept {
+    if ( this != &other ) {
+      _release();
+      _take( other );
+    }
+    return *this;
+  }
+  ~Sequence() { _release(); }
+
+  /** The vologram's header and directory, for anything not wrapped here. */
+  const vol_geom_info_t& info() const noexcept { return _info; }
+  uint32_t frame_count() const noexcept { return _info.hdr.frame_count; }
+  /** Frames per second from the header, or 30 for volograms before v1.3, which have no frame rate. */
+  double fps() const noexcept { return _info.hdr.fps > 0.0f ? static_cast<double>( _info.hdr.fps ) : 30.0; }
+  bool is_keyframe( uint32_t frame_idx ) const noexcept { return vol_geom_is_keyframe( &_info, frame_idx ); }
+
+  /** Read a frame, and its keyframe first if that isn't the last keyframe read. Reading frames in order only reads each keyframe once.
+   * @returns False on a read error or an out-of-range `frame_idx`, in which case `frame` is unchanged.
+   */
+  bool read( uint32_t frame_idx, FrameView& frame ) noexcept {
+    int key_idx = vol_geom_find_previous_keyframe( &_info, frame_idx );
+    if ( key_idx < 0 || frame_idx >= frame_count() ) { return false; }
+    bool has_texture = _info.hdr.textured && _info.hdr.texture_compression > 0;
+    if ( key_idx != _key_idx ) {
+      _key_idx                       = -1;
+      vol_geom_frame_data_t key_data = vol_geom_frame_data_t{};
+      if ( !_read_frame( static_cast<uint32_t>( key_idx ), key_data ) ) { return false; }
+      const uint8_t* blob_ptr   = key_data.block_data_ptr;
+      uint8_t* dst_ptr          = _align16( _key_buf_ptr.get() );
+      _key_frame._index         = static_cast<uint32_t>( key_idx );
+      _key_frame._keyframe      = true;
+      _key_frame._positions_ptr = _copy_aligned( &blob_ptr[key_data.vertices_offset], key_data.vertices_sz, dst_ptr );
+      _key_frame._positions_sz  = key_data.vertices_sz;
+      _key_frame._normals_ptr   = _copy_aligned( &blob_ptr[key_data.normals_offset], key_data.normals_sz, dst_ptr );
+      _key_frame._normals_sz    = key_data.normals_sz;
+      _key_frame._uvs_ptr       = _copy_aligned( &blob_ptr[key_data.uvs_offset], key_data.uvs_sz, dst_ptr );
+      _key_frame._uvs_sz        = key_data.uvs_sz;
+      _key_frame._indices_ptr   = _copy_aligned( &blob_ptr[key_data.indices_offset], key_data.indices_sz, dst_ptr );
+      _key_frame._indices_sz    = key_data.indices_sz;
+      _key_frame._texture_sz    = has_texture ? key_data.texture_sz : 0;
+      _key_frame._texture_ptr   = has_texture ? _copy_aligned( &blob_ptr[key_data.texture_offset], _key_frame._texture_sz, dst_ptr ) : nullptr;
+      _key_idx                  = key_idx;
+    }
+    if ( static_cast<uint32_t>( key_idx ) == frame_idx ) {
+      frame = _key_frame;
+      return true;
+    }
+
+    // Tracked frames are used where vol_geom read them, unless their positions or normals need copying to be aligned for floats.
+    vol_geom_frame_data_t frame_data = vol_geom_frame_data_t{};
+    if ( !_read_frame( frame_idx, frame_data ) ) { return false; }
+    const uint8_t* blob_ptr = frame_data.block_data_ptr;
+    uint8_t* dst_ptr        = _align16( _frame_buf_ptr.get() );
+    frame                   = _key_frame;
+    frame._index            = frame_idx;
+    frame._keyframe         = false;
+    frame._positions_ptr    = _aligned_or_copy( &blob_ptr[frame_data.vertices_offset], frame_data.vertices_sz, dst_ptr );
+    frame._positions_sz     = frame_data.vertices_sz;
+    frame._normals_ptr      = _aligned_or_copy( &blob_ptr[frame_data.normals_offset], frame_data.normals_sz, dst_ptr );
+    frame._normals_sz       = frame_data.normals_sz;
+    frame._texture_ptr      = has_texture ? &blob_ptr[frame_data.texture_offset] : nullptr;
+    frame._texture_sz       = has_texture ? frame_data.texture_sz : 0;
+    return true;
+  }
+
+  /** As `read( frame_idx, frame )`, returning the frame. Empty on a read error. */
+  std::optional<FrameView> read( uint32_t frame_idx ) noexcept {
+    FrameView frame;
+    if ( !read( frame_idx, frame ) ) { return std::nullopt; }
+    return frame;
+  }
+
+  /** True if iteration with `frames()` stopped early on a read error. */
+  bool failed() const noexcept { return _failed; }
+
+  /** Input iterator over frames. Incrementing reads the next frame. A read error ends iteration, and sets the Sequence's `failed()`. */
+  class Iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = FrameView;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const FrameView*;
+    using reference         = const FrameView&;
+
+    Iterator() noexcept = default;
+    reference operator*() const noexcept { return _frame; }
+    pointer operator->() const noexcept { return &_frame; }
+    Iterator& operator++() noexcept {
+      _idx++;
+      _read_or_end();
+      return *this;
+    }
+    void operator++( int ) noexcept { ++*this; }
+    bool operator==( const Iterator& other ) const noexcept { return _idx == other._idx; }
+    bool operator!=( const Iterator& other ) const noexcept { return _idx != other._idx; }
+
+  private:
+    friend class Sequence;
+    Iterator( Sequence* seq_ptr, uint32_t idx, uint32_t end_idx ) noexcept : _seq_ptr( seq_ptr ), _idx( idx ), _end_idx( end_idx ) { _read_or_end(); }
+    void _read_or_end() noexcept {
+      if ( _idx >= _end_idx ) { return; }
+      if ( !_seq_ptr->read( _idx, _frame ) ) {
+        _seq_ptr->_failed = true;
+        _idx              = _end_idx;
+      }
+    }
+    Sequence* _seq_ptr = nullptr;
+    uint32_t _idx = 0, _end_idx = 0;
+    FrameView _frame;
+  };
+
+  /** A range of frames for range-based for. Only one iterator should be in use at a time, as each frame read replaces the last. */
+  class Range {
+  public:
+    Iterator begin() const noexcept { return Iterator( _seq_ptr, _first_idx, _end_idx ); }
+    Iterator end() const noexcept { return Iterator( _seq_ptr, _end_idx, _end_idx ); }
+
+  private:
+    friend class Sequence;
+    Range( Sequence* seq_ptr, uint32_t first_idx, uint32_t end_idx ) noexcept : _seq_ptr( seq_ptr ), _first_idx( first_idx ), _end_idx( end_idx ) {}
+    Sequence* _seq_ptr;
+    uint32_t _first_idx, _end_idx;
+  };
+
+  /** All frames, in order. */
+  Range frames() noexcept { return frames( 0, frame_count() ); }
+  /** Frames from `first_idx` up to but not including `end_idx`, which is clamped to the frame count. */
+  Range frames( uint32_t first_idx, uint32_t end_idx ) noexcept {
+    _failed = false;
+    end_idx = end_idx < frame_count() ? end_idx : frame_count();
+    return Range( this, first_idx < end_idx ? first_idx : end_idx, end_idx );
+  }
+
+private:
+  Sequence() noexcept { std::memset( &_info, 0, sizeof( _info ) ); }
+
+  static bool _file_io_read( void* user_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr ) {
+    std::FILE* f_ptr = static_cast<std::FILE*>( user_ptr );
+#ifdef _WIN32
+    if ( 0 != _fseeki64( f_ptr, static_cast<int64_t>( offset ), SEEK_SET ) ) { return false; }
+#else
+    if ( 0 != fseeko( f_ptr, static_cast<off_t>( offset ), SEEK_SET ) ) { return false; }
+#endif
+    return 0 == sz || 1 == std::fread( dst_ptr, sz, 1, f_ptr );
+  }
+
+  /** @returns `ptr` rounded up to the next multiple of 16 bytes. */
+  static uint8_t* _align16( uint8_t* ptr ) noexcept {
+    return reinterpret_cast<uint8_t*>( ( reinterpret_cast<std::uintptr_t>( ptr ) + 15u ) & ~static_cast<std::uintptr_t>( 15u ) );
+  }
+
+  /** Copy `sz` bytes to `dst_ptr`, then move `dst_ptr` on to the next 16-byte boundary after them. @returns Where the bytes were copied to. */
+  static const uint8_t* _copy_aligned( const uint8_t* src_ptr, uint32_t sz, uint8_t*& dst_ptr ) noexcept {
+    uint8_t* copy_ptr = dst_ptr;
+    if ( sz > 0 ) { std::memcpy( copy_ptr, src_ptr, sz ); }
+    dst_ptr = _align16( copy_ptr + sz );
+    return copy_ptr;
+  }
+
+  /** @returns `src_ptr` if it's aligned for floats and 32-bit indices, otherwise a copy made with `_copy_aligned()`. */
+  static const uint8_t* _aligned_or_copy( const uint8_t* src_ptr, uint32_t sz, uint8_t*& dst_ptr ) noexcept {
+    if ( 0 == reinterpret_cast<std::uintptr_t>( src_ptr ) % alignof( float ) ) { return src_ptr; }
+    return _copy_aligned( src_ptr, sz, dst_ptr );
+  }
+
+  /** Allocate the keyframe and frame buffers, and keep a playback container open. Called once, by `open()`. */
+  bool _init( const char* seq_filename ) {
+    // Room for every array of a frame, each padded to 16 bytes, after aligning the start. A keyframe has up to 5 arrays, a tracked frame's copies 2.
+    std::size_t blob_sz = static_cast<std::size_t>( _info.biggest_frame_blob_sz );
+    _key_buf_ptr.reset( new ( std::nothrow ) uint8_t[blob_sz + 16 * 6] );
+    _frame_buf_ptr.reset( new ( std::nothrow ) uint8_t[blob_sz + 16 * 3] );
+    if ( !_key_buf_ptr || !_frame_buf_ptr ) { return false; }
+    if ( _info.playback_entries_ptr ) {
+      std::FILE* f_ptr = std::fopen( seq_filename, "rb" );
+      if ( !f_ptr ) { return false; }
+      _io = vol_geom_io_t{ _file_io_read, 0, f_ptr };
+    } else {
+      _seq_filename = seq_filename;
+    }
+    return true;
+  }
+
+  bool _read_frame( uint32_t frame_idx, vol_geom_frame_data_t& frame_data ) noexcept {
+    if ( _io.user_ptr ) { return vol_geom_read_frame_from_io( &_io, &_info, frame_idx, &frame_data ); }
+    return vol_geom_read_frame( _seq_filename.c_str(), &_info, frame_idx, &frame_data );
+  }
+
+  void _take( Sequence& other ) noexcept {
+    _info          = other._info;
+    _opened        = std::exchange( other._opened, false );
+    _io            = std::exchange( other._io, vol_geom_io_t{} );
+    _seq_filename  = std::move( other._seq_filename );
+    _key_buf_ptr   = std::move( other._key_buf_ptr );
+    _frame_buf_ptr = std::move( other._frame_buf_ptr );
+    _key_frame     = other._key_frame;
+    _key_idx       = std::exchange( other._key_idx, -1 );
+    _failed        = other._failed;
+  }
+
+  void _release() noexcept {
+    if ( _io.user_ptr ) { std::fclose( static_cast<std::FILE*>( _io.user_ptr ) ); }
+    if ( _opened ) { vol_geom_free_file_info( &_info ); }
+    _io     = vol_geom_io_t{};
+    _opened = false;
+    _key_idx = -1;
+  }
+
+  vol_geom_info_t _info;
+  bool _opened     = false;
+  vol_geom_io_t _io = vol_geom_io_t{}; // Playback containers only.
+  std::string _seq_filename;            // Other volograms only.
+  std::unique_ptr<uint8_t[]> _key_buf_ptr;   // Aligned copies of the last keyframe's arrays.
+  std::unique_ptr<uint8_t[]> _frame_buf_ptr; // Aligned copies of a tracked frame's positions and normals, if they were misaligned.
+  FrameView _key_frame;                      // Points into `_key_buf_ptr`.
+  int _key_idx = -1;
+  bool _failed = false;
+};
+
+/** An opened texture video. Move-only. Create with `VideoDecoder::open()`. */
+class VideoDecoder {
+public:
+  /** Open a video file, or a URL such as http://.
+   * @returns Empty on failure. vol_av logs the reason.
+   */
+  static std::optional<VideoDecoder> open( const char* filename ) {
+    VideoDecoder video;
+    if ( !filename || !vol_av_open( filename, &video._video ) ) {
+      if ( video._video._context_ptr ) { vol_av_close( &video._video ); } // vol_av_open() can fail after allocating.
+      return std::nullopt;
+    }
+    return std::optional<VideoDecoder>( std::move( video ) );
+  }
+
+  VideoDecoder( const VideoDecoder& )            = delete;
+  VideoDecoder& operator=( const VideoDecoder& ) = delete;
+  VideoDecoder( VideoDecoder&& other ) noexcept : _video( std::exchange( other._video, vol_av_video_t{} ) ) {}
+  VideoDecoder& operator=( VideoDecoder&& other ) noexcept {
+    if ( this != &other ) {
+      _release();
+      _video = std::exchange( other._video, vol_av_video_t{} );
+    }
+    return *this;
+  }
+  ~VideoDecoder() { _release(); }
+
+  /** The underlying vol_av video, for anything not wrapped here, e.g. setting `log_sink_ptr`. */
+  vol_av_video_t& video() noexcept { return _video; }
+
+  /** Decode the next frame and convert it to RGB. @returns False on error or at the end of the video. */
+  bool read_next() noexcept { return vol_av_read_next_frame( &_video ); }
+  /** Decode the next frame without converting it, e.g. to skip a frame. See `vol_av_decode_next_frame()`. */
+  bool decode_next() noexcept { return vol_av_decode_next_frame( &_video ); }
+  /** Convert the frame from `decode_next()` to RGB. */
+  bool convert() noexcept { return vol_av_convert_frame( &_video ); }
+  /** Presentation time of the last decoded frame in seconds, or -1.0 before the first. */
+  double pts_s() const noexcept { return vol_av_frame_pts_s( &_video ); }
+
+  /** The last converted frame, as tightly-packed RGB. Empty before the first. Valid until the next conversion. */
+  Span<const uint8_t> pixels() const noexcept { return { _video.pixels_ptr, _video.pixels_ptr ? static_cast<std::size_t>( _video.w ) * _video.h * 3 : 0 }; }
+  int width() const noexcept { return _video.w; }
+  int height() const noexcept { return _video.h; }
+  double frame_rate() const noexcept { return vol_av_frame_rate( &_video ); }
+  double duration_s() const noexcept { return vol_av_duration_s( &_video ); }
+
+private:
+  VideoDecoder() noexcept : _video( vol_av_video_t{} ) {}
+  void _release() noexcept {
+    if ( _video._context_ptr ) { vol_av_close( &_video ); }
+  }
+
+  vol_av_video_t _video;
+};
+
+} // namespace vol
@@ -1,7 +1,7 @@
 /** @file vol_av.c
  * Volograms SDK Audio-Video Decoding API
  *
- * Version:   0.9.0 \n
+ * Version:   0.14.0 \n
  * Authors:   Anton Gerdelan <anton@volograms.com> \n
  * Copyright: 2021, Volograms (http://volograms.com/) \n
  * Language:  C99 \n
@@ -9,6 +9,13 @@
  */
 
 #include "vol_av.h"
+#ifdef VOL_TRACE
+#include "vol_trace.h"
+#else
+// Without VOL_TRACE the trace markers compile to nothing, so vol_trace.h isn't needed to build this library.
+#define VOL_TRACE_BEGIN( name_str ) ( (void)0 )
+#define VOL_TRACE_END( name_str ) ( (void)0 )
+#endif
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/imgutils.h> // av_image_get_buffer_size()
@@ -37,6 +44,11 @@ struct vol_av_internal_t {
   struct SwsContext* sws_conv_ctx_ptr; /** Scaling/image conversion context. */
 
   int w, h; /** Dimensions of `output_frame_rgb_ptr`. */
+
+  // Timestamps
+  bool skip_rgb;            /** Set while `vol_av_decode_next_frame()` decodes, so that the RGB conversion is left to `vol_av_convert_frame()`. */
+  int64_t n_frames_decoded; /** Frames received from the decoder so far. */
+  double frame_pts_s;       /** Presentation time of the most recently decoded frame, in seconds from the start of the stream. */
 };
 
 static void _default_logger( vol_av_log_type_t log_type, const char* message_str ) {
@@ -45,45 +57,77 @@ static void _default_logger( vol_av_log_type_t log_type, const char* message_str
 }
 
 static void ( *_logger_ptr )( vol_av_log_type_t log_type, const char* message_str ) = _default_logger;
+static vol_av_log_type_t _logger_min_log_type                                          = VOL_AV_LOG_TYPE_DEBUG;
+
+/// Log types are not declared in order of severity, so this maps them to DEBUG=0 < INFO=1 < WARNING=2 < ERROR=3. Folds to a constant for constant types.
+#define _LOG_SEVERITY( log_type ) ( VOL_AV_LOG_TYPE_DEBUG == ( log_type ) ? 0 : VOL_AV_LOG_TYPE_INFO == ( log_type ) ? 1 : (int)( log_type ) )
 
-// This function is used in this file as a printf-style logger. It converts that format to a simple string and passes it to _logger_ptr.
-static void _vol_loggerf( vol_av_log_type_t log_type, const char* message_str, ... ) {
-  if ( !_logger_ptr ) { return; }
+/// @returns True if a message of `log_type` would be passed on by `sink_ptr`, or by the global callback if `sink_ptr` is NULL.
+static bool _log_enabled( const vol_av_log_sink_t* sink_ptr, vol_av_log_type_t log_type ) {
+  if ( sink_ptr ) { return sink_ptr->callback_ptr && _LOG_SEVERITY( log_type ) >= _LOG_SEVERITY( sink_ptr->min_log_type ); }
+  return _logger_ptr && _LOG_SEVERITY( log_type ) >= _LOG_SEVERITY( _logger_min_log_type );
+}
+
+// Converts a printf-style message to a simple string and passes it to the sink, or to _logger_ptr. Called via the macros below.
+static void _vol_sink_loggerf_impl( const vol_av_log_sink_t* sink_ptr, vol_av_log_type_t log_type, const char* message_str, ... ) {
   char log_str[VOL_AV_LOG_STR_MAX_LEN];
   log_str[0] = '\0';
   va_list arg_ptr; // using va_args lets us make sure any printf-style formatting values are properly written into the string.
   va_start( arg_ptr, message_str );
   vsnprintf( log_str, VOL_AV_LOG_STR_MAX_LEN - 1, message_str, arg_ptr );
   va_end( arg_ptr );
-  _logger_ptr( log_type, log_str );
+  if ( sink_ptr ) {
+    sink_ptr->callback_ptr( log_type, log_str, sink_ptr->user_ptr );
+  } else {
+    _logger_ptr( log_type, log_str );
+  }
 }
 
+// printf-style loggers used in this file. Levels are checked before any formatting, and messages below VOL_AV_LOG_MIN_TYPE compile to nothing.
+#define _vol_sink_loggerf( sink_ptr, log_type, ... )                                                                                                           \
+  do {                                                                                                                                                         \
+    if ( _LOG_SEVERITY( log_type ) >= _LOG_SEVERITY( VOL_AV_LOG_MIN_TYPE ) && _log_enabled( ( sink_ptr ), ( log_type ) ) ) {                                   \
+      _vol_sink_loggerf_impl( ( sink_ptr ), ( log_type ), __VA_ARGS__ );                                                                                       \
+    }                                                                                                                                                          \
+  } while ( 0 )
+#define _vol_loggerf( log_type, ... ) _vol_sink_loggerf( NULL, log_type, __VA_ARGS__ )
+#define _vol_info_loggerf( obj_ptr, log_type, ... ) _vol_sink_loggerf( ( obj_ptr )->log_sink_ptr, log_type, __VA_ARGS__ )
+
 //
 //
 bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
   if ( !filename || !info_ptr || info_ptr->_context_ptr != NULL ) { return false; }
 
-  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "opening URL `%s`...\n", filename );
+  _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_INFO, "opening URL `%s`...\n", filename );
 
+  const vol_av_log_sink_t* log_sink_ptr = info_ptr->log_sink_ptr;
   memset( info_ptr, 0, sizeof( vol_av_video_t ) );
+  info_ptr->log_sink_ptr = log_sink_ptr;
   info_ptr->_context_ptr = calloc( 1, sizeof( vol_av_internal_t ) );
   if ( !info_ptr->_context_ptr ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for internal pointer\n" );
+    _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for internal pointer\n" );
     return false;
   }
   vol_av_internal_t* p = info_ptr->_context_ptr;
 
   { // Open the file and read its header. The codecs are not opened. -- note that if first param is NULL then this allocates memory.
-    if ( avformat_open_input( &p->fmt_ctx_ptr, filename, NULL, NULL ) < 0 ) { // NOTE(Anton) the second param is `url` and we can try a web stream.
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to open input file.\n" );
+    AVDictionary* options_ptr = NULL;
+    if ( strstr( filename, "://" ) ) { // A URL. FFmpeg's network init is reference-counted, so calling it once per URL is fine.
+      avformat_network_init();
+      av_dict_set( &options_ptr, "reconnect", "1", 0 ); // Resume a dropped HTTP connection with a range request rather than failing mid-sequence.
+    }
+    int open_result = avformat_open_input( &p->fmt_ctx_ptr, filename, NULL, &options_ptr );
+    av_dict_free( &options_ptr );
+    if ( open_result < 0 ) {
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to open input file.\n" );
       return false;
     }
-    _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "format: %s, duration: %lld us, bit_rate: %lld\n", p->fmt_ctx_ptr->iformat->name, p->fmt_ctx_ptr->duration,
-      p->fmt_ctx_ptr->bit_rate );
+    _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_INFO, "format: %s, duration: %lld us, bit_rate: %lld\n", p->fmt_ctx_ptr->iformat->name,
+      p->fmt_ctx_ptr->duration, p->fmt_ctx_ptr->bit_rate );
 
     // Read packets from the AVFormatContext to get stream information. this function populates p->fmt_ctx_ptr->streams
     if ( avformat_find_stream_info( p->fmt_ctx_ptr, NULL ) < 0 ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to get stream info.\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to get stream info.\n" );
       return false;
     }
 
@@ -96,22 +140,22 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
     p->video_stream_idx                 = -1;
     // Now p->fmt_ctx_ptr->streams is just an array of pointers, so let's walk through it until we find a video stream.
     for ( unsigned int i = 0; i < p->fmt_ctx_ptr->nb_streams; ++i ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "AVStream->time_base before open coded %d/%d\n", p->fmt_ctx_ptr->streams[i]->time_base.num,
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "AVStream->time_base before open coded %d/%d\n", p->fmt_ctx_ptr->streams[i]->time_base.num,
         p->fmt_ctx_ptr->streams[i]->time_base.den );
-      _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "AVStream->r_frame_rate before open coded %d/%d\n", p->fmt_ctx_ptr->streams[i]->r_frame_rate.num,
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "AVStream->r_frame_rate before open coded %d/%d\n", p->fmt_ctx_ptr->streams[i]->r_frame_rate.num,
         p->fmt_ctx_ptr->streams[i]->r_frame_rate.den );
-      _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "AVStream->start_time %lld\n", p->fmt_ctx_ptr->streams[i]->start_time );
-      _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "AVStream->duration %lld\n", vol_av_duration_s( info_ptr ) );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "AVStream->start_time %lld\n", p->fmt_ctx_ptr->streams[i]->start_time );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "AVStream->duration %lld\n", vol_av_duration_s( info_ptr ) );
       // NOTE(Anton) this is an update from using deprecated codec pointer (p->fmt_ctx_ptr->streams[i]->codec->codec_type).
       AVCodecParameters* tmp_codec_params_ptr = p->fmt_ctx_ptr->streams[i]->codecpar;
       if ( !tmp_codec_params_ptr ) {
-        _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: unsupported codec parameters!\n" );
+        _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: unsupported codec parameters!\n" );
         continue;
       }
       // find proper decoder
       const AVCodec* tmp_codec_ptr = avcodec_find_decoder( tmp_codec_params_ptr->codec_id ); // https://ffmpeg.org/doxygen/trunk/group__lavc__decoding.html#ga19a0ca553277f019dd5b0fec6e1f9dca
       if ( !tmp_codec_ptr ) {
-        _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: unsupported codec!\n" );
+        _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: unsupported codec!\n" );
         continue;
       }
 
@@ -121,29 +165,31 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
           p->codec_ptr        = (AVCodec*)tmp_codec_ptr;
           codec_params_ptr    = tmp_codec_params_ptr;
         }
-        _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Video Codec: resolution %dx%d\n", tmp_codec_params_ptr->width, tmp_codec_params_ptr->height );
+        _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "Video Codec: resolution %dx%d\n", tmp_codec_params_ptr->width, tmp_codec_params_ptr->height );
       } else if ( tmp_codec_params_ptr->codec_type == AVMEDIA_TYPE_AUDIO ) {
-        _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Audio Codec: %d channels, sample rate %d\n", tmp_codec_params_ptr->channels, tmp_codec_params_ptr->sample_rate );
+        _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "Audio Codec: %d channels, sample rate %d\n", tmp_codec_params_ptr->channels,
+          tmp_codec_params_ptr->sample_rate );
       }
 
       // print its name, id and bitrate
-      _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "\tCodec %s ID %d bit_rate %lld\n", tmp_codec_ptr->name, tmp_codec_ptr->id, tmp_codec_params_ptr->bit_rate );
+      _vol_info_loggerf(
+        info_ptr, VOL_AV_LOG_TYPE_DEBUG, "\tCodec %s ID %d bit_rate %lld\n", tmp_codec_ptr->name, tmp_codec_ptr->id, tmp_codec_params_ptr->bit_rate );
     }
 
     if ( p->video_stream_idx == -1 ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to find video stream.\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to find video stream.\n" );
       return false;
     }
 
     p->codec_ctx_ptr = avcodec_alloc_context3( p->codec_ptr );
     if ( !p->codec_ctx_ptr ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for AVCodecContext\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for AVCodecContext\n" );
       return false;
     }
     // Fill the codec context based on the values from the supplied codec parameters
     // https://ffmpeg.org/doxygen/trunk/group__lavc__core.html#gac7b282f51540ca7a99416a3ba6ee0d16
     if ( avcodec_parameters_to_context( p->codec_ctx_ptr, codec_params_ptr ) < 0 ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to copy codec params to codec context\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to copy codec params to codec context\n" );
       return false;
     }
 
@@ -168,7 +214,7 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
     // Initialise the AVCodecContext to use the given AVCodec.
     // https://ffmpeg.org/doxygen/trunk/group__lavc__core.html#ga11f785a188d7d9df71621001465b0f1d
     if ( avcodec_open2( p->codec_ctx_ptr, p->codec_ptr, NULL ) < 0 ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to open codec through avcodec_open2\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to open codec through avcodec_open2\n" );
       return false;
     }
   } // endblock Video Codec Context
@@ -177,7 +223,7 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
     p->output_frame_ptr     = av_frame_alloc();
     p->output_frame_rgb_ptr = av_frame_alloc();
     if ( !p->output_frame_ptr || !p->output_frame_rgb_ptr ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocate frame storage.\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocate frame storage.\n" );
       return false;
     }
     p->output_frame_rgb_ptr->format = AV_PIX_FMT_RGB24;
@@ -195,7 +241,7 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
       align                              // int	align_
     );
     if ( ret < 0 ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate and set up output image buffer.\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate and set up output image buffer.\n" );
       return false;
     }
   } // endblock Allocate Frame Storage
@@ -203,7 +249,7 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
   { // init SWS context for software scaling
     // This function can crash if it gets bad params so let's check for those first
     if ( AV_PIX_FMT_NONE == p->codec_ctx_ptr->pix_fmt ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to get SWS context - pixel format of stream was NONE.\n" );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to get SWS context - pixel format of stream was NONE.\n" );
       return false;
     }
 
@@ -226,7 +272,7 @@ bool vol_av_open( const char* filename, vol_av_video_t* info_ptr ) {
 bool vol_av_close( vol_av_video_t* info_ptr ) {
   if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
 
-  _vol_loggerf( VOL_AV_LOG_TYPE_INFO, "Releasing all the resources...\n" );
+  _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_INFO, "Releasing all the resources...\n" );
 
   vol_av_internal_t* p = info_ptr->_context_ptr;
 
@@ -241,8 +287,10 @@ bool vol_av_close( vol_av_video_t* info_ptr ) {
   // tools
   if ( p->sws_conv_ctx_ptr ) { sws_freeContext( p->sws_conv_ctx_ptr ); }
 
+  const vol_av_log_sink_t* log_sink_ptr = info_ptr->log_sink_ptr;
   free( info_ptr->_context_ptr );                  // this is our internal struct we allocated
   memset( info_ptr, 0, sizeof( vol_av_video_t ) ); // wipe for subsequent use
+  info_ptr->log_sink_ptr = log_sink_ptr;
 
   return true;
 }
@@ -256,6 +304,7 @@ static void _save_rgb_frame( vol_av_video_t* info_ptr ) {
   info_ptr->h = p->output_frame_ptr->height;
   //   printf("[vol_av] DEBUG - frame wxh %ix%i linesize %i\n", info_ptr->w, info_ptr->h, p->output_frame_rgb_ptr->linesize[0] );
   // Convert the image from its native format to RGB
+  VOL_TRACE_BEGIN( "vol_av_sws_scale" );
   sws_scale( p->sws_conv_ctx_ptr,                     // context.
     (uint8_t const* const*)p->output_frame_ptr->data, // src slice.
     p->output_frame_ptr->linesize,                    // src stride.
@@ -264,11 +313,31 @@ static void _save_rgb_frame( vol_av_video_t* info_ptr ) {
     p->output_frame_rgb_ptr->data,                    // dst.
     p->output_frame_rgb_ptr->linesize                 // dst stride.
   );
+  VOL_TRACE_END( "vol_av_sws_scale" );
   // Remember that you can cast an AVFrame pointer to an AVPicture pointer.
   // can now save or use this data and increment frame counter
   info_ptr->pixels_ptr = p->output_frame_rgb_ptr->data[0]; // [0] is the first (red) channel. output usually has 3 but can have 4 channels.
 }
 
+/** Works out the presentation time of the frame just received from the decoder.
+ * Containers give frames in decode order, which is not display order for streams with B-frames, so the decoder's best-effort timestamp is used.
+ * Frames without any timestamp are assumed to follow the previous frame by one frame period.
+ */
+static void _update_frame_pts( vol_av_video_t* info_ptr ) {
+  vol_av_internal_t* p = info_ptr->_context_ptr;
+  AVStream* v_strm     = p->fmt_ctx_ptr->streams[p->video_stream_idx];
+  int64_t ts           = p->output_frame_ptr->best_effort_timestamp;
+  if ( AV_NOPTS_VALUE == ts ) { ts = p->output_frame_ptr->pts; }
+  if ( AV_NOPTS_VALUE == ts || v_strm->time_base.den <= 0 ) {
+    double frame_rate = vol_av_frame_rate( info_ptr );
+    p->frame_pts_s    = p->n_frames_decoded > 0 && frame_rate > 0.0 ? p->frame_pts_s + 1.0 / frame_rate : 0.0;
+  } else {
+    int64_t start_ts = AV_NOPTS_VALUE != v_strm->start_time ? v_strm->start_time : 0; // e.g. MPEG-TS streams rarely start at 0.
+    p->frame_pts_s   = (double)( ts - start_ts ) * av_q2d( v_strm->time_base );
+  }
+  p->n_frames_decoded++;
+}
+
 //
 //
 static int _decode_packet( vol_av_video_t* info_ptr, AVPacket* packet_ptr ) {
@@ -291,7 +360,7 @@ static int _decode_packet( vol_av_video_t* info_ptr, AVPacket* packet_ptr ) {
   // Supply raw packet data as input to a decoder
   int response = avcodec_send_packet( p->codec_ctx_ptr, packet_ptr ); // https://ffmpeg.org/doxygen/trunk/group__lavc__decoding.html#ga58bc4bf1e0ac59e27362597e467efff3
   if ( response < 0 && response != AVERROR_EOF ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while sending a packet to the decoder: %s\n", av_err2str( response ) );
+    _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: while sending a packet to the decoder: %s\n", av_err2str( response ) );
     return response;
   }
 
@@ -305,17 +374,18 @@ static int _decode_packet( vol_av_video_t* info_ptr, AVPacket* packet_ptr ) {
     if ( response == AVERROR( EAGAIN ) ) {                                     //|| response == AVERROR_EOF
       return response;
     } else if ( response < 0 && response != AVERROR_EOF ) {
-      _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: while receiving a frame from the decoder: %s\n", av_err2str( response ) );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: while receiving a frame from the decoder: %s\n", av_err2str( response ) );
       return response;
     }
     // NOTE(Anton) i think this is always true >=0 at this point.
     if ( response >= 0 ) {
 #ifdef VOL_AV_DEBUG_EXTRA
-      _vol_loggerf( VOL_AV_LOG_TYPE_DEBUG, "Frame %d (type=%c, size=%d bytes, format=%d) pts %d key_frame %d [DTS %d]\n", p->codec_ctx_ptr->frame_number,
-        av_get_picture_type_char( p->output_frame_ptr->pict_type ), p->output_frame_ptr->pkt_size, p->output_frame_ptr->format, p->output_frame_ptr->pts,
-        p->output_frame_ptr->key_frame, p->output_frame_ptr->coded_picture_number );
+      _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_DEBUG, "Frame %d (type=%c, size=%d bytes, format=%d) pts %d key_frame %d [DTS %d]\n",
+        p->codec_ctx_ptr->frame_number, av_get_picture_type_char( p->output_frame_ptr->pict_type ), p->output_frame_ptr->pkt_size, p->output_frame_ptr->format,
+        p->output_frame_ptr->pts, p->output_frame_ptr->key_frame, p->output_frame_ptr->coded_picture_number );
 #endif
-      _save_rgb_frame( info_ptr );
+      _update_frame_pts( info_ptr );
+      if ( !p->skip_rgb ) { _save_rgb_frame( info_ptr ); }
       return response;
     }
     overflow_retry_count++;
@@ -324,22 +394,25 @@ static int _decode_packet( vol_av_video_t* info_ptr, AVPacket* packet_ptr ) {
   return response;
 }
 
-//
-//
-bool vol_av_read_next_frame( vol_av_video_t* info_ptr ) {
+/** Reads packets until the decoder gives a frame. Shared by `vol_av_read_next_frame()` and `vol_av_decode_next_frame()`.
+ * @param convert If false then the frame is left in the decoder's pixel format, and `pixels_ptr` is not changed.
+ */
+static bool _read_next_frame( vol_av_video_t* info_ptr, bool convert ) {
   if ( !info_ptr || !info_ptr->_context_ptr ) {
     _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: info_ptr || !info_ptr->_context_ptr NULL.\n" );
     return false;
   }
 
   vol_av_internal_t* p = info_ptr->_context_ptr;
+  p->skip_rgb          = !convert;
 
   AVPacket* packet_ptr = av_packet_alloc(); // https://ffmpeg.org/doxygen/trunk/structAVPacket.html
   if ( !packet_ptr ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocated memory for AVPacket.\n" );
+    _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocated memory for AVPacket.\n" );
     return false;
   }
   int packet_response = -1;
+  VOL_TRACE_BEGIN( "vol_av_read_next_frame" );
   // fill the Packet with data from the Stream
   // https://ffmpeg.org/doxygen/trunk/group__lavf__decoding.html#ga4fdb3084415a82e3810de6ee60e46a61
 
@@ -370,15 +443,44 @@ bool vol_av_read_next_frame( vol_av_video_t* info_ptr ) {
 
   av_packet_unref( packet_ptr );
   av_packet_free( &packet_ptr );
+  VOL_TRACE_END( "vol_av_read_next_frame" );
 
   if ( packet_response < 0 && packet_response != AVERROR_EOF && packet_response != AVERROR( EAGAIN ) ) {
-    _vol_loggerf( VOL_AV_LOG_TYPE_ERROR, "ERROR: packet response was %i.\n", packet_response );
+    _vol_info_loggerf( info_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: packet response was %i.\n", packet_response );
     return false;
   }
 
   return true;
 }
 
+//
+//
+bool vol_av_read_next_frame( vol_av_video_t* info_ptr ) { return _read_next_frame( info_ptr, true ); }
+
+//
+//
+bool vol_av_decode_next_frame( vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr ) { return false; }
+  int64_t n_frames_before = info_ptr->_context_ptr->n_frames_decoded;
+  bool read_ok            = _read_next_frame( info_ptr, false );
+  return read_ok && info_ptr->_context_ptr->n_frames_decoded > n_frames_before;
+}
+
+//
+//
+bool vol_av_convert_frame( vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || 0 == info_ptr->_context_ptr->n_frames_decoded ) { return false; }
+  _save_rgb_frame( info_ptr );
+  return true;
+}
+
+//
+//
+double vol_av_frame_pts_s( const vol_av_video_t* info_ptr ) {
+  if ( !info_ptr || !info_ptr->_context_ptr || 0 == info_ptr->_context_ptr->n_frames_decoded ) { return -1.0; }
+  return info_ptr->_context_ptr->frame_pts_s;
+}
+
 //
 //
 void vol_av_dimensions( const vol_av_video_t* info_ptr, int* w, int* h ) {
@@ -442,3 +544,206 @@ void vol_av_set_log_callback( void ( *user_function_ptr )( vol_av_log_type_t log
 //
 //
 void vol_av_reset_log_callback( void ) { _logger_ptr = _default_logger; }
+
+//
+//
+void vol_av_set_log_level( vol_av_log_type_t min_log_type ) { _logger_min_log_type = min_log_type; }
+
+/** Internal ffmpeg-specific context variables for encoding. This struct lives inside the vol_av_encoder_t interface struct. */
+struct vol_av_encoder_internal_t {
+  AVFormatContext* fmt_ctx_ptr;        /** Output container. */
+  AVCodecContext* codec_ctx_ptr;       /** Video encoder context. */
+  AVStream* stream_ptr;                /** The single video stream in the container. */
+  AVFrame* frame_ptr;                  /** Frame in the encoder's native (YUV) format. */
+  AVPacket* packet_ptr;                /** Reused for each encoded packet. */
+  struct SwsContext* sws_conv_ctx_ptr; /** RGB(A) to YUV conversion context. */
+  bool header_written;                 /** The container header has been written, so the trailer must be too. */
+};
+
+/** Send a frame to the encoder, or NULL to flush it, and write out any packets it has ready. Returns false on error. */
+static bool _encode_and_write( vol_av_encoder_internal_t* p, AVFrame* frame_ptr, const vol_av_log_sink_t* sink_ptr ) {
+  int response = avcodec_send_frame( p->codec_ctx_ptr, frame_ptr );
+  if ( response < 0 ) {
+    _vol_sink_loggerf( sink_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: while sending a frame to the encoder: %s\n", av_err2str( response ) );
+    return false;
+  }
+  while ( response >= 0 ) {
+    response = avcodec_receive_packet( p->codec_ctx_ptr, p->packet_ptr );
+    if ( response == AVERROR( EAGAIN ) || response == AVERROR_EOF ) { return true; }
+    if ( response < 0 ) {
+      _vol_sink_loggerf( sink_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: while receiving a packet from the encoder: %s\n", av_err2str( response ) );
+      return false;
+    }
+    av_packet_rescale_ts( p->packet_ptr, p->codec_ctx_ptr->time_base, p->stream_ptr->time_base );
+    p->packet_ptr->stream_index = p->stream_ptr->index;
+    response                    = av_interleaved_write_frame( p->fmt_ctx_ptr, p->packet_ptr ); // Takes ownership of the packet's data.
+    if ( response < 0 ) {
+      _vol_sink_loggerf( sink_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: while writing a packet: %s\n", av_err2str( response ) );
+      return false;
+    }
+  }
+  return true;
+}
+
+//
+//
+bool vol_av_encoder_open( const char* filename, int w, int h, int n_chans, double fps, int64_t bit_rate, vol_av_encoder_t* enc_ptr ) {
+  if ( !filename || !enc_ptr || enc_ptr->_context_ptr != NULL ) { return false; }
+  if ( w <= 0 || h <= 0 || 0 != w % 2 || 0 != h % 2 || ( n_chans != 3 && n_chans != 4 ) || fps <= 0.0 || bit_rate <= 0 ) { return false; }
+
+  _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_INFO, "opening `%s` for encoding %ix%i @ %.2f fps...\n", filename, w, h, fps );
+
+  const vol_av_log_sink_t* log_sink_ptr = enc_ptr->log_sink_ptr;
+  memset( enc_ptr, 0, sizeof( vol_av_encoder_t ) );
+  enc_ptr->log_sink_ptr = log_sink_ptr;
+  enc_ptr->_context_ptr = calloc( 1, sizeof( vol_av_encoder_internal_t ) );
+  if ( !enc_ptr->_context_ptr ) {
+    _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: calloc() failed to allocate memory for internal pointer\n" );
+    return false;
+  }
+  enc_ptr->w                   = w;
+  enc_ptr->h                   = h;
+  enc_ptr->n_chans             = n_chans;
+  vol_av_encoder_internal_t* p = enc_ptr->_context_ptr;
+
+  { // Container and stream.
+    if ( avformat_alloc_output_context2( &p->fmt_ctx_ptr, NULL, NULL, filename ) < 0 || !p->fmt_ctx_ptr ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Could not deduce an output format from file extension.\n" );
+      goto _veo_fail;
+    }
+    const AVCodec* codec_ptr = avcodec_find_encoder( AV_CODEC_ID_H264 );
+    if ( !codec_ptr ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: No H.264 encoder found in this FFmpeg build.\n" );
+      goto _veo_fail;
+    }
+    p->stream_ptr    = avformat_new_stream( p->fmt_ctx_ptr, NULL );
+    p->codec_ctx_ptr = avcodec_alloc_context3( codec_ptr );
+    if ( !p->stream_ptr || !p->codec_ctx_ptr ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate memory for stream or AVCodecContext\n" );
+      goto _veo_fail;
+    }
+
+    AVRational frame_rate          = av_d2q( fps, 100000 );
+    p->codec_ctx_ptr->width        = w;
+    p->codec_ctx_ptr->height       = h;
+    p->codec_ctx_ptr->bit_rate     = bit_rate;
+    p->codec_ctx_ptr->framerate    = frame_rate;
+    p->codec_ctx_ptr->time_base    = av_inv_q( frame_rate );
+    p->codec_ctx_ptr->pix_fmt      = AV_PIX_FMT_YUV420P;
+    p->codec_ctx_ptr->gop_size     = (int)( fps + 0.5 ); // A keyframe about every second keeps seeking reasonable.
+    p->codec_ctx_ptr->max_b_frames = 0;                  // Frames are decoded in order by players that step through the texture.
+    p->codec_ctx_ptr->thread_count = 0;                  // 0 lets the encoder choose the number of threads.
+    p->stream_ptr->time_base       = p->codec_ctx_ptr->time_base;
+    p->stream_ptr->avg_frame_rate  = frame_rate;
+    if ( p->fmt_ctx_ptr->oformat->flags & AVFMT_GLOBALHEADER ) { p->codec_ctx_ptr->flags |= AV_CODEC_FLAG_GLOBAL_HEADER; }
+
+    if ( avcodec_open2( p->codec_ctx_ptr, codec_ptr, NULL ) < 0 ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to open encoder through avcodec_open2\n" );
+      goto _veo_fail;
+    }
+    if ( avcodec_parameters_from_context( p->stream_ptr->codecpar, p->codec_ctx_ptr ) < 0 ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to copy codec context to stream params\n" );
+      goto _veo_fail;
+    }
+  } // endblock Container and stream.
+
+  { // Frame storage and conversion.
+    p->frame_ptr  = av_frame_alloc();
+    p->packet_ptr = av_packet_alloc();
+    if ( !p->frame_ptr || !p->packet_ptr ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to allocate frame storage.\n" );
+      goto _veo_fail;
+    }
+    p->frame_ptr->format = p->codec_ctx_ptr->pix_fmt;
+    p->frame_ptr->width  = w;
+    p->frame_ptr->height = h;
+    if ( av_frame_get_buffer( p->frame_ptr, 0 ) < 0 ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to allocate encoder frame buffer.\n" );
+      goto _veo_fail;
+    }
+    p->sws_conv_ctx_ptr = sws_getContext( w, h, 4 == n_chans ? AV_PIX_FMT_RGBA : AV_PIX_FMT_RGB24, w, h, p->codec_ctx_ptr->pix_fmt, SWS_BILINEAR, NULL, NULL, NULL );
+    if ( !p->sws_conv_ctx_ptr ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: failed to get SWS context for encoding.\n" );
+      goto _veo_fail;
+    }
+  } // endblock Frame storage and conversion.
+
+  { // Open the file and write the container header.
+    if ( !( p->fmt_ctx_ptr->oformat->flags & AVFMT_NOFILE ) && avio_open( &p->fmt_ctx_ptr->pb, filename, AVIO_FLAG_WRITE ) < 0 ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to open output file `%s`.\n", filename );
+      goto _veo_fail;
+    }
+    if ( avformat_write_header( p->fmt_ctx_ptr, NULL ) < 0 ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to write container header.\n" );
+      goto _veo_fail;
+    }
+    p->header_written = true;
+  } // endblock Open the file.
+
+  return true;
+
+_veo_fail:
+  vol_av_encoder_close( enc_ptr );
+  return false;
+}
+
+//
+//
+bool vol_av_encoder_write_frame( vol_av_encoder_t* enc_ptr, const uint8_t* pixels_ptr ) {
+  if ( !enc_ptr || !enc_ptr->_context_ptr || !pixels_ptr ) { return false; }
+
+  vol_av_encoder_internal_t* p = enc_ptr->_context_ptr;
+  // The encoder may still hold a reference to the previous frame's buffers.
+  if ( av_frame_make_writable( p->frame_ptr ) < 0 ) {
+    _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to make encoder frame writable.\n" );
+    return false;
+  }
+  const uint8_t* src_data[1] = { pixels_ptr };
+  int src_stride[1]          = { enc_ptr->w * enc_ptr->n_chans };
+  VOL_TRACE_BEGIN( "vol_av_sws_scale" );
+  sws_scale( p->sws_conv_ctx_ptr, src_data, src_stride, 0, enc_ptr->h, p->frame_ptr->data, p->frame_ptr->linesize );
+  VOL_TRACE_END( "vol_av_sws_scale" );
+  p->frame_ptr->pts = enc_ptr->n_frames;
+
+  VOL_TRACE_BEGIN( "vol_av_encode_frame" );
+  bool encode_ok = _encode_and_write( p, p->frame_ptr, enc_ptr->log_sink_ptr );
+  VOL_TRACE_END( "vol_av_encode_frame" );
+  if ( !encode_ok ) { return false; }
+  enc_ptr->n_frames++;
+
+  return true;
+}
+
+//
+//
+bool vol_av_encoder_close( vol_av_encoder_t* enc_ptr ) {
+  if ( !enc_ptr || !enc_ptr->_context_ptr ) { return false; }
+
+  _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_INFO, "Finishing encoded video...\n" );
+
+  vol_av_encoder_internal_t* p = enc_ptr->_context_ptr;
+  bool success                 = true;
+
+  if ( p->header_written ) {
+    if ( !_encode_and_write( p, NULL, enc_ptr->log_sink_ptr ) ) { success = false; } // Flush frames buffered in the encoder.
+    if ( av_write_trailer( p->fmt_ctx_ptr ) < 0 ) {
+      _vol_info_loggerf( enc_ptr, VOL_AV_LOG_TYPE_ERROR, "ERROR: Failed to write container trailer.\n" );
+      success = false;
+    }
+  }
+  if ( p->fmt_ctx_ptr ) {
+    if ( p->fmt_ctx_ptr->pb && !( p->fmt_ctx_ptr->oformat->flags & AVFMT_NOFILE ) ) { avio_closep( &p->fmt_ctx_ptr->pb ); }
+    avformat_free_context( p->fmt_ctx_ptr );
+  }
+  if ( p->codec_ctx_ptr ) { avcodec_free_context( &p->codec_ctx_ptr ); }
+  if ( p->frame_ptr ) { av_frame_free( &p->frame_ptr ); }
+  if ( p->packet_ptr ) { av_packet_free( &p->packet_ptr ); }
+  if ( p->sws_conv_ctx_ptr ) { sws_freeContext( p->sws_conv_ctx_ptr ); }
+
+  const vol_av_log_sink_t* log_sink_ptr = enc_ptr->log_sink_ptr;
+  free( enc_ptr->_context_ptr );
+  memset( enc_ptr, 0, sizeof( vol_av_encoder_t ) );
+  enc_ptr->log_sink_ptr = log_sink_ptr;
+
+  return success;
+}
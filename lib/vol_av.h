@@ -3,7 +3,7 @@
  *
  * vol_av    | Audio-Video Decoding API
  * --------- | ----------
- * Version   | 0.9
+ * Version   | 0.14
  * Authors   | Anton Gerdelan <anton@volograms.com>
  * Copyright | 2021, Volograms (http://volograms.com/)
  * Language  | C99
@@ -16,7 +16,8 @@
  * * Only video is currently processed, audio is ignored.
  * * Seek frame is not implemented.
  * * Reverse play is not implemented.
- * * Network streaming is not implemented.
+ * * Network streaming is whatever FFmpeg's protocols provide, e.g. `vol_av_open( "http://cdn.example.com/texture.mp4", ... )`.
+ *   FFmpeg reads HTTP with range requests, but does not prefetch ahead of the decoder. For geometry see vol_stream.h.
  *
  * References
  * -----------
@@ -24,6 +25,11 @@
  *
  * History
  * -----------
+ * - 0.14.0 (2026/10/18) - Frame presentation timestamps, and decoding without RGB conversion, for players that pair frames by time.
+ * - 0.13.0 (2026/10/18) - `vol_av_open()` initialises FFmpeg networking for URLs, and reconnects dropped HTTP connections.
+ * - 0.12.0 (2026/10/18) - Per-video log sinks, log level filtering before formatting, and a compile-time minimum log level.
+ * - 0.11.0 (2026/10/18) - Trace markers around decoding, encoding and pixel format conversion, when built with VOL_TRACE defined. See vol_trace.h.
+ * - 0.10.0 (2026/10/18) - Added H.264 video encoding, for tools that write texture videos.
  * - 0.9.0 (2022/03/23) - Added log reset from Unity plugin, multithreaded decoding, and tidied docs.
  * - 0.8.0 (2021/01/20) - Added customisable debug callback.
  * - 0.7.1 (2021/12/10) - Tidied comments.
@@ -67,8 +73,34 @@ VOL_AV_EXPORT typedef struct vol_av_video_t {
   uint8_t* pixels_ptr;
   /** Dimensions of image in `pixels_ptr`. */
   int w, h;
+
+  /** Where this video's log messages go. If NULL then the global log callback is used. Zero-initialise if unused.
+   * Kept by `vol_av_open()` and `vol_av_close()`. */
+  const struct vol_av_log_sink_t* log_sink_ptr;
 } vol_av_video_t;
 
+/** Forward-declaration of internal encoder context struct type. */
+VOL_AV_EXPORT typedef struct vol_av_encoder_internal_t vol_av_encoder_internal_t;
+
+/** Context variables for a video file being written.
+Have one copy of this struct per output file. Separate encoders can be used from separate threads.
+Zero the memory for instances of this struct before use.
+*/
+VOL_AV_EXPORT typedef struct vol_av_encoder_t {
+  /** Internal context state. Must start == NULL. Should not need to be accessed by the application. */
+  vol_av_encoder_internal_t* _context_ptr;
+
+  /** Dimensions of the video, and of images given to `vol_av_encoder_write_frame()`. */
+  int w, h;
+  /** Number of channels in images given to `vol_av_encoder_write_frame()`. 3 for RGB or 4 for RGBA. */
+  int n_chans;
+  /** Number of frames given to `vol_av_encoder_write_frame()` so far. */
+  int64_t n_frames;
+
+  /** Where this encoder's log messages go. If NULL then the global log callback is used. Kept by `vol_av_encoder_open()` and `vol_av_encoder_close()`. */
+  const struct vol_av_log_sink_t* log_sink_ptr;
+} vol_av_encoder_t;
+
 /** In your application these enum values can be used to filter out or categorise messages given by vol_av_log_callback. */
 typedef enum vol_av_log_type_t {
   VOL_AV_LOG_TYPE_INFO = 0, //
@@ -78,12 +110,38 @@ typedef enum vol_av_log_type_t {
   VOL_AV_LOG_STR_MAX_LEN // Not an error type, just used to count the error types.
 } vol_av_log_type_t;
 
+/** Messages less severe than this are removed when the library is compiled, including the evaluation of their arguments.
+ * Severity order is DEBUG < INFO < WARNING < ERROR. e.g. build with `-DVOL_AV_LOG_MIN_TYPE=VOL_AV_LOG_TYPE_WARNING` for release plugins.
+ */
+#ifndef VOL_AV_LOG_MIN_TYPE
+#define VOL_AV_LOG_MIN_TYPE VOL_AV_LOG_TYPE_DEBUG
+#endif
+
+/** A destination for one video's log messages, set via the `log_sink_ptr` of `vol_av_video_t` or `vol_av_encoder_t`.
+ * Videos with separate sinks don't share any logging state, so they can be decoded and logged from separate threads.
+ * The sink must outlive any struct that points to it.
+ */
+typedef struct vol_av_log_sink_t {
+  /** Called for each message of at least `min_log_type`. If NULL then messages are discarded. */
+  void ( *callback_ptr )( vol_av_log_type_t log_type, const char* message_str, void* user_ptr );
+  /** Passed through to `callback_ptr`, e.g. a `vol_log_ring_t` pointer. */
+  void* user_ptr;
+  /** Least severe type of message to pass on. Messages are filtered before they are formatted. The zero value, INFO, discards DEBUG messages. */
+  vol_av_log_type_t min_log_type;
+} vol_av_log_sink_t;
+
+/** To silence log output or pipe log messages into a user function. This is used for videos without their own `log_sink_ptr`. */
 VOL_AV_EXPORT void vol_av_set_log_callback( void ( *user_function_ptr )( vol_av_log_type_t log_type, const char* message_str ) );
 
 VOL_AV_EXPORT void vol_av_reset_log_callback( void );
 
+/** Set the least severe type of message passed to the global log callback. Defaults to VOL_AV_LOG_TYPE_DEBUG, so everything is logged.
+ * Filtered messages are not formatted, so they cost almost nothing.
+ */
+VOL_AV_EXPORT void vol_av_set_log_level( vol_av_log_type_t min_log_type );
+
 /** Open a video file given by `filename`.
- * @param filename File path to the movie file to open. Must not be NULL.
+ * @param filename File path to the movie file to open, or a URL such as http://. Must not be NULL.
  * @param info_ptr This function populates the struct pointed to with context data about the file. Must not be NULL.
  * @return         False on error. If info_ptr points to a struct where _context_ptr is not initialised to NULL this function will fail and return false.
  */
@@ -143,6 +201,51 @@ while ( next_frame > frame ) {
 */
 VOL_AV_EXPORT bool vol_av_read_next_frame( vol_av_video_t* info_ptr );
 
+/** Decode the next frame without converting it to RGB. `pixels_ptr` still holds the last converted frame.
+ * Players use this to decode past frames they will drop, which must still be decoded as later frames are predicted from them, at less cost.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         False on error, or at the end of the file when no more frames come out of the decoder.
+ */
+VOL_AV_EXPORT bool vol_av_decode_next_frame( vol_av_video_t* info_ptr );
+
+/** Convert the frame last decoded by `vol_av_decode_next_frame()` to RGB in `pixels_ptr`, as `vol_av_read_next_frame()` would have.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         False if no frame has been decoded yet.
+ */
+VOL_AV_EXPORT bool vol_av_convert_frame( vol_av_video_t* info_ptr );
+
+/** Get the presentation time of the most recently decoded frame, from its timestamp in the container.
+ * Frames don't always come one frame period apart: encoders and editors can drop or duplicate frames.
+ * So pair video with geometry by this rather than by counting frames.
+ * @param info_ptr The context data for the file. Must not be NULL.
+ * @return         Seconds from the start of the video stream, or -1.0 if no frame has been decoded yet.
+ */
+VOL_AV_EXPORT double vol_av_frame_pts_s( const vol_av_video_t* info_ptr );
+
+/** Create a video file and open an H.264 encoder for it. The container format is chosen from the file extension, e.g. `.mp4`.
+ * @param filename  File path to write. Must not be NULL.
+ * @param w,h       Dimensions of the video in pixels. Must be even.
+ * @param n_chans   Channels in the images that will be given to `vol_av_encoder_write_frame()`. 3 for RGB or 4 for RGBA. Alpha is discarded.
+ * @param fps       Frame rate in Hz. Must be > 0.
+ * @param bit_rate  Target bit rate in bits per second. Must be > 0.
+ * @param enc_ptr   This function populates the struct pointed to with context data about the file. Must not be NULL, and `_context_ptr` must be NULL.
+ * @return          False on error, in which case the encoder is closed again.
+ */
+VOL_AV_EXPORT bool vol_av_encoder_open( const char* filename, int w, int h, int n_chans, double fps, int64_t bit_rate, vol_av_encoder_t* enc_ptr );
+
+/** Encode one image as the next frame of the video.
+ * @param enc_ptr    The encoder context. Must not be NULL.
+ * @param pixels_ptr Tightly-packed image of `enc_ptr->w` * `enc_ptr->h` pixels with `enc_ptr->n_chans` channels. Must not be NULL.
+ * @return           False on error.
+ */
+VOL_AV_EXPORT bool vol_av_encoder_write_frame( vol_av_encoder_t* enc_ptr, const uint8_t* pixels_ptr );
+
+/** Flush any frames still buffered in the encoder, finish the file, and release resources.
+ * @param enc_ptr The encoder context. Must not be NULL.
+ * @return        False on error. Resources are still released.
+ */
+VOL_AV_EXPORT bool vol_av_encoder_close( vol_av_encoder_t* enc_ptr );
+
 #ifdef __cplusplus
 }
 #endif /* CPP */
@@ -3,7 +3,7 @@
  *
  * vol_basis | .basis Transcoding Wrapper.
  * --------- | ---------------------
- * Version   | 0.1
+ * Version   | 0.2
  * Authors   | See matching header file.
  * Copyright | 2023, Volograms (http://volograms.com/)
  * Language  | C++
@@ -12,6 +12,13 @@
  */
 
 #include "vol_basis.h"
+#ifdef VOL_TRACE
+#include "vol_trace.h"
+#else
+// Without VOL_TRACE the trace markers compile to nothing, so vol_trace.h isn't needed to build this library.
+#define VOL_TRACE_BEGIN( name_str ) ( (void)0 )
+#define VOL_TRACE_END( name_str ) ( (void)0 )
+#endif
 #include "basis_universal/transcoder/basisu_transcoder.h"
 #include <stdint.h>
 #include <stdio.h>
@@ -54,7 +61,10 @@ bool vol_basis_transcode( //
     fprintf( stderr, "ERROR vol_basis_transcode not ready to transcode.\n" );
     return false;
   }
-  if ( !trans.transcode_image_level( data_ptr, data_sz, image_index, level_index, output_blocks_ptr, output_blocks_sz, fmt ) ) {
+  VOL_TRACE_BEGIN( "vol_basis_transcode" );
+  bool transcode_ok = trans.transcode_image_level( data_ptr, data_sz, image_index, level_index, output_blocks_ptr, output_blocks_sz, fmt );
+  VOL_TRACE_END( "vol_basis_transcode" );
+  if ( !transcode_ok ) {
     fprintf( stderr, "ERROR vol_basis_transcode transcoding image level failed.\n" );
     return false;
   }
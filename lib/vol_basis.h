@@ -3,7 +3,7 @@
  *
  * vol_basis | .basis Transcoding Wrapper.
  * --------- | ---------------------
- * Version   | 0.1
+ * Version   | 0.2
  * Authors   | Anton Gerdelan     <anton@volograms.com>
  *           | Patrick Geoghegan  <patrick@volograms.com>
  * Copyright | 2023, Volograms (http://volograms.com/)
@@ -13,6 +13,7 @@
  *
  * History
  * -------
+ * - 0.2 (2026/10/18) - Trace marker around transcoding, when built with VOL_TRACE defined. See vol_trace.h.
  * - 0.1 (2023/04/26) - First version.
  */
 
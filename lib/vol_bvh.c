@@ -0,0 +1,780 @@
+/** @file vol_bvh.c
+ * Volograms Bounding Volume Hierarchy API
+ *
+ * vol_bvh   | Ray and nearest-point queries on vologram frames, for picking and measuring.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * References
+ * ----------
+ * - Ingo Wald, "On fast Construction of SAH-based Bounding Volume Hierarchies", 2007. For binned SAH builds.
+ * - Tomas Möller and Ben Trumbore, "Fast, Minimum Storage Ray/Triangle Intersection", 1997.
+ * - Christer Ericson, "Real-Time Collision Detection", 2005, section 5.1.5. For the closest point on a triangle.
+ */
+
+#include "vol_bvh.h"
+#include "vol_thread.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Centroid bins per axis when choosing a split.
+#define VOL_BVH_N_BINS 16
+/// Nodes with more triangles than this are always split, even if the SAH says a leaf would be cheaper.
+#define VOL_BVH_MAX_LEAF_TRIS 8
+/// Cost of visiting a node, relative to testing a triangle, for the SAH.
+#define VOL_BVH_TRAVERSAL_COST 1.0f
+/// Below this depth nodes are split at the median triangle instead of by the SAH, which bounds the tree's depth however the triangles are spread.
+#define VOL_BVH_MAX_SAH_DEPTH 48
+/// Deeper than any tree can be: `VOL_BVH_MAX_SAH_DEPTH`, plus 32 median splits of up to 2^32 triangles.
+#define VOL_BVH_STACK_SZ 96
+/// Subtrees are built on worker threads once they have no more triangles than this, or fewer if there are many threads.
+#define VOL_BVH_TASK_MAX_TRIS 16384
+/// Subtrees with fewer triangles than this are too small to be worth handing to another thread.
+#define VOL_BVH_TASK_MIN_TRIS 1024
+
+/** BVH node, stored in depth-first order, so an inner node's left child directly follows it, and every subtree is a contiguous range of nodes. 32 bytes. */
+typedef struct _node_t {
+  float min[3];
+  uint32_t right_or_first; // Inner nodes: index of the right child. Leaves: first triangle in `tris_ptr`.
+  float max[3];
+  uint32_t n_tris; // 0 for inner nodes.
+} _node_t;
+
+struct vol_bvh_t {
+  _node_t* nodes_ptr;
+  uint32_t n_nodes;
+  /// Vertex indices of each triangle, 3 per triangle, reordered so each leaf's triangles are together. Copied from the frame, as 32-bit.
+  uint32_t* tris_ptr;
+  /// Index of each triangle in `tris_ptr` in the frame's original indices.
+  uint32_t* tri_ids_ptr;
+  uint32_t n_tris;
+  /// Frames refitted or queried with must have at least this many vertices, i.e. the largest index plus 1.
+  uint32_t min_vertices;
+  /// Subtrees that were built on worker threads, as node ranges [first, end), are refitted on worker threads too.
+  uint32_t* task_ranges_ptr;
+  uint32_t n_tasks;
+  /// Nodes above the subtrees, in depth-first order, which are refitted last, on the calling thread.
+  uint32_t* top_nodes_ptr;
+  uint32_t n_top_nodes;
+  uint32_t n_leaves;
+  uint32_t max_depth;
+};
+
+/*************************************************************************************************************************************************
+ * Building
+ *************************************************************************************************************************************************/
+
+/** Node of a tree while it's being built, before it's flattened into depth-first order. */
+typedef struct _build_node_t {
+  float min[3], max[3];
+  uint32_t left, right; // Indices in the same node list. Unused by leaves.
+  uint32_t first, count;
+  int32_t task_idx; // If not -1 then this node is a subtree built by a worker thread instead, from the task's node list.
+} _build_node_t;
+
+typedef struct _node_list_t {
+  _build_node_t* nodes_ptr;
+  uint32_t n, capacity;
+} _node_list_t;
+
+/** A subtree built by a worker thread, into its own node list, whose root is its first node. */
+typedef struct _task_t {
+  uint32_t first, count, depth;
+  _node_list_t list;
+  bool failed;
+} _task_t;
+
+/** A triangle's box and centroid. These are reordered in place as nodes are split, rather than an array of indices to them,
+ * so splits read memory in order instead of all over the place. */
+typedef struct _tri_ref_t {
+  float min[3], max[3];
+  float centroid[3];
+  uint32_t tri_idx;
+} _tri_ref_t;
+
+typedef struct _builder_t {
+  _tri_ref_t* refs_ptr;
+  uint32_t task_max_tris;
+  _task_t* tasks_ptr;
+  uint32_t n_tasks, tasks_capacity;
+} _builder_t;
+
+static uint32_t _index_get( const void* indices_ptr, uint32_t i, vol_mesh_index_type_t index_type ) {
+  switch ( index_type ) {
+  case VOL_MESH_INDEX_TYPE_U8: return ( (const uint8_t*)indices_ptr )[i];
+  case VOL_MESH_INDEX_TYPE_U16: return ( (const uint16_t*)indices_ptr )[i];
+  default: return ( (const uint32_t*)indices_ptr )[i];
+  }
+}
+
+static void _box_reset( float* min_ptr, float* max_ptr ) {
+  for ( int a = 0; a < 3; a++ ) {
+    min_ptr[a] = FLT_MAX;
+    max_ptr[a] = -FLT_MAX;
+  }
+}
+
+/** Written as selects rather than ifs, so compilers use min and max instructions instead of branches, which would be mispredicted often. */
+static inline void _box_grow( float* min_ptr, float* max_ptr, const float* p_min_ptr, const float* p_max_ptr ) {
+  min_ptr[0] = p_min_ptr[0] < min_ptr[0] ? p_min_ptr[0] : min_ptr[0];
+  min_ptr[1] = p_min_ptr[1] < min_ptr[1] ? p_min_ptr[1] : min_ptr[1];
+  min_ptr[2] = p_min_ptr[2] < min_ptr[2] ? p_min_ptr[2] : min_ptr[2];
+  max_ptr[0] = p_max_ptr[0] > max_ptr[0] ? p_max_ptr[0] : max_ptr[0];
+  max_ptr[1] = p_max_ptr[1] > max_ptr[1] ? p_max_ptr[1] : max_ptr[1];
+  max_ptr[2] = p_max_ptr[2] > max_ptr[2] ? p_max_ptr[2] : max_ptr[2];
+}
+
+/** @returns Half the surface area of a box, which is all the SAH needs, as it only compares ratios of areas. 0 for an empty box. */
+static float _box_half_area( const float* min_ptr, const float* max_ptr ) {
+  float d[3];
+  for ( int a = 0; a < 3; a++ ) {
+    d[a] = max_ptr[a] - min_ptr[a];
+    if ( d[a] < 0.0f ) { return 0.0f; }
+  }
+  return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+}
+
+static uint32_t _push_node( _node_list_t* list_ptr ) {
+  if ( list_ptr->n == list_ptr->capacity ) {
+    uint32_t capacity        = list_ptr->capacity ? list_ptr->capacity * 2 : 64;
+    _build_node_t* nodes_ptr = realloc( list_ptr->nodes_ptr, capacity * sizeof( _build_node_t ) );
+    if ( !nodes_ptr ) { return UINT32_MAX; }
+    list_ptr->nodes_ptr = nodes_ptr;
+    list_ptr->capacity  = capacity;
+  }
+  return list_ptr->n++;
+}
+
+static int _bin_of( float c, float c_min, float scale, int n_bins ) {
+  int b = (int)( ( c - c_min ) * scale );
+  return b < 0 ? 0 : ( b >= n_bins ? n_bins - 1 : b );
+}
+
+static void _swap_refs( _tri_ref_t* a_ptr, _tri_ref_t* b_ptr ) {
+  _tri_ref_t tmp = *a_ptr;
+  *a_ptr         = *b_ptr;
+  *b_ptr         = tmp;
+}
+
+/** Reorder `refs_ptr[first .. first + count)` so the `k`th triangle is the one it would be if sorted by centroid on `axis`, with smaller ones before it. */
+static void _select_median( _tri_ref_t* refs_ptr, uint32_t first, uint32_t count, int axis, uint32_t k ) {
+  uint32_t lo = first, hi = first + count - 1;
+  while ( lo < hi ) {
+    float pivot = refs_ptr[( lo + hi ) / 2].centroid[axis];
+    uint32_t i  = lo, j = hi;
+    while ( i <= j ) {
+      while ( refs_ptr[i].centroid[axis] < pivot ) { i++; }
+      while ( refs_ptr[j].centroid[axis] > pivot ) { j--; }
+      if ( i <= j ) {
+        _swap_refs( &refs_ptr[i], &refs_ptr[j] );
+        i++;
+        if ( 0 == j ) { break; }
+        j--;
+      }
+    }
+    if ( k <= j ) {
+      hi = j;
+    } else if ( k >= i ) {
+      lo = i;
+    } else {
+      break;
+    }
+  }
+}
+
+/** Choose where to split a node's triangles, and reorder them so the left child's come first.
+ * @param c_min, c_max Bounds of the centroids of the node's triangles.
+ * @returns            The number of triangles in the left child, or 0 to make the node a leaf.
+ */
+static uint32_t _split( const _builder_t* b_ptr, const _build_node_t* node_ptr, const float* c_min, const float* c_max, uint32_t depth ) {
+  const uint32_t first = node_ptr->first, count = node_ptr->count;
+  if ( count <= 1 ) { return 0; }
+  // Small nodes get a bin per triangle at most, as emptier bins cost as much to sweep and don't find better splits.
+  const int n_bins = count < VOL_BVH_N_BINS ? (int)count : VOL_BVH_N_BINS;
+  int widest_axis  = 0;
+  for ( int a = 1; a < 3; a++ ) {
+    if ( c_max[a] - c_min[a] > c_max[widest_axis] - c_min[widest_axis] ) { widest_axis = a; }
+  }
+
+  if ( depth < VOL_BVH_MAX_SAH_DEPTH ) {
+    float best_cost = FLT_MAX;
+    int best_axis   = -1, best_bin = 0;
+    for ( int a = 0; a < 3; a++ ) {
+      float extent = c_max[a] - c_min[a];
+      if ( !( extent > 0.0f ) ) { continue; }
+      float scale                         = n_bins * ( 1.0f - FLT_EPSILON ) / extent;
+      uint32_t bin_counts[VOL_BVH_N_BINS] = { 0 };
+      float bin_min[VOL_BVH_N_BINS][3], bin_max[VOL_BVH_N_BINS][3];
+      for ( int k = 0; k < n_bins; k++ ) { _box_reset( bin_min[k], bin_max[k] ); }
+      for ( uint32_t i = first; i < first + count; i++ ) {
+        const _tri_ref_t* ref_ptr = &b_ptr->refs_ptr[i];
+        int k                     = _bin_of( ref_ptr->centroid[a], c_min[a], scale, n_bins );
+        bin_counts[k]++;
+        _box_grow( bin_min[k], bin_max[k], ref_ptr->min, ref_ptr->max );
+      }
+      // Sweep from the right to get the cost of everything right of each split plane, then from the left to add the left side's.
+      float right_area[VOL_BVH_N_BINS];
+      uint32_t right_count[VOL_BVH_N_BINS];
+      float r_min[3], r_max[3];
+      _box_reset( r_min, r_max );
+      uint32_t n = 0;
+      for ( int k = n_bins - 1; k > 0; k-- ) {
+        _box_grow( r_min, r_max, bin_min[k], bin_max[k] );
+        n += bin_counts[k];
+        right_area[k]  = _box_half_area( r_min, r_max );
+        right_count[k] = n;
+      }
+      float l_min[3], l_max[3];
+      _box_reset( l_min, l_max );
+      n = 0;
+      for ( int k = 0; k < n_bins - 1; k++ ) { // Split between bin k and k + 1.
+        _box_grow( l_min, l_max, bin_min[k], bin_max[k] );
+        n += bin_counts[k];
+        if ( 0 == n || 0 == right_count[k + 1] ) { continue; }
+        float cost = _box_half_area( l_min, l_max ) * n + right_area[k + 1] * right_count[k + 1];
+        if ( cost < best_cost ) {
+          best_cost = cost;
+          best_axis = a;
+          best_bin  = k;
+        }
+      }
+    }
+    if ( best_axis >= 0 ) {
+      float parent_area = _box_half_area( node_ptr->min, node_ptr->max );
+      float split_cost  = VOL_BVH_TRAVERSAL_COST + ( parent_area > 0.0f ? best_cost / parent_area : (float)count );
+      if ( split_cost >= (float)count && count <= VOL_BVH_MAX_LEAF_TRIS ) { return 0; }
+      float scale = n_bins * ( 1.0f - FLT_EPSILON ) / ( c_max[best_axis] - c_min[best_axis] );
+      uint32_t i  = first, j = first + count;
+      while ( i < j ) {
+        if ( _bin_of( b_ptr->refs_ptr[i].centroid[best_axis], c_min[best_axis], scale, n_bins ) <= best_bin ) {
+          i++;
+        } else {
+          j--;
+          _swap_refs( &b_ptr->refs_ptr[i], &b_ptr->refs_ptr[j] );
+        }
+      }
+      return i - first;
+    }
+  }
+  if ( count <= VOL_BVH_MAX_LEAF_TRIS ) { return 0; }
+  // Too deep for the SAH, or every centroid is in the same place, so split at the median instead.
+  _select_median( b_ptr->refs_ptr, first, count, widest_axis, first + count / 2 );
+  return count / 2;
+}
+
+/** Build the subtree over `refs_ptr[first .. first + count)` into a node list, splitting off tasks for worker threads if `tasks_ptr` is not NULL.
+ * @returns The index of the subtree's root in the node list, or UINT32_MAX if out of memory.
+ */
+static uint32_t _build_subtree( _builder_t* b_ptr, _node_list_t* list_ptr, uint32_t first, uint32_t count, uint32_t depth, bool make_tasks ) {
+  uint32_t idx = _push_node( list_ptr );
+  if ( UINT32_MAX == idx ) { return UINT32_MAX; }
+  _build_node_t* node_ptr = &list_ptr->nodes_ptr[idx];
+  *node_ptr               = ( _build_node_t ){ .first = first, .count = count, .task_idx = -1 };
+  // Bounds are gathered in locals, as the compiler can't tell that writes to the node don't change the triangles.
+  float b_min[3], b_max[3], c_min[3], c_max[3];
+  _box_reset( b_min, b_max );
+  _box_reset( c_min, c_max );
+  for ( uint32_t i = first; i < first + count; i++ ) {
+    const _tri_ref_t* ref_ptr = &b_ptr->refs_ptr[i];
+    _box_grow( b_min, b_max, ref_ptr->min, ref_ptr->max );
+    _box_grow( c_min, c_max, ref_ptr->centroid, ref_ptr->centroid );
+  }
+  memcpy( node_ptr->min, b_min, sizeof( b_min ) );
+  memcpy( node_ptr->max, b_max, sizeof( b_max ) );
+
+  if ( make_tasks && count <= b_ptr->task_max_tris ) {
+    if ( b_ptr->n_tasks == b_ptr->tasks_capacity ) {
+      uint32_t capacity  = b_ptr->tasks_capacity ? b_ptr->tasks_capacity * 2 : 64;
+      _task_t* tasks_ptr = realloc( b_ptr->tasks_ptr, capacity * sizeof( _task_t ) );
+      if ( !tasks_ptr ) { return UINT32_MAX; }
+      b_ptr->tasks_ptr      = tasks_ptr;
+      b_ptr->tasks_capacity = capacity;
+    }
+    b_ptr->tasks_ptr[b_ptr->n_tasks] = ( _task_t ){ .first = first, .count = count, .depth = depth };
+    node_ptr->task_idx               = (int32_t)b_ptr->n_tasks++;
+    return idx;
+  }
+
+  uint32_t n_left = _split( b_ptr, node_ptr, c_min, c_max, depth );
+  if ( 0 == n_left ) { return idx; }
+  // Recursion may move the node list, so don't keep `node_ptr` across it.
+  uint32_t left = _build_subtree( b_ptr, list_ptr, first, n_left, depth + 1, make_tasks );
+  if ( UINT32_MAX == left ) { return UINT32_MAX; }
+  uint32_t right = _build_subtree( b_ptr, list_ptr, first + n_left, count - n_left, depth + 1, make_tasks );
+  if ( UINT32_MAX == right ) { return UINT32_MAX; }
+  list_ptr->nodes_ptr[idx].left  = left;
+  list_ptr->nodes_ptr[idx].right = right;
+  return idx;
+}
+
+static void _build_task( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  _builder_t* b_ptr = (_builder_t*)user_ptr;
+  _task_t* task_ptr = &b_ptr->tasks_ptr[item_idx];
+  // A binary tree with n leaves has 2n - 1 nodes, so the list never has to grow.
+  task_ptr->list.capacity  = task_ptr->count * 2 - 1;
+  task_ptr->list.nodes_ptr = malloc( task_ptr->list.capacity * sizeof( _build_node_t ) );
+  if ( !task_ptr->list.nodes_ptr ) {
+    task_ptr->failed = true;
+    return;
+  }
+  // Tasks only touch their own range of `refs_ptr`, so no locking is needed.
+  if ( UINT32_MAX == _build_subtree( b_ptr, &task_ptr->list, task_ptr->first, task_ptr->count, task_ptr->depth, false ) ) { task_ptr->failed = true; }
+}
+
+/** Copies the built trees into the BVH's nodes, in depth-first order. */
+typedef struct _flattener_t {
+  vol_bvh_t* bvh_ptr;
+  const _builder_t* b_ptr;
+  uint32_t n_tasks_done;
+} _flattener_t;
+
+static uint32_t _flatten( _flattener_t* f_ptr, const _node_list_t* list_ptr, uint32_t idx, uint32_t depth, bool is_top ) {
+  vol_bvh_t* bvh_ptr            = f_ptr->bvh_ptr;
+  const _build_node_t* node_ptr = &list_ptr->nodes_ptr[idx];
+  if ( node_ptr->task_idx >= 0 ) {
+    uint32_t root = bvh_ptr->n_nodes;
+    _flatten( f_ptr, &f_ptr->b_ptr->tasks_ptr[node_ptr->task_idx].list, 0, depth, false );
+    bvh_ptr->task_ranges_ptr[f_ptr->n_tasks_done * 2 + 0] = root;
+    bvh_ptr->task_ranges_ptr[f_ptr->n_tasks_done * 2 + 1] = bvh_ptr->n_nodes;
+    f_ptr->n_tasks_done++;
+    return root;
+  }
+
+  uint32_t out     = bvh_ptr->n_nodes++;
+  _node_t* out_ptr = &bvh_ptr->nodes_ptr[out];
+  memcpy( out_ptr->min, node_ptr->min, sizeof( out_ptr->min ) );
+  memcpy( out_ptr->max, node_ptr->max, sizeof( out_ptr->max ) );
+  if ( is_top ) { bvh_ptr->top_nodes_ptr[bvh_ptr->n_top_nodes++] = out; }
+  if ( 0 == node_ptr->left && 0 == node_ptr->right ) { // Leaf. The root is never a child, so 0 means no child.
+    out_ptr->right_or_first = node_ptr->first;
+    out_ptr->n_tris         = node_ptr->count;
+    bvh_ptr->n_leaves++;
+    if ( depth > bvh_ptr->max_depth ) { bvh_ptr->max_depth = depth; }
+    return out;
+  }
+  out_ptr->n_tris = 0;
+  _flatten( f_ptr, list_ptr, node_ptr->left, depth + 1, is_top );
+  uint32_t right                         = _flatten( f_ptr, list_ptr, node_ptr->right, depth + 1, is_top );
+  bvh_ptr->nodes_ptr[out].right_or_first = right;
+  return out;
+}
+
+vol_bvh_t* vol_bvh_build( const vol_mesh_frame_view_t* view_ptr, uint32_t n_threads ) {
+  if ( !view_ptr || 0 != view_ptr->n_indices % 3 ) { return NULL; }
+  if ( view_ptr->n_indices > 0 && ( !view_ptr->vertices_ptr || !view_ptr->indices_ptr ) ) { return NULL; }
+  if ( 0 == n_threads ) { n_threads = vol_thread_hardware_concurrency(); }
+
+  vol_bvh_t* bvh_ptr = calloc( 1, sizeof( vol_bvh_t ) );
+  if ( !bvh_ptr ) { return NULL; }
+  const uint32_t n_tris = view_ptr->n_indices / 3;
+  bvh_ptr->n_tris       = n_tris;
+  if ( 0 == n_tris ) { return bvh_ptr; }
+
+  _builder_t b          = ( _builder_t ){ .task_max_tris = VOL_BVH_TASK_MAX_TRIS };
+  _node_list_t top_list = ( _node_list_t ){ .n = 0 };
+  bvh_ptr->tris_ptr     = malloc( (size_t)n_tris * 3 * sizeof( uint32_t ) );
+  bvh_ptr->tri_ids_ptr  = malloc( (size_t)n_tris * sizeof( uint32_t ) );
+  b.refs_ptr            = malloc( (size_t)n_tris * sizeof( _tri_ref_t ) );
+  if ( !bvh_ptr->tris_ptr || !bvh_ptr->tri_ids_ptr || !b.refs_ptr ) { goto _build_fail; }
+
+  for ( uint32_t t = 0; t < n_tris; t++ ) {
+    _tri_ref_t* ref_ptr = &b.refs_ptr[t];
+    _box_reset( ref_ptr->min, ref_ptr->max );
+    for ( int j = 0; j < 3; j++ ) {
+      uint32_t v = _index_get( view_ptr->indices_ptr, t * 3 + j, view_ptr->index_type );
+      if ( v >= view_ptr->n_vertices ) { goto _build_fail; }
+      if ( v >= bvh_ptr->min_vertices ) { bvh_ptr->min_vertices = v + 1; }
+      const float* p = &view_ptr->vertices_ptr[v * 3];
+      _box_grow( ref_ptr->min, ref_ptr->max, p, p );
+    }
+    for ( int a = 0; a < 3; a++ ) { ref_ptr->centroid[a] = 0.5f * ( ref_ptr->min[a] + ref_ptr->max[a] ); }
+    ref_ptr->tri_idx = t;
+  }
+
+  // Split off enough subtrees to keep every thread busy, even if they take different times, unless that makes them too small to be worth it.
+  if ( n_threads > 1 ) {
+    uint32_t per_task = n_tris / ( n_threads * 4 );
+    if ( per_task < b.task_max_tris ) { b.task_max_tris = per_task < VOL_BVH_TASK_MIN_TRIS ? VOL_BVH_TASK_MIN_TRIS : per_task; }
+  } else {
+    b.task_max_tris = UINT32_MAX; // Build the whole tree as one task, so it can still be refitted as one.
+  }
+  if ( UINT32_MAX == _build_subtree( &b, &top_list, 0, n_tris, 0, true ) ) { goto _build_fail; }
+  vol_thread_parallel_for( b.n_tasks, n_threads, _build_task, &b );
+  uint32_t n_nodes = top_list.n - b.n_tasks;
+  for ( uint32_t i = 0; i < b.n_tasks; i++ ) {
+    if ( b.tasks_ptr[i].failed ) { goto _build_fail; }
+    n_nodes += b.tasks_ptr[i].list.n;
+  }
+
+  bvh_ptr->nodes_ptr       = malloc( (size_t)n_nodes * sizeof( _node_t ) );
+  bvh_ptr->task_ranges_ptr = malloc( ( b.n_tasks ? b.n_tasks : 1 ) * 2 * sizeof( uint32_t ) );
+  bvh_ptr->top_nodes_ptr   = malloc( ( top_list.n ? top_list.n : 1 ) * sizeof( uint32_t ) );
+  if ( !bvh_ptr->nodes_ptr || !bvh_ptr->task_ranges_ptr || !bvh_ptr->top_nodes_ptr ) { goto _build_fail; }
+  bvh_ptr->n_tasks = b.n_tasks;
+  _flattener_t f   = ( _flattener_t ){ .bvh_ptr = bvh_ptr, .b_ptr = &b };
+  _flatten( &f, &top_list, 0, 0, true );
+
+  // Triangles are stored in leaf order, so a leaf's triangles are next to each other in memory.
+  for ( uint32_t i = 0; i < n_tris; i++ ) {
+    uint32_t t              = b.refs_ptr[i].tri_idx;
+    bvh_ptr->tri_ids_ptr[i] = t;
+    for ( int j = 0; j < 3; j++ ) { bvh_ptr->tris_ptr[i * 3 + j] = _index_get( view_ptr->indices_ptr, t * 3 + j, view_ptr->index_type ); }
+  }
+
+  for ( uint32_t i = 0; i < b.n_tasks; i++ ) { free( b.tasks_ptr[i].list.nodes_ptr ); }
+  free( b.tasks_ptr );
+  free( top_list.nodes_ptr );
+  free( b.refs_ptr );
+  return bvh_ptr;
+
+_build_fail:
+  for ( uint32_t i = 0; i < b.n_tasks; i++ ) { free( b.tasks_ptr[i].list.nodes_ptr ); }
+  free( b.tasks_ptr );
+  free( top_list.nodes_ptr );
+  free( b.refs_ptr );
+  vol_bvh_free( bvh_ptr );
+  return NULL;
+}
+
+/*************************************************************************************************************************************************
+ * Refitting
+ *************************************************************************************************************************************************/
+
+static void _refit_node( vol_bvh_t* bvh_ptr, const float* vertices_ptr, uint32_t idx ) {
+  _node_t* node_ptr = &bvh_ptr->nodes_ptr[idx];
+  if ( node_ptr->n_tris ) {
+    float b_min[3], b_max[3];
+    _box_reset( b_min, b_max );
+    const uint32_t* tri_ptr = &bvh_ptr->tris_ptr[node_ptr->right_or_first * 3];
+    for ( uint32_t i = 0; i < node_ptr->n_tris * 3; i++ ) {
+      const float* p = &vertices_ptr[tri_ptr[i] * 3];
+      _box_grow( b_min, b_max, p, p );
+    }
+    memcpy( node_ptr->min, b_min, sizeof( b_min ) );
+    memcpy( node_ptr->max, b_max, sizeof( b_max ) );
+    return;
+  }
+  const _node_t* l_ptr = &bvh_ptr->nodes_ptr[idx + 1];
+  const _node_t* r_ptr = &bvh_ptr->nodes_ptr[node_ptr->right_or_first];
+  for ( int a = 0; a < 3; a++ ) {
+    node_ptr->min[a] = l_ptr->min[a] < r_ptr->min[a] ? l_ptr->min[a] : r_ptr->min[a];
+    node_ptr->max[a] = l_ptr->max[a] > r_ptr->max[a] ? l_ptr->max[a] : r_ptr->max[a];
+  }
+}
+
+typedef struct _refit_batch_t {
+  vol_bvh_t* bvh_ptr;
+  const float* vertices_ptr;
+} _refit_batch_t;
+
+static void _refit_task( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  _refit_batch_t* batch_ptr = (_refit_batch_t*)user_ptr;
+  const uint32_t* range_ptr = &batch_ptr->bvh_ptr->task_ranges_ptr[item_idx * 2];
+  // Children come after their parents in depth-first order, so going backwards fits every child before its parent.
+  for ( uint32_t i = range_ptr[1]; i > range_ptr[0]; i-- ) { _refit_node( batch_ptr->bvh_ptr, batch_ptr->vertices_ptr, i - 1 ); }
+}
+
+bool vol_bvh_refit( vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr, uint32_t n_threads ) {
+  if ( !bvh_ptr || !view_ptr || view_ptr->n_vertices < bvh_ptr->min_vertices ) { return false; }
+  if ( 0 == bvh_ptr->n_nodes ) { return true; }
+  if ( !view_ptr->vertices_ptr ) { return false; }
+
+  if ( 1 == n_threads || bvh_ptr->n_tasks < 2 ) {
+    for ( uint32_t i = bvh_ptr->n_nodes; i > 0; i-- ) { _refit_node( bvh_ptr, view_ptr->vertices_ptr, i - 1 ); }
+    return true;
+  }
+  _refit_batch_t batch = ( _refit_batch_t ){ .bvh_ptr = bvh_ptr, .vertices_ptr = view_ptr->vertices_ptr };
+  vol_thread_parallel_for( bvh_ptr->n_tasks, n_threads, _refit_task, &batch );
+  for ( uint32_t i = bvh_ptr->n_top_nodes; i > 0; i-- ) { _refit_node( bvh_ptr, view_ptr->vertices_ptr, bvh_ptr->top_nodes_ptr[i - 1] ); }
+  return true;
+}
+
+/*************************************************************************************************************************************************
+ * Queries
+ *************************************************************************************************************************************************/
+
+static bool _view_ok( const vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr ) {
+  return bvh_ptr && view_ptr && bvh_ptr->n_nodes > 0 && view_ptr->vertices_ptr && view_ptr->n_vertices >= bvh_ptr->min_vertices;
+}
+
+/** @returns Distance along the ray to where it enters the box, or INFINITY if it misses the box or enters it after `t_max`.
+ * A NaN from a zero direction component times an infinite inverse leaves that slab out of the test, which can only add false positives.
+ */
+static inline float _ray_box( const _node_t* node_ptr, const float* origin, const float* inv_dir, float t_max ) {
+  float t_near = 0.0f, t_far = t_max;
+  for ( int a = 0; a < 3; a++ ) {
+    float t0 = ( node_ptr->min[a] - origin[a] ) * inv_dir[a];
+    float t1 = ( node_ptr->max[a] - origin[a] ) * inv_dir[a];
+    if ( t0 > t1 ) {
+      float tmp = t0;
+      t0        = t1;
+      t1        = tmp;
+    }
+    if ( t0 > t_near ) { t_near = t0; }
+    if ( t1 < t_far ) { t_far = t1; }
+  }
+  return t_near <= t_far ? t_near : INFINITY;
+}
+
+/** Möller-Trumbore ray-triangle intersection, without back-face culling. Updates `hit_ptr` if the hit is closer than `hit_ptr->t`. */
+static inline bool _ray_triangle( const float* origin, const float* dir, const float* p0, const float* p1, const float* p2, vol_bvh_hit_t* hit_ptr ) {
+  float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+  float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+  float p[3]  = { dir[1] * e2[2] - dir[2] * e2[1], dir[2] * e2[0] - dir[0] * e2[2], dir[0] * e2[1] - dir[1] * e2[0] };
+  float det   = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+  if ( det == 0.0f ) { return false; } // Parallel to the triangle, or a degenerate triangle.
+  float inv_det = 1.0f / det;
+  float s[3]    = { origin[0] - p0[0], origin[1] - p0[1], origin[2] - p0[2] };
+  float u       = ( s[0] * p[0] + s[1] * p[1] + s[2] * p[2] ) * inv_det;
+  if ( u < 0.0f || u > 1.0f ) { return false; }
+  float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+  float v    = ( dir[0] * q[0] + dir[1] * q[1] + dir[2] * q[2] ) * inv_det;
+  if ( v < 0.0f || u + v > 1.0f ) { return false; }
+  float t = ( e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2] ) * inv_det;
+  if ( !( t >= 0.0f && t < hit_ptr->t ) ) { return false; }
+  hit_ptr->t = t;
+  hit_ptr->u = u;
+  hit_ptr->v = v;
+  return true;
+}
+
+bool vol_bvh_raycast( const vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr, const float origin[3], const float direction[3],
+  float t_max, vol_bvh_hit_t* hit_ptr ) {
+  if ( !_view_ok( bvh_ptr, view_ptr ) || !origin || !direction || !hit_ptr ) { return false; }
+
+  const float* vertices_ptr = view_ptr->vertices_ptr;
+  const float inv_dir[3]    = { 1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2] };
+  vol_bvh_hit_t best        = ( vol_bvh_hit_t ){ .t = t_max };
+  uint32_t best_i           = UINT32_MAX;
+  // Each entry is a node still to visit, and where the ray enters its box, so it can be skipped if a closer hit has been found since.
+  uint32_t stack_nodes[VOL_BVH_STACK_SZ];
+  float stack_ts[VOL_BVH_STACK_SZ];
+  uint32_t n_stack = 0;
+
+  uint32_t idx = 0;
+  float t_idx  = _ray_box( &bvh_ptr->nodes_ptr[0], origin, inv_dir, best.t );
+  if ( t_idx == INFINITY ) { return false; }
+  for ( ;; ) {
+    const _node_t* node_ptr = &bvh_ptr->nodes_ptr[idx];
+    if ( node_ptr->n_tris ) {
+      for ( uint32_t i = node_ptr->right_or_first; i < node_ptr->right_or_first + node_ptr->n_tris; i++ ) {
+        const uint32_t* tri_ptr = &bvh_ptr->tris_ptr[i * 3];
+        if ( _ray_triangle( origin, direction, &vertices_ptr[tri_ptr[0] * 3], &vertices_ptr[tri_ptr[1] * 3], &vertices_ptr[tri_ptr[2] * 3], &best ) ) {
+          best_i = i;
+        }
+      }
+    } else {
+      uint32_t near_idx = idx + 1, far_idx = node_ptr->right_or_first;
+      float t_near      = _ray_box( &bvh_ptr->nodes_ptr[near_idx], origin, inv_dir, best.t );
+      float t_far       = _ray_box( &bvh_ptr->nodes_ptr[far_idx], origin, inv_dir, best.t );
+      if ( t_far < t_near ) {
+        float t_tmp  = t_near;
+        t_near       = t_far;
+        t_far        = t_tmp;
+        uint32_t tmp = near_idx;
+        near_idx     = far_idx;
+        far_idx      = tmp;
+      }
+      if ( t_near != INFINITY ) {
+        if ( t_far != INFINITY ) {
+          stack_nodes[n_stack] = far_idx;
+          stack_ts[n_stack++]  = t_far;
+        }
+        idx = near_idx;
+        continue;
+      }
+    }
+    // Pop the next node, skipping those that the ray enters beyond the closest hit so far.
+    do {
+      if ( 0 == n_stack ) { goto _raycast_done; }
+      n_stack--;
+    } while ( stack_ts[n_stack] > best.t );
+    idx = stack_nodes[n_stack];
+  }
+
+_raycast_done:
+  if ( UINT32_MAX == best_i ) { return false; }
+  best.tri_idx = bvh_ptr->tri_ids_ptr[best_i];
+  for ( int a = 0; a < 3; a++ ) { best.point[a] = origin[a] + direction[a] * best.t; }
+  *hit_ptr = best;
+  return true;
+}
+
+/** @returns The squared distance from a point to a box, or 0 if it's inside. */
+static inline float _point_box_sq( const _node_t* node_ptr, const float* p ) {
+  float d_sq = 0.0f;
+  for ( int a = 0; a < 3; a++ ) {
+    float d = 0.0f;
+    if ( p[a] < node_ptr->min[a] ) {
+      d = node_ptr->min[a] - p[a];
+    } else if ( p[a] > node_ptr->max[a] ) {
+      d = p[a] - node_ptr->max[a];
+    }
+    d_sq += d * d;
+  }
+  return d_sq;
+}
+
+/** Closest point on triangle `a`, `b`, `c` to `p`, from Ericson's book, by which of the triangle's Voronoi regions `p` is in.
+ * @returns The squared distance, with barycentric coordinates for `b` and `c` in `u_ptr` and `v_ptr`.
+ */
+static float _point_triangle_sq( const float* p, const float* a, const float* b, const float* c, float* u_ptr, float* v_ptr, float* closest_ptr ) {
+  float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+  float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+  float ap[3] = { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+  float d1    = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+  float d2    = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+  float u     = 0.0f, v = 0.0f;
+  if ( d1 <= 0.0f && d2 <= 0.0f ) { goto _pt_found; } // Vertex a.
+
+  float bp[3] = { p[0] - b[0], p[1] - b[1], p[2] - b[2] };
+  float d3    = ab[0] * bp[0] + ab[1] * bp[1] + ab[2] * bp[2];
+  float d4    = ac[0] * bp[0] + ac[1] * bp[1] + ac[2] * bp[2];
+  if ( d3 >= 0.0f && d4 <= d3 ) { // Vertex b.
+    u = 1.0f;
+    goto _pt_found;
+  }
+  float vc = d1 * d4 - d3 * d2;
+  if ( vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f ) { // Edge ab.
+    u = d1 / ( d1 - d3 );
+    goto _pt_found;
+  }
+
+  float cp[3] = { p[0] - c[0], p[1] - c[1], p[2] - c[2] };
+  float d5    = ab[0] * cp[0] + ab[1] * cp[1] + ab[2] * cp[2];
+  float d6    = ac[0] * cp[0] + ac[1] * cp[1] + ac[2] * cp[2];
+  if ( d6 >= 0.0f && d5 <= d6 ) { // Vertex c.
+    v = 1.0f;
+    goto _pt_found;
+  }
+  float vb = d5 * d2 - d1 * d6;
+  if ( vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f ) { // Edge ac.
+    v = d2 / ( d2 - d6 );
+    goto _pt_found;
+  }
+  float va = d3 * d6 - d5 * d4;
+  if ( va <= 0.0f && ( d4 - d3 ) >= 0.0f && ( d5 - d6 ) >= 0.0f ) { // Edge bc.
+    v = ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) );
+    u = 1.0f - v;
+    goto _pt_found;
+  }
+  float denom = va + vb + vc;
+  if ( denom > 0.0f ) { // Inside the face. A degenerate triangle's face has no inside, and is covered by its edges above.
+    u = vb / denom;
+    v = vc / denom;
+  }
+
+_pt_found:
+  *u_ptr     = u;
+  *v_ptr     = v;
+  float d_sq = 0.0f;
+  for ( int i = 0; i < 3; i++ ) {
+    closest_ptr[i] = a[i] + ab[i] * u + ac[i] * v;
+    float d        = p[i] - closest_ptr[i];
+    d_sq += d * d;
+  }
+  return d_sq;
+}
+
+bool vol_bvh_nearest_point( const vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr, const float point[3], float max_distance,
+  vol_bvh_nearest_t* nearest_ptr ) {
+  if ( !_view_ok( bvh_ptr, view_ptr ) || !point || !nearest_ptr || !( max_distance >= 0.0f ) ) { return false; }
+
+  const float* vertices_ptr = view_ptr->vertices_ptr;
+  float best_sq             = max_distance == INFINITY ? INFINITY : max_distance * max_distance;
+  vol_bvh_nearest_t best    = ( vol_bvh_nearest_t ){ .tri_idx = UINT32_MAX };
+  uint32_t stack_nodes[VOL_BVH_STACK_SZ];
+  float stack_ds[VOL_BVH_STACK_SZ];
+  uint32_t n_stack = 0;
+
+  uint32_t idx = 0;
+  if ( _point_box_sq( &bvh_ptr->nodes_ptr[0], point ) > best_sq ) { return false; }
+  for ( ;; ) {
+    const _node_t* node_ptr = &bvh_ptr->nodes_ptr[idx];
+    if ( node_ptr->n_tris ) {
+      for ( uint32_t i = node_ptr->right_or_first; i < node_ptr->right_or_first + node_ptr->n_tris; i++ ) {
+        const uint32_t* tri_ptr = &bvh_ptr->tris_ptr[i * 3];
+        float u, v, closest[3];
+        float d_sq = _point_triangle_sq( point, &vertices_ptr[tri_ptr[0] * 3], &vertices_ptr[tri_ptr[1] * 3], &vertices_ptr[tri_ptr[2] * 3], &u, &v, closest );
+        if ( d_sq <= best_sq ) {
+          best_sq = d_sq;
+          best    = ( vol_bvh_nearest_t ){ .tri_idx = bvh_ptr->tri_ids_ptr[i], .u = u, .v = v, .point = { closest[0], closest[1], closest[2] } };
+        }
+      }
+    } else {
+      uint32_t near_idx = idx + 1, far_idx = node_ptr->right_or_first;
+      float d_near      = _point_box_sq( &bvh_ptr->nodes_ptr[near_idx], point );
+      float d_far       = _point_box_sq( &bvh_ptr->nodes_ptr[far_idx], point );
+      if ( d_far < d_near ) {
+        float d_tmp  = d_near;
+        d_near       = d_far;
+        d_far        = d_tmp;
+        uint32_t tmp = near_idx;
+        near_idx     = far_idx;
+        far_idx      = tmp;
+      }
+      if ( d_near <= best_sq ) {
+        if ( d_far <= best_sq ) {
+          stack_nodes[n_stack] = far_idx;
+          stack_ds[n_stack++]  = d_far;
+        }
+        idx = near_idx;
+        continue;
+      }
+    }
+    do {
+      if ( 0 == n_stack ) { goto _nearest_done; }
+      n_stack--;
+    } while ( stack_ds[n_stack] > best_sq );
+    idx = stack_nodes[n_stack];
+  }
+
+_nearest_done:
+  if ( UINT32_MAX == best.tri_idx ) { return false; }
+  best.distance = sqrtf( best_sq );
+  *nearest_ptr  = best;
+  return true;
+}
+
+/*************************************************************************************************************************************************
+ * Lifetime
+ *************************************************************************************************************************************************/
+
+vol_bvh_stats_t vol_bvh_get_stats( const vol_bvh_t* bvh_ptr ) {
+  vol_bvh_stats_t stats = ( vol_bvh_stats_t ){ .n_triangles = 0 };
+  if ( !bvh_ptr ) { return stats; }
+  stats.n_triangles = bvh_ptr->n_tris;
+  stats.n_nodes     = bvh_ptr->n_nodes;
+  stats.n_leaves    = bvh_ptr->n_leaves;
+  stats.max_depth   = bvh_ptr->max_depth;
+  if ( 0 == bvh_ptr->n_nodes ) { return stats; }
+  float root_area = _box_half_area( bvh_ptr->nodes_ptr[0].min, bvh_ptr->nodes_ptr[0].max );
+  if ( !( root_area > 0.0f ) ) { return stats; }
+  double cost = 0.0;
+  for ( uint32_t i = 0; i < bvh_ptr->n_nodes; i++ ) {
+    const _node_t* node_ptr = &bvh_ptr->nodes_ptr[i];
+    double area             = _box_half_area( node_ptr->min, node_ptr->max ) / root_area;
+    cost += area * ( node_ptr->n_tris ? (double)node_ptr->n_tris : VOL_BVH_TRAVERSAL_COST );
+  }
+  stats.sah_cost = (float)cost;
+  return stats;
+}
+
+void vol_bvh_free( vol_bvh_t* bvh_ptr ) {
+  if ( !bvh_ptr ) { return; }
+  free( bvh_ptr->nodes_ptr );
+  free( bvh_ptr->tris_ptr );
+  free( bvh_ptr->tri_ids_ptr );
+  free( bvh_ptr->task_ranges_ptr );
+  free( bvh_ptr->top_nodes_ptr );
+  free( bvh_ptr );
+}
@@ -0,0 +1,131 @@
+/**  @file vol_bvh.h
+ * Volograms Bounding Volume Hierarchy API
+ *
+ * vol_bvh   | Ray and nearest-point queries on vologram frames, for picking and measuring.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * A bounding volume hierarchy (BVH) of axis-aligned boxes over a frame's triangles, so a query only tests the few triangles near it,
+ * instead of every triangle in the frame.
+ *
+ * A BVH is built once per keyframe, as that's when the triangles change. The tracked frames that follow share the keyframe's triangles,
+ * and only move the vertices, so `vol_bvh_refit()` updates the boxes for each of them, which is many times cheaper than a rebuild.
+ * Boxes that have been refitted can overlap more than rebuilt ones, so queries slow down a little as a segment's frames move away from its keyframe.
+ *
+ * Builds split triangles by the surface area heuristic (SAH), binned by centroid, which estimates the cost of a query from the areas of the boxes.
+ * The top of the tree is split on the calling thread, then the subtrees below it are built on worker threads with vol_thread,
+ * so link with `-pthread` on POSIX systems.
+ *
+ * Queries take the frame view that the BVH was last built or refitted with, for its vertices. They don't change the BVH,
+ * so any number of threads may query the same BVH at once, but not while it's being refitted.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_BVH_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_BVH_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include "vol_mesh.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Opaque BVH. Create with `vol_bvh_build()`. */
+typedef struct vol_bvh_t vol_bvh_t;
+
+/** Closest intersection of a ray with a frame's triangles. */
+typedef struct vol_bvh_hit_t {
+  /// Triangle hit, i.e. its first index is at `tri_idx * 3` in the frame's indices.
+  uint32_t tri_idx;
+  /// Distance along the ray, in multiples of the ray's direction vector.
+  float t;
+  /// Barycentric coordinates of the hit on the triangle's 2nd and 3rd vertices. The 1st vertex's is `1 - u - v`. Use these to interpolate UVs or normals.
+  float u, v;
+  /// Position of the hit.
+  float point[3];
+} vol_bvh_hit_t;
+
+/** Closest point on a frame's triangles to a query point. */
+typedef struct vol_bvh_nearest_t {
+  /// Triangle the point is on.
+  uint32_t tri_idx;
+  /// Distance from the query point.
+  float distance;
+  /// Barycentric coordinates of the point on the triangle's 2nd and 3rd vertices, as in `vol_bvh_hit_t`.
+  float u, v;
+  /// The closest point.
+  float point[3];
+} vol_bvh_nearest_t;
+
+/** Counters describing a BVH, e.g. to compare builds. */
+typedef struct vol_bvh_stats_t {
+  uint32_t n_triangles;
+  uint32_t n_nodes;     // Including leaves.
+  uint32_t n_leaves;
+  uint32_t max_depth;   // Of the deepest leaf. The root has depth 0.
+  float sah_cost;       // Estimated cost of a query, in triangle tests, from the areas of the boxes. Lower is better. Goes up as refits loosen the boxes.
+} vol_bvh_stats_t;
+
+/** Build a BVH over a frame's triangles. The triangles are copied, so the frame's indices may be freed afterwards.
+ * @param view_ptr  A keyframe's view. Only `vertices_ptr`, `n_vertices`, `indices_ptr`, `n_indices`, and `index_type` are used.
+ *                  `n_indices` must be a multiple of 3.
+ * @param n_threads Number of threads to use. 0 uses one per logical processor.
+ * @returns         NULL on invalid parameters, an out-of-range index, or out of memory.
+ */
+VOL_BVH_EXPORT vol_bvh_t* vol_bvh_build( const vol_mesh_frame_view_t* view_ptr, uint32_t n_threads );
+
+/** Update the BVH's boxes for the moved vertices of a frame that has the same triangles as the frame it was built with,
+ * i.e. a tracked frame of the same keyframe segment. The tree's structure is kept.
+ * @param view_ptr  Only `vertices_ptr` and `n_vertices` are used. Must have at least as many vertices as the frame the BVH was built with.
+ * @param n_threads Number of threads to use. 0 uses one per logical processor. 1 refits on the calling thread, which is quickest for smaller frames.
+ * @returns         False on invalid parameters.
+ */
+VOL_BVH_EXPORT bool vol_bvh_refit( vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr, uint32_t n_threads );
+
+/** Find the closest triangle hit by a ray. Both sides of triangles are hit.
+ * @param view_ptr   The view the BVH was last built or refitted with.
+ * @param origin     Start of the ray.
+ * @param direction  Direction of the ray. Needn't be unit length.
+ * @param t_max      Hits further than `t_max` multiples of `direction` are ignored. Use `INFINITY` for no limit.
+ * @param hit_ptr    Receives the closest hit. Must not be NULL.
+ * @returns          False if nothing was hit, or on invalid parameters.
+ */
+VOL_BVH_EXPORT bool vol_bvh_raycast( const vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr, const float origin[3], const float direction[3],
+  float t_max, vol_bvh_hit_t* hit_ptr );
+
+/** Find the closest point on any triangle to a point.
+ * @param view_ptr     The view the BVH was last built or refitted with.
+ * @param point        Query point.
+ * @param max_distance Points further away than this are ignored. Use `INFINITY` for no limit. A small limit makes the query quicker.
+ * @param nearest_ptr  Receives the closest point. Must not be NULL.
+ * @returns            False if no triangle is within `max_distance`, or on invalid parameters.
+ */
+VOL_BVH_EXPORT bool vol_bvh_nearest_point( const vol_bvh_t* bvh_ptr, const vol_mesh_frame_view_t* view_ptr, const float point[3], float max_distance,
+  vol_bvh_nearest_t* nearest_ptr );
+
+/** @returns Counters describing the BVH's current tree and boxes. */
+VOL_BVH_EXPORT vol_bvh_stats_t vol_bvh_get_stats( const vol_bvh_t* bvh_ptr );
+
+/** Free a BVH. Does nothing if `bvh_ptr` is NULL. */
+VOL_BVH_EXPORT void vol_bvh_free( vol_bvh_t* bvh_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
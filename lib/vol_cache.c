@@ -0,0 +1,335 @@
+/** @file vol_cache.c
+ * Volograms Mesh Cache API
+ *
+ * vol_cache | Time-sampled mesh cache files for VFX and DCC pipelines.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 64-bit offsets, as in vol_geom, for caches over 2GB.
+#if defined( _WIN32 ) || defined( _WIN64 )
+#define vol_cache_fseeko _fseeki64
+#define vol_cache_ftello _ftelli64
+#else
+#define vol_cache_fseeko fseeko
+#define vol_cache_ftello ftello
+#endif
+
+#define VOL_CACHE_ALIGN 16
+#define VOL_CACHE_CHUNK_HDR_SZ 16
+#define VOL_CACHE_TAG_SEGMENT 0x4D474553u // "SEGM" as little-endian bytes.
+#define VOL_CACHE_TAG_SAMPLE 0x504D4153u  // "SAMP" as little-endian bytes.
+
+/** One entry in the index at the end of the file. The same layout is used for segments and samples. */
+typedef struct _index_entry_t {
+  uint64_t offset;
+  uint32_t a; // A segment's first sample, or a sample's segment.
+  uint32_t b; // A segment's number of samples. Unused for samples.
+} _index_entry_t;
+
+struct vol_cache_writer_t {
+  FILE* f_ptr;
+  uint64_t offset; // Bytes written so far.
+  bool failed;
+  uint32_t flags;
+  float fps;
+  uint32_t n_vertices; // Of the current segment.
+  _index_entry_t* segments_ptr;
+  uint32_t n_segments, segments_capacity;
+  _index_entry_t* samples_ptr;
+  uint32_t n_samples, samples_capacity;
+};
+
+struct vol_cache_t {
+  FILE* f_ptr;
+  vol_cache_info_t info;
+  _index_entry_t* segments_ptr;
+  _index_entry_t* samples_ptr;
+  int64_t loaded_segment_idx; // Segment whose topology is in `topology_ptr`, or -1.
+  uint8_t* topology_ptr;      // Indices then UVs of the loaded segment.
+  size_t topology_capacity;
+  uint8_t* sample_data_ptr; // Positions then normals of the last sample read.
+  size_t sample_data_capacity;
+  vol_cache_sample_t sample; // Topology part of the last sample read.
+};
+
+static size_t _padded( size_t sz ) { return ( sz + VOL_CACHE_ALIGN - 1 ) & ~(size_t)( VOL_CACHE_ALIGN - 1 ); }
+
+static void _put_u32( uint8_t* dst_ptr, uint32_t v ) {
+  for ( int i = 0; i < 4; i++ ) { dst_ptr[i] = (uint8_t)( v >> ( 8 * i ) ); }
+}
+
+static void _put_u64( uint8_t* dst_ptr, uint64_t v ) {
+  for ( int i = 0; i < 8; i++ ) { dst_ptr[i] = (uint8_t)( v >> ( 8 * i ) ); }
+}
+
+static uint32_t _get_u32( const uint8_t* src_ptr ) {
+  uint32_t v = 0;
+  for ( int i = 0; i < 4; i++ ) { v |= (uint32_t)src_ptr[i] << ( 8 * i ); }
+  return v;
+}
+
+static uint64_t _get_u64( const uint8_t* src_ptr ) {
+  uint64_t v = 0;
+  for ( int i = 0; i < 8; i++ ) { v |= (uint64_t)src_ptr[i] << ( 8 * i ); }
+  return v;
+}
+
+/** Writes bytes followed by zeros up to the next 16-byte boundary. Failures are remembered and reported by `vol_cache_writer_close()`. */
+static void _write_padded( vol_cache_writer_t* writer_ptr, const void* data_ptr, size_t sz ) {
+  static const uint8_t zeros[VOL_CACHE_ALIGN] = { 0 };
+  size_t pad_sz                               = _padded( sz ) - sz;
+  if ( sz > 0 && 1 != fwrite( data_ptr, sz, 1, writer_ptr->f_ptr ) ) { writer_ptr->failed = true; }
+  if ( pad_sz > 0 && 1 != fwrite( zeros, pad_sz, 1, writer_ptr->f_ptr ) ) { writer_ptr->failed = true; }
+  writer_ptr->offset += sz + pad_sz;
+}
+
+/** Appends an index entry, growing the array as required. */
+static bool _push_entry( _index_entry_t** entries_ptr, uint32_t* n_ptr, uint32_t* capacity_ptr, _index_entry_t entry ) {
+  if ( *n_ptr == *capacity_ptr ) {
+    uint32_t capacity           = *capacity_ptr ? *capacity_ptr * 2 : 256;
+    _index_entry_t* resized_ptr = realloc( *entries_ptr, capacity * sizeof( _index_entry_t ) );
+    if ( !resized_ptr ) { return false; }
+    *entries_ptr  = resized_ptr;
+    *capacity_ptr = capacity;
+  }
+  ( *entries_ptr )[( *n_ptr )++] = entry;
+  return true;
+}
+
+static void _encode_hdr( uint8_t* hdr, uint32_t flags, uint32_t n_samples, uint32_t n_segments, float fps, uint64_t index_offset ) {
+  memset( hdr, 0, VOL_CACHE_HDR_SZ );
+  memcpy( hdr, "VOLCACHE", 8 );
+  _put_u32( &hdr[8], VOL_CACHE_VERSION );
+  _put_u32( &hdr[12], flags );
+  _put_u32( &hdr[16], n_samples );
+  _put_u32( &hdr[20], n_segments );
+  memcpy( &hdr[24], &fps, sizeof( float ) );
+  _put_u64( &hdr[32], index_offset );
+}
+
+vol_cache_writer_t* vol_cache_writer_open( const char* filename, float fps, uint32_t flags ) {
+  if ( !filename || !( fps > 0.0f ) ) { return NULL; }
+  vol_cache_writer_t* writer_ptr = calloc( 1, sizeof( vol_cache_writer_t ) );
+  if ( !writer_ptr ) { return NULL; }
+  writer_ptr->f_ptr = fopen( filename, "wb" );
+  if ( !writer_ptr->f_ptr ) {
+    free( writer_ptr );
+    return NULL;
+  }
+  writer_ptr->fps   = fps;
+  writer_ptr->flags = flags & ( VOL_CACHE_FLAG_NORMALS | VOL_CACHE_FLAG_UVS );
+
+  // Placeholder until the counts and index offset are known.
+  uint8_t hdr[VOL_CACHE_HDR_SZ];
+  _encode_hdr( hdr, writer_ptr->flags, 0, 0, fps, 0 );
+  _write_padded( writer_ptr, hdr, sizeof( hdr ) );
+  return writer_ptr;
+}
+
+bool vol_cache_write_segment(
+  vol_cache_writer_t* writer_ptr, const void* indices_ptr, uint32_t n_indices, uint32_t index_sz, const float* uvs_ptr, uint32_t n_vertices ) {
+  if ( !writer_ptr || !indices_ptr || ( 2 != index_sz && 4 != index_sz ) || 0 == n_vertices ) { return false; }
+  bool has_uvs = writer_ptr->flags & VOL_CACHE_FLAG_UVS;
+  if ( has_uvs && !uvs_ptr ) { return false; }
+
+  _index_entry_t entry = { .offset = writer_ptr->offset, .a = writer_ptr->n_samples, .b = 0 };
+  if ( !_push_entry( &writer_ptr->segments_ptr, &writer_ptr->n_segments, &writer_ptr->segments_capacity, entry ) ) { return false; }
+  uint8_t chunk_hdr[VOL_CACHE_CHUNK_HDR_SZ];
+  _put_u32( &chunk_hdr[0], VOL_CACHE_TAG_SEGMENT );
+  _put_u32( &chunk_hdr[4], n_vertices );
+  _put_u32( &chunk_hdr[8], n_indices );
+  _put_u32( &chunk_hdr[12], index_sz );
+  _write_padded( writer_ptr, chunk_hdr, sizeof( chunk_hdr ) );
+  _write_padded( writer_ptr, indices_ptr, (size_t)n_indices * index_sz );
+  if ( has_uvs ) { _write_padded( writer_ptr, uvs_ptr, (size_t)n_vertices * 2 * sizeof( float ) ); }
+  writer_ptr->n_vertices = n_vertices;
+  return !writer_ptr->failed;
+}
+
+bool vol_cache_write_sample( vol_cache_writer_t* writer_ptr, const float* positions_ptr, const float* normals_ptr ) {
+  if ( !writer_ptr || !positions_ptr || 0 == writer_ptr->n_segments ) { return false; }
+  bool has_normals = writer_ptr->flags & VOL_CACHE_FLAG_NORMALS;
+  if ( has_normals && !normals_ptr ) { return false; }
+
+  uint32_t segment_idx = writer_ptr->n_segments - 1;
+  _index_entry_t entry = { .offset = writer_ptr->offset, .a = segment_idx, .b = 0 };
+  if ( !_push_entry( &writer_ptr->samples_ptr, &writer_ptr->n_samples, &writer_ptr->samples_capacity, entry ) ) { return false; }
+  writer_ptr->segments_ptr[segment_idx].b++;
+  uint8_t chunk_hdr[VOL_CACHE_CHUNK_HDR_SZ];
+  _put_u32( &chunk_hdr[0], VOL_CACHE_TAG_SAMPLE );
+  _put_u32( &chunk_hdr[4], segment_idx );
+  _put_u32( &chunk_hdr[8], writer_ptr->n_vertices );
+  _put_u32( &chunk_hdr[12], 0 );
+  _write_padded( writer_ptr, chunk_hdr, sizeof( chunk_hdr ) );
+  _write_padded( writer_ptr, positions_ptr, (size_t)writer_ptr->n_vertices * 3 * sizeof( float ) );
+  if ( has_normals ) { _write_padded( writer_ptr, normals_ptr, (size_t)writer_ptr->n_vertices * 3 * sizeof( float ) ); }
+  return !writer_ptr->failed;
+}
+
+/** Writes index entries in batches, to avoid a write call per sample. */
+static void _write_index( vol_cache_writer_t* writer_ptr, const _index_entry_t* entries_ptr, uint32_t n_entries ) {
+  uint8_t batch[256 * 16];
+  for ( uint32_t first = 0; first < n_entries; first += 256 ) {
+    uint32_t n = n_entries - first < 256 ? n_entries - first : 256;
+    for ( uint32_t i = 0; i < n; i++ ) {
+      _put_u64( &batch[i * 16], entries_ptr[first + i].offset );
+      _put_u32( &batch[i * 16 + 8], entries_ptr[first + i].a );
+      _put_u32( &batch[i * 16 + 12], entries_ptr[first + i].b );
+    }
+    _write_padded( writer_ptr, batch, n * 16 );
+  }
+}
+
+bool vol_cache_writer_close( vol_cache_writer_t* writer_ptr ) {
+  if ( !writer_ptr ) { return false; }
+  uint64_t index_offset = writer_ptr->offset;
+  _write_index( writer_ptr, writer_ptr->segments_ptr, writer_ptr->n_segments );
+  _write_index( writer_ptr, writer_ptr->samples_ptr, writer_ptr->n_samples );
+
+  // Finish the header last, so a cache that was cut short is never mistaken for a complete one.
+  uint8_t hdr[VOL_CACHE_HDR_SZ];
+  _encode_hdr( hdr, writer_ptr->flags, writer_ptr->n_samples, writer_ptr->n_segments, writer_ptr->fps, index_offset );
+  bool ok = !writer_ptr->failed && 0 == vol_cache_fseeko( writer_ptr->f_ptr, 0, SEEK_SET ) && 1 == fwrite( hdr, sizeof( hdr ), 1, writer_ptr->f_ptr );
+  ok      = 0 == fclose( writer_ptr->f_ptr ) && ok;
+  free( writer_ptr->segments_ptr );
+  free( writer_ptr->samples_ptr );
+  free( writer_ptr );
+  return ok;
+}
+
+/** Reads index entries, checking they point inside the file. */
+static bool _read_index( FILE* f_ptr, _index_entry_t* entries_ptr, uint32_t n_entries, uint64_t index_offset ) {
+  uint8_t entry[16];
+  for ( uint32_t i = 0; i < n_entries; i++ ) {
+    if ( 1 != fread( entry, sizeof( entry ), 1, f_ptr ) ) { return false; }
+    entries_ptr[i].offset = _get_u64( &entry[0] );
+    entries_ptr[i].a      = _get_u32( &entry[8] );
+    entries_ptr[i].b      = _get_u32( &entry[12] );
+    if ( entries_ptr[i].offset < VOL_CACHE_HDR_SZ || entries_ptr[i].offset >= index_offset ) { return false; }
+  }
+  return true;
+}
+
+vol_cache_t* vol_cache_open( const char* filename ) {
+  if ( !filename ) { return NULL; }
+  vol_cache_t* cache_ptr = calloc( 1, sizeof( vol_cache_t ) );
+  if ( !cache_ptr ) { return NULL; }
+  cache_ptr->loaded_segment_idx = -1;
+  cache_ptr->f_ptr              = fopen( filename, "rb" );
+  if ( !cache_ptr->f_ptr ) { goto _vco_fail; }
+
+  uint8_t hdr[VOL_CACHE_HDR_SZ];
+  if ( 1 != fread( hdr, sizeof( hdr ), 1, cache_ptr->f_ptr ) ) { goto _vco_fail; }
+  if ( 0 != memcmp( hdr, "VOLCACHE", 8 ) || _get_u32( &hdr[8] ) > VOL_CACHE_VERSION ) { goto _vco_fail; }
+  cache_ptr->info.flags      = _get_u32( &hdr[12] );
+  cache_ptr->info.n_samples  = _get_u32( &hdr[16] );
+  cache_ptr->info.n_segments = _get_u32( &hdr[20] );
+  memcpy( &cache_ptr->info.fps, &hdr[24], sizeof( float ) );
+  uint64_t index_offset = _get_u64( &hdr[32] );
+  if ( 0 == index_offset ) { goto _vco_fail; } // Writer didn't finish.
+
+  cache_ptr->segments_ptr = malloc( ( (size_t)cache_ptr->info.n_segments + 1 ) * sizeof( _index_entry_t ) );
+  cache_ptr->samples_ptr  = malloc( ( (size_t)cache_ptr->info.n_samples + 1 ) * sizeof( _index_entry_t ) );
+  if ( !cache_ptr->segments_ptr || !cache_ptr->samples_ptr ) { goto _vco_fail; }
+  if ( 0 != vol_cache_fseeko( cache_ptr->f_ptr, (int64_t)index_offset, SEEK_SET ) ) { goto _vco_fail; }
+  if ( !_read_index( cache_ptr->f_ptr, cache_ptr->segments_ptr, cache_ptr->info.n_segments, index_offset ) ) { goto _vco_fail; }
+  if ( !_read_index( cache_ptr->f_ptr, cache_ptr->samples_ptr, cache_ptr->info.n_samples, index_offset ) ) { goto _vco_fail; }
+  for ( uint32_t i = 0; i < cache_ptr->info.n_samples; i++ ) {
+    if ( cache_ptr->samples_ptr[i].a >= cache_ptr->info.n_segments ) { goto _vco_fail; }
+  }
+  return cache_ptr;
+
+_vco_fail:
+  vol_cache_close( cache_ptr );
+  return NULL;
+}
+
+vol_cache_info_t vol_cache_get_info( const vol_cache_t* cache_ptr ) {
+  vol_cache_info_t info = { .flags = 0 };
+  if ( cache_ptr ) { info = cache_ptr->info; }
+  return info;
+}
+
+/** Grows a buffer to at least `sz` bytes. Contents are not kept. */
+static bool _reserve( uint8_t** buffer_ptr, size_t* capacity_ptr, size_t sz ) {
+  if ( sz <= *capacity_ptr ) { return true; }
+  uint8_t* resized_ptr = malloc( sz );
+  if ( !resized_ptr ) { return false; }
+  free( *buffer_ptr );
+  *buffer_ptr   = resized_ptr;
+  *capacity_ptr = sz;
+  return true;
+}
+
+/** Reads a chunk's 16-byte header and checks its tag. */
+static bool _read_chunk_hdr( FILE* f_ptr, uint64_t offset, uint32_t tag, uint32_t* fields ) {
+  uint8_t chunk_hdr[VOL_CACHE_CHUNK_HDR_SZ];
+  if ( 0 != vol_cache_fseeko( f_ptr, (int64_t)offset, SEEK_SET ) || 1 != fread( chunk_hdr, sizeof( chunk_hdr ), 1, f_ptr ) ) { return false; }
+  if ( _get_u32( chunk_hdr ) != tag ) { return false; }
+  for ( int i = 0; i < 3; i++ ) { fields[i] = _get_u32( &chunk_hdr[4 + i * 4] ); }
+  return true;
+}
+
+static bool _load_segment( vol_cache_t* cache_ptr, uint32_t segment_idx ) {
+  if ( (int64_t)segment_idx == cache_ptr->loaded_segment_idx ) { return true; }
+  cache_ptr->loaded_segment_idx = -1;
+
+  uint32_t fields[3]; // n_vertices, n_indices, index_sz.
+  if ( !_read_chunk_hdr( cache_ptr->f_ptr, cache_ptr->segments_ptr[segment_idx].offset, VOL_CACHE_TAG_SEGMENT, fields ) ) { return false; }
+  if ( 2 != fields[2] && 4 != fields[2] ) { return false; }
+  bool has_uvs      = cache_ptr->info.flags & VOL_CACHE_FLAG_UVS;
+  size_t indices_sz = _padded( (size_t)fields[1] * fields[2] );
+  size_t uvs_sz     = has_uvs ? _padded( (size_t)fields[0] * 2 * sizeof( float ) ) : 0;
+  if ( !_reserve( &cache_ptr->topology_ptr, &cache_ptr->topology_capacity, indices_sz + uvs_sz ) ) { return false; }
+  if ( indices_sz + uvs_sz > 0 && 1 != fread( cache_ptr->topology_ptr, indices_sz + uvs_sz, 1, cache_ptr->f_ptr ) ) { return false; }
+
+  cache_ptr->sample.indices_ptr = cache_ptr->topology_ptr;
+  cache_ptr->sample.uvs_ptr     = has_uvs ? (const float*)&cache_ptr->topology_ptr[indices_sz] : NULL;
+  cache_ptr->sample.n_vertices  = fields[0];
+  cache_ptr->sample.n_indices   = fields[1];
+  cache_ptr->sample.index_sz    = fields[2];
+  cache_ptr->sample.segment_idx = segment_idx;
+  cache_ptr->loaded_segment_idx = segment_idx;
+  return true;
+}
+
+bool vol_cache_read_sample( vol_cache_t* cache_ptr, uint32_t sample_idx, vol_cache_sample_t* sample_ptr ) {
+  if ( !cache_ptr || !sample_ptr || sample_idx >= cache_ptr->info.n_samples ) { return false; }
+  const _index_entry_t* entry_ptr = &cache_ptr->samples_ptr[sample_idx];
+  if ( !_load_segment( cache_ptr, entry_ptr->a ) ) { return false; }
+
+  uint32_t fields[3]; // segment_idx, n_vertices, reserved.
+  if ( !_read_chunk_hdr( cache_ptr->f_ptr, entry_ptr->offset, VOL_CACHE_TAG_SAMPLE, fields ) ) { return false; }
+  if ( fields[0] != entry_ptr->a || fields[1] != cache_ptr->sample.n_vertices ) { return false; }
+  bool has_normals = cache_ptr->info.flags & VOL_CACHE_FLAG_NORMALS;
+  size_t array_sz  = _padded( (size_t)fields[1] * 3 * sizeof( float ) );
+  size_t data_sz   = has_normals ? array_sz * 2 : array_sz;
+  if ( !_reserve( &cache_ptr->sample_data_ptr, &cache_ptr->sample_data_capacity, data_sz ) ) { return false; }
+  if ( data_sz > 0 && 1 != fread( cache_ptr->sample_data_ptr, data_sz, 1, cache_ptr->f_ptr ) ) { return false; }
+
+  *sample_ptr               = cache_ptr->sample;
+  sample_ptr->positions_ptr = (const float*)cache_ptr->sample_data_ptr;
+  sample_ptr->normals_ptr   = has_normals ? (const float*)&cache_ptr->sample_data_ptr[array_sz] : NULL;
+  return true;
+}
+
+void vol_cache_close( vol_cache_t* cache_ptr ) {
+  if ( !cache_ptr ) { return; }
+  if ( cache_ptr->f_ptr ) { fclose( cache_ptr->f_ptr ); }
+  free( cache_ptr->segments_ptr );
+  free( cache_ptr->samples_ptr );
+  free( cache_ptr->topology_ptr );
+  free( cache_ptr->sample_data_ptr );
+  free( cache_ptr );
+}
@@ -0,0 +1,145 @@
+/**  @file vol_cache.h
+ * Volograms Mesh Cache API
+ *
+ * vol_cache | Time-sampled mesh cache files for VFX and DCC pipelines.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * A mesh cache stores a performance as one file of time samples, in the spirit of Alembic's PolyMesh caches, for import into DCC tools.
+ * Topology (indices and UVs) is stored once per segment, which is a keyframe and the tracked frames that follow it.
+ * Positions, and optionally normals, are stored per sample. Sample `i` is at time `i / fps` seconds.
+ *
+ * Files are written in a single streaming pass, so a writer only holds one frame at a time plus 16 bytes of index per sample.
+ * The index is written last, and its offset patched into the header, so readers can seek straight to any sample.
+ *
+ * File layout. All values are little-endian. Every chunk starts on a 16-byte boundary, and arrays within chunks are padded to 16 bytes.
+ *
+ *     Header, 64 bytes:
+ *       char     magic[8]      "VOLCACHE"
+ *       uint32_t version       1
+ *       uint32_t flags         VOL_CACHE_FLAG_* bits.
+ *       uint32_t n_samples
+ *       uint32_t n_segments
+ *       float    fps
+ *       uint32_t reserved
+ *       uint64_t index_offset  0 if the file was not closed properly.
+ *       uint8_t  reserved[24]
+ *     Segment chunk:
+ *       uint32_t tag           "SEGM"
+ *       uint32_t n_vertices, n_indices, index_sz   index_sz is 2 or 4 bytes.
+ *       indices[n_indices]
+ *       float uvs[n_vertices * 2]                  If VOL_CACHE_FLAG_UVS.
+ *     Sample chunk:
+ *       uint32_t tag           "SAMP"
+ *       uint32_t segment_idx, n_vertices, reserved
+ *       float positions[n_vertices * 3]
+ *       float normals[n_vertices * 3]              If VOL_CACHE_FLAG_NORMALS.
+ *     Index, at index_offset:
+ *       n_segments * { uint64_t offset; uint32_t first_sample; uint32_t n_samples; }
+ *       n_samples  * { uint64_t offset; uint32_t segment_idx; uint32_t reserved; }
+ *
+ * The format does not define an axis convention. vol2obj writes caches in the same right-handed space as its .obj files.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_CACHE_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_CACHE_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define VOL_CACHE_VERSION 1
+#define VOL_CACHE_HDR_SZ 64
+
+/** Bits of the header's `flags`, saying which optional arrays every chunk has. */
+#define VOL_CACHE_FLAG_NORMALS 1
+#define VOL_CACHE_FLAG_UVS 2
+
+/** Opaque writer. Create with `vol_cache_writer_open()`. */
+typedef struct vol_cache_writer_t vol_cache_writer_t;
+
+/** Opaque reader. Create with `vol_cache_open()`. */
+typedef struct vol_cache_t vol_cache_t;
+
+/** A sample returned by `vol_cache_read_sample()`. Pointers are owned by the reader and stay valid until the next read or `vol_cache_close()`. */
+typedef struct vol_cache_sample_t {
+  const float* positions_ptr; // `n_vertices` * 3 floats.
+  const float* normals_ptr;   // `n_vertices` * 3 floats, or NULL if the cache has no normals.
+  const void* indices_ptr;    // `n_indices` indices of `index_sz` bytes each.
+  const float* uvs_ptr;       // `n_vertices` * 2 floats, or NULL if the cache has no UVs.
+  uint32_t n_vertices, n_indices, index_sz;
+  uint32_t segment_idx;
+} vol_cache_sample_t;
+
+/** Header fields of an open cache. */
+typedef struct vol_cache_info_t {
+  uint32_t flags;
+  uint32_t n_samples;
+  uint32_t n_segments;
+  float fps;
+} vol_cache_info_t;
+
+/** Create a cache file for writing.
+ * @param flags VOL_CACHE_FLAG_* bits. Every segment and sample written must then include those arrays.
+ * @returns NULL if the file could not be created, or on invalid parameters.
+ */
+VOL_CACHE_EXPORT vol_cache_writer_t* vol_cache_writer_open( const char* filename, float fps, uint32_t flags );
+
+/** Start a new segment. Following samples use its topology until the next segment is started.
+ * @param index_sz  2 or 4 bytes per index.
+ * @param uvs_ptr   `n_vertices` * 2 floats. Required if the cache has VOL_CACHE_FLAG_UVS, otherwise ignored.
+ * @returns False on a failed write or invalid parameters.
+ */
+VOL_CACHE_EXPORT bool vol_cache_write_segment(
+  vol_cache_writer_t* writer_ptr, const void* indices_ptr, uint32_t n_indices, uint32_t index_sz, const float* uvs_ptr, uint32_t n_vertices );
+
+/** Append the next time sample, which uses the current segment's topology.
+ * @param positions_ptr  The segment's `n_vertices` * 3 floats.
+ * @param normals_ptr    `n_vertices` * 3 floats. Required if the cache has VOL_CACHE_FLAG_NORMALS, otherwise ignored.
+ * @returns False on a failed write, or if no segment has been started.
+ */
+VOL_CACHE_EXPORT bool vol_cache_write_sample( vol_cache_writer_t* writer_ptr, const float* positions_ptr, const float* normals_ptr );
+
+/** Write the index, finish the header, close the file, and free the writer.
+ * @returns False if any write failed, in which case the file is incomplete.
+ */
+VOL_CACHE_EXPORT bool vol_cache_writer_close( vol_cache_writer_t* writer_ptr );
+
+/** Open a cache for reading. Only the header and index are read.
+ * @returns NULL if the file could not be opened, is not a complete cache, or is a newer version.
+ */
+VOL_CACHE_EXPORT vol_cache_t* vol_cache_open( const char* filename );
+
+/** @returns The header fields of an open cache. */
+VOL_CACHE_EXPORT vol_cache_info_t vol_cache_get_info( const vol_cache_t* cache_ptr );
+
+/** Read any sample. The segment's topology is only read if it differs from the previous read's, so reading in order costs one seek per sample.
+ * @returns False if `sample_idx` is out of range, or on a read error.
+ */
+VOL_CACHE_EXPORT bool vol_cache_read_sample( vol_cache_t* cache_ptr, uint32_t sample_idx, vol_cache_sample_t* sample_ptr );
+
+/** Close a cache and free its buffers. */
+VOL_CACHE_EXPORT void vol_cache_close( vol_cache_t* cache_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
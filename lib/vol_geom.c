@@ -3,7 +3,7 @@
  *
  * vol_geom  | .vol Geometry Decoding API
  * --------- | ---------------------
- * Version   | 0.11.1
+ * Version   | 0.15.0
  * Authors   | See matching header file.
  * Copyright | 2021, Volograms (http://volograms.com/)
  * Language  | C99
@@ -12,6 +12,13 @@
  */
 
 #include "vol_geom.h"
+#ifdef VOL_TRACE
+#include "vol_trace.h"
+#else
+// Without VOL_TRACE the trace markers compile to nothing, so vol_trace.h isn't needed to build this library.
+#define VOL_TRACE_BEGIN( name_str ) ( (void)0 )
+#define VOL_TRACE_END( name_str ) ( (void)0 )
+#endif
 #include <assert.h>
 #include <inttypes.h> // 64-bit printfs (PRId64 for integer, PRIu64 for unsigned int, PRIx64 for hex)
 #include <stdarg.h>
@@ -52,19 +59,41 @@ static void _default_logger( vol_geom_log_type_t log_type, const char* message_s
 }
 
 static void ( *_logger_ptr )( vol_geom_log_type_t log_type, const char* message_str ) = _default_logger;
+static vol_geom_log_type_t _logger_min_log_type                                          = VOL_GEOM_LOG_TYPE_DEBUG;
+
+/// Log types are not declared in order of severity, so this maps them to DEBUG=0 < INFO=1 < WARNING=2 < ERROR=3. Folds to a constant for constant types.
+#define _LOG_SEVERITY( log_type ) ( VOL_GEOM_LOG_TYPE_DEBUG == ( log_type ) ? 0 : VOL_GEOM_LOG_TYPE_INFO == ( log_type ) ? 1 : (int)( log_type ) )
+
+/// @returns True if a message of `log_type` would be passed on by `sink_ptr`, or by the global callback if `sink_ptr` is NULL.
+static bool _log_enabled( const vol_geom_log_sink_t* sink_ptr, vol_geom_log_type_t log_type ) {
+  if ( sink_ptr ) { return sink_ptr->callback_ptr && _LOG_SEVERITY( log_type ) >= _LOG_SEVERITY( sink_ptr->min_log_type ); }
+  return _logger_ptr && _LOG_SEVERITY( log_type ) >= _LOG_SEVERITY( _logger_min_log_type );
+}
 
-// This function is used in this file as a printf-style logger. It converts that format to a simple string and passes it to _logger_ptr.
-static void _vol_loggerf( vol_geom_log_type_t log_type, const char* message_str, ... ) {
-  if ( !_logger_ptr ) { return; }
+// Converts a printf-style message to a simple string and passes it to the sink, or to _logger_ptr. Called via the macros below.
+static void _vol_sink_loggerf_impl( const vol_geom_log_sink_t* sink_ptr, vol_geom_log_type_t log_type, const char* message_str, ... ) {
   char log_str[VOL_GEOM_LOG_STR_MAX_LEN];
   log_str[0] = '\0';
   va_list arg_ptr; // using va_args lets us make sure any printf-style formatting values are properly written into the string.
   va_start( arg_ptr, message_str );
   vsnprintf( log_str, VOL_GEOM_LOG_STR_MAX_LEN - 1, message_str, arg_ptr );
   va_end( arg_ptr );
-  _logger_ptr( log_type, log_str );
+  if ( sink_ptr ) {
+    sink_ptr->callback_ptr( log_type, log_str, sink_ptr->user_ptr );
+  } else {
+    _logger_ptr( log_type, log_str );
+  }
 }
 
+// printf-style loggers used in this file. Levels are checked before any formatting, and messages below VOL_GEOM_LOG_MIN_TYPE compile to nothing.
+#define _vol_sink_loggerf( sink_ptr, log_type, ... )                                                                                                           \
+  do {                                                                                                                                                         \
+    if ( _LOG_SEVERITY( log_type ) >= _LOG_SEVERITY( VOL_GEOM_LOG_MIN_TYPE ) && _log_enabled( ( sink_ptr ), ( log_type ) ) ) {                                 \
+      _vol_sink_loggerf_impl( ( sink_ptr ), ( log_type ), __VA_ARGS__ );                                                                                       \
+    }                                                                                                                                                          \
+  } while ( 0 )
+#define _vol_info_loggerf( info_ptr, log_type, ... ) _vol_sink_loggerf( ( info_ptr )->log_sink_ptr, log_type, __VA_ARGS__ )
+
 /** Helper function to check if a path is a file (i.e. is not a directory). */
 static bool _is_file( const char* path ) {
   struct vol_geom_stat64_t path_stat;
@@ -92,14 +121,14 @@ static bool _get_file_sz( const char* filename, vol_geom_size_t* sz_ptr ) {
 /** Helper function to read an entire file into an array of bytes within struct pointed to by `fr_ptr`.
  * @param max_bytes If zero then read the entire file, otherwise read up to max_bytes into memory.
  */
-static bool _read_file( const char* filename, vol_geom_file_record_t* fr_ptr, vol_geom_size_t max_bytes ) {
+static bool _read_file( const char* filename, vol_geom_file_record_t* fr_ptr, vol_geom_size_t max_bytes, const vol_geom_log_sink_t* sink_ptr ) {
   FILE* f_ptr = NULL;
 
   if ( !filename || !fr_ptr ) { goto vol_geom_read_file_failed; }
   if ( !_get_file_sz( filename, &fr_ptr->sz ) ) { goto vol_geom_read_file_failed; }
   fr_ptr->sz = ( 0 == max_bytes || fr_ptr->sz < max_bytes ) ? fr_ptr->sz : max_bytes;
 
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for reading file\n", fr_ptr->sz );
+  _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for reading file\n", fr_ptr->sz );
   fr_ptr->byte_ptr = NULL;
   fr_ptr->byte_ptr = malloc( (size_t)fr_ptr->sz );
   if ( !fr_ptr->byte_ptr ) { goto vol_geom_read_file_failed; }
@@ -124,13 +153,14 @@ vol_geom_read_file_failed:
 }
 
 /** Helper function to read Unity-style strings, specified in VOL format, from a loaded file. */
-static bool _read_short_str( const uint8_t* data_ptr, uint32_t data_sz, vol_geom_size_t offset, vol_geom_short_str_t* sstr ) {
+static bool _read_short_str(
+  const uint8_t* data_ptr, uint32_t data_sz, vol_geom_size_t offset, vol_geom_short_str_t* sstr, const vol_geom_log_sink_t* sink_ptr ) {
   if ( !data_ptr || !sstr ) { return false; }
   if ( offset >= data_sz ) { return false; } // OOB
 
   sstr->sz = data_ptr[offset];               // assumes the 1-byte length
   if ( sstr->sz > 127 ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: string length %i given is > 127\n", (int)sstr->sz );
+    _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: string length %i given is > 127\n", (int)sstr->sz );
     return false;
   }
   if ( offset + sstr->sz >= data_sz ) { return false; } // OOB
@@ -227,25 +257,25 @@ static bool _build_frames_directory_from_file( const char* seq_filename, vol_geo
 
   { // Allocate memory for frame headers and frames directory.
     vol_geom_size_t frame_headers_sz = info_ptr->hdr.frame_count * sizeof( vol_geom_frame_hdr_t );
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for frame headers.\n", frame_headers_sz );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for frame headers.\n", frame_headers_sz );
     info_ptr->frame_headers_ptr = calloc( 1, (size_t)frame_headers_sz );
     if ( !info_ptr->frame_headers_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames headers.\n" );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames headers.\n" );
       goto bfdff_fail;
     }
 
     vol_geom_size_t frames_directory_sz = info_ptr->hdr.frame_count * sizeof( vol_geom_frame_directory_entry_t );
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for frames directory.\n", frames_directory_sz );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Allocating %" PRId64 " bytes for frames directory.\n", frames_directory_sz );
     info_ptr->frames_directory_ptr = calloc( 1, (size_t)frames_directory_sz );
     if ( !info_ptr->frames_directory_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames directory.\n" );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames directory.\n" );
       goto bfdff_fail;
     }
   }
 
   vol_geom_size_t sequence_file_sz = 0;
   if ( !_get_file_sz( seq_filename, &sequence_file_sz ) ) { goto bfdff_fail; }
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Sequence file is %" PRId64 " bytes.\n", sequence_file_sz );
+  _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Sequence file is %" PRId64 " bytes.\n", sequence_file_sz );
 
   f_ptr = fopen( seq_filename, "rb" );
   if ( !f_ptr ) { goto bfdff_fail; }
@@ -258,24 +288,24 @@ static bool _build_frames_directory_from_file( const char* seq_filename, vol_geo
     if ( -1LL == frame_start_offset ) { goto bfdff_fail; }
 
     if ( !fread( &frame_hdr.frame_number, sizeof( uint32_t ), 1, f_ptr ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number at frame %i in sequence file was out of file size range.\n", i );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number at frame %i in sequence file was out of file size range.\n", i );
       goto bfdff_fail;
     }
     if ( frame_hdr.frame_number != i ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number was %i at frame %i in sequence file.\n", frame_hdr.frame_number, i );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame_number was %i at frame %i in sequence file.\n", frame_hdr.frame_number, i );
       goto bfdff_fail;
     }
     if ( !fread( &frame_hdr.mesh_data_sz, sizeof( uint32_t ), 1, f_ptr ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: mesh_data_sz %i was out of file size range in sequence file.\n", frame_hdr.mesh_data_sz );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: mesh_data_sz %i was out of file size range in sequence file.\n", frame_hdr.mesh_data_sz );
       goto bfdff_fail;
     }
     if ( (vol_geom_size_t)frame_hdr.mesh_data_sz > sequence_file_sz ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i has mesh_data_sz %i, which is invalid. Sequence file is %" PRId64 " bytes.\n", i,
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i has mesh_data_sz %i, which is invalid. Sequence file is %" PRId64 " bytes.\n", i,
         frame_hdr.mesh_data_sz, sequence_file_sz );
       goto bfdff_fail;
     }
     if ( !fread( &frame_hdr.keyframe, sizeof( uint8_t ), 1, f_ptr ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: keyframe (type) was out of file size range in sequence file.\n" );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: keyframe (type) was out of file size range in sequence file.\n" );
       goto bfdff_fail;
     }
 
@@ -299,14 +329,15 @@ static bool _build_frames_directory_from_file( const char* seq_filename, vol_geo
       }
     }
     if ( info_ptr->frames_directory_ptr[i].corrected_payload_sz > sequence_file_sz ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i corrected_payload_sz %" PRId64 " bytes was too large for a sequence of %" PRId64 " bytes.\n", i,
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR,
+        "ERROR: frame %i corrected_payload_sz %" PRId64 " bytes was too large for a sequence of %" PRId64 " bytes.\n", i,
         info_ptr->frames_directory_ptr[i].corrected_payload_sz, sequence_file_sz );
       goto bfdff_fail;
     }
 
     // Seek past mesh data and past the final integer "frame data size". See if file is big enough.
     if ( 0 != vol_geom_fseeko( f_ptr, info_ptr->frames_directory_ptr[i].corrected_payload_sz + 4, SEEK_CUR ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: not enough memory in sequence file for frame %i contents.\n", i );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: not enough memory in sequence file for frame %i contents.\n", i );
       goto bfdff_fail;
     }
     frame_current_offset = vol_geom_ftello( f_ptr );
@@ -317,8 +348,8 @@ static bool _build_frames_directory_from_file( const char* seq_filename, vol_geo
     info_ptr->frames_directory_ptr[i].total_sz  = (vol_geom_size_t)frame_current_offset - (vol_geom_size_t)frame_start_offset;
     info_ptr->frame_headers_ptr[i]              = frame_hdr;
     if ( info_ptr->frames_directory_ptr[i].total_sz > sequence_file_sz ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i total_sz %" PRId64 " bytes was too large for a sequence of %" PRId64 " bytes.\n", i,
-        info_ptr->frames_directory_ptr[i].total_sz, sequence_file_sz );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i total_sz %" PRId64 " bytes was too large for a sequence of %" PRId64 " bytes.\n",
+        i, info_ptr->frames_directory_ptr[i].total_sz, sequence_file_sz );
       goto bfdff_fail;
     }
 
@@ -351,9 +382,12 @@ void vol_geom_set_log_callback( void ( *user_function_ptr )( vol_geom_log_type_t
 
 void vol_geom_reset_log_callback( void ) { _logger_ptr = _default_logger; }
 
-bool vol_geom_read_hdr_from_mem( const uint8_t* data_ptr, uint32_t data_sz, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr ) {
+void vol_geom_set_log_level( vol_geom_log_type_t min_log_type ) { _logger_min_log_type = min_log_type; }
+
+static bool _read_hdr_from_mem(
+  const uint8_t* data_ptr, uint32_t data_sz, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr, const vol_geom_log_sink_t* sink_ptr ) {
   if ( !data_ptr || !hdr_ptr || !hdr_sz_ptr || data_sz < VOL_GEOM_FILE_HDR_V10_MIN_SZ ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "vol_geom_read_hdr_from_mem: invalid parameters\n" );
+    _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_ERROR, "vol_geom_read_hdr_from_mem: invalid parameters\n" );
     return false;
   }
 
@@ -364,15 +398,16 @@ bool vol_geom_read_hdr_from_mem( const uint8_t* data_ptr, uint32_t data_sz, vol_
   if ( data_ptr[0] == 'V' && data_ptr[1] == 'O' && data_ptr[2] == 'L' && data_ptr[3] == 'S' ) {
     memcpy( hdr_ptr->format.bytes, data_ptr, 4 );
     hdr_ptr->format.sz = 4;
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "vol_geom_read_hdr_from_mem: format: %c, %c, %c, %c\n", data_ptr[0], data_ptr[1], data_ptr[2], data_ptr[3] );
+    _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "vol_geom_read_hdr_from_mem: format: %c, %c, %c, %c\n", data_ptr[0], data_ptr[1], data_ptr[2],
+      data_ptr[3] );
     offset += 4;
   } else {
-    if ( !_read_short_str( data_ptr, data_sz, 0, &hdr_ptr->format ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "vol_geom_read_hdr_from_mem: failed to read format\n" );
+    if ( !_read_short_str( data_ptr, data_sz, 0, &hdr_ptr->format, sink_ptr ) ) {
+      _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_ERROR, "vol_geom_read_hdr_from_mem: failed to read format\n" );
       return false;
     }
     if ( strncmp( "VOLS", hdr_ptr->format.bytes, 4 ) != 0 ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "vol_geom_read_hdr_from_mem: failed format check\n" );
+      _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_ERROR, "vol_geom_read_hdr_from_mem: failed format check\n" );
       return false;
     } // Format check.
     offset += ( hdr_ptr->format.sz + 1 );
@@ -380,20 +415,20 @@ bool vol_geom_read_hdr_from_mem( const uint8_t* data_ptr, uint32_t data_sz, vol_
   if ( offset + 4 * (vol_geom_size_t)sizeof( uint32_t ) + 3 >= data_sz ) { return false; } // OOB
   memcpy( &hdr_ptr->version, &data_ptr[offset], sizeof( uint32_t ) );
   offset += (vol_geom_size_t)sizeof( uint32_t );
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "vol_geom_read_hdr_from_mem: detected header version %d", hdr_ptr->version );
+  _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "vol_geom_read_hdr_from_mem: detected header version %d", hdr_ptr->version );
   if ( hdr_ptr->version < 10 || hdr_ptr->version > 13 ) { return false; } // Version check.
   memcpy( &hdr_ptr->compression, &data_ptr[offset], sizeof( uint32_t ) );
   offset += (vol_geom_size_t)sizeof( uint32_t );
   if ( hdr_ptr->version < 13 ) { // V1.3 removed strings & topology field from header.
-    if ( !_read_short_str( data_ptr, data_sz, offset, &hdr_ptr->mesh_name ) ) { return false; }
+    if ( !_read_short_str( data_ptr, data_sz, offset, &hdr_ptr->mesh_name, sink_ptr ) ) { return false; }
     offset += ( hdr_ptr->mesh_name.sz + 1 );
     if ( offset + 2 * (vol_geom_size_t)sizeof( uint32_t ) + 2 >= data_sz ) { return false; } // OOB
-    if ( !_read_short_str( data_ptr, data_sz, offset, &hdr_ptr->material ) ) { return false; }
+    if ( !_read_short_str( data_ptr, data_sz, offset, &hdr_ptr->material, sink_ptr ) ) { return false; }
     offset += ( hdr_ptr->material.sz + 1 );
     if ( offset + 2 * (vol_geom_size_t)sizeof( uint32_t ) + 1 >= data_sz ) { return false; } // OOB
-    if ( !_read_short_str( data_ptr, data_sz, offset, &hdr_ptr->shader ) ) { return false; }
+    if ( !_read_short_str( data_ptr, data_sz, offset, &hdr_ptr->shader, sink_ptr ) ) { return false; }
     offset += ( hdr_ptr->shader.sz + 1 );
-    if ( offset + 2 * (vol_geom_size_t)sizeof( uint32_t ) >= data_sz ) { return false; } // OOB
+    if ( offset + 2 * (vol_geom_size_t)sizeof( uint32_t ) > data_sz ) { return false; } // OOB
     memcpy( &hdr_ptr->topology, &data_ptr[offset], sizeof( uint32_t ) );
     offset += (vol_geom_size_t)sizeof( uint32_t );
   }
@@ -449,12 +484,16 @@ vol_geom_rhfmem_success:
   return true;
 }
 
-bool vol_geom_read_hdr_from_file( const char* filename, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr ) {
+bool vol_geom_read_hdr_from_mem( const uint8_t* data_ptr, uint32_t data_sz, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr ) {
+  return _read_hdr_from_mem( data_ptr, data_sz, hdr_ptr, hdr_sz_ptr, NULL );
+}
+
+static bool _read_hdr_from_file( const char* filename, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr, const vol_geom_log_sink_t* sink_ptr ) {
   vol_geom_file_record_t record = ( vol_geom_file_record_t ){ .byte_ptr = NULL };
   if ( !filename || !hdr_ptr || !hdr_sz_ptr ) { return false; }
-  if ( !_read_file( filename, &record, sizeof( vol_geom_file_hdr_t ) ) ) { goto rhff_fail; }
-  if ( !vol_geom_read_hdr_from_mem( record.byte_ptr, record.sz, hdr_ptr, hdr_sz_ptr ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_read_hdr_from_file: Failed to read header from file `%s`.\n", filename );
+  if ( !_read_file( filename, &record, sizeof( vol_geom_file_hdr_t ), sink_ptr ) ) { goto rhff_fail; }
+  if ( !_read_hdr_from_mem( record.byte_ptr, record.sz, hdr_ptr, hdr_sz_ptr, sink_ptr ) ) {
+    _vol_sink_loggerf( sink_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_read_hdr_from_file: Failed to read header from file `%s`.\n", filename );
     goto rhff_fail;
   }
   if ( record.byte_ptr != NULL ) { free( record.byte_ptr ); }
@@ -464,6 +503,10 @@ rhff_fail:
   return false;
 }
 
+bool vol_geom_read_hdr_from_file( const char* filename, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr ) {
+  return _read_hdr_from_file( filename, hdr_ptr, hdr_sz_ptr, NULL );
+}
+
 bool vol_geom_read_audio_from_file( const char* vols_filename, vol_geom_info_t* info_ptr ) {
   FILE* f_ptr = NULL;
   if ( !vols_filename || !info_ptr || info_ptr->hdr.version < 13 ) { goto vgraff_fail; }
@@ -482,33 +525,287 @@ vgraff_fail:
   return false;
 }
 
-bool vol_geom_create_file_info_from_file( const char* vols_filename, vol_geom_info_t* info_ptr ) {
-  if ( !vols_filename || !info_ptr || !_is_file( vols_filename ) ) { return false; }
+/** Decodes an LZ4 block that must expand to exactly `dst_sz` bytes. Every length and offset is checked, so corrupt input fails rather than overruns. */
+static bool _lz4_decompress( const uint8_t* src_ptr, uint32_t src_sz, uint8_t* dst_ptr, uint32_t dst_sz ) {
+  const uint8_t* ip     = src_ptr;
+  const uint8_t* ip_end = src_ptr + src_sz;
+  uint8_t* op           = dst_ptr;
+  uint8_t* op_end       = dst_ptr + dst_sz;
+
+  for ( ;; ) {
+    if ( ip >= ip_end ) { return false; }
+    uint8_t token  = *ip++;
+    size_t lit_len = token >> 4;
+    if ( 15 == lit_len ) {
+      uint8_t b = 255;
+      while ( 255 == b ) {
+        if ( ip >= ip_end ) { return false; }
+        b = *ip++;
+        lit_len += b;
+      }
+    }
+    if ( (size_t)( ip_end - ip ) < lit_len || (size_t)( op_end - op ) < lit_len ) { return false; }
+    memcpy( op, ip, lit_len );
+    op += lit_len;
+    ip += lit_len;
+    if ( ip == ip_end ) { return op == op_end; } // The last sequence is literals only.
+
+    if ( ip_end - ip < 2 ) { return false; }
+    size_t match_offset = (size_t)ip[0] | ( (size_t)ip[1] << 8 );
+    ip += 2;
+    if ( 0 == match_offset || match_offset > (size_t)( op - dst_ptr ) ) { return false; }
+    size_t match_len = token & 15;
+    if ( 15 == match_len ) {
+      uint8_t b = 255;
+      while ( 255 == b ) {
+        if ( ip >= ip_end ) { return false; }
+        b = *ip++;
+        match_len += b;
+      }
+    }
+    match_len += 4; // Minimum match length.
+    if ( (size_t)( op_end - op ) < match_len ) { return false; }
+    const uint8_t* match_ptr = op - match_offset;
+    if ( match_offset >= match_len ) {
+      memcpy( op, match_ptr, match_len );
+    } else { // Overlapping copy, which repeats the last `match_offset` bytes.
+      for ( size_t i = 0; i < match_len; i++ ) { op[i] = match_ptr[i]; }
+    }
+    op += match_len;
+  }
+}
+
+/** Reverses the byte shuffle of VOL_GEOM_CODEC_LZ4_SHUFFLE. See "Playback containers" in vol_geom.h. */
+static void _unshuffle4( const uint8_t* src_ptr, uint8_t* dst_ptr, uint32_t sz ) {
+  uint32_t n_words   = sz / 4;
+  const uint8_t* p0 = src_ptr;
+  const uint8_t* p1 = &src_ptr[n_words];
+  const uint8_t* p2 = &src_ptr[n_words * 2];
+  const uint8_t* p3 = &src_ptr[n_words * 3];
+  for ( uint32_t i = 0; i < n_words; i++ ) { // Writes in order, reading the 4 planes in step.
+    dst_ptr[i * 4 + 0] = p0[i];
+    dst_ptr[i * 4 + 1] = p1[i];
+    dst_ptr[i * 4 + 2] = p2[i];
+    dst_ptr[i * 4 + 3] = p3[i];
+  }
+  memcpy( &dst_ptr[n_words * 4], &src_ptr[n_words * 4], sz - n_words * 4 );
+}
+
+bool vol_geom_decode_playback_chunk( const vol_geom_playback_entry_t* entry_ptr, const uint8_t* stored_ptr, uint8_t* raw_ptr, uint8_t* scratch_ptr ) {
+  if ( !entry_ptr || !stored_ptr || !raw_ptr ) { return false; }
+
+  switch ( entry_ptr->codec ) {
+  case VOL_GEOM_CODEC_NONE:
+    if ( entry_ptr->stored_sz != entry_ptr->raw_sz ) { return false; }
+    memcpy( raw_ptr, stored_ptr, entry_ptr->raw_sz );
+    return true;
+  case VOL_GEOM_CODEC_LZ4: return _lz4_decompress( stored_ptr, entry_ptr->stored_sz, raw_ptr, entry_ptr->raw_sz );
+  case VOL_GEOM_CODEC_LZ4_SHUFFLE:
+    if ( !scratch_ptr || !_lz4_decompress( stored_ptr, entry_ptr->stored_sz, scratch_ptr, entry_ptr->raw_sz ) ) { return false; }
+    _unshuffle4( scratch_ptr, raw_ptr, entry_ptr->raw_sz );
+    return true;
+  default: return false;
+  }
+}
+
+/** @returns True if the file starts with the playback container magic number. */
+static bool _is_playback_file( const char* filename ) {
+  char magic[4] = { 0 };
+  FILE* f_ptr   = fopen( filename, "rb" );
+  if ( !f_ptr ) { return false; }
+  bool read_ok = 1 == fread( magic, sizeof( magic ), 1, f_ptr );
+  fclose( f_ptr );
+  return read_ok && 0 == memcmp( magic, "VOLP", 4 );
+}
 
-  vol_geom_size_t hdr_sz = 0;
-  if ( !vol_geom_read_hdr_from_file( vols_filename, &info_ptr->hdr, &hdr_sz ) ) { goto cfiff_fail; }
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_INFO, "Vologram header v%i.%i\n", info_ptr->hdr.version / 10, info_ptr->hdr.version % 10 );
+/** `vol_geom_io_t` read function for local files. */
+static bool _file_io_read( void* user_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr ) {
+  FILE* f_ptr = (FILE*)user_ptr;
+  if ( 0 != vol_geom_fseeko( f_ptr, (vol_geom_size_t)offset, SEEK_SET ) ) { return false; }
+  return 0 == sz || 1 == fread( dst_ptr, sz, 1, f_ptr );
+}
 
-  if ( info_ptr->hdr.audio && !vol_geom_read_audio_from_file( vols_filename, info_ptr ) ) { goto cfiff_fail; }
+/** Fill in the header, frame headers, frames directory, and audio from a playback container's header and index.
+ * This replaces the scan of the sequence done by `_build_frames_directory_from_file()`, so no frame data is read.
+ * Everything is fetched in 3 reads or fewer - header, index, and audio - to suit sources where each read is a network round trip.
+ */
+static bool _read_playback_index( const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr ) {
+  uint8_t* index_ptr = NULL;
+  uint8_t hdr[VOL_GEOM_PLAYBACK_HDR_SZ];
+
+  vol_geom_size_t file_sz = io_ptr->total_sz;
+  if ( file_sz < VOL_GEOM_PLAYBACK_HDR_SZ || !io_ptr->read_fn( io_ptr->user_ptr, 0, sizeof( hdr ), hdr ) ) { goto rpi_fail; }
+  if ( 0 != memcmp( hdr, "VOLP", 4 ) ) { goto rpi_fail; }
+
+  uint32_t playback_version = 0, page_sz = 0, audio_sz = 0;
+  uint64_t audio_offset = 0, index_offset = 0;
+  vol_geom_file_hdr_t* hdr_ptr = &info_ptr->hdr;
+  *hdr_ptr                     = ( vol_geom_file_hdr_t ){ .version = 0 };
+  memcpy( &playback_version, &hdr[4], sizeof( uint32_t ) );
+  memcpy( &page_sz, &hdr[8], sizeof( uint32_t ) );
+  memcpy( &hdr_ptr->frame_count, &hdr[12], sizeof( uint32_t ) );
+  memcpy( &hdr_ptr->version, &hdr[16], sizeof( uint32_t ) );
+  memcpy( &hdr_ptr->compression, &hdr[20], sizeof( uint32_t ) );
+  hdr_ptr->normals                  = (bool)hdr[24];
+  hdr_ptr->textured                 = (bool)hdr[25];
+  hdr_ptr->texture_compression      = hdr[26];
+  hdr_ptr->texture_container_format = hdr[27];
+  memcpy( &hdr_ptr->texture_width, &hdr[28], sizeof( uint32_t ) );
+  memcpy( &hdr_ptr->texture_height, &hdr[32], sizeof( uint32_t ) );
+  memcpy( &hdr_ptr->fps, &hdr[36], sizeof( float ) );
+  memcpy( &hdr_ptr->texture_format, &hdr[40], sizeof( uint16_t ) );
+  memcpy( &audio_sz, &hdr[44], sizeof( uint32_t ) );
+  memcpy( &audio_offset, &hdr[48], sizeof( uint64_t ) );
+  memcpy( &index_offset, &hdr[56], sizeof( uint64_t ) );
+  memcpy( hdr_ptr->translation, &hdr[64], 3 * sizeof( float ) );
+  memcpy( hdr_ptr->rotation, &hdr[76], 4 * sizeof( float ) );
+  memcpy( &hdr_ptr->scale, &hdr[92], sizeof( float ) );
+  memcpy( hdr_ptr->format.bytes, "VOLS", 4 );
+  hdr_ptr->format.sz = 4;
+  hdr_ptr->audio     = audio_sz > 0 ? 1 : 0;
+  _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_INFO, "Vologram playback container v%u, frames v%i.%i\n", playback_version, hdr_ptr->version / 10,
+    hdr_ptr->version % 10 );
+  if ( 0 == playback_version || playback_version > VOL_GEOM_PLAYBACK_VERSION ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: playback container version %u is not supported.\n", playback_version );
+    goto rpi_fail;
+  }
+  if ( hdr_ptr->version < 10 || hdr_ptr->version > 13 || 0 == page_sz ) { goto rpi_fail; }
+  vol_geom_size_t index_sz = (vol_geom_size_t)hdr_ptr->frame_count * VOL_GEOM_PLAYBACK_ENTRY_SZ;
+  if ( index_offset < VOL_GEOM_PLAYBACK_HDR_SZ || index_sz > UINT32_MAX || (vol_geom_size_t)index_offset + index_sz > file_sz ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: playback container index for %u frames is out of file size range.\n", hdr_ptr->frame_count );
+    goto rpi_fail;
+  }
 
-  // v1.3 introduced a header offset field for this. Preceding versions are immediately after the header.
-  info_ptr->sequence_offset = info_ptr->hdr.frame_body_start ? info_ptr->hdr.frame_body_start : hdr_sz;
+  info_ptr->frame_headers_ptr    = calloc( hdr_ptr->frame_count, sizeof( vol_geom_frame_hdr_t ) );
+  info_ptr->frames_directory_ptr = calloc( hdr_ptr->frame_count, sizeof( vol_geom_frame_directory_entry_t ) );
+  info_ptr->playback_entries_ptr = calloc( hdr_ptr->frame_count + 1, sizeof( vol_geom_playback_entry_t ) );
+  index_ptr                      = malloc( (size_t)index_sz + 1 );
+  if ( !info_ptr->frame_headers_ptr || !info_ptr->frames_directory_ptr || !info_ptr->playback_entries_ptr || !index_ptr ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating frames directory.\n" );
+    goto rpi_fail;
+  }
+  if ( index_sz > 0 && !io_ptr->read_fn( io_ptr->user_ptr, index_offset, (uint32_t)index_sz, index_ptr ) ) { goto rpi_fail; }
+
+  uint32_t biggest_stored_sz = 0;
+  bool any_compressed        = false;
+  for ( uint32_t i = 0; i < hdr_ptr->frame_count; i++ ) {
+    const uint8_t* entry_ptr        = &index_ptr[i * VOL_GEOM_PLAYBACK_ENTRY_SZ];
+    vol_geom_playback_entry_t entry = ( vol_geom_playback_entry_t ){ .offset = 0 };
+    memcpy( &entry.offset, &entry_ptr[0], sizeof( uint64_t ) );
+    memcpy( &entry.stored_sz, &entry_ptr[8], sizeof( uint32_t ) );
+    memcpy( &entry.raw_sz, &entry_ptr[12], sizeof( uint32_t ) );
+    memcpy( &entry.mesh_data_sz, &entry_ptr[16], sizeof( uint32_t ) );
+    entry.keyframe = entry_ptr[20];
+    entry.codec    = entry_ptr[21];
+    if ( entry.codec >= VOL_GEOM_CODEC_MAX || ( VOL_GEOM_CODEC_NONE == entry.codec && entry.stored_sz != entry.raw_sz ) ) {
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i uses unsupported codec %i.\n", i, (int)entry.codec );
+      goto rpi_fail;
+    }
+    if ( entry.raw_sz < VOL_GEOM_FRAME_MIN_SZ || entry.offset < index_offset + index_sz || (vol_geom_size_t)( entry.offset + entry.stored_sz ) > file_sz ) {
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame %i chunk is out of file size range.\n", i );
+      goto rpi_fail;
+    }
+    info_ptr->playback_entries_ptr[i] = entry;
+    if ( VOL_GEOM_CODEC_NONE != entry.codec ) { any_compressed = true; }
+    if ( entry.stored_sz > biggest_stored_sz ) { biggest_stored_sz = entry.stored_sz; }
+    // Every version's frame header is a frame number, mesh_data_sz, and keyframe byte. The frame ends with a repeat of mesh_data_sz.
+    const vol_geom_size_t frame_hdr_sz                     = 2 * sizeof( uint32_t ) + sizeof( uint8_t );
+    info_ptr->frames_directory_ptr[i].offset_sz            = (vol_geom_size_t)entry.offset;
+    info_ptr->frames_directory_ptr[i].total_sz             = entry.raw_sz;
+    info_ptr->frames_directory_ptr[i].hdr_sz               = frame_hdr_sz;
+    info_ptr->frames_directory_ptr[i].corrected_payload_sz = entry.raw_sz - frame_hdr_sz - sizeof( uint32_t );
+    info_ptr->frame_headers_ptr[i].frame_number            = i;
+    info_ptr->frame_headers_ptr[i].mesh_data_sz            = entry.mesh_data_sz;
+    info_ptr->frame_headers_ptr[i].keyframe                = entry.keyframe;
+    if ( info_ptr->frames_directory_ptr[i].total_sz > info_ptr->biggest_frame_blob_sz ) {
+      info_ptr->biggest_frame_blob_sz = info_ptr->frames_directory_ptr[i].total_sz;
+    }
+  }
 
-  if ( !_build_frames_directory_from_file( vols_filename, info_ptr, info_ptr->sequence_offset ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_create_file_info_from_file(): Failed to create frames directory.\n" );
-    goto cfiff_fail;
+  if ( audio_sz > 0 ) {
+    if ( (vol_geom_size_t)( audio_offset + audio_sz ) > file_sz ) { goto rpi_fail; }
+    info_ptr->audio_data_sz  = audio_sz;
+    info_ptr->audio_data_ptr = malloc( audio_sz );
+    if ( !info_ptr->audio_data_ptr ) { goto rpi_fail; }
+    if ( !io_ptr->read_fn( io_ptr->user_ptr, audio_offset, audio_sz, info_ptr->audio_data_ptr ) ) { goto rpi_fail; }
   }
 
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating preallocated_frame_blob_ptr bytes %" PRId64 "\n", info_ptr->biggest_frame_blob_sz );
+  // Compressed chunks are read whole and decoded into the frame blob, via scratch memory for the shuffle.
+  if ( any_compressed ) {
+    if ( info_ptr->biggest_frame_blob_sz >= 1024 * 1024 * 1024 ) { goto rpi_fail; } // Checked again, with a message, by the caller.
+    info_ptr->chunk_scratch_ptr = malloc( (size_t)info_ptr->biggest_frame_blob_sz + biggest_stored_sz );
+    if ( !info_ptr->chunk_scratch_ptr ) {
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: OOM allocating chunk scratch memory.\n" );
+      goto rpi_fail;
+    }
+  }
+
+  info_ptr->playback_version = playback_version;
+  info_ptr->sequence_offset  = 0; // Chunk offsets are from the start of the file.
+  free( index_ptr );
+  return true;
+
+rpi_fail:
+  free( index_ptr );
+  return false; // Anything allocated in `info_ptr` is freed by the caller.
+}
+
+/** Allocates `preallocated_frame_blob_ptr` once `biggest_frame_blob_sz` is known. */
+static bool _alloc_frame_blob( vol_geom_info_t* info_ptr ) {
+  _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Allocating preallocated_frame_blob_ptr bytes %" PRId64 "\n", info_ptr->biggest_frame_blob_sz );
   if ( info_ptr->biggest_frame_blob_sz >= 1024 * 1024 * 1024 ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: extremely high frame size %" PRId64 " reported - assuming error.\n", info_ptr->biggest_frame_blob_sz );
-    goto cfiff_fail;
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: extremely high frame size %" PRId64 " reported - assuming error.\n",
+      info_ptr->biggest_frame_blob_sz );
+    return false;
   }
   info_ptr->preallocated_frame_blob_ptr = calloc( 1, info_ptr->biggest_frame_blob_sz );
   if ( !info_ptr->preallocated_frame_blob_ptr ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating frame blob reserve.\n" );
-    goto cfiff_fail;
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating frame blob reserve.\n" );
+    return false;
+  }
+  return true;
+}
+
+bool vol_geom_create_file_info_from_file( const char* vols_filename, vol_geom_info_t* info_ptr ) {
+  return vol_geom_create_file_info_from_file_ex( vols_filename, info_ptr, NULL );
+}
+
+bool vol_geom_create_file_info_from_file_ex( const char* vols_filename, vol_geom_info_t* info_ptr, const vol_geom_log_sink_t* sink_ptr ) {
+  if ( !vols_filename || !info_ptr || !_is_file( vols_filename ) ) { return false; }
+
+  *info_ptr = ( vol_geom_info_t ){ .log_sink_ptr = sink_ptr };
+
+  if ( _is_playback_file( vols_filename ) ) {
+    vol_geom_io_t io = ( vol_geom_io_t ){ .read_fn = _file_io_read };
+    bool index_ok    = _get_file_sz( vols_filename, &io.total_sz );
+    io.user_ptr      = index_ok ? fopen( vols_filename, "rb" ) : NULL;
+    VOL_TRACE_BEGIN( "vol_geom_read_playback_index" );
+    index_ok = io.user_ptr && _read_playback_index( &io, info_ptr );
+    VOL_TRACE_END( "vol_geom_read_playback_index" );
+    if ( io.user_ptr ) { fclose( (FILE*)io.user_ptr ); }
+    if ( !index_ok ) {
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_create_file_info_from_file(): Failed to read playback container index.\n" );
+      goto cfiff_fail;
+    }
+  } else {
+    vol_geom_size_t hdr_sz = 0;
+    if ( !_read_hdr_from_file( vols_filename, &info_ptr->hdr, &hdr_sz, info_ptr->log_sink_ptr ) ) { goto cfiff_fail; }
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_INFO, "Vologram header v%i.%i\n", info_ptr->hdr.version / 10, info_ptr->hdr.version % 10 );
+
+    if ( info_ptr->hdr.audio && !vol_geom_read_audio_from_file( vols_filename, info_ptr ) ) { goto cfiff_fail; }
+
+    // v1.3 introduced a header offset field for this. Preceding versions are immediately after the header.
+    info_ptr->sequence_offset = info_ptr->hdr.frame_body_start ? info_ptr->hdr.frame_body_start : hdr_sz;
+
+    VOL_TRACE_BEGIN( "vol_geom_build_frames_directory" );
+    bool directory_ok = _build_frames_directory_from_file( vols_filename, info_ptr, info_ptr->sequence_offset );
+    VOL_TRACE_END( "vol_geom_build_frames_directory" );
+    if ( !directory_ok ) {
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_create_file_info_from_file(): Failed to create frames directory.\n" );
+      goto cfiff_fail;
+    }
   }
+  if ( !_alloc_frame_blob( info_ptr ) ) { goto cfiff_fail; }
 
   return true;
 
@@ -517,37 +814,64 @@ cfiff_fail:
   return false;
 }
 
+bool vol_geom_create_file_info_from_io( const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr ) {
+  return vol_geom_create_file_info_from_io_ex( io_ptr, info_ptr, NULL );
+}
+
+bool vol_geom_create_file_info_from_io_ex( const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr, const vol_geom_log_sink_t* sink_ptr ) {
+  if ( !io_ptr || !io_ptr->read_fn || !info_ptr ) { return false; }
+
+  *info_ptr = ( vol_geom_info_t ){ .log_sink_ptr = sink_ptr };
+
+  VOL_TRACE_BEGIN( "vol_geom_read_playback_index" );
+  bool index_ok = _read_playback_index( io_ptr, info_ptr );
+  VOL_TRACE_END( "vol_geom_read_playback_index" );
+  if ( !index_ok ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_create_file_info_from_io(): Failed to read playback container index.\n" );
+    goto cfiio_fail;
+  }
+  if ( !_alloc_frame_blob( info_ptr ) ) { goto cfiio_fail; }
+
+  return true;
+
+cfiio_fail:
+  vol_geom_free_file_info( info_ptr );
+  return false;
+}
+
 bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode ) {
+  return vol_geom_create_file_info_ex( hdr_filename, seq_filename, info_ptr, streaming_mode, NULL );
+}
+
+bool vol_geom_create_file_info_ex(
+  const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode, const vol_geom_log_sink_t* sink_ptr ) {
   if ( !hdr_filename || !seq_filename || !info_ptr ) { return false; }
 
   vol_geom_file_record_t record = ( vol_geom_file_record_t ){ .sz = 0 };
   vol_geom_size_t hdr_sz        = 0;
-  *info_ptr                     = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 };
+  *info_ptr                     = ( vol_geom_info_t ){ .log_sink_ptr = sink_ptr };
   info_ptr->sequence_offset     = 0; // Using separate files here, so there is no offset.
 
-  if ( !vol_geom_read_hdr_from_file( hdr_filename, &info_ptr->hdr, &hdr_sz ) ) { goto cfi_fail; }
+  if ( !_read_hdr_from_file( hdr_filename, &info_ptr->hdr, &hdr_sz, info_ptr->log_sink_ptr ) ) { goto cfi_fail; }
 
-  if ( !_build_frames_directory_from_file( seq_filename, info_ptr, info_ptr->sequence_offset ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_create_file_info_from_file(): Failed to create frames directory.\n" );
+  VOL_TRACE_BEGIN( "vol_geom_build_frames_directory" );
+  bool directory_ok = _build_frames_directory_from_file( seq_filename, info_ptr, info_ptr->sequence_offset );
+  VOL_TRACE_END( "vol_geom_build_frames_directory" );
+  if ( !directory_ok ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: vol_geom_create_file_info_from_file(): Failed to create frames directory.\n" );
     goto cfi_fail;
   }
 
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Allocating preallocated_frame_blob_ptr bytes %" PRId64 "\n", info_ptr->biggest_frame_blob_sz );
-  if ( info_ptr->biggest_frame_blob_sz >= 1024 * 1024 * 1024 ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: extremely high frame size %" PRId64 " reported - assuming error.\n", info_ptr->biggest_frame_blob_sz );
-    goto cfi_fail;
-  }
-  info_ptr->preallocated_frame_blob_ptr = calloc( 1, info_ptr->biggest_frame_blob_sz );
-  if ( !info_ptr->preallocated_frame_blob_ptr ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: out of memory allocating frame blob reserve.\n" );
-    goto cfi_fail;
-  }
+  if ( !_alloc_frame_blob( info_ptr ) ) { goto cfi_fail; }
 
   // If not dealing with huge sequence files - preload the whole thing to memory to avoid file I/O problems.
   if ( !streaming_mode ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Reading entire sequence file to blob memory\n" );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Reading entire sequence file to blob memory\n" );
     vol_geom_file_record_t seq_blob = ( vol_geom_file_record_t ){ .sz = 0 };
-    if ( !_read_file( seq_filename, &seq_blob, 0 ) ) { goto cfi_fail; }
+    VOL_TRACE_BEGIN( "vol_geom_preload_sequence" );
+    bool preload_ok = _read_file( seq_filename, &seq_blob, 0, info_ptr->log_sink_ptr );
+    VOL_TRACE_END( "vol_geom_preload_sequence" );
+    if ( !preload_ok ) { goto cfi_fail; }
     info_ptr->sequence_blob_byte_ptr = (uint8_t*)seq_blob.byte_ptr;
   }
 
@@ -555,9 +879,9 @@ bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filena
 
 cfi_fail:
 
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to parse info from vologram geometry files.\n" );
+  _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: Failed to parse info from vologram geometry files.\n" );
   if ( record.byte_ptr ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing record.byte_ptr\n" );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Freeing record.byte_ptr\n" );
     free( record.byte_ptr );
   }
   vol_geom_free_file_info( info_ptr );
@@ -568,12 +892,14 @@ cfi_fail:
 bool vol_geom_free_file_info( vol_geom_info_t* info_ptr ) {
   if ( !info_ptr ) { return false; }
 
-  _vol_loggerf( VOL_GEOM_LOG_TYPE_DEBUG, "Freeing allocated vol_geom info_ptr memory.\n" );
+  _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_DEBUG, "Freeing allocated vol_geom info_ptr memory.\n" );
   if ( info_ptr->audio_data_ptr ) { free( info_ptr->audio_data_ptr ); }
   if ( info_ptr->sequence_blob_byte_ptr ) { free( info_ptr->sequence_blob_byte_ptr ); }
   if ( info_ptr->preallocated_frame_blob_ptr ) { free( info_ptr->preallocated_frame_blob_ptr ); }
   if ( info_ptr->frame_headers_ptr ) { free( info_ptr->frame_headers_ptr ); }
   if ( info_ptr->frames_directory_ptr ) { free( info_ptr->frames_directory_ptr ); }
+  if ( info_ptr->playback_entries_ptr ) { free( info_ptr->playback_entries_ptr ); }
+  if ( info_ptr->chunk_scratch_ptr ) { free( info_ptr->chunk_scratch_ptr ); }
   *info_ptr = ( vol_geom_info_t ){ .hdr.frame_count = 0 };
 
   return true;
@@ -597,12 +923,11 @@ int vol_geom_find_previous_keyframe( const vol_geom_info_t* info_ptr, uint32_t f
   return -1;
 }
 
-bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
-  assert( seq_filename && info_ptr && frame_data_ptr );
-  if ( !seq_filename || !info_ptr || !frame_data_ptr ) { return false; }
-
+/// Copies or reads a frame's bytes into `info_ptr->preallocated_frame_blob_ptr`.
+static bool _read_frame_blob( const char* seq_filename, const vol_geom_info_t* info_ptr, uint32_t frame_idx ) {
   if ( frame_idx >= info_ptr->hdr.frame_count ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame requested (%i) is not in valid range of 0-%i for sequence\n", frame_idx, info_ptr->hdr.frame_count );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame requested (%i) is not in valid range of 0-%i for sequence\n", frame_idx,
+      info_ptr->hdr.frame_count );
     return false;
   }
 
@@ -610,49 +935,125 @@ bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_
   vol_geom_size_t offset_sz = info_ptr->frames_directory_ptr[frame_idx].offset_sz;
   vol_geom_size_t total_sz  = info_ptr->frames_directory_ptr[frame_idx].total_sz;
 
+  // A compressed chunk is read into the scratch memory, after the space used to decode it, and is smaller on disk than in memory.
+  const vol_geom_playback_entry_t* entry_ptr = info_ptr->playback_entries_ptr ? &info_ptr->playback_entries_ptr[frame_idx] : NULL;
+  bool compressed                            = entry_ptr && VOL_GEOM_CODEC_NONE != entry_ptr->codec;
+  uint8_t* read_ptr                          = info_ptr->preallocated_frame_blob_ptr;
+  vol_geom_size_t read_sz                    = total_sz;
+  if ( compressed ) {
+    if ( !info_ptr->chunk_scratch_ptr ) { return false; }
+    read_ptr = &info_ptr->chunk_scratch_ptr[info_ptr->biggest_frame_blob_sz];
+    read_sz  = entry_ptr->stored_sz;
+  }
+
   // Get file size and check for file size issues before allocating memory or reading
   vol_geom_size_t file_sz = 0;
   if ( !_get_file_sz( seq_filename, &file_sz ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file `%s` could not be opened.\n", seq_filename );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file `%s` could not be opened.\n", seq_filename );
     return false;
   }
-  if ( file_sz < ( offset_sz + total_sz ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file is too short to contain frame %i data.\n", frame_idx );
+  if ( file_sz < ( offset_sz + read_sz ) ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: sequence file is too short to contain frame %i data.\n", frame_idx );
     return false;
   }
 
   if ( info_ptr->biggest_frame_blob_sz < total_sz ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR: pre-allocated frame blob was too small for frame %i: %" PRId64 "/%" PRId64 " bytes.\n", frame_idx,
-      info_ptr->biggest_frame_blob_sz, total_sz );
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: pre-allocated frame blob was too small for frame %i: %" PRId64 "/%" PRId64 " bytes.\n",
+      frame_idx, info_ptr->biggest_frame_blob_sz, total_sz );
     return false;
   }
 
   // Find frame section within sequence file blob if it was pre-loaded.
   if ( info_ptr->sequence_blob_byte_ptr ) {
-    memcpy( info_ptr->preallocated_frame_blob_ptr, &info_ptr->sequence_blob_byte_ptr[offset_sz], total_sz );
+    memcpy( read_ptr, &info_ptr->sequence_blob_byte_ptr[offset_sz], read_sz );
 
     // Read frame blob from file.
   } else {
     FILE* f_ptr = fopen( seq_filename, "rb" );
     if ( !f_ptr ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR could not open file `%s` for frame data.\n", seq_filename );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR could not open file `%s` for frame data.\n", seq_filename );
       return false;
     }
     if ( 0 != vol_geom_fseeko( f_ptr, offset_sz, SEEK_SET ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR seeking frame %i from sequence file - file too small for data.\n", frame_idx );
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR seeking frame %i from sequence file - file too small for data.\n", frame_idx );
       fclose( f_ptr );
       return false;
     }
-    if ( !fread( info_ptr->preallocated_frame_blob_ptr, total_sz, 1, f_ptr ) ) {
-      _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", frame_idx );
+    if ( !fread( read_ptr, read_sz, 1, f_ptr ) ) {
+      _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i from sequence file\n", frame_idx );
       fclose( f_ptr );
       return false;
     }
     fclose( f_ptr );
   } // end FILE i/o block
 
-  if ( !_read_vol_frame( info_ptr, frame_idx, frame_data_ptr ) ) {
-    _vol_loggerf( VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
+  if ( compressed ) {
+    VOL_TRACE_BEGIN( "vol_geom_decode_chunk" );
+    bool decode_ok = vol_geom_decode_playback_chunk( entry_ptr, read_ptr, info_ptr->preallocated_frame_blob_ptr, info_ptr->chunk_scratch_ptr );
+    VOL_TRACE_END( "vol_geom_decode_chunk" );
+    if ( !decode_ok ) {
+      _vol_info_loggerf(
+        info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR decoding frame %i chunk with codec %i - chunk is corrupt.\n", frame_idx, (int)entry_ptr->codec );
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool vol_geom_read_frame_from_io( const vol_geom_io_t* io_ptr, const vol_geom_info_t* info_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
+  if ( !io_ptr || !io_ptr->read_fn || !info_ptr || !frame_data_ptr || !info_ptr->playback_entries_ptr ) { return false; }
+  if ( frame_idx >= info_ptr->hdr.frame_count ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR: frame requested (%i) is not in valid range of 0-%i for sequence\n", frame_idx,
+      info_ptr->hdr.frame_count );
+    return false;
+  }
+
+  const vol_geom_playback_entry_t* entry_ptr = &info_ptr->playback_entries_ptr[frame_idx];
+  bool compressed                            = VOL_GEOM_CODEC_NONE != entry_ptr->codec;
+  uint8_t* read_ptr = compressed ? &info_ptr->chunk_scratch_ptr[info_ptr->biggest_frame_blob_sz] : info_ptr->preallocated_frame_blob_ptr;
+  VOL_TRACE_BEGIN( "vol_geom_read_frame_blob" );
+  bool blob_ok = io_ptr->read_fn( io_ptr->user_ptr, entry_ptr->offset, entry_ptr->stored_sz, read_ptr );
+  VOL_TRACE_END( "vol_geom_read_frame_blob" );
+  if ( !blob_ok ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR reading frame %i chunk\n", frame_idx );
+    return false;
+  }
+  if ( compressed ) {
+    VOL_TRACE_BEGIN( "vol_geom_decode_chunk" );
+    bool decode_ok = vol_geom_decode_playback_chunk( entry_ptr, read_ptr, info_ptr->preallocated_frame_blob_ptr, info_ptr->chunk_scratch_ptr );
+    VOL_TRACE_END( "vol_geom_decode_chunk" );
+    if ( !decode_ok ) {
+      _vol_info_loggerf(
+        info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR decoding frame %i chunk with codec %i - chunk is corrupt.\n", frame_idx, (int)entry_ptr->codec );
+      return false;
+    }
+  }
+
+  VOL_TRACE_BEGIN( "vol_geom_parse_frame" );
+  bool parse_ok = _read_vol_frame( info_ptr, frame_idx, frame_data_ptr );
+  VOL_TRACE_END( "vol_geom_parse_frame" );
+  if ( !parse_ok ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
+    return false;
+  }
+  return true;
+}
+
+bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
+  assert( seq_filename && info_ptr && frame_data_ptr );
+  if ( !seq_filename || !info_ptr || !frame_data_ptr ) { return false; }
+
+  VOL_TRACE_BEGIN( "vol_geom_read_frame_blob" );
+  bool blob_ok = _read_frame_blob( seq_filename, info_ptr, frame_idx );
+  VOL_TRACE_END( "vol_geom_read_frame_blob" );
+  if ( !blob_ok ) { return false; }
+
+  VOL_TRACE_BEGIN( "vol_geom_parse_frame" );
+  bool parse_ok = _read_vol_frame( info_ptr, frame_idx, frame_data_ptr );
+  VOL_TRACE_END( "vol_geom_parse_frame" );
+  if ( !parse_ok ) {
+    _vol_info_loggerf( info_ptr, VOL_GEOM_LOG_TYPE_ERROR, "ERROR parsing frame %i\n", frame_idx );
     return false;
   }
   return true;
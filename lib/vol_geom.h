@@ -3,7 +3,7 @@
  *
  * vol_geom  | .vol Geometry Decoding API
  * --------- | ---------------------
- * Version   | 0.11
+ * Version   | 0.15.0
  * Authors   | Anton Gerdelan     <anton@volograms.com>
  *           | Patrick Geoghegan  <patrick@volograms.com>
  * Copyright | 2021, Volograms (http://volograms.com/)
@@ -14,6 +14,57 @@
  * Core library code that reads geometry data for a VOL sequence.
  * These functions are to be built into an application/engine and called from engine code.
  *
+ * Playback containers
+ * -------------------
+ * `vol_geom_create_file_info_from_file()` also opens playback containers, as written by the streamvols tool with `vol_geom_write_playback_*()`.
+ * These hold the same frames as a .vols file, but with an index up front so that opening doesn't scan the sequence,
+ * and with each frame in its own chunk, aligned to VOL_GEOM_PLAYBACK_PAGE_SZ, so any frame is fetched with a single aligned read.
+ * A frame's chunk holds its geometry and, for textured volograms, its texture, so one read gets everything needed to draw it.
+ * Chunks are whole pages, so players can also `mmap()` the file, or read it with `O_DIRECT`, using the offsets in `frames_directory_ptr`.
+ *
+ * All values are little-endian:
+ *
+ *     Header, VOL_GEOM_PLAYBACK_HDR_SZ bytes:
+ *        0 char     magic[4]           "VOLP"
+ *        4 uint32_t playback_version   VOL_GEOM_PLAYBACK_VERSION
+ *        8 uint32_t page_sz            Alignment of the audio and of every frame chunk.
+ *       12 uint32_t frame_count
+ *       16 uint32_t version            .vols version whose frame layout the chunks use, 10 to 13.
+ *       20 uint32_t compression        As in the .vols header.
+ *       24 uint8_t  normals, textured, texture_compression, texture_container_format
+ *       28 uint32_t texture_width, texture_height
+ *       36 float    fps
+ *       40 uint16_t texture_format, reserved
+ *       44 uint32_t audio_sz           0 if there is no audio.
+ *       48 uint64_t audio_offset
+ *       56 uint64_t index_offset
+ *       64 float    translation[3], rotation[4], scale
+ *       96 uint8_t  reserved[32]
+ *     Index, at index_offset, VOL_GEOM_PLAYBACK_ENTRY_SZ bytes per frame:
+ *        0 uint64_t offset             Start of the frame's chunk. A multiple of page_sz.
+ *        8 uint32_t stored_sz          Bytes of the chunk that are used, before padding to page_sz.
+ *       12 uint32_t raw_sz             Size of the frame in .vols layout, after any decompression.
+ *       16 uint32_t mesh_data_sz       As in the frame's header.
+ *       20 uint8_t  keyframe
+ *       21 uint8_t  codec              A `vol_geom_codec_t`.
+ *       22 uint16_t reserved
+ *     Audio, at audio_offset, if audio_sz > 0.
+ *     Frame chunks, each one frame exactly as laid out in a .vols sequence, from its frame number to its trailing size, stored with the entry's codec.
+ *
+ * Each frame chunk is compressed on its own, so any frame can still be read and decoded with one read and no other frames.
+ * The codecs are:
+ *
+ * - VOL_GEOM_CODEC_NONE         - Stored as is.
+ * - VOL_GEOM_CODEC_LZ4          - A single LZ4 block (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), without a frame header.
+ * - VOL_GEOM_CODEC_LZ4_SHUFFLE  - As LZ4, but the frame is byte-shuffled first: for each of the frame's `raw_sz / 4` 4-byte words, byte `b` is stored in
+ *                                 plane `b`, planes in order, then the last `raw_sz % 4` bytes as is. Grouping float exponent bytes compresses meshes better.
+ *
+ * `vol_geom_read_frame()` decodes compressed chunks itself, into a scratch buffer kept in `vol_geom_info_t`.
+ * Players that fetch chunks on their own threads can decode them there with `vol_geom_decode_playback_chunk()`.
+ *
+ * Playback containers can also be read through a `vol_geom_io_t` instead of a file, with `vol_geom_create_file_info_from_io()` and
+ * `vol_geom_read_frame_from_io()`. The io only has to read byte ranges, so it can be backed by memory, an archive, or HTTP range requests (see vol_stream).
+ *
  * Eventually
  * ----------
  * - allow custom allocator
@@ -21,6 +72,13 @@
  *
  * History
  * -------
+ * - 0.15.1 (2026/10/18) - Log sinks are given to the new `_ex` create functions, rather than read from a possibly uninitialised `vol_geom_info_t`.
+ * - 0.15.0 (2026/10/18) - `vol_geom_io_t`, for reading playback containers from sources other than files.
+ * - 0.14.0 (2026/10/18) - LZ4 and byte-shuffled LZ4 compression of playback container frame chunks, and `vol_geom_decode_playback_chunk()`.
+ * - 0.13.0 (2026/10/18) - Opens playback containers with a frame index and page-aligned frame chunks. See "Playback containers" above.
+ * - 0.12.0 (2026/10/18) - Per-vologram log sinks, log level filtering before formatting, and a compile-time minimum log level.
+ * - 0.11.2 (2026/10/18) - Trace markers around frame reads and directory building, when built with VOL_TRACE defined. See vol_trace.h.
+ * - 0.11.1 (2026/10/18) - Fix v1.0 header files being rejected when they end straight after the frame count.
  * - 0.11.0 (2022/04/)   - Support for reading single-file volograms.
  * - 0.10.0 (2022/03/22) - Support added for reading >2GB volograms.
  * - 0.9.0  (2022/03/22) - Version bump for parity with vol_av.
@@ -56,6 +114,43 @@ extern "C" {
 /** Using a specified-size type instead of size_t for better platform consistency. */
 typedef int64_t vol_geom_size_t; // Note that signed int64 should be compatible with off_t.
 
+/** Latest version of the playback container layout that this library can read. */
+#define VOL_GEOM_PLAYBACK_VERSION 1
+/** Size of a playback container's header, in bytes. The frame index usually starts straight after it. */
+#define VOL_GEOM_PLAYBACK_HDR_SZ 128
+/** Size of each frame's entry in a playback container's index, in bytes. */
+#define VOL_GEOM_PLAYBACK_ENTRY_SZ 24
+/** Alignment of frame chunks in playback containers written by vol_geom_write. Matches the page size of common platforms and the block size of most disks. */
+#define VOL_GEOM_PLAYBACK_PAGE_SZ 4096
+
+/** How a frame chunk in a playback container is stored. */
+typedef enum vol_geom_codec_t {
+  VOL_GEOM_CODEC_NONE = 0,    // Uncompressed.
+  VOL_GEOM_CODEC_LZ4,         // An LZ4 block.
+  VOL_GEOM_CODEC_LZ4_SHUFFLE, // Byte-shuffled in 4-byte words, then an LZ4 block.
+  VOL_GEOM_CODEC_MAX          // Not a codec, just used to count the codecs.
+} vol_geom_codec_t;
+
+/** A frame's entry in a playback container's index. See "Playback containers" above for the layout on disk. */
+VOL_GEOM_EXPORT typedef struct vol_geom_playback_entry_t {
+  uint64_t offset;
+  uint32_t stored_sz;
+  uint32_t raw_sz;
+  uint32_t mesh_data_sz;
+  uint8_t keyframe;
+  uint8_t codec;
+} vol_geom_playback_entry_t;
+
+/** A source of playback container bytes, for `vol_geom_create_file_info_from_io()` and `vol_geom_read_frame_from_io()`. */
+VOL_GEOM_EXPORT typedef struct vol_geom_io_t {
+  /// Copy `sz` bytes starting at `offset` into `dst_ptr`. Returns false if any of the bytes could not be read.
+  bool ( *read_fn )( void* user_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr );
+  /// Total size of the container in bytes.
+  vol_geom_size_t total_sz;
+  /// Passed to `read_fn`.
+  void* user_ptr;
+} vol_geom_io_t;
+
 /** Helper struct to store Unity-style strings from VOL file. */
 VOL_GEOM_EXPORT typedef struct vol_geom_short_str_t {
   /// Bytes of string.
@@ -134,6 +229,16 @@ VOL_GEOM_EXPORT typedef struct vol_geom_info_t {
   uint8_t* sequence_blob_byte_ptr;
   /// Byte offset of the sequence chunk from the start of file. For separated hdr/seq files this will be 0.
   vol_geom_size_t sequence_offset;
+  /// Version of the playback container the vologram was opened from, or 0 for a .vols file. Frame offsets in a playback container are page-aligned.
+  uint32_t playback_version;
+  /// Playback containers only, otherwise NULL: the container's index, one entry per frame.
+  vol_geom_playback_entry_t* playback_entries_ptr;
+  /// Playback containers with compressed chunks only, otherwise NULL: where `vol_geom_read_frame()` reads and decodes chunks.
+  /// `biggest_frame_blob_sz` bytes of decode scratch, followed by room for the biggest stored chunk.
+  uint8_t* chunk_scratch_ptr;
+  /// Where this vologram's log messages go. If NULL then the global log callback is used.
+  /// Set from the `sink_ptr` given to the `_ex` create functions, e.g. `vol_geom_create_file_info_ex()`. The other create functions set it to NULL.
+  const struct vol_geom_log_sink_t* log_sink_ptr;
 } vol_geom_info_t;
 
 /** Meta-data for each from of the Vologram sequence. */
@@ -180,22 +285,60 @@ typedef enum vol_geom_log_type_t {
   VOL_GEOM_LOG_STR_MAX_LEN // Not an error type, just used to count the error types.
 } vol_geom_log_type_t;
 
-/** To silence log output or pipe log messages into a user function.
+/** Messages less severe than this are removed when the library is compiled, including the evaluation of their arguments.
+ * Severity order is DEBUG < INFO < WARNING < ERROR. e.g. build with `-DVOL_GEOM_LOG_MIN_TYPE=VOL_GEOM_LOG_TYPE_WARNING` for release plugins.
+ */
+#ifndef VOL_GEOM_LOG_MIN_TYPE
+#define VOL_GEOM_LOG_MIN_TYPE VOL_GEOM_LOG_TYPE_DEBUG
+#endif
+
+/** A destination for one vologram's log messages, given to e.g. `vol_geom_create_file_info_ex()`.
+ * Separate readers with separate sinks don't share any logging state, so they can log from separate threads.
+ * The sink must outlive any `vol_geom_info_t` that points to it.
+ */
+typedef struct vol_geom_log_sink_t {
+  /// Called for each message of at least `min_log_type`. If NULL then messages are discarded.
+  void ( *callback_ptr )( vol_geom_log_type_t log_type, const char* message_str, void* user_ptr );
+  /// Passed through to `callback_ptr`, e.g. a `vol_log_ring_t` pointer.
+  void* user_ptr;
+  /// Least severe type of message to pass on. Messages are filtered before they are formatted. The zero value, INFO, discards DEBUG messages.
+  vol_geom_log_type_t min_log_type;
+} vol_geom_log_sink_t;
+
+/** To silence log output or pipe log messages into a user function. This is used for volograms without their own `log_sink_ptr`.
  * @param user_function_ptr
  */
 VOL_GEOM_EXPORT void vol_geom_set_log_callback( void ( *user_function_ptr )( vol_geom_log_type_t log_type, const char* message_str ) );
 
 VOL_GEOM_EXPORT void vol_geom_reset_log_callback( void );
 
+/** Set the least severe type of message passed to the global log callback. Defaults to VOL_GEOM_LOG_TYPE_DEBUG, so everything is logged.
+ * Filtered messages are not formatted, so they cost almost nothing.
+ */
+VOL_GEOM_EXPORT void vol_geom_set_log_level( vol_geom_log_type_t min_log_type );
+
 /** Read a header from the top of a .vols blob in memory. */
 VOL_GEOM_EXPORT bool vol_geom_read_hdr_from_mem( const uint8_t* data_ptr, uint32_t data_sz, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr );
 
 /** Read a header from the top of a .vols file. */
 VOL_GEOM_EXPORT bool vol_geom_read_hdr_from_file( const char* filename, vol_geom_file_hdr_t* hdr_ptr, vol_geom_size_t* hdr_sz_ptr );
 
-/** As vol_geom_create_file_info, but for volograms where the contents { header, sequence } are all in one .vols file. */
+/** As vol_geom_create_file_info, but for volograms where the contents { header, sequence } are all in one .vols file, or in a playback container. */
 VOL_GEOM_EXPORT bool vol_geom_create_file_info_from_file( const char* vols_filename, vol_geom_info_t* info_ptr );
 
+/** As vol_geom_create_file_info_from_file, but the vologram logs to `sink_ptr`, or to the global log callback if it is NULL. */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_from_file_ex( const char* vols_filename, vol_geom_info_t* info_ptr, const vol_geom_log_sink_t* sink_ptr );
+
+/** As vol_geom_create_file_info_from_file, but reads a playback container through `io_ptr`. Only the header, index, and audio are read.
+ * .vols files are not supported, as building their frames directory means reading every frame's header.
+ * @param io_ptr         The container's bytes. Must not be NULL. Only used during the call.
+ * @returns              False on a read error, or if the io is not a playback container. Allocated memory is cleaned up on failure.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_from_io( const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr );
+
+/** As vol_geom_create_file_info_from_io, but the vologram logs to `sink_ptr`, or to the global log callback if it is NULL. */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_from_io_ex( const vol_geom_io_t* io_ptr, vol_geom_info_t* info_ptr, const vol_geom_log_sink_t* sink_ptr );
+
 /** Call this function before playing a vologram sequence.
  * It will build a directory of file and frame information about the VOL sequence, and pre-allocate memory.
  * You only need to call this function once per Vologram - you can keep the vol_geom_info_t struct in memory and re-use it during playback.
@@ -212,6 +355,12 @@ VOL_GEOM_EXPORT bool vol_geom_create_file_info_from_file( const char* vols_filen
  */
 VOL_GEOM_EXPORT bool vol_geom_create_file_info( const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode );
 
+/** As vol_geom_create_file_info, but the vologram logs to `sink_ptr`, or to the global log callback if it is NULL.
+ * The sink is stored in `info_ptr->log_sink_ptr`, and must outlive the vologram. `info_ptr` doesn't need to be initialised first.
+ */
+VOL_GEOM_EXPORT bool vol_geom_create_file_info_ex(
+  const char* hdr_filename, const char* seq_filename, vol_geom_info_t* info_ptr, bool streaming_mode, const vol_geom_log_sink_t* sink_ptr );
+
 /** Call this function to free memory allocated by a call to `vol_geom_create_file_info()` and reset struct to defaults.
  * @param info_ptr       Pointer to a `vol_geom_info_t` struct in your application that will be populated by this function. Must not be NULL.
  * @returns              False error such as NULL pointers where allocated memory was expected.
@@ -242,6 +391,25 @@ VOL_GEOM_EXPORT int vol_geom_find_previous_keyframe( const vol_geom_info_t* info
  */
 VOL_GEOM_EXPORT bool vol_geom_read_frame( const char* seq_filename, const vol_geom_info_t* info_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr );
 
+/** As vol_geom_read_frame, but for a playback container opened with `vol_geom_create_file_info_from_io()`.
+ * Reads exactly one range from `io_ptr`: the frame's chunk at `playback_entries_ptr[frame_idx].offset`, of `stored_sz` bytes.
+ * @param io_ptr         The container's bytes. Must not be NULL. This need not be the io the info was created with, e.g. it may serve a prefetched chunk.
+ * @returns              False on any error including `frame_idx` range validation, a failed read, or a corrupt chunk.
+ */
+VOL_GEOM_EXPORT bool vol_geom_read_frame_from_io(
+  const vol_geom_io_t* io_ptr, const vol_geom_info_t* info_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr );
+
+/** Decode a playback container's frame chunk, as stored on disk, back to the frame's .vols layout.
+ * This touches no state other than its arguments, so it is safe to call from any thread, e.g. to decode prefetched chunks on worker threads.
+ * @param entry_ptr   The frame's index entry, e.g. from `vol_geom_info_t->playback_entries_ptr`. Must not be NULL.
+ * @param stored_ptr  The chunk's first `entry_ptr->stored_sz` bytes, read from `entry_ptr->offset`. Must not be NULL.
+ * @param raw_ptr     Receives `entry_ptr->raw_sz` bytes of the decoded frame. Must not be NULL.
+ * @param scratch_ptr `entry_ptr->raw_sz` bytes of working memory, used by VOL_GEOM_CODEC_LZ4_SHUFFLE. May be NULL for other codecs.
+ * @returns           False if the codec is unknown, or the chunk is corrupt and doesn't decode to exactly `raw_sz` bytes.
+ */
+VOL_GEOM_EXPORT bool vol_geom_decode_playback_chunk(
+  const vol_geom_playback_entry_t* entry_ptr, const uint8_t* stored_ptr, uint8_t* raw_ptr, uint8_t* scratch_ptr );
+
 #ifdef __cplusplus
 }
 #endif /* CPP */
@@ -0,0 +1,428 @@
+/** @file vol_geom_write.c
+ * Volograms Geometry Encoding API
+ *
+ * vol_geom_write | .vols Geometry Encoding API
+ * -------------- | ---------------------
+ * Version        | 0.3
+ * Authors        | See matching header file.
+ * Copyright      | 2026, Volograms (http://volograms.com/)
+ * Language       | C99
+ * Files          | 2
+ * Licence        | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_geom_write.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 64-bit offsets, as in vol_geom, so playback containers over 2GB can be written.
+#if defined( _WIN32 ) || defined( _WIN64 )
+#define vol_geom_write_fseeko _fseeki64
+#define vol_geom_write_ftello _ftelli64
+#else
+#define vol_geom_write_fseeko fseeko
+#define vol_geom_write_ftello ftello
+#endif
+
+/** Helper to write a Unity-style string (1-byte length then the bytes, without a terminator). */
+static bool _write_short_str( FILE* f_ptr, const vol_geom_short_str_t* sstr ) {
+  uint8_t sz = sstr->sz > 127 ? 127 : sstr->sz;
+  if ( 1 != fwrite( &sz, 1, 1, f_ptr ) ) { return false; }
+  if ( sz > 0 && 1 != fwrite( sstr->bytes, sz, 1, f_ptr ) ) { return false; }
+  return true;
+}
+
+/** Where frames are written: a file, or if `f_ptr` is NULL, a memory buffer. Playback frames go to memory to be compressed.
+ * With neither, bytes are only counted in `pos`.
+ */
+typedef struct _sink_t {
+  FILE* f_ptr;
+  uint8_t* mem_ptr;
+  size_t mem_sz, pos;
+} _sink_t;
+
+static bool _sink_write( _sink_t* sink_ptr, const void* data_ptr, size_t data_sz ) {
+  if ( sink_ptr->f_ptr ) {
+    if ( 1 != fwrite( data_ptr, data_sz, 1, sink_ptr->f_ptr ) ) { return false; }
+  } else if ( sink_ptr->mem_ptr ) {
+    if ( sink_ptr->mem_sz - sink_ptr->pos < data_sz ) { return false; }
+    memcpy( &sink_ptr->mem_ptr[sink_ptr->pos], data_ptr, data_sz );
+  }
+  sink_ptr->pos += data_sz;
+  return true;
+}
+
+/** Helper to write an array section: a uint32 size in bytes followed by the data. */
+static bool _write_array( _sink_t* sink_ptr, const void* data_ptr, uint32_t data_sz ) {
+  if ( !_sink_write( sink_ptr, &data_sz, sizeof( uint32_t ) ) ) { return false; }
+  if ( data_sz > 0 && ( !data_ptr || !_sink_write( sink_ptr, data_ptr, data_sz ) ) ) { return false; }
+  return true;
+}
+
+bool vol_geom_write_hdr( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const uint8_t* audio_ptr, uint32_t audio_sz ) {
+  if ( !f_ptr || !hdr_ptr ) { return false; }
+  if ( hdr_ptr->version < 10 || hdr_ptr->version > 13 ) { return false; }
+  if ( hdr_ptr->version >= 13 && hdr_ptr->audio && ( !audio_ptr || 0 == audio_sz ) ) { return false; }
+
+  if ( hdr_ptr->version >= 13 ) {
+    // v1.3 uses IFF-style magic numbers and drops the strings and topology fields.
+    uint8_t flags[4]          = { (uint8_t)hdr_ptr->normals, (uint8_t)hdr_ptr->textured, hdr_ptr->texture_compression, hdr_ptr->texture_container_format };
+    uint32_t audio            = hdr_ptr->audio ? 1 : 0;
+    uint32_t audio_start      = VOL_GEOM_WRITE_V13_HDR_SZ;
+    uint32_t frame_body_start = VOL_GEOM_WRITE_V13_HDR_SZ + (uint32_t)sizeof( uint32_t ) + ( audio ? audio_sz : 0 );
+    if ( 1 != fwrite( "VOLS", 4, 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &hdr_ptr->version, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &hdr_ptr->compression, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &hdr_ptr->frame_count, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( flags, sizeof( flags ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &hdr_ptr->texture_width, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &hdr_ptr->texture_height, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &hdr_ptr->fps, sizeof( float ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &audio, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &audio_start, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    if ( 1 != fwrite( &frame_body_start, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+    // The audio chunk always has its size field, so frames start at 48 when there is no audio.
+    _sink_t sink = ( _sink_t ){ .f_ptr = f_ptr };
+    if ( !_write_array( &sink, audio ? audio_ptr : NULL, audio ? audio_sz : 0 ) ) { return false; }
+    return true;
+  }
+
+  vol_geom_short_str_t format = ( vol_geom_short_str_t ){ .sz = 4 };
+  memcpy( format.bytes, "VOLS", 4 );
+  if ( !_write_short_str( f_ptr, &format ) ) { return false; }
+  if ( 1 != fwrite( &hdr_ptr->version, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( &hdr_ptr->compression, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+  if ( !_write_short_str( f_ptr, &hdr_ptr->mesh_name ) ) { return false; }
+  if ( !_write_short_str( f_ptr, &hdr_ptr->material ) ) { return false; }
+  if ( !_write_short_str( f_ptr, &hdr_ptr->shader ) ) { return false; }
+  if ( 1 != fwrite( &hdr_ptr->topology, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( &hdr_ptr->frame_count, sizeof( uint32_t ), 1, f_ptr ) ) { return false; }
+  if ( hdr_ptr->version < 11 ) { return true; }
+
+  uint8_t flags[2] = { (uint8_t)hdr_ptr->normals, (uint8_t)hdr_ptr->textured };
+  uint16_t w = (uint16_t)hdr_ptr->texture_width, h = (uint16_t)hdr_ptr->texture_height;
+  if ( 1 != fwrite( flags, sizeof( flags ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( &w, sizeof( uint16_t ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( &h, sizeof( uint16_t ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( &hdr_ptr->texture_format, sizeof( uint16_t ), 1, f_ptr ) ) { return false; }
+  if ( hdr_ptr->version < 12 ) { return true; }
+
+  if ( 1 != fwrite( hdr_ptr->translation, 3 * sizeof( float ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( hdr_ptr->rotation, 4 * sizeof( float ), 1, f_ptr ) ) { return false; }
+  if ( 1 != fwrite( &hdr_ptr->scale, sizeof( float ), 1, f_ptr ) ) { return false; }
+  return true;
+}
+
+/** Works out the `mesh_data_sz` field of a frame's header, which is also written after the frame.
+ * @returns False if the frame is too big for the field.
+ */
+static bool _mesh_data_sz( const vol_geom_file_hdr_t* hdr_ptr, const vol_geom_write_frame_t* frame_ptr, uint32_t* mesh_data_sz_ptr ) {
+  // Which sections are present follows the same rules as the reader in vol_geom.c.
+  bool has_normals = hdr_ptr->normals && hdr_ptr->version >= 11;
+  bool has_indices = 1 == frame_ptr->keyframe || ( hdr_ptr->version >= 12 && 2 == frame_ptr->keyframe );
+  bool has_texture = hdr_ptr->textured && hdr_ptr->version >= 11;
+
+  // Payload is everything between the keyframe byte and the trailing size integer.
+  uint64_t payload_sz = sizeof( uint32_t ) + (uint64_t)frame_ptr->vertices_sz;
+  if ( has_normals ) { payload_sz += sizeof( uint32_t ) + (uint64_t)frame_ptr->normals_sz; }
+  if ( has_indices ) { payload_sz += 2 * sizeof( uint32_t ) + (uint64_t)frame_ptr->indices_sz + (uint64_t)frame_ptr->uvs_sz; }
+  if ( has_texture ) { payload_sz += sizeof( uint32_t ) + (uint64_t)frame_ptr->texture_sz; }
+
+  // Versions before 12 don't count some of the array size integers in mesh_data_sz. This is the inverse of the correction made when reading.
+  uint64_t correction_sz = 0;
+  if ( hdr_ptr->version < 12 ) {
+    if ( 1 == frame_ptr->keyframe ) { correction_sz += 8; }
+    if ( 11 == hdr_ptr->version ) {
+      correction_sz += 4;
+      if ( hdr_ptr->textured ) { correction_sz += 4; }
+    }
+  }
+  if ( payload_sz < correction_sz || payload_sz - correction_sz > UINT32_MAX ) { return false; }
+  *mesh_data_sz_ptr = (uint32_t)( payload_sz - correction_sz );
+  return true;
+}
+
+static bool _write_frame( _sink_t* sink_ptr, const vol_geom_file_hdr_t* hdr_ptr, const vol_geom_write_frame_t* frame_ptr ) {
+  bool has_normals      = hdr_ptr->normals && hdr_ptr->version >= 11;
+  bool has_indices      = 1 == frame_ptr->keyframe || ( hdr_ptr->version >= 12 && 2 == frame_ptr->keyframe );
+  bool has_texture      = hdr_ptr->textured && hdr_ptr->version >= 11;
+  uint32_t mesh_data_sz = 0;
+  if ( !_mesh_data_sz( hdr_ptr, frame_ptr, &mesh_data_sz ) ) { return false; }
+
+  if ( !_sink_write( sink_ptr, &frame_ptr->frame_number, sizeof( uint32_t ) ) ) { return false; }
+  if ( !_sink_write( sink_ptr, &mesh_data_sz, sizeof( uint32_t ) ) ) { return false; }
+  if ( !_sink_write( sink_ptr, &frame_ptr->keyframe, sizeof( uint8_t ) ) ) { return false; }
+  if ( !_write_array( sink_ptr, frame_ptr->vertices_ptr, frame_ptr->vertices_sz ) ) { return false; }
+  if ( has_normals && !_write_array( sink_ptr, frame_ptr->normals_ptr, frame_ptr->normals_sz ) ) { return false; }
+  if ( has_indices ) {
+    if ( !_write_array( sink_ptr, frame_ptr->indices_ptr, frame_ptr->indices_sz ) ) { return false; }
+    if ( !_write_array( sink_ptr, frame_ptr->uvs_ptr, frame_ptr->uvs_sz ) ) { return false; }
+  }
+  if ( has_texture && !_write_array( sink_ptr, frame_ptr->texture_ptr, frame_ptr->texture_sz ) ) { return false; }
+  if ( !_sink_write( sink_ptr, &mesh_data_sz, sizeof( uint32_t ) ) ) { return false; } // Trailing "frame data size".
+
+  return true;
+}
+
+bool vol_geom_write_frame( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const vol_geom_write_frame_t* frame_ptr ) {
+  if ( !f_ptr || !hdr_ptr || !frame_ptr ) { return false; }
+
+  _sink_t sink = ( _sink_t ){ .f_ptr = f_ptr };
+  return _write_frame( &sink, hdr_ptr, frame_ptr );
+}
+
+void vol_geom_write_frame_from_data( const vol_geom_info_t* info_ptr, uint32_t frame_idx, const uint8_t* block_data_ptr,
+  const vol_geom_frame_data_t* frame_data_ptr, vol_geom_write_frame_t* write_frame_ptr ) {
+  if ( !info_ptr || !block_data_ptr || !frame_data_ptr || !write_frame_ptr || frame_idx >= info_ptr->hdr.frame_count ) { return; }
+
+  *write_frame_ptr              = ( vol_geom_write_frame_t ){ .frame_number = frame_idx };
+  write_frame_ptr->keyframe     = info_ptr->frame_headers_ptr[frame_idx].keyframe;
+  write_frame_ptr->vertices_ptr = &block_data_ptr[frame_data_ptr->vertices_offset];
+  write_frame_ptr->vertices_sz  = frame_data_ptr->vertices_sz;
+  if ( frame_data_ptr->normals_sz > 0 ) {
+    write_frame_ptr->normals_ptr = &block_data_ptr[frame_data_ptr->normals_offset];
+    write_frame_ptr->normals_sz  = frame_data_ptr->normals_sz;
+  }
+  if ( frame_data_ptr->indices_sz > 0 ) {
+    write_frame_ptr->indices_ptr = &block_data_ptr[frame_data_ptr->indices_offset];
+    write_frame_ptr->indices_sz  = frame_data_ptr->indices_sz;
+  }
+  if ( frame_data_ptr->uvs_sz > 0 ) {
+    write_frame_ptr->uvs_ptr = &block_data_ptr[frame_data_ptr->uvs_offset];
+    write_frame_ptr->uvs_sz  = frame_data_ptr->uvs_sz;
+  }
+  if ( frame_data_ptr->texture_sz > 0 ) {
+    write_frame_ptr->texture_ptr = &block_data_ptr[frame_data_ptr->texture_offset];
+    write_frame_ptr->texture_sz  = frame_data_ptr->texture_sz;
+  }
+}
+
+/** Writes zeros up to the next multiple of VOL_GEOM_PLAYBACK_PAGE_SZ. */
+static bool _pad_to_page( FILE* f_ptr ) {
+  static const uint8_t zeros[VOL_GEOM_PLAYBACK_PAGE_SZ] = { 0 };
+  int64_t offset                                       = vol_geom_write_ftello( f_ptr );
+  if ( offset < 0 ) { return false; }
+  size_t pad_sz = (size_t)( ( VOL_GEOM_PLAYBACK_PAGE_SZ - offset % VOL_GEOM_PLAYBACK_PAGE_SZ ) % VOL_GEOM_PLAYBACK_PAGE_SZ );
+  return 0 == pad_sz || 1 == fwrite( zeros, pad_sz, 1, f_ptr );
+}
+
+#define _LZ4_HASH_BITS 14
+#define _LZ4_MIN_MATCH 4
+#define _LZ4_LAST_LITERALS 5 // The format requires a block to end with at least this many literals...
+#define _LZ4_MATCH_LIMIT 12  // ...and its last match to start at least this many bytes before the end.
+#define _LZ4_MAX_OFFSET 65535
+
+static uint32_t _read_u32( const uint8_t* ptr ) {
+  uint32_t v;
+  memcpy( &v, ptr, sizeof( uint32_t ) );
+  return v;
+}
+
+static uint32_t _lz4_hash( uint32_t v ) { return ( v * 2654435761u ) >> ( 32 - _LZ4_HASH_BITS ); }
+
+/** Writes the extra bytes of a literal or match length that didn't fit in its token's 4 bits. */
+static uint8_t* _lz4_write_len( uint8_t* op, size_t len ) {
+  for ( ; len >= 255; len -= 255 ) { *op++ = 255; }
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+/** @returns Room to allow for compressing `src_sz` bytes, in the worst case of data with no matches. */
+static size_t _lz4_compress_bound( size_t src_sz ) { return src_sz + src_sz / 255 + 16; }
+
+/** Greedy LZ4 block compression, with one hash table lookup per position, much like the reference library's fast mode.
+ * @param table_ptr Working memory of 1 << _LZ4_HASH_BITS positions.
+ * @returns The compressed size, or 0 if it would exceed `dst_sz`.
+ */
+static size_t _lz4_compress( const uint8_t* src_ptr, size_t src_sz, uint8_t* dst_ptr, size_t dst_sz, uint32_t* table_ptr ) {
+  const uint8_t* ip     = src_ptr;
+  const uint8_t* anchor = src_ptr; // Start of the literals not yet written.
+  const uint8_t* ip_end = src_ptr + src_sz;
+  uint8_t* op           = dst_ptr;
+  const uint8_t* op_end = dst_ptr + dst_sz;
+  memset( table_ptr, 0, ( (size_t)1 << _LZ4_HASH_BITS ) * sizeof( uint32_t ) );
+
+  if ( src_sz > _LZ4_MATCH_LIMIT ) {
+    const uint8_t* match_start_limit = ip_end - _LZ4_MATCH_LIMIT;
+    const uint8_t* match_end_limit   = ip_end - _LZ4_LAST_LITERALS;
+    while ( ip <= match_start_limit ) {
+      uint32_t seq       = _read_u32( ip );
+      uint32_t h         = _lz4_hash( seq );
+      const uint8_t* ref = src_ptr + table_ptr[h];
+      table_ptr[h]       = (uint32_t)( ip - src_ptr );
+      if ( ref >= ip || ip - ref > _LZ4_MAX_OFFSET || _read_u32( ref ) != seq ) {
+        ip += 1 + ( ( ip - anchor ) >> 6 ); // Skip faster through data that isn't matching.
+        continue;
+      }
+      while ( ip > anchor && ref > src_ptr && ip[-1] == ref[-1] ) { // Extend the match backwards into the literals.
+        ip--;
+        ref--;
+      }
+      const uint8_t* match_end = ip + _LZ4_MIN_MATCH;
+      const uint8_t* ref_end   = ref + _LZ4_MIN_MATCH;
+      while ( match_end < match_end_limit && *match_end == *ref_end ) {
+        match_end++;
+        ref_end++;
+      }
+
+      size_t lit_len   = (size_t)( ip - anchor );
+      size_t match_len = (size_t)( match_end - ip ) - _LZ4_MIN_MATCH;
+      if ( (size_t)( op_end - op ) < 1 + lit_len / 255 + 1 + lit_len + 2 + match_len / 255 + 1 ) { return 0; }
+      uint8_t* token_ptr = op++;
+      *token_ptr         = (uint8_t)( ( lit_len < 15 ? lit_len : 15 ) << 4 );
+      if ( lit_len >= 15 ) { op = _lz4_write_len( op, lit_len - 15 ); }
+      memcpy( op, anchor, lit_len );
+      op += lit_len;
+      uint16_t offset = (uint16_t)( ip - ref );
+      *op++           = (uint8_t)( offset & 0xFF );
+      *op++           = (uint8_t)( offset >> 8 );
+      *token_ptr |= (uint8_t)( match_len < 15 ? match_len : 15 );
+      if ( match_len >= 15 ) { op = _lz4_write_len( op, match_len - 15 ); }
+
+      ip = anchor = match_end;
+      if ( ip <= match_start_limit ) { table_ptr[_lz4_hash( _read_u32( ip - 2 ) )] = (uint32_t)( ip - 2 - src_ptr ); }
+    }
+  }
+
+  // The rest is literals.
+  size_t lit_len = (size_t)( ip_end - anchor );
+  if ( (size_t)( op_end - op ) < 1 + lit_len / 255 + 1 + lit_len ) { return 0; }
+  uint8_t* token_ptr = op++;
+  *token_ptr         = (uint8_t)( ( lit_len < 15 ? lit_len : 15 ) << 4 );
+  if ( lit_len >= 15 ) { op = _lz4_write_len( op, lit_len - 15 ); }
+  memcpy( op, anchor, lit_len );
+  op += lit_len;
+  return (size_t)( op - dst_ptr );
+}
+
+/** The byte shuffle of VOL_GEOM_CODEC_LZ4_SHUFFLE. See "Playback containers" in vol_geom.h. */
+static void _shuffle4( const uint8_t* src_ptr, uint8_t* dst_ptr, size_t sz ) {
+  size_t n_words = sz / 4;
+  for ( size_t b = 0; b < 4; b++ ) {
+    uint8_t* plane_ptr = &dst_ptr[b * n_words];
+    for ( size_t i = 0; i < n_words; i++ ) { plane_ptr[i] = src_ptr[i * 4 + b]; }
+  }
+  memcpy( &dst_ptr[n_words * 4], &src_ptr[n_words * 4], sz - n_words * 4 );
+}
+
+bool vol_geom_write_playback_hdr( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const uint8_t* audio_ptr, uint32_t audio_sz ) {
+  if ( !f_ptr || !hdr_ptr ) { return false; }
+  if ( hdr_ptr->version < 10 || hdr_ptr->version > 13 ) { return false; }
+  if ( audio_sz > 0 && !audio_ptr ) { return false; }
+
+  // The index goes straight after the header. Audio, then frames, start on the following pages.
+  const uint64_t page_sz = VOL_GEOM_PLAYBACK_PAGE_SZ;
+  uint64_t index_offset  = VOL_GEOM_PLAYBACK_HDR_SZ;
+  uint64_t index_end     = index_offset + (uint64_t)hdr_ptr->frame_count * VOL_GEOM_PLAYBACK_ENTRY_SZ;
+  uint64_t audio_offset  = audio_sz > 0 ? ( index_end + page_sz - 1 ) / page_sz * page_sz : 0;
+
+  uint8_t hdr[VOL_GEOM_PLAYBACK_HDR_SZ] = { 0 };
+  uint32_t playback_version             = VOL_GEOM_PLAYBACK_VERSION, page_sz_u32 = VOL_GEOM_PLAYBACK_PAGE_SZ;
+  memcpy( &hdr[0], "VOLP", 4 );
+  memcpy( &hdr[4], &playback_version, sizeof( uint32_t ) );
+  memcpy( &hdr[8], &page_sz_u32, sizeof( uint32_t ) );
+  memcpy( &hdr[12], &hdr_ptr->frame_count, sizeof( uint32_t ) );
+  memcpy( &hdr[16], &hdr_ptr->version, sizeof( uint32_t ) );
+  memcpy( &hdr[20], &hdr_ptr->compression, sizeof( uint32_t ) );
+  hdr[24] = (uint8_t)hdr_ptr->normals;
+  hdr[25] = (uint8_t)hdr_ptr->textured;
+  hdr[26] = hdr_ptr->texture_compression;
+  hdr[27] = hdr_ptr->texture_container_format;
+  memcpy( &hdr[28], &hdr_ptr->texture_width, sizeof( uint32_t ) );
+  memcpy( &hdr[32], &hdr_ptr->texture_height, sizeof( uint32_t ) );
+  memcpy( &hdr[36], &hdr_ptr->fps, sizeof( float ) );
+  memcpy( &hdr[40], &hdr_ptr->texture_format, sizeof( uint16_t ) );
+  memcpy( &hdr[44], &audio_sz, sizeof( uint32_t ) );
+  memcpy( &hdr[48], &audio_offset, sizeof( uint64_t ) );
+  memcpy( &hdr[56], &index_offset, sizeof( uint64_t ) );
+  memcpy( &hdr[64], hdr_ptr->translation, 3 * sizeof( float ) );
+  memcpy( &hdr[76], hdr_ptr->rotation, 4 * sizeof( float ) );
+  memcpy( &hdr[92], &hdr_ptr->scale, sizeof( float ) );
+  if ( 1 != fwrite( hdr, sizeof( hdr ), 1, f_ptr ) ) { return false; }
+
+  // Zeros until the index is written at the end.
+  uint8_t entry[VOL_GEOM_PLAYBACK_ENTRY_SZ] = { 0 };
+  for ( uint32_t i = 0; i < hdr_ptr->frame_count; i++ ) {
+    if ( 1 != fwrite( entry, sizeof( entry ), 1, f_ptr ) ) { return false; }
+  }
+  if ( audio_sz > 0 ) {
+    if ( !_pad_to_page( f_ptr ) ) { return false; }
+    if ( 1 != fwrite( audio_ptr, audio_sz, 1, f_ptr ) ) { return false; }
+  }
+  return _pad_to_page( f_ptr );
+}
+
+bool vol_geom_write_playback_frame( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const vol_geom_write_frame_t* frame_ptr, vol_geom_codec_t codec,
+  vol_geom_playback_entry_t* entry_ptr ) {
+  if ( !f_ptr || !hdr_ptr || !frame_ptr || !entry_ptr || codec >= VOL_GEOM_CODEC_MAX ) { return false; }
+
+  int64_t offset = vol_geom_write_ftello( f_ptr );
+  if ( offset < 0 || 0 != offset % VOL_GEOM_PLAYBACK_PAGE_SZ ) { return false; }
+  *entry_ptr = ( vol_geom_playback_entry_t ){ .offset = (uint64_t)offset, .keyframe = frame_ptr->keyframe, .codec = VOL_GEOM_CODEC_NONE };
+  if ( !_mesh_data_sz( hdr_ptr, frame_ptr, &entry_ptr->mesh_data_sz ) ) { return false; }
+
+  if ( VOL_GEOM_CODEC_NONE == codec ) {
+    if ( !vol_geom_write_frame( f_ptr, hdr_ptr, frame_ptr ) ) { return false; }
+    int64_t end = vol_geom_write_ftello( f_ptr );
+    if ( end < offset || end - offset > UINT32_MAX ) { return false; }
+    entry_ptr->raw_sz    = (uint32_t)( end - offset );
+    entry_ptr->stored_sz = entry_ptr->raw_sz;
+    return _pad_to_page( f_ptr );
+  }
+
+  // Measure the frame, lay it out in memory, then compress it.
+  _sink_t sink = ( _sink_t ){ .f_ptr = NULL };
+  if ( !_write_frame( &sink, hdr_ptr, frame_ptr ) || sink.pos > UINT32_MAX ) { return false; }
+  size_t raw_sz    = sink.pos;
+  size_t table_sz  = ( (size_t)1 << _LZ4_HASH_BITS ) * sizeof( uint32_t );
+  uint8_t* mem_ptr = malloc( table_sz + raw_sz * 2 + _lz4_compress_bound( raw_sz ) );
+  if ( !mem_ptr ) { return false; }
+  uint32_t* table_ptr     = (uint32_t*)mem_ptr;
+  uint8_t* raw_ptr        = &mem_ptr[table_sz];
+  uint8_t* shuffled_ptr   = &raw_ptr[raw_sz];
+  uint8_t* compressed_ptr = &shuffled_ptr[raw_sz];
+  bool ok                 = false;
+
+  sink = ( _sink_t ){ .mem_ptr = raw_ptr, .mem_sz = raw_sz };
+  if ( !_write_frame( &sink, hdr_ptr, frame_ptr ) ) { goto wpf_end; }
+  entry_ptr->raw_sz = (uint32_t)raw_sz;
+
+  const uint8_t* src_ptr = raw_ptr;
+  if ( VOL_GEOM_CODEC_LZ4_SHUFFLE == codec ) {
+    _shuffle4( raw_ptr, shuffled_ptr, raw_sz );
+    src_ptr = shuffled_ptr;
+  }
+  // Frames that don't get smaller, such as those that are mostly an already-compressed texture, are stored as they are.
+  size_t compressed_sz = _lz4_compress( src_ptr, raw_sz, compressed_ptr, raw_sz - 1, table_ptr );
+  if ( compressed_sz > 0 ) {
+    entry_ptr->codec     = (uint8_t)codec;
+    entry_ptr->stored_sz = (uint32_t)compressed_sz;
+    ok                   = 1 == fwrite( compressed_ptr, compressed_sz, 1, f_ptr );
+  } else {
+    entry_ptr->stored_sz = entry_ptr->raw_sz;
+    ok                   = 1 == fwrite( raw_ptr, raw_sz, 1, f_ptr );
+  }
+  ok = ok && _pad_to_page( f_ptr );
+
+wpf_end:
+  free( mem_ptr );
+  return ok;
+}
+
+bool vol_geom_write_playback_index( FILE* f_ptr, const vol_geom_playback_entry_t* entries_ptr, uint32_t n_entries ) {
+  if ( !f_ptr || ( n_entries > 0 && !entries_ptr ) ) { return false; }
+
+  int64_t end = vol_geom_write_ftello( f_ptr );
+  if ( end < 0 || 0 != vol_geom_write_fseeko( f_ptr, VOL_GEOM_PLAYBACK_HDR_SZ, SEEK_SET ) ) { return false; }
+  for ( uint32_t i = 0; i < n_entries; i++ ) {
+    uint8_t entry[VOL_GEOM_PLAYBACK_ENTRY_SZ] = { 0 };
+    memcpy( &entry[0], &entries_ptr[i].offset, sizeof( uint64_t ) );
+    memcpy( &entry[8], &entries_ptr[i].stored_sz, sizeof( uint32_t ) );
+    memcpy( &entry[12], &entries_ptr[i].raw_sz, sizeof( uint32_t ) );
+    memcpy( &entry[16], &entries_ptr[i].mesh_data_sz, sizeof( uint32_t ) );
+    entry[20] = entries_ptr[i].keyframe;
+    entry[21] = entries_ptr[i].codec;
+    if ( 1 != fwrite( entry, sizeof( entry ), 1, f_ptr ) ) { return false; }
+  }
+  return 0 == vol_geom_write_fseeko( f_ptr, end, SEEK_SET );
+}
@@ -0,0 +1,123 @@
+/**  @file vol_geom_write.h
+ * Volograms Geometry Encoding API
+ *
+ * vol_geom_write | .vols Geometry Encoding API
+ * -------------- | ---------------------
+ * Version        | 0.3
+ * Authors        | Anton Gerdelan     <anton@volograms.com>
+ * Copyright      | 2026, Volograms (http://volograms.com/)
+ * Language       | C99
+ * Files          | 2
+ * Licence        | The MIT License. See LICENSE.md for details.
+ *
+ * Counterpart to vol_geom for tools that need to write .vols files.
+ * It writes headers and frames in the layout of any version vol_geom can read (v1.0 to v1.3),
+ * so a file read with vol_geom, modified, and written back out with the same header, keeps its original version.
+ *
+ * It also writes playback containers (see "Playback containers" in vol_geom.h), in three steps:
+ *
+ *     vol_geom_write_playback_hdr( f_ptr, &hdr, audio_ptr, audio_sz );                 // Reserves the index.
+ *     for ( uint32_t i = 0; i < hdr.frame_count; i++ ) {
+ *       vol_geom_write_playback_frame( f_ptr, &hdr, &frames[i], codec, &entries_ptr[i] ); // Appends a page-aligned chunk.
+ *     }
+ *     vol_geom_write_playback_index( f_ptr, entries_ptr, hdr.frame_count );            // Fills in the index.
+ *
+ * Frame chunks can be compressed. VOL_GEOM_CODEC_LZ4_SHUFFLE is usually the smaller of the two codecs, and decodes faster than most disks read.
+ * How much smaller depends on the meshes; noisy or already-compressed data barely shrinks.
+ *
+ * History
+ * -------
+ * - 0.3   (2026/10/18) - LZ4 and byte-shuffled LZ4 compression of playback container frame chunks.
+ * - 0.2   (2026/10/18) - Playback container writing.
+ * - 0.1   (2026/10/18) - First version. Header and frame writing for v1.0 to v1.3.
+ */
+
+#pragma once
+
+#include "vol_geom.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+/** The byte offset of the audio chunk in a v1.3 file. The v1.3 header is always this size. */
+#define VOL_GEOM_WRITE_V13_HDR_SZ 44
+
+/** Contents of a single frame to write. Arrays that are not present in a frame can be NULL with a size of 0. */
+VOL_GEOM_EXPORT typedef struct vol_geom_write_frame_t {
+  /// Must match the index of the frame in the sequence, starting at 0.
+  uint32_t frame_number;
+  /// 0 = tracked frame, 1 = first/key frame, 2 = last tracked frame (only if Version >= 12).
+  uint8_t keyframe;
+  const void* vertices_ptr;
+  uint32_t vertices_sz;
+  /// Only written if the header has normals and version >= 11.
+  const void* normals_ptr;
+  uint32_t normals_sz;
+  /// Only written for keyframes.
+  const void* indices_ptr;
+  uint32_t indices_sz;
+  /// Only written for keyframes.
+  const void* uvs_ptr;
+  uint32_t uvs_sz;
+  /// Only written if the header is textured and version >= 11.
+  const void* texture_ptr;
+  uint32_t texture_sz;
+} vol_geom_write_frame_t;
+
+/** Write a .vols file header in the layout given by `hdr_ptr->version`.
+ * For v1.3 the `audio_start` and `frame_body_start` fields are computed here, and the audio chunk is written straight after the header.
+ * @param f_ptr     File opened for binary writing, positioned at the start of the file. Must not be NULL.
+ * @param hdr_ptr   Header to write. Must not be NULL.
+ * @param audio_ptr Audio data for v1.3 files. May be NULL if `hdr_ptr->audio` is 0.
+ * @param audio_sz  Size of the audio data in bytes.
+ * @returns         False on any error, including an unsupported version number or a failed write.
+ */
+VOL_GEOM_EXPORT bool vol_geom_write_hdr( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const uint8_t* audio_ptr, uint32_t audio_sz );
+
+/** Write a frame, including its frame header and trailing size integer, in the layout given by `hdr_ptr`.
+ * @param f_ptr     File opened for binary writing, positioned at the end of the previous frame. Must not be NULL.
+ * @param hdr_ptr   Header of the file being written. Used to decide which sections are present. Must not be NULL.
+ * @param frame_ptr Frame contents. Must not be NULL.
+ * @returns         False on any error, including a failed write.
+ */
+VOL_GEOM_EXPORT bool vol_geom_write_frame( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const vol_geom_write_frame_t* frame_ptr );
+
+/** Helper to fill a write-frame struct from the data of a frame read with `vol_geom_read_frame()`.
+ * Pointers in `write_frame_ptr` will point into the memory referred to by `frame_data_ptr`, so that must remain valid until the frame is written.
+ * @param block_data_ptr  Address that the offsets in `frame_data_ptr` are relative to. Usually `frame_data_ptr->block_data_ptr`.
+ */
+VOL_GEOM_EXPORT void vol_geom_write_frame_from_data( const vol_geom_info_t* info_ptr, uint32_t frame_idx, const uint8_t* block_data_ptr,
+  const vol_geom_frame_data_t* frame_data_ptr, vol_geom_write_frame_t* write_frame_ptr );
+
+/** Write a playback container's header, space for its index, and its audio, and pad to the first frame chunk.
+ * @param f_ptr     File opened for binary writing and seeking, positioned at the start of the file. Must not be NULL.
+ * @param hdr_ptr   Header of the vologram. Its version, 10 to 13, sets the layout of the frame chunks. Must not be NULL.
+ * @param audio_ptr Audio data. May be NULL if `audio_sz` is 0.
+ * @param audio_sz  Size of the audio data in bytes. The container has audio if this is more than 0.
+ * @returns         False on any error, including an unsupported version number or a failed write.
+ */
+VOL_GEOM_EXPORT bool vol_geom_write_playback_hdr( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const uint8_t* audio_ptr, uint32_t audio_sz );
+
+/** Append a frame to a playback container as a chunk, padded to VOL_GEOM_PLAYBACK_PAGE_SZ.
+ * @param f_ptr     File written by `vol_geom_write_playback_hdr()` and any previous frames. Must not be NULL.
+ * @param hdr_ptr   Header given to `vol_geom_write_playback_hdr()`. Must not be NULL.
+ * @param frame_ptr Frame contents. Must not be NULL.
+ * @param codec     How to store the chunk. If compressing doesn't make the frame smaller it is stored with VOL_GEOM_CODEC_NONE instead.
+ * @param entry_ptr Receives the frame's index entry, to pass to `vol_geom_write_playback_index()`. Must not be NULL.
+ * @returns         False on any error, including a failed write.
+ */
+VOL_GEOM_EXPORT bool vol_geom_write_playback_frame( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, const vol_geom_write_frame_t* frame_ptr,
+  vol_geom_codec_t codec, vol_geom_playback_entry_t* entry_ptr );
+
+/** Write a playback container's index into the space reserved for it. Call after the last frame.
+ * @param entries_ptr Index entries filled in by `vol_geom_write_playback_frame()`, one per frame, in order.
+ * @param n_entries   Must equal the header's `frame_count`.
+ * @returns           False on a failed seek or write.
+ */
+VOL_GEOM_EXPORT bool vol_geom_write_playback_index( FILE* f_ptr, const vol_geom_playback_entry_t* entries_ptr, uint32_t n_entries );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
@@ -0,0 +1,404 @@
+/** @file vol_http.c
+ * Volograms HTTP Range Client
+ *
+ * vol_http  | Minimal HTTP/1.1 client for byte-range requests.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * References
+ * ----------
+ * - RFC 9110, "HTTP Semantics", section 14 "Range Requests". https://www.rfc-editor.org/rfc/rfc9110#name-range-requests
+ */
+
+#include "vol_http.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET _socket_t;
+#define _INVALID_SOCKET INVALID_SOCKET
+#define _close_socket closesocket
+#define _SEND_FLAGS 0
+#define strncasecmp _strnicmp
+#else
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h> // strncasecmp
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+typedef int _socket_t;
+#define _INVALID_SOCKET -1
+#define _close_socket close
+#ifdef MSG_NOSIGNAL
+#define _SEND_FLAGS MSG_NOSIGNAL // Report a connection closed by the server as an error, rather than raising SIGPIPE.
+#else
+#define _SEND_FLAGS 0
+#endif
+#endif
+
+#define VOL_HTTP_HOST_MAX_LEN 256
+#define VOL_HTTP_PATH_MAX_LEN 2048
+#define VOL_HTTP_HDR_MAX_LEN 8192
+#define VOL_HTTP_ERROR_MAX_LEN 256
+
+struct vol_http_t {
+  char host_str[VOL_HTTP_HOST_MAX_LEN];
+  char port_str[8];
+  char host_hdr_str[VOL_HTTP_HOST_MAX_LEN + 8]; // Value of the Host header: the host, and the port if it isn't 80.
+  char path_str[VOL_HTTP_PATH_MAX_LEN];
+  char error_str[VOL_HTTP_ERROR_MAX_LEN];
+  char hdr_buf[VOL_HTTP_HDR_MAX_LEN]; // Response headers, and any body bytes received with them. Also used to discard unwanted body bytes.
+  _socket_t sock;
+  uint32_t timeout_ms;
+};
+
+/** Outcomes of one request on one connection. */
+typedef enum _request_result_t {
+  _REQUEST_OK,
+  _REQUEST_FAILED,
+  _REQUEST_RETRY // The connection was closed before any response, which kept-alive connections can be at any time. Worth one retry.
+} _request_result_t;
+
+static void _set_error( vol_http_t* http_ptr, const char* message_str, ... ) {
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vsnprintf( http_ptr->error_str, VOL_HTTP_ERROR_MAX_LEN, message_str, arg_ptr );
+  va_end( arg_ptr );
+}
+
+/** Splits "http://host[:port][/path]" into the client's host, port, and path. IPv6 hosts are in brackets, e.g. "http://[::1]:8080/". */
+static bool _parse_url( const char* url, vol_http_t* http_ptr ) {
+  const char* scheme_str = "http://";
+  if ( 0 != strncasecmp( url, scheme_str, strlen( scheme_str ) ) ) { return false; }
+  const char* authority_ptr = url + strlen( scheme_str );
+  size_t authority_len      = strcspn( authority_ptr, "/?#" );
+  if ( 0 == authority_len || memchr( authority_ptr, '@', authority_len ) ) { return false; } // No user info.
+
+  const char* host_ptr = authority_ptr;
+  size_t host_len      = authority_len;
+  const char* port_ptr = NULL;
+  if ( '[' == authority_ptr[0] ) {
+    const char* close_ptr = memchr( authority_ptr, ']', authority_len );
+    if ( !close_ptr ) { return false; }
+    host_ptr = authority_ptr + 1;
+    host_len = close_ptr - host_ptr;
+    if ( close_ptr + 1 < authority_ptr + authority_len ) {
+      if ( ':' != close_ptr[1] ) { return false; }
+      port_ptr = close_ptr + 2;
+    }
+  } else {
+    const char* colon_ptr = memchr( authority_ptr, ':', authority_len );
+    if ( colon_ptr ) {
+      host_len = colon_ptr - authority_ptr;
+      port_ptr = colon_ptr + 1;
+    }
+  }
+  size_t port_len = port_ptr ? (size_t)( authority_ptr + authority_len - port_ptr ) : 0;
+  if ( 0 == host_len || host_len >= VOL_HTTP_HOST_MAX_LEN || port_len >= sizeof( http_ptr->port_str ) ) { return false; }
+  for ( size_t i = 0; i < port_len; i++ ) {
+    if ( port_ptr[i] < '0' || port_ptr[i] > '9' ) { return false; }
+  }
+  memcpy( http_ptr->host_str, host_ptr, host_len );
+  http_ptr->host_str[host_len] = '\0';
+  if ( port_len > 0 ) {
+    memcpy( http_ptr->port_str, port_ptr, port_len );
+    http_ptr->port_str[port_len] = '\0';
+  } else {
+    strcpy( http_ptr->port_str, "80" );
+  }
+  memcpy( http_ptr->host_hdr_str, authority_ptr, authority_len );
+  http_ptr->host_hdr_str[authority_len] = '\0';
+
+  // The path is sent as is, including any query string, but not a fragment.
+  const char* path_ptr = authority_ptr + authority_len;
+  size_t path_len      = strcspn( path_ptr, "#" );
+  if ( 0 == path_len ) {
+    strcpy( http_ptr->path_str, "/" );
+  } else {
+    if ( '/' != path_ptr[0] ) { return false; } // e.g. "http://host?query".
+    if ( path_len >= VOL_HTTP_PATH_MAX_LEN ) { return false; }
+    memcpy( http_ptr->path_str, path_ptr, path_len );
+    http_ptr->path_str[path_len] = '\0';
+  }
+  for ( const char* c_ptr = http_ptr->path_str; *c_ptr; c_ptr++ ) {
+    if ( (unsigned char)*c_ptr <= ' ' ) { return false; } // Spaces and control characters would break the request line.
+  }
+  return true;
+}
+
+static void _disconnect( vol_http_t* http_ptr ) {
+  if ( _INVALID_SOCKET == http_ptr->sock ) { return; }
+  _close_socket( http_ptr->sock );
+  http_ptr->sock = _INVALID_SOCKET;
+}
+
+static bool _connect( vol_http_t* http_ptr ) {
+  struct addrinfo hints;
+  memset( &hints, 0, sizeof( hints ) );
+  hints.ai_family            = AF_UNSPEC;
+  hints.ai_socktype          = SOCK_STREAM;
+  struct addrinfo* addrs_ptr = NULL;
+  int gai_result             = getaddrinfo( http_ptr->host_str, http_ptr->port_str, &hints, &addrs_ptr );
+  if ( 0 != gai_result ) {
+    _set_error( http_ptr, "could not resolve host `%s`: %s", http_ptr->host_str, gai_strerror( gai_result ) );
+    return false;
+  }
+
+  for ( struct addrinfo* addr_ptr = addrs_ptr; addr_ptr; addr_ptr = addr_ptr->ai_next ) {
+    _socket_t sock = socket( addr_ptr->ai_family, addr_ptr->ai_socktype, addr_ptr->ai_protocol );
+    if ( _INVALID_SOCKET == sock ) { continue; }
+    if ( 0 != connect( sock, addr_ptr->ai_addr, (int)addr_ptr->ai_addrlen ) ) {
+      _close_socket( sock );
+      continue;
+    }
+    http_ptr->sock = sock;
+    break;
+  }
+  freeaddrinfo( addrs_ptr );
+  if ( _INVALID_SOCKET == http_ptr->sock ) {
+    _set_error( http_ptr, "could not connect to %s port %s", http_ptr->host_str, http_ptr->port_str );
+    return false;
+  }
+
+  // Requests are small and each waits for its response, so don't let Nagle's algorithm hold them back.
+  int nodelay = 1;
+  setsockopt( http_ptr->sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof( nodelay ) );
+#if !defined( _WIN32 ) && defined( SO_NOSIGPIPE )
+  int nosigpipe = 1;
+  setsockopt( http_ptr->sock, SOL_SOCKET, SO_NOSIGPIPE, &nosigpipe, sizeof( nosigpipe ) );
+#endif
+  if ( http_ptr->timeout_ms > 0 ) {
+#ifdef _WIN32
+    DWORD timeout = http_ptr->timeout_ms;
+#else
+    struct timeval timeout = ( struct timeval ){ .tv_sec = http_ptr->timeout_ms / 1000, .tv_usec = ( http_ptr->timeout_ms % 1000 ) * 1000 };
+#endif
+    setsockopt( http_ptr->sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof( timeout ) );
+    setsockopt( http_ptr->sock, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof( timeout ) );
+  }
+  return true;
+}
+
+static bool _send_all( vol_http_t* http_ptr, const char* buf_ptr, size_t sz ) {
+  while ( sz > 0 ) {
+    int n = (int)send( http_ptr->sock, buf_ptr, (int)sz, _SEND_FLAGS );
+#ifndef _WIN32
+    if ( n < 0 && EINTR == errno ) { continue; }
+#endif
+    if ( n <= 0 ) { return false; }
+    buf_ptr += n;
+    sz -= n;
+  }
+  return true;
+}
+
+/** @returns Bytes received, 0 if the server closed the connection, or -1 on an error or timeout. */
+static int _recv_some( vol_http_t* http_ptr, char* buf_ptr, uint32_t max_sz ) {
+  if ( max_sz > ( 1u << 30 ) ) { max_sz = 1u << 30; }
+  for ( ;; ) {
+    int n = (int)recv( http_ptr->sock, buf_ptr, (int)max_sz, 0 );
+#ifndef _WIN32
+    if ( n < 0 && EINTR == errno ) { continue; }
+#endif
+    return n;
+  }
+}
+
+/** Read the body of a response, keeping the `want` bytes after the first `skip`.
+ * @param n_buffered Body bytes that were received along with the headers, starting at `hdr_buf[body_start]`.
+ */
+static bool _read_body( vol_http_t* http_ptr, uint32_t body_start, uint32_t n_buffered, uint64_t skip, uint32_t want, uint8_t* dst_ptr ) {
+  uint64_t end_pos = skip + want;
+  uint64_t pos     = n_buffered < end_pos ? n_buffered : end_pos;
+  if ( pos > skip ) { memcpy( dst_ptr, &http_ptr->hdr_buf[body_start + skip], (size_t)( pos - skip ) ); }
+  while ( pos < end_pos ) {
+    int n = 0;
+    if ( pos < skip ) { // Discard into the header buffer, which has been parsed already.
+      uint64_t discard_sz = skip - pos < VOL_HTTP_HDR_MAX_LEN ? skip - pos : VOL_HTTP_HDR_MAX_LEN;
+      n                   = _recv_some( http_ptr, http_ptr->hdr_buf, (uint32_t)discard_sz );
+    } else {
+      n = _recv_some( http_ptr, (char*)&dst_ptr[pos - skip], (uint32_t)( end_pos - pos ) );
+    }
+    if ( n <= 0 ) {
+      _set_error( http_ptr, "connection closed or timed out after %" PRIu64 " of %" PRIu64 " body bytes", pos, end_pos );
+      return false;
+    }
+    pos += n;
+  }
+  return true;
+}
+
+/** @returns A pointer to the value of header `name_str` in the NUL-terminated headers, or NULL if it isn't there. */
+static const char* _find_header( const char* hdrs_str, const char* name_str ) {
+  size_t name_len = strlen( name_str );
+  for ( const char* line_ptr = strstr( hdrs_str, "\r\n" ); line_ptr; line_ptr = strstr( line_ptr, "\r\n" ) ) {
+    line_ptr += 2;
+    if ( 0 == strncasecmp( line_ptr, name_str, name_len ) && ':' == line_ptr[name_len] ) {
+      const char* value_ptr = line_ptr + name_len + 1;
+      while ( ' ' == *value_ptr || '\t' == *value_ptr ) { value_ptr++; }
+      return value_ptr;
+    }
+  }
+  return NULL;
+}
+
+static _request_result_t _request(
+  vol_http_t* http_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr, uint32_t* got_sz_ptr, uint64_t* total_sz_ptr, bool* keep_alive_ptr ) {
+  char request_str[VOL_HTTP_PATH_MAX_LEN + VOL_HTTP_HOST_MAX_LEN + 128];
+  int request_len = snprintf( request_str, sizeof( request_str ),
+    "GET %s HTTP/1.1\r\nHost: %s\r\nRange: bytes=%" PRIu64 "-%" PRIu64 "\r\nUser-Agent: vol_http/0.1\r\n\r\n", http_ptr->path_str, http_ptr->host_hdr_str,
+    offset, offset + sz - 1 );
+  if ( !_send_all( http_ptr, request_str, (size_t)request_len ) ) {
+    _set_error( http_ptr, "could not send request" );
+    return _REQUEST_RETRY;
+  }
+
+  // Receive until the blank line that ends the headers.
+  uint32_t n_received = 0;
+  char* hdrs_end_ptr  = NULL;
+  while ( !hdrs_end_ptr ) {
+    if ( n_received >= VOL_HTTP_HDR_MAX_LEN - 1 ) {
+      _set_error( http_ptr, "response headers are longer than %i bytes", VOL_HTTP_HDR_MAX_LEN );
+      return _REQUEST_FAILED;
+    }
+    int n = _recv_some( http_ptr, &http_ptr->hdr_buf[n_received], VOL_HTTP_HDR_MAX_LEN - 1 - n_received );
+    if ( 0 == n && 0 == n_received ) {
+      _set_error( http_ptr, "connection closed by server" );
+      return _REQUEST_RETRY;
+    }
+    if ( n <= 0 ) {
+      _set_error( http_ptr, "connection closed or timed out while reading response headers" );
+      return _REQUEST_FAILED;
+    }
+    n_received += n;
+    http_ptr->hdr_buf[n_received] = '\0';
+    hdrs_end_ptr                  = strstr( http_ptr->hdr_buf, "\r\n\r\n" );
+  }
+  uint32_t body_start = (uint32_t)( hdrs_end_ptr - http_ptr->hdr_buf ) + 4;
+  uint32_t n_buffered = n_received - body_start;
+  hdrs_end_ptr[2]     = '\0'; // Keep the last header's line ending, for `_find_header()`.
+
+  int status = 0;
+  if ( 1 != sscanf( http_ptr->hdr_buf, "HTTP/1.%*d %d", &status ) ) {
+    _set_error( http_ptr, "response is not HTTP/1.x" );
+    return _REQUEST_FAILED;
+  }
+  const char* connection_str = _find_header( http_ptr->hdr_buf, "Connection" );
+  const char* encoding_str   = _find_header( http_ptr->hdr_buf, "Transfer-Encoding" );
+  const char* length_str     = _find_header( http_ptr->hdr_buf, "Content-Length" );
+  const char* range_str      = _find_header( http_ptr->hdr_buf, "Content-Range" );
+  *keep_alive_ptr            = !( connection_str && 0 == strncasecmp( connection_str, "close", 5 ) );
+  if ( encoding_str && 0 != strncasecmp( encoding_str, "identity", 8 ) ) {
+    _set_error( http_ptr, "transfer encodings such as chunked are not supported" );
+    return _REQUEST_FAILED;
+  }
+  uint64_t content_length = length_str ? strtoull( length_str, NULL, 10 ) : 0;
+
+  if ( 206 == status ) { // Partial Content: "Content-Range: bytes first-last/total", where total may be "*" if unknown.
+    uint64_t first     = 0, last = 0;
+    char total_str[24] = { 0 };
+    if ( !range_str || 3 != sscanf( range_str, "bytes %" SCNu64 "-%" SCNu64 "/%23s", &first, &last, total_str ) || first != offset || last < first ||
+         last - first >= sz || ( length_str && content_length != last - first + 1 ) ) {
+      _set_error( http_ptr, "206 response has a missing or unexpected Content-Range" );
+      return _REQUEST_FAILED;
+    }
+    uint64_t total = '*' == total_str[0] ? last + 1 : strtoull( total_str, NULL, 10 );
+    *got_sz_ptr    = (uint32_t)( last - first + 1 );
+    if ( n_buffered > *got_sz_ptr ) { *keep_alive_ptr = false; } // More bytes than the range, so the connection is out of step.
+    if ( total_sz_ptr ) { *total_sz_ptr = total; }
+    return _read_body( http_ptr, body_start, n_buffered, 0, *got_sz_ptr, dst_ptr ) ? _REQUEST_OK : _REQUEST_FAILED;
+  }
+  if ( 200 == status ) { // The server ignored the range and sent the whole file, so skip to the range, then hang up.
+    if ( !length_str || offset >= content_length ) {
+      _set_error( http_ptr, "200 response without a Content-Length covering offset %" PRIu64, offset );
+      return _REQUEST_FAILED;
+    }
+    *got_sz_ptr = content_length - offset < sz ? (uint32_t)( content_length - offset ) : sz;
+    if ( offset + *got_sz_ptr < content_length ) { *keep_alive_ptr = false; }
+    if ( total_sz_ptr ) { *total_sz_ptr = content_length; }
+    return _read_body( http_ptr, body_start, n_buffered, offset, *got_sz_ptr, dst_ptr ) ? _REQUEST_OK : _REQUEST_FAILED;
+  }
+  *keep_alive_ptr = false; // The error's body is not read.
+  if ( 416 == status ) { // Range Not Satisfiable: "Content-Range: bytes */total".
+    uint64_t total = 0;
+    if ( range_str && 1 == sscanf( range_str, "bytes */%" SCNu64, &total ) ) {
+      if ( total_sz_ptr ) { *total_sz_ptr = total; }
+      _set_error( http_ptr, "offset %" PRIu64 " is past the end of the file, which is %" PRIu64 " bytes", offset, total );
+    } else {
+      _set_error( http_ptr, "offset %" PRIu64 " is past the end of the file", offset );
+    }
+    return _REQUEST_FAILED;
+  }
+  _set_error( http_ptr, "HTTP status %i for %s", status, http_ptr->path_str );
+  return _REQUEST_FAILED;
+}
+
+vol_http_t* vol_http_open( const char* url, uint32_t timeout_ms ) {
+  if ( !url ) { return NULL; }
+  vol_http_t* http_ptr = calloc( 1, sizeof( vol_http_t ) );
+  if ( !http_ptr ) { return NULL; }
+  http_ptr->sock       = _INVALID_SOCKET;
+  http_ptr->timeout_ms = timeout_ms;
+  if ( !_parse_url( url, http_ptr ) ) {
+    free( http_ptr );
+    return NULL;
+  }
+#ifdef _WIN32
+  WSADATA wsa_data; // Winsock is reference-counted, so each client starts it, and cleans it up when closed.
+  if ( 0 != WSAStartup( MAKEWORD( 2, 2 ), &wsa_data ) ) {
+    free( http_ptr );
+    return NULL;
+  }
+#endif
+  return http_ptr;
+}
+
+bool vol_http_get_range( vol_http_t* http_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr, uint32_t* got_sz_ptr, uint64_t* total_sz_ptr ) {
+  if ( !http_ptr || !dst_ptr || !got_sz_ptr ) { return false; }
+  *got_sz_ptr            = 0;
+  http_ptr->error_str[0] = '\0';
+  if ( 0 == sz ) {
+    _set_error( http_ptr, "empty range requested" );
+    return false;
+  }
+
+  for ( int attempt = 0; attempt < 2; attempt++ ) {
+    bool reused = _INVALID_SOCKET != http_ptr->sock;
+    if ( !reused && !_connect( http_ptr ) ) { return false; }
+    bool keep_alive          = false;
+    _request_result_t result = _request( http_ptr, offset, sz, dst_ptr, got_sz_ptr, total_sz_ptr, &keep_alive );
+    if ( _REQUEST_OK != result || !keep_alive ) { _disconnect( http_ptr ); }
+    if ( _REQUEST_OK == result ) { return true; }
+    if ( _REQUEST_RETRY != result || !reused ) { return false; } // Only a stale kept-alive connection is worth retrying.
+  }
+  return false;
+}
+
+const char* vol_http_error( const vol_http_t* http_ptr ) {
+  if ( !http_ptr ) { return ""; }
+  return http_ptr->error_str;
+}
+
+void vol_http_close( vol_http_t* http_ptr ) {
+  if ( !http_ptr ) { return; }
+  _disconnect( http_ptr );
+  free( http_ptr );
+#ifdef _WIN32
+  WSACleanup();
+#endif
+}
@@ -0,0 +1,74 @@
+/**  @file vol_http.h
+ * Volograms HTTP Range Client
+ *
+ * vol_http  | Minimal HTTP/1.1 client for byte-range requests.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Fetches byte ranges of one URL with `Range: bytes=first-last` requests, for reading files in place on a web server or CDN without downloading them.
+ * A connection is kept alive between requests. If a kept-alive connection has been closed by the server, the request is retried once on a new one.
+ *
+ * Each client is one connection, so a client must only be used by one thread at a time. Open one client per thread to fetch in parallel.
+ * On POSIX systems this uses BSD sockets. On Windows it uses Winsock, so link with `ws2_32`.
+ *
+ * Limitations
+ * -----------
+ * - Only http:// URLs. There is no TLS, so for https:// put a local TLS-terminating proxy in front, or serve over http:// inside a trusted network.
+ * - No redirects, proxies, authentication, or chunked transfer encoding. A server that ignores the Range header and replies with the whole file
+ *   (200 OK) still works, but the rest of the file is not read and the connection is closed, so that is slow.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_HTTP_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_HTTP_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Opaque client. Create with `vol_http_open()`. */
+typedef struct vol_http_t vol_http_t;
+
+/** Create a client for a URL. This only parses the URL. The connection is made by the first request.
+ * @param url        e.g. "http://cdn.example.com:8080/volograms/counter.volp". Must not be NULL.
+ * @param timeout_ms Give up on a connection that sends nothing for this long. 0 means wait forever.
+ * @returns          NULL if the URL is not a valid http:// URL, or on out of memory.
+ */
+VOL_HTTP_EXPORT vol_http_t* vol_http_open( const char* url, uint32_t timeout_ms );
+
+/** Fetch `sz` bytes starting at `offset`. Fewer are returned if the range runs past the end of the file.
+ * @param dst_ptr      Receives the bytes. At least `sz` bytes. Must not be NULL.
+ * @param got_sz_ptr   Receives the number of bytes written to `dst_ptr`. Must not be NULL.
+ * @param total_sz_ptr If not NULL, receives the size of the whole file, as reported by the server.
+ * @returns            False on a connection error, a timeout, an HTTP error status such as 404, or if `offset` is past the end of the file.
+ *                     See `vol_http_error()` for the reason.
+ */
+VOL_HTTP_EXPORT bool vol_http_get_range( vol_http_t* http_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr, uint32_t* got_sz_ptr, uint64_t* total_sz_ptr );
+
+/** @returns A description of the last error, or an empty string. Valid until the next call with this client. */
+VOL_HTTP_EXPORT const char* vol_http_error( const vol_http_t* http_ptr );
+
+/** Close the connection, if any, and free the client. */
+VOL_HTTP_EXPORT void vol_http_close( vol_http_t* http_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
@@ -0,0 +1,217 @@
+/** @file vol_image.c
+ * Volograms Image Processing API
+ *
+ * vol_image | CPU image processing for vologram textures.
+ * --------- | ---------------------
+ * Version   | 0.2
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_image.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define VOL_IMAGE_SSE
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#define VOL_IMAGE_NEON
+#include <arm_neon.h>
+#endif
+
+/** Add a row of bytes into a row of 16-bit sums. This is where the box filter spends most of its time, and it doesn't care about channels. */
+static void _accumulate_row( const uint8_t* src_ptr, uint16_t* acc_ptr, int n_bytes ) {
+  int i = 0;
+#if defined( VOL_IMAGE_SSE )
+  const __m128i zero = _mm_setzero_si128();
+  for ( ; i + 16 <= n_bytes; i += 16 ) {
+    __m128i s  = _mm_loadu_si128( (const __m128i*)&src_ptr[i] );
+    __m128i lo = _mm_loadu_si128( (const __m128i*)&acc_ptr[i] );
+    __m128i hi = _mm_loadu_si128( (const __m128i*)&acc_ptr[i + 8] );
+    _mm_storeu_si128( (__m128i*)&acc_ptr[i], _mm_add_epi16( lo, _mm_unpacklo_epi8( s, zero ) ) );
+    _mm_storeu_si128( (__m128i*)&acc_ptr[i + 8], _mm_add_epi16( hi, _mm_unpackhi_epi8( s, zero ) ) );
+  }
+#elif defined( VOL_IMAGE_NEON )
+  for ( ; i + 16 <= n_bytes; i += 16 ) {
+    uint8x16_t s = vld1q_u8( &src_ptr[i] );
+    vst1q_u16( &acc_ptr[i], vaddw_u8( vld1q_u16( &acc_ptr[i] ), vget_low_u8( s ) ) );
+    vst1q_u16( &acc_ptr[i + 8], vaddw_u8( vld1q_u16( &acc_ptr[i + 8] ), vget_high_u8( s ) ) );
+  }
+#endif
+  for ( ; i < n_bytes; i++ ) { acc_ptr[i] += src_ptr[i]; }
+}
+
+/** Whole-number downscale: sum `ky` rows into `acc_ptr`, then sum `kx` pixels along the row, and divide with rounding. */
+static bool _resize_box( const uint8_t* src_ptr, int src_w, int n_chans, uint8_t* dst_ptr, int dst_w, int dst_h, int kx, int ky ) {
+  const int row_bytes = src_w * n_chans;
+  uint16_t* acc_ptr   = malloc( (size_t)row_bytes * sizeof( uint16_t ) );
+  if ( !acc_ptr ) { return false; }
+  const uint32_t area = (uint32_t)( kx * ky );
+  const uint32_t half = area / 2;
+
+  for ( int y = 0; y < dst_h; y++ ) {
+    memset( acc_ptr, 0, (size_t)row_bytes * sizeof( uint16_t ) );
+    for ( int j = 0; j < ky; j++ ) { _accumulate_row( &src_ptr[(size_t)( y * ky + j ) * row_bytes], acc_ptr, row_bytes ); }
+    uint8_t* out_ptr = &dst_ptr[(size_t)y * dst_w * n_chans];
+    for ( int x = 0; x < dst_w; x++ ) {
+      const uint16_t* in_ptr = &acc_ptr[x * kx * n_chans];
+      for ( int c = 0; c < n_chans; c++ ) {
+        uint32_t sum = 0;
+        for ( int i = 0; i < kx; i++ ) { sum += in_ptr[i * n_chans + c]; }
+        out_ptr[x * n_chans + c] = (uint8_t)( ( sum + half ) / area );
+      }
+    }
+  }
+
+  free( acc_ptr );
+  return true;
+}
+
+/** Bilinear filtering with pixel centres aligned, for any other sizes. */
+static void _resize_bilinear( const uint8_t* src_ptr, int src_w, int src_h, int n_chans, uint8_t* dst_ptr, int dst_w, int dst_h ) {
+  const float sx = (float)src_w / (float)dst_w;
+  const float sy = (float)src_h / (float)dst_h;
+  for ( int y = 0; y < dst_h; y++ ) {
+    float fy = ( y + 0.5f ) * sy - 0.5f;
+    fy       = fy < 0.0f ? 0.0f : fy;
+    int y0   = (int)fy;
+    int y1   = y0 + 1 < src_h ? y0 + 1 : src_h - 1;
+    float ty = fy - (float)y0;
+    for ( int x = 0; x < dst_w; x++ ) {
+      float fx = ( x + 0.5f ) * sx - 0.5f;
+      fx       = fx < 0.0f ? 0.0f : fx;
+      int x0   = (int)fx;
+      int x1   = x0 + 1 < src_w ? x0 + 1 : src_w - 1;
+      float tx = fx - (float)x0;
+      for ( int c = 0; c < n_chans; c++ ) {
+        float a = src_ptr[( (size_t)y0 * src_w + x0 ) * n_chans + c], b = src_ptr[( (size_t)y0 * src_w + x1 ) * n_chans + c];
+        float d = src_ptr[( (size_t)y1 * src_w + x0 ) * n_chans + c], e = src_ptr[( (size_t)y1 * src_w + x1 ) * n_chans + c];
+        float v = ( a + ( b - a ) * tx ) * ( 1.0f - ty ) + ( d + ( e - d ) * tx ) * ty;
+
+        dst_ptr[( (size_t)y * dst_w + x ) * n_chans + c] = (uint8_t)( v + 0.5f );
+      }
+    }
+  }
+}
+
+bool vol_image_resize( const uint8_t* src_ptr, int src_w, int src_h, int n_chans, uint8_t* dst_ptr, int dst_w, int dst_h ) {
+  if ( !src_ptr || !dst_ptr || src_w <= 0 || src_h <= 0 || dst_w <= 0 || dst_h <= 0 || n_chans < 1 || n_chans > 4 ) { return false; }
+
+  if ( src_w == dst_w && src_h == dst_h ) {
+    memcpy( dst_ptr, src_ptr, (size_t)src_w * src_h * n_chans );
+    return true;
+  }
+  if ( 0 == src_w % dst_w && 0 == src_h % dst_h ) {
+    int kx = src_w / dst_w, ky = src_h / dst_h;
+    if ( kx <= VOL_IMAGE_MAX_BOX_FACTOR && ky <= VOL_IMAGE_MAX_BOX_FACTOR ) { return _resize_box( src_ptr, src_w, n_chans, dst_ptr, dst_w, dst_h, kx, ky ); }
+  }
+  _resize_bilinear( src_ptr, src_w, src_h, n_chans, dst_ptr, dst_w, dst_h );
+  return true;
+}
+
+/** Bilinear sample for one point. The SSE2 path in vol_image_sample_rgb() does the same arithmetic in the same order, so output is identical. */
+static void _sample_rgb_point( const uint8_t* img_ptr, int w, int h, int n_chans, float u, float v, uint8_t* rgb_ptr ) {
+  float fx = u * (float)w - 0.5f, fy = ( 1.0f - v ) * (float)h - 0.5f;
+  fx       = fx > 0.0f ? fx : 0.0f; // Also replaces NaN.
+  fy       = fy > 0.0f ? fy : 0.0f;
+  fx       = fx < (float)( w - 1 ) ? fx : (float)( w - 1 );
+  fy       = fy < (float)( h - 1 ) ? fy : (float)( h - 1 );
+  int x0 = (int)fx, y0 = (int)fy;
+  int x1 = x0 + 1 < w ? x0 + 1 : w - 1, y1 = y0 + 1 < h ? y0 + 1 : h - 1;
+  float tx = fx - (float)x0, ty = fy - (float)y0;
+  const uint8_t* a_ptr = &img_ptr[( (size_t)y0 * w + x0 ) * n_chans];
+  const uint8_t* b_ptr = &img_ptr[( (size_t)y0 * w + x1 ) * n_chans];
+  const uint8_t* d_ptr = &img_ptr[( (size_t)y1 * w + x0 ) * n_chans];
+  const uint8_t* e_ptr = &img_ptr[( (size_t)y1 * w + x1 ) * n_chans];
+  for ( int c = 0; c < 3; c++ ) {
+    float top = (float)a_ptr[c] + ( (float)b_ptr[c] - (float)a_ptr[c] ) * tx;
+    float bot = (float)d_ptr[c] + ( (float)e_ptr[c] - (float)d_ptr[c] ) * tx;
+    rgb_ptr[c] = (uint8_t)( top + ( bot - top ) * ty + 0.5f );
+  }
+}
+
+#if defined( VOL_IMAGE_SSE )
+/** Gathers a texel for each of four points, as 0x00BBGGRR words. */
+static __m128i _gather_texels( const uint8_t* img_ptr, int w, int n_chans, const int32_t* xs, const int32_t* ys ) {
+  uint32_t texels[4];
+  for ( int k = 0; k < 4; k++ ) {
+    const uint8_t* p_ptr = &img_ptr[( (size_t)ys[k] * w + xs[k] ) * n_chans];
+    texels[k]            = (uint32_t)p_ptr[0] | (uint32_t)p_ptr[1] << 8 | (uint32_t)p_ptr[2] << 16;
+  }
+  return _mm_loadu_si128( (const __m128i*)texels );
+}
+
+/** One channel of four gathered texels, as floats. */
+static __m128 _texel_channel( __m128i texels, int shift ) {
+  const __m128i mask = _mm_set1_epi32( 0xFF );
+  switch ( shift ) { // Shifts by a constant, as some compilers require.
+  case 8: texels = _mm_srli_epi32( texels, 8 ); break;
+  case 16: texels = _mm_srli_epi32( texels, 16 ); break;
+  default: break;
+  }
+  return _mm_cvtepi32_ps( _mm_and_si128( texels, mask ) );
+}
+#endif
+
+bool vol_image_sample_rgb( const uint8_t* img_ptr, int w, int h, int n_chans, const float* uvs_ptr, uint32_t n_points, uint8_t* rgb_ptr ) {
+  if ( !img_ptr || !uvs_ptr || !rgb_ptr || w <= 0 || h <= 0 || n_chans < 3 || n_chans > 4 ) { return false; }
+
+  uint32_t i = 0;
+#if defined( VOL_IMAGE_SSE )
+  // Texel addresses are found four points at a time. The texels are then gathered one at a time, as SSE2 has no gather, and blended four at a time.
+  const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps( 1.0f ), half = _mm_set1_ps( 0.5f );
+  const __m128 wf = _mm_set1_ps( (float)w ), hf = _mm_set1_ps( (float)h );
+  const __m128 max_x = _mm_set1_ps( (float)( w - 1 ) ), max_y = _mm_set1_ps( (float)( h - 1 ) );
+  for ( ; i + 4 <= n_points; i += 4 ) {
+    __m128 uv01 = _mm_loadu_ps( &uvs_ptr[i * 2] );
+    __m128 uv23 = _mm_loadu_ps( &uvs_ptr[i * 2 + 4] );
+    __m128 u    = _mm_shuffle_ps( uv01, uv23, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 v    = _mm_shuffle_ps( uv01, uv23, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+    __m128 fx   = _mm_sub_ps( _mm_mul_ps( u, wf ), half );
+    __m128 fy   = _mm_sub_ps( _mm_mul_ps( _mm_sub_ps( one, v ), hf ), half );
+    fx          = _mm_min_ps( _mm_max_ps( fx, zero ), max_x ); // _mm_max_ps() returns its second operand for NaN, as the scalar path does.
+    fy          = _mm_min_ps( _mm_max_ps( fy, zero ), max_y );
+    __m128i x0  = _mm_cvttps_epi32( fx ), y0 = _mm_cvttps_epi32( fy );
+    __m128 tx   = _mm_sub_ps( fx, _mm_cvtepi32_ps( x0 ) );
+    __m128 ty   = _mm_sub_ps( fy, _mm_cvtepi32_ps( y0 ) );
+    __m128i x1  = _mm_cvttps_epi32( _mm_min_ps( _mm_add_ps( _mm_cvtepi32_ps( x0 ), one ), max_x ) );
+    __m128i y1  = _mm_cvttps_epi32( _mm_min_ps( _mm_add_ps( _mm_cvtepi32_ps( y0 ), one ), max_y ) );
+
+    int32_t xs0[4], xs1[4], ys0[4], ys1[4];
+    _mm_storeu_si128( (__m128i*)xs0, x0 );
+    _mm_storeu_si128( (__m128i*)xs1, x1 );
+    _mm_storeu_si128( (__m128i*)ys0, y0 );
+    _mm_storeu_si128( (__m128i*)ys1, y1 );
+    __m128i a = _gather_texels( img_ptr, w, n_chans, xs0, ys0 ), b = _gather_texels( img_ptr, w, n_chans, xs1, ys0 );
+    __m128i d = _gather_texels( img_ptr, w, n_chans, xs0, ys1 ), e = _gather_texels( img_ptr, w, n_chans, xs1, ys1 );
+
+    __m128i rgb = _mm_setzero_si128();
+    for ( int c = 0; c < 3; c++ ) {
+      __m128 ca = _texel_channel( a, c * 8 ), cb = _texel_channel( b, c * 8 );
+      __m128 cd = _texel_channel( d, c * 8 ), ce = _texel_channel( e, c * 8 );
+      __m128 top = _mm_add_ps( ca, _mm_mul_ps( _mm_sub_ps( cb, ca ), tx ) );
+      __m128 bot = _mm_add_ps( cd, _mm_mul_ps( _mm_sub_ps( ce, cd ), tx ) );
+      __m128i ch = _mm_cvttps_epi32( _mm_add_ps( _mm_add_ps( top, _mm_mul_ps( _mm_sub_ps( bot, top ), ty ) ), half ) );
+      switch ( c ) {
+      case 1: ch = _mm_slli_epi32( ch, 8 ); break;
+      case 2: ch = _mm_slli_epi32( ch, 16 ); break;
+      default: break;
+      }
+      rgb = _mm_or_si128( rgb, ch );
+    }
+    uint32_t words[4];
+    _mm_storeu_si128( (__m128i*)words, rgb );
+    for ( int k = 0; k < 4; k++ ) {
+      rgb_ptr[( i + k ) * 3 + 0] = (uint8_t)( words[k] );
+      rgb_ptr[( i + k ) * 3 + 1] = (uint8_t)( words[k] >> 8 );
+      rgb_ptr[( i + k ) * 3 + 2] = (uint8_t)( words[k] >> 16 );
+    }
+  }
+#endif
+  for ( ; i < n_points; i++ ) { _sample_rgb_point( img_ptr, w, h, n_chans, uvs_ptr[i * 2], uvs_ptr[i * 2 + 1], &rgb_ptr[i * 3] ); }
+  return true;
+}
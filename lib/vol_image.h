@@ -0,0 +1,66 @@
+/**  @file vol_image.h
+ * Volograms Image Processing API
+ *
+ * vol_image | CPU image processing for vologram textures.
+ * --------- | ---------------------
+ * Version   | 0.2
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Functions that operate on decoded, tightly-packed, 8-bit-per-channel images, such as the output of vol_av or vol_basis.
+ * Nothing here does any file I/O. Functions return false on invalid parameters or if they run out of memory.
+ *
+ * History
+ * -------
+ * - 0.2   (2026/10/18) - Bilinear sampling of colours at texture coordinates.
+ * - 0.1   (2026/10/18) - First version. Image resizing.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_IMAGE_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_IMAGE_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Largest whole-number downscale factor, in either axis, that takes the box-filter path in `vol_image_resize()`. */
+#define VOL_IMAGE_MAX_BOX_FACTOR 64
+
+/** Resize an image.
+ * When the source is a whole-number multiple of the destination size in both axes (e.g. 2048 to 1024 or 512) each output pixel is the average of
+ * the source pixels it covers. This is vectorised with SSE2 or NEON and is the path to prefer for texture variants.
+ * Other sizes, and upscales, use bilinear filtering.
+ * @param src_ptr  Source image of `src_w` * `src_h` pixels of `n_chans` bytes each. Must not be NULL.
+ * @param n_chans  Number of channels, 1 to 4.
+ * @param dst_ptr  Destination image of `dst_w` * `dst_h` pixels of `n_chans` bytes each. Must not be NULL and must not overlap `src_ptr`.
+ * @returns        False on invalid parameters or out of memory.
+ */
+VOL_IMAGE_EXPORT bool vol_image_resize( const uint8_t* src_ptr, int src_w, int src_h, int n_chans, uint8_t* dst_ptr, int dst_w, int dst_h );
+
+/** Sample an image's colour at each of a list of texture coordinates, e.g. to colour a point cloud from a mesh's vertices and its texture.
+ * Samples are bilinearly filtered, with coordinates outside 0 to 1 clamped to the edge. As for vologram UVs, v=0 is the bottom row of the image.
+ * Points are processed four at a time with SSE2, where available.
+ * @param img_ptr  Image of `w` * `h` pixels of `n_chans` bytes each. Must not be NULL.
+ * @param n_chans  Number of channels, 3 (RGB) or 4 (RGBA). Alpha is ignored.
+ * @param uvs_ptr  `n_points` pairs of floats, u then v. Must not be NULL.
+ * @param rgb_ptr  Receives `n_points` RGB colours of 3 bytes each. Must not be NULL.
+ * @returns        False on invalid parameters.
+ */
+VOL_IMAGE_EXPORT bool vol_image_sample_rgb( const uint8_t* img_ptr, int w, int h, int n_chans, const float* uvs_ptr, uint32_t n_points, uint8_t* rgb_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
@@ -0,0 +1,132 @@
+/** @file vol_log_ring.c
+ * Volograms Log Ring Buffer
+ *
+ * vol_log_ring | Lock-free ring buffer for log messages.
+ * ------------ | ---------------------
+ * Version      | 0.1
+ * Authors      | See matching header file.
+ * Copyright    | 2026, Volograms (http://volograms.com/)
+ * Language     | C99
+ * Files        | 2
+ * Licence      | The MIT License. See LICENSE.md for details.
+ *
+ * References
+ * ----------
+ * - Dmitry Vyukov, "Bounded MPMC queue". https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+
+#include "vol_log_ring.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined( _MSC_VER )
+#define WIN32_LEAN_AND_MEAN 1
+#include <windows.h>
+// Interlocked functions are full barriers, which is stronger than the acquire/release ordering required.
+#define _load_acquire( ptr ) ( (uint32_t)InterlockedCompareExchange( (volatile LONG*)( ptr ), 0, 0 ) )
+#define _store_release( ptr, val ) InterlockedExchange( (volatile LONG*)( ptr ), (LONG)( val ) )
+#define _load_relaxed( ptr ) ( *(volatile uint32_t*)( ptr ) )
+#define _fetch_inc( ptr ) InterlockedIncrement( (volatile LONG*)( ptr ) )
+static bool _cas( uint32_t* ptr, uint32_t* expected_ptr, uint32_t desired ) {
+  uint32_t prev = (uint32_t)InterlockedCompareExchange( (volatile LONG*)ptr, (LONG)desired, (LONG)*expected_ptr );
+  if ( prev == *expected_ptr ) { return true; }
+  *expected_ptr = prev;
+  return false;
+}
+#else
+#define _load_acquire( ptr ) __atomic_load_n( ( ptr ), __ATOMIC_ACQUIRE )
+#define _store_release( ptr, val ) __atomic_store_n( ( ptr ), ( val ), __ATOMIC_RELEASE )
+#define _load_relaxed( ptr ) __atomic_load_n( ( ptr ), __ATOMIC_RELAXED )
+#define _fetch_inc( ptr ) __atomic_fetch_add( ( ptr ), 1, __ATOMIC_RELAXED )
+#define _cas( ptr, expected_ptr, desired ) __atomic_compare_exchange_n( ( ptr ), ( expected_ptr ), ( desired ), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED )
+#endif
+
+#define VOL_LOG_RING_MAX_MESSAGES ( 1u << 20 )
+
+/** Each slot's sequence number says whose turn it is: equal to the write position when free, or the write position + 1 when it holds a message. */
+typedef struct _ring_slot_t {
+  uint32_t seq;
+  int log_type;
+  char message_str[VOL_LOG_RING_MSG_MAX_LEN];
+} _ring_slot_t;
+
+struct vol_log_ring_t {
+  _ring_slot_t* slots_ptr;
+  uint32_t mask;
+  uint32_t n_dropped;
+  uint32_t write_pos;
+  char _pad[64]; // Keeps the reader's position on a different cache line to the writers'.
+  uint32_t read_pos;
+};
+
+vol_log_ring_t* vol_log_ring_create( uint32_t n_messages ) {
+  if ( 0 == n_messages || n_messages > VOL_LOG_RING_MAX_MESSAGES ) { return NULL; }
+  uint32_t n_slots = 1;
+  while ( n_slots < n_messages ) { n_slots *= 2; }
+
+  vol_log_ring_t* ring_ptr = calloc( 1, sizeof( vol_log_ring_t ) );
+  if ( !ring_ptr ) { return NULL; }
+  ring_ptr->slots_ptr = malloc( n_slots * sizeof( _ring_slot_t ) );
+  if ( !ring_ptr->slots_ptr ) {
+    free( ring_ptr );
+    return NULL;
+  }
+  for ( uint32_t i = 0; i < n_slots; i++ ) { ring_ptr->slots_ptr[i].seq = i; }
+  ring_ptr->mask = n_slots - 1;
+  return ring_ptr;
+}
+
+void vol_log_ring_free( vol_log_ring_t* ring_ptr ) {
+  if ( !ring_ptr ) { return; }
+  free( ring_ptr->slots_ptr );
+  free( ring_ptr );
+}
+
+bool vol_log_ring_push( vol_log_ring_t* ring_ptr, int log_type, const char* message_str ) {
+  if ( !ring_ptr || !message_str ) { return false; }
+
+  _ring_slot_t* slot_ptr = NULL;
+  uint32_t pos           = _load_relaxed( &ring_ptr->write_pos );
+  for ( ;; ) {
+    slot_ptr     = &ring_ptr->slots_ptr[pos & ring_ptr->mask];
+    int32_t diff = (int32_t)( _load_acquire( &slot_ptr->seq ) - pos );
+    if ( 0 == diff ) {
+      if ( _cas( &ring_ptr->write_pos, &pos, pos + 1 ) ) { break; } // Claimed the slot. On failure `pos` is updated to retry.
+    } else if ( diff < 0 ) { // Reader hasn't freed this slot yet, so the ring is full.
+      _fetch_inc( &ring_ptr->n_dropped );
+      return false;
+    } else { // Another writer claimed it first.
+      pos = _load_relaxed( &ring_ptr->write_pos );
+    }
+  }
+
+  slot_ptr->log_type = log_type;
+  size_t len         = strlen( message_str );
+  len                = len < VOL_LOG_RING_MSG_MAX_LEN - 1 ? len : VOL_LOG_RING_MSG_MAX_LEN - 1;
+  memcpy( slot_ptr->message_str, message_str, len );
+  slot_ptr->message_str[len] = '\0';
+  _store_release( &slot_ptr->seq, pos + 1 ); // Publish to the reader.
+  return true;
+}
+
+bool vol_log_ring_pop( vol_log_ring_t* ring_ptr, int* log_type_ptr, char* message_str, uint32_t max_len ) {
+  if ( !ring_ptr || !message_str || 0 == max_len ) { return false; }
+
+  uint32_t pos           = ring_ptr->read_pos;
+  _ring_slot_t* slot_ptr = &ring_ptr->slots_ptr[pos & ring_ptr->mask];
+  if ( _load_acquire( &slot_ptr->seq ) != pos + 1 ) { return false; } // Empty, or the next message is still being written.
+
+  if ( log_type_ptr ) { *log_type_ptr = slot_ptr->log_type; }
+  size_t len = strlen( slot_ptr->message_str );
+  len        = len < max_len - 1 ? len : max_len - 1;
+  memcpy( message_str, slot_ptr->message_str, len );
+  message_str[len] = '\0';
+  ring_ptr->read_pos = pos + 1;
+  _store_release( &slot_ptr->seq, pos + ring_ptr->mask + 1 ); // Free for the writer of the next lap.
+  return true;
+}
+
+uint32_t vol_log_ring_n_dropped( const vol_log_ring_t* ring_ptr ) {
+  if ( !ring_ptr ) { return 0; }
+  return _load_relaxed( &ring_ptr->n_dropped );
+}
@@ -0,0 +1,78 @@
+/**  @file vol_log_ring.h
+ * Volograms Log Ring Buffer
+ *
+ * vol_log_ring | Lock-free ring buffer for log messages.
+ * ------------ | ---------------------
+ * Version      | 0.1
+ * Authors      | Anton Gerdelan     <anton@volograms.com>
+ * Copyright    | 2026, Volograms (http://volograms.com/)
+ * Language     | C99
+ * Files        | 2
+ * Licence      | The MIT License. See LICENSE.md for details.
+ *
+ * A log sink for vol_geom and vol_av that never blocks and never does I/O on the thread that logs.
+ * Any number of threads can push messages at once. One thread pops them later, e.g. once per rendered frame, and prints or displays them.
+ * When the ring is full, new messages are dropped and counted rather than waiting for space.
+ *
+ * Connect it to a library with a short callback that forwards to `vol_log_ring_push()`:
+ *
+ *     static void _ring_callback( vol_geom_log_type_t log_type, const char* message_str, void* user_ptr ) {
+ *       vol_log_ring_push( (vol_log_ring_t*)user_ptr, (int)log_type, message_str );
+ *     }
+ *     vol_geom_log_sink_t sink = { .callback_ptr = _ring_callback, .user_ptr = ring_ptr, .min_log_type = VOL_GEOM_LOG_TYPE_WARNING };
+ *     vol_geom_create_file_info_from_file_ex( "my.vols", &info, &sink );
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_LOG_RING_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_LOG_RING_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Longer messages are truncated. Matches the longest message the libraries format. */
+#define VOL_LOG_RING_MSG_MAX_LEN 512
+
+/** Opaque ring buffer. Create with `vol_log_ring_create()`. */
+typedef struct vol_log_ring_t vol_log_ring_t;
+
+/** Allocate a ring with room for at least `n_messages` messages. The count is rounded up to a power of two.
+ * @returns NULL if out of memory or `n_messages` is 0 or too large.
+ */
+VOL_LOG_RING_EXPORT vol_log_ring_t* vol_log_ring_create( uint32_t n_messages );
+
+/** Free a ring. No other thread may be using it. */
+VOL_LOG_RING_EXPORT void vol_log_ring_free( vol_log_ring_t* ring_ptr );
+
+/** Copy a message into the ring. Safe to call from any number of threads at once.
+ * @param log_type A library's log type, e.g. a `vol_geom_log_type_t`, returned as-is by `vol_log_ring_pop()`.
+ * @returns False if the ring was full, in which case the message is counted in `vol_log_ring_n_dropped()`.
+ */
+VOL_LOG_RING_EXPORT bool vol_log_ring_push( vol_log_ring_t* ring_ptr, int log_type, const char* message_str );
+
+/** Remove the oldest message from the ring. Call from one thread at a time.
+ * @param message_str Receives the message. Must have room for `max_len` bytes, up to VOL_LOG_RING_MSG_MAX_LEN.
+ * @returns False if the ring was empty.
+ */
+VOL_LOG_RING_EXPORT bool vol_log_ring_pop( vol_log_ring_t* ring_ptr, int* log_type_ptr, char* message_str, uint32_t max_len );
+
+/** @returns The number of messages dropped because the ring was full, since it was created. */
+VOL_LOG_RING_EXPORT uint32_t vol_log_ring_n_dropped( const vol_log_ring_t* ring_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
@@ -0,0 +1,1270 @@
+/** @file vol_mesh.c
+ * Volograms Mesh Processing API
+ *
+ * vol_mesh  | Mesh processing for vologram frames.
+ * --------- | ---------------------
+ * Version   | 0.6
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * References
+ * ----------
+ * - Tom Forsyth, "Linear-Speed Vertex Cache Optimisation", 2006. https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+ */
+
+#include "vol_mesh.h"
+#include "vol_thread.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define VOL_MESH_SSE
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#define VOL_MESH_NEON
+#include <arm_neon.h>
+#endif
+
+// AVX2 kernels are compiled whatever the target, and only called if the CPU has AVX2. See `vol_mesh_simd()`.
+// They may also use F16C half-float conversion, which every CPU with AVX2 has.
+#if defined( VOL_MESH_SSE ) && ( defined( __GNUC__ ) || defined( _MSC_VER ) )
+#define VOL_MESH_AVX2
+#include <immintrin.h>
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#define VOL_MESH_TARGET_AVX2
+#else
+#include <cpuid.h>
+#define VOL_MESH_TARGET_AVX2 __attribute__( ( target( "avx2,f16c" ) ) )
+#endif
+#endif
+
+/// Values from Forsyth's paper. The cache is a little bigger than the size we score for, so that vertices can fall out of it gracefully.
+#define VOL_MESH_FORSYTH_CACHE_DECAY_POWER 1.5f
+#define VOL_MESH_FORSYTH_LAST_TRI_SCORE 0.75f
+#define VOL_MESH_FORSYTH_VALENCE_BOOST_SCALE 2.0f
+#define VOL_MESH_FORSYTH_VALENCE_BOOST_POWER 0.5f
+
+static uint32_t _index_get( const void* indices_ptr, uint32_t i, vol_mesh_index_type_t index_type ) {
+  switch ( index_type ) {
+  case VOL_MESH_INDEX_TYPE_U8: return ( (const uint8_t*)indices_ptr )[i];
+  case VOL_MESH_INDEX_TYPE_U16: return ( (const uint16_t*)indices_ptr )[i];
+  default: return ( (const uint32_t*)indices_ptr )[i];
+  }
+}
+
+static void _index_set( void* indices_ptr, uint32_t i, uint32_t value, vol_mesh_index_type_t index_type ) {
+  switch ( index_type ) {
+  case VOL_MESH_INDEX_TYPE_U8: ( (uint8_t*)indices_ptr )[i] = (uint8_t)value; break;
+  case VOL_MESH_INDEX_TYPE_U16: ( (uint16_t*)indices_ptr )[i] = (uint16_t)value; break;
+  default: ( (uint32_t*)indices_ptr )[i] = value; break;
+  }
+}
+
+static bool _valid_index_type( vol_mesh_index_type_t index_type ) { return index_type >= VOL_MESH_INDEX_TYPE_U8 && index_type <= VOL_MESH_INDEX_TYPE_U32; }
+
+vol_mesh_index_type_t vol_mesh_index_type( uint32_t n_vertices ) { return n_vertices >= 65535 ? VOL_MESH_INDEX_TYPE_U32 : VOL_MESH_INDEX_TYPE_U16; }
+
+uint32_t vol_mesh_index_sz( vol_mesh_index_type_t index_type ) {
+  switch ( index_type ) {
+  case VOL_MESH_INDEX_TYPE_U8: return 1;
+  case VOL_MESH_INDEX_TYPE_U16: return 2;
+  default: return 4;
+  }
+}
+
+/** Forsyth's vertex score. `cache_pos` is -1 if the vertex is not in the cache. */
+static float _vertex_score( int cache_pos, uint32_t remaining_valence ) {
+  if ( 0 == remaining_valence ) { return -1.0f; } // No triangles left that use this vertex.
+
+  float score = 0.0f;
+  if ( cache_pos >= 0 ) {
+    if ( cache_pos < 3 ) {
+      // Used by the last triangle. Fixed score so that it doesn't matter which of the 3 is used, otherwise we'd favour strips.
+      score = VOL_MESH_FORSYTH_LAST_TRI_SCORE;
+    } else {
+      const float scaler = 1.0f / ( VOL_MESH_VERTEX_CACHE_SZ - 3 );
+      score              = powf( 1.0f - ( cache_pos - 3 ) * scaler, VOL_MESH_FORSYTH_CACHE_DECAY_POWER );
+    }
+  }
+  // Bonus for vertices with few triangles left, so lone triangles get cleaned up rather than left until later.
+  score += VOL_MESH_FORSYTH_VALENCE_BOOST_SCALE * powf( (float)remaining_valence, -VOL_MESH_FORSYTH_VALENCE_BOOST_POWER );
+  return score;
+}
+
+bool vol_mesh_optimise_vertex_cache( void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, vol_mesh_index_type_t index_type ) {
+  if ( !indices_ptr || 0 != n_indices % 3 || !_valid_index_type( index_type ) ) { return false; }
+  if ( 0 == n_indices || 0 == n_vertices ) { return true; }
+
+  const uint32_t n_tris = n_indices / 3;
+  bool success          = false;
+
+  uint32_t* tmp_indices_ptr    = malloc( n_indices * sizeof( uint32_t ) );
+  uint32_t* valence_ptr        = calloc( n_vertices, sizeof( uint32_t ) ); // Triangles not yet emitted that use each vertex.
+  uint32_t* adjacency_offs_ptr = calloc( (size_t)n_vertices + 1, sizeof( uint32_t ) );
+  uint32_t* adjacency_ptr      = malloc( n_indices * sizeof( uint32_t ) ); // Triangle IDs used by each vertex, packed.
+  int* cache_pos_ptr           = malloc( n_vertices * sizeof( int ) );
+  float* vertex_score_ptr      = malloc( n_vertices * sizeof( float ) );
+  bool* tri_emitted_ptr        = calloc( n_tris, sizeof( bool ) );
+  if ( !tmp_indices_ptr || !valence_ptr || !adjacency_offs_ptr || !adjacency_ptr || !cache_pos_ptr || !vertex_score_ptr || !tri_emitted_ptr ) {
+    goto vmovc_end;
+  }
+
+  // Build vertex->triangle adjacency.
+  for ( uint32_t i = 0; i < n_indices; i++ ) {
+    uint32_t v = _index_get( indices_ptr, i, index_type );
+    if ( v >= n_vertices ) { goto vmovc_end; }
+    tmp_indices_ptr[i] = v;
+    valence_ptr[v]++;
+  }
+  for ( uint32_t v = 0; v < n_vertices; v++ ) { adjacency_offs_ptr[v + 1] = adjacency_offs_ptr[v] + valence_ptr[v]; }
+  {
+    // Re-use cache_pos_ptr as a fill counter here, before it's initialised properly.
+    memset( cache_pos_ptr, 0, n_vertices * sizeof( int ) );
+    for ( uint32_t i = 0; i < n_indices; i++ ) {
+      uint32_t v                                               = tmp_indices_ptr[i];
+      adjacency_ptr[adjacency_offs_ptr[v] + cache_pos_ptr[v]++] = i / 3;
+    }
+  }
+
+  for ( uint32_t v = 0; v < n_vertices; v++ ) {
+    cache_pos_ptr[v]    = -1;
+    vertex_score_ptr[v] = _vertex_score( -1, valence_ptr[v] );
+  }
+
+  uint32_t cache[VOL_MESH_VERTEX_CACHE_SZ + 3], new_cache[VOL_MESH_VERTEX_CACHE_SZ + 3];
+  uint32_t cache_count = 0;
+  uint32_t scan_cursor = 0; // For finding a new best triangle when the cache has none left to offer.
+  int64_t best_tri     = -1;
+
+  for ( uint32_t out_tri = 0; out_tri < n_tris; out_tri++ ) {
+    if ( best_tri < 0 ) {
+      // Nothing adjacent to the cache. Restart from the next triangle in input order, which keeps this step linear overall.
+      while ( scan_cursor < n_tris && tri_emitted_ptr[scan_cursor] ) { scan_cursor++; }
+      if ( scan_cursor >= n_tris ) { goto vmovc_end; } // Shouldn't happen - would mean out_tri miscounted.
+      best_tri = scan_cursor;
+    }
+
+    // Emit the triangle into the output index buffer.
+    const uint32_t* tri_ptr = &tmp_indices_ptr[best_tri * 3];
+    for ( int k = 0; k < 3; k++ ) { _index_set( indices_ptr, out_tri * 3 + k, tri_ptr[k], index_type ); }
+    tri_emitted_ptr[best_tri] = true;
+
+    // Remove the triangle from its vertices' adjacency lists.
+    for ( int k = 0; k < 3; k++ ) {
+      uint32_t v        = tri_ptr[k];
+      uint32_t* adj_ptr = &adjacency_ptr[adjacency_offs_ptr[v]];
+      for ( uint32_t a = 0; a < valence_ptr[v]; a++ ) {
+        if ( adj_ptr[a] == (uint32_t)best_tri ) {
+          adj_ptr[a] = adj_ptr[valence_ptr[v] - 1];
+          break;
+        }
+      }
+      valence_ptr[v]--;
+    }
+
+    // Push the triangle's vertices to the front of the cache (LRU order).
+    uint32_t new_count = 0;
+    for ( int k = 0; k < 3; k++ ) {
+      if ( ( k > 0 && tri_ptr[k] == tri_ptr[0] ) || ( k > 1 && tri_ptr[k] == tri_ptr[1] ) ) { continue; } // Degenerate triangle.
+      new_cache[new_count++] = tri_ptr[k];
+    }
+    for ( uint32_t c = 0; c < cache_count; c++ ) {
+      uint32_t v = cache[c];
+      if ( v != tri_ptr[0] && v != tri_ptr[1] && v != tri_ptr[2] ) { new_cache[new_count++] = v; }
+    }
+    // Vertices pushed out of the scored cache size lose their cache bonus.
+    for ( uint32_t c = VOL_MESH_VERTEX_CACHE_SZ; c < new_count; c++ ) {
+      uint32_t v          = new_cache[c];
+      cache_pos_ptr[v]    = -1;
+      vertex_score_ptr[v] = _vertex_score( -1, valence_ptr[v] );
+    }
+    cache_count = new_count < VOL_MESH_VERTEX_CACHE_SZ ? new_count : VOL_MESH_VERTEX_CACHE_SZ;
+    memcpy( cache, new_cache, cache_count * sizeof( uint32_t ) );
+
+    // Re-score vertices in the cache, and the triangles that use them, and pick the next triangle from those.
+    for ( uint32_t c = 0; c < cache_count; c++ ) {
+      uint32_t v          = cache[c];
+      cache_pos_ptr[v]    = (int)c;
+      vertex_score_ptr[v] = _vertex_score( (int)c, valence_ptr[v] );
+    }
+    float best_score = -1.0f;
+    best_tri         = -1;
+    for ( uint32_t c = 0; c < cache_count; c++ ) {
+      uint32_t v              = cache[c];
+      const uint32_t* adj_ptr = &adjacency_ptr[adjacency_offs_ptr[v]];
+      for ( uint32_t a = 0; a < valence_ptr[v]; a++ ) {
+        uint32_t t  = adj_ptr[a];
+        float score = vertex_score_ptr[tmp_indices_ptr[t * 3 + 0]] + vertex_score_ptr[tmp_indices_ptr[t * 3 + 1]] + vertex_score_ptr[tmp_indices_ptr[t * 3 + 2]];
+        if ( score > best_score ) {
+          best_score = score;
+          best_tri   = t;
+        }
+      }
+    }
+  } // endfor out_tri
+  success = true;
+
+vmovc_end:
+  free( tmp_indices_ptr );
+  free( valence_ptr );
+  free( adjacency_offs_ptr );
+  free( adjacency_ptr );
+  free( cache_pos_ptr );
+  free( vertex_score_ptr );
+  free( tri_emitted_ptr );
+  return success;
+}
+
+bool vol_mesh_optimise_vertex_fetch( void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, vol_mesh_index_type_t index_type, uint32_t* remap_ptr ) {
+  if ( !indices_ptr || !remap_ptr || !_valid_index_type( index_type ) ) { return false; }
+
+  const uint32_t unset = UINT32_MAX;
+  for ( uint32_t v = 0; v < n_vertices; v++ ) { remap_ptr[v] = unset; }
+
+  // First pass checks indices so a bad index doesn't leave the index buffer half-rewritten.
+  for ( uint32_t i = 0; i < n_indices; i++ ) {
+    if ( _index_get( indices_ptr, i, index_type ) >= n_vertices ) { return false; }
+  }
+
+  uint32_t next = 0;
+  for ( uint32_t i = 0; i < n_indices; i++ ) {
+    uint32_t v = _index_get( indices_ptr, i, index_type );
+    if ( unset == remap_ptr[v] ) { remap_ptr[v] = next++; }
+    _index_set( indices_ptr, i, remap_ptr[v], index_type );
+  }
+  // Keep unreferenced vertices so that tracked frames, which have a vertex per keyframe vertex, still line up.
+  for ( uint32_t v = 0; v < n_vertices; v++ ) {
+    if ( unset == remap_ptr[v] ) { remap_ptr[v] = next++; }
+  }
+
+  return true;
+}
+
+bool vol_mesh_remap_vertices( const void* src_ptr, void* dst_ptr, uint32_t n_vertices, uint32_t element_sz, const uint32_t* remap_ptr ) {
+  if ( !src_ptr || !dst_ptr || !remap_ptr || 0 == element_sz ) { return false; }
+
+  const uint8_t* src_bytes_ptr = (const uint8_t*)src_ptr;
+  uint8_t* dst_bytes_ptr       = (uint8_t*)dst_ptr;
+  for ( uint32_t v = 0; v < n_vertices; v++ ) {
+    if ( remap_ptr[v] >= n_vertices ) { return false; }
+    memcpy( &dst_bytes_ptr[(size_t)remap_ptr[v] * element_sz], &src_bytes_ptr[(size_t)v * element_sz], element_sz );
+  }
+  return true;
+}
+
+float vol_mesh_acmr( const void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, vol_mesh_index_type_t index_type, uint32_t cache_sz ) {
+  if ( !indices_ptr || !_valid_index_type( index_type ) || 0 == cache_sz || n_indices < 3 ) { return -1.0f; }
+
+  // Store the "time" each vertex entered the FIFO, so a lookup is O(1).
+  uint32_t* entered_ptr = malloc( n_vertices * sizeof( uint32_t ) );
+  if ( !entered_ptr ) { return -1.0f; }
+  for ( uint32_t v = 0; v < n_vertices; v++ ) { entered_ptr[v] = UINT32_MAX; }
+
+  uint32_t misses = 0;
+  for ( uint32_t i = 0; i < n_indices; i++ ) {
+    uint32_t v = _index_get( indices_ptr, i, index_type );
+    if ( v >= n_vertices ) {
+      free( entered_ptr );
+      return -1.0f;
+    }
+    if ( UINT32_MAX == entered_ptr[v] || misses - entered_ptr[v] >= cache_sz ) { entered_ptr[v] = misses++; }
+  }
+  free( entered_ptr );
+
+  return (float)misses / (float)( n_indices / 3 );
+}
+
+/** Normalise `n_normals` 3-float vectors in-place. Zero-length vectors are left as zero. */
+static void _normalise_vec3s( float* normals_ptr, uint32_t n_normals ) {
+  const float eps = 1e-20f;
+  uint32_t i      = 0;
+#if defined( VOL_MESH_SSE )
+  // 4 vectors at a time as 3 registers of AoS data: a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3).
+  for ( ; i + 4 <= n_normals; i += 4 ) {
+    float* p    = &normals_ptr[i * 3];
+    __m128 a    = _mm_loadu_ps( p ), b = _mm_loadu_ps( p + 4 ), c = _mm_loadu_ps( p + 8 );
+    __m128 x    = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+    __m128 y_lo = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 1, 1 ) ), y_hi = _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 2, 3, 3 ) );
+    __m128 z_lo = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 1, 2, 2 ) ), z_hi = _mm_shuffle_ps( c, c, _MM_SHUFFLE( 3, 3, 0, 0 ) );
+    __m128 y    = _mm_shuffle_ps( y_lo, y_hi, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 z    = _mm_shuffle_ps( z_lo, z_hi, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+    __m128 len2 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) );
+    __m128 mask = _mm_cmpgt_ps( len2, _mm_set1_ps( eps ) );
+    __m128 s    = _mm_and_ps( mask, _mm_div_ps( _mm_set1_ps( 1.0f ), _mm_sqrt_ps( _mm_max_ps( len2, _mm_set1_ps( eps ) ) ) ) );
+    // Broadcast each vector's scale back over its AoS lanes.
+    _mm_storeu_ps( p, _mm_mul_ps( a, _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 0, 0, 0 ) ) ) );
+    _mm_storeu_ps( p + 4, _mm_mul_ps( b, _mm_shuffle_ps( s, s, _MM_SHUFFLE( 2, 2, 1, 1 ) ) ) );
+    _mm_storeu_ps( p + 8, _mm_mul_ps( c, _mm_shuffle_ps( s, s, _MM_SHUFFLE( 3, 3, 3, 2 ) ) ) );
+  }
+#elif defined( VOL_MESH_NEON )
+  for ( ; i + 4 <= n_normals; i += 4 ) {
+    float* p         = &normals_ptr[i * 3];
+    float32x4x3_t v  = vld3q_f32( p ); // De-interleaves into x, y, z.
+    float32x4_t len2 = vmlaq_f32( vmlaq_f32( vmulq_f32( v.val[0], v.val[0] ), v.val[1], v.val[1] ), v.val[2], v.val[2] );
+    uint32x4_t mask  = vcgtq_f32( len2, vdupq_n_f32( eps ) );
+    len2             = vmaxq_f32( len2, vdupq_n_f32( eps ) );
+    float32x4_t s    = vrsqrteq_f32( len2 );
+    s                = vmulq_f32( s, vrsqrtsq_f32( vmulq_f32( len2, s ), s ) ); // Two Newton-Raphson steps for full precision.
+    s                = vmulq_f32( s, vrsqrtsq_f32( vmulq_f32( len2, s ), s ) );
+    s                = vbslq_f32( mask, s, vdupq_n_f32( 0.0f ) );
+    v.val[0]         = vmulq_f32( v.val[0], s );
+    v.val[1]         = vmulq_f32( v.val[1], s );
+    v.val[2]         = vmulq_f32( v.val[2], s );
+    vst3q_f32( p, v );
+  }
+#endif
+  for ( ; i < n_normals; i++ ) {
+    float* p   = &normals_ptr[i * 3];
+    float len2 = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+    float s    = len2 > eps ? 1.0f / sqrtf( len2 ) : 0.0f;
+    p[0] *= s;
+    p[1] *= s;
+    p[2] *= s;
+  }
+}
+
+bool vol_mesh_compute_normals( const float* vertices_ptr, uint32_t n_vertices, const void* indices_ptr, uint32_t n_indices, vol_mesh_index_type_t index_type,
+  float* normals_ptr ) {
+  if ( !vertices_ptr || !indices_ptr || !normals_ptr || 0 != n_indices % 3 || !_valid_index_type( index_type ) ) { return false; }
+
+  memset( normals_ptr, 0, (size_t)n_vertices * 3 * sizeof( float ) );
+
+  // The un-normalised cross product has a length of twice the triangle's area, so summing them gives area-weighted normals for free.
+  for ( uint32_t i = 0; i < n_indices; i += 3 ) {
+    uint32_t ia = _index_get( indices_ptr, i + 0, index_type );
+    uint32_t ib = _index_get( indices_ptr, i + 1, index_type );
+    uint32_t ic = _index_get( indices_ptr, i + 2, index_type );
+    if ( ia >= n_vertices || ib >= n_vertices || ic >= n_vertices ) { return false; }
+    const float* a = &vertices_ptr[ia * 3];
+    const float* b = &vertices_ptr[ib * 3];
+    const float* c = &vertices_ptr[ic * 3];
+    float e0[3]    = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    float e1[3]    = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    float n[3]     = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+    for ( int j = 0; j < 3; j++ ) {
+      normals_ptr[ia * 3 + j] += n[j];
+      normals_ptr[ib * 3 + j] += n[j];
+      normals_ptr[ic * 3 + j] += n[j];
+    }
+  }
+  _normalise_vec3s( normals_ptr, n_vertices );
+
+  return true;
+}
+
+/** Per-batch state shared by the worker threads of `vol_mesh_compute_normals_frames()`. */
+typedef struct _normals_batch_t {
+  vol_mesh_frame_view_t* views_ptr;
+  bool* failed_ptr;
+} _normals_batch_t;
+
+static void _compute_normals_frame( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  _normals_batch_t* batch_ptr = (_normals_batch_t*)user_ptr;
+  vol_mesh_frame_view_t* v    = &batch_ptr->views_ptr[item_idx];
+  // Each frame writes only to its own normals, so no locking is needed.
+  if ( !vol_mesh_compute_normals( v->vertices_ptr, v->n_vertices, v->indices_ptr, v->n_indices, v->index_type, v->normals_ptr ) ) {
+    batch_ptr->failed_ptr[item_idx] = true;
+  }
+}
+
+bool vol_mesh_compute_normals_frames( vol_mesh_frame_view_t* views_ptr, uint32_t n_views, uint32_t n_threads ) {
+  if ( !views_ptr ) { return false; }
+  if ( 0 == n_views ) { return true; }
+
+  bool* failed_ptr = calloc( n_views, sizeof( bool ) );
+  if ( !failed_ptr ) { return false; }
+  _normals_batch_t batch = ( _normals_batch_t ){ .views_ptr = views_ptr, .failed_ptr = failed_ptr };
+  bool success           = vol_thread_parallel_for( n_views, n_threads, _compute_normals_frame, &batch );
+  for ( uint32_t i = 0; i < n_views; i++ ) {
+    if ( failed_ptr[i] ) { success = false; }
+  }
+  free( failed_ptr );
+
+  return success;
+}
+
+/*************************************************************************************************************************************************
+ * SIMD dispatch
+ *************************************************************************************************************************************************/
+
+static vol_mesh_simd_t _simd_max = VOL_MESH_SIMD_AVX2;
+
+#ifdef VOL_MESH_AVX2
+static bool _cpu_check_avx2( void ) {
+#if defined( _MSC_VER ) && !defined( __clang__ )
+  int info[4];
+  __cpuid( info, 0 );
+  if ( info[0] < 7 ) { return false; }
+  __cpuid( info, 1 );
+  if ( !( info[2] & ( 1 << 27 ) ) || !( info[2] & ( 1 << 28 ) ) ) { return false; } // OSXSAVE and AVX.
+  if ( !( info[2] & ( 1 << 29 ) ) ) { return false; }                               // F16C.
+  if ( ( _xgetbv( 0 ) & 6 ) != 6 ) { return false; }                                 // The OS saves YMM registers on context switches.
+  __cpuidex( info, 7, 0 );
+  return 0 != ( info[1] & ( 1 << 5 ) );
+#else
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if ( !__get_cpuid( 1, &eax, &ebx, &ecx, &edx ) || !( ecx & bit_F16C ) ) { return false; }
+  return __builtin_cpu_supports( "avx2" );
+#endif
+}
+
+/** CPUID can be slow in virtual machines, so it's only checked once. A race to check it first is harmless, as every check gives the same answer. */
+static bool _cpu_has_avx2( void ) {
+  static int has_avx2 = -1;
+  if ( has_avx2 < 0 ) { has_avx2 = _cpu_check_avx2() ? 1 : 0; }
+  return 1 == has_avx2;
+}
+#endif
+
+vol_mesh_simd_t vol_mesh_simd( void ) {
+  vol_mesh_simd_t simd = VOL_MESH_SIMD_NONE;
+#if defined( VOL_MESH_SSE )
+  simd = VOL_MESH_SIMD_SSE2;
+#elif defined( VOL_MESH_NEON )
+  simd = VOL_MESH_SIMD_NEON;
+#endif
+#ifdef VOL_MESH_AVX2
+  if ( _simd_max >= VOL_MESH_SIMD_AVX2 && _cpu_has_avx2() ) { simd = VOL_MESH_SIMD_AVX2; }
+#endif
+  return simd > _simd_max ? VOL_MESH_SIMD_NONE : simd;
+}
+
+void vol_mesh_set_simd_max( vol_mesh_simd_t simd_max ) { _simd_max = simd_max; }
+
+/*************************************************************************************************************************************************
+ * Transforms
+ *************************************************************************************************************************************************/
+
+vol_mesh_transform_t vol_mesh_transform_from_hdr( const vol_geom_file_hdr_t* hdr_ptr, bool flip_x ) {
+  vol_mesh_transform_t xform = ( vol_mesh_transform_t ){ .m = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f } };
+  bool reflects              = false;
+  if ( hdr_ptr && 12 == hdr_ptr->version ) { // Added in v1.2, removed in v1.3.
+    // Rotation matrix of the quaternion (w, x, y, z). A zero quaternion is taken as the identity, as is the result of rotating by it with q v q*.
+    const float* q = hdr_ptr->rotation;
+    float len2     = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    float s2       = len2 > 0.0f ? 2.0f / len2 : 0.0f;
+    float w = q[0], x = q[1], y = q[2], z = q[3];
+    float r[9] = {
+      1.0f - s2 * ( y * y + z * z ), s2 * ( x * y - w * z ), s2 * ( x * z + w * y ), //
+      s2 * ( x * y + w * z ), 1.0f - s2 * ( x * x + z * z ), s2 * ( y * z - w * x ), //
+      s2 * ( x * z - w * y ), s2 * ( y * z + w * x ), 1.0f - s2 * ( x * x + y * y )  //
+    };
+    // A negative scale is a rotation and a reflection through the origin. The inverse transpose keeps the reflection, so normals are reversed too.
+    float n_sign = copysignf( 1.0f, hdr_ptr->scale );
+    reflects     = hdr_ptr->scale < 0.0f;
+    for ( int i = 0; i < 9; i++ ) {
+      xform.m[i]   = r[i] * hdr_ptr->scale;
+      xform.n_m[i] = r[i] * n_sign;
+    }
+    memcpy( xform.t, hdr_ptr->translation, sizeof( xform.t ) );
+  } else {
+    memcpy( xform.n_m, xform.m, sizeof( xform.n_m ) );
+  }
+  if ( flip_x ) { // Negate the first row, so X is reversed after the rest of the transform.
+    for ( int i = 0; i < 3; i++ ) {
+      xform.m[i]   = -xform.m[i];
+      xform.n_m[i] = -xform.n_m[i];
+    }
+    xform.t[0] = -xform.t[0];
+  }
+  xform.flips_winding = reflects != flip_x;
+  return xform;
+}
+
+bool vol_mesh_transform_is_identity( const vol_mesh_transform_t* xform_ptr ) {
+  if ( !xform_ptr ) { return false; }
+  for ( int i = 0; i < 9; i++ ) {
+    float id = 0 == i % 4 ? 1.0f : 0.0f;
+    if ( xform_ptr->m[i] != id || xform_ptr->n_m[i] != id ) { return false; }
+  }
+  return 0.0f == xform_ptr->t[0] && 0.0f == xform_ptr->t[1] && 0.0f == xform_ptr->t[2];
+}
+
+/** `dst = m * src + t` for `n` xyz vectors. Each vector is read before it is written, so `dst_ptr` may be `src_ptr`. */
+static void _affine_xyz_c( const float* m, const float* t, const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  for ( uint32_t i = 0; i < n; i++ ) {
+    float x        = src_ptr[i * 3 + 0];
+    float y        = src_ptr[i * 3 + 1];
+    float z        = src_ptr[i * 3 + 2];
+    dst_ptr[i * 3 + 0] = m[0] * x + m[1] * y + m[2] * z + t[0];
+    dst_ptr[i * 3 + 1] = m[3] * x + m[4] * y + m[5] * z + t[1];
+    dst_ptr[i * 3 + 2] = m[6] * x + m[7] * y + m[8] * z + t[2];
+  }
+}
+
+#if defined( VOL_MESH_SSE )
+// 4 xyz vectors as 3 registers of AoS data, a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3), to and from x, y, and z registers.
+// The same shuffles work on the two 128-bit lanes of AVX registers independently, so the AVX2 kernel uses them too, on 2 groups of 4 vectors.
+#define VOL_MESH_XYZ_FROM_AOS( SHUF, a, b, c, x, y, z )                                                                                                        \
+  do {                                                                                                                                                         \
+    x = SHUF( a, SHUF( b, c, _MM_SHUFFLE( 2, 1, 3, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );                                                                         \
+    y = SHUF( SHUF( a, b, _MM_SHUFFLE( 1, 0, 2, 1 ) ), SHUF( b, c, _MM_SHUFFLE( 2, 1, 3, 2 ) ), _MM_SHUFFLE( 3, 1, 2, 0 ) );                                   \
+    z = SHUF( SHUF( a, b, _MM_SHUFFLE( 1, 0, 2, 1 ) ), c, _MM_SHUFFLE( 3, 0, 3, 1 ) );                                                                         \
+  } while ( 0 )
+#define VOL_MESH_AOS_FROM_XYZ( SHUF, UNPACKLO, UNPACKHI, x, y, z, a, b, c )                                                                                    \
+  do {                                                                                                                                                         \
+    a = SHUF( UNPACKLO( x, y ), SHUF( z, UNPACKLO( x, y ), _MM_SHUFFLE( 2, 2, 0, 0 ) ), _MM_SHUFFLE( 2, 0, 1, 0 ) );                                           \
+    b = SHUF( SHUF( UNPACKLO( x, y ), z, _MM_SHUFFLE( 1, 1, 3, 3 ) ), UNPACKHI( x, y ), _MM_SHUFFLE( 1, 0, 2, 0 ) );                                           \
+    c = SHUF( SHUF( z, UNPACKHI( x, y ), _MM_SHUFFLE( 2, 2, 2, 2 ) ),                                                                                          \
+      SHUF( UNPACKHI( x, y ), z, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );                                                                     \
+  } while ( 0 )
+
+static void _affine_xyz_sse2( const float* m, const float* t, const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  __m128 m0 = _mm_set1_ps( m[0] ), m1 = _mm_set1_ps( m[1] ), m2 = _mm_set1_ps( m[2] );
+  __m128 m3 = _mm_set1_ps( m[3] ), m4 = _mm_set1_ps( m[4] ), m5 = _mm_set1_ps( m[5] );
+  __m128 m6 = _mm_set1_ps( m[6] ), m7 = _mm_set1_ps( m[7] ), m8 = _mm_set1_ps( m[8] );
+  __m128 t0 = _mm_set1_ps( t[0] ), t1 = _mm_set1_ps( t[1] ), t2 = _mm_set1_ps( t[2] );
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    const float* s = &src_ptr[i * 3];
+    float* d       = &dst_ptr[i * 3];
+    __m128 a = _mm_loadu_ps( s ), b = _mm_loadu_ps( s + 4 ), c = _mm_loadu_ps( s + 8 ), x, y, z;
+    VOL_MESH_XYZ_FROM_AOS( _mm_shuffle_ps, a, b, c, x, y, z );
+    __m128 ox = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m0, x ), _mm_mul_ps( m1, y ) ), _mm_mul_ps( m2, z ) ), t0 );
+    __m128 oy = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m3, x ), _mm_mul_ps( m4, y ) ), _mm_mul_ps( m5, z ) ), t1 );
+    __m128 oz = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m6, x ), _mm_mul_ps( m7, y ) ), _mm_mul_ps( m8, z ) ), t2 );
+    VOL_MESH_AOS_FROM_XYZ( _mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, ox, oy, oz, a, b, c );
+    _mm_storeu_ps( d, a );
+    _mm_storeu_ps( d + 4, b );
+    _mm_storeu_ps( d + 8, c );
+  }
+  _affine_xyz_c( m, t, &src_ptr[i * 3], &dst_ptr[i * 3], n - i );
+}
+#endif
+
+#ifdef VOL_MESH_AVX2
+/** Load 8 xyz vectors so that the low lane holds vectors 0-3 and the high lane vectors 4-7, each as for the SSE2 kernel. */
+static inline VOL_MESH_TARGET_AVX2 __m256 _avx_load_lanes( const float* p, int reg ) {
+  return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( p + reg * 4 ) ), _mm_loadu_ps( p + 12 + reg * 4 ), 1 );
+}
+
+static inline VOL_MESH_TARGET_AVX2 void _avx_store_lanes( float* p, int reg, __m256 v ) {
+  _mm_storeu_ps( p + reg * 4, _mm256_castps256_ps128( v ) );
+  _mm_storeu_ps( p + 12 + reg * 4, _mm256_extractf128_ps( v, 1 ) );
+}
+
+static VOL_MESH_TARGET_AVX2 void _affine_xyz_avx2( const float* m, const float* t, const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  __m256 m0 = _mm256_set1_ps( m[0] ), m1 = _mm256_set1_ps( m[1] ), m2 = _mm256_set1_ps( m[2] );
+  __m256 m3 = _mm256_set1_ps( m[3] ), m4 = _mm256_set1_ps( m[4] ), m5 = _mm256_set1_ps( m[5] );
+  __m256 m6 = _mm256_set1_ps( m[6] ), m7 = _mm256_set1_ps( m[7] ), m8 = _mm256_set1_ps( m[8] );
+  __m256 t0 = _mm256_set1_ps( t[0] ), t1 = _mm256_set1_ps( t[1] ), t2 = _mm256_set1_ps( t[2] );
+  uint32_t i = 0;
+  for ( ; i + 8 <= n; i += 8 ) {
+    const float* s = &src_ptr[i * 3];
+    float* d       = &dst_ptr[i * 3];
+    __m256 a = _avx_load_lanes( s, 0 ), b = _avx_load_lanes( s, 1 ), c = _avx_load_lanes( s, 2 ), x, y, z;
+    VOL_MESH_XYZ_FROM_AOS( _mm256_shuffle_ps, a, b, c, x, y, z );
+    // Multiplies and adds are kept separate, rather than fused, so results match the SSE2 and plain C kernels.
+    __m256 ox = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( m0, x ), _mm256_mul_ps( m1, y ) ), _mm256_mul_ps( m2, z ) ), t0 );
+    __m256 oy = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( m3, x ), _mm256_mul_ps( m4, y ) ), _mm256_mul_ps( m5, z ) ), t1 );
+    __m256 oz = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( m6, x ), _mm256_mul_ps( m7, y ) ), _mm256_mul_ps( m8, z ) ), t2 );
+    VOL_MESH_AOS_FROM_XYZ( _mm256_shuffle_ps, _mm256_unpacklo_ps, _mm256_unpackhi_ps, ox, oy, oz, a, b, c );
+    _avx_store_lanes( d, 0, a );
+    _avx_store_lanes( d, 1, b );
+    _avx_store_lanes( d, 2, c );
+  }
+  _affine_xyz_sse2( m, t, &src_ptr[i * 3], &dst_ptr[i * 3], n - i );
+}
+#endif
+
+#ifdef VOL_MESH_NEON
+static void _affine_xyz_neon( const float* m, const float* t, const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    float32x4x3_t v = vld3q_f32( &src_ptr[i * 3] ), o; // De-interleaves into x, y, z.
+    for ( int r = 0; r < 3; r++ ) {
+      float32x4_t acc = vmulq_n_f32( v.val[0], m[r * 3 + 0] );
+      acc             = vaddq_f32( acc, vmulq_n_f32( v.val[1], m[r * 3 + 1] ) );
+      acc             = vaddq_f32( acc, vmulq_n_f32( v.val[2], m[r * 3 + 2] ) );
+      o.val[r]        = vaddq_f32( acc, vdupq_n_f32( t[r] ) );
+    }
+    vst3q_f32( &dst_ptr[i * 3], o );
+  }
+  _affine_xyz_c( m, t, &src_ptr[i * 3], &dst_ptr[i * 3], n - i );
+}
+#endif
+
+static void _affine_xyz( const float* m, const float* t, const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  switch ( vol_mesh_simd() ) {
+#ifdef VOL_MESH_AVX2
+  case VOL_MESH_SIMD_AVX2: _affine_xyz_avx2( m, t, src_ptr, dst_ptr, n ); return;
+#endif
+#ifdef VOL_MESH_SSE
+  case VOL_MESH_SIMD_SSE2: _affine_xyz_sse2( m, t, src_ptr, dst_ptr, n ); return;
+#endif
+#ifdef VOL_MESH_NEON
+  case VOL_MESH_SIMD_NEON: _affine_xyz_neon( m, t, src_ptr, dst_ptr, n ); return;
+#endif
+  default: _affine_xyz_c( m, t, src_ptr, dst_ptr, n ); return;
+  }
+}
+
+bool vol_mesh_transform_vertices( const vol_mesh_transform_t* xform_ptr, const float* src_ptr, float* dst_ptr, uint32_t n_vertices ) {
+  if ( !xform_ptr || !src_ptr || !dst_ptr ) { return false; }
+  _affine_xyz( xform_ptr->m, xform_ptr->t, src_ptr, dst_ptr, n_vertices );
+  return true;
+}
+
+bool vol_mesh_transform_normals( const vol_mesh_transform_t* xform_ptr, const float* src_ptr, float* dst_ptr, uint32_t n_normals ) {
+  if ( !xform_ptr || !src_ptr || !dst_ptr ) { return false; }
+  const float zero[3] = { 0.0f, 0.0f, 0.0f };
+  _affine_xyz( xform_ptr->n_m, zero, src_ptr, dst_ptr, n_normals );
+  return true;
+}
+
+/*************************************************************************************************************************************************
+ * Coordinate system and winding conversion
+ *************************************************************************************************************************************************/
+
+/** Copy `n` groups of 3 32-bit elements, with element k of each output group taken from element `from[k]` of the input group, xor `flip[k]`.
+ * Bits are moved, never converted, so this covers float axis swaps and negations, and the winding of 32-bit index triangles alike.
+ * Each group is read before it is written, so `dst_ptr` may be `src_ptr`.
+ */
+static void _swizzle3_c( const int* from, const uint32_t* flip, const void* src_ptr, void* dst_ptr, uint32_t n ) {
+  const uint8_t* s = (const uint8_t*)src_ptr;
+  uint8_t* d       = (uint8_t*)dst_ptr;
+  for ( uint32_t i = 0; i < n; i++ ) {
+    uint32_t in[3], out[3];
+    memcpy( in, &s[i * 12], 12 );
+    for ( int k = 0; k < 3; k++ ) { out[k] = in[from[k]] ^ flip[k]; }
+    memcpy( &d[i * 12], out, 12 );
+  }
+}
+
+/** Copy `n` UV pairs with `v` replaced by `1 - v`. */
+static void _flip_v_c( const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  for ( uint32_t i = 0; i < n; i++ ) {
+    dst_ptr[i * 2 + 0] = src_ptr[i * 2 + 0];
+    dst_ptr[i * 2 + 1] = 1.0f - src_ptr[i * 2 + 1];
+  }
+}
+
+static void _reverse_winding_u16_c( const uint16_t* src_ptr, uint16_t* dst_ptr, uint32_t n_tris ) {
+  for ( uint32_t t = 0; t < n_tris; t++ ) {
+    uint16_t a = src_ptr[t * 3 + 0], b = src_ptr[t * 3 + 1], c = src_ptr[t * 3 + 2];
+    dst_ptr[t * 3 + 0] = c;
+    dst_ptr[t * 3 + 1] = b;
+    dst_ptr[t * 3 + 2] = a;
+  }
+}
+
+#if defined( VOL_MESH_SSE )
+static void _swizzle3_sse2( const int* from, const uint32_t* flip, const void* src_ptr, void* dst_ptr, uint32_t n ) {
+  const float* s_ptr = (const float*)src_ptr;
+  float* d_ptr       = (float*)dst_ptr;
+  __m128 flip0 = _mm_castsi128_ps( _mm_set1_epi32( (int)flip[0] ) ), flip1 = _mm_castsi128_ps( _mm_set1_epi32( (int)flip[1] ) );
+  __m128 flip2 = _mm_castsi128_ps( _mm_set1_epi32( (int)flip[2] ) );
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    const float* s = &s_ptr[i * 3];
+    float* d       = &d_ptr[i * 3];
+    __m128 a = _mm_loadu_ps( s ), b = _mm_loadu_ps( s + 4 ), c = _mm_loadu_ps( s + 8 ), in[3];
+    VOL_MESH_XYZ_FROM_AOS( _mm_shuffle_ps, a, b, c, in[0], in[1], in[2] );
+    __m128 x = _mm_xor_ps( in[from[0]], flip0 ), y = _mm_xor_ps( in[from[1]], flip1 ), z = _mm_xor_ps( in[from[2]], flip2 );
+    VOL_MESH_AOS_FROM_XYZ( _mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, x, y, z, a, b, c );
+    _mm_storeu_ps( d, a );
+    _mm_storeu_ps( d + 4, b );
+    _mm_storeu_ps( d + 8, c );
+  }
+  _swizzle3_c( from, flip, &s_ptr[i * 3], &d_ptr[i * 3], n - i );
+}
+
+static void _flip_v_sse2( const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  // Lanes are u, v, u, v. `u` is passed through untouched, rather than by adding 0, which would turn -0 into +0.
+  const __m128 ones = _mm_set1_ps( 1.0f ), v_mask = _mm_castsi128_ps( _mm_set_epi32( -1, 0, -1, 0 ) );
+  uint32_t i = 0;
+  for ( ; i + 2 <= n; i += 2 ) {
+    __m128 uv = _mm_loadu_ps( &src_ptr[i * 2] );
+    _mm_storeu_ps( &dst_ptr[i * 2], _mm_or_ps( _mm_and_ps( v_mask, _mm_sub_ps( ones, uv ) ), _mm_andnot_ps( v_mask, uv ) ) );
+  }
+  _flip_v_c( &src_ptr[i * 2], &dst_ptr[i * 2], n - i );
+}
+
+/** 8 triangles at a time: indices are widened to 32 bits, so each 4 triangles are an AoS group as for vectors, then narrowed again.
+ * SSE2 has no unsigned 32 to 16-bit pack, so values are offset by 0x8000 into the range of the signed one.
+ */
+static void _reverse_winding_u16_sse2( const uint16_t* src_ptr, uint16_t* dst_ptr, uint32_t n_tris ) {
+  const __m128i zero = _mm_setzero_si128(), bias32 = _mm_set1_epi32( 0x8000 ), bias16 = _mm_set1_epi16( (short)0x8000 );
+  uint32_t t = 0;
+  for ( ; t + 8 <= n_tris; t += 8 ) {
+    const __m128i* s = (const __m128i*)&src_ptr[t * 3];
+    __m128i* d       = (__m128i*)&dst_ptr[t * 3];
+    __m128 w[6];
+    for ( int r = 0; r < 3; r++ ) {
+      __m128i v    = _mm_loadu_si128( &s[r] );
+      w[r * 2 + 0] = _mm_castsi128_ps( _mm_unpacklo_epi16( v, zero ) );
+      w[r * 2 + 1] = _mm_castsi128_ps( _mm_unpackhi_epi16( v, zero ) );
+    }
+    for ( int g = 0; g < 6; g += 3 ) {
+      __m128 x, y, z;
+      VOL_MESH_XYZ_FROM_AOS( _mm_shuffle_ps, w[g + 0], w[g + 1], w[g + 2], x, y, z );
+      VOL_MESH_AOS_FROM_XYZ( _mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, z, y, x, w[g + 0], w[g + 1], w[g + 2] );
+    }
+    for ( int r = 0; r < 3; r++ ) {
+      __m128i lo = _mm_sub_epi32( _mm_castps_si128( w[r * 2 + 0] ), bias32 );
+      __m128i hi = _mm_sub_epi32( _mm_castps_si128( w[r * 2 + 1] ), bias32 );
+      _mm_storeu_si128( &d[r], _mm_xor_si128( _mm_packs_epi32( lo, hi ), bias16 ) );
+    }
+  }
+  _reverse_winding_u16_c( &src_ptr[t * 3], &dst_ptr[t * 3], n_tris - t );
+}
+#endif
+
+#ifdef VOL_MESH_AVX2
+static VOL_MESH_TARGET_AVX2 void _swizzle3_avx2( const int* from, const uint32_t* flip, const void* src_ptr, void* dst_ptr, uint32_t n ) {
+  const float* s_ptr = (const float*)src_ptr;
+  float* d_ptr       = (float*)dst_ptr;
+  __m256 flip0 = _mm256_castsi256_ps( _mm256_set1_epi32( (int)flip[0] ) ), flip1 = _mm256_castsi256_ps( _mm256_set1_epi32( (int)flip[1] ) );
+  __m256 flip2 = _mm256_castsi256_ps( _mm256_set1_epi32( (int)flip[2] ) );
+  uint32_t i = 0;
+  for ( ; i + 8 <= n; i += 8 ) {
+    const float* s = &s_ptr[i * 3];
+    float* d       = &d_ptr[i * 3];
+    __m256 a = _avx_load_lanes( s, 0 ), b = _avx_load_lanes( s, 1 ), c = _avx_load_lanes( s, 2 ), in[3];
+    VOL_MESH_XYZ_FROM_AOS( _mm256_shuffle_ps, a, b, c, in[0], in[1], in[2] );
+    __m256 x = _mm256_xor_ps( in[from[0]], flip0 ), y = _mm256_xor_ps( in[from[1]], flip1 ), z = _mm256_xor_ps( in[from[2]], flip2 );
+    VOL_MESH_AOS_FROM_XYZ( _mm256_shuffle_ps, _mm256_unpacklo_ps, _mm256_unpackhi_ps, x, y, z, a, b, c );
+    _avx_store_lanes( d, 0, a );
+    _avx_store_lanes( d, 1, b );
+    _avx_store_lanes( d, 2, c );
+  }
+  _swizzle3_sse2( from, flip, &s_ptr[i * 3], &d_ptr[i * 3], n - i );
+}
+
+static VOL_MESH_TARGET_AVX2 void _flip_v_avx2( const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  const __m256 ones = _mm256_set1_ps( 1.0f ), v_mask = _mm256_castsi256_ps( _mm256_set_epi32( -1, 0, -1, 0, -1, 0, -1, 0 ) );
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    __m256 uv = _mm256_loadu_ps( &src_ptr[i * 2] );
+    _mm256_storeu_ps( &dst_ptr[i * 2], _mm256_blendv_ps( uv, _mm256_sub_ps( ones, uv ), v_mask ) );
+  }
+  _flip_v_sse2( &src_ptr[i * 2], &dst_ptr[i * 2], n - i );
+}
+#endif
+
+#ifdef VOL_MESH_NEON
+static void _swizzle3_neon( const int* from, const uint32_t* flip, const void* src_ptr, void* dst_ptr, uint32_t n ) {
+  const uint32_t* s_ptr = (const uint32_t*)src_ptr;
+  uint32_t* d_ptr       = (uint32_t*)dst_ptr;
+  uint32_t i            = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    uint32x4x3_t in = vld3q_u32( &s_ptr[i * 3] ), out;
+    for ( int k = 0; k < 3; k++ ) { out.val[k] = veorq_u32( in.val[from[k]], vdupq_n_u32( flip[k] ) ); }
+    vst3q_u32( &d_ptr[i * 3], out );
+  }
+  _swizzle3_c( from, flip, &s_ptr[i * 3], &d_ptr[i * 3], n - i );
+}
+
+static void _flip_v_neon( const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    float32x4x2_t uv = vld2q_f32( &src_ptr[i * 2] );
+    uv.val[1]        = vsubq_f32( vdupq_n_f32( 1.0f ), uv.val[1] );
+    vst2q_f32( &dst_ptr[i * 2], uv );
+  }
+  _flip_v_c( &src_ptr[i * 2], &dst_ptr[i * 2], n - i );
+}
+
+static void _reverse_winding_u16_neon( const uint16_t* src_ptr, uint16_t* dst_ptr, uint32_t n_tris ) {
+  uint32_t t = 0;
+  for ( ; t + 8 <= n_tris; t += 8 ) {
+    uint16x8x3_t tri = vld3q_u16( &src_ptr[t * 3] );
+    uint16x8_t a     = tri.val[0];
+    tri.val[0]       = tri.val[2];
+    tri.val[2]       = a;
+    vst3q_u16( &dst_ptr[t * 3], tri );
+  }
+  _reverse_winding_u16_c( &src_ptr[t * 3], &dst_ptr[t * 3], n_tris - t );
+}
+#endif
+
+static void _swizzle3( const int* from, const uint32_t* flip, const void* src_ptr, void* dst_ptr, uint32_t n ) {
+  switch ( vol_mesh_simd() ) {
+#ifdef VOL_MESH_AVX2
+  case VOL_MESH_SIMD_AVX2: _swizzle3_avx2( from, flip, src_ptr, dst_ptr, n ); return;
+#endif
+#ifdef VOL_MESH_SSE
+  case VOL_MESH_SIMD_SSE2: _swizzle3_sse2( from, flip, src_ptr, dst_ptr, n ); return;
+#endif
+#ifdef VOL_MESH_NEON
+  case VOL_MESH_SIMD_NEON: _swizzle3_neon( from, flip, src_ptr, dst_ptr, n ); return;
+#endif
+  default: _swizzle3_c( from, flip, src_ptr, dst_ptr, n ); return;
+  }
+}
+
+bool vol_mesh_swizzle_vec3s( const float* src_ptr, float* dst_ptr, uint32_t n, vol_mesh_axis_t x_from, vol_mesh_axis_t y_from, vol_mesh_axis_t z_from ) {
+  vol_mesh_axis_t axes[3] = { x_from, y_from, z_from };
+  if ( !src_ptr || !dst_ptr ) { return false; }
+  int from[3];
+  uint32_t flip[3];
+  for ( int k = 0; k < 3; k++ ) {
+    if ( axes[k] < VOL_MESH_AXIS_X || axes[k] > VOL_MESH_AXIS_NEG_Z ) { return false; }
+    from[k] = axes[k] % 3;
+    flip[k] = axes[k] >= VOL_MESH_AXIS_NEG_X ? 0x80000000u : 0; // Negating a float flips its sign bit, as unary minus does.
+  }
+  _swizzle3( from, flip, src_ptr, dst_ptr, n );
+  return true;
+}
+
+bool vol_mesh_y_up_to_z_up( const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  return vol_mesh_swizzle_vec3s( src_ptr, dst_ptr, n, VOL_MESH_AXIS_X, VOL_MESH_AXIS_NEG_Z, VOL_MESH_AXIS_Y );
+}
+
+bool vol_mesh_z_up_to_y_up( const float* src_ptr, float* dst_ptr, uint32_t n ) {
+  return vol_mesh_swizzle_vec3s( src_ptr, dst_ptr, n, VOL_MESH_AXIS_X, VOL_MESH_AXIS_Z, VOL_MESH_AXIS_NEG_Y );
+}
+
+bool vol_mesh_reverse_winding( const void* src_ptr, void* dst_ptr, uint32_t n_indices, vol_mesh_index_type_t index_type ) {
+  if ( !src_ptr || !dst_ptr || !_valid_index_type( index_type ) || n_indices % 3 != 0 ) { return false; }
+  uint32_t n_tris = n_indices / 3;
+  switch ( index_type ) {
+  case VOL_MESH_INDEX_TYPE_U32: {
+    const int from[3]      = { 2, 1, 0 };
+    const uint32_t flip[3] = { 0, 0, 0 };
+    _swizzle3( from, flip, src_ptr, dst_ptr, n_tris );
+  } break;
+  case VOL_MESH_INDEX_TYPE_U16: {
+    vol_mesh_simd_t simd = vol_mesh_simd();
+    (void)simd;
+#if defined( VOL_MESH_SSE )
+    if ( simd >= VOL_MESH_SIMD_SSE2 ) { // AVX2 gains nothing over SSE2 here, as the narrowing pack doesn't cross 128-bit lanes.
+      _reverse_winding_u16_sse2( (const uint16_t*)src_ptr, (uint16_t*)dst_ptr, n_tris );
+      break;
+    }
+#elif defined( VOL_MESH_NEON )
+    if ( VOL_MESH_SIMD_NEON == simd ) {
+      _reverse_winding_u16_neon( (const uint16_t*)src_ptr, (uint16_t*)dst_ptr, n_tris );
+      break;
+    }
+#endif
+    _reverse_winding_u16_c( (const uint16_t*)src_ptr, (uint16_t*)dst_ptr, n_tris );
+  } break;
+  default: {
+    const uint8_t* s = (const uint8_t*)src_ptr;
+    uint8_t* d       = (uint8_t*)dst_ptr;
+    for ( uint32_t t = 0; t < n_tris; t++ ) {
+      uint8_t a = s[t * 3 + 0], b = s[t * 3 + 1], c = s[t * 3 + 2];
+      d[t * 3 + 0] = c;
+      d[t * 3 + 1] = b;
+      d[t * 3 + 2] = a;
+    }
+  } break;
+  }
+  return true;
+}
+
+bool vol_mesh_flip_v( const float* src_ptr, float* dst_ptr, uint32_t n_uvs ) {
+  if ( !src_ptr || !dst_ptr ) { return false; }
+  switch ( vol_mesh_simd() ) {
+#ifdef VOL_MESH_AVX2
+  case VOL_MESH_SIMD_AVX2: _flip_v_avx2( src_ptr, dst_ptr, n_uvs ); break;
+#endif
+#ifdef VOL_MESH_SSE
+  case VOL_MESH_SIMD_SSE2: _flip_v_sse2( src_ptr, dst_ptr, n_uvs ); break;
+#endif
+#ifdef VOL_MESH_NEON
+  case VOL_MESH_SIMD_NEON: _flip_v_neon( src_ptr, dst_ptr, n_uvs ); break;
+#endif
+  default: _flip_v_c( src_ptr, dst_ptr, n_uvs ); break;
+  }
+  return true;
+}
+
+/*************************************************************************************************************************************************
+ * Interleaved vertex buffers
+ *************************************************************************************************************************************************/
+
+/// Vertices are converted in blocks this size, into small buffers that stay in L1 cache, then written out once, interleaved.
+#define VOL_MESH_INTERLEAVE_BLOCK 64
+
+uint32_t vol_mesh_attrib_sz( vol_mesh_attrib_format_t format, uint32_t n_components ) {
+  if ( n_components < 2 || n_components > 3 ) { return 0; }
+  switch ( format ) {
+  case VOL_MESH_ATTRIB_F32: return n_components * 4;
+  case VOL_MESH_ATTRIB_F16:
+  case VOL_MESH_ATTRIB_SNORM16:
+  case VOL_MESH_ATTRIB_UNORM16: return 3 == n_components ? 8 : 4; // Padded to a multiple of 4 bytes.
+  case VOL_MESH_ATTRIB_SNORM8: return 4;
+  default: return 0;
+  }
+}
+
+vol_mesh_vertex_layout_t vol_mesh_vertex_layout(
+  vol_mesh_attrib_format_t position_format, vol_mesh_attrib_format_t normal_format, vol_mesh_attrib_format_t uv_format ) {
+  uint32_t position_sz = vol_mesh_attrib_sz( position_format, 3 );
+  uint32_t normal_sz   = vol_mesh_attrib_sz( normal_format, 3 );
+  uint32_t uv_sz       = vol_mesh_attrib_sz( uv_format, 2 );
+  return ( vol_mesh_vertex_layout_t ){
+    .position_format = position_format,
+    .normal_format   = normal_format,
+    .uv_format       = uv_format,
+    .position_offset = 0,
+    .normal_offset   = position_sz,
+    .uv_offset       = position_sz + normal_sz,
+    .stride          = position_sz + normal_sz + uv_sz //
+  };
+}
+
+/** IEEE half float, rounded to nearest even, as F16C and NEON conversions give. Out-of-range values become infinity, and NaNs stay quiet NaNs. */
+static uint16_t _f32_to_f16( float f ) {
+  uint32_t x;
+  memcpy( &x, &f, sizeof( x ) );
+  uint32_t sign = ( x >> 16 ) & 0x8000, mant = x & 0x7FFFFF;
+  int32_t e     = (int32_t)( ( x >> 23 ) & 0xFF ) - 127 + 15;
+  if ( 128 + 15 == e ) { return (uint16_t)( sign | 0x7C00 | ( mant ? 0x200 | ( mant >> 13 ) : 0 ) ); } // Infinity or NaN.
+  if ( e >= 31 ) { return (uint16_t)( sign | 0x7C00 ); }
+  uint32_t h, rem, half;
+  if ( e <= 0 ) { // Subnormal half, or zero.
+    if ( e < -10 ) { return (uint16_t)sign; }
+    uint32_t shift = (uint32_t)( 14 - e );
+    mant |= 0x800000;
+    h    = mant >> shift;
+    rem  = mant & ( ( 1u << shift ) - 1 );
+    half = 1u << ( shift - 1 );
+  } else {
+    h    = ( (uint32_t)e << 10 ) | ( mant >> 13 );
+    rem  = mant & 0x1FFF;
+    half = 0x1000;
+  }
+  if ( rem > half || ( rem == half && ( h & 1 ) ) ) { h++; } // A carry into the exponent is still correct, up to infinity.
+  return (uint16_t)( sign | h );
+}
+
+static void _f32_to_f16_c( const float* src_ptr, uint16_t* dst_ptr, uint32_t n ) {
+  for ( uint32_t i = 0; i < n; i++ ) { dst_ptr[i] = _f32_to_f16( src_ptr[i] ); }
+}
+
+/** Normalised integers as `round( clamp( v, lo, 1 ) * scale )`, rounding to nearest even. NaNs become 0. */
+static void _f32_to_norm_c( const float* src_ptr, void* dst_ptr, uint32_t n, vol_mesh_attrib_format_t format ) {
+  float lo    = VOL_MESH_ATTRIB_UNORM16 == format ? 0.0f : -1.0f;
+  float scale = VOL_MESH_ATTRIB_SNORM16 == format ? 32767.0f : ( VOL_MESH_ATTRIB_SNORM8 == format ? 127.0f : 65535.0f );
+  for ( uint32_t i = 0; i < n; i++ ) {
+    float v = src_ptr[i] != src_ptr[i] ? 0.0f : src_ptr[i];
+    v       = v < lo ? lo : ( v > 1.0f ? 1.0f : v );
+    long q  = lrintf( v * scale );
+    switch ( format ) {
+    case VOL_MESH_ATTRIB_SNORM16: ( (int16_t*)dst_ptr )[i] = (int16_t)q; break;
+    case VOL_MESH_ATTRIB_SNORM8: ( (int8_t*)dst_ptr )[i] = (int8_t)q; break;
+    default: ( (uint16_t*)dst_ptr )[i] = (uint16_t)q; break;
+    }
+  }
+}
+
+#if defined( VOL_MESH_SSE )
+/** Store 8 rounded 32-bit values as normalised integers. SSE2 has no unsigned 32 to 16-bit pack, so UNORM16 is offset into the signed range. */
+static inline void _store_norm8_sse2( __m128i a, __m128i b, void* dst_ptr, vol_mesh_attrib_format_t format ) {
+  switch ( format ) {
+  case VOL_MESH_ATTRIB_SNORM16: _mm_storeu_si128( (__m128i*)dst_ptr, _mm_packs_epi32( a, b ) ); break;
+  case VOL_MESH_ATTRIB_SNORM8: {
+    __m128i s16 = _mm_packs_epi32( a, b );
+    _mm_storel_epi64( (__m128i*)dst_ptr, _mm_packs_epi16( s16, s16 ) );
+  } break;
+  default: {
+    __m128i bias32 = _mm_set1_epi32( 0x8000 );
+    __m128i s16    = _mm_packs_epi32( _mm_sub_epi32( a, bias32 ), _mm_sub_epi32( b, bias32 ) );
+    _mm_storeu_si128( (__m128i*)dst_ptr, _mm_xor_si128( s16, _mm_set1_epi16( (short)0x8000 ) ) );
+  } break;
+  }
+}
+
+static void _f32_to_norm_sse2( const float* src_ptr, void* dst_ptr, uint32_t n, vol_mesh_attrib_format_t format ) {
+  uint32_t dst_sz = VOL_MESH_ATTRIB_SNORM8 == format ? 1 : 2;
+  __m128 lo       = _mm_set1_ps( VOL_MESH_ATTRIB_UNORM16 == format ? 0.0f : -1.0f ), hi = _mm_set1_ps( 1.0f );
+  __m128 scale    = _mm_set1_ps( VOL_MESH_ATTRIB_SNORM16 == format ? 32767.0f : ( VOL_MESH_ATTRIB_SNORM8 == format ? 127.0f : 65535.0f ) );
+  uint32_t i      = 0;
+  for ( ; i + 8 <= n; i += 8 ) {
+    __m128 a = _mm_loadu_ps( &src_ptr[i] ), b = _mm_loadu_ps( &src_ptr[i + 4] );
+    a        = _mm_min_ps( _mm_max_ps( _mm_and_ps( a, _mm_cmpord_ps( a, a ) ), lo ), hi ); // NaNs to 0, then clamp.
+    b        = _mm_min_ps( _mm_max_ps( _mm_and_ps( b, _mm_cmpord_ps( b, b ) ), lo ), hi );
+    // Converts with the current rounding mode, nearest even by default, as lrintf().
+    _store_norm8_sse2( _mm_cvtps_epi32( _mm_mul_ps( a, scale ) ), _mm_cvtps_epi32( _mm_mul_ps( b, scale ) ), (uint8_t*)dst_ptr + i * dst_sz, format );
+  }
+  _f32_to_norm_c( &src_ptr[i], (uint8_t*)dst_ptr + i * dst_sz, n - i, format );
+}
+#endif
+
+#ifdef VOL_MESH_AVX2
+static VOL_MESH_TARGET_AVX2 void _f32_to_f16_avx2( const float* src_ptr, uint16_t* dst_ptr, uint32_t n ) {
+  uint32_t i = 0;
+  for ( ; i + 8 <= n; i += 8 ) { _mm_storeu_si128( (__m128i*)&dst_ptr[i], _mm256_cvtps_ph( _mm256_loadu_ps( &src_ptr[i] ), _MM_FROUND_TO_NEAREST_INT ) ); }
+  _f32_to_f16_c( &src_ptr[i], &dst_ptr[i], n - i );
+}
+
+static VOL_MESH_TARGET_AVX2 void _f32_to_norm_avx2( const float* src_ptr, void* dst_ptr, uint32_t n, vol_mesh_attrib_format_t format ) {
+  uint32_t dst_sz = VOL_MESH_ATTRIB_SNORM8 == format ? 1 : 2;
+  __m256 lo       = _mm256_set1_ps( VOL_MESH_ATTRIB_UNORM16 == format ? 0.0f : -1.0f ), hi = _mm256_set1_ps( 1.0f );
+  __m256 scale    = _mm256_set1_ps( VOL_MESH_ATTRIB_SNORM16 == format ? 32767.0f : ( VOL_MESH_ATTRIB_SNORM8 == format ? 127.0f : 65535.0f ) );
+  uint32_t i      = 0;
+  for ( ; i + 8 <= n; i += 8 ) {
+    __m256 a  = _mm256_loadu_ps( &src_ptr[i] );
+    a         = _mm256_min_ps( _mm256_max_ps( _mm256_and_ps( a, _mm256_cmp_ps( a, a, _CMP_ORD_Q ) ), lo ), hi );
+    __m256i q = _mm256_cvtps_epi32( _mm256_mul_ps( a, scale ) );
+    _store_norm8_sse2( _mm256_castsi256_si128( q ), _mm256_extracti128_si256( q, 1 ), (uint8_t*)dst_ptr + i * dst_sz, format );
+  }
+  _f32_to_norm_c( &src_ptr[i], (uint8_t*)dst_ptr + i * dst_sz, n - i, format );
+}
+#endif
+
+#if defined( VOL_MESH_NEON ) && defined( __aarch64__ )
+static void _f32_to_f16_neon( const float* src_ptr, uint16_t* dst_ptr, uint32_t n ) {
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) { vst1_u16( &dst_ptr[i], vreinterpret_u16_f16( vcvt_f16_f32( vld1q_f32( &src_ptr[i] ) ) ) ); }
+  _f32_to_f16_c( &src_ptr[i], &dst_ptr[i], n - i );
+}
+
+static void _f32_to_norm_neon( const float* src_ptr, void* dst_ptr, uint32_t n, vol_mesh_attrib_format_t format ) {
+  float32x4_t lo    = vdupq_n_f32( VOL_MESH_ATTRIB_UNORM16 == format ? 0.0f : -1.0f ), hi = vdupq_n_f32( 1.0f );
+  float32x4_t scale = vdupq_n_f32( VOL_MESH_ATTRIB_SNORM16 == format ? 32767.0f : ( VOL_MESH_ATTRIB_SNORM8 == format ? 127.0f : 65535.0f ) );
+  uint32_t dst_sz   = VOL_MESH_ATTRIB_SNORM8 == format ? 1 : 2;
+  uint32_t i        = 0;
+  for ( ; i + 8 <= n; i += 8 ) {
+    int32x4_t q[2];
+    for ( int h = 0; h < 2; h++ ) {
+      float32x4_t v = vld1q_f32( &src_ptr[i + h * 4] );
+      v             = vreinterpretq_f32_u32( vandq_u32( vreinterpretq_u32_f32( v ), vceqq_f32( v, v ) ) ); // NaNs to 0.
+      q[h]          = vcvtnq_s32_f32( vmulq_f32( vminq_f32( vmaxq_f32( v, lo ), hi ), scale ) );
+    }
+    uint8_t* d = (uint8_t*)dst_ptr + i * dst_sz;
+    switch ( format ) {
+    case VOL_MESH_ATTRIB_SNORM16: vst1q_s16( (int16_t*)d, vcombine_s16( vqmovn_s32( q[0] ), vqmovn_s32( q[1] ) ) ); break;
+    case VOL_MESH_ATTRIB_SNORM8: vst1_s8( (int8_t*)d, vqmovn_s16( vcombine_s16( vqmovn_s32( q[0] ), vqmovn_s32( q[1] ) ) ) ); break;
+    default: vst1q_u16( (uint16_t*)d, vcombine_u16( vqmovun_s32( q[0] ), vqmovun_s32( q[1] ) ) ); break;
+    }
+  }
+  _f32_to_norm_c( &src_ptr[i], (uint8_t*)dst_ptr + i * dst_sz, n - i, format );
+}
+#endif
+
+/** Convert `n` floats to `format`, packed, into `dst_ptr`. */
+static void _convert_floats( const float* src_ptr, void* dst_ptr, uint32_t n, vol_mesh_attrib_format_t format ) {
+  vol_mesh_simd_t simd = vol_mesh_simd();
+  (void)simd;
+  if ( VOL_MESH_ATTRIB_F16 == format ) {
+#ifdef VOL_MESH_AVX2
+    if ( VOL_MESH_SIMD_AVX2 == simd ) { // SSE2 has no half conversion.
+      _f32_to_f16_avx2( src_ptr, (uint16_t*)dst_ptr, n );
+      return;
+    }
+#endif
+#if defined( VOL_MESH_NEON ) && defined( __aarch64__ )
+    if ( VOL_MESH_SIMD_NEON == simd ) {
+      _f32_to_f16_neon( src_ptr, (uint16_t*)dst_ptr, n );
+      return;
+    }
+#endif
+    _f32_to_f16_c( src_ptr, (uint16_t*)dst_ptr, n );
+    return;
+  }
+#ifdef VOL_MESH_AVX2
+  if ( VOL_MESH_SIMD_AVX2 == simd ) {
+    _f32_to_norm_avx2( src_ptr, dst_ptr, n, format );
+    return;
+  }
+#endif
+#ifdef VOL_MESH_SSE
+  if ( VOL_MESH_SIMD_SSE2 == simd ) {
+    _f32_to_norm_sse2( src_ptr, dst_ptr, n, format );
+    return;
+  }
+#endif
+#if defined( VOL_MESH_NEON ) && defined( __aarch64__ )
+  if ( VOL_MESH_SIMD_NEON == simd ) {
+    _f32_to_norm_neon( src_ptr, dst_ptr, n, format );
+    return;
+  }
+#endif
+  _f32_to_norm_c( src_ptr, dst_ptr, n, format );
+}
+
+/** One attribute of a block of vertices, converted and packed, ready to interleave. */
+typedef struct _attrib_block_t {
+  const uint8_t* packed_ptr; // Each vertex's components, tightly packed, without padding.
+  uint32_t packed_sz;        // Bytes per vertex in `packed_ptr`.
+  uint32_t offset;           // Byte offset in the output vertex.
+} _attrib_block_t;
+
+/** Points `block_ptr` at `n` vertices' worth of an attribute in the output format: the source itself for F32, otherwise converted into `tmp_ptr`. */
+static void _prepare_attrib(
+  const float* src_ptr, uint32_t n_components, uint32_t n, vol_mesh_attrib_format_t format, uint8_t* tmp_ptr, _attrib_block_t* block_ptr ) {
+  if ( VOL_MESH_ATTRIB_F32 == format ) {
+    block_ptr->packed_ptr = (const uint8_t*)src_ptr;
+    block_ptr->packed_sz  = n_components * 4;
+    return;
+  }
+  _convert_floats( src_ptr, tmp_ptr, n * n_components, format );
+  block_ptr->packed_ptr = tmp_ptr;
+  block_ptr->packed_sz  = n_components * ( VOL_MESH_ATTRIB_SNORM8 == format ? 1 : 2 );
+}
+
+/** Writes one attribute of one vertex, with a fixed-size copy for each packed size, and zeroes any padding up to the next multiple of 4 bytes. */
+static inline void _put_attrib( uint8_t* dst_ptr, const uint8_t* src_ptr, uint32_t packed_sz ) {
+  switch ( packed_sz ) {
+  case 12: memcpy( dst_ptr, src_ptr, 12 ); break;
+  case 8: memcpy( dst_ptr, src_ptr, 8 ); break;
+  case 6: {
+    uint64_t padded = 0; // One 8-byte store rather than a 6 and a 2.
+    memcpy( &padded, src_ptr, 6 );
+    memcpy( dst_ptr, &padded, 8 );
+  } break;
+  case 4: memcpy( dst_ptr, src_ptr, 4 ); break;
+  case 3: {
+    uint32_t padded = 0;
+    memcpy( &padded, src_ptr, 3 );
+    memcpy( dst_ptr, &padded, 4 );
+  } break;
+  default: memcpy( dst_ptr, src_ptr, packed_sz ); break;
+  }
+}
+
+bool vol_mesh_interleave_vertices( const vol_mesh_vertex_layout_t* layout_ptr, const float* positions_ptr, const float* normals_ptr, const float* uvs_ptr,
+  uint32_t n_vertices, void* dst_ptr, size_t dst_sz ) {
+  if ( !layout_ptr || !dst_ptr || layout_ptr->stride == 0 ) { return false; }
+  if ( (size_t)layout_ptr->stride * n_vertices > dst_sz ) { return false; }
+  const vol_mesh_attrib_format_t formats[3] = { layout_ptr->position_format, layout_ptr->normal_format, layout_ptr->uv_format };
+  const float* srcs[3]                      = { positions_ptr, normals_ptr, uvs_ptr };
+  const uint32_t offsets[3]                 = { layout_ptr->position_offset, layout_ptr->normal_offset, layout_ptr->uv_offset };
+  const uint32_t n_components[3]            = { 3, 3, 2 };
+  // Positions can't be normalised, as they aren't in a fixed range, and UVs can't be signed.
+  if ( VOL_MESH_ATTRIB_SNORM16 == formats[0] || VOL_MESH_ATTRIB_SNORM8 == formats[0] || VOL_MESH_ATTRIB_UNORM16 == formats[0] ) { return false; }
+  if ( VOL_MESH_ATTRIB_SNORM16 == formats[2] || VOL_MESH_ATTRIB_SNORM8 == formats[2] ) { return false; }
+  if ( VOL_MESH_ATTRIB_UNORM16 == formats[1] ) { return false; }
+  int n_attribs = 0;
+  int attrib_idxs[3];
+  for ( int a = 0; a < 3; a++ ) {
+    if ( VOL_MESH_ATTRIB_NONE == formats[a] ) { continue; }
+    uint32_t sz = vol_mesh_attrib_sz( formats[a], n_components[a] );
+    if ( 0 == sz || !srcs[a] || offsets[a] + sz > layout_ptr->stride ) { return false; }
+    attrib_idxs[n_attribs++] = a;
+  }
+
+  uint8_t tmp[3][VOL_MESH_INTERLEAVE_BLOCK * 3 * 2]; // Big enough for 3 16-bit components per vertex.
+  uint8_t* d = (uint8_t*)dst_ptr;
+  for ( uint32_t first = 0; first < n_vertices; first += VOL_MESH_INTERLEAVE_BLOCK ) {
+    uint32_t n = n_vertices - first < VOL_MESH_INTERLEAVE_BLOCK ? n_vertices - first : VOL_MESH_INTERLEAVE_BLOCK;
+    _attrib_block_t blocks[3];
+    for ( int i = 0; i < n_attribs; i++ ) {
+      int a = attrib_idxs[i];
+      _prepare_attrib( &srcs[a][first * n_components[a]], n_components[a], n, formats[a], tmp[i], &blocks[i] );
+      blocks[i].offset = offsets[a];
+    }
+    // The only pass over the output, in order, so a write-combined GPU mapping is written once, sequentially.
+    for ( uint32_t v = 0; v < n; v++ ) {
+      uint8_t* vertex_ptr = &d[(size_t)( first + v ) * layout_ptr->stride];
+      for ( int i = 0; i < n_attribs; i++ ) {
+        _put_attrib( &vertex_ptr[blocks[i].offset], &blocks[i].packed_ptr[v * blocks[i].packed_sz], blocks[i].packed_sz );
+      }
+    }
+  }
+  return true;
+}
+
+/*************************************************************************************************************************************************
+ * Temporal interpolation
+ *************************************************************************************************************************************************/
+
+/// Normals are interpolated then normalised in blocks this size, so each block is still in L1 cache when it is normalised.
+#define VOL_MESH_NLERP_BLOCK 256
+
+/** `dst = a * ( 1 - t ) + b * t` for `n` floats, which gives exactly `a` when t is 0, and exactly `b` when t is 1.
+ * Elementwise, so `dst_ptr` may be `a_ptr` or `b_ptr`.
+ */
+static void _lerp_floats_c( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  const float s = 1.0f - t;
+  for ( uint32_t i = 0; i < n; i++ ) { dst_ptr[i] = a_ptr[i] * s + b_ptr[i] * t; }
+}
+
+#if defined( VOL_MESH_SSE )
+static void _lerp_floats_sse2( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  const __m128 s4 = _mm_set1_ps( 1.0f - t ), t4 = _mm_set1_ps( t );
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    __m128 a = _mm_loadu_ps( &a_ptr[i] ), b = _mm_loadu_ps( &b_ptr[i] );
+    _mm_storeu_ps( &dst_ptr[i], _mm_add_ps( _mm_mul_ps( a, s4 ), _mm_mul_ps( b, t4 ) ) );
+  }
+  _lerp_floats_c( &a_ptr[i], &b_ptr[i], t, &dst_ptr[i], n - i );
+}
+#endif
+
+#ifdef VOL_MESH_AVX2
+static VOL_MESH_TARGET_AVX2 void _lerp_floats_avx2( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  const __m256 s8 = _mm256_set1_ps( 1.0f - t ), t8 = _mm256_set1_ps( t );
+  uint32_t i = 0;
+  for ( ; i + 8 <= n; i += 8 ) {
+    __m256 a = _mm256_loadu_ps( &a_ptr[i] ), b = _mm256_loadu_ps( &b_ptr[i] );
+    _mm256_storeu_ps( &dst_ptr[i], _mm256_add_ps( _mm256_mul_ps( a, s8 ), _mm256_mul_ps( b, t8 ) ) );
+  }
+  _lerp_floats_sse2( &a_ptr[i], &b_ptr[i], t, &dst_ptr[i], n - i );
+}
+#endif
+
+#ifdef VOL_MESH_NEON
+static void _lerp_floats_neon( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  uint32_t i = 0;
+  for ( ; i + 4 <= n; i += 4 ) {
+    float32x4_t a = vld1q_f32( &a_ptr[i] ), b = vld1q_f32( &b_ptr[i] );
+    vst1q_f32( &dst_ptr[i], vaddq_f32( vmulq_n_f32( a, 1.0f - t ), vmulq_n_f32( b, t ) ) ); // Not vmlaq, which may fuse, to match plain C.
+  }
+  _lerp_floats_c( &a_ptr[i], &b_ptr[i], t, &dst_ptr[i], n - i );
+}
+#endif
+
+static void _lerp_floats( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  switch ( vol_mesh_simd() ) {
+#ifdef VOL_MESH_AVX2
+  case VOL_MESH_SIMD_AVX2: _lerp_floats_avx2( a_ptr, b_ptr, t, dst_ptr, n ); return;
+#endif
+#ifdef VOL_MESH_SSE
+  case VOL_MESH_SIMD_SSE2: _lerp_floats_sse2( a_ptr, b_ptr, t, dst_ptr, n ); return;
+#endif
+#ifdef VOL_MESH_NEON
+  case VOL_MESH_SIMD_NEON: _lerp_floats_neon( a_ptr, b_ptr, t, dst_ptr, n ); return;
+#endif
+  default: _lerp_floats_c( a_ptr, b_ptr, t, dst_ptr, n ); return;
+  }
+}
+
+bool vol_mesh_lerp_vec3s( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  if ( !a_ptr || !b_ptr || !dst_ptr || !( t >= 0.0f && t <= 1.0f ) ) { return false; }
+  _lerp_floats( a_ptr, b_ptr, t, dst_ptr, n * 3 );
+  return true;
+}
+
+bool vol_mesh_nlerp_vec3s( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n ) {
+  if ( !a_ptr || !b_ptr || !dst_ptr || !( t >= 0.0f && t <= 1.0f ) ) { return false; }
+  for ( uint32_t first = 0; first < n; first += VOL_MESH_NLERP_BLOCK ) {
+    uint32_t n_block = n - first < VOL_MESH_NLERP_BLOCK ? n - first : VOL_MESH_NLERP_BLOCK;
+    _lerp_floats( &a_ptr[first * 3], &b_ptr[first * 3], t, &dst_ptr[first * 3], n_block * 3 );
+    _normalise_vec3s( &dst_ptr[first * 3], n_block );
+  }
+  return true;
+}
+
+bool vol_mesh_frame_lerp( const vol_geom_info_t* info_ptr, double frame_time, vol_mesh_frame_lerp_t* lerp_ptr ) {
+  if ( !info_ptr || !lerp_ptr || 0 == info_ptr->hdr.frame_count || isnan( frame_time ) ) { return false; }
+  const double last_frame = (double)( info_ptr->hdr.frame_count - 1 );
+  frame_time              = frame_time < 0.0 ? 0.0 : ( frame_time > last_frame ? last_frame : frame_time );
+  uint32_t frame_a        = (uint32_t)frame_time;
+  float t                 = (float)( frame_time - (double)frame_a );
+  *lerp_ptr               = ( vol_mesh_frame_lerp_t ){ .frame_a = frame_a, .frame_b = frame_a, .t = 0.0f };
+  // A keyframe starts a new topology, so its vertices don't correspond to the frame before's, and that frame is held until it.
+  // Reads the frame header as `vol_geom_is_keyframe()` does, so that vol_mesh only needs vol_geom's types, not its code.
+  if ( t > 0.0f && frame_a + 1 < info_ptr->hdr.frame_count && 0 == info_ptr->frame_headers_ptr[frame_a + 1].keyframe ) {
+    lerp_ptr->frame_b = frame_a + 1;
+    lerp_ptr->t       = t;
+  }
+  return true;
+}
+
+bool vol_mesh_interpolate_frames( const vol_mesh_frame_view_t* a_ptr, const vol_mesh_frame_view_t* b_ptr, float t, float* positions_ptr, float* normals_ptr ) {
+  if ( !a_ptr || !b_ptr || a_ptr->n_vertices != b_ptr->n_vertices || !( t >= 0.0f && t <= 1.0f ) ) { return false; }
+  if ( positions_ptr && !vol_mesh_lerp_vec3s( a_ptr->vertices_ptr, b_ptr->vertices_ptr, t, positions_ptr, a_ptr->n_vertices ) ) { return false; }
+  if ( normals_ptr && !vol_mesh_nlerp_vec3s( a_ptr->normals_ptr, b_ptr->normals_ptr, t, normals_ptr, a_ptr->n_vertices ) ) { return false; }
+  return true;
+}
@@ -0,0 +1,302 @@
+/**  @file vol_mesh.h
+ * Volograms Mesh Processing API
+ *
+ * vol_mesh  | Mesh processing for vologram frames.
+ * --------- | ---------------------
+ * Version   | 0.6.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Functions that operate on the vertex, index, and UV arrays of a frame after it has been read with vol_geom.
+ * Nothing here does any file I/O. Functions return false on invalid parameters or if they run out of memory.
+ * Functions that process many frames at once use vol_thread, so link with `-pthread` on POSIX systems.
+ *
+ * Kernels that stream whole arrays, such as `vol_mesh_transform_vertices()`, use SIMD instructions: SSE2 or NEON, whichever the compiler targets,
+ * and AVX2 where the CPU has it, which is checked when the kernel is called. Multiplies and adds aren't fused, so results match the plain C version exactly.
+ *
+ * History
+ * -------
+ * - 0.6.1 (2026/10/18) - Header transforms with a negative scale reverse normals, and report that they flip triangle winding.
+ * - 0.6   (2026/10/18) - Temporal interpolation of positions and normals between tracked frames, for playback above the capture frame rate.
+ * - 0.5   (2026/10/18) - Interleaved vertex buffers, with half-float and normalised integer packing, written in one pass.
+ * - 0.4   (2026/10/18) - Axis swaps and flips, Y-up and Z-up conversion, winding reversal, and UV V-flips, as SIMD kernels.
+ * - 0.3   (2026/10/18) - Header transforms, with handedness conversion, applied to whole frames by SIMD kernels with runtime CPU dispatch.
+ * - 0.2   (2026/10/18) - Area-weighted vertex normal generation, for single frames or batches of frames in parallel.
+ * - 0.1   (2026/10/18) - First version. Vertex cache and vertex fetch reordering.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_MESH_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_MESH_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include "vol_geom.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** Index types as used in the .vols spec: { 0=unsigned byte, 1=unsigned short, 2=unsigned int }. */
+typedef enum vol_mesh_index_type_t {
+  VOL_MESH_INDEX_TYPE_U8 = 0, //
+  VOL_MESH_INDEX_TYPE_U16,
+  VOL_MESH_INDEX_TYPE_U32
+} vol_mesh_index_type_t;
+
+/** A view of one frame's mesh arrays, for functions that process a batch of frames.
+ * Views don't own any memory. Tracked frames share `indices_ptr` with their keyframe.
+ */
+VOL_MESH_EXPORT typedef struct vol_mesh_frame_view_t {
+  const float* vertices_ptr;
+  uint32_t n_vertices;
+  const void* indices_ptr;
+  uint32_t n_indices;
+  vol_mesh_index_type_t index_type;
+  /// Output array of `n_vertices` * 3 floats.
+  float* normals_ptr;
+} vol_mesh_frame_view_t;
+
+/** Instruction sets used by the SIMD kernels, in order of preference. `VOL_MESH_SIMD_AVX2` includes F16C half-float conversion. */
+typedef enum vol_mesh_simd_t {
+  VOL_MESH_SIMD_NONE = 0, // Plain C.
+  VOL_MESH_SIMD_SSE2,
+  VOL_MESH_SIMD_NEON,
+  VOL_MESH_SIMD_AVX2
+} vol_mesh_simd_t;
+
+/** Where a component of `vol_mesh_swizzle_vec3s()`'s output comes from: one of the input's axes, or its negation. */
+typedef enum vol_mesh_axis_t {
+  VOL_MESH_AXIS_X = 0, //
+  VOL_MESH_AXIS_Y,
+  VOL_MESH_AXIS_Z,
+  VOL_MESH_AXIS_NEG_X,
+  VOL_MESH_AXIS_NEG_Y,
+  VOL_MESH_AXIS_NEG_Z
+} vol_mesh_axis_t;
+
+/** Formats of attributes in an interleaved vertex buffer. Each attribute takes a multiple of 4 bytes, with any padding after its components zeroed.
+ * Normalised integers are `round( clamp( v, -1 or 0, 1 ) * max )`, rounded to nearest even, with NaNs as 0, as GPUs read them back.
+ */
+typedef enum vol_mesh_attrib_format_t {
+  VOL_MESH_ATTRIB_NONE = 0, // Left out of the vertex buffer.
+  VOL_MESH_ATTRIB_F32,      // 32-bit floats. 12 bytes for 3 components, 8 for 2.
+  VOL_MESH_ATTRIB_F16,      // IEEE half floats, rounded to nearest even. 8 bytes for 3 components, with a zero 4th, and 4 for 2.
+  VOL_MESH_ATTRIB_SNORM16,  // 16-bit signed normalised, for normals. 8 bytes.
+  VOL_MESH_ATTRIB_SNORM8,   // 8-bit signed normalised, for normals. 4 bytes.
+  VOL_MESH_ATTRIB_UNORM16   // 16-bit unsigned normalised, for UVs. UVs outside 0 to 1 are clamped. 4 bytes.
+} vol_mesh_attrib_format_t;
+
+/** Where each attribute goes in a vertex of an interleaved vertex buffer. Make a packed one with `vol_mesh_vertex_layout()`, or fill in your own. */
+typedef struct vol_mesh_vertex_layout_t {
+  vol_mesh_attrib_format_t position_format, normal_format, uv_format;
+  uint32_t position_offset, normal_offset, uv_offset; // Bytes from the start of a vertex. Ignored for attributes that are left out.
+  uint32_t stride;                                    // Bytes from the start of one vertex to the next.
+} vol_mesh_vertex_layout_t;
+
+/** An affine transform of vertices, and the matching transform of their normals. Make one with `vol_mesh_transform_from_hdr()`.
+ * A vertex `v` becomes `m * v + t`, and a normal `n` becomes `n_m * n`. Matrices are row-major.
+ */
+VOL_MESH_EXPORT typedef struct vol_mesh_transform_t {
+  float m[9];
+  float t[3];
+  float n_m[9];
+  bool flips_winding; // True if `m` is a reflection, with a negative determinant. Reverse triangles with `vol_mesh_reverse_winding()` to keep front faces.
+} vol_mesh_transform_t;
+
+/** The two frames to interpolate between for a fractional frame time, from `vol_mesh_frame_lerp()`. */
+typedef struct vol_mesh_frame_lerp_t {
+  uint32_t frame_a, frame_b; // The same frame if it is held, rather than interpolated.
+  float t;                   // Weight of `frame_b`, from 0 to 1. 0 if the frame is held.
+} vol_mesh_frame_lerp_t;
+
+/** Cache size that vertex cache optimisation targets, and a sensible default for `vol_mesh_acmr()`. */
+#define VOL_MESH_VERTEX_CACHE_SZ 32
+
+/** Index type used by a .vols mesh with this many vertices.
+ * "Integer[] if # vertices >= 65535 (Unity Version < 2017.3 does not support Integer indices). Short[] if # vertices < 65535."
+ */
+VOL_MESH_EXPORT vol_mesh_index_type_t vol_mesh_index_type( uint32_t n_vertices );
+
+/** Size in bytes of a single index of the given type. */
+VOL_MESH_EXPORT uint32_t vol_mesh_index_sz( vol_mesh_index_type_t index_type );
+
+/** Reorder triangles, in-place, to improve the hit rate of the GPU's post-transform vertex cache.
+ * This is Tom Forsyth's "Linear-Speed Vertex Cache Optimisation". Triangle winding is preserved.
+ * @param indices_ptr Triangle list indices of type `index_type`. Must not be NULL.
+ * @param n_indices   Number of indices. Must be a multiple of 3.
+ * @param n_vertices  Number of vertices referenced by the indices. Every index must be less than this.
+ * @returns           False on invalid parameters, an out-of-range index, or out of memory.
+ */
+VOL_MESH_EXPORT bool vol_mesh_optimise_vertex_cache( void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, vol_mesh_index_type_t index_type );
+
+/** Renumber vertices, in-place in the index array, in the order that they are first used by the triangles.
+ * This improves locality of vertex fetches. Run it after `vol_mesh_optimise_vertex_cache()`.
+ * The same `remap_ptr` must then be applied to every per-vertex array that uses these indices, with `vol_mesh_remap_vertices()`.
+ * Vertices not referenced by any triangle are moved to the end, in their original order, so the vertex count does not change.
+ * @param remap_ptr   Output array of `n_vertices` elements, where remap_ptr[old_index] = new_index. Must not be NULL.
+ * @returns           False on invalid parameters, an out-of-range index, or out of memory.
+ */
+VOL_MESH_EXPORT bool vol_mesh_optimise_vertex_fetch(
+  void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, vol_mesh_index_type_t index_type, uint32_t* remap_ptr );
+
+/** Copy a per-vertex array into a new order.
+ * @param src_ptr      Array of `n_vertices` elements, each `element_sz` bytes. Must not be NULL, and must not overlap `dst_ptr`.
+ * @param dst_ptr      Output array of the same size. Must not be NULL.
+ * @param remap_ptr    Remap table from `vol_mesh_optimise_vertex_fetch()`.
+ * @param element_sz   Size of one vertex's element in bytes. e.g. 12 for 3 floats.
+ */
+VOL_MESH_EXPORT bool vol_mesh_remap_vertices( const void* src_ptr, void* dst_ptr, uint32_t n_vertices, uint32_t element_sz, const uint32_t* remap_ptr );
+
+/** Average Cache Miss Ratio: the number of vertex transforms per triangle with a FIFO cache of `cache_sz` entries.
+ * 3.0 is the worst possible. About 0.5-0.7 is typical of an optimised mesh.
+ * @returns ACMR, or a negative value on error.
+ */
+VOL_MESH_EXPORT float vol_mesh_acmr( const void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, vol_mesh_index_type_t index_type, uint32_t cache_sz );
+
+/** Compute smooth, area-weighted, unit-length vertex normals for a triangle mesh.
+ * Each triangle adds its un-normalised face normal to its 3 vertices, so larger triangles have more influence.
+ * That accumulation is a scalar loop, as it is bound by gathering and scattering vertices by index. Only the final normalisation uses SSE2 or NEON.
+ * Face normals follow the .vols (Unity) convention of clockwise front faces, so match the normals stored in captures.
+ * Vertices not used by any triangle, or only by degenerate triangles, get a zero normal.
+ * @param vertices_ptr Array of `n_vertices` * 3 floats. Must not be NULL.
+ * @param normals_ptr  Output array of `n_vertices` * 3 floats. Must not be NULL, and must not overlap `vertices_ptr`.
+ * @returns            False on invalid parameters or an out-of-range index.
+ */
+VOL_MESH_EXPORT bool vol_mesh_compute_normals( const float* vertices_ptr, uint32_t n_vertices, const void* indices_ptr, uint32_t n_indices,
+  vol_mesh_index_type_t index_type, float* normals_ptr );
+
+/** Call `vol_mesh_compute_normals()` for each frame view, spread across threads.
+ * @param n_threads Number of threads to use. 0 uses one per logical processor.
+ * @returns         False if any frame failed. Normals of the other frames are still computed.
+ */
+VOL_MESH_EXPORT bool vol_mesh_compute_normals_frames( vol_mesh_frame_view_t* views_ptr, uint32_t n_views, uint32_t n_threads );
+
+/** @returns The instruction set the SIMD kernels use on this CPU, limited by `vol_mesh_set_simd_max()`. */
+VOL_MESH_EXPORT vol_mesh_simd_t vol_mesh_simd( void );
+
+/** Limit the instruction set used by the SIMD kernels, e.g. `VOL_MESH_SIMD_NONE` to compare against plain C. Defaults to `VOL_MESH_SIMD_AVX2`.
+ * Not thread-safe: call before starting threads that use vol_mesh.
+ */
+VOL_MESH_EXPORT void vol_mesh_set_simd_max( vol_mesh_simd_t simd_max );
+
+/** Make the transform that places a vologram's meshes, from a v1.2 header's scale, rotation, and translation, applied in that order.
+ * Other versions' headers don't have these, so give the identity.
+ * @param hdr_ptr May be NULL for the identity.
+ * @param flip_x  If true then X is reversed after the header transform, which converts from the .vols left-handed coordinates, as in Unity,
+ *                to the right-handed coordinates of formats such as .obj and glTF.
+ * Header transforms have a uniform scale, so normals are only rotated and reversed, and stay unit length.
+ * A negative scale reflects through the origin, so it reverses normals too. With `flip_x` the two reflections cancel, so check `flips_winding`
+ * rather than `flip_x` to decide whether to reverse triangles.
+ */
+VOL_MESH_EXPORT vol_mesh_transform_t vol_mesh_transform_from_hdr( const vol_geom_file_hdr_t* hdr_ptr, bool flip_x );
+
+/** @returns True if the transform leaves vertices and normals unchanged, so a copy can be skipped. */
+VOL_MESH_EXPORT bool vol_mesh_transform_is_identity( const vol_mesh_transform_t* xform_ptr );
+
+/** Transform an array of vertex positions.
+ * @param src_ptr Array of `n_vertices` * 3 floats. Must not be NULL.
+ * @param dst_ptr Output array of `n_vertices` * 3 floats. Must not be NULL.
+ *                May be the same as `src_ptr` to transform in-place, but must not otherwise overlap it.
+ * @returns       False on invalid parameters.
+ */
+VOL_MESH_EXPORT bool vol_mesh_transform_vertices( const vol_mesh_transform_t* xform_ptr, const float* src_ptr, float* dst_ptr, uint32_t n_vertices );
+
+/** Transform an array of vertex normals, as `vol_mesh_transform_vertices()`, with the transform's normal matrix and no translation. */
+VOL_MESH_EXPORT bool vol_mesh_transform_normals( const vol_mesh_transform_t* xform_ptr, const float* src_ptr, float* dst_ptr, uint32_t n_normals );
+
+/** Copy an array of 3D vectors, such as positions or normals, with their axes reordered or negated.
+ * e.g. `VOL_MESH_AXIS_NEG_X, VOL_MESH_AXIS_Y, VOL_MESH_AXIS_Z` reverses X, to convert between left and right-handed coordinates,
+ * and `VOL_MESH_AXIS_X, VOL_MESH_AXIS_Z, VOL_MESH_AXIS_Y` swaps Y and Z. Values are only moved and have their sign bits flipped,
+ * so are otherwise bit-exact. A transform that reverses handedness needs `vol_mesh_reverse_winding()` too, to keep front faces.
+ * @param src_ptr Array of `n` * 3 floats. Must not be NULL.
+ * @param dst_ptr Output array of `n` * 3 floats. Must not be NULL. May be the same as `src_ptr` to convert in-place, but must not otherwise overlap it.
+ * @returns       False on invalid parameters.
+ */
+VOL_MESH_EXPORT bool vol_mesh_swizzle_vec3s(
+  const float* src_ptr, float* dst_ptr, uint32_t n, vol_mesh_axis_t x_from, vol_mesh_axis_t y_from, vol_mesh_axis_t z_from );
+
+/** Rotate vectors from Y-up coordinates, as in .vols, glTF, and Unity, to Z-up coordinates, as in Blender and 3ds Max: (x, y, z) becomes (x, -z, y).
+ * Handedness is kept, so triangle winding is unchanged. Parameters are as for `vol_mesh_swizzle_vec3s()`.
+ */
+VOL_MESH_EXPORT bool vol_mesh_y_up_to_z_up( const float* src_ptr, float* dst_ptr, uint32_t n );
+
+/** The inverse of `vol_mesh_y_up_to_z_up()`: (x, y, z) becomes (x, z, -y). */
+VOL_MESH_EXPORT bool vol_mesh_z_up_to_y_up( const float* src_ptr, float* dst_ptr, uint32_t n );
+
+/** Copy a triangle list with each triangle's winding reversed, from clockwise to counter-clockwise or back. (a, b, c) becomes (c, b, a).
+ * @param dst_ptr May be the same as `src_ptr` to reverse in-place, but must not otherwise overlap it.
+ * @returns       False on invalid parameters, or if `n_indices` isn't a multiple of 3.
+ */
+VOL_MESH_EXPORT bool vol_mesh_reverse_winding( const void* src_ptr, void* dst_ptr, uint32_t n_indices, vol_mesh_index_type_t index_type );
+
+/** Copy an array of UVs with V flipped, to `1 - v`, e.g. between the .vols convention of V starting at the bottom of the image, and glTF's top.
+ * @param src_ptr Array of `n_uvs` * 2 floats. Must not be NULL.
+ * @param dst_ptr Output array of `n_uvs` * 2 floats. Must not be NULL. May be the same as `src_ptr` to flip in-place, but must not otherwise overlap it.
+ * @returns       False on invalid parameters.
+ */
+VOL_MESH_EXPORT bool vol_mesh_flip_v( const float* src_ptr, float* dst_ptr, uint32_t n_uvs );
+
+/** @returns Bytes that an attribute of `n_components`, 2 or 3, takes in a vertex, including padding. 0 if the format is `VOL_MESH_ATTRIB_NONE` or invalid. */
+VOL_MESH_EXPORT uint32_t vol_mesh_attrib_sz( vol_mesh_attrib_format_t format, uint32_t n_components );
+
+/** @returns A layout with positions, normals, then UVs, each packed straight after the last, and those with `VOL_MESH_ATTRIB_NONE` left out. */
+VOL_MESH_EXPORT vol_mesh_vertex_layout_t vol_mesh_vertex_layout(
+  vol_mesh_attrib_format_t position_format, vol_mesh_attrib_format_t normal_format, vol_mesh_attrib_format_t uv_format );
+
+/** Build an interleaved vertex buffer from a frame's separate arrays, e.g. straight into a mapped GPU buffer.
+ * Positions and normals come from the frame itself, and UVs from its keyframe, as read with vol_geom.
+ * Vertices are converted in small blocks that stay in cache, so `dst_ptr` is written once, in order, and never read.
+ * Bytes of each vertex not covered by an attribute, or its padding, are left as they were.
+ * @param layout_ptr    Positions may be F32 or F16, normals anything but UNORM16, and UVs F32, F16, or UNORM16.
+ * @param positions_ptr Array of `n_vertices` * 3 floats. May be NULL only if the layout leaves positions out. Likewise for normals and UVs.
+ * @param normals_ptr   Array of `n_vertices` * 3 floats.
+ * @param uvs_ptr       Array of `n_vertices` * 2 floats.
+ * @param dst_ptr       Output buffer of at least `n_vertices` * `stride` bytes. Must not overlap the inputs.
+ * @param dst_sz        Size of `dst_ptr` in bytes, checked against the above.
+ * @returns             False on invalid parameters, e.g. a format not allowed for its attribute, or an attribute that doesn't fit in the stride.
+ */
+VOL_MESH_EXPORT bool vol_mesh_interleave_vertices( const vol_mesh_vertex_layout_t* layout_ptr, const float* positions_ptr, const float* normals_ptr,
+  const float* uvs_ptr, uint32_t n_vertices, void* dst_ptr, size_t dst_sz );
+
+/** Linearly interpolate between two arrays of 3D vectors, such as the positions of two tracked frames of the same keyframe segment,
+ * which correspond vertex for vertex: `dst = a * ( 1 - t ) + b * t`. t of 0 gives `a`, and 1 gives `b`, exactly.
+ * @param a_ptr,b_ptr Arrays of `n` * 3 floats. Must not be NULL.
+ * @param dst_ptr     Output array of `n` * 3 floats. Must not be NULL. May be the same as `a_ptr` or `b_ptr`, but must not otherwise overlap them.
+ * @returns           False on invalid parameters, or if t isn't between 0 and 1.
+ */
+VOL_MESH_EXPORT bool vol_mesh_lerp_vec3s( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n );
+
+/** As `vol_mesh_lerp_vec3s()`, then normalise each vector, for interpolating unit normals. Zero-length results are left as zero. */
+VOL_MESH_EXPORT bool vol_mesh_nlerp_vec3s( const float* a_ptr, const float* b_ptr, float t, float* dst_ptr, uint32_t n );
+
+/** Find the frames to interpolate between to show a vologram at a fractional frame time, e.g. `seconds * fps` when playing a 30 fps capture at 90 Hz.
+ * Frames are only interpolated within a keyframe segment. The last frame before a keyframe is held until the keyframe, as their vertices don't correspond.
+ * @param frame_time Times before the first frame, or after the last, are clamped to them.
+ * @returns          False on invalid parameters, or if the vologram has no frames.
+ */
+VOL_MESH_EXPORT bool vol_mesh_frame_lerp( const vol_geom_info_t* info_ptr, double frame_time, vol_mesh_frame_lerp_t* lerp_ptr );
+
+/** Interpolate positions, with `vol_mesh_lerp_vec3s()`, and normals, with `vol_mesh_nlerp_vec3s()`, between two frames of the same keyframe segment,
+ * e.g. those from `vol_mesh_frame_lerp()`, straight into the caller's buffers, such as mapped GPU buffers. No frames need be stored for the in-between times.
+ * @param a_ptr,b_ptr   Views of the two frames. `vertices_ptr` is read for positions, and `normals_ptr` for normals. Must have the same `n_vertices`.
+ * @param positions_ptr Output array of `n_vertices` * 3 floats, or NULL to skip positions.
+ * @param normals_ptr   Output array of `n_vertices` * 3 floats, or NULL to skip normals.
+ * @returns             False on invalid parameters, e.g. different vertex counts, or a NULL input array for an output that was asked for.
+ */
+VOL_MESH_EXPORT bool vol_mesh_interpolate_frames(
+  const vol_mesh_frame_view_t* a_ptr, const vol_mesh_frame_view_t* b_ptr, float t, float* positions_ptr, float* normals_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
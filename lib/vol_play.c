@@ -0,0 +1,406 @@
+/** @file vol_play.c
+ * Volograms Playback Scheduler API
+ *
+ * vol_play  | Play a vologram in time, with its texture video, decoding ahead on a worker thread.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_play.h"
+#include "vol_av.h"
+#include "vol_thread.h"
+#include "vol_trace.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VOL_PLAY_ERROR_MAX_LEN 256
+#define VOL_PLAY_NO_FRAME UINT32_MAX
+
+/** A ready frame in the ring. The blob holds the frame's data, followed by its keyframe's indices and UVs if it isn't a keyframe. */
+typedef struct _slot_t {
+  uint32_t frame_idx;
+  vol_geom_frame_data_t geom;
+  uint8_t* blob_ptr;   // 2 * `biggest_frame_blob_sz` bytes.
+  uint8_t* pixels_ptr; // `video_w` * `video_h` * 3 bytes, or NULL if there is no video.
+  double video_pts_s;
+} _slot_t;
+
+struct vol_play_t {
+  vol_play_opts_t opts;
+  double fps;
+  vol_geom_info_t info;           // Used for files. For URLs the stream's info is used.
+  const vol_geom_info_t* info_ptr; // Whichever of the above is in use.
+  vol_stream_t* stream_ptr;        // NULL unless `seq_filename` is a URL.
+  char* seq_filename;
+  bool opened_info;
+
+  // Worker thread only.
+  vol_av_video_t video;
+  bool has_video, video_pending, video_converted, video_ended;
+  double video_pts_s;            // Of the frame in `video.pixels_ptr`.
+  int video_w, video_h;
+  uint8_t* key_blob_ptr;         // Copy of the most recently read keyframe.
+  vol_geom_frame_data_t key_data; // Points into `key_blob_ptr`.
+  uint32_t key_idx;
+  vol_thread_t* thread_ptr;
+
+  // Everything below is shared with the worker, and guarded by the mutex.
+  vol_thread_mutex_t* mutex_ptr;
+  vol_thread_cond_t* cond_ptr; // Broadcast when a frame is ready, when slots are freed, when the worker finishes, and when closing.
+  _slot_t* slots_ptr;          // Ring of `n_slots`, in frame order. While a frame is shown it is the slot at `ring_first`.
+  uint32_t n_slots, ring_first, ring_count;
+  bool has_shown;              // The slot at `ring_first` is being shown.
+  double clock_s;              // The time given to the latest update. The worker skips frames whose time has passed.
+  uint32_t waiting_idx;        // First frame that was due but not ready, until it or a later frame is shown.
+  uint32_t last_late_idx;
+  vol_play_stats_t stats;
+  bool worker_done, failed, quit;
+  char error_str[VOL_PLAY_ERROR_MAX_LEN];
+};
+
+static double _due_s( const vol_play_t* play_ptr, uint32_t frame_idx ) { return (double)frame_idx / play_ptr->fps; }
+
+/** Record a read error and stop the worker. Called with the lock held. */
+static void _set_error( vol_play_t* play_ptr, const char* message_str, ... ) {
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vsnprintf( play_ptr->error_str, VOL_PLAY_ERROR_MAX_LEN, message_str, arg_ptr );
+  va_end( arg_ptr );
+  play_ptr->failed = true;
+}
+
+static bool _read_frame( vol_play_t* play_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
+  if ( play_ptr->stream_ptr ) { return vol_stream_read_frame( play_ptr->stream_ptr, frame_idx, frame_data_ptr ); }
+  return vol_geom_read_frame( play_ptr->seq_filename, &play_ptr->info, frame_idx, frame_data_ptr );
+}
+
+/** Read a frame's geometry, and its keyframe if that isn't the last one read, into a slot. */
+static bool _read_geom( vol_play_t* play_ptr, uint32_t frame_idx, _slot_t* slot_ptr ) {
+  int key_idx = vol_geom_find_previous_keyframe( play_ptr->info_ptr, frame_idx );
+  if ( key_idx < 0 ) { return false; }
+  if ( (uint32_t)key_idx != play_ptr->key_idx ) {
+    vol_geom_frame_data_t key_data;
+    if ( !_read_frame( play_ptr, (uint32_t)key_idx, &key_data ) ) { return false; }
+    memcpy( play_ptr->key_blob_ptr, key_data.block_data_ptr, key_data.block_data_sz );
+    key_data.block_data_ptr = play_ptr->key_blob_ptr;
+    play_ptr->key_data      = key_data;
+    play_ptr->key_idx       = (uint32_t)key_idx;
+  }
+  const vol_geom_frame_data_t* key_ptr = &play_ptr->key_data;
+  if ( frame_idx == play_ptr->key_idx ) {
+    memcpy( slot_ptr->blob_ptr, key_ptr->block_data_ptr, key_ptr->block_data_sz );
+    slot_ptr->geom                = *key_ptr;
+    slot_ptr->geom.block_data_ptr = slot_ptr->blob_ptr;
+    return true;
+  }
+
+  vol_geom_frame_data_t frame_data;
+  if ( !_read_frame( play_ptr, frame_idx, &frame_data ) ) { return false; }
+  // Append the keyframe's indices and UVs, so that the slot holds a complete frame.
+  vol_geom_size_t sz = frame_data.block_data_sz;
+  memcpy( slot_ptr->blob_ptr, frame_data.block_data_ptr, sz );
+  memcpy( &slot_ptr->blob_ptr[sz], &key_ptr->block_data_ptr[key_ptr->indices_offset], key_ptr->indices_sz );
+  memcpy( &slot_ptr->blob_ptr[sz + key_ptr->indices_sz], &key_ptr->block_data_ptr[key_ptr->uvs_offset], key_ptr->uvs_sz );
+  frame_data.block_data_ptr = slot_ptr->blob_ptr;
+  frame_data.indices_offset = sz;
+  frame_data.indices_sz     = key_ptr->indices_sz;
+  frame_data.uvs_offset     = sz + key_ptr->indices_sz;
+  frame_data.uvs_sz         = key_ptr->uvs_sz;
+  frame_data.block_data_sz  = sz + key_ptr->indices_sz + key_ptr->uvs_sz;
+  slot_ptr->geom            = frame_data;
+  return true;
+}
+
+/** Decode video frames up to the one nearest a geometry frame's time, and copy it into the slot unless the frame is being skipped.
+ * A video frame belongs to the geometry frame whose time is nearest its PTS. The decoded frame after those stays pending in the decoder.
+ */
+static void _pair_video( vol_play_t* play_ptr, uint32_t frame_idx, bool skip, _slot_t* slot_ptr, vol_play_stats_t* stats_ptr ) {
+  if ( !play_ptr->has_video ) { return; }
+  double until_s = _due_s( play_ptr, frame_idx ) + 0.5 / play_ptr->fps;
+  bool got_own   = false;
+  for ( ;; ) {
+    if ( !play_ptr->video_pending ) {
+      if ( play_ptr->video_ended || !vol_av_decode_next_frame( &play_ptr->video ) ) { // End of the video, or a decoding error. The last frame stays up.
+        play_ptr->video_ended = true;
+        break;
+      }
+      play_ptr->video_pending = true;
+      stats_ptr->n_video_decoded++;
+    }
+    double pts_s = vol_av_frame_pts_s( &play_ptr->video );
+    if ( pts_s >= until_s ) { break; } // Belongs to a later geometry frame.
+    if ( got_own ) { stats_ptr->n_video_extra++; }
+    if ( !skip && vol_av_convert_frame( &play_ptr->video ) ) {
+      play_ptr->video_converted = true;
+      play_ptr->video_pts_s     = pts_s;
+    }
+    got_own                 = true;
+    play_ptr->video_pending = false;
+  }
+  if ( !got_own ) { stats_ptr->n_video_repeated++; }
+  if ( skip ) { return; }
+
+  size_t sz = (size_t)play_ptr->video_w * play_ptr->video_h * 3;
+  if ( play_ptr->video_converted ) { // Repeats copy the previous frame again, which is still in vol_av's buffer.
+    memcpy( slot_ptr->pixels_ptr, play_ptr->video.pixels_ptr, sz );
+    slot_ptr->video_pts_s = play_ptr->video_pts_s;
+  } else {
+    memset( slot_ptr->pixels_ptr, 0, sz );
+    slot_ptr->video_pts_s = -1.0;
+  }
+}
+
+static void _worker_fn( void* user_ptr ) {
+  vol_play_t* play_ptr = (vol_play_t*)user_ptr;
+  uint32_t n_frames    = play_ptr->info_ptr->hdr.frame_count;
+  for ( uint32_t i = 0; i < n_frames; i++ ) {
+    vol_thread_mutex_lock( play_ptr->mutex_ptr );
+    while ( !play_ptr->quit && play_ptr->ring_count == play_ptr->n_slots ) { vol_thread_cond_wait( play_ptr->cond_ptr, play_ptr->mutex_ptr ); }
+    if ( play_ptr->quit ) {
+      vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+      break;
+    }
+    double clock_s    = play_ptr->clock_s;
+    _slot_t* slot_ptr = &play_ptr->slots_ptr[( play_ptr->ring_first + play_ptr->ring_count ) % play_ptr->n_slots];
+    vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+
+    // The slot after the ring isn't visible to the presenting thread, so it's filled without the lock.
+    bool skip = !play_ptr->opts.no_drop && i + 1 < n_frames && _due_s( play_ptr, i + 1 ) <= clock_s && !vol_geom_is_keyframe( play_ptr->info_ptr, i );
+    vol_play_stats_t stats = ( vol_play_stats_t ){ 0 };
+    VOL_TRACE_BEGIN( "vol_play_video" );
+    _pair_video( play_ptr, i, skip, slot_ptr, &stats );
+    VOL_TRACE_END( "vol_play_video" );
+    bool read_ok = true;
+    if ( !skip ) {
+      VOL_TRACE_BEGIN( "vol_play_geom" );
+      read_ok             = _read_geom( play_ptr, i, slot_ptr );
+      slot_ptr->frame_idx = i;
+      VOL_TRACE_END( "vol_play_geom" );
+    }
+
+    vol_thread_mutex_lock( play_ptr->mutex_ptr );
+    play_ptr->stats.n_video_decoded += stats.n_video_decoded;
+    play_ptr->stats.n_video_repeated += stats.n_video_repeated;
+    play_ptr->stats.n_video_extra += stats.n_video_extra;
+    if ( !read_ok ) {
+      _set_error( play_ptr, "reading geometry frame %" PRIu32 "%s%s", i, play_ptr->stream_ptr ? ": " : "",
+        play_ptr->stream_ptr ? vol_stream_error( play_ptr->stream_ptr ) : "" );
+      vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+      break;
+    }
+    if ( skip ) {
+      play_ptr->stats.n_skipped++;
+    } else {
+      play_ptr->ring_count++;
+    }
+    vol_thread_cond_broadcast( play_ptr->cond_ptr );
+    vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+  }
+  vol_thread_mutex_lock( play_ptr->mutex_ptr );
+  play_ptr->worker_done = true;
+  vol_thread_cond_broadcast( play_ptr->cond_ptr );
+  vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+}
+
+vol_play_t* vol_play_open( const char* hdr_filename, const char* seq_filename, const char* video_filename, const vol_play_opts_t* opts_ptr ) {
+  if ( !seq_filename ) { return NULL; }
+  vol_play_t* play_ptr = calloc( 1, sizeof( vol_play_t ) );
+  if ( !play_ptr ) { return NULL; }
+  if ( opts_ptr ) { play_ptr->opts = *opts_ptr; }
+  vol_play_opts_t* o_ptr = &play_ptr->opts;
+  if ( 0 == o_ptr->n_ahead ) { o_ptr->n_ahead = 8; }
+  if ( o_ptr->n_ahead > VOL_PLAY_MAX_AHEAD ) { o_ptr->n_ahead = VOL_PLAY_MAX_AHEAD; }
+  play_ptr->key_idx       = VOL_PLAY_NO_FRAME;
+  play_ptr->waiting_idx   = VOL_PLAY_NO_FRAME;
+  play_ptr->last_late_idx = VOL_PLAY_NO_FRAME;
+
+  if ( strstr( seq_filename, "://" ) ) {
+    play_ptr->stream_ptr = vol_stream_open( seq_filename, o_ptr->stream_opts_ptr );
+    if ( !play_ptr->stream_ptr ) { goto vpo_fail; }
+    play_ptr->info_ptr = vol_stream_get_info( play_ptr->stream_ptr );
+  } else {
+    size_t len             = strlen( seq_filename );
+    play_ptr->seq_filename = malloc( len + 1 );
+    if ( !play_ptr->seq_filename ) { goto vpo_fail; }
+    memcpy( play_ptr->seq_filename, seq_filename, len + 1 );
+    play_ptr->opened_info = hdr_filename ? vol_geom_create_file_info( hdr_filename, seq_filename, &play_ptr->info, true ) :
+                                           vol_geom_create_file_info_from_file( seq_filename, &play_ptr->info );
+    if ( !play_ptr->opened_info ) { goto vpo_fail; }
+    play_ptr->info_ptr = &play_ptr->info;
+  }
+  const vol_geom_info_t* info_ptr = play_ptr->info_ptr;
+  if ( 0 == info_ptr->hdr.frame_count ) { goto vpo_fail; }
+  play_ptr->fps = o_ptr->fps > 0.0 ? o_ptr->fps : info_ptr->hdr.fps > 0.0f ? (double)info_ptr->hdr.fps : 30.0; // Versions before 1.3 have no fps.
+
+  if ( video_filename ) {
+    if ( !vol_av_open( video_filename, &play_ptr->video ) ) { goto vpo_fail; }
+    play_ptr->has_video = true;
+    vol_av_dimensions( &play_ptr->video, &play_ptr->video_w, &play_ptr->video_h );
+  }
+
+  play_ptr->n_slots      = o_ptr->n_ahead + 1; // One more for the frame being shown.
+  play_ptr->slots_ptr    = calloc( play_ptr->n_slots, sizeof( _slot_t ) );
+  play_ptr->key_blob_ptr = malloc( info_ptr->biggest_frame_blob_sz );
+  play_ptr->mutex_ptr    = vol_thread_mutex_create();
+  play_ptr->cond_ptr     = vol_thread_cond_create();
+  if ( !play_ptr->slots_ptr || !play_ptr->key_blob_ptr || !play_ptr->mutex_ptr || !play_ptr->cond_ptr ) { goto vpo_fail; }
+  for ( uint32_t i = 0; i < play_ptr->n_slots; i++ ) {
+    _slot_t* slot_ptr  = &play_ptr->slots_ptr[i];
+    slot_ptr->blob_ptr = malloc( 2 * info_ptr->biggest_frame_blob_sz ); // A frame, plus its keyframe's indices and UVs, which are smaller than a frame.
+    if ( !slot_ptr->blob_ptr ) { goto vpo_fail; }
+    if ( play_ptr->has_video ) {
+      slot_ptr->pixels_ptr = malloc( (size_t)play_ptr->video_w * play_ptr->video_h * 3 );
+      if ( !slot_ptr->pixels_ptr ) { goto vpo_fail; }
+    }
+  }
+
+  play_ptr->thread_ptr = vol_thread_create( _worker_fn, play_ptr );
+  if ( !play_ptr->thread_ptr ) { goto vpo_fail; }
+  return play_ptr;
+
+vpo_fail:
+  vol_play_close( play_ptr );
+  return NULL;
+}
+
+const vol_geom_info_t* vol_play_get_info( const vol_play_t* play_ptr ) {
+  if ( !play_ptr ) { return NULL; }
+  return play_ptr->info_ptr;
+}
+
+double vol_play_fps( const vol_play_t* play_ptr ) {
+  if ( !play_ptr ) { return 0.0; }
+  return play_ptr->fps;
+}
+
+bool vol_play_preroll( vol_play_t* play_ptr ) {
+  if ( !play_ptr ) { return false; }
+  vol_thread_mutex_lock( play_ptr->mutex_ptr );
+  while ( !play_ptr->failed && !play_ptr->worker_done && play_ptr->ring_count < play_ptr->opts.n_ahead ) {
+    vol_thread_cond_wait( play_ptr->cond_ptr, play_ptr->mutex_ptr );
+  }
+  bool failed = play_ptr->failed;
+  vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+  return !failed;
+}
+
+bool vol_play_update( vol_play_t* play_ptr, double time_s, vol_play_frame_t* frame_ptr ) {
+  if ( !play_ptr || !frame_ptr ) { return false; }
+  uint32_t n_frames = play_ptr->info_ptr->hdr.frame_count;
+  double due_f      = floor( ( time_s > 0.0 ? time_s : 0.0 ) * play_ptr->fps );
+  uint32_t due_idx  = due_f < (double)n_frames ? (uint32_t)due_f : n_frames; // n_frames once the last frame's time has passed.
+  frame_ptr->is_new = false;
+
+  vol_thread_mutex_lock( play_ptr->mutex_ptr );
+  if ( play_ptr->failed ) {
+    vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+    return false;
+  }
+  if ( time_s > play_ptr->clock_s ) { play_ptr->clock_s = time_s; }
+  uint32_t shown_idx = play_ptr->has_shown ? play_ptr->slots_ptr[play_ptr->ring_first].frame_idx : VOL_PLAY_NO_FRAME;
+  if ( due_idx >= n_frames && ( !play_ptr->opts.no_drop || n_frames - 1 == shown_idx ) ) {
+    vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+    return false;
+  }
+
+  // Pick the latest ready frame that is due, or with no_drop, the next frame in turn if it's due.
+  uint32_t first_i = play_ptr->has_shown ? 1 : 0;
+  uint32_t pick_i  = VOL_PLAY_NO_FRAME;
+  for ( uint32_t i = first_i; i < play_ptr->ring_count; i++ ) {
+    if ( play_ptr->slots_ptr[( play_ptr->ring_first + i ) % play_ptr->n_slots].frame_idx > due_idx ) { break; }
+    pick_i = i;
+    if ( play_ptr->opts.no_drop ) { break; }
+  }
+  if ( VOL_PLAY_NO_FRAME != pick_i ) {
+    play_ptr->stats.n_dropped += pick_i - first_i; // Ready frames before the pick were never shown.
+    play_ptr->ring_first = ( play_ptr->ring_first + pick_i ) % play_ptr->n_slots;
+    play_ptr->ring_count -= pick_i;
+    play_ptr->has_shown = true;
+    shown_idx           = play_ptr->slots_ptr[play_ptr->ring_first].frame_idx;
+    play_ptr->stats.n_shown++;
+    frame_ptr->is_new = true;
+    if ( VOL_PLAY_NO_FRAME != play_ptr->waiting_idx && shown_idx >= play_ptr->waiting_idx ) {
+      double late_s = time_s - _due_s( play_ptr, play_ptr->waiting_idx );
+      if ( late_s > play_ptr->stats.max_late_s ) { play_ptr->stats.max_late_s = late_s; }
+      play_ptr->waiting_idx = VOL_PLAY_NO_FRAME;
+    }
+    vol_thread_cond_broadcast( play_ptr->cond_ptr ); // Slots were freed.
+  }
+
+  // The frame that should be showing now. With no_drop frames are shown in turn, so it's the one after the shown frame.
+  uint32_t want_idx = play_ptr->opts.no_drop && VOL_PLAY_NO_FRAME != shown_idx && shown_idx + 1 < due_idx ? shown_idx + 1 : due_idx;
+  if ( want_idx < n_frames && ( VOL_PLAY_NO_FRAME == shown_idx || shown_idx < want_idx ) ) {
+    if ( VOL_PLAY_NO_FRAME == play_ptr->waiting_idx ) { play_ptr->waiting_idx = want_idx; }
+    if ( VOL_PLAY_NO_FRAME == play_ptr->last_late_idx || want_idx > play_ptr->last_late_idx ) {
+      play_ptr->stats.n_late++;
+      play_ptr->last_late_idx = want_idx;
+    }
+  }
+
+  if ( play_ptr->has_shown ) {
+    const _slot_t* slot_ptr = &play_ptr->slots_ptr[play_ptr->ring_first];
+    frame_ptr->frame_idx    = slot_ptr->frame_idx;
+    frame_ptr->due_s        = _due_s( play_ptr, slot_ptr->frame_idx );
+    frame_ptr->geom         = slot_ptr->geom;
+    frame_ptr->pixels_ptr   = slot_ptr->pixels_ptr;
+    frame_ptr->w            = play_ptr->video_w;
+    frame_ptr->h            = play_ptr->video_h;
+    frame_ptr->video_pts_s  = play_ptr->has_video ? slot_ptr->video_pts_s : -1.0;
+  } else {
+    *frame_ptr = ( vol_play_frame_t ){ .video_pts_s = -1.0 };
+  }
+  vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+  return true;
+}
+
+vol_play_stats_t vol_play_get_stats( vol_play_t* play_ptr ) {
+  vol_play_stats_t stats = ( vol_play_stats_t ){ 0 };
+  if ( !play_ptr || !play_ptr->mutex_ptr ) { return stats; }
+  vol_thread_mutex_lock( play_ptr->mutex_ptr );
+  stats = play_ptr->stats;
+  vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+  return stats;
+}
+
+const char* vol_play_error( vol_play_t* play_ptr ) {
+  if ( !play_ptr || !play_ptr->mutex_ptr ) { return ""; }
+  vol_thread_mutex_lock( play_ptr->mutex_ptr );
+  bool failed = play_ptr->failed; // The worker stops after an error, so the string doesn't change after this is set.
+  vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+  return failed ? play_ptr->error_str : "";
+}
+
+void vol_play_close( vol_play_t* play_ptr ) {
+  if ( !play_ptr ) { return; }
+  if ( play_ptr->thread_ptr ) {
+    vol_thread_mutex_lock( play_ptr->mutex_ptr );
+    play_ptr->quit = true;
+    vol_thread_cond_broadcast( play_ptr->cond_ptr );
+    vol_thread_mutex_unlock( play_ptr->mutex_ptr );
+    vol_thread_join( play_ptr->thread_ptr );
+  }
+  if ( play_ptr->slots_ptr ) {
+    for ( uint32_t i = 0; i < play_ptr->n_slots; i++ ) {
+      free( play_ptr->slots_ptr[i].blob_ptr );
+      free( play_ptr->slots_ptr[i].pixels_ptr );
+    }
+    free( play_ptr->slots_ptr );
+  }
+  free( play_ptr->key_blob_ptr );
+  if ( play_ptr->cond_ptr ) { vol_thread_cond_free( play_ptr->cond_ptr ); }
+  if ( play_ptr->mutex_ptr ) { vol_thread_mutex_free( play_ptr->mutex_ptr ); }
+  if ( play_ptr->has_video ) { vol_av_close( &play_ptr->video ); }
+  if ( play_ptr->opened_info ) { vol_geom_free_file_info( &play_ptr->info ); }
+  vol_stream_close( play_ptr->stream_ptr );
+  free( play_ptr->seq_filename );
+  free( play_ptr );
+}
@@ -0,0 +1,140 @@
+/**  @file vol_play.h
+ * Volograms Playback Scheduler API
+ *
+ * vol_play  | Play a vologram in time, with its texture video, decoding ahead on a worker thread.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Maps a playback clock to geometry frames and video frames. Geometry frame `i` is shown from `i / fps` seconds, until the next one is due.
+ * The frame rate is the header's `fps` (v1.3), or 30 for older volograms, unless overridden.
+ * Each geometry frame is paired with the video frame whose presentation timestamp (PTS) is nearest, rather than by counting video frames,
+ * so a texture video with dropped or duplicated frames still lines up, and a bad one is reported in the statistics.
+ *
+ * A worker thread reads geometry frames and decodes video frames ahead of the clock, into a small ring of ready frames.
+ * For playback containers on a web server (http:// URLs) the geometry is read with vol_stream, which also prefetches the chunks.
+ * `vol_play_update()` never waits for the worker. If the due frame isn't ready yet the previous frame stays up, and the frame counts as late.
+ *
+ * To hold the frame rate when decoding can't keep up, frames are dropped:
+ * - The presenting thread skips over ready frames whose time has passed, to the latest one that is due.
+ * - The worker doesn't read the geometry of frames whose time has already passed, and only decodes, without converting to RGB, their video frames.
+ *   Keyframes are always read, as the frames after them need their indices and UVs.
+ *
+ * Every frame given out is complete: a frame that isn't a keyframe comes with its keyframe's indices and UVs.
+ *
+ * Limitations
+ * -----------
+ * - Playback runs forward once, from the first frame. Looping or seeking means closing and opening again. vol_av has no seeking.
+ * - Audio is not played, and there is no audio clock. The caller's clock is the master.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_PLAY_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_PLAY_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include "vol_geom.h"
+#include "vol_stream.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Upper limit on `vol_play_opts_t.n_ahead`. */
+#define VOL_PLAY_MAX_AHEAD 120
+
+/** Opaque player. Create with `vol_play_open()`. */
+typedef struct vol_play_t vol_play_t;
+
+/** Options for `vol_play_open()`. Zeroed fields take the defaults given. */
+typedef struct vol_play_opts_t {
+  double fps;                               // Overrides the header's frame rate, e.g. to play faster or slower. Default 0 means use the header's.
+  uint32_t n_ahead;                         // Frames decoded ahead of the one shown. Default 8. Each takes the biggest frame's size, plus an RGB video frame.
+  bool no_drop;                             // Show every frame in turn, however late, so playback falls behind the clock instead. For comparison.
+  const vol_stream_opts_t* stream_opts_ptr; // Options for http:// URLs. May be NULL for the defaults.
+} vol_play_opts_t;
+
+/** A frame given out by `vol_play_update()`. Pointers are valid until the next update, or until the player is closed. */
+typedef struct vol_play_frame_t {
+  /// Geometry frame index. Its keyframe's indices and UVs are in `geom`, at `indices_offset` and `uvs_offset`.
+  uint32_t frame_idx;
+  /// When this frame is due, in seconds of the playback clock.
+  double due_s;
+  /// As from `vol_geom_read_frame()`, but complete for every frame, not just keyframes. Points into the player's own copy of the frame.
+  vol_geom_frame_data_t geom;
+  /// Tightly-packed 3-channel RGB image of `w` * `h` pixels, or NULL if there is no video.
+  const uint8_t* pixels_ptr;
+  int w, h;
+  /// Presentation time of the video frame, or -1.0 if there is no video.
+  double video_pts_s;
+  /// True if this is a different frame from the one given out by the previous update. False when the same frame is still showing.
+  bool is_new;
+} vol_play_frame_t;
+
+/** Counters since the player was opened. */
+typedef struct vol_play_stats_t {
+  uint32_t n_shown;          // Frames given out by `vol_play_update()`.
+  uint32_t n_dropped;        // Frames the worker had ready, that were skipped over because a later frame was due.
+  uint32_t n_skipped;        // Frames the worker didn't read at all, because their time had passed.
+  uint32_t n_late;           // Frames that weren't ready when due, so the previous frame stayed up longer.
+  double max_late_s;         // Longest time from a frame being due until that frame, or a later one, was shown.
+  uint32_t n_video_decoded;  // Video frames out of the decoder.
+  uint32_t n_video_repeated; // Geometry frames with no video frame of their own, which reused the previous video frame. e.g. dropped video frames.
+  uint32_t n_video_extra;    // Video frames that lost out to another for the same geometry frame. e.g. duplicated video frames.
+} vol_play_stats_t;
+
+/** Open a vologram and its texture video, and start decoding ahead.
+ * @param hdr_filename   Header file of an older multi-file vologram, or NULL.
+ * @param seq_filename   Sequence file of a multi-file vologram, or a single-file .vols or .volp, or an http:// URL of a playback container. Must not be NULL.
+ * @param video_filename Texture video file or URL, or NULL for volograms without a texture video.
+ * @param opts_ptr       May be NULL for the defaults.
+ * @returns              NULL on failure to open either file, or on out of memory.
+ */
+VOL_PLAY_EXPORT vol_play_t* vol_play_open( const char* hdr_filename, const char* seq_filename, const char* video_filename, const vol_play_opts_t* opts_ptr );
+
+/** @returns The vologram's header and directory. Don't read frames with it, as the worker thread does that. */
+VOL_PLAY_EXPORT const vol_geom_info_t* vol_play_get_info( const vol_play_t* play_ptr );
+
+/** @returns The frame rate playback is scheduled at. */
+VOL_PLAY_EXPORT double vol_play_fps( const vol_play_t* play_ptr );
+
+/** Wait until the worker has `n_ahead` frames ready, or has read the last frame. Call before starting the clock, so playback starts with a full ring.
+ * @returns False on a read error.
+ */
+VOL_PLAY_EXPORT bool vol_play_preroll( vol_play_t* play_ptr );
+
+/** Get the frame to show at a point on the playback clock. Never waits for the worker.
+ * @param time_s    Seconds since playback started, from the caller's clock. Should not go backwards.
+ * @param frame_ptr Receives the frame to show. Must not be NULL.
+ * @returns         False after the last frame's time has passed, or on a read error. See `vol_play_error()` to tell them apart.
+ *                  Until the first frame is ready `frame_ptr->is_new` is false and its pointers are NULL.
+ */
+VOL_PLAY_EXPORT bool vol_play_update( vol_play_t* play_ptr, double time_s, vol_play_frame_t* frame_ptr );
+
+/** @returns The counters since the player was opened. */
+VOL_PLAY_EXPORT vol_play_stats_t vol_play_get_stats( vol_play_t* play_ptr );
+
+/** @returns A description of a read error on the worker thread, or an empty string. */
+VOL_PLAY_EXPORT const char* vol_play_error( vol_play_t* play_ptr );
+
+/** Stop the worker thread, close the files, and free the player. */
+VOL_PLAY_EXPORT void vol_play_close( vol_play_t* play_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
@@ -0,0 +1,372 @@
+/** @file vol_stream.c
+ * Volograms HTTP Streaming API
+ *
+ * vol_stream | Play playback containers from a web server, with prefetching.
+ * ---------- | ---------------------
+ * Version    | 0.1
+ * Authors    | See matching header file.
+ * Copyright  | 2026, Volograms (http://volograms.com/)
+ * Language   | C99
+ * Files      | 2
+ * Licence    | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_stream.h"
+#include "vol_http.h"
+#include "vol_thread.h"
+#include "vol_trace.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Bytes fetched when opening. Enough for the header and the index of most volograms, so opening is usually one request. */
+#define VOL_STREAM_HEAD_SZ ( 64 * 1024 )
+#define VOL_STREAM_ERROR_MAX_LEN 256
+#define VOL_STREAM_NO_FRAME UINT32_MAX
+
+typedef enum _chunk_state_t {
+  _CHUNK_EMPTY = 0,
+  _CHUNK_QUEUED,   // In the prefetch queue.
+  _CHUNK_FETCHING, // A request is in flight, on a worker or the reading thread. Its size is counted in the cache already.
+  _CHUNK_READY     // `data_ptr` holds the chunk.
+} _chunk_state_t;
+
+/** One per frame. Chunk sizes are in the frame's playback index entry. */
+typedef struct _chunk_t {
+  uint8_t* data_ptr;
+  uint64_t last_used; // Stream's use clock when this frame was last read, or wanted as an upcoming frame. Lowest is evicted first.
+  _chunk_state_t state;
+} _chunk_t;
+
+typedef struct _worker_t {
+  vol_stream_t* stream_ptr;
+  vol_http_t* http_ptr;
+  vol_thread_t* thread_ptr;
+} _worker_t;
+
+struct vol_stream_t {
+  vol_geom_info_t info;
+  vol_stream_opts_t opts;
+  vol_http_t* http_ptr; // The reading thread's connection.
+  uint8_t* head_ptr;    // The first bytes of the file, only while opening.
+  uint32_t head_sz;
+
+  // Everything below is shared with the workers, and guarded by the mutex.
+  vol_thread_mutex_t* mutex_ptr;
+  vol_thread_cond_t* cond_ptr; // Broadcast when frames are queued, when a fetch finishes, and when closing.
+  _chunk_t* chunks_ptr;
+  uint32_t* queue_ptr; // Ring of frame indices to prefetch, nearest first. Capacity is the frame count.
+  uint32_t queue_first, queue_count;
+  uint64_t cached_sz;  // Bytes of ready and fetching chunks.
+  uint64_t use_clock;
+  uint32_t pinned_idx; // The frame being decoded, which must not be evicted, or VOL_STREAM_NO_FRAME.
+  uint32_t prev_read_idx;
+  vol_stream_stats_t stats;
+  bool quit;
+
+  _worker_t workers[VOL_STREAM_MAX_THREADS];
+  uint32_t n_workers;
+  char error_str[VOL_STREAM_ERROR_MAX_LEN];
+};
+
+static void _set_error( vol_stream_t* stream_ptr, const char* message_str, ... ) {
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vsnprintf( stream_ptr->error_str, VOL_STREAM_ERROR_MAX_LEN, message_str, arg_ptr );
+  va_end( arg_ptr );
+}
+
+/** Fetch a frame's chunk into a new allocation. Called without the lock held. */
+static bool _fetch_chunk( vol_stream_t* stream_ptr, vol_http_t* http_ptr, uint32_t frame_idx, uint8_t** data_ptr_ptr ) {
+  const vol_geom_playback_entry_t* entry_ptr = &stream_ptr->info.playback_entries_ptr[frame_idx];
+  uint8_t* data_ptr                          = malloc( entry_ptr->stored_sz );
+  if ( !data_ptr ) { return false; }
+  uint32_t got_sz = 0;
+  VOL_TRACE_BEGIN( "vol_stream_fetch" );
+  bool fetch_ok = vol_http_get_range( http_ptr, entry_ptr->offset, entry_ptr->stored_sz, data_ptr, &got_sz, NULL ) && got_sz == entry_ptr->stored_sz;
+  VOL_TRACE_END( "vol_stream_fetch" );
+  if ( !fetch_ok ) {
+    free( data_ptr );
+    return false;
+  }
+  *data_ptr_ptr = data_ptr;
+  return true;
+}
+
+/** Drop least recently used chunks until `sz` more bytes fit in the cache. Only chunks used before `max_last_used` are dropped.
+ * Called with the lock held. O(frames) per chunk dropped, which is small next to a request.
+ * @returns False if the chunks that may be dropped don't free enough room.
+ */
+static bool _evict_for( vol_stream_t* stream_ptr, uint64_t sz, uint64_t max_last_used ) {
+  while ( stream_ptr->cached_sz + sz > stream_ptr->opts.cache_sz ) {
+    uint32_t lru_idx = VOL_STREAM_NO_FRAME;
+    for ( uint32_t i = 0; i < stream_ptr->info.hdr.frame_count; i++ ) {
+      const _chunk_t* chunk_ptr = &stream_ptr->chunks_ptr[i];
+      if ( _CHUNK_READY != chunk_ptr->state || i == stream_ptr->pinned_idx || chunk_ptr->last_used >= max_last_used ) { continue; }
+      if ( VOL_STREAM_NO_FRAME == lru_idx || chunk_ptr->last_used < stream_ptr->chunks_ptr[lru_idx].last_used ) { lru_idx = i; }
+    }
+    if ( VOL_STREAM_NO_FRAME == lru_idx ) { return false; }
+    _chunk_t* chunk_ptr = &stream_ptr->chunks_ptr[lru_idx];
+    free( chunk_ptr->data_ptr );
+    chunk_ptr->data_ptr = NULL;
+    chunk_ptr->state    = _CHUNK_EMPTY;
+    stream_ptr->cached_sz -= stream_ptr->info.playback_entries_ptr[lru_idx].stored_sz;
+    stream_ptr->stats.n_evictions++;
+  }
+  return true;
+}
+
+/** Take the frames following `frame_idx` as upcoming, and queue those that aren't cached or in flight. Called with the lock held. */
+static void _queue_upcoming( vol_stream_t* stream_ptr, uint32_t frame_idx ) {
+  uint32_t n_frames = stream_ptr->info.hdr.frame_count;
+  bool in_order     = frame_idx == stream_ptr->prev_read_idx || frame_idx == ( stream_ptr->prev_read_idx + 1 ) % n_frames;
+  if ( !in_order && VOL_STREAM_NO_FRAME != stream_ptr->prev_read_idx ) { // A seek, so the queued frames aren't upcoming any more.
+    for ( uint32_t i = 0; i < stream_ptr->queue_count; i++ ) {
+      _chunk_t* chunk_ptr = &stream_ptr->chunks_ptr[stream_ptr->queue_ptr[( stream_ptr->queue_first + i ) % n_frames]];
+      if ( _CHUNK_QUEUED == chunk_ptr->state ) { chunk_ptr->state = _CHUNK_EMPTY; }
+    }
+    stream_ptr->queue_count = 0;
+  }
+  stream_ptr->prev_read_idx = frame_idx;
+
+  // Upcoming frames count as used now, nearest last, so that eviction drops played frames first, then the furthest upcoming frames.
+  uint32_t n_upcoming = stream_ptr->opts.prefetch_frames < n_frames ? stream_ptr->opts.prefetch_frames : n_frames - 1;
+  uint64_t base_clock = stream_ptr->use_clock;
+  stream_ptr->use_clock += n_upcoming;
+  for ( uint32_t i = 1; i <= n_upcoming; i++ ) {
+    uint32_t upcoming_idx = ( frame_idx + i ) % n_frames;
+    _chunk_t* chunk_ptr   = &stream_ptr->chunks_ptr[upcoming_idx];
+    chunk_ptr->last_used  = base_clock + n_upcoming - i + 1;
+    if ( _CHUNK_EMPTY != chunk_ptr->state || stream_ptr->queue_count >= n_frames ) { continue; }
+    chunk_ptr->state = _CHUNK_QUEUED;
+    stream_ptr->queue_ptr[( stream_ptr->queue_first + stream_ptr->queue_count ) % n_frames] = upcoming_idx;
+    stream_ptr->queue_count++;
+  }
+  vol_thread_cond_broadcast( stream_ptr->cond_ptr );
+}
+
+static void _worker_fn( void* user_ptr ) {
+  _worker_t* worker_ptr    = (_worker_t*)user_ptr;
+  vol_stream_t* stream_ptr = worker_ptr->stream_ptr;
+  uint32_t n_frames        = stream_ptr->info.hdr.frame_count;
+  vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+  for ( ;; ) {
+    while ( !stream_ptr->quit && 0 == stream_ptr->queue_count ) { vol_thread_cond_wait( stream_ptr->cond_ptr, stream_ptr->mutex_ptr ); }
+    if ( stream_ptr->quit ) { break; }
+    uint32_t frame_idx      = stream_ptr->queue_ptr[stream_ptr->queue_first];
+    stream_ptr->queue_first = ( stream_ptr->queue_first + 1 ) % n_frames;
+    stream_ptr->queue_count--;
+    _chunk_t* chunk_ptr = &stream_ptr->chunks_ptr[frame_idx];
+    if ( _CHUNK_QUEUED != chunk_ptr->state ) { continue; } // The reading thread got to it first.
+
+    // A prefetch may only displace chunks that are wanted less, i.e. played frames and further upcoming ones, or a small cache would drop the next frames.
+    uint32_t sz = stream_ptr->info.playback_entries_ptr[frame_idx].stored_sz;
+    if ( !_evict_for( stream_ptr, sz, chunk_ptr->last_used ) ) {
+      chunk_ptr->state = _CHUNK_EMPTY;
+      continue;
+    }
+    chunk_ptr->state = _CHUNK_FETCHING;
+    stream_ptr->cached_sz += sz;
+    vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+
+    uint8_t* data_ptr = NULL;
+    bool fetch_ok     = _fetch_chunk( stream_ptr, worker_ptr->http_ptr, frame_idx, &data_ptr );
+
+    vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+    if ( fetch_ok ) {
+      chunk_ptr->data_ptr = data_ptr;
+      chunk_ptr->state    = _CHUNK_READY;
+      stream_ptr->stats.bytes_fetched += sz;
+    } else {
+      chunk_ptr->state = _CHUNK_EMPTY; // The reading thread will fetch it itself, and report the error.
+      stream_ptr->cached_sz -= sz;
+      stream_ptr->stats.n_failed++;
+    }
+    vol_thread_cond_broadcast( stream_ptr->cond_ptr );
+  }
+  vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+}
+
+/** `vol_geom_io_t` reader for opening: serves the header and index from the first bytes of the file, or fetches anything beyond them. */
+static bool _head_io_read( void* user_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr ) {
+  vol_stream_t* stream_ptr = (vol_stream_t*)user_ptr;
+  if ( offset + sz <= stream_ptr->head_sz ) {
+    memcpy( dst_ptr, &stream_ptr->head_ptr[offset], sz );
+    return true;
+  }
+  uint32_t got_sz = 0;
+  return vol_http_get_range( stream_ptr->http_ptr, offset, sz, dst_ptr, &got_sz, NULL ) && got_sz == sz;
+}
+
+/** `vol_geom_io_t` reader for decoding: serves the pinned frame's chunk from the cache. */
+static bool _chunk_io_read( void* user_ptr, uint64_t offset, uint32_t sz, uint8_t* dst_ptr ) {
+  vol_stream_t* stream_ptr                   = (vol_stream_t*)user_ptr;
+  const vol_geom_playback_entry_t* entry_ptr = &stream_ptr->info.playback_entries_ptr[stream_ptr->pinned_idx];
+  if ( offset != entry_ptr->offset || sz > entry_ptr->stored_sz ) { return false; }
+  memcpy( dst_ptr, stream_ptr->chunks_ptr[stream_ptr->pinned_idx].data_ptr, sz );
+  return true;
+}
+
+vol_stream_t* vol_stream_open( const char* url, const vol_stream_opts_t* opts_ptr ) {
+  if ( !url ) { return NULL; }
+  vol_stream_t* stream_ptr = calloc( 1, sizeof( vol_stream_t ) );
+  if ( !stream_ptr ) { return NULL; }
+  stream_ptr->pinned_idx    = VOL_STREAM_NO_FRAME;
+  stream_ptr->prev_read_idx = VOL_STREAM_NO_FRAME;
+  if ( opts_ptr ) { stream_ptr->opts = *opts_ptr; }
+  vol_stream_opts_t* o_ptr = &stream_ptr->opts;
+  if ( 0 == o_ptr->n_threads ) { o_ptr->n_threads = 4; }
+  if ( o_ptr->n_threads > VOL_STREAM_MAX_THREADS ) { o_ptr->n_threads = VOL_STREAM_MAX_THREADS; }
+  if ( 0 == o_ptr->prefetch_frames ) { o_ptr->prefetch_frames = 30; }
+  if ( 0 == o_ptr->cache_sz ) { o_ptr->cache_sz = 64 * 1024 * 1024; }
+  if ( 0 == o_ptr->timeout_ms ) { o_ptr->timeout_ms = 5000; }
+
+  stream_ptr->http_ptr = vol_http_open( url, o_ptr->timeout_ms );
+  stream_ptr->head_ptr = malloc( VOL_STREAM_HEAD_SZ );
+  if ( !stream_ptr->http_ptr || !stream_ptr->head_ptr ) { goto vso_fail; }
+  uint64_t total_sz = 0;
+  VOL_TRACE_BEGIN( "vol_stream_open" );
+  bool head_ok = vol_http_get_range( stream_ptr->http_ptr, 0, VOL_STREAM_HEAD_SZ, stream_ptr->head_ptr, &stream_ptr->head_sz, &total_sz );
+  if ( head_ok ) {
+    vol_geom_io_t io = ( vol_geom_io_t ){ .read_fn = _head_io_read, .total_sz = total_sz, .user_ptr = stream_ptr };
+    head_ok          = vol_geom_create_file_info_from_io( &io, &stream_ptr->info );
+  }
+  VOL_TRACE_END( "vol_stream_open" );
+  free( stream_ptr->head_ptr );
+  stream_ptr->head_ptr = NULL;
+  if ( !head_ok ) { goto vso_fail; }
+
+  uint32_t n_frames      = stream_ptr->info.hdr.frame_count;
+  stream_ptr->chunks_ptr = calloc( n_frames, sizeof( _chunk_t ) );
+  stream_ptr->queue_ptr  = calloc( n_frames, sizeof( uint32_t ) );
+  stream_ptr->mutex_ptr  = vol_thread_mutex_create();
+  stream_ptr->cond_ptr   = vol_thread_cond_create();
+  if ( !stream_ptr->chunks_ptr || !stream_ptr->queue_ptr || !stream_ptr->mutex_ptr || !stream_ptr->cond_ptr ) { goto vso_fail; }
+
+  for ( uint32_t i = 0; !o_ptr->no_prefetch && i < o_ptr->n_threads; i++ ) { // Prefetching with fewer workers than asked for still works.
+    _worker_t* worker_ptr  = &stream_ptr->workers[stream_ptr->n_workers];
+    worker_ptr->stream_ptr = stream_ptr;
+    worker_ptr->http_ptr   = vol_http_open( url, o_ptr->timeout_ms );
+    if ( !worker_ptr->http_ptr ) { break; }
+    worker_ptr->thread_ptr = vol_thread_create( _worker_fn, worker_ptr );
+    if ( !worker_ptr->thread_ptr ) {
+      vol_http_close( worker_ptr->http_ptr );
+      break;
+    }
+    stream_ptr->n_workers++;
+  }
+  return stream_ptr;
+
+vso_fail:
+  vol_stream_close( stream_ptr );
+  return NULL;
+}
+
+const vol_geom_info_t* vol_stream_get_info( const vol_stream_t* stream_ptr ) {
+  if ( !stream_ptr ) { return NULL; }
+  return &stream_ptr->info;
+}
+
+bool vol_stream_read_frame( vol_stream_t* stream_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr ) {
+  if ( !stream_ptr || !frame_data_ptr ) { return false; }
+  stream_ptr->error_str[0] = '\0';
+  if ( frame_idx >= stream_ptr->info.hdr.frame_count ) {
+    _set_error( stream_ptr, "frame %" PRIu32 " is out of range, as there are %" PRIu32 " frames", frame_idx, stream_ptr->info.hdr.frame_count );
+    return false;
+  }
+  _chunk_t* chunk_ptr = &stream_ptr->chunks_ptr[frame_idx];
+  uint32_t sz         = stream_ptr->info.playback_entries_ptr[frame_idx].stored_sz;
+
+  vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+  stream_ptr->stats.n_reads++;
+  if ( stream_ptr->n_workers > 0 ) { _queue_upcoming( stream_ptr, frame_idx ); }
+  chunk_ptr->last_used = ++stream_ptr->use_clock; // Newest of all, as it's needed now.
+  if ( _CHUNK_FETCHING == chunk_ptr->state ) {
+    stream_ptr->stats.n_waits++;
+    VOL_TRACE_BEGIN( "vol_stream_wait" );
+    while ( _CHUNK_FETCHING == chunk_ptr->state ) { vol_thread_cond_wait( stream_ptr->cond_ptr, stream_ptr->mutex_ptr ); }
+    VOL_TRACE_END( "vol_stream_wait" );
+  } else if ( _CHUNK_READY == chunk_ptr->state ) {
+    stream_ptr->stats.n_hits++;
+  }
+  if ( _CHUNK_READY != chunk_ptr->state ) { // Not requested yet, still queued, or the prefetch failed. A worker skips it once it isn't queued.
+    stream_ptr->stats.n_misses++;
+    _evict_for( stream_ptr, sz, UINT64_MAX ); // The frame being read is needed whether or not it fits.
+    chunk_ptr->state = _CHUNK_FETCHING;
+    stream_ptr->cached_sz += sz;
+    vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+
+    uint8_t* data_ptr = NULL;
+    bool fetch_ok     = _fetch_chunk( stream_ptr, stream_ptr->http_ptr, frame_idx, &data_ptr );
+
+    vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+    if ( fetch_ok ) {
+      chunk_ptr->data_ptr = data_ptr;
+      chunk_ptr->state    = _CHUNK_READY;
+      stream_ptr->stats.bytes_fetched += sz;
+    } else {
+      chunk_ptr->state = _CHUNK_EMPTY;
+      stream_ptr->cached_sz -= sz;
+      stream_ptr->stats.n_failed++;
+      _set_error( stream_ptr, "fetching frame %" PRIu32 ": %s", frame_idx, vol_http_error( stream_ptr->http_ptr ) );
+    }
+    vol_thread_cond_broadcast( stream_ptr->cond_ptr );
+    if ( !fetch_ok ) {
+      vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+      return false;
+    }
+  }
+  stream_ptr->pinned_idx = frame_idx;
+  vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+
+  // The pinned chunk can't be evicted, so it can be decoded without the lock.
+  vol_geom_io_t io = ( vol_geom_io_t ){ .read_fn = _chunk_io_read, .total_sz = 0, .user_ptr = stream_ptr };
+  bool decode_ok   = vol_geom_read_frame_from_io( &io, &stream_ptr->info, frame_idx, frame_data_ptr );
+  if ( !decode_ok ) { _set_error( stream_ptr, "frame %" PRIu32 " is corrupt", frame_idx ); }
+
+  vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+  stream_ptr->pinned_idx = VOL_STREAM_NO_FRAME;
+  vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+  return decode_ok;
+}
+
+vol_stream_stats_t vol_stream_get_stats( vol_stream_t* stream_ptr ) {
+  vol_stream_stats_t stats = ( vol_stream_stats_t ){ 0 };
+  if ( !stream_ptr || !stream_ptr->mutex_ptr ) { return stats; }
+  vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+  stats = stream_ptr->stats;
+  vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+  return stats;
+}
+
+const char* vol_stream_error( const vol_stream_t* stream_ptr ) {
+  if ( !stream_ptr ) { return ""; }
+  return stream_ptr->error_str;
+}
+
+void vol_stream_close( vol_stream_t* stream_ptr ) {
+  if ( !stream_ptr ) { return; }
+  if ( stream_ptr->n_workers > 0 ) {
+    vol_thread_mutex_lock( stream_ptr->mutex_ptr );
+    stream_ptr->quit = true;
+    vol_thread_cond_broadcast( stream_ptr->cond_ptr );
+    vol_thread_mutex_unlock( stream_ptr->mutex_ptr );
+    for ( uint32_t i = 0; i < stream_ptr->n_workers; i++ ) {
+      vol_thread_join( stream_ptr->workers[i].thread_ptr );
+      vol_http_close( stream_ptr->workers[i].http_ptr );
+    }
+  }
+  if ( stream_ptr->chunks_ptr ) {
+    for ( uint32_t i = 0; i < stream_ptr->info.hdr.frame_count; i++ ) { free( stream_ptr->chunks_ptr[i].data_ptr ); }
+    free( stream_ptr->chunks_ptr );
+  }
+  free( stream_ptr->queue_ptr );
+  free( stream_ptr->head_ptr );
+  if ( stream_ptr->cond_ptr ) { vol_thread_cond_free( stream_ptr->cond_ptr ); }
+  if ( stream_ptr->mutex_ptr ) { vol_thread_mutex_free( stream_ptr->mutex_ptr ); }
+  if ( stream_ptr->info.playback_entries_ptr ) { vol_geom_free_file_info( &stream_ptr->info ); }
+  vol_http_close( stream_ptr->http_ptr );
+  free( stream_ptr );
+}
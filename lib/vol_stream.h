@@ -0,0 +1,105 @@
+/**  @file vol_stream.h
+ * Volograms HTTP Streaming API
+ *
+ * vol_stream | Play playback containers from a web server, with prefetching.
+ * ---------- | ---------------------
+ * Version    | 0.1
+ * Authors    | Anton Gerdelan     <anton@volograms.com>
+ * Copyright  | 2026, Volograms (http://volograms.com/)
+ * Language   | C99
+ * Files      | 2
+ * Licence    | The MIT License. See LICENSE.md for details.
+ *
+ * Reads a playback container (see "Playback containers" in vol_geom.h, and the streamvols tool) in place on a web server or CDN, with HTTP range requests.
+ * Opening fetches the first 64 kB, which holds the header and, for up to about 2,700 frames, the whole frame index. Nothing else is downloaded up front.
+ *
+ * Each frame is its own chunk in a playback container, so a frame is one range request.
+ * When a frame is read, worker threads start fetching the following frames, each worker on its own connection, so that several requests are in flight.
+ * Fetched chunks are kept in a cache with a byte budget. When it is full the least recently used chunk is dropped,
+ * so played frames are dropped before prefetched ones, and seeking back a short way is free.
+ * A frame that isn't cached when it is read is fetched on the reading thread, which is a stall.
+ *
+ * Frames are decoded with `vol_geom_read_frame_from_io()`, so the returned frame data is the same as from `vol_geom_read_frame()`,
+ * and the same rules for keyframes apply. Texture videos alongside the container can be opened by URL with `vol_av_open()`.
+ *
+ * A stream must only be read from one thread at a time. The worker threads are internal.
+ *
+ * Only http:// URLs are supported. See vol_http.h.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_STREAM_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_STREAM_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include "vol_geom.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Upper limit on `vol_stream_opts_t.n_threads`. */
+#define VOL_STREAM_MAX_THREADS 32
+
+/** Opaque stream. Create with `vol_stream_open()`. */
+typedef struct vol_stream_t vol_stream_t;
+
+/** Options for `vol_stream_open()`. Zeroed fields take the defaults given. */
+typedef struct vol_stream_opts_t {
+  uint32_t n_threads;       // Prefetching threads, each with its own connection. Default 4.
+  uint32_t prefetch_frames; // How many frames after each read frame to fetch ahead. Default 30, i.e. one second at 30 fps.
+  uint64_t cache_sz;        // Budget in bytes for cached chunks. Default 64 MB. Should hold at least `prefetch_frames` + 1 of the largest chunks.
+  uint32_t timeout_ms;      // Fail a request after this long without data from the server. Default 5000.
+  bool no_prefetch;         // Fetch each frame only when read, on the reading thread. For comparison with prefetching.
+} vol_stream_opts_t;
+
+/** Counters since the stream was opened. */
+typedef struct vol_stream_stats_t {
+  uint32_t n_reads;       // Calls to `vol_stream_read_frame()`.
+  uint32_t n_hits;        // Reads whose chunk was already cached.
+  uint32_t n_waits;       // Reads whose chunk was being prefetched, so the reader waited for it to arrive.
+  uint32_t n_misses;      // Reads whose chunk hadn't been fetched yet, so it was fetched on the reading thread.
+  uint32_t n_evictions;   // Chunks dropped from the cache to make room.
+  uint32_t n_failed;      // Failed requests, including prefetches.
+  uint64_t bytes_fetched; // Bytes of chunks received, not counting the header and index.
+} vol_stream_stats_t;
+
+/** Open a playback container by URL, and read its header and index.
+ * @param url      e.g. "http://cdn.example.com/counter.volp". Must not be NULL.
+ * @param opts_ptr May be NULL for the defaults.
+ * @returns        NULL if the server can't be reached, the file isn't a playback container, or on out of memory.
+ */
+VOL_STREAM_EXPORT vol_stream_t* vol_stream_open( const char* url, const vol_stream_opts_t* opts_ptr );
+
+/** @returns The vologram's header and index. The frame data blob in it is overwritten by each `vol_stream_read_frame()`. */
+VOL_STREAM_EXPORT const vol_geom_info_t* vol_stream_get_info( const vol_stream_t* stream_ptr );
+
+/** Read a frame, from the cache if it's there, and prefetch the frames after it. After the last frame, prefetching wraps around to the first.
+ * @param frame_data_ptr As for `vol_geom_read_frame()`. Pointers into the stream's info, valid until the next read.
+ * @returns             False on a failed request or a corrupt chunk. See `vol_stream_error()` for the reason.
+ */
+VOL_STREAM_EXPORT bool vol_stream_read_frame( vol_stream_t* stream_ptr, uint32_t frame_idx, vol_geom_frame_data_t* frame_data_ptr );
+
+/** @returns The counters since the stream was opened. */
+VOL_STREAM_EXPORT vol_stream_stats_t vol_stream_get_stats( vol_stream_t* stream_ptr );
+
+/** @returns A description of the last error on the reading thread, or an empty string. */
+VOL_STREAM_EXPORT const char* vol_stream_error( const vol_stream_t* stream_ptr );
+
+/** Stop the worker threads, close the connections, and free the stream. */
+VOL_STREAM_EXPORT void vol_stream_close( vol_stream_t* stream_ptr );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
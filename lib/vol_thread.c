@@ -0,0 +1,268 @@
+/** @file vol_thread.c
+ * Volograms Threading Helpers
+ *
+ * vol_thread | Minimal portable threading for Volograms tools.
+ * ---------- | ---------------------
+ * Version    | 0.3
+ * Authors    | See matching header file.
+ * Copyright  | 2026, Volograms (http://volograms.com/)
+ * Language   | C99
+ * Files      | 2
+ * Licence    | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_thread.h"
+#include "vol_trace.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>   // nanosleep
+#include <unistd.h> // sysconf
+#endif
+
+/** Work for one thread of a parallel-for. */
+typedef struct _range_t {
+  vol_thread_for_fn_t fn;
+  void* user_ptr;
+  uint32_t first_idx, end_idx, thread_idx;
+} _range_t;
+
+static void _run_range( _range_t* range_ptr ) {
+  VOL_TRACE_BEGIN( "vol_thread_range" );
+  for ( uint32_t i = range_ptr->first_idx; i < range_ptr->end_idx; i++ ) { range_ptr->fn( i, range_ptr->thread_idx, range_ptr->user_ptr ); }
+  VOL_TRACE_END( "vol_thread_range" );
+}
+
+#ifdef _WIN32
+static DWORD WINAPI _thread_main( LPVOID arg_ptr ) {
+  _run_range( (_range_t*)arg_ptr );
+  return 0;
+}
+#else
+static void* _thread_main( void* arg_ptr ) {
+  _run_range( (_range_t*)arg_ptr );
+  return NULL;
+}
+#endif
+
+uint32_t vol_thread_hardware_concurrency( void ) {
+#ifdef _WIN32
+  SYSTEM_INFO sys_info;
+  GetSystemInfo( &sys_info );
+  return sys_info.dwNumberOfProcessors > 0 ? (uint32_t)sys_info.dwNumberOfProcessors : 1;
+#else
+  long n = sysconf( _SC_NPROCESSORS_ONLN );
+  return n > 0 ? (uint32_t)n : 1;
+#endif
+}
+
+bool vol_thread_parallel_for( uint32_t n_items, uint32_t n_threads, vol_thread_for_fn_t fn, void* user_ptr ) {
+  if ( !fn ) { return false; }
+  if ( 0 == n_items ) { return true; }
+  if ( 0 == n_threads ) { n_threads = vol_thread_hardware_concurrency(); }
+  if ( n_threads > VOL_THREAD_MAX_THREADS ) { n_threads = VOL_THREAD_MAX_THREADS; }
+  if ( n_threads > n_items ) { n_threads = n_items; }
+
+  _range_t ranges[VOL_THREAD_MAX_THREADS];
+  bool started[VOL_THREAD_MAX_THREADS] = { false };
+#ifdef _WIN32
+  HANDLE threads[VOL_THREAD_MAX_THREADS];
+#else
+  pthread_t threads[VOL_THREAD_MAX_THREADS];
+#endif
+
+  for ( uint32_t t = 0; t < n_threads; t++ ) {
+    ranges[t] = ( _range_t ){
+      .fn         = fn,
+      .user_ptr   = user_ptr,
+      .first_idx  = (uint32_t)( (uint64_t)n_items * t / n_threads ),
+      .end_idx    = (uint32_t)( (uint64_t)n_items * ( t + 1 ) / n_threads ),
+      .thread_idx = t //
+    };
+  }
+  // Range 0 runs on this thread, after the others have been started.
+  for ( uint32_t t = 1; t < n_threads; t++ ) {
+#ifdef _WIN32
+    threads[t] = CreateThread( NULL, 0, _thread_main, &ranges[t], 0, NULL );
+    started[t] = NULL != threads[t];
+#else
+    started[t] = 0 == pthread_create( &threads[t], NULL, _thread_main, &ranges[t] );
+#endif
+  }
+  _run_range( &ranges[0] );
+  for ( uint32_t t = 1; t < n_threads; t++ ) {
+    if ( !started[t] ) {
+      _run_range( &ranges[t] );
+      continue;
+    }
+#ifdef _WIN32
+    WaitForSingleObject( threads[t], INFINITE );
+    CloseHandle( threads[t] );
+#else
+    pthread_join( threads[t], NULL );
+#endif
+  }
+  return true;
+}
+
+struct vol_thread_t {
+  void ( *fn )( void* user_ptr );
+  void* user_ptr;
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  pthread_t handle;
+#endif
+};
+
+struct vol_thread_mutex_t {
+#ifdef _WIN32
+  CRITICAL_SECTION cs;
+#else
+  pthread_mutex_t mutex;
+#endif
+};
+
+struct vol_thread_cond_t {
+#ifdef _WIN32
+  CONDITION_VARIABLE cv;
+#else
+  pthread_cond_t cond;
+#endif
+};
+
+#ifdef _WIN32
+static DWORD WINAPI _thread_fn_main( LPVOID arg_ptr ) {
+  vol_thread_t* thread_ptr = (vol_thread_t*)arg_ptr;
+  thread_ptr->fn( thread_ptr->user_ptr );
+  return 0;
+}
+#else
+static void* _thread_fn_main( void* arg_ptr ) {
+  vol_thread_t* thread_ptr = (vol_thread_t*)arg_ptr;
+  thread_ptr->fn( thread_ptr->user_ptr );
+  return NULL;
+}
+#endif
+
+vol_thread_t* vol_thread_create( void ( *fn )( void* user_ptr ), void* user_ptr ) {
+  if ( !fn ) { return NULL; }
+  vol_thread_t* thread_ptr = malloc( sizeof( vol_thread_t ) );
+  if ( !thread_ptr ) { return NULL; }
+  thread_ptr->fn       = fn;
+  thread_ptr->user_ptr = user_ptr;
+#ifdef _WIN32
+  thread_ptr->handle = CreateThread( NULL, 0, _thread_fn_main, thread_ptr, 0, NULL );
+  bool started       = NULL != thread_ptr->handle;
+#else
+  bool started = 0 == pthread_create( &thread_ptr->handle, NULL, _thread_fn_main, thread_ptr );
+#endif
+  if ( !started ) {
+    free( thread_ptr );
+    return NULL;
+  }
+  return thread_ptr;
+}
+
+void vol_thread_join( vol_thread_t* thread_ptr ) {
+  if ( !thread_ptr ) { return; }
+#ifdef _WIN32
+  WaitForSingleObject( thread_ptr->handle, INFINITE );
+  CloseHandle( thread_ptr->handle );
+#else
+  pthread_join( thread_ptr->handle, NULL );
+#endif
+  free( thread_ptr );
+}
+
+vol_thread_mutex_t* vol_thread_mutex_create( void ) {
+  vol_thread_mutex_t* mutex_ptr = malloc( sizeof( vol_thread_mutex_t ) );
+  if ( !mutex_ptr ) { return NULL; }
+#ifdef _WIN32
+  InitializeCriticalSection( &mutex_ptr->cs );
+#else
+  if ( 0 != pthread_mutex_init( &mutex_ptr->mutex, NULL ) ) {
+    free( mutex_ptr );
+    return NULL;
+  }
+#endif
+  return mutex_ptr;
+}
+
+void vol_thread_mutex_free( vol_thread_mutex_t* mutex_ptr ) {
+  if ( !mutex_ptr ) { return; }
+#ifdef _WIN32
+  DeleteCriticalSection( &mutex_ptr->cs );
+#else
+  pthread_mutex_destroy( &mutex_ptr->mutex );
+#endif
+  free( mutex_ptr );
+}
+
+void vol_thread_mutex_lock( vol_thread_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  EnterCriticalSection( &mutex_ptr->cs );
+#else
+  pthread_mutex_lock( &mutex_ptr->mutex );
+#endif
+}
+
+void vol_thread_mutex_unlock( vol_thread_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  LeaveCriticalSection( &mutex_ptr->cs );
+#else
+  pthread_mutex_unlock( &mutex_ptr->mutex );
+#endif
+}
+
+vol_thread_cond_t* vol_thread_cond_create( void ) {
+  vol_thread_cond_t* cond_ptr = malloc( sizeof( vol_thread_cond_t ) );
+  if ( !cond_ptr ) { return NULL; }
+#ifdef _WIN32
+  InitializeConditionVariable( &cond_ptr->cv );
+#else
+  if ( 0 != pthread_cond_init( &cond_ptr->cond, NULL ) ) {
+    free( cond_ptr );
+    return NULL;
+  }
+#endif
+  return cond_ptr;
+}
+
+void vol_thread_cond_free( vol_thread_cond_t* cond_ptr ) {
+  if ( !cond_ptr ) { return; }
+#ifndef _WIN32
+  pthread_cond_destroy( &cond_ptr->cond ); // Windows condition variables don't need freeing.
+#endif
+  free( cond_ptr );
+}
+
+void vol_thread_cond_wait( vol_thread_cond_t* cond_ptr, vol_thread_mutex_t* mutex_ptr ) {
+#ifdef _WIN32
+  SleepConditionVariableCS( &cond_ptr->cv, &mutex_ptr->cs, INFINITE );
+#else
+  pthread_cond_wait( &cond_ptr->cond, &mutex_ptr->mutex );
+#endif
+}
+
+void vol_thread_cond_broadcast( vol_thread_cond_t* cond_ptr ) {
+#ifdef _WIN32
+  WakeAllConditionVariable( &cond_ptr->cv );
+#else
+  pthread_cond_broadcast( &cond_ptr->cond );
+#endif
+}
+
+void vol_thread_sleep_ms( uint32_t ms ) {
+#ifdef _WIN32
+  Sleep( ms );
+#else
+  struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)( ms % 1000 ) * 1000000L };
+  while ( 0 != nanosleep( &ts, &ts ) ) {} // Resumes the remaining time if interrupted by a signal.
+#endif
+}
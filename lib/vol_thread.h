@@ -0,0 +1,101 @@
+/**  @file vol_thread.h
+ * Volograms Threading Helpers
+ *
+ * vol_thread | Minimal portable threading for Volograms tools.
+ * ---------- | ---------------------
+ * Version    | 0.3
+ * Authors    | Anton Gerdelan     <anton@volograms.com>
+ * Copyright  | 2026, Volograms (http://volograms.com/)
+ * Language   | C99
+ * Files      | 2
+ * Licence    | The MIT License. See LICENSE.md for details.
+ *
+ * A thin wrapper over POSIX threads and Win32 threads, so that the libraries and tools can split work across cores without a dependency.
+ * On POSIX systems link with `-pthread`.
+ *
+ * For longer-lived workers, such as prefetchers and servers, there are also threads, mutexes, and condition variables.
+ * These are opaque and heap-allocated, so that headers including this one don't pull in platform headers.
+ *
+ * History
+ * -------
+ * - 0.3   (2026/10/18) - Threads, mutexes, condition variables, and sleep.
+ * - 0.2   (2026/10/18) - Trace marker around each thread's range of items. See vol_trace.h.
+ * - 0.1   (2026/10/18) - First version. Parallel-for over a range of items.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_THREAD_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_THREAD_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Upper limit on the number of threads that `vol_thread_parallel_for()` will start. */
+#define VOL_THREAD_MAX_THREADS 64
+
+/** Function called once per item by `vol_thread_parallel_for()`.
+ * @param item_idx   Index of the item to process, from 0 to n_items - 1.
+ * @param thread_idx Index of the worker calling the function, from 0 to n_threads - 1. Useful for indexing per-thread scratch memory.
+ * @param user_ptr   The pointer given to `vol_thread_parallel_for()`.
+ */
+typedef void ( *vol_thread_for_fn_t )( uint32_t item_idx, uint32_t thread_idx, void* user_ptr );
+
+/** @returns The number of logical processors available, or 1 if that can't be determined. */
+VOL_THREAD_EXPORT uint32_t vol_thread_hardware_concurrency( void );
+
+/** Call `fn` for every item in [0, n_items), split into contiguous ranges across up to `n_threads` threads.
+ * The calling thread processes the first range, and the function returns once every item has been processed.
+ * @param n_threads If 0 then `vol_thread_hardware_concurrency()` is used. Clamped to `n_items` and `VOL_THREAD_MAX_THREADS`.
+ * @returns         False if `fn` is NULL. If a thread can't be started its range is processed on the calling thread instead.
+ */
+VOL_THREAD_EXPORT bool vol_thread_parallel_for( uint32_t n_items, uint32_t n_threads, vol_thread_for_fn_t fn, void* user_ptr );
+
+/** Opaque thread handle. Create with `vol_thread_create()`. */
+typedef struct vol_thread_t vol_thread_t;
+/** Opaque mutex. Create with `vol_thread_mutex_create()`. */
+typedef struct vol_thread_mutex_t vol_thread_mutex_t;
+/** Opaque condition variable. Create with `vol_thread_cond_create()`. */
+typedef struct vol_thread_cond_t vol_thread_cond_t;
+
+/** Start a thread running `fn( user_ptr )`.
+ * @returns NULL if the thread couldn't be started. Otherwise the thread must be passed to `vol_thread_join()` exactly once.
+ */
+VOL_THREAD_EXPORT vol_thread_t* vol_thread_create( void ( *fn )( void* user_ptr ), void* user_ptr );
+
+/** Wait for a thread to return from its function, then free the handle. */
+VOL_THREAD_EXPORT void vol_thread_join( vol_thread_t* thread_ptr );
+
+/** @returns A new unlocked mutex, or NULL on failure. Free with `vol_thread_mutex_free()`. */
+VOL_THREAD_EXPORT vol_thread_mutex_t* vol_thread_mutex_create( void );
+VOL_THREAD_EXPORT void vol_thread_mutex_free( vol_thread_mutex_t* mutex_ptr );
+VOL_THREAD_EXPORT void vol_thread_mutex_lock( vol_thread_mutex_t* mutex_ptr );
+VOL_THREAD_EXPORT void vol_thread_mutex_unlock( vol_thread_mutex_t* mutex_ptr );
+
+/** @returns A new condition variable, or NULL on failure. Free with `vol_thread_cond_free()`. */
+VOL_THREAD_EXPORT vol_thread_cond_t* vol_thread_cond_create( void );
+VOL_THREAD_EXPORT void vol_thread_cond_free( vol_thread_cond_t* cond_ptr );
+
+/** Unlock `mutex_ptr`, which must be locked by the caller, and sleep until woken, then lock it again.
+ * Wake-ups can be spurious, so always wait in a loop that checks the condition.
+ */
+VOL_THREAD_EXPORT void vol_thread_cond_wait( vol_thread_cond_t* cond_ptr, vol_thread_mutex_t* mutex_ptr );
+
+/** Wake every thread waiting on `cond_ptr`. */
+VOL_THREAD_EXPORT void vol_thread_cond_broadcast( vol_thread_cond_t* cond_ptr );
+
+/** Sleep the calling thread for at least `ms` milliseconds. */
+VOL_THREAD_EXPORT void vol_thread_sleep_ms( uint32_t ms );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
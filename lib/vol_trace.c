@@ -0,0 +1,178 @@
+/** @file vol_trace.c
+ * Volograms Tracing API
+ *
+ * vol_trace | Scoped timing markers with Chrome trace export.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | See matching header file.
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ */
+
+#include "vol_trace.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <windows.h>
+#endif
+
+#if defined( _MSC_VER )
+#define VOL_TRACE_TLS __declspec( thread )
+#define _atomic_fetch_inc( ptr ) ( (uint32_t)InterlockedIncrement( (volatile LONG*)( ptr ) ) - 1 )
+#else
+#define VOL_TRACE_TLS __thread
+#define _atomic_fetch_inc( ptr ) __atomic_fetch_add( ( ptr ), 1, __ATOMIC_RELAXED )
+#endif
+
+// Chunks start small, as short-lived worker threads only record a few events, then double in size up to a limit.
+#define VOL_TRACE_FIRST_CHUNK_EVENTS 256
+#define VOL_TRACE_MAX_CHUNK_EVENTS 65536
+
+typedef struct _trace_event_t {
+  const char* name_str;
+  uint64_t ts_ns;
+  char phase;
+} _trace_event_t;
+
+typedef struct _trace_chunk_t {
+  struct _trace_chunk_t* next_ptr;
+  uint32_t n_events, capacity;
+  _trace_event_t events[];
+} _trace_chunk_t;
+
+/** One per thread. Only the owning thread writes to it. */
+typedef struct _trace_buffer_t {
+  _trace_chunk_t* first_chunk_ptr;
+  _trace_chunk_t* last_chunk_ptr;
+  const char* thread_name_str;
+  uint32_t n_dropped; // Events lost to failed allocations.
+} _trace_buffer_t;
+
+static _trace_buffer_t* _buffers[VOL_TRACE_MAX_THREADS];
+static uint32_t _n_buffers_claimed; // May pass VOL_TRACE_MAX_THREADS, in which case those threads aren't traced.
+static uint32_t _generation = 1;    // Bumped by vol_trace_clear() so threads know to claim a new buffer.
+
+static VOL_TRACE_TLS _trace_buffer_t* _tls_buffer_ptr;
+static VOL_TRACE_TLS uint32_t _tls_generation;
+
+static uint64_t _time_ns( void ) {
+#ifdef _WIN32
+  static LARGE_INTEGER freq;
+  LARGE_INTEGER count;
+  if ( 0 == freq.QuadPart ) { QueryPerformanceFrequency( &freq ); }
+  QueryPerformanceCounter( &count );
+  return (uint64_t)( (double)count.QuadPart * 1e9 / (double)freq.QuadPart );
+#else
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/** @returns The calling thread's buffer, claiming a slot for it the first time. NULL if the thread can't be traced. */
+static _trace_buffer_t* _thread_buffer( void ) {
+  if ( _tls_generation == _generation ) { return _tls_buffer_ptr; }
+  _tls_generation = _generation;
+  _tls_buffer_ptr = NULL;
+  uint32_t slot   = _atomic_fetch_inc( &_n_buffers_claimed );
+  if ( slot >= VOL_TRACE_MAX_THREADS ) { return NULL; }
+  _trace_buffer_t* buffer_ptr = calloc( 1, sizeof( _trace_buffer_t ) );
+  _buffers[slot]              = buffer_ptr;
+  _tls_buffer_ptr             = buffer_ptr;
+  return buffer_ptr;
+}
+
+void vol_trace_event( const char* name_str, char phase ) {
+  uint64_t ts_ns              = _time_ns(); // Before any allocation, so a BEGIN isn't late.
+  _trace_buffer_t* buffer_ptr = _thread_buffer();
+  if ( !buffer_ptr ) { return; }
+  _trace_chunk_t* chunk_ptr = buffer_ptr->last_chunk_ptr;
+  if ( !chunk_ptr || chunk_ptr->n_events >= chunk_ptr->capacity ) {
+    uint32_t capacity = VOL_TRACE_FIRST_CHUNK_EVENTS;
+    if ( chunk_ptr ) { capacity = chunk_ptr->capacity < VOL_TRACE_MAX_CHUNK_EVENTS ? chunk_ptr->capacity * 2 : VOL_TRACE_MAX_CHUNK_EVENTS; }
+    _trace_chunk_t* new_chunk_ptr = malloc( sizeof( _trace_chunk_t ) + capacity * sizeof( _trace_event_t ) );
+    if ( !new_chunk_ptr ) {
+      buffer_ptr->n_dropped++;
+      return;
+    }
+    new_chunk_ptr->next_ptr = NULL;
+    new_chunk_ptr->n_events = 0;
+    new_chunk_ptr->capacity = capacity;
+    if ( chunk_ptr ) {
+      chunk_ptr->next_ptr = new_chunk_ptr;
+    } else {
+      buffer_ptr->first_chunk_ptr = new_chunk_ptr;
+    }
+    buffer_ptr->last_chunk_ptr = chunk_ptr = new_chunk_ptr;
+  }
+  chunk_ptr->events[chunk_ptr->n_events++] = ( _trace_event_t ){ .name_str = name_str, .ts_ns = ts_ns, .phase = phase };
+}
+
+void vol_trace_set_thread_name( const char* name_str ) {
+  _trace_buffer_t* buffer_ptr = _thread_buffer();
+  if ( buffer_ptr ) { buffer_ptr->thread_name_str = name_str; }
+}
+
+bool vol_trace_write_json( const char* filename ) {
+  if ( !filename ) { return false; }
+  FILE* f_ptr = fopen( filename, "w" );
+  if ( !f_ptr ) { return false; }
+
+  uint32_t n_buffers = _n_buffers_claimed < VOL_TRACE_MAX_THREADS ? _n_buffers_claimed : VOL_TRACE_MAX_THREADS;
+  uint64_t start_ns  = UINT64_MAX; // Timestamps are written relative to the first event.
+  for ( uint32_t i = 0; i < n_buffers; i++ ) {
+    if ( !_buffers[i] || !_buffers[i]->first_chunk_ptr || 0 == _buffers[i]->first_chunk_ptr->n_events ) { continue; }
+    if ( _buffers[i]->first_chunk_ptr->events[0].ts_ns < start_ns ) { start_ns = _buffers[i]->first_chunk_ptr->events[0].ts_ns; }
+  }
+
+  bool first = true;
+  fprintf( f_ptr, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+  for ( uint32_t i = 0; i < n_buffers; i++ ) {
+    const _trace_buffer_t* buffer_ptr = _buffers[i];
+    if ( !buffer_ptr ) { continue; }
+    uint32_t tid = i + 1;
+    if ( buffer_ptr->thread_name_str ) {
+      fprintf( f_ptr, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", first ? "" : ",", tid,
+        buffer_ptr->thread_name_str );
+      first = false;
+    }
+    for ( const _trace_chunk_t* chunk_ptr = buffer_ptr->first_chunk_ptr; chunk_ptr; chunk_ptr = chunk_ptr->next_ptr ) {
+      for ( uint32_t j = 0; j < chunk_ptr->n_events; j++ ) {
+        const _trace_event_t* e_ptr = &chunk_ptr->events[j];
+        fprintf( f_ptr, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", first ? "" : ",", e_ptr->name_str, e_ptr->phase,
+          (double)( e_ptr->ts_ns - start_ns ) / 1000.0, tid );
+        first = false;
+      }
+    }
+    if ( buffer_ptr->n_dropped > 0 ) {
+      fprintf( f_ptr, "%s\n{\"name\":\"dropped %u events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":1,\"tid\":%u}", first ? "" : ",",
+        buffer_ptr->n_dropped, tid );
+      first = false;
+    }
+  }
+  fprintf( f_ptr, "\n]}\n" );
+  return 0 == fclose( f_ptr );
+}
+
+void vol_trace_clear( void ) {
+  uint32_t n_buffers = _n_buffers_claimed < VOL_TRACE_MAX_THREADS ? _n_buffers_claimed : VOL_TRACE_MAX_THREADS;
+  for ( uint32_t i = 0; i < n_buffers; i++ ) {
+    if ( !_buffers[i] ) { continue; }
+    _trace_chunk_t* chunk_ptr = _buffers[i]->first_chunk_ptr;
+    while ( chunk_ptr ) {
+      _trace_chunk_t* next_ptr = chunk_ptr->next_ptr;
+      free( chunk_ptr );
+      chunk_ptr = next_ptr;
+    }
+    free( _buffers[i] );
+    _buffers[i] = NULL;
+  }
+  _n_buffers_claimed = 0;
+  _generation++;
+}
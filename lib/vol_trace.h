@@ -0,0 +1,74 @@
+/**  @file vol_trace.h
+ * Volograms Tracing API
+ *
+ * vol_trace | Scoped timing markers with Chrome trace export.
+ * --------- | ---------------------
+ * Version   | 0.1
+ * Authors   | Anton Gerdelan     <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 2
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * The libraries and tools mark the start and end of their expensive sections with `VOL_TRACE_BEGIN()` and `VOL_TRACE_END()`.
+ * These compile to nothing unless `VOL_TRACE` is defined, e.g. `make -e VOL_TRACE=1 vol2obj`, so there is no cost in normal builds.
+ *
+ * When enabled, each thread appends events to its own buffer, so recording takes no locks. Buffers grow in chunks as required, starting small so that short-lived worker threads cost little.
+ * Call `vol_trace_write_json()` once traced threads have finished, to write Chrome's trace event format.
+ * Open the file in https://ui.perfetto.dev or chrome://tracing to see each thread's sections on a timeline.
+ *
+ * Names must be string literals, or otherwise outlive the trace, as only the pointer is stored.
+ * Each END must match the most recent BEGIN on its thread.
+ *
+ * History
+ * -------
+ * - 0.1   (2026/10/18) - First version.
+ */
+
+#pragma once
+
+#ifdef _WIN32
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_TRACE_EXPORT __declspec( dllexport )
+#else
+/** If building a library with Visual Studio, we need to explicitly 'export' symbols. This generates a .lib file to go with the .dll dynamic library file. */
+#define VOL_TRACE_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* CPP */
+
+#include <stdbool.h>
+
+#ifdef VOL_TRACE
+#define VOL_TRACE_BEGIN( name_str ) vol_trace_event( ( name_str ), 'B' )
+#define VOL_TRACE_END( name_str ) vol_trace_event( ( name_str ), 'E' )
+#else
+#define VOL_TRACE_BEGIN( name_str ) ( (void)0 )
+#define VOL_TRACE_END( name_str ) ( (void)0 )
+#endif
+
+/** Upper limit on the number of different threads that can record events between calls to `vol_trace_clear()`. Later threads are not traced. */
+#define VOL_TRACE_MAX_THREADS 4096
+
+/** Record an event on the calling thread. Use the macros above rather than calling this directly.
+ * @param phase 'B' to begin a section or 'E' to end it.
+ */
+VOL_TRACE_EXPORT void vol_trace_event( const char* name_str, char phase );
+
+/** Name the calling thread in the trace, e.g. "vol_thread worker 2". The name must outlive the trace. */
+VOL_TRACE_EXPORT void vol_trace_set_thread_name( const char* name_str );
+
+/** Write every thread's events to a JSON file in Chrome's trace event format.
+ * Not thread-safe: call only when no other thread is recording events, e.g. after worker threads have been joined.
+ * @returns False if the file could not be written.
+ */
+VOL_TRACE_EXPORT bool vol_trace_write_json( const char* filename );
+
+/** Discard all events and free trace memory. Not thread-safe, as for `vol_trace_write_json()`. */
+VOL_TRACE_EXPORT void vol_trace_clear( void );
+
+#ifdef __cplusplus
+}
+#endif /* CPP */
@@ -0,0 +1,749 @@
+/** @file volograms.c
+ * Volograms Python extension module.
+ *
+ * volograms | Read vologram frames and texture videos from Python, as zero-copy NumPy-compatible arrays.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99, CPython 3.8+ C API
+ * Files     | 1
+ * Licence   | The MIT License. Note that dependencies have separate licences.
+ *           | See LICENSE.md for details.
+ *
+ * Wraps vol_geom and vol_av. A frame's vertices, normals, UVs, indices and texture are memoryviews over the memory vol_geom read the frame into,
+ * with the shape and type of the data, so `numpy.asarray( frame.vertices )` is a (n, 3) float32 array without copying anything.
+ * Each frame is read into its own memory, which lives as long as any view of it, so frames can be kept and compared.
+ * A texture video's `pixels` is a (h, w, 3) uint8 view of vol_av's RGB frame, which the next `read()` overwrites: copy it to keep a frame.
+ *
+ * Frames that aren't keyframes have no indices or UVs of their own. Their `indices` and `uvs` are their keyframe's, which is read along with them
+ * if needed, and kept as the frame's `keyframe`.
+ *
+ * `Sequence.read_range()` reads a batch of frames with the GIL released, so several Python threads can read frames at once,
+ * e.g. with a ThreadPoolExecutor over ranges of frames, or over many volograms.
+ * Reads don't share any memory, so this is safe on one Sequence as well as several. A Video can only be read by one thread at a time.
+ *
+ * Usage Instructions
+ * ------------------
+ *     import numpy, volograms
+ *     with volograms.Sequence( "counter.vols" ) as seq:
+ *       for frame in seq.read_range( 0, len( seq ) ):
+ *         vertices = numpy.asarray( frame.vertices ) # (n, 3) float32, a view of the frame's memory.
+ *         triangles = numpy.asarray( frame.indices ) # (n_triangles, 3) uint16, or uint32 for meshes of 65535 or more vertices.
+ *     video = volograms.Video( "texture_1024_h264.mp4" )
+ *     while video.read():
+ *       image = numpy.array( video.pixels ) # (h, w, 3) uint8, copied, as the next read() overwrites the view.
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make pyvols` builds `volograms` with the extension suffix of `python3`, e.g. volograms.cpython-311-x86_64-linux-gnu.so, in the repository's root.
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "vol_av.h"   // Volograms' texture video decoding library.
+#include "vol_geom.h" // Volograms' .vols file parsing library.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*************************************************************************************************************************************************
+ * Arrays
+ *************************************************************************************************************************************************/
+
+/** Exports a block of another object's memory through the buffer protocol, with a shape and type. Properties wrap these in memoryviews. */
+typedef struct _array_t {
+  PyObject_HEAD
+  PyObject* owner_ptr; // Keeps the memory alive.
+  void* data_ptr;
+  Py_ssize_t shape[3];
+  int ndim;
+  Py_ssize_t itemsize;
+  const char* format;         // struct module format, e.g. "f" for float32.
+  Py_ssize_t* n_exports_ptr;  // If not NULL, counts views of memory that the owner must not free while viewed.
+} _array_t;
+
+static int _array_getbuffer( PyObject* self_ptr, Py_buffer* view_ptr, int flags ) {
+  _array_t* array_ptr = (_array_t*)self_ptr;
+  if ( ( flags & PyBUF_WRITABLE ) == PyBUF_WRITABLE ) {
+    PyErr_SetString( PyExc_BufferError, "vologram arrays are read-only" );
+    return -1;
+  }
+  Py_ssize_t len = array_ptr->itemsize;
+  for ( int i = 0; i < array_ptr->ndim; i++ ) { len *= array_ptr->shape[i]; }
+  view_ptr->obj        = self_ptr;
+  view_ptr->buf        = array_ptr->data_ptr;
+  view_ptr->len        = len;
+  view_ptr->readonly   = 1;
+  view_ptr->itemsize   = array_ptr->itemsize;
+  view_ptr->format     = ( flags & PyBUF_FORMAT ) ? (char*)array_ptr->format : NULL;
+  view_ptr->ndim       = array_ptr->ndim;
+  view_ptr->shape      = ( flags & PyBUF_ND ) ? array_ptr->shape : NULL;
+  view_ptr->strides    = NULL; // C-contiguous.
+  view_ptr->suboffsets = NULL;
+  view_ptr->internal   = NULL;
+  if ( array_ptr->n_exports_ptr ) { ( *array_ptr->n_exports_ptr )++; }
+  Py_INCREF( self_ptr );
+  return 0;
+}
+
+static void _array_releasebuffer( PyObject* self_ptr, Py_buffer* view_ptr ) {
+  (void)view_ptr;
+  _array_t* array_ptr = (_array_t*)self_ptr;
+  if ( array_ptr->n_exports_ptr ) { ( *array_ptr->n_exports_ptr )--; }
+}
+
+static void _array_dealloc( PyObject* self_ptr ) {
+  Py_XDECREF( ( (_array_t*)self_ptr )->owner_ptr );
+  Py_TYPE( self_ptr )->tp_free( self_ptr );
+}
+
+static PyBufferProcs _array_buffer_procs = { _array_getbuffer, _array_releasebuffer };
+
+static PyTypeObject _array_type = {
+  PyVarObject_HEAD_INIT( NULL, 0 )
+  .tp_name        = "volograms._Array",
+  .tp_basicsize   = sizeof( _array_t ),
+  .tp_dealloc     = _array_dealloc,
+  .tp_as_buffer   = &_array_buffer_procs,
+  .tp_flags       = Py_TPFLAGS_DEFAULT,
+  .tp_doc         = "Memory owned by a vologram frame or video, for memoryview() and numpy.asarray().",
+};
+
+/** @returns A new memoryview of `rows` * `cols` elements of `owner_ptr`'s memory, or of `rows` if `cols` is 0. NULL with an exception set on failure. */
+static PyObject* _memoryview( PyObject* owner_ptr, void* data_ptr, Py_ssize_t rows, Py_ssize_t cols, Py_ssize_t itemsize, const char* format ) {
+  _array_t* array_ptr = PyObject_New( _array_t, &_array_type );
+  if ( !array_ptr ) { return NULL; }
+  Py_INCREF( owner_ptr );
+  array_ptr->owner_ptr     = owner_ptr;
+  array_ptr->data_ptr      = data_ptr;
+  array_ptr->shape[0]      = rows;
+  array_ptr->shape[1]      = cols;
+  array_ptr->shape[2]      = 0;
+  array_ptr->ndim          = cols > 0 ? 2 : 1;
+  array_ptr->itemsize      = itemsize;
+  array_ptr->format        = format;
+  array_ptr->n_exports_ptr = NULL;
+  PyObject* view_ptr       = PyMemoryView_FromObject( (PyObject*)array_ptr );
+  Py_DECREF( array_ptr );
+  return view_ptr;
+}
+
+/*************************************************************************************************************************************************
+ * Frame
+ *************************************************************************************************************************************************/
+
+typedef struct _frame_t {
+  PyObject_HEAD
+  uint8_t* blob_ptr; // The frame's own copy of its vol_geom frame blob. Everything in `data` points into this.
+  vol_geom_frame_data_t data;
+  PyObject* key_ptr; // The keyframe whose indices and UVs this frame uses, or NULL if this is a keyframe.
+  uint32_t frame_idx;
+  bool has_texture;
+} _frame_t;
+
+static void _frame_dealloc( PyObject* self_ptr ) {
+  _frame_t* frame_ptr = (_frame_t*)self_ptr;
+  Py_XDECREF( frame_ptr->key_ptr );
+  free( frame_ptr->blob_ptr );
+  Py_TYPE( self_ptr )->tp_free( self_ptr );
+}
+
+static const _frame_t* _frame_key( const _frame_t* frame_ptr ) { return frame_ptr->key_ptr ? (const _frame_t*)frame_ptr->key_ptr : frame_ptr; }
+static Py_ssize_t _frame_n_vertices( const _frame_t* frame_ptr ) { return (Py_ssize_t)frame_ptr->data.vertices_sz / ( 3 * sizeof( float ) ); }
+
+static PyObject* _frame_get_index( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  return PyLong_FromUnsignedLong( ( (_frame_t*)self_ptr )->frame_idx );
+}
+
+static PyObject* _frame_get_is_keyframe( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  return PyBool_FromLong( NULL == ( (_frame_t*)self_ptr )->key_ptr );
+}
+
+static PyObject* _frame_get_keyframe( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  PyObject* key_ptr = (PyObject*)_frame_key( (_frame_t*)self_ptr );
+  Py_INCREF( key_ptr );
+  return key_ptr;
+}
+
+static PyObject* _frame_get_vertices( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  _frame_t* frame_ptr = (_frame_t*)self_ptr;
+  return _memoryview( self_ptr, &frame_ptr->data.block_data_ptr[frame_ptr->data.vertices_offset], _frame_n_vertices( frame_ptr ), 3, sizeof( float ), "f" );
+}
+
+static PyObject* _frame_get_normals( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  _frame_t* frame_ptr = (_frame_t*)self_ptr;
+  if ( 0 == frame_ptr->data.normals_sz ) { Py_RETURN_NONE; }
+  Py_ssize_t n = (Py_ssize_t)frame_ptr->data.normals_sz / ( 3 * sizeof( float ) );
+  return _memoryview( self_ptr, &frame_ptr->data.block_data_ptr[frame_ptr->data.normals_offset], n, 3, sizeof( float ), "f" );
+}
+
+static PyObject* _frame_get_uvs( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  _frame_t* key_ptr = (_frame_t*)_frame_key( (_frame_t*)self_ptr );
+  Py_ssize_t n      = (Py_ssize_t)key_ptr->data.uvs_sz / ( 2 * sizeof( float ) );
+  return _memoryview( (PyObject*)key_ptr, &key_ptr->data.block_data_ptr[key_ptr->data.uvs_offset], n, 2, sizeof( float ), "f" );
+}
+
+static PyObject* _frame_get_indices( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  _frame_t* key_ptr = (_frame_t*)_frame_key( (_frame_t*)self_ptr );
+  // As in the .vols spec, indices are 32-bit for meshes of 65535 or more vertices, otherwise 16-bit.
+  bool wide         = _frame_n_vertices( key_ptr ) >= 65535;
+  Py_ssize_t stride = wide ? sizeof( uint32_t ) : sizeof( uint16_t );
+  Py_ssize_t n_tris = (Py_ssize_t)key_ptr->data.indices_sz / ( 3 * stride );
+  return _memoryview( (PyObject*)key_ptr, &key_ptr->data.block_data_ptr[key_ptr->data.indices_offset], n_tris, 3, stride, wide ? "I" : "H" );
+}
+
+static PyObject* _frame_get_texture( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  _frame_t* frame_ptr = (_frame_t*)self_ptr;
+  if ( !frame_ptr->has_texture || 0 == frame_ptr->data.texture_sz ) { Py_RETURN_NONE; }
+  return _memoryview( self_ptr, &frame_ptr->data.block_data_ptr[frame_ptr->data.texture_offset], frame_ptr->data.texture_sz, 0, 1, "B" );
+}
+
+static PyGetSetDef _frame_getset[] = {
+  { "index", _frame_get_index, NULL, "Frame index, starting at 0.", NULL },
+  { "is_keyframe", _frame_get_is_keyframe, NULL, "True for keyframes, which carry the indices and UVs used by the frames after them.", NULL },
+  { "keyframe", _frame_get_keyframe, NULL, "The keyframe whose indices and UVs this frame uses. The frame itself for keyframes.", NULL },
+  { "vertices", _frame_get_vertices, NULL, "(n, 3) float32 memoryview of vertex positions.", NULL },
+  { "normals", _frame_get_normals, NULL, "(n, 3) float32 memoryview of vertex normals, or None if the vologram has none.", NULL },
+  { "uvs", _frame_get_uvs, NULL, "(n, 2) float32 memoryview of texture coordinates, from the keyframe.", NULL },
+  { "indices", _frame_get_indices, NULL, "(n_triangles, 3) uint16 or uint32 memoryview of triangle indices, from the keyframe.", NULL },
+  { "texture", _frame_get_texture, NULL, "uint8 memoryview of the frame's Basis Universal texture, for v1.3 volograms that have them, otherwise None.", NULL },
+  { NULL, NULL, NULL, NULL, NULL },
+};
+
+static PyTypeObject _frame_type = {
+  PyVarObject_HEAD_INIT( NULL, 0 )
+  .tp_name        = "volograms.Frame",
+  .tp_basicsize   = sizeof( _frame_t ),
+  .tp_dealloc     = _frame_dealloc,
+  .tp_getset      = _frame_getset,
+  .tp_flags       = Py_TPFLAGS_DEFAULT,
+  .tp_doc         = "One frame's mesh, read by a Sequence. Arrays are memoryviews of the frame's own memory, valid for as long as they are kept.",
+};
+
+/*************************************************************************************************************************************************
+ * Sequence
+ *************************************************************************************************************************************************/
+
+typedef struct _sequence_t {
+  PyObject_HEAD
+  vol_geom_info_t info;
+  bool opened;
+  char* seq_filename;
+  uint32_t biggest_stored_sz; // Of playback container chunks, to size the scratch memory for decoding compressed ones.
+  Py_ssize_t n_reading;       // Batches being read with the GIL released. The info must not be freed until they finish.
+  PyObject* last_key_ptr;     // The last keyframe read, so reading a vologram in batches reads each keyframe once.
+} _sequence_t;
+
+/** A frame being read with the GIL released, before it is wrapped in a Frame. */
+typedef struct _read_t {
+  uint32_t frame_idx;
+  uint8_t* blob_ptr;
+  vol_geom_frame_data_t data;
+} _read_t;
+
+/** Reads a frame into its own memory. Called without the GIL, so it touches nothing shared but the read-only info.
+ * vol_geom reads frames into the info's frame blob, so this reads through a copy of the info that points at the frame's own memory instead.
+ * @param scratch_ptr Decode scratch for compressed chunks, as `vol_geom_info_t.chunk_scratch_ptr`. Must not be shared with other threads.
+ */
+static bool _read_frame( const _sequence_t* seq_ptr, uint8_t* scratch_ptr, _read_t* read_ptr ) {
+  vol_geom_info_t info   = seq_ptr->info;
+  vol_geom_size_t blob_sz = info.frames_directory_ptr[read_ptr->frame_idx].total_sz;
+  if ( info.playback_entries_ptr && info.playback_entries_ptr[read_ptr->frame_idx].raw_sz > blob_sz ) {
+    blob_sz = info.playback_entries_ptr[read_ptr->frame_idx].raw_sz;
+  }
+  read_ptr->blob_ptr = malloc( (size_t)blob_sz );
+  if ( !read_ptr->blob_ptr ) { return false; }
+  info.preallocated_frame_blob_ptr = read_ptr->blob_ptr;
+  info.chunk_scratch_ptr           = scratch_ptr;
+  return vol_geom_read_frame( seq_ptr->seq_filename, &info, read_ptr->frame_idx, &read_ptr->data );
+}
+
+static void _sequence_release( _sequence_t* seq_ptr ) {
+  Py_CLEAR( seq_ptr->last_key_ptr );
+  if ( seq_ptr->opened ) { vol_geom_free_file_info( &seq_ptr->info ); }
+  seq_ptr->opened = false;
+  free( seq_ptr->seq_filename );
+  seq_ptr->seq_filename = NULL;
+}
+
+static void _sequence_dealloc( PyObject* self_ptr ) {
+  _sequence_release( (_sequence_t*)self_ptr );
+  Py_TYPE( self_ptr )->tp_free( self_ptr );
+}
+
+static int _sequence_init( PyObject* self_ptr, PyObject* args_ptr, PyObject* kwargs_ptr ) {
+  _sequence_t* seq_ptr = (_sequence_t*)self_ptr;
+  static char* kwlist[] = { "path", "header", "preload", NULL };
+  const char *path_str = NULL, *header_str = NULL;
+  int preload          = 0;
+  if ( !PyArg_ParseTupleAndKeywords( args_ptr, kwargs_ptr, "s|zp", kwlist, &path_str, &header_str, &preload ) ) { return -1; }
+  if ( seq_ptr->n_reading > 0 ) {
+    PyErr_SetString( PyExc_RuntimeError, "the Sequence is being read by another thread" );
+    return -1;
+  }
+  _sequence_release( seq_ptr );
+  memset( &seq_ptr->info, 0, sizeof( seq_ptr->info ) );
+
+  bool ok = false;
+  Py_BEGIN_ALLOW_THREADS;
+  if ( header_str ) {
+    ok = vol_geom_create_file_info( header_str, path_str, &seq_ptr->info, !preload );
+  } else {
+    ok = vol_geom_create_file_info_from_file( path_str, &seq_ptr->info );
+  }
+  Py_END_ALLOW_THREADS;
+  if ( !ok ) {
+    PyErr_Format( PyExc_OSError, "could not open vologram `%s`", path_str );
+    return -1;
+  }
+  seq_ptr->opened            = true;
+  seq_ptr->biggest_stored_sz = 0;
+  for ( uint32_t i = 0; seq_ptr->info.playback_entries_ptr && i < seq_ptr->info.hdr.frame_count; i++ ) {
+    uint32_t stored_sz = seq_ptr->info.playback_entries_ptr[i].stored_sz;
+    if ( stored_sz > seq_ptr->biggest_stored_sz ) { seq_ptr->biggest_stored_sz = stored_sz; }
+  }
+  seq_ptr->seq_filename = malloc( strlen( path_str ) + 1 );
+  if ( !seq_ptr->seq_filename ) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  strcpy( seq_ptr->seq_filename, path_str );
+  return 0;
+}
+
+static bool _sequence_check_open( const _sequence_t* seq_ptr ) {
+  if ( seq_ptr->opened ) { return true; }
+  PyErr_SetString( PyExc_ValueError, "the Sequence is closed" );
+  return false;
+}
+
+/** Read frames `first_idx` up to `end_idx` with the GIL released, and any keyframe before them that they need.
+ * @returns A new list of Frames, or NULL with an exception set.
+ */
+static PyObject* _sequence_read_frames( _sequence_t* seq_ptr, uint32_t first_idx, uint32_t end_idx ) {
+  if ( !_sequence_check_open( seq_ptr ) ) { return NULL; }
+  uint32_t n_frames = seq_ptr->info.hdr.frame_count;
+  if ( first_idx >= end_idx || end_idx > n_frames ) {
+    PyErr_Format( PyExc_IndexError, "frames %u to %u are not in the range of 0 to %u", first_idx, end_idx, n_frames );
+    return NULL;
+  }
+
+  // The first frame's keyframe is read first, if it is before the range and wasn't the last keyframe read.
+  int key_idx        = vol_geom_find_previous_keyframe( &seq_ptr->info, first_idx );
+  PyObject* key_ptr  = NULL;
+  bool read_first_key = false;
+  if ( key_idx < 0 ) {
+    PyErr_Format( PyExc_OSError, "frame %u has no keyframe", first_idx );
+    return NULL;
+  }
+  if ( (uint32_t)key_idx < first_idx ) {
+    _frame_t* last_key_ptr = (_frame_t*)seq_ptr->last_key_ptr;
+    if ( last_key_ptr && last_key_ptr->frame_idx == (uint32_t)key_idx ) {
+      key_ptr = (PyObject*)last_key_ptr;
+      Py_INCREF( key_ptr );
+    } else {
+      read_first_key = true;
+    }
+  }
+
+  uint32_t n_reads  = end_idx - first_idx + ( read_first_key ? 1 : 0 );
+  _read_t* reads_ptr = PyMem_Calloc( n_reads, sizeof( _read_t ) );
+  uint8_t* scratch_ptr = NULL;
+  if ( seq_ptr->info.chunk_scratch_ptr ) { scratch_ptr = PyMem_Malloc( (size_t)seq_ptr->info.biggest_frame_blob_sz + seq_ptr->biggest_stored_sz ); }
+  if ( !reads_ptr || ( seq_ptr->info.chunk_scratch_ptr && !scratch_ptr ) ) {
+    PyMem_Free( reads_ptr );
+    PyMem_Free( scratch_ptr );
+    Py_XDECREF( key_ptr );
+    return PyErr_NoMemory();
+  }
+  for ( uint32_t i = 0; i < n_reads; i++ ) { reads_ptr[i].frame_idx = read_first_key ? ( 0 == i ? (uint32_t)key_idx : first_idx + i - 1 ) : first_idx + i; }
+
+  uint32_t n_read = 0;
+  seq_ptr->n_reading++;
+  Py_BEGIN_ALLOW_THREADS;
+  while ( n_read < n_reads && _read_frame( seq_ptr, scratch_ptr, &reads_ptr[n_read] ) ) { n_read++; }
+  Py_END_ALLOW_THREADS;
+  seq_ptr->n_reading--;
+  PyMem_Free( scratch_ptr );
+
+  PyObject* list_ptr = NULL;
+  if ( n_read < n_reads ) {
+    PyErr_Format( PyExc_OSError, "could not read frame %u of `%s`", reads_ptr[n_read].frame_idx, seq_ptr->seq_filename );
+    goto rf_done;
+  }
+  list_ptr = PyList_New( end_idx - first_idx );
+  if ( !list_ptr ) { goto rf_done; }
+  for ( uint32_t i = 0; i < n_reads; i++ ) {
+    _frame_t* frame_ptr = PyObject_New( _frame_t, &_frame_type );
+    if ( !frame_ptr ) {
+      Py_CLEAR( list_ptr );
+      goto rf_done;
+    }
+    frame_ptr->blob_ptr    = reads_ptr[i].blob_ptr;
+    frame_ptr->data        = reads_ptr[i].data;
+    frame_ptr->frame_idx   = reads_ptr[i].frame_idx;
+    frame_ptr->has_texture = seq_ptr->info.hdr.textured && seq_ptr->info.hdr.texture_compression > 0;
+    frame_ptr->key_ptr     = NULL;
+    reads_ptr[i].blob_ptr  = NULL;
+    if ( vol_geom_is_keyframe( &seq_ptr->info, frame_ptr->frame_idx ) ) {
+      Py_XDECREF( key_ptr );
+      key_ptr = (PyObject*)frame_ptr;
+      Py_INCREF( key_ptr );
+    } else {
+      frame_ptr->key_ptr = key_ptr;
+      Py_XINCREF( key_ptr );
+    }
+    if ( read_first_key && 0 == i ) {
+      Py_DECREF( frame_ptr ); // Only kept as the following frames' keyframe.
+    } else {
+      PyList_SET_ITEM( list_ptr, frame_ptr->frame_idx - first_idx, (PyObject*)frame_ptr );
+    }
+  }
+  Py_XSETREF( seq_ptr->last_key_ptr, key_ptr );
+  key_ptr = NULL;
+
+rf_done:
+  Py_XDECREF( key_ptr );
+  for ( uint32_t i = 0; i < n_reads; i++ ) { free( reads_ptr[i].blob_ptr ); }
+  PyMem_Free( reads_ptr );
+  return list_ptr;
+}
+
+static PyObject* _sequence_read( PyObject* self_ptr, PyObject* args_ptr ) {
+  unsigned int frame_idx = 0;
+  if ( !PyArg_ParseTuple( args_ptr, "I", &frame_idx ) ) { return NULL; }
+  _sequence_t* seq_ptr   = (_sequence_t*)self_ptr;
+  if ( !_sequence_check_open( seq_ptr ) ) { return NULL; }
+  if ( frame_idx >= seq_ptr->info.hdr.frame_count ) {
+    PyErr_Format( PyExc_IndexError, "frame %u is not in the range of 0 to %u", frame_idx, seq_ptr->info.hdr.frame_count );
+    return NULL;
+  }
+  PyObject* list_ptr = _sequence_read_frames( seq_ptr, frame_idx, frame_idx + 1 );
+  if ( !list_ptr ) { return NULL; }
+  PyObject* frame_ptr = PyList_GET_ITEM( list_ptr, 0 );
+  Py_INCREF( frame_ptr );
+  Py_DECREF( list_ptr );
+  return frame_ptr;
+}
+
+static PyObject* _sequence_read_range( PyObject* self_ptr, PyObject* args_ptr ) {
+  unsigned int first_idx = 0, end_idx = 0;
+  if ( !PyArg_ParseTuple( args_ptr, "II", &first_idx, &end_idx ) ) { return NULL; }
+  return _sequence_read_frames( (_sequence_t*)self_ptr, first_idx, end_idx );
+}
+
+static PyObject* _sequence_is_keyframe( PyObject* self_ptr, PyObject* args_ptr ) {
+  _sequence_t* seq_ptr   = (_sequence_t*)self_ptr;
+  unsigned int frame_idx = 0;
+  if ( !PyArg_ParseTuple( args_ptr, "I", &frame_idx ) ) { return NULL; }
+  if ( !_sequence_check_open( seq_ptr ) ) { return NULL; }
+  return PyBool_FromLong( vol_geom_is_keyframe( &seq_ptr->info, frame_idx ) );
+}
+
+static PyObject* _sequence_close( PyObject* self_ptr, PyObject* unused_ptr ) {
+  (void)unused_ptr;
+  _sequence_t* seq_ptr = (_sequence_t*)self_ptr;
+  if ( seq_ptr->n_reading > 0 ) {
+    PyErr_SetString( PyExc_RuntimeError, "the Sequence is being read by another thread" );
+    return NULL;
+  }
+  _sequence_release( seq_ptr );
+  Py_RETURN_NONE;
+}
+
+static PyObject* _sequence_enter( PyObject* self_ptr, PyObject* unused_ptr ) {
+  (void)unused_ptr;
+  Py_INCREF( self_ptr );
+  return self_ptr;
+}
+
+static PyObject* _sequence_exit( PyObject* self_ptr, PyObject* args_ptr ) {
+  (void)args_ptr;
+  return _sequence_close( self_ptr, NULL );
+}
+
+static Py_ssize_t _sequence_len( PyObject* self_ptr ) {
+  _sequence_t* seq_ptr = (_sequence_t*)self_ptr;
+  if ( !_sequence_check_open( seq_ptr ) ) { return -1; }
+  return seq_ptr->info.hdr.frame_count;
+}
+
+static PyObject* _sequence_get_hdr( PyObject* self_ptr, void* closure_ptr ) {
+  _sequence_t* seq_ptr = (_sequence_t*)self_ptr;
+  if ( !_sequence_check_open( seq_ptr ) ) { return NULL; }
+  const vol_geom_file_hdr_t* hdr_ptr = &seq_ptr->info.hdr;
+  switch ( (intptr_t)closure_ptr ) {
+  case 0: return PyLong_FromUnsignedLong( hdr_ptr->frame_count );
+  case 1: return PyFloat_FromDouble( hdr_ptr->fps > 0.0f ? hdr_ptr->fps : 30.0 ); // Volograms before v1.3 have no frame rate, and are 30 fps.
+  case 2: return PyLong_FromUnsignedLong( hdr_ptr->version );
+  case 3: return PyBool_FromLong( hdr_ptr->normals );
+  case 4: return PyBool_FromLong( hdr_ptr->textured );
+  case 5: return PyLong_FromUnsignedLong( hdr_ptr->texture_width );
+  case 6: return PyLong_FromUnsignedLong( hdr_ptr->texture_height );
+  default: Py_RETURN_NONE;
+  }
+}
+
+static PyMethodDef _sequence_methods[] = {
+  { "read", _sequence_read, METH_VARARGS, "read(index) -> Frame. Reads a frame, and its keyframe if needed, with the GIL released." },
+  { "read_range", _sequence_read_range, METH_VARARGS,
+    "read_range(start, stop) -> list of Frame. Reads frames start to stop - 1 with the GIL released, so other threads can read at the same time." },
+  { "is_keyframe", _sequence_is_keyframe, METH_VARARGS, "is_keyframe(index) -> bool." },
+  { "close", _sequence_close, METH_NOARGS, "Free the vologram's index and any preloaded data. Frames already read stay valid." },
+  { "__enter__", _sequence_enter, METH_NOARGS, NULL },
+  { "__exit__", _sequence_exit, METH_VARARGS, NULL },
+  { NULL, NULL, 0, NULL },
+};
+
+static PyGetSetDef _sequence_getset[] = {
+  { "frame_count", _sequence_get_hdr, NULL, "Number of frames.", (void*)0 },
+  { "fps", _sequence_get_hdr, NULL, "Frames per second. 30 for volograms before v1.3, which don't store it.", (void*)1 },
+  { "version", _sequence_get_hdr, NULL, "File format version, e.g. 13 for v1.3.", (void*)2 },
+  { "has_normals", _sequence_get_hdr, NULL, "True if frames have normals.", (void*)3 },
+  { "textured", _sequence_get_hdr, NULL, "True if the vologram is textured, by a video or by per-frame textures.", (void*)4 },
+  { "texture_width", _sequence_get_hdr, NULL, "Texture width in pixels.", (void*)5 },
+  { "texture_height", _sequence_get_hdr, NULL, "Texture height in pixels.", (void*)6 },
+  { NULL, NULL, NULL, NULL, NULL },
+};
+
+static PySequenceMethods _sequence_as_sequence = { .sq_length = _sequence_len };
+
+static PyTypeObject _sequence_type = {
+  PyVarObject_HEAD_INIT( NULL, 0 )
+  .tp_name        = "volograms.Sequence",
+  .tp_basicsize   = sizeof( _sequence_t ),
+  .tp_dealloc     = _sequence_dealloc,
+  .tp_as_sequence = &_sequence_as_sequence,
+  .tp_methods     = _sequence_methods,
+  .tp_getset      = _sequence_getset,
+  .tp_init        = _sequence_init,
+  .tp_new         = PyType_GenericNew,
+  .tp_flags       = Py_TPFLAGS_DEFAULT,
+  .tp_doc         = "Sequence(path, header=None, preload=False)\n\n"
+                    "An opened vologram: a single-file .vols or playback container, or, with `header`, the sequence file of a multi-file vologram.\n"
+                    "`preload` reads a multi-file vologram's sequence into memory up front, so frames are read without file I/O.",
+};
+
+/*************************************************************************************************************************************************
+ * Video
+ *************************************************************************************************************************************************/
+
+typedef struct _video_t {
+  PyObject_HEAD
+  vol_av_video_t video;
+  bool opened;
+  bool busy;            // A thread is decoding with the GIL released. vol_av videos can't be decoded by two threads at once.
+  Py_ssize_t n_exports; // Views of `pixels`. vol_av's RGB frame must not be freed while there are any.
+} _video_t;
+
+static void _video_release( _video_t* video_ptr ) {
+  if ( video_ptr->video._context_ptr ) { vol_av_close( &video_ptr->video ); } // vol_av_open() can fail after allocating, so this isn't only when opened.
+  video_ptr->opened = false;
+}
+
+static void _video_dealloc( PyObject* self_ptr ) {
+  _video_release( (_video_t*)self_ptr );
+  Py_TYPE( self_ptr )->tp_free( self_ptr );
+}
+
+static int _video_init( PyObject* self_ptr, PyObject* args_ptr, PyObject* kwargs_ptr ) {
+  _video_t* video_ptr   = (_video_t*)self_ptr;
+  static char* kwlist[] = { "path", NULL };
+  const char* path_str  = NULL;
+  if ( !PyArg_ParseTupleAndKeywords( args_ptr, kwargs_ptr, "s", kwlist, &path_str ) ) { return -1; }
+  if ( video_ptr->busy || video_ptr->n_exports > 0 ) {
+    PyErr_SetString( PyExc_BufferError, "the Video is in use" );
+    return -1;
+  }
+  _video_release( video_ptr );
+  memset( &video_ptr->video, 0, sizeof( video_ptr->video ) );
+
+  bool ok = false;
+  Py_BEGIN_ALLOW_THREADS;
+  ok = vol_av_open( path_str, &video_ptr->video );
+  Py_END_ALLOW_THREADS;
+  if ( !ok ) {
+    _video_release( video_ptr );
+    PyErr_Format( PyExc_OSError, "could not open video `%s`", path_str );
+    return -1;
+  }
+  video_ptr->opened = true;
+  return 0;
+}
+
+/** Checks the video can be decoded, and marks it busy. */
+static bool _video_begin( _video_t* video_ptr ) {
+  if ( !video_ptr->opened ) {
+    PyErr_SetString( PyExc_ValueError, "the Video is closed" );
+    return false;
+  }
+  if ( video_ptr->busy ) {
+    PyErr_SetString( PyExc_RuntimeError, "the Video is being read by another thread" );
+    return false;
+  }
+  video_ptr->busy = true;
+  return true;
+}
+
+static PyObject* _video_read( PyObject* self_ptr, PyObject* unused_ptr ) {
+  (void)unused_ptr;
+  _video_t* video_ptr = (_video_t*)self_ptr;
+  if ( !_video_begin( video_ptr ) ) { return NULL; }
+  bool ok = false;
+  Py_BEGIN_ALLOW_THREADS;
+  ok = vol_av_read_next_frame( &video_ptr->video );
+  Py_END_ALLOW_THREADS;
+  video_ptr->busy = false;
+  return PyBool_FromLong( ok );
+}
+
+static PyObject* _video_skip( PyObject* self_ptr, PyObject* unused_ptr ) {
+  (void)unused_ptr;
+  _video_t* video_ptr = (_video_t*)self_ptr;
+  if ( !_video_begin( video_ptr ) ) { return NULL; }
+  bool ok = false;
+  Py_BEGIN_ALLOW_THREADS;
+  ok = vol_av_decode_next_frame( &video_ptr->video );
+  Py_END_ALLOW_THREADS;
+  video_ptr->busy = false;
+  return PyBool_FromLong( ok );
+}
+
+static PyObject* _video_close( PyObject* self_ptr, PyObject* unused_ptr ) {
+  (void)unused_ptr;
+  _video_t* video_ptr = (_video_t*)self_ptr;
+  if ( video_ptr->busy ) {
+    PyErr_SetString( PyExc_RuntimeError, "the Video is being read by another thread" );
+    return NULL;
+  }
+  if ( video_ptr->n_exports > 0 ) {
+    PyErr_SetString( PyExc_BufferError, "the Video's pixels are still in use. Release views of them, e.g. with `del`, before closing" );
+    return NULL;
+  }
+  _video_release( video_ptr );
+  Py_RETURN_NONE;
+}
+
+static PyObject* _video_exit( PyObject* self_ptr, PyObject* args_ptr ) {
+  (void)args_ptr;
+  return _video_close( self_ptr, NULL );
+}
+
+static PyObject* _video_get_pixels( PyObject* self_ptr, void* closure_ptr ) {
+  (void)closure_ptr;
+  _video_t* video_ptr = (_video_t*)self_ptr;
+  if ( !video_ptr->opened || !video_ptr->video.pixels_ptr ) { Py_RETURN_NONE; }
+  _array_t* array_ptr = PyObject_New( _array_t, &_array_type );
+  if ( !array_ptr ) { return NULL; }
+  Py_INCREF( self_ptr );
+  array_ptr->owner_ptr     = self_ptr;
+  array_ptr->data_ptr      = video_ptr->video.pixels_ptr;
+  array_ptr->shape[0]      = video_ptr->video.h;
+  array_ptr->shape[1]      = video_ptr->video.w;
+  array_ptr->shape[2]      = 3;
+  array_ptr->ndim          = 3;
+  array_ptr->itemsize      = 1;
+  array_ptr->format        = "B";
+  array_ptr->n_exports_ptr = &video_ptr->n_exports;
+  PyObject* view_ptr       = PyMemoryView_FromObject( (PyObject*)array_ptr );
+  Py_DECREF( array_ptr );
+  return view_ptr;
+}
+
+static PyObject* _video_get_info( PyObject* self_ptr, void* closure_ptr ) {
+  _video_t* video_ptr = (_video_t*)self_ptr;
+  if ( !video_ptr->opened ) {
+    PyErr_SetString( PyExc_ValueError, "the Video is closed" );
+    return NULL;
+  }
+  switch ( (intptr_t)closure_ptr ) {
+  case 0: return PyLong_FromLong( video_ptr->video.w );
+  case 1: return PyLong_FromLong( video_ptr->video.h );
+  case 2: return PyFloat_FromDouble( vol_av_frame_pts_s( &video_ptr->video ) );
+  case 3: return PyFloat_FromDouble( vol_av_frame_rate( &video_ptr->video ) );
+  case 4: return PyFloat_FromDouble( vol_av_duration_s( &video_ptr->video ) );
+  default: Py_RETURN_NONE;
+  }
+}
+
+static PyMethodDef _video_methods[] = {
+  { "read", _video_read, METH_NOARGS, "read() -> bool. Decode the next frame into `pixels`, with the GIL released. False at the end of the video or on error." },
+  { "skip", _video_skip, METH_NOARGS, "skip() -> bool. Decode the next frame without converting it to RGB, which is faster. `pixels` is unchanged." },
+  { "close", _video_close, METH_NOARGS, "Close the video. Raises BufferError while views of `pixels` exist." },
+  { "__enter__", _sequence_enter, METH_NOARGS, NULL },
+  { "__exit__", _video_exit, METH_VARARGS, NULL },
+  { NULL, NULL, 0, NULL },
+};
+
+static PyGetSetDef _video_getset[] = {
+  { "pixels", _video_get_pixels, NULL, "(h, w, 3) uint8 memoryview of the last frame read, as RGB, or None before the first. The next read() overwrites it.",
+    NULL },
+  { "width", _video_get_info, NULL, "Frame width in pixels. 0 before the first frame is read.", (void*)0 },
+  { "height", _video_get_info, NULL, "Frame height in pixels. 0 before the first frame is read.", (void*)1 },
+  { "pts", _video_get_info, NULL, "Presentation time of the last frame decoded, in seconds, or -1.0 before the first.", (void*)2 },
+  { "frame_rate", _video_get_info, NULL, "Frames per second, from the container.", (void*)3 },
+  { "duration", _video_get_info, NULL, "Duration in seconds, from the container.", (void*)4 },
+  { NULL, NULL, NULL, NULL, NULL },
+};
+
+static PyTypeObject _video_type = {
+  PyVarObject_HEAD_INIT( NULL, 0 )
+  .tp_name        = "volograms.Video",
+  .tp_basicsize   = sizeof( _video_t ),
+  .tp_dealloc     = _video_dealloc,
+  .tp_methods     = _video_methods,
+  .tp_getset      = _video_getset,
+  .tp_init        = _video_init,
+  .tp_new         = PyType_GenericNew,
+  .tp_flags       = Py_TPFLAGS_DEFAULT,
+  .tp_doc         = "Video(path)\n\nAn opened texture video file or URL, decoded with vol_av.",
+};
+
+/*************************************************************************************************************************************************
+ * Module
+ *************************************************************************************************************************************************/
+
+static struct PyModuleDef _module = {
+  PyModuleDef_HEAD_INIT,
+  .m_name = "volograms",
+  .m_doc  = "Read vologram frames and texture videos, as memoryviews that numpy.asarray() wraps without copying.",
+  .m_size = -1,
+};
+
+PyMODINIT_FUNC PyInit_volograms( void ) {
+  if ( PyType_Ready( &_array_type ) < 0 || PyType_Ready( &_frame_type ) < 0 || PyType_Ready( &_sequence_type ) < 0 || PyType_Ready( &_video_type ) < 0 ) {
+    return NULL;
+  }
+  // Python reports errors as exceptions, so only the libraries' warnings and errors are printed.
+  vol_geom_set_log_level( VOL_GEOM_LOG_TYPE_WARNING );
+  vol_av_set_log_level( VOL_AV_LOG_TYPE_WARNING );
+
+  PyObject* module_ptr = PyModule_Create( &_module );
+  if ( !module_ptr ) { return NULL; }
+  Py_INCREF( &_frame_type );
+  Py_INCREF( &_sequence_type );
+  Py_INCREF( &_video_type );
+  if ( PyModule_AddObject( module_ptr, "Frame", (PyObject*)&_frame_type ) < 0 || PyModule_AddObject( module_ptr, "Sequence", (PyObject*)&_sequence_type ) < 0 ||
+       PyModule_AddObject( module_ptr, "Video", (PyObject*)&_video_type ) < 0 ) {
+    Py_DECREF( module_ptr );
+    return NULL;
+  }
+  return module_ptr;
+}
@@ -0,0 +1,989 @@
+/** @file main.c
+ * Volograms benchmark tool.
+ *
+ * benchvols | Time the hot paths of vol_geom, vol_av, vol_basis, and vol2obj's output on a vologram.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.6.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. Note that dependencies have separate licences.
+ *           | See LICENSE.md for details.
+ *
+ * Runs each benchmark a fixed number of times, in a fixed order, and writes the timings as JSON so that results can be compared between releases.
+ * Each benchmark reports its number of samples, mean, min, max, and 50th/90th/99th percentile sample times in microseconds,
+ * and its throughput in items (frames, lookups, images) per second and, where there is a meaningful byte count, MB per second.
+ *
+ * Benchmarks
+ * ----------
+ * - `directory_build_streaming`, `directory_build_preload` - vol_geom_create_file_info(), or the single-file equivalent, and free.
+ * - `read_frame_streaming`, `read_frame_preload`           - vol_geom_read_frame() on every frame in order. Preload is for multi-file volograms only.
+ * - `keyframe_lookup`                                      - vol_geom_find_previous_keyframe() for pseudo-random frames, timed in batches.
+ * - `chunk_decode`                                         - vol_geom_decode_playback_chunk() of compressed playback container chunks, already in memory.
+ *                                                            Compare its MB/s with the disk's read speed to see if compression pays for itself.
+ * - `obj_format`                                           - Writing frames as .obj text, as vol2obj does, to the null device.
+ * - `bvh_build`, `bvh_refit`                               - vol_bvh_build() of each keyframe, on all threads, and vol_bvh_refit() of each tracked
+ *                                                            frame, on one thread, as a picking tool would do when stepping through frames.
+ * - `bvh_raycast`                                          - vol_bvh_raycast() of pseudo-random picking rays at each frame. Each sample is one ray.
+ * - `video_decode`                                         - vol_av_read_next_frame(), which is H.264 (or other) decode plus conversion to RGB.
+ * - `basis_transcode`                                      - vol_basis_transcode() of v1.3 per-frame Basis textures to RGBA.
+ * - `jpeg_encode`                                          - stb_image_write JPEG encoding of a texture to memory.
+ * - `stream_open`                                          - With `--url`: vol_stream_open() and close, i.e. fetching the header and index.
+ * - `stream_playback`                                      - With `--url`: vol_stream_read_frame() of every frame, paced in real time at the
+ *                                                            vologram's fps, as a player would. The results also get a "stream" object with
+ *                                                            the number of frames that weren't ready in time, and the stream's cache counters.
+ * - `play_realtime`                                        - With `--play`: vol_play playback of the vologram and video in real time, updated twice a
+ *                                                            frame period as a render loop would. Each sample is the time from a frame being due to it
+ *                                                            being shown. The results also get a "play" object with the dropped, skipped and late frames.
+ *
+ * Benchmarks that need data the vologram doesn't have, e.g. video decode without `--video`, are left out of the results.
+ * vol_geom has no memory-mapped mode, so there is no mmap frame read benchmark.
+ *
+ * `--url` benchmarks streaming a playback container from a web server instead of a local file. Use the servevols tool as a stand-in for a CDN,
+ * with its `--latency` and `--rate` options, to check that prefetching keeps playback ahead of real time. `--no-prefetch` reads each frame
+ * only when it is due, for comparison.
+ *
+ * `--play` adds playback through vol_play's scheduler to either mode, which decodes ahead on a worker thread and drops frames to hold the frame rate.
+ * `--no-drop` shows every frame instead, for comparison.
+ *
+ * Usage Instructions
+ * ------------------
+ *     ./benchvols.bin -c MYFILE.VOLS -o results.json
+ *     ./benchvols.bin -h HEADER.VOLS -s SEQUENCE.VOLS -v VIDEO.MP4 -o results.json
+ *     ./benchvols.bin --url http://127.0.0.1:8642/MYFILE.VOLP -o results.json
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make benchvols`, or `make bench` to build and run against a synthetic vologram and the samples.
+ *
+ * History
+ * -----------
+ * - 0.6.0   (2026/10/18) - New bvh_build, bvh_refit, and bvh_raycast benchmarks of vol_bvh.
+ * - 0.5.0   (2026/10/18) - New --play option, with a real-time play_realtime benchmark of vol_play.
+ * - 0.4.0   (2026/10/18) - New --url mode, with stream_open and real-time stream_playback benchmarks of vol_stream.
+ * - 0.3.0   (2026/10/18) - New chunk_decode benchmark for compressed playback containers.
+ * - 0.2.0   (2026/10/18) - Library warnings and errors are queued in a vol_log_ring during benchmarks and printed afterwards, instead of discarded.
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_av.h"       // Volograms' texture video library.
+#include "vol_basis.h"    // Volograms' Basis Universal wrapper library.
+#include "vol_bvh.h"      // Volograms' ray and nearest-point queries.
+#include "vol_geom.h"     // Volograms' .vols file parsing library.
+#include "vol_log_ring.h" // Volograms' lock-free log queue.
+#include "vol_play.h"     // Volograms' playback scheduler.
+#include "vol_stream.h"   // Volograms' HTTP streaming library.
+#include "vol_thread.h"   // Volograms' threading helpers, for sleep.
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb/stb_image_write.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define NULL_DEVICE "NUL"
+#define bench_fseeko _fseeki64
+#else
+#define NULL_DEVICE "/dev/null"
+#define bench_fseeko fseeko
+#endif
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define BENCH_MAX_RESULTS 16
+#define BENCH_KEYFRAME_LOOKUPS 1000     // Lookups per keyframe_lookup sample.
+#define BENCH_SYNTHETIC_IMAGE_DIMS 1024 // Size of image used for jpeg_encode if the vologram has no texture to use.
+#define BENCH_LOG_RING_MESSAGES 256     // Library log messages queued during benchmarks. Any more are dropped.
+#define BENCH_BVH_RAYS 16               // Picking rays cast at each frame for bvh_raycast.
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t {
+  CL_COMBINED,
+  CL_FRAMES,
+  CL_HEADER,
+  CL_HELP,
+  CL_ITERATIONS,
+  CL_NO_DROP,
+  CL_NO_PREFETCH,
+  CL_OUTPUT,
+  CL_PLAY,
+  CL_SEQUENCE,
+  CL_URL,
+  CL_VIDEO,
+  CL_MAX
+} cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Timings of one benchmark. */
+typedef struct _bench_t {
+  const char* name_str;
+  double* samples_ptr; // Seconds per sample.
+  uint32_t n_samples;
+  uint32_t max_samples;
+  uint64_t n_items; // Total frames/lookups/images over all samples.
+  uint64_t n_bytes; // Total bytes processed over all samples, or 0 if not meaningful.
+} _bench_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
+  { "--frames", "-n", "The next argument gives the maximum number of frames to use per pass. Default is all frames.\n", 1 },       // CL_FRAMES
+  { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--iterations", "-i", "The next argument gives the number of passes over the frames for each benchmark. Default is 5.\n", 1 }, // CL_ITERATIONS
+  { "--no-drop", NULL, "With --play, show every frame in turn, however late, instead of dropping frames to hold the frame rate.\n", 0 }, // CL_NO_DROP
+  { "--no-prefetch", NULL, "With --url, read each frame only when it is due, without prefetching, for comparison.\n", 0 },         // CL_NO_PREFETCH
+  { "--output", "-o", "The next argument gives the path of the JSON file to write. Default is to write JSON to stdout.\n", 1 },    // CL_OUTPUT
+  { "--play", NULL, "Also play the vologram, and video if given, in real time with vol_play, and report late and dropped frames.\n", 0 }, // CL_PLAY
+  { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }, // CL_SEQUENCE
+  { "--url", "-u", "The next argument gives the http:// URL of a playback container, to benchmark streaming it.\n", 1 },           // CL_URL
+  { "--video", "-v", "The next argument gives the path to a video texture file, to benchmark video decoding.\n", 1 }               // CL_VIDEO
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+// Inputs.
+static const char* _input_header_filename;
+static const char* _input_sequence_filename;
+static const char* _input_combined_filename;
+static const char* _input_video_filename;
+static const char* _input_url;
+
+/** Playback results of `--url`, for the "stream" object in the JSON. */
+typedef struct _stream_results_t {
+  bool valid;
+  double fps;
+  uint32_t n_frames_played;
+  uint32_t n_late;   // Frames whose read finished after the end of their frame period.
+  double max_late_s; // Latest finish after the end of a frame period.
+  vol_stream_stats_t stats;
+} _stream_results_t;
+static _stream_results_t _stream_results;
+
+/** Playback results of `--play`, for the "play" object in the JSON. Counters are summed over iterations. */
+typedef struct _play_results_t {
+  bool valid;
+  double fps;
+  vol_play_stats_t stats;
+} _play_results_t;
+static _play_results_t _play_results;
+
+static _bench_t _results[BENCH_MAX_RESULTS];
+static uint32_t _n_results;
+
+// Most recent texture seen by a benchmark, which jpeg_encode uses if there is one.
+static uint8_t* _image_ptr;
+static int _image_w, _image_h, _image_n;
+
+/** All messages go to stderr, so that JSON written to stdout is not interleaved with them. */
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stderr;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** The libraries' warnings and errors are queued while benchmarking, rather than printed, so that printing isn't timed too. Lower levels are filtered out
+ * before the libraries format them. */
+static vol_log_ring_t* _log_ring_ptr;
+
+static void _ring_geom_logger( vol_geom_log_type_t log_type, const char* message_str ) { vol_log_ring_push( _log_ring_ptr, (int)log_type, message_str ); }
+
+static void _ring_av_logger( vol_av_log_type_t log_type, const char* message_str ) { vol_log_ring_push( _log_ring_ptr, (int)log_type, message_str ); }
+
+/** Print any queued library messages. The libraries' log types have the same values as _log_type. */
+static void _print_queued_logs( void ) {
+  char message_str[VOL_LOG_RING_MSG_MAX_LEN];
+  int log_type = 0;
+  while ( vol_log_ring_pop( _log_ring_ptr, &log_type, message_str, sizeof( message_str ) ) ) { _printlog( (_log_type)log_type, "%s", message_str ); }
+  uint32_t n_dropped = vol_log_ring_n_dropped( _log_ring_ptr );
+  if ( n_dropped > 0 ) { _printlog( _LOG_TYPE_WARNING, "WARNING: %u library log messages were dropped.\n", n_dropped ); }
+}
+
+/** @returns A monotonic time in seconds. */
+static double _time_s( void ) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency( &freq );
+  QueryPerformanceCounter( &count );
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/** Start a new benchmark with room for `max_samples` timings. */
+static _bench_t* _bench_begin( const char* name_str, uint32_t max_samples ) {
+  if ( _n_results >= BENCH_MAX_RESULTS || 0 == max_samples ) { return NULL; }
+  _bench_t* bench_ptr    = &_results[_n_results];
+  *bench_ptr             = ( _bench_t ){ .name_str = name_str, .max_samples = max_samples };
+  bench_ptr->samples_ptr = malloc( (size_t)max_samples * sizeof( double ) );
+  if ( !bench_ptr->samples_ptr ) { return NULL; }
+  _n_results++;
+  _printlog( _LOG_TYPE_INFO, "Running %s...\n", name_str );
+  return bench_ptr;
+}
+
+static void _bench_add( _bench_t* bench_ptr, double seconds, uint64_t n_items, uint64_t n_bytes ) {
+  if ( bench_ptr->n_samples >= bench_ptr->max_samples ) { return; }
+  bench_ptr->samples_ptr[bench_ptr->n_samples++] = seconds;
+  bench_ptr->n_items += n_items;
+  bench_ptr->n_bytes += n_bytes;
+}
+
+/** Remove a benchmark that couldn't complete, if it's the most recent one. */
+static void _bench_cancel( _bench_t* bench_ptr ) {
+  if ( !bench_ptr || _n_results == 0 || bench_ptr != &_results[_n_results - 1] ) { return; }
+  free( bench_ptr->samples_ptr );
+  *bench_ptr = ( _bench_t ){ .name_str = NULL };
+  _n_results--;
+}
+
+static int _compare_doubles( const void* a_ptr, const void* b_ptr ) {
+  double a = *(const double*)a_ptr, b = *(const double*)b_ptr;
+  return ( a > b ) - ( a < b );
+}
+
+/** Nearest-rank percentile of sorted samples. */
+static double _percentile( const double* sorted_ptr, uint32_t n, double p ) {
+  uint32_t rank = (uint32_t)( p / 100.0 * n + 0.999999 );
+  rank          = rank < 1 ? 1 : ( rank > n ? n : rank );
+  return sorted_ptr[rank - 1];
+}
+
+/** Write a JSON string member, escaping e.g. Windows path separators. */
+static void _write_json_str( FILE* f_ptr, const char* key_str, const char* value_str ) {
+  fprintf( f_ptr, "    \"%s\": \"", key_str );
+  for ( const char* c_ptr = value_str; *c_ptr; c_ptr++ ) {
+    if ( '\\' == *c_ptr || '"' == *c_ptr ) { fputc( '\\', f_ptr ); }
+    fputc( *c_ptr, f_ptr );
+  }
+  fprintf( f_ptr, "\",\n" );
+}
+
+static bool _write_json( FILE* f_ptr, const vol_geom_info_t* info_ptr, uint32_t iterations, uint32_t max_frames ) {
+  fprintf( f_ptr, "{\n  \"tool\": \"benchvols\",\n  \"tool_version\": \"0.6.0\",\n" );
+  fprintf( f_ptr, "  \"input\": {\n" );
+  if ( _input_url ) {
+    _write_json_str( f_ptr, "url", _input_url );
+  } else if ( _input_combined_filename ) {
+    _write_json_str( f_ptr, "combined", _input_combined_filename );
+  } else {
+    _write_json_str( f_ptr, "header", _input_header_filename );
+    _write_json_str( f_ptr, "sequence", _input_sequence_filename );
+  }
+  if ( _input_video_filename ) { _write_json_str( f_ptr, "video", _input_video_filename ); }
+  fprintf( f_ptr, "    \"version\": %u,\n    \"frame_count\": %u,\n    \"normals\": %s,\n    \"textured\": %s\n  },\n", info_ptr->hdr.version,
+    info_ptr->hdr.frame_count, info_ptr->hdr.normals ? "true" : "false", info_ptr->hdr.textured ? "true" : "false" );
+  fprintf( f_ptr, "  \"iterations\": %u,\n  \"max_frames\": %u,\n  \"results\": [", iterations, max_frames );
+
+  for ( uint32_t i = 0; i < _n_results; i++ ) {
+    _bench_t* bench_ptr = &_results[i];
+    uint32_t n          = bench_ptr->n_samples;
+    double total_s      = 0.0;
+    for ( uint32_t j = 0; j < n; j++ ) { total_s += bench_ptr->samples_ptr[j]; }
+    qsort( bench_ptr->samples_ptr, n, sizeof( double ), _compare_doubles );
+    const double* s_ptr = bench_ptr->samples_ptr;
+    fprintf( f_ptr, "%s\n    {\n      \"name\": \"%s\",\n      \"samples\": %u,\n      \"items\": %llu,\n", i > 0 ? "," : "", bench_ptr->name_str, n,
+      (unsigned long long)bench_ptr->n_items );
+    if ( n > 0 ) {
+      fprintf( f_ptr, "      \"mean_us\": %.3f,\n      \"min_us\": %.3f,\n      \"max_us\": %.3f,\n", total_s / n * 1e6, s_ptr[0] * 1e6, s_ptr[n - 1] * 1e6 );
+      fprintf( f_ptr, "      \"p50_us\": %.3f,\n      \"p90_us\": %.3f,\n      \"p99_us\": %.3f,\n", _percentile( s_ptr, n, 50.0 ) * 1e6,
+        _percentile( s_ptr, n, 90.0 ) * 1e6, _percentile( s_ptr, n, 99.0 ) * 1e6 );
+    }
+    fprintf( f_ptr, "      \"items_per_s\": %.3f", total_s > 0.0 ? (double)bench_ptr->n_items / total_s : 0.0 );
+    if ( bench_ptr->n_bytes > 0 ) {
+      fprintf( f_ptr, ",\n      \"mb_per_s\": %.3f", total_s > 0.0 ? (double)bench_ptr->n_bytes / ( 1024.0 * 1024.0 ) / total_s : 0.0 );
+    }
+    fprintf( f_ptr, "\n    }" );
+  }
+  fprintf( f_ptr, "\n  ]" );
+  if ( _stream_results.valid ) {
+    const vol_stream_stats_t* st_ptr = &_stream_results.stats;
+    fprintf( f_ptr, ",\n  \"stream\": {\n    \"fps\": %.3f,\n    \"frames_played\": %u,\n    \"late_frames\": %u,\n    \"max_late_ms\": %.3f,\n",
+      _stream_results.fps, _stream_results.n_frames_played, _stream_results.n_late, _stream_results.max_late_s * 1e3 );
+    fprintf( f_ptr, "    \"cache_hits\": %u,\n    \"cache_waits\": %u,\n    \"cache_misses\": %u,\n    \"evictions\": %u,\n", st_ptr->n_hits,
+      st_ptr->n_waits, st_ptr->n_misses, st_ptr->n_evictions );
+    fprintf( f_ptr, "    \"failed_requests\": %u,\n    \"bytes_fetched\": %llu\n  }", st_ptr->n_failed, (unsigned long long)st_ptr->bytes_fetched );
+  }
+  if ( _play_results.valid ) {
+    const vol_play_stats_t* st_ptr = &_play_results.stats;
+    fprintf( f_ptr, ",\n  \"play\": {\n    \"fps\": %.3f,\n    \"no_drop\": %s,\n    \"shown\": %u,\n    \"dropped\": %u,\n    \"skipped\": %u,\n",
+      _play_results.fps, _option_arg_indices[CL_NO_DROP] ? "true" : "false", st_ptr->n_shown, st_ptr->n_dropped, st_ptr->n_skipped );
+    fprintf( f_ptr, "    \"late_frames\": %u,\n    \"max_late_ms\": %.3f,\n    \"video_decoded\": %u,\n    \"video_repeated\": %u,\n", st_ptr->n_late,
+      st_ptr->max_late_s * 1e3, st_ptr->n_video_decoded, st_ptr->n_video_repeated );
+    fprintf( f_ptr, "    \"video_extra\": %u\n  }", st_ptr->n_video_extra );
+  }
+  return fprintf( f_ptr, "\n}\n" ) > 0;
+}
+
+static bool _open_vologram( vol_geom_info_t* info_ptr, bool streaming_mode ) {
+  *info_ptr = ( vol_geom_info_t ){ .biggest_frame_blob_sz = 0 };
+  if ( _input_combined_filename ) { return vol_geom_create_file_info_from_file( _input_combined_filename, info_ptr ); }
+  return vol_geom_create_file_info( _input_header_filename, _input_sequence_filename, info_ptr, streaming_mode );
+}
+
+static void _bench_directory_build( const char* name_str, bool streaming_mode, uint32_t iterations ) {
+  _bench_t* bench_ptr = _bench_begin( name_str, iterations );
+  if ( !bench_ptr ) { return; }
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    vol_geom_info_t info;
+    double t0 = _time_s();
+    if ( !_open_vologram( &info, streaming_mode ) ) {
+      _bench_cancel( bench_ptr );
+      return;
+    }
+    vol_geom_free_file_info( &info );
+    _bench_add( bench_ptr, _time_s() - t0, 1, 0 );
+  }
+}
+
+static void _bench_read_frames( const char* name_str, bool streaming_mode, uint32_t iterations, uint32_t n_frames ) {
+  vol_geom_info_t info;
+  if ( !_open_vologram( &info, streaming_mode ) ) { return; }
+  const char* seq_filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  _bench_t* bench_ptr      = _bench_begin( name_str, iterations * n_frames );
+  if ( !bench_ptr ) { goto _brf_end; }
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    for ( uint32_t f = 0; f < n_frames; f++ ) {
+      vol_geom_frame_data_t frame_data;
+      double t0 = _time_s();
+      if ( !vol_geom_read_frame( seq_filename, &info, f, &frame_data ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frame %u.\n", f );
+        _bench_cancel( bench_ptr );
+        goto _brf_end;
+      }
+      _bench_add( bench_ptr, _time_s() - t0, 1, (uint64_t)frame_data.block_data_sz );
+    }
+  }
+_brf_end:
+  vol_geom_free_file_info( &info );
+}
+
+/** Times decoding of each compressed chunk only. Chunks are read into memory first, outside the timing. */
+static void _bench_chunk_decode( const vol_geom_info_t* info_ptr, uint32_t iterations, uint32_t n_frames ) {
+  if ( !info_ptr->chunk_scratch_ptr ) { return; } // Only allocated if some chunks are compressed.
+  FILE* f_ptr          = fopen( _input_combined_filename, "rb" );
+  uint8_t* stored_ptr  = malloc( (size_t)info_ptr->biggest_frame_blob_sz ); // Chunks are only kept compressed if that makes them smaller.
+  uint8_t* raw_ptr     = malloc( (size_t)info_ptr->biggest_frame_blob_sz );
+  uint8_t* scratch_ptr = malloc( (size_t)info_ptr->biggest_frame_blob_sz );
+  _bench_t* bench_ptr  = NULL;
+  if ( !f_ptr || !stored_ptr || !raw_ptr || !scratch_ptr ) { goto _bcd_end; }
+  bench_ptr = _bench_begin( "chunk_decode", iterations * n_frames );
+  if ( !bench_ptr ) { goto _bcd_end; }
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    for ( uint32_t f = 0; f < n_frames; f++ ) {
+      const vol_geom_playback_entry_t* entry_ptr = &info_ptr->playback_entries_ptr[f];
+      if ( VOL_GEOM_CODEC_NONE == entry_ptr->codec ) { continue; }
+      if ( 0 != bench_fseeko( f_ptr, (int64_t)entry_ptr->offset, SEEK_SET ) || 1 != fread( stored_ptr, entry_ptr->stored_sz, 1, f_ptr ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading chunk %u.\n", f );
+        _bench_cancel( bench_ptr );
+        goto _bcd_end;
+      }
+      double t0 = _time_s();
+      if ( !vol_geom_decode_playback_chunk( entry_ptr, stored_ptr, raw_ptr, scratch_ptr ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Decoding chunk %u.\n", f );
+        _bench_cancel( bench_ptr );
+        goto _bcd_end;
+      }
+      _bench_add( bench_ptr, _time_s() - t0, 1, entry_ptr->raw_sz );
+    }
+  }
+_bcd_end:
+  if ( f_ptr ) { fclose( f_ptr ); }
+  free( stored_ptr );
+  free( raw_ptr );
+  free( scratch_ptr );
+}
+
+static void _bench_keyframe_lookup( const vol_geom_info_t* info_ptr, uint32_t iterations ) {
+  const uint32_t n_batches = iterations * 20;
+  _bench_t* bench_ptr      = _bench_begin( "keyframe_lookup", n_batches );
+  if ( !bench_ptr ) { return; }
+  uint32_t rng = 1; // Fixed seed so every run does the same lookups.
+  int sum      = 0; // Keeps the compiler from removing the lookups.
+  for ( uint32_t b = 0; b < n_batches; b++ ) {
+    double t0 = _time_s();
+    for ( uint32_t i = 0; i < BENCH_KEYFRAME_LOOKUPS; i++ ) {
+      rng = rng * 1664525u + 1013904223u;
+      sum += vol_geom_find_previous_keyframe( info_ptr, ( rng >> 8 ) % info_ptr->hdr.frame_count );
+    }
+    _bench_add( bench_ptr, _time_s() - t0, BENCH_KEYFRAME_LOOKUPS, 0 );
+  }
+  if ( sum < 0 ) { _printlog( _LOG_TYPE_WARNING, "WARNING: Keyframe lookup failed.\n" ); }
+}
+
+/** Format a frame as .obj text, the same way as vol2obj, and return the number of characters written. */
+static uint64_t _format_obj( FILE* f_ptr, const float* vertices_ptr, uint32_t n_vertices, const float* texcoords_ptr, const float* normals_ptr,
+  const uint8_t* indices_ptr, uint32_t n_indices, uint32_t index_sz ) {
+  uint64_t n_chars = 0;
+  for ( uint32_t i = 0; i < n_vertices; i++ ) {
+    n_chars += fprintf( f_ptr, "v %0.3f %0.3f %0.3f\n", -vertices_ptr[i * 3 + 0], vertices_ptr[i * 3 + 1], vertices_ptr[i * 3 + 2] );
+  }
+  for ( uint32_t i = 0; i < n_vertices; i++ ) { n_chars += fprintf( f_ptr, "vt %0.3f %0.3f\n", texcoords_ptr[i * 2 + 0], texcoords_ptr[i * 2 + 1] ); }
+  if ( normals_ptr ) {
+    for ( uint32_t i = 0; i < n_vertices; i++ ) {
+      n_chars += fprintf( f_ptr, "vn %0.3f %0.3f %0.3f\n", -normals_ptr[i * 3 + 0], normals_ptr[i * 3 + 1], normals_ptr[i * 3 + 2] );
+    }
+  }
+  for ( uint32_t i = 0; i < n_indices / 3; i++ ) {
+    uint32_t abc[3] = { 0, 0, 0 };
+    for ( int j = 0; j < 3; j++ ) { memcpy( &abc[j], &indices_ptr[( i * 3 + j ) * index_sz], index_sz ); }
+    int a = (int)abc[0] + 1, b = (int)abc[1] + 1, c = (int)abc[2] + 1;
+    if ( normals_ptr ) {
+      n_chars += fprintf( f_ptr, "f %i/%i/%i %i/%i/%i %i/%i/%i\n", c, c, c, b, b, b, a, a, a );
+    } else {
+      n_chars += fprintf( f_ptr, "f %i/%i %i/%i %i/%i\n", c, c, b, b, a, a );
+    }
+  }
+  return n_chars;
+}
+
+static void _bench_obj_format( uint32_t iterations, uint32_t n_frames ) {
+  vol_geom_info_t info;
+  if ( !_open_vologram( &info, true ) ) { return; }
+  const char* seq_filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  FILE* f_ptr              = fopen( NULL_DEVICE, "w" );
+  uint8_t* key_blob_ptr    = malloc( info.biggest_frame_blob_sz );
+  _bench_t* bench_ptr      = f_ptr && key_blob_ptr ? _bench_begin( "obj_format", iterations * n_frames ) : NULL;
+  if ( !bench_ptr ) { goto _bof_end; }
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    vol_geom_frame_data_t key_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+    int loaded_key_idx             = -1;
+    for ( uint32_t f = 0; f < n_frames; f++ ) {
+      vol_geom_frame_data_t frame_data;
+      int key_idx = vol_geom_find_previous_keyframe( &info, f );
+      if ( key_idx < 0 ) { goto _bof_fail; }
+      if ( key_idx != loaded_key_idx ) { // Reading a frame overwrites the previous one's memory, so keep a copy of the keyframe, as vol2obj does.
+        if ( !vol_geom_read_frame( seq_filename, &info, (uint32_t)key_idx, &key_data ) ) { goto _bof_fail; }
+        memcpy( key_blob_ptr, key_data.block_data_ptr, key_data.block_data_sz );
+        loaded_key_idx = key_idx;
+      }
+      if ( !vol_geom_read_frame( seq_filename, &info, f, &frame_data ) ) { goto _bof_fail; }
+      uint32_t n_vertices      = frame_data.vertices_sz / ( sizeof( float ) * 3 );
+      uint32_t index_sz        = n_vertices < 65535 ? 2 : 4;
+      const float* normals_ptr = frame_data.normals_sz ? (const float*)&frame_data.block_data_ptr[frame_data.normals_offset] : NULL;
+
+      double t0        = _time_s();
+      uint64_t n_chars = _format_obj( f_ptr, (const float*)&frame_data.block_data_ptr[frame_data.vertices_offset], n_vertices,
+        (const float*)&key_blob_ptr[key_data.uvs_offset], normals_ptr, &key_blob_ptr[key_data.indices_offset], key_data.indices_sz / index_sz, index_sz );
+      fflush( f_ptr );
+      _bench_add( bench_ptr, _time_s() - t0, 1, n_chars );
+    }
+  }
+  goto _bof_end;
+_bof_fail:
+  _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frames for obj_format.\n" );
+  _bench_cancel( bench_ptr );
+_bof_end:
+  if ( f_ptr ) { fclose( f_ptr ); }
+  free( key_blob_ptr );
+  vol_geom_free_file_info( &info );
+}
+
+/** Build a BVH on each keyframe and refit it on each tracked frame, as a picking tool would, then time picking rays cast at the frame. */
+static void _bench_bvh( uint32_t iterations, uint32_t n_frames ) {
+  vol_geom_info_t info;
+  if ( !_open_vologram( &info, true ) ) { return; }
+  const char* seq_filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  uint8_t* key_blob_ptr    = malloc( info.biggest_frame_blob_sz );
+  vol_bvh_t* bvh_ptr       = NULL;
+  _bench_t* build_ptr      = key_blob_ptr ? _bench_begin( "bvh_build", iterations * n_frames ) : NULL;
+  _bench_t* refit_ptr      = build_ptr ? _bench_begin( "bvh_refit", iterations * n_frames ) : NULL;
+  _bench_t* raycast_ptr    = refit_ptr ? _bench_begin( "bvh_raycast", iterations * n_frames * BENCH_BVH_RAYS ) : NULL;
+  if ( !raycast_ptr ) { goto _bbvh_fail; }
+  uint32_t rng    = 1; // Fixed seed so every run casts the same rays.
+  uint32_t n_hits = 0;
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    vol_geom_frame_data_t key_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+    int loaded_key_idx             = -1;
+    for ( uint32_t f = 0; f < n_frames; f++ ) {
+      vol_geom_frame_data_t frame_data;
+      int key_idx = vol_geom_find_previous_keyframe( &info, f );
+      if ( key_idx < 0 ) { goto _bbvh_fail; }
+      if ( key_idx != loaded_key_idx ) {
+        if ( !vol_geom_read_frame( seq_filename, &info, (uint32_t)key_idx, &key_data ) ) { goto _bbvh_fail; }
+        memcpy( key_blob_ptr, key_data.block_data_ptr, key_data.block_data_sz );
+      }
+      if ( !vol_geom_read_frame( seq_filename, &info, f, &frame_data ) ) { goto _bbvh_fail; }
+      uint32_t n_vertices        = frame_data.vertices_sz / ( sizeof( float ) * 3 );
+      uint32_t index_sz          = n_vertices < 65535 ? 2 : 4; // As in the .vols spec.
+      vol_mesh_frame_view_t view = ( vol_mesh_frame_view_t ){
+        .vertices_ptr = (const float*)&frame_data.block_data_ptr[frame_data.vertices_offset],
+        .n_vertices   = n_vertices,
+        .indices_ptr  = &key_blob_ptr[key_data.indices_offset],
+        .n_indices    = key_data.indices_sz / index_sz,
+        .index_type   = 2 == index_sz ? VOL_MESH_INDEX_TYPE_U16 : VOL_MESH_INDEX_TYPE_U32 //
+      };
+
+      double t0 = _time_s();
+      if ( key_idx != loaded_key_idx ) {
+        vol_bvh_free( bvh_ptr );
+        bvh_ptr = vol_bvh_build( &view, 0 );
+        if ( !bvh_ptr ) { goto _bbvh_fail; }
+        _bench_add( build_ptr, _time_s() - t0, 1, 0 );
+        loaded_key_idx = key_idx;
+      } else {
+        if ( !vol_bvh_refit( bvh_ptr, &view, 1 ) ) { goto _bbvh_fail; }
+        _bench_add( refit_ptr, _time_s() - t0, 1, 0 );
+      }
+
+      // Rays from points around the frame, at pseudo-random points in its bounding box, as a user clicking on it from different viewpoints.
+      float box_min[3] = { 0.0f, 0.0f, 0.0f }, box_max[3] = { 0.0f, 0.0f, 0.0f };
+      for ( uint32_t v = 0; v < n_vertices; v++ ) {
+        for ( int a = 0; a < 3; a++ ) {
+          float c    = view.vertices_ptr[v * 3 + a];
+          box_min[a] = 0 == v || c < box_min[a] ? c : box_min[a];
+          box_max[a] = 0 == v || c > box_max[a] ? c : box_max[a];
+        }
+      }
+      for ( uint32_t r = 0; r < BENCH_BVH_RAYS; r++ ) {
+        float origin[3], direction[3];
+        for ( int a = 0; a < 3; a++ ) {
+          float extent = box_max[a] - box_min[a];
+          rng          = rng * 1664525u + 1013904223u;
+          origin[a]    = box_min[a] - extent + 3.0f * extent * (float)( rng >> 8 ) / (float)( 1u << 24 );
+          rng          = rng * 1664525u + 1013904223u;
+          direction[a] = box_min[a] + extent * (float)( rng >> 8 ) / (float)( 1u << 24 ) - origin[a];
+        }
+        vol_bvh_hit_t hit;
+        t0 = _time_s();
+        n_hits += vol_bvh_raycast( bvh_ptr, &view, origin, direction, INFINITY, &hit ) ? 1 : 0;
+        _bench_add( raycast_ptr, _time_s() - t0, 1, 0 );
+      }
+    }
+  }
+  _printlog( _LOG_TYPE_INFO, "%u of %u picking rays hit.\n", n_hits, raycast_ptr->n_samples );
+  goto _bbvh_end;
+_bbvh_fail:
+  _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frames or building BVHs for bvh benchmarks.\n" );
+  _bench_cancel( raycast_ptr );
+  _bench_cancel( refit_ptr );
+  _bench_cancel( build_ptr );
+_bbvh_end:
+  vol_bvh_free( bvh_ptr );
+  free( key_blob_ptr );
+  vol_geom_free_file_info( &info );
+}
+
+/** Keep a copy of a decoded or transcoded texture for jpeg_encode. */
+static void _keep_image( const uint8_t* pixels_ptr, int w, int h, int n ) {
+  free( _image_ptr );
+  _image_ptr = malloc( (size_t)w * h * n );
+  if ( !_image_ptr ) { return; }
+  memcpy( _image_ptr, pixels_ptr, (size_t)w * h * n );
+  _image_w = w;
+  _image_h = h;
+  _image_n = n;
+}
+
+static void _bench_video_decode( uint32_t iterations, uint32_t max_frames ) {
+  _bench_t* bench_ptr = NULL;
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    vol_av_video_t av_info = ( vol_av_video_t ){ ._context_ptr = NULL };
+    if ( !vol_av_open( _input_video_filename, &av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open video file %s.\n", _input_video_filename );
+      _bench_cancel( bench_ptr );
+      return;
+    }
+    uint32_t n_frames = (uint32_t)vol_av_frame_count( &av_info );
+    n_frames          = max_frames > 0 && max_frames < n_frames ? max_frames : n_frames;
+    if ( !bench_ptr ) { bench_ptr = _bench_begin( "video_decode", iterations * n_frames ); }
+    for ( uint32_t f = 0; bench_ptr && f < n_frames; f++ ) {
+      double t0 = _time_s();
+      if ( !vol_av_read_next_frame( &av_info ) ) { break; }
+      _bench_add( bench_ptr, _time_s() - t0, 1, (uint64_t)av_info.w * av_info.h * 3 );
+    }
+    if ( i == iterations - 1 && av_info.pixels_ptr ) { _keep_image( av_info.pixels_ptr, av_info.w, av_info.h, 3 ); }
+    vol_av_close( &av_info );
+  }
+}
+
+static void _bench_basis_transcode( uint32_t iterations, uint32_t n_frames ) {
+  vol_geom_info_t info;
+  if ( !_open_vologram( &info, true ) ) { return; }
+  const char* seq_filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  uint32_t dims_w          = info.hdr.texture_width > 0 ? info.hdr.texture_width : 8192;
+  uint32_t dims_h          = info.hdr.texture_height > 0 ? info.hdr.texture_height : 8192;
+  uint32_t output_sz       = dims_w * dims_h * 4;
+  uint8_t* output_ptr      = malloc( output_sz );
+  _bench_t* bench_ptr      = output_ptr ? _bench_begin( "basis_transcode", iterations * n_frames ) : NULL;
+  if ( !bench_ptr ) { goto _bbt_end; }
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    for ( uint32_t f = 0; f < n_frames; f++ ) {
+      vol_geom_frame_data_t frame_data;
+      int w = 0, h = 0;
+      if ( !vol_geom_read_frame( seq_filename, &info, f, &frame_data ) ) { goto _bbt_fail; }
+      double t0 = _time_s();
+      // 13 = cTFRGBA32, as used by vol2obj.
+      if ( !vol_basis_transcode( 13, &frame_data.block_data_ptr[frame_data.texture_offset], frame_data.texture_sz, output_ptr, output_sz, &w, &h ) ) {
+        goto _bbt_fail;
+      }
+      _bench_add( bench_ptr, _time_s() - t0, 1, (uint64_t)frame_data.texture_sz );
+      if ( i == iterations - 1 && f == n_frames - 1 ) { _keep_image( output_ptr, w, h, 4 ); }
+    }
+  }
+  goto _bbt_end;
+_bbt_fail:
+  _printlog( _LOG_TYPE_WARNING, "WARNING: Basis transcoding failed. Leaving out basis_transcode.\n" );
+  _bench_cancel( bench_ptr );
+_bbt_end:
+  free( output_ptr );
+  vol_geom_free_file_info( &info );
+}
+
+/** stb_image_write callback that only counts bytes, so that no file I/O is timed. */
+static void _count_bytes_cb( void* context_ptr, void* data_ptr, int sz ) {
+  (void)data_ptr;
+  *(uint64_t*)context_ptr += (uint64_t)sz;
+}
+
+static void _bench_jpeg_encode( uint32_t iterations ) {
+  if ( !_image_ptr ) { // A deterministic pattern with some detail, if there's no real texture.
+    _image_w = _image_h = BENCH_SYNTHETIC_IMAGE_DIMS;
+    _image_n            = 3;
+    _image_ptr          = malloc( (size_t)_image_w * _image_h * _image_n );
+    if ( !_image_ptr ) { return; }
+    for ( int y = 0; y < _image_h; y++ ) {
+      for ( int x = 0; x < _image_w; x++ ) {
+        uint8_t* p_ptr = &_image_ptr[( y * _image_w + x ) * 3];
+        p_ptr[0]       = (uint8_t)( x ^ y );
+        p_ptr[1]       = (uint8_t)( x * 3 + y );
+        p_ptr[2]       = (uint8_t)( ( x * y ) >> 4 );
+      }
+    }
+  }
+  _bench_t* bench_ptr = _bench_begin( "jpeg_encode", iterations );
+  if ( !bench_ptr ) { return; }
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    uint64_t n_bytes = 0;
+    double t0        = _time_s();
+    if ( !stbi_write_jpg_to_func( _count_bytes_cb, &n_bytes, _image_w, _image_h, _image_n, _image_ptr, 95 ) ) {
+      _bench_cancel( bench_ptr );
+      return;
+    }
+    _bench_add( bench_ptr, _time_s() - t0, 1, (uint64_t)_image_w * _image_h * _image_n );
+  }
+}
+
+static void _bench_stream_open( uint32_t iterations ) {
+  _bench_t* bench_ptr = _bench_begin( "stream_open", iterations );
+  if ( !bench_ptr ) { return; }
+  vol_stream_opts_t opts = ( vol_stream_opts_t ){ .no_prefetch = true }; // No worker threads, so only the opening requests are timed.
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    double t0                = _time_s();
+    vol_stream_t* stream_ptr = vol_stream_open( _input_url, &opts );
+    if ( !stream_ptr ) {
+      _bench_cancel( bench_ptr );
+      return;
+    }
+    vol_stream_close( stream_ptr );
+    _bench_add( bench_ptr, _time_s() - t0, 1, 0 );
+  }
+}
+
+/** Read every frame at the time a player would show it, one frame period apart, and time each read.
+ * A frame is late if its read finishes after the end of its frame period. Late frames aren't skipped, so the following frames are read straight away.
+ * Each iteration starts again from the first frame, on the same stream, so later passes may find frames still cached.
+ */
+static void _bench_stream_playback( vol_stream_t* stream_ptr, uint32_t iterations, uint32_t n_frames ) {
+  const vol_geom_info_t* info_ptr = vol_stream_get_info( stream_ptr );
+  double fps                      = info_ptr->hdr.fps > 0.0f ? (double)info_ptr->hdr.fps : 30.0; // Versions before 1.3 have no fps. Most are 30.
+  double period_s                 = 1.0 / fps;
+  _bench_t* bench_ptr             = _bench_begin( "stream_playback", iterations * n_frames );
+  if ( !bench_ptr ) { return; }
+  _stream_results = ( _stream_results_t ){ .fps = fps };
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    double start_s = _time_s();
+    for ( uint32_t f = 0; f < n_frames; f++ ) {
+      double wait_s = start_s + f * period_s - _time_s();
+      if ( wait_s > 0.0 ) { vol_thread_sleep_ms( (uint32_t)( wait_s * 1e3 ) ); }
+      vol_geom_frame_data_t frame_data;
+      double t0 = _time_s();
+      if ( !vol_stream_read_frame( stream_ptr, f, &frame_data ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frame %u: %s.\n", f, vol_stream_error( stream_ptr ) );
+        _bench_cancel( bench_ptr );
+        return;
+      }
+      double t1 = _time_s();
+      _bench_add( bench_ptr, t1 - t0, 1, (uint64_t)frame_data.block_data_sz );
+      double late_s = t1 - ( start_s + ( f + 1 ) * period_s );
+      if ( late_s > 0.0 ) {
+        _stream_results.n_late++;
+        if ( late_s > _stream_results.max_late_s ) { _stream_results.max_late_s = late_s; }
+      }
+      _stream_results.n_frames_played++;
+    }
+  }
+  _stream_results.stats = vol_stream_get_stats( stream_ptr );
+  _stream_results.valid = true;
+}
+
+/** Play the vologram through vol_play, in real time, updating twice a frame period. Each iteration opens a new player, and prerolls before the clock starts. */
+static void _bench_play( uint32_t iterations, uint32_t max_frames ) {
+  const char* seq_filename = _input_url ? _input_url : _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  const char* hdr_filename = _input_url || _input_combined_filename ? NULL : _input_header_filename;
+  vol_play_opts_t opts     = ( vol_play_opts_t ){ .no_drop = _option_arg_indices[CL_NO_DROP] > 0 };
+  _bench_t* bench_ptr      = NULL;
+  _play_results            = ( _play_results_t ){ .valid = false };
+  for ( uint32_t i = 0; i < iterations; i++ ) {
+    vol_play_t* play_ptr = vol_play_open( hdr_filename, seq_filename, _input_video_filename, &opts );
+    if ( !play_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: vol_play_open() failed.\n" );
+      break;
+    }
+    uint32_t n_frames = vol_play_get_info( play_ptr )->hdr.frame_count;
+    n_frames          = max_frames > 0 && max_frames < n_frames ? max_frames : n_frames;
+    double fps        = vol_play_fps( play_ptr );
+    if ( !bench_ptr ) { bench_ptr = _bench_begin( "play_realtime", iterations * n_frames ); }
+    bool play_ok      = bench_ptr && vol_play_preroll( play_ptr );
+    double start_s    = _time_s();
+    while ( play_ok ) {
+      double time_s = _time_s() - start_s;
+      if ( time_s * fps >= (double)n_frames ) { break; }
+      vol_play_frame_t frame;
+      if ( !vol_play_update( play_ptr, time_s, &frame ) ) {
+        play_ok = '\0' == vol_play_error( play_ptr )[0];
+        break;
+      }
+      if ( frame.is_new ) { _bench_add( bench_ptr, time_s - frame.due_s, 1, (uint64_t)frame.geom.block_data_sz ); }
+      vol_thread_sleep_ms( (uint32_t)( 500.0 / fps ) );
+    }
+    if ( !play_ok && bench_ptr ) { _printlog( _LOG_TYPE_ERROR, "ERROR: Playback failed: %s.\n", vol_play_error( play_ptr ) ); }
+    vol_play_stats_t stats = vol_play_get_stats( play_ptr );
+    vol_play_close( play_ptr );
+    if ( !play_ok ) {
+      if ( bench_ptr ) { _bench_cancel( bench_ptr ); }
+      return;
+    }
+    vol_play_stats_t* sum_ptr = &_play_results.stats;
+    sum_ptr->n_shown += stats.n_shown;
+    sum_ptr->n_dropped += stats.n_dropped;
+    sum_ptr->n_skipped += stats.n_skipped;
+    sum_ptr->n_late += stats.n_late;
+    sum_ptr->n_video_decoded += stats.n_video_decoded;
+    sum_ptr->n_video_repeated += stats.n_video_repeated;
+    sum_ptr->n_video_extra += stats.n_video_extra;
+    if ( stats.max_late_s > sum_ptr->max_late_s ) { sum_ptr->max_late_s = stats.max_late_s; }
+    _play_results.fps   = fps;
+    _play_results.valid = true;
+  }
+  if ( _play_results.valid ) {
+    const vol_play_stats_t* st_ptr = &_play_results.stats;
+    _printlog( st_ptr->n_late > 0 ? _LOG_TYPE_WARNING : _LOG_TYPE_INFO, "Played %u frames: %u late, %u dropped, %u skipped, late by up to %.1f ms.\n",
+      st_ptr->n_shown, st_ptr->n_late, st_ptr->n_dropped, st_ptr->n_skipped, st_ptr->max_late_s * 1e3 );
+  }
+}
+
+/** Benchmarks for `--url`. None of the file benchmarks apply. */
+static int _run_url_benchmarks( const char* output_filename, uint32_t iterations, uint32_t max_frames ) {
+  vol_stream_opts_t opts   = ( vol_stream_opts_t ){ .no_prefetch = _option_arg_indices[CL_NO_PREFETCH] > 0 };
+  vol_stream_t* stream_ptr = vol_stream_open( _input_url, &opts );
+  if ( !stream_ptr ) {
+    _print_queued_logs();
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open `%s`. Check the server is running, and that the file is a playback container.\n", _input_url );
+    return 1;
+  }
+  const vol_geom_info_t* info_ptr = vol_stream_get_info( stream_ptr );
+  uint32_t n_frames               = info_ptr->hdr.frame_count;
+  n_frames                        = max_frames > 0 && max_frames < n_frames ? max_frames : n_frames;
+
+  _bench_stream_open( iterations );
+  _bench_stream_playback( stream_ptr, iterations, n_frames );
+  if ( _option_arg_indices[CL_PLAY] ) { _bench_play( iterations, max_frames ); }
+  _print_queued_logs();
+  if ( _stream_results.valid ) {
+    _printlog( _stream_results.n_late > 0 ? _LOG_TYPE_WARNING : _LOG_TYPE_INFO, "%u of %u frames were late, by up to %.1f ms.\n", _stream_results.n_late,
+      _stream_results.n_frames_played, _stream_results.max_late_s * 1e3 );
+  }
+
+  FILE* f_ptr  = output_filename ? fopen( output_filename, "w" ) : stdout;
+  bool success = f_ptr && _write_json( f_ptr, info_ptr, iterations, max_frames );
+  if ( f_ptr && f_ptr != stdout ) { success = 0 == fclose( f_ptr ) && success; }
+  if ( !success ) { _printlog( _LOG_TYPE_ERROR, "ERROR: Writing results to `%s`.\n", output_filename ? output_filename : "stdout" ); }
+
+  vol_stream_close( stream_ptr );
+  for ( uint32_t i = 0; i < _n_results; i++ ) { free( _results[i].samples_ptr ); }
+  vol_log_ring_free( _log_ring_ptr );
+  if ( !success ) { return 1; }
+  if ( output_filename ) { _printlog( _LOG_TYPE_SUCCESS, "Wrote benchmark results to `%s`.\n", output_filename ); }
+  return 0;
+}
+
+int main( int argc, char** argv ) {
+  uint32_t iterations         = 5;
+  uint32_t max_frames         = 0;
+  const char* output_filename = NULL;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf(
+      "Usage for single-file volograms:\n"
+      "%s [OPTIONS] -c MYFILE.VOLS\n\n"
+      "Usage for multi-file volograms:\n"
+      "%s [OPTIONS] -h HEADER.VOLS -s SEQUENCE.VOLS [-v VIDEO.MP4]\n\n"
+      "Usage for playback containers on a web server:\n"
+      "%s [OPTIONS] --url http://HOST:PORT/MYFILE.VOLP\n\n",
+      argv[0], argv[0], argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { _input_combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_HEADER] ) { _input_header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { _input_sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_VIDEO] ) { _input_video_filename = my_argv[_option_arg_indices[CL_VIDEO] + 1]; }
+  if ( _option_arg_indices[CL_URL] ) { _input_url = my_argv[_option_arg_indices[CL_URL] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_filename = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( _option_arg_indices[CL_ITERATIONS] ) { iterations = (uint32_t)atoi( my_argv[_option_arg_indices[CL_ITERATIONS] + 1] ); }
+  if ( _option_arg_indices[CL_FRAMES] ) { max_frames = (uint32_t)atoi( my_argv[_option_arg_indices[CL_FRAMES] + 1] ); }
+  if ( !_input_url && !_input_combined_filename && ( !_input_header_filename || !_input_sequence_filename ) ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --combined, or --header and --sequence, or --url, is missing. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( 0 == iterations ) {
+    _printlog( _LOG_TYPE_WARNING, "--iterations must be at least 1.\n" );
+    return 1;
+  }
+
+  _log_ring_ptr = vol_log_ring_create( BENCH_LOG_RING_MESSAGES );
+  vol_geom_set_log_level( VOL_GEOM_LOG_TYPE_WARNING );
+  vol_av_set_log_level( VOL_AV_LOG_TYPE_WARNING );
+  vol_geom_set_log_callback( _ring_geom_logger );
+  vol_av_set_log_callback( _ring_av_logger );
+  if ( _input_url ) { return _run_url_benchmarks( output_filename, iterations, max_frames ); }
+
+  vol_geom_info_t info;
+  if ( !_open_vologram( &info, true ) ) {
+    _print_queued_logs();
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open vologram.\n" );
+    vol_log_ring_free( _log_ring_ptr );
+    return 1;
+  }
+  uint32_t n_frames = info.hdr.frame_count;
+  n_frames          = max_frames > 0 && max_frames < n_frames ? max_frames : n_frames;
+
+  _bench_directory_build( "directory_build_streaming", true, iterations );
+  if ( !_input_combined_filename ) { _bench_directory_build( "directory_build_preload", false, iterations ); }
+  _bench_read_frames( "read_frame_streaming", true, iterations, n_frames );
+  if ( !_input_combined_filename ) { _bench_read_frames( "read_frame_preload", false, iterations, n_frames ); }
+  if ( _input_combined_filename ) { _bench_chunk_decode( &info, iterations, n_frames ); }
+  _bench_keyframe_lookup( &info, iterations );
+  _bench_obj_format( iterations, n_frames );
+  _bench_bvh( iterations, n_frames );
+  if ( _input_video_filename ) { _bench_video_decode( iterations, max_frames ); }
+  if ( info.hdr.version >= 13 && info.hdr.textured && 1 == info.hdr.texture_compression ) {
+    if ( vol_basis_init() ) { _bench_basis_transcode( iterations, n_frames ); }
+  }
+  _bench_jpeg_encode( iterations );
+  if ( _option_arg_indices[CL_PLAY] ) { _bench_play( iterations, max_frames ); }
+  _print_queued_logs();
+
+  FILE* f_ptr  = output_filename ? fopen( output_filename, "w" ) : stdout;
+  bool success = f_ptr && _write_json( f_ptr, &info, iterations, max_frames );
+  if ( f_ptr && f_ptr != stdout ) { success = 0 == fclose( f_ptr ) && success; }
+  if ( !success ) { _printlog( _LOG_TYPE_ERROR, "ERROR: Writing results to `%s`.\n", output_filename ? output_filename : "stdout" ); }
+
+  vol_geom_free_file_info( &info );
+  for ( uint32_t i = 0; i < _n_results; i++ ) { free( _results[i].samples_ptr ); }
+  free( _image_ptr );
+  vol_log_ring_free( _log_ring_ptr );
+  if ( !success ) { return 1; }
+  if ( output_filename ) { _printlog( _LOG_TYPE_SUCCESS, "Wrote benchmark results to `%s`.\n", output_filename ); }
+  return 0;
+}
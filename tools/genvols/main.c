@@ -0,0 +1,566 @@
+/** @file main.c
+ * Volograms synthetic vologram generator.
+ *
+ * genvols   | Write synthetic volograms of any size for benchmarks and stress tests.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * The vologram is a square grid of vertices with a travelling wave across it. Each keyframe has the same grid, but its triangles are shuffled into a
+ * different order, as captured meshes are not ordered for rendering. Every frame is computed from the frame number and a seed, so the same
+ * parameters always give byte-identical files, on any platform.
+ *
+ * Any user-supplied texture file, e.g. a .basis, is embedded in every frame as-is. Audio is a synthetic tone in a 16-bit mono WAV.
+ *
+ * Usage Instructions
+ * ------------------
+ * For a single-file v1.3 vologram:
+ *     ./genvols.bin -o MYFILE.VOLS -n 300 -p 100000
+ *
+ * For versions before 1.3 a header and sequence file are written, `MYNAME_hdr.vols` and `MYNAME_seq.vols`:
+ *     ./genvols.bin -o MYNAME --version 12 -n 300 -p 100000
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make genvols`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_geom.h"       // Volograms' .vols file parsing library.
+#include "vol_geom_write.h" // Volograms' .vols file writing library.
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define MAX_FILENAME_LEN 1024
+#define GEN_PI 3.14159265358979323846f
+#define GEN_AUDIO_SAMPLE_RATE 44100
+#define GEN_WAV_HDR_SZ 44
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t {
+  CL_AUDIO,
+  CL_FRAMES,
+  CL_HELP,
+  CL_KEYFRAME_INTERVAL,
+  CL_NO_NORMALS,
+  CL_OUTPUT,
+  CL_SEED,
+  CL_TEXTURE,
+  CL_TEXTURE_SIZE,
+  CL_VERSION,
+  CL_VERTICES,
+  CL_MAX
+} cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--audio", NULL,                                                                                                               // CL_AUDIO
+    "The next argument gives the length of a synthetic audio track to embed, in seconds. Version 13 only.\n",                      //
+    1 },                                                                                                                           //
+  { "--frames", "-n", "The next argument gives the number of frames. Default is 300.\n", 1 },                                      // CL_FRAMES
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--keyframe-interval", "-k",                                                                                                   // CL_KEYFRAME_INTERVAL
+    "The next argument gives the number of frames from one keyframe to the next. Default is 30.\n"                                 //
+    "0 makes the first frame the only keyframe.\n",                                                                                //
+    1 },                                                                                                                           //
+  { "--no-normals", NULL, "Don't write vertex normals. Ignored for version 11, which always has normals.\n", 0 },                  // CL_NO_NORMALS
+  { "--output", "-o",                                                                                                              // CL_OUTPUT
+    "Required. The next argument gives the path of the .vols file to write.\n"                                                     //
+    "For versions before 13 this is a name, and `NAME_hdr.vols` and `NAME_seq.vols` are written.\n",                               //
+    1 },                                                                                                                           //
+  { "--seed", NULL, "The next argument gives a number used to vary the triangle order. Default is 1.\n", 1 },                      // CL_SEED
+  { "--texture", NULL,                                                                                                             // CL_TEXTURE
+    "The next argument gives the path to a texture file, such as a .basis, to embed in every frame. Version 11 and later.\n"       //
+    "Files ending in .basis or .ktx2 are marked as such in a v1.3 header; anything else is marked raw.\n",                         //
+    1 },                                                                                                                           //
+  { "--texture-size", NULL,                                                                                                        // CL_TEXTURE_SIZE
+    "The next argument gives the texture dimensions to write in the header, as WIDTHxHEIGHT. Default is 2048x2048.\n",             //
+    1 },                                                                                                                           //
+  { "--version", NULL, "The next argument gives the .vols version to write, from 10 to 13. Default is 13.\n", 1 },                 // CL_VERSION
+  { "--vertices", "-p",                                                                                                            // CL_VERTICES
+    "The next argument gives the approximate number of vertices per frame. Default is 10000.\n"                                    //
+    "It is rounded up to a square grid. Keyframes of 65535 or more vertices use 32-bit indices.\n",                                //
+    1 }                                                                                                                            //
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+// Grid mesh, re-used between frames. Only z and normals change per frame.
+static uint32_t _grid_side;     // Vertices along each side of the grid.
+static uint32_t _n_vertices;    //
+static uint32_t _n_triangles;   //
+static uint32_t _index_sz;      // 2 or 4 bytes.
+static float* _vertices_ptr;    //
+static float* _normals_ptr;     //
+static float* _uvs_ptr;         //
+static uint8_t* _indices_ptr;   //
+static float* _wave_tables_ptr; // sin/cos per column and per row for the current frame. 4 * _grid_side floats.
+
+static uint32_t _rng_state;
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** Small LCG so that output doesn't depend on the platform's rand(). */
+static uint32_t _rng_next( void ) {
+  _rng_state = _rng_state * 1664525u + 1013904223u;
+  return _rng_state;
+}
+
+static void _set_index( uint32_t i, uint32_t value ) {
+  if ( 2 == _index_sz ) {
+    uint16_t v = (uint16_t)value;
+    memcpy( &_indices_ptr[i * 2], &v, sizeof( uint16_t ) );
+  } else {
+    memcpy( &_indices_ptr[i * 4], &value, sizeof( uint32_t ) );
+  }
+}
+
+/** Allocate the grid and set the parts of it that don't change between frames. */
+static bool _create_grid( uint32_t approx_n_vertices ) {
+  _grid_side = (uint32_t)ceil( sqrt( (double)approx_n_vertices ) );
+  _grid_side = _grid_side < 2 ? 2 : _grid_side;
+  if ( (uint64_t)_grid_side * _grid_side * sizeof( float ) * 3 > UINT32_MAX ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: %u vertices is too many for a single frame.\n", approx_n_vertices );
+    return false;
+  }
+  _n_vertices      = _grid_side * _grid_side;
+  _n_triangles     = ( _grid_side - 1 ) * ( _grid_side - 1 ) * 2;
+  _index_sz        = _n_vertices < 65535 ? 2 : 4; // Matches the index size that readers infer from the vertex count.
+  _vertices_ptr    = malloc( (size_t)_n_vertices * sizeof( float ) * 3 );
+  _normals_ptr     = malloc( (size_t)_n_vertices * sizeof( float ) * 3 );
+  _uvs_ptr         = malloc( (size_t)_n_vertices * sizeof( float ) * 2 );
+  _indices_ptr     = malloc( (size_t)_n_triangles * 3 * _index_sz );
+  _wave_tables_ptr = malloc( (size_t)_grid_side * sizeof( float ) * 4 );
+  if ( !_vertices_ptr || !_normals_ptr || !_uvs_ptr || !_indices_ptr || !_wave_tables_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory allocating a grid of %u vertices.\n", _n_vertices );
+    return false;
+  }
+
+  // 2x2 metre grid, centred, facing +z.
+  for ( uint32_t y = 0; y < _grid_side; y++ ) {
+    for ( uint32_t x = 0; x < _grid_side; x++ ) {
+      uint32_t i               = y * _grid_side + x;
+      float u                  = (float)x / (float)( _grid_side - 1 );
+      float v                  = (float)y / (float)( _grid_side - 1 );
+      _vertices_ptr[i * 3 + 0] = u * 2.0f - 1.0f;
+      _vertices_ptr[i * 3 + 1] = v * 2.0f - 1.0f;
+      _vertices_ptr[i * 3 + 2] = 0.0f;
+      _uvs_ptr[i * 2 + 0]      = u;
+      _uvs_ptr[i * 2 + 1]      = v;
+    }
+  }
+  return true;
+}
+
+/** Fill the index buffer with the grid's triangles, in a shuffled order that is different for every keyframe. */
+static void _shuffle_triangles( uint32_t keyframe_idx, uint32_t seed ) {
+  uint32_t t = 0;
+  for ( uint32_t y = 0; y < _grid_side - 1; y++ ) {
+    for ( uint32_t x = 0; x < _grid_side - 1; x++ ) {
+      uint32_t a = y * _grid_side + x;
+      _set_index( t * 3 + 0, a );
+      _set_index( t * 3 + 1, a + 1 );
+      _set_index( t * 3 + 2, a + _grid_side );
+      t++;
+      _set_index( t * 3 + 0, a + 1 );
+      _set_index( t * 3 + 1, a + _grid_side + 1 );
+      _set_index( t * 3 + 2, a + _grid_side );
+      t++;
+    }
+  }
+  // Fisher-Yates over whole triangles.
+  _rng_state            = seed * 2654435761u + keyframe_idx;
+  const uint32_t tri_sz = _index_sz * 3;
+  uint8_t tmp[12];
+  for ( uint32_t i = _n_triangles - 1; i > 0; i-- ) {
+    uint32_t j = (uint32_t)( ( (uint64_t)_rng_next() * ( i + 1 ) ) >> 32 );
+    memcpy( tmp, &_indices_ptr[i * tri_sz], tri_sz );
+    memcpy( &_indices_ptr[i * tri_sz], &_indices_ptr[j * tri_sz], tri_sz );
+    memcpy( &_indices_ptr[j * tri_sz], tmp, tri_sz );
+  }
+}
+
+/** Move the grid to frame `frame_idx` of a wave, z = A sin( kx + wt ) cos( ky + wt/2 ), with analytic normals.
+ * The wave is separable so there are only 4 trig calls per grid row and column, rather than per vertex.
+ */
+static void _animate_grid( uint32_t frame_idx, float fps, bool normals ) {
+  const float amp = 0.1f, k = 2.0f * GEN_PI, w = 2.0f * GEN_PI;
+  const float t   = (float)frame_idx / fps;
+  float* sin_x    = &_wave_tables_ptr[0];
+  float* cos_x    = &_wave_tables_ptr[_grid_side];
+  float* sin_y    = &_wave_tables_ptr[_grid_side * 2];
+  float* cos_y    = &_wave_tables_ptr[_grid_side * 3];
+  for ( uint32_t i = 0; i < _grid_side; i++ ) {
+    float p  = (float)i / (float)( _grid_side - 1 ) * 2.0f - 1.0f;
+    sin_x[i] = sinf( k * p + w * t );
+    cos_x[i] = cosf( k * p + w * t );
+    sin_y[i] = sinf( k * p + 0.5f * w * t );
+    cos_y[i] = cosf( k * p + 0.5f * w * t );
+  }
+  for ( uint32_t y = 0; y < _grid_side; y++ ) {
+    for ( uint32_t x = 0; x < _grid_side; x++ ) {
+      uint32_t i               = y * _grid_side + x;
+      _vertices_ptr[i * 3 + 2] = amp * sin_x[x] * cos_y[y];
+      if ( !normals ) { continue; }
+      float dzdx              = amp * k * cos_x[x] * cos_y[y];
+      float dzdy              = -amp * k * sin_x[x] * sin_y[y];
+      float inv_len           = 1.0f / sqrtf( dzdx * dzdx + dzdy * dzdy + 1.0f );
+      _normals_ptr[i * 3 + 0] = -dzdx * inv_len;
+      _normals_ptr[i * 3 + 1] = -dzdy * inv_len;
+      _normals_ptr[i * 3 + 2] = inv_len;
+    }
+  }
+}
+
+/** Read a whole file into a new buffer. */
+static uint8_t* _read_file( const char* filename, uint32_t* sz_ptr ) {
+  FILE* f_ptr = fopen( filename, "rb" );
+  if ( !f_ptr ) { return NULL; }
+  uint8_t* data_ptr = NULL;
+  if ( 0 != fseek( f_ptr, 0, SEEK_END ) ) { goto _rf_end; }
+  long sz = ftell( f_ptr );
+  if ( sz <= 0 || 0 != fseek( f_ptr, 0, SEEK_SET ) ) { goto _rf_end; }
+  data_ptr = malloc( (size_t)sz );
+  if ( !data_ptr ) { goto _rf_end; }
+  if ( 1 != fread( data_ptr, (size_t)sz, 1, f_ptr ) ) {
+    free( data_ptr );
+    data_ptr = NULL;
+    goto _rf_end;
+  }
+  *sz_ptr = (uint32_t)sz;
+_rf_end:
+  fclose( f_ptr );
+  return data_ptr;
+}
+
+static void _put_u16( uint8_t* dst_ptr, uint16_t v ) { memcpy( dst_ptr, &v, sizeof( uint16_t ) ); }
+static void _put_u32( uint8_t* dst_ptr, uint32_t v ) { memcpy( dst_ptr, &v, sizeof( uint32_t ) ); }
+
+/** Create a 16-bit mono WAV file in memory, of a 440Hz tone. Assumes a little-endian machine, like the rest of the .vols code. */
+static uint8_t* _create_wav( float seconds, uint32_t* sz_ptr ) {
+  uint32_t n_samples = (uint32_t)( seconds * GEN_AUDIO_SAMPLE_RATE );
+  uint32_t data_sz   = n_samples * sizeof( int16_t );
+  uint8_t* wav_ptr   = malloc( GEN_WAV_HDR_SZ + (size_t)data_sz );
+  if ( !wav_ptr ) { return NULL; }
+  memcpy( &wav_ptr[0], "RIFF", 4 );
+  _put_u32( &wav_ptr[4], 36 + data_sz );
+  memcpy( &wav_ptr[8], "WAVEfmt ", 8 );
+  _put_u32( &wav_ptr[16], 16 );                         // fmt chunk size.
+  _put_u16( &wav_ptr[20], 1 );                          // PCM.
+  _put_u16( &wav_ptr[22], 1 );                          // Mono.
+  _put_u32( &wav_ptr[24], GEN_AUDIO_SAMPLE_RATE );      // Sample rate.
+  _put_u32( &wav_ptr[28], GEN_AUDIO_SAMPLE_RATE * 2 );  // Byte rate.
+  _put_u16( &wav_ptr[32], 2 );                          // Block align.
+  _put_u16( &wav_ptr[34], 16 );                         // Bits per sample.
+  memcpy( &wav_ptr[36], "data", 4 );
+  _put_u32( &wav_ptr[40], data_sz );
+  for ( uint32_t i = 0; i < n_samples; i++ ) {
+    int16_t s = (int16_t)( 8192.0f * sinf( 2.0f * GEN_PI * 440.0f * (float)i / (float)GEN_AUDIO_SAMPLE_RATE ) );
+    memcpy( &wav_ptr[GEN_WAV_HDR_SZ + i * sizeof( int16_t )], &s, sizeof( int16_t ) );
+  }
+  *sz_ptr = GEN_WAV_HDR_SZ + data_sz;
+  return wav_ptr;
+}
+
+static bool _has_extension( const char* filename, const char* ext_str ) {
+  size_t l = strlen( filename ), el = strlen( ext_str );
+  return l >= el && 0 == strcasecmp( &filename[l - el], ext_str );
+}
+
+static void _set_short_str( vol_geom_short_str_t* sstr, const char* str ) {
+  sstr->sz = (uint8_t)strlen( str );
+  memcpy( sstr->bytes, str, sstr->sz );
+}
+
+/** Write all the frames of the vologram to `f_ptr`.
+ * @returns The number of bytes of frames written, or 0 on error.
+ */
+static uint64_t _write_frames( FILE* f_ptr, const vol_geom_file_hdr_t* hdr_ptr, uint32_t keyframe_interval, uint32_t seed, const uint8_t* texture_ptr,
+  uint32_t texture_sz ) {
+  uint64_t total_sz = 0;
+  for ( uint32_t i = 0; i < hdr_ptr->frame_count; i++ ) {
+    bool keyframe = 0 == i || ( keyframe_interval > 0 && 0 == i % keyframe_interval );
+    if ( keyframe ) { _shuffle_triangles( keyframe_interval > 0 ? i / keyframe_interval : 0, seed ); }
+    _animate_grid( i, hdr_ptr->fps, hdr_ptr->normals );
+
+    vol_geom_write_frame_t write_frame = ( vol_geom_write_frame_t ){ .frame_number = i, .keyframe = keyframe ? 1 : 0 };
+    write_frame.vertices_ptr           = _vertices_ptr;
+    write_frame.vertices_sz            = _n_vertices * sizeof( float ) * 3;
+    if ( hdr_ptr->normals ) {
+      write_frame.normals_ptr = _normals_ptr;
+      write_frame.normals_sz  = _n_vertices * sizeof( float ) * 3;
+    }
+    if ( keyframe ) {
+      write_frame.indices_ptr = _indices_ptr;
+      write_frame.indices_sz  = _n_triangles * 3 * _index_sz;
+      write_frame.uvs_ptr     = _uvs_ptr;
+      write_frame.uvs_sz      = _n_vertices * sizeof( float ) * 2;
+    }
+    if ( hdr_ptr->textured ) {
+      write_frame.texture_ptr = texture_ptr;
+      write_frame.texture_sz  = texture_sz;
+    }
+    if ( !vol_geom_write_frame( f_ptr, hdr_ptr, &write_frame ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame %u. Check disk space and permissions.\n", i );
+      return 0;
+    }
+    total_sz += (uint64_t)write_frame.vertices_sz + write_frame.normals_sz + write_frame.indices_sz + write_frame.uvs_sz + write_frame.texture_sz;
+  }
+  return total_sz;
+}
+
+static FILE* _open_output( const char* filename ) {
+  FILE* f_ptr = fopen( filename, "wb" );
+  if ( !f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", filename );
+    return NULL;
+  }
+  setvbuf( f_ptr, NULL, _IOFBF, 1 << 20 ); // Frames are written in a few large pieces.
+  return f_ptr;
+}
+
+int main( int argc, char** argv ) {
+  const char* output_str  = NULL;
+  const char* texture_str = NULL;
+  uint32_t version        = 13;
+  uint32_t n_frames       = 300;
+  uint32_t n_vertices     = 10000;
+  uint32_t kf_interval    = 30;
+  uint32_t seed           = 1;
+  uint32_t tex_w          = 2048;
+  uint32_t tex_h          = 2048;
+  float audio_s           = 0.0f;
+  bool normals            = true;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf( "Usage:\n%s [OPTIONS] -o MYFILE.VOLS\n\n", argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_str = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( _option_arg_indices[CL_TEXTURE] ) { texture_str = my_argv[_option_arg_indices[CL_TEXTURE] + 1]; }
+  if ( _option_arg_indices[CL_VERSION] ) { version = (uint32_t)atoi( my_argv[_option_arg_indices[CL_VERSION] + 1] ); }
+  if ( _option_arg_indices[CL_FRAMES] ) { n_frames = (uint32_t)atoi( my_argv[_option_arg_indices[CL_FRAMES] + 1] ); }
+  if ( _option_arg_indices[CL_VERTICES] ) { n_vertices = (uint32_t)atoi( my_argv[_option_arg_indices[CL_VERTICES] + 1] ); }
+  if ( _option_arg_indices[CL_KEYFRAME_INTERVAL] ) { kf_interval = (uint32_t)atoi( my_argv[_option_arg_indices[CL_KEYFRAME_INTERVAL] + 1] ); }
+  if ( _option_arg_indices[CL_SEED] ) { seed = (uint32_t)atoi( my_argv[_option_arg_indices[CL_SEED] + 1] ); }
+  if ( _option_arg_indices[CL_AUDIO] ) { audio_s = (float)atof( my_argv[_option_arg_indices[CL_AUDIO] + 1] ); }
+  if ( _option_arg_indices[CL_NO_NORMALS] ) { normals = false; }
+  if ( _option_arg_indices[CL_TEXTURE_SIZE] ) {
+    if ( 2 != sscanf( my_argv[_option_arg_indices[CL_TEXTURE_SIZE] + 1], "%ux%u", &tex_w, &tex_h ) || 0 == tex_w || 0 == tex_h ) {
+      _printlog( _LOG_TYPE_WARNING, "--texture-size must be given as WIDTHxHEIGHT, e.g. 2048x2048.\n" );
+      return 1;
+    }
+  }
+  if ( !output_str ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --output is missing. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( version < 10 || version > 13 ) {
+    _printlog( _LOG_TYPE_WARNING, "--version must be 10, 11, 12, or 13.\n" );
+    return 1;
+  }
+  if ( 0 == n_frames || 0 == n_vertices ) {
+    _printlog( _LOG_TYPE_WARNING, "--frames and --vertices must be at least 1.\n" );
+    return 1;
+  }
+  if ( texture_str && version < 11 ) {
+    _printlog( _LOG_TYPE_WARNING, "Version 10 volograms can't have embedded textures.\n" );
+    return 1;
+  }
+  if ( audio_s > 0.0f && version < 13 ) {
+    _printlog( _LOG_TYPE_WARNING, "Only version 13 volograms can have embedded audio.\n" );
+    return 1;
+  }
+  if ( 10 == version ) { normals = false; }
+  if ( 11 == version && !normals ) {
+    _printlog( _LOG_TYPE_WARNING, "WARNING: Version 11 volograms always have normals. Ignoring --no-normals.\n" );
+    normals = true;
+  }
+
+  vol_geom_file_hdr_t hdr = ( vol_geom_file_hdr_t ){ .version = version, .frame_count = n_frames, .normals = normals, .fps = 30.0f, .scale = 1.0f };
+  hdr.rotation[0]         = 1.0f;
+  hdr.texture_width       = tex_w;
+  hdr.texture_height      = tex_h;
+  _set_short_str( &hdr.mesh_name, "genvols" );
+  _set_short_str( &hdr.material, "default" );
+  _set_short_str( &hdr.shader, "default" );
+
+  int ret_val          = 1;
+  uint8_t* texture_ptr = NULL;
+  uint8_t* audio_ptr   = NULL;
+  uint32_t texture_sz  = 0;
+  uint32_t audio_sz    = 0;
+  FILE* hdr_f_ptr      = NULL;
+  FILE* seq_f_ptr      = NULL;
+
+  if ( texture_str ) {
+    texture_ptr = _read_file( texture_str, &texture_sz );
+    if ( !texture_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading texture file `%s`.\n", texture_str );
+      goto _main_end;
+    }
+    hdr.textured = true;
+    if ( _has_extension( texture_str, ".basis" ) ) {
+      hdr.texture_compression = 1;
+    } else if ( _has_extension( texture_str, ".ktx2" ) ) {
+      hdr.texture_compression = 2;
+    }
+  }
+  if ( audio_s > 0.0f ) {
+    audio_ptr = _create_wav( audio_s, &audio_sz );
+    if ( !audio_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory creating %.1fs of audio.\n", audio_s );
+      goto _main_end;
+    }
+    hdr.audio = 1;
+  }
+  if ( !_create_grid( n_vertices ) ) { goto _main_end; }
+
+  char hdr_filename[MAX_FILENAME_LEN], seq_filename[MAX_FILENAME_LEN];
+  if ( version >= 13 ) {
+    snprintf( hdr_filename, MAX_FILENAME_LEN, "%s", output_str );
+    hdr_f_ptr = _open_output( hdr_filename );
+    seq_f_ptr = hdr_f_ptr;
+  } else {
+    snprintf( hdr_filename, MAX_FILENAME_LEN, "%s_hdr.vols", output_str );
+    snprintf( seq_filename, MAX_FILENAME_LEN, "%s_seq.vols", output_str );
+    hdr_f_ptr = _open_output( hdr_filename );
+    seq_f_ptr = hdr_f_ptr ? _open_output( seq_filename ) : NULL;
+  }
+  if ( !hdr_f_ptr || !seq_f_ptr ) { goto _main_end; }
+  if ( !vol_geom_write_hdr( hdr_f_ptr, &hdr, audio_ptr, audio_sz ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Writing header to `%s`.\n", hdr_filename );
+    goto _main_end;
+  }
+
+  _printlog( _LOG_TYPE_INFO, "Writing v%u.%u vologram of %u frames with %u vertices and %u triangles (%u-bit indices).\n", version / 10, version % 10,
+    n_frames, _n_vertices, _n_triangles, _index_sz * 8 );
+  uint64_t frames_sz = _write_frames( seq_f_ptr, &hdr, kf_interval, seed, texture_ptr, texture_sz );
+  if ( 0 == frames_sz ) { goto _main_end; }
+
+  _printlog( _LOG_TYPE_INFO, "Wrote %.1f MB of frame data.\n", (double)frames_sz / ( 1024.0 * 1024.0 ) );
+  ret_val = 0;
+
+_main_end:
+  if ( seq_f_ptr && seq_f_ptr != hdr_f_ptr && 0 != fclose( seq_f_ptr ) ) { ret_val = 1; }
+  if ( hdr_f_ptr && 0 != fclose( hdr_f_ptr ) ) { ret_val = 1; }
+  free( texture_ptr );
+  free( audio_ptr );
+  free( _vertices_ptr );
+  free( _normals_ptr );
+  free( _uvs_ptr );
+  free( _indices_ptr );
+  free( _wave_tables_ptr );
+  if ( 0 == ret_val ) { _printlog( _LOG_TYPE_SUCCESS, "Vologram generation completed.\n" ); }
+  return ret_val;
+}
@@ -0,0 +1,374 @@
+/** @file main.c
+ * Volograms vertex cache and vertex fetch optimiser.
+ *
+ * optvols   | Reorder vologram meshes for faster rendering.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Index buffers in vologram keyframes come straight from capture, so aren't ordered for the GPU's post-transform vertex cache.
+ * This tool reorders each keyframe's triangles for vertex cache locality, then renumbers its vertices in order of first use for fetch locality.
+ * The keyframe's vertex permutation is applied to every tracked frame in the same segment, so nothing is lost or approximated.
+ * The output keeps the version and header of the input.
+ *
+ * Usage Instructions
+ * ------------------
+ * For single-file volograms:
+ *     ./optvols.bin -c MYFILE.VOLS -o OPTIMISED.VOLS
+ *
+ * For older multi-file volograms, a new sequence file is written, which is used with the original header and video files:
+ *     ./optvols.bin -h HEADER.VOLS -s SEQUENCE.VOLS -o OPTIMISED_SEQUENCE.VOLS
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make optvols`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_geom.h"       // Volograms' .vols file parsing library.
+#include "vol_geom_write.h" // Volograms' .vols file writing library.
+#include "vol_mesh.h"       // Volograms' mesh processing library.
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_COMBINED, CL_HEADER, CL_HELP, CL_OUTPUT, CL_SEQUENCE, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
+  { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output", "-o",                                                                                                              // CL_OUTPUT
+    "Required. The next argument gives the path of the file to write.\n"                                                           //
+    "For single-file volograms this is a complete .vols file. For multi-file volograms this is a new sequence file.\n",            //
+    1 },                                                                                                                           //
+  { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }  // CL_SEQUENCE
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_geom_info_t _geom_info; // Mesh information from vol_geom library.
+
+// Working memory, grown as required and re-used between frames.
+static uint8_t* _vertices_ptr;
+static uint8_t* _normals_ptr;
+static uint8_t* _uvs_ptr;
+static uint8_t* _indices_ptr;
+static uint32_t* _remap_ptr;
+static uint32_t _remap_n; // Number of vertices in the current keyframe segment's remap table. 0 if there is no remap yet.
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** Helper to grow a working buffer, keeping it if it's already big enough. */
+static bool _reserve( void** ptr_ptr, size_t* capacity_ptr, size_t sz ) {
+  if ( sz <= *capacity_ptr ) { return true; }
+  void* ptr = realloc( *ptr_ptr, sz );
+  if ( !ptr ) { return false; }
+  *ptr_ptr      = ptr;
+  *capacity_ptr = sz;
+  return true;
+}
+
+/** Copies the first `sz` bytes of one file into another. Used to keep the header, and any audio, of single-file volograms as-is. */
+static bool _copy_file_prefix( const char* src_filename, FILE* dst_f_ptr, vol_geom_size_t sz ) {
+  uint8_t buffer[64 * 1024];
+  FILE* src_f_ptr = fopen( src_filename, "rb" );
+  if ( !src_f_ptr ) { return false; }
+  while ( sz > 0 ) {
+    size_t chunk_sz = sz < (vol_geom_size_t)sizeof( buffer ) ? (size_t)sz : sizeof( buffer );
+    if ( 1 != fread( buffer, chunk_sz, 1, src_f_ptr ) || 1 != fwrite( buffer, chunk_sz, 1, dst_f_ptr ) ) {
+      fclose( src_f_ptr );
+      return false;
+    }
+    sz -= (vol_geom_size_t)chunk_sz;
+  }
+  fclose( src_f_ptr );
+  return true;
+}
+
+/** Optimise a keyframe's indices in-place, and build the remap table used for it and the tracked frames after it.
+ * @param acmr_before_ptr,acmr_after_ptr Output: Average Cache Miss Ratio before and after optimisation.
+ */
+static bool _optimise_keyframe( void* indices_ptr, uint32_t n_indices, uint32_t n_vertices, float* acmr_before_ptr, float* acmr_after_ptr ) {
+  vol_mesh_index_type_t index_type = vol_mesh_index_type( n_vertices );
+
+  *acmr_before_ptr = vol_mesh_acmr( indices_ptr, n_indices, n_vertices, index_type, VOL_MESH_VERTEX_CACHE_SZ );
+  if ( !vol_mesh_optimise_vertex_cache( indices_ptr, n_indices, n_vertices, index_type ) ) { return false; }
+  if ( !vol_mesh_optimise_vertex_fetch( indices_ptr, n_indices, n_vertices, index_type, _remap_ptr ) ) { return false; }
+  *acmr_after_ptr = vol_mesh_acmr( indices_ptr, n_indices, n_vertices, index_type, VOL_MESH_VERTEX_CACHE_SZ );
+  _remap_n        = n_vertices;
+
+  return true;
+}
+
+static bool _optimise_vologram( const char* seq_filename, const char* combined_filename, const char* output_filename ) {
+  const char* filename = combined_filename ? combined_filename : seq_filename;
+  FILE* f_ptr          = NULL;
+  size_t vertices_cap = 0, normals_cap = 0, uvs_cap = 0, indices_cap = 0, remap_cap = 0;
+  uint32_t n_keyframes = 0;
+  double acmr_before_sum = 0.0, acmr_after_sum = 0.0;
+
+  f_ptr = fopen( output_filename, "wb" );
+  if ( !f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", output_filename );
+    return false;
+  }
+  // Single-file volograms keep everything before the frames exactly as it was.
+  if ( combined_filename && !_copy_file_prefix( combined_filename, f_ptr, _geom_info.sequence_offset ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Copying header from `%s` to `%s`.\n", combined_filename, output_filename );
+    goto _ov_fail;
+  }
+
+  for ( uint32_t i = 0; i < _geom_info.hdr.frame_count; i++ ) {
+    vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+    vol_geom_write_frame_t write_frame;
+    if ( !vol_geom_read_frame( filename, &_geom_info, i, &frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %u.\n", i );
+      goto _ov_fail;
+    }
+    vol_geom_write_frame_from_data( &_geom_info, i, frame_data.block_data_ptr, &frame_data, &write_frame );
+
+    uint32_t n_vertices = frame_data.vertices_sz / ( sizeof( float ) * 3 );
+
+    // Keyframes, including "last tracked frame" (2) keyframes, start a new topology and remap.
+    if ( frame_data.indices_sz > 0 ) {
+      uint32_t index_sz  = vol_mesh_index_sz( vol_mesh_index_type( n_vertices ) );
+      uint32_t n_indices = frame_data.indices_sz / index_sz;
+      uint32_t n_uvs     = frame_data.uvs_sz / ( sizeof( float ) * 2 );
+      if ( !_reserve( (void**)&_indices_ptr, &indices_cap, frame_data.indices_sz ) ||
+           !_reserve( (void**)&_remap_ptr, &remap_cap, (size_t)n_vertices * sizeof( uint32_t ) ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory at frame %u.\n", i );
+        goto _ov_fail;
+      }
+      memcpy( _indices_ptr, write_frame.indices_ptr, frame_data.indices_sz );
+      _remap_n = 0;
+
+      if ( n_uvs != n_vertices || 0 != n_indices % 3 ) {
+        _printlog( _LOG_TYPE_WARNING, "WARNING: Keyframe %u has %u vertices and %u UVs, or a partial triangle. Leaving this segment as-is.\n", i, n_vertices, n_uvs );
+      } else {
+        float acmr_before = 0.0f, acmr_after = 0.0f;
+        if ( !_optimise_keyframe( _indices_ptr, n_indices, n_vertices, &acmr_before, &acmr_after ) ) {
+          _printlog( _LOG_TYPE_ERROR, "ERROR: Optimising keyframe %u. Check for out-of-range indices.\n", i );
+          goto _ov_fail;
+        }
+        if ( !_reserve( (void**)&_uvs_ptr, &uvs_cap, frame_data.uvs_sz ) ) {
+          _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory at frame %u.\n", i );
+          goto _ov_fail;
+        }
+        vol_mesh_remap_vertices( write_frame.uvs_ptr, _uvs_ptr, n_vertices, sizeof( float ) * 2, _remap_ptr );
+        write_frame.indices_ptr = _indices_ptr;
+        write_frame.uvs_ptr     = _uvs_ptr;
+        acmr_before_sum += acmr_before;
+        acmr_after_sum += acmr_after;
+        n_keyframes++;
+        _printlog( _LOG_TYPE_INFO, "Keyframe %u: %u triangles, ACMR %.3f -> %.3f\n", i, n_indices / 3, acmr_before, acmr_after );
+      }
+    } // endif keyframe.
+
+    // Apply the segment's remap to this frame's per-vertex data.
+    if ( _remap_n > 0 ) {
+      if ( n_vertices != _remap_n ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %u has %u vertices but its keyframe has %u.\n", i, n_vertices, _remap_n );
+        goto _ov_fail;
+      }
+      if ( !_reserve( (void**)&_vertices_ptr, &vertices_cap, frame_data.vertices_sz ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory at frame %u.\n", i );
+        goto _ov_fail;
+      }
+      vol_mesh_remap_vertices( write_frame.vertices_ptr, _vertices_ptr, n_vertices, sizeof( float ) * 3, _remap_ptr );
+      write_frame.vertices_ptr = _vertices_ptr;
+      // Normals left in their old order would each end up paired with another vertex.
+      if ( write_frame.normals_ptr && frame_data.normals_sz != frame_data.vertices_sz ) {
+        uint32_t n_normals = frame_data.normals_sz / ( sizeof( float ) * 3 );
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %u has %u vertices but %u normals.\n", i, n_vertices, n_normals );
+        goto _ov_fail;
+      }
+      if ( write_frame.normals_ptr ) {
+        if ( !_reserve( (void**)&_normals_ptr, &normals_cap, frame_data.normals_sz ) ) {
+          _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory at frame %u.\n", i );
+          goto _ov_fail;
+        }
+        vol_mesh_remap_vertices( write_frame.normals_ptr, _normals_ptr, n_vertices, sizeof( float ) * 3, _remap_ptr );
+        write_frame.normals_ptr = _normals_ptr;
+      }
+    }
+
+    if ( !vol_geom_write_frame( f_ptr, &_geom_info.hdr, &write_frame ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame %u to `%s`. Check disk space and permissions.\n", i, output_filename );
+      goto _ov_fail;
+    }
+  } // endfor frames.
+
+  fclose( f_ptr );
+  if ( n_keyframes > 0 ) {
+    _printlog( _LOG_TYPE_INFO, "Optimised %u keyframes. Mean ACMR %.3f -> %.3f\n", n_keyframes, acmr_before_sum / n_keyframes, acmr_after_sum / n_keyframes );
+  }
+  _printlog( _LOG_TYPE_INFO, "Wrote `%s`\n", output_filename );
+  return true;
+
+_ov_fail:
+  if ( f_ptr ) { fclose( f_ptr ); }
+  return false;
+}
+
+int main( int argc, char** argv ) {
+  const char* header_filename   = NULL;
+  const char* sequence_filename = NULL;
+  const char* combined_filename = NULL;
+  const char* output_filename   = NULL;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf(
+      "Usage for single-file volograms:\n"
+      "%s -c MYFILE.VOLS -o OPTIMISED.VOLS\n\n"
+      "Usage for multi-file volograms:\n"
+      "%s -h HEADER.VOLS -s SEQUENCE.VOLS -o OPTIMISED_SEQUENCE.VOLS\n\n",
+      argv[0], argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_HEADER] ) { header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_filename = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( !combined_filename && !( header_filename && sequence_filename ) ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --combined, or --header and --sequence, is missing. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( !output_filename ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --output is missing. Run with --help for details.\n" );
+    return 1;
+  }
+
+  if ( combined_filename ) {
+    if ( !vol_geom_create_file_info_from_file( combined_filename, &_geom_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open combined vologram file=%s.\n", combined_filename );
+      return 1;
+    }
+  } else if ( !vol_geom_create_file_info( header_filename, sequence_filename, &_geom_info, true ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open geometry files header=%s sequence=%s.\n", header_filename, sequence_filename );
+    return 1;
+  }
+
+  bool success = _optimise_vologram( sequence_filename, combined_filename, output_filename );
+  vol_geom_free_file_info( &_geom_info );
+  free( _vertices_ptr );
+  free( _normals_ptr );
+  free( _uvs_ptr );
+  free( _indices_ptr );
+  free( _remap_ptr );
+  if ( !success ) { return 1; }
+
+  if ( !combined_filename ) { _printlog( _LOG_TYPE_INFO, "Use `%s` with the original header and video texture files.\n", output_filename ); }
+  _printlog( _LOG_TYPE_SUCCESS, "Vologram optimisation completed.\n" );
+  return 0;
+}
@@ -0,0 +1,322 @@
+/** @file main.c
+ * Volograms multi-file to single-file converter.
+ *
+ * packvols  | Repackage an older multi-file vologram as a v1.3 single-file vologram.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.2.1
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. Note that dependencies have separate licences.
+ *           | See LICENSE.md for details.
+ *
+ * Older volograms are a header.vols, a sequence_0.vols, and a texture video. This tool writes the header and sequence as a single v1.3 .vols file,
+ * with every geometry frame written straight through, so that the geometry can be opened, and any frame read, from one file.
+ *
+ * The texture video is kept as-is and referenced alongside the new file, e.g. `vol2obj -c MYFILE.VOLS -v texture_2048_h264.mp4`.
+ * Converting the video to per-frame Basis Universal textures is not supported because this repository only includes the Basis Universal transcoder,
+ * not the encoder. If a video is given its frame rate and dimensions are stored in the new header.
+ *
+ * v1.3 headers don't have the translation, rotation, and scale of v1.2 headers, so if these are not identity they are applied to the
+ * vertices and normals of every frame.
+ *
+ * Usage Instructions
+ * ------------------
+ *     ./packvols.bin -h HEADER.VOLS -s SEQUENCE.VOLS -v VIDEO.MP4 -o MYFILE.VOLS
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make packvols`
+ *
+ * History
+ * -----------
+ * - 0.2.1   (2026/10/18) - Triangles are reversed when a negative header scale mirrors the mesh, to keep front faces.
+ * - 0.2.0   (2026/10/18) - The header transform is applied with vol_mesh's vectorised kernels.
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_av.h"         // Volograms' texture video library.
+#include "vol_geom.h"       // Volograms' .vols file parsing library.
+#include "vol_geom_write.h" // Volograms' .vols file writing library.
+#include "vol_mesh.h"       // Volograms' mesh processing library.
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_FPS, CL_HEADER, CL_HELP, CL_OUTPUT, CL_SEQUENCE, CL_VIDEO, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--fps", NULL,                                                                                                                 // CL_FPS
+    "The next argument gives the frame rate to store in the header.\n"                                                             //
+    "Default is the frame rate of the video given with --video, or 30 if there is no video.\n",                                    //
+    1 },                                                                                                                           //
+  { "--header", "-h", "Required. The next argument gives the path to the header.vols file.\n", 1 },                                // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output", "-o", "Required. The next argument gives the path of the single-file .vols to write.\n", 1 },                      // CL_OUTPUT
+  { "--sequence", "-s", "Required. The next argument gives the path to the sequence_0.vols file.\n", 1 },                          // CL_SEQUENCE
+  { "--video", "-v", "The next argument gives the path to the video texture file, used for frame rate and texture dimensions.\n", 1 } // CL_VIDEO
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_geom_info_t _geom_info;   // Mesh information from vol_geom library.
+static vol_mesh_transform_t _xform; // The v1.2 header's translation, rotation, and scale.
+
+// Working memory for frames that have the header transform applied.
+static float* _vertices_ptr;
+static float* _normals_ptr;
+static uint8_t* _indices_ptr; // Keyframes' triangles, reversed if the transform mirrors the mesh.
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** Apply the header transform (scale, then rotation, then translation) to a copy of a frame's vertices and normals.
+ * A negative scale mirrors the mesh, so keyframes' triangles are reversed too, to keep their front faces.
+ * @returns False if a keyframe's indices aren't a whole number of triangles.
+ */
+static bool _apply_transform( const vol_mesh_transform_t* xform_ptr, vol_geom_write_frame_t* write_frame_ptr ) {
+  uint32_t n_vertices = write_frame_ptr->vertices_sz / ( sizeof( float ) * 3 );
+  vol_mesh_transform_vertices( xform_ptr, write_frame_ptr->vertices_ptr, _vertices_ptr, n_vertices );
+  write_frame_ptr->vertices_ptr = _vertices_ptr;
+
+  if ( write_frame_ptr->normals_ptr ) {
+    uint32_t n_normals = write_frame_ptr->normals_sz / ( sizeof( float ) * 3 );
+    vol_mesh_transform_normals( xform_ptr, write_frame_ptr->normals_ptr, _normals_ptr, n_normals ); // Uniform scale doesn't change direction.
+    write_frame_ptr->normals_ptr = _normals_ptr;
+  }
+
+  if ( xform_ptr->flips_winding && write_frame_ptr->indices_ptr && write_frame_ptr->indices_sz > 0 ) {
+    vol_mesh_index_type_t index_type = vol_mesh_index_type( n_vertices );
+    uint32_t n_indices               = write_frame_ptr->indices_sz / vol_mesh_index_sz( index_type );
+    if ( !vol_mesh_reverse_winding( write_frame_ptr->indices_ptr, _indices_ptr, n_indices, index_type ) ) { return false; }
+    write_frame_ptr->indices_ptr = _indices_ptr;
+  }
+  return true;
+}
+
+static bool _pack_vologram( const char* seq_filename, const char* output_filename, const vol_geom_file_hdr_t* out_hdr_ptr, bool apply_transform ) {
+  FILE* f_ptr = fopen( output_filename, "wb" );
+  if ( !f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", output_filename );
+    return false;
+  }
+  if ( !vol_geom_write_hdr( f_ptr, out_hdr_ptr, NULL, 0 ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Writing header to `%s`.\n", output_filename );
+    goto _pv_fail;
+  }
+
+  for ( uint32_t i = 0; i < _geom_info.hdr.frame_count; i++ ) {
+    vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+    vol_geom_write_frame_t write_frame;
+    if ( !vol_geom_read_frame( seq_filename, &_geom_info, i, &frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %u.\n", i );
+      goto _pv_fail;
+    }
+    vol_geom_write_frame_from_data( &_geom_info, i, frame_data.block_data_ptr, &frame_data, &write_frame );
+    if ( apply_transform && !_apply_transform( &_xform, &write_frame ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Keyframe %u has a partial triangle, so its winding can't be reversed.\n", i );
+      goto _pv_fail;
+    }
+    if ( !vol_geom_write_frame( f_ptr, out_hdr_ptr, &write_frame ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame %u to `%s`. Check disk space and permissions.\n", i, output_filename );
+      goto _pv_fail;
+    }
+  }
+
+  fclose( f_ptr );
+  _printlog( _LOG_TYPE_INFO, "Wrote %u frames to `%s`\n", _geom_info.hdr.frame_count, output_filename );
+  return true;
+
+_pv_fail:
+  fclose( f_ptr );
+  return false;
+}
+
+int main( int argc, char** argv ) {
+  const char* header_filename   = NULL;
+  const char* sequence_filename = NULL;
+  const char* video_filename    = NULL;
+  const char* output_filename   = NULL;
+  float fps                     = 0.0f;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf( "Usage:\n%s -h HEADER.VOLS -s SEQUENCE.VOLS [-v VIDEO.MP4] -o MYFILE.VOLS\n\n", argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_HEADER] ) { header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_VIDEO] ) { video_filename = my_argv[_option_arg_indices[CL_VIDEO] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_filename = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( _option_arg_indices[CL_FPS] ) {
+    fps = (float)atof( my_argv[_option_arg_indices[CL_FPS] + 1] );
+    if ( fps <= 0.0f ) {
+      _printlog( _LOG_TYPE_WARNING, "--fps must be a positive number.\n" );
+      return 1;
+    }
+  }
+  if ( !header_filename || !sequence_filename || !output_filename ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --header, --sequence, or --output is missing. Run with --help for details.\n" );
+    return 1;
+  }
+
+  if ( !vol_geom_create_file_info( header_filename, sequence_filename, &_geom_info, true ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open geometry files header=%s sequence=%s.\n", header_filename, sequence_filename );
+    return 1;
+  }
+  if ( _geom_info.hdr.version >= 13 ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: `%s` is already a v1.3 header.\n", header_filename );
+    vol_geom_free_file_info( &_geom_info );
+    return 1;
+  }
+
+  // v1.3 header. Per-frame textures in older files were raw, so they keep texture_compression 0.
+  vol_geom_file_hdr_t out_hdr      = _geom_info.hdr;
+  out_hdr.version                  = 13;
+  out_hdr.texture_compression      = 0;
+  out_hdr.texture_container_format = 0;
+  out_hdr.audio                    = 0;
+  out_hdr.fps                      = 30.0f;
+  if ( video_filename ) {
+    vol_av_video_t av_info = ( vol_av_video_t ){ ._context_ptr = NULL };
+    if ( !vol_av_open( video_filename, &av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open video file %s.\n", video_filename );
+      vol_geom_free_file_info( &_geom_info );
+      return 1;
+    }
+    int w = 0, h = 0;
+    vol_av_dimensions( &av_info, &w, &h );
+    out_hdr.texture_width  = (uint32_t)w;
+    out_hdr.texture_height = (uint32_t)h;
+    if ( vol_av_frame_rate( &av_info ) > 0.0 ) { out_hdr.fps = (float)vol_av_frame_rate( &av_info ); }
+    vol_av_close( &av_info );
+  }
+  if ( fps > 0.0f ) { out_hdr.fps = fps; }
+
+  _xform               = vol_mesh_transform_from_hdr( &_geom_info.hdr, false );
+  bool apply_transform = !vol_mesh_transform_is_identity( &_xform );
+  if ( apply_transform ) {
+    _printlog( _LOG_TYPE_INFO, "Applying header translation, rotation, and scale to vertices, as v1.3 headers don't store them.\n" );
+    _vertices_ptr = malloc( _geom_info.biggest_frame_blob_sz );
+    _normals_ptr  = malloc( _geom_info.biggest_frame_blob_sz );
+    _indices_ptr  = malloc( _geom_info.biggest_frame_blob_sz );
+    if ( !_vertices_ptr || !_normals_ptr || !_indices_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory.\n" );
+      vol_geom_free_file_info( &_geom_info );
+      return 1;
+    }
+  }
+
+  bool success = _pack_vologram( sequence_filename, output_filename, &out_hdr, apply_transform );
+  vol_geom_free_file_info( &_geom_info );
+  free( _vertices_ptr );
+  free( _normals_ptr );
+  free( _indices_ptr );
+  if ( !success ) { return 1; }
+
+  if ( video_filename ) { _printlog( _LOG_TYPE_INFO, "Use `%s` with the video texture `%s`.\n", output_filename, video_filename ); }
+  _printlog( _LOG_TYPE_SUCCESS, "Vologram packing completed.\n" );
+  return 0;
+}
@@ -0,0 +1,485 @@
+/** @file main.c
+ * Volograms local HTTP server, for testing streaming.
+ *
+ * servevols | Serve a directory over HTTP with range requests, with injected latency and throttling.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. Note that dependencies have separate licences.
+ *           | See LICENSE.md for details.
+ *
+ * A stand-in for a CDN, to develop and test streaming players, such as vol_stream.h and benchvols' --url mode, without a network.
+ * Files under the served directory are served to GET and HEAD requests, with single byte ranges (206 Partial Content), and kept-alive connections.
+ *
+ * A CDN is slower than a local server in two ways, which can be added to every response:
+ *
+ * - `--latency MS` waits before each response, like the round trip and time to first byte of a request to a CDN edge.
+ * - `--rate KIB_PER_S` throttles each connection's body bytes, like the bandwidth of one connection.
+ *   As with a real network, parallel connections each get that rate.
+ *
+ * Each connection is served by one thread for as long as the client keeps it alive, so `--threads` must be at least the number of connections
+ * clients hold open, e.g. for vol_stream its number of prefetching threads plus one. Further connections wait until one closes.
+ *
+ * The server only listens on the loopback interface, 127.0.0.1, and only serves files under the directory, so it isn't suitable beyond testing.
+ * It runs until it is stopped, e.g. with Ctrl+C.
+ *
+ * Usage Instructions
+ * ------------------
+ *     ./servevols.bin -d samples/ -p 8642
+ *     ./servevols.bin -d . --latency 40 --rate 4096
+ *     ./benchvols.bin --url http://127.0.0.1:8642/bench_synthetic.volp
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make servevols`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_thread.h" // Volograms' threading helpers.
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h> // To only serve regular files.
+#include <sys/types.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET _socket_t;
+#define _INVALID_SOCKET INVALID_SOCKET
+#define _close_socket closesocket
+#define _SEND_FLAGS 0
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int _socket_t;
+#define _INVALID_SOCKET -1
+#define _close_socket close
+#ifdef MSG_NOSIGNAL
+#define _SEND_FLAGS MSG_NOSIGNAL // A client hanging up mid-response is normal, and mustn't raise SIGPIPE.
+#else
+#define _SEND_FLAGS 0
+#endif
+#endif
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#define strncasecmp _strnicmp
+#define fseeko _fseeki64
+#define ftello _ftelli64
+#define _stat_t __stat64
+#define _stat_path _stat64
+#else
+#define _stat_t stat
+#define _stat_path stat
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define SERVEVOLS_REQUEST_MAX_LEN 8192
+#define SERVEVOLS_PATH_MAX_LEN 2048
+#define SERVEVOLS_SEND_BLOCK_SZ ( 64 * 1024 )
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_DIR, CL_HELP, CL_LATENCY, CL_PORT, CL_RATE, CL_THREADS, CL_VERBOSE, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--dir"
+  const char* short_str; // e.g. "-d"
+  const char* help_str;  // e.g. "Optional. The next argument is the directory to serve. Defaults to the current directory.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--dir", "-d", "Optional. The next argument is the directory to serve. Defaults to the current directory.\n", 1 },             // CL_DIR
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--latency", "-l", "Optional. The next argument is a delay in milliseconds before each response. Defaults to 0.\n", 1 },       // CL_LATENCY
+  { "--port", "-p", "Optional. The next argument is the port to listen on. Defaults to 8642.\n", 1 },                              // CL_PORT
+  { "--rate", "-r", "Optional. The next argument limits each connection to that many KiB/s. Defaults to unlimited.\n", 1 },        // CL_RATE
+  { "--threads", "-t", "Optional. The next argument is how many connections are served at once. Defaults to 32.\n", 1 },           // CL_THREADS
+  { "--verbose", "-v", "Optional. Prints a line for each request.\n", 0 }                                                          // CL_VERBOSE
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** State shared by the server threads. Read-only once serving starts. */
+typedef struct _server_t {
+  _socket_t listen_sock;
+  const char* dir_str;
+  uint32_t latency_ms;
+  uint32_t rate_kib;
+  bool verbose;
+} _server_t;
+
+static _server_t _server;
+
+static bool _send_all( _socket_t sock, const char* buf_ptr, size_t sz ) {
+  while ( sz > 0 ) {
+    int n = (int)send( sock, buf_ptr, (int)sz, _SEND_FLAGS );
+    if ( n <= 0 ) { return false; }
+    buf_ptr += n;
+    sz -= n;
+  }
+  return true;
+}
+
+/** Send `sz` bytes of the file from `offset`, at no more than the --rate. The rate is kept over the whole body, rather than per block. */
+static bool _send_file_range( _socket_t sock, FILE* f_ptr, uint64_t offset, uint64_t sz, char* block_ptr ) {
+  if ( 0 != fseeko( f_ptr, (int64_t)offset, SEEK_SET ) ) { return false; }
+  uint64_t bytes_per_s = (uint64_t)_server.rate_kib * 1024;
+  uint64_t block_sz    = SERVEVOLS_SEND_BLOCK_SZ;
+  if ( bytes_per_s > 0 && bytes_per_s / 50 < block_sz ) { block_sz = bytes_per_s / 50 > 1024 ? bytes_per_s / 50 : 1024; } // About 20 ms per block.
+  uint64_t sent_sz = 0, slept_ms = 0;
+  while ( sent_sz < sz ) {
+    size_t n = (size_t)( sz - sent_sz < block_sz ? sz - sent_sz : block_sz );
+    if ( n != fread( block_ptr, 1, n, f_ptr ) ) { return false; }
+    if ( !_send_all( sock, block_ptr, n ) ) { return false; }
+    sent_sz += n;
+    if ( bytes_per_s > 0 ) {
+      uint64_t due_ms = sent_sz * 1000 / bytes_per_s;
+      if ( due_ms > slept_ms ) {
+        vol_thread_sleep_ms( (uint32_t)( due_ms - slept_ms ) );
+        slept_ms = due_ms;
+      }
+    }
+  }
+  return true;
+}
+
+static bool _send_status( _socket_t sock, int status, const char* reason_str, bool keep_alive ) {
+  char response_str[256];
+  int len = snprintf( response_str, sizeof( response_str ), "HTTP/1.1 %i %s\r\nContent-Length: 0\r\nConnection: %s\r\n\r\n", status, reason_str,
+    keep_alive ? "keep-alive" : "close" );
+  return _send_all( sock, response_str, (size_t)len );
+}
+
+/** @returns True if `path_str` is a regular file, not a directory or anything else. */
+static bool _is_file( const char* path_str ) {
+  struct _stat_t path_stat;
+  if ( 0 != _stat_path( path_str, &path_stat ) ) { return false; }
+#ifdef _MSC_VER
+  return path_stat.st_mode & _S_IFREG;
+#else
+  return S_ISREG( path_stat.st_mode );
+#endif
+}
+
+/** @returns A pointer to the value of header `name_str` in the NUL-terminated request, or NULL if it isn't there. */
+static const char* _find_header( const char* request_str, const char* name_str ) {
+  size_t name_len = strlen( name_str );
+  for ( const char* line_ptr = strstr( request_str, "\r\n" ); line_ptr; line_ptr = strstr( line_ptr, "\r\n" ) ) {
+    line_ptr += 2;
+    if ( 0 == strncasecmp( line_ptr, name_str, name_len ) && ':' == line_ptr[name_len] ) {
+      const char* value_ptr = line_ptr + name_len + 1;
+      while ( ' ' == *value_ptr || '\t' == *value_ptr ) { value_ptr++; }
+      return value_ptr;
+    }
+  }
+  return NULL;
+}
+
+/** Parse a single range, "bytes=first-last", "bytes=first-", or "bytes=-suffix_len", against a file of `file_sz` bytes.
+ * @returns 0 if the range is valid, 1 if it is past the end of the file, or -1 if it can't be parsed or has several ranges, which are served as a 200.
+ */
+static int _parse_range( const char* range_str, uint64_t file_sz, uint64_t* first_ptr, uint64_t* last_ptr ) {
+  if ( 0 != strncasecmp( range_str, "bytes=", 6 ) || strchr( range_str, ',' ) ) { return -1; }
+  const char* spec_ptr = range_str + 6;
+  char* end_ptr        = NULL;
+  if ( '-' == spec_ptr[0] ) {
+    uint64_t suffix_sz = strtoull( spec_ptr + 1, &end_ptr, 10 );
+    if ( end_ptr == spec_ptr + 1 ) { return -1; }
+    if ( 0 == suffix_sz || 0 == file_sz ) { return 1; }
+    *first_ptr = suffix_sz < file_sz ? file_sz - suffix_sz : 0;
+    *last_ptr  = file_sz - 1;
+    return 0;
+  }
+  *first_ptr = strtoull( spec_ptr, &end_ptr, 10 );
+  if ( end_ptr == spec_ptr || '-' != *end_ptr ) { return -1; }
+  const char* last_str = end_ptr + 1;
+  *last_ptr            = strtoull( last_str, &end_ptr, 10 );
+  if ( end_ptr == last_str ) { *last_ptr = UINT64_MAX; } // "first-" means to the end.
+  if ( *last_ptr < *first_ptr ) { return -1; }
+  if ( *first_ptr >= file_sz ) { return 1; }
+  if ( *last_ptr >= file_sz ) { *last_ptr = file_sz - 1; }
+  return 0;
+}
+
+/** Respond to one request.
+ * @returns False if the connection should be closed.
+ */
+static bool _handle_request( _socket_t sock, char* request_str, char* block_ptr ) {
+  char method_str[8], target_str[SERVEVOLS_PATH_MAX_LEN];
+  if ( 2 != sscanf( request_str, "%7s %2047s HTTP/1.", method_str, target_str ) ) {
+    _send_status( sock, 400, "Bad Request", false );
+    return false;
+  }
+  const char* connection_str = _find_header( request_str, "Connection" );
+  bool keep_alive            = !( connection_str && 0 == strncasecmp( connection_str, "close", 5 ) );
+  bool head_only             = 0 == strcmp( method_str, "HEAD" );
+  if ( !head_only && 0 != strcmp( method_str, "GET" ) ) { // The request may have a body, which we don't read, so close the connection.
+    _send_status( sock, 405, "Method Not Allowed", false );
+    return false;
+  }
+
+  // Only paths under the served directory. Query strings are ignored.
+  target_str[strcspn( target_str, "?#" )] = '\0';
+  if ( '/' != target_str[0] || strstr( target_str, ".." ) || strchr( target_str, '\\' ) ) {
+    return _send_status( sock, 404, "Not Found", keep_alive ) && keep_alive;
+  }
+  char path_str[SERVEVOLS_PATH_MAX_LEN * 2];
+  snprintf( path_str, sizeof( path_str ), "%s%s", _server.dir_str, target_str );
+  // fopen() succeeds on directories on POSIX, and ftello() then gives a nonsense size, so check it's a regular file first.
+  FILE* f_ptr      = _is_file( path_str ) ? fopen( path_str, "rb" ) : NULL;
+  int64_t file_end = -1;
+  if ( f_ptr && 0 == fseeko( f_ptr, 0, SEEK_END ) ) { file_end = (int64_t)ftello( f_ptr ); }
+  uint64_t file_sz = file_end > 0 ? (uint64_t)file_end : 0;
+  if ( !f_ptr || file_end < 0 || '/' == target_str[strlen( target_str ) - 1] ) {
+    if ( f_ptr ) { fclose( f_ptr ); }
+    if ( _server.verbose ) { _printlog( _LOG_TYPE_INFO, "%s %s -> 404\n", method_str, target_str ); }
+    if ( _server.latency_ms ) { vol_thread_sleep_ms( _server.latency_ms ); }
+    return _send_status( sock, 404, "Not Found", keep_alive ) && keep_alive;
+  }
+
+  uint64_t first = 0, last = 0;
+  const char* range_str = _find_header( request_str, "Range" );
+  int range_result      = range_str ? _parse_range( range_str, file_sz, &first, &last ) : -1;
+  if ( range_result < 0 ) { // No range, or one we don't support, so the whole file.
+    first = 0;
+    last  = file_sz > 0 ? file_sz - 1 : 0;
+  }
+  if ( _server.latency_ms ) { vol_thread_sleep_ms( _server.latency_ms ); }
+
+  char response_str[512];
+  int len = 0;
+  if ( range_result > 0 ) {
+    len = snprintf( response_str, sizeof( response_str ),
+      "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */%" PRIu64 "\r\nContent-Length: 0\r\nConnection: %s\r\n\r\n", file_sz,
+      keep_alive ? "keep-alive" : "close" );
+  } else if ( 0 == range_result ) {
+    len = snprintf( response_str, sizeof( response_str ),
+      "HTTP/1.1 206 Partial Content\r\nAccept-Ranges: bytes\r\nContent-Range: bytes %" PRIu64 "-%" PRIu64 "/%" PRIu64 "\r\nContent-Length: %" PRIu64
+      "\r\nContent-Type: application/octet-stream\r\nConnection: %s\r\n\r\n",
+      first, last, file_sz, last - first + 1, keep_alive ? "keep-alive" : "close" );
+  } else {
+    len = snprintf( response_str, sizeof( response_str ),
+      "HTTP/1.1 200 OK\r\nAccept-Ranges: bytes\r\nContent-Length: %" PRIu64 "\r\nContent-Type: application/octet-stream\r\nConnection: %s\r\n\r\n", file_sz,
+      keep_alive ? "keep-alive" : "close" );
+  }
+  if ( _server.verbose ) {
+    _printlog( _LOG_TYPE_INFO, "%s %s bytes %" PRIu64 "-%" PRIu64 " -> %s\n", method_str, target_str, first, last,
+      range_result > 0 ? "416" : ( 0 == range_result ? "206" : "200" ) );
+  }
+  bool ok = _send_all( sock, response_str, (size_t)len );
+  if ( ok && !head_only && range_result <= 0 && file_sz > 0 ) { ok = _send_file_range( sock, f_ptr, first, last - first + 1, block_ptr ); }
+  fclose( f_ptr );
+  return ok && keep_alive;
+}
+
+/** Serve one connection's requests until the client hangs up, or asks to close. */
+static void _serve_connection( _socket_t sock, char* request_str, char* block_ptr ) {
+  uint32_t n_received = 0; // Bytes of the next requests, if the client has sent more than one.
+  for ( ;; ) {
+    char* end_ptr = NULL;
+    while ( !( end_ptr = strstr( request_str, "\r\n\r\n" ) ) ) {
+      if ( n_received >= SERVEVOLS_REQUEST_MAX_LEN - 1 ) {
+        _send_status( sock, 431, "Request Header Fields Too Large", false );
+        return;
+      }
+      int n = (int)recv( sock, &request_str[n_received], (int)( SERVEVOLS_REQUEST_MAX_LEN - 1 - n_received ), 0 );
+      if ( n <= 0 ) { return; }
+      n_received += n;
+      request_str[n_received] = '\0';
+    }
+    end_ptr[2] = '\0'; // Keep the last header's line ending, for `_find_header()`.
+    if ( !_handle_request( sock, request_str, block_ptr ) ) { return; }
+
+    // Requests have no body, so anything after the blank line is the next request.
+    uint32_t request_len = (uint32_t)( end_ptr + 4 - request_str );
+    memmove( request_str, &request_str[request_len], n_received - request_len + 1 );
+    n_received -= request_len;
+  }
+}
+
+static void _server_thread_fn( void* user_ptr ) {
+  (void)user_ptr;
+  char* request_str = malloc( SERVEVOLS_REQUEST_MAX_LEN );
+  char* block_ptr   = malloc( SERVEVOLS_SEND_BLOCK_SZ );
+  if ( !request_str || !block_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory.\n" );
+    free( request_str );
+    free( block_ptr );
+    return;
+  }
+  for ( ;; ) {
+    _socket_t sock = accept( _server.listen_sock, NULL, NULL );
+    if ( _INVALID_SOCKET == sock ) { continue; }
+    int nodelay = 1;
+    setsockopt( sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof( nodelay ) );
+    request_str[0] = '\0';
+    _serve_connection( sock, request_str, block_ptr );
+    _close_socket( sock );
+  }
+}
+
+int main( int argc, char** argv ) {
+  uint32_t port      = 8642;
+  uint32_t n_threads = 32;
+  _server.dir_str    = ".";
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( _option_arg_indices[CL_HELP] ) {
+    printf( "Usage:\n%s -d DIRECTORY -p PORT [--latency MS] [--rate KIB_PER_S]\n\n", argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_DIR] ) { _server.dir_str = my_argv[_option_arg_indices[CL_DIR] + 1]; }
+  if ( _option_arg_indices[CL_LATENCY] ) { _server.latency_ms = (uint32_t)atoi( my_argv[_option_arg_indices[CL_LATENCY] + 1] ); }
+  if ( _option_arg_indices[CL_PORT] ) { port = (uint32_t)atoi( my_argv[_option_arg_indices[CL_PORT] + 1] ); }
+  if ( _option_arg_indices[CL_RATE] ) { _server.rate_kib = (uint32_t)atoi( my_argv[_option_arg_indices[CL_RATE] + 1] ); }
+  if ( _option_arg_indices[CL_THREADS] ) { n_threads = (uint32_t)atoi( my_argv[_option_arg_indices[CL_THREADS] + 1] ); }
+  _server.verbose = _option_arg_indices[CL_VERBOSE] > 0;
+  if ( 0 == port || port > 65535 || 0 == n_threads || n_threads > VOL_THREAD_MAX_THREADS ) {
+    _printlog( _LOG_TYPE_WARNING, "--port must be 1-65535, and --threads 1-%i.\n", VOL_THREAD_MAX_THREADS );
+    return 1;
+  }
+
+#ifdef _WIN32
+  WSADATA wsa_data;
+  if ( 0 != WSAStartup( MAKEWORD( 2, 2 ), &wsa_data ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: WSAStartup() failed.\n" );
+    return 1;
+  }
+#endif
+  _server.listen_sock = socket( AF_INET, SOCK_STREAM, 0 );
+  if ( _INVALID_SOCKET == _server.listen_sock ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Creating socket.\n" );
+    return 1;
+  }
+  int reuse = 1; // Allow restarting straight after stopping, without waiting for the old connections to time out.
+  setsockopt( _server.listen_sock, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof( reuse ) );
+  struct sockaddr_in addr;
+  memset( &addr, 0, sizeof( addr ) );
+  addr.sin_family      = AF_INET;
+  addr.sin_port        = htons( (uint16_t)port );
+  addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+  if ( 0 != bind( _server.listen_sock, (struct sockaddr*)&addr, sizeof( addr ) ) || 0 != listen( _server.listen_sock, 64 ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Listening on port %u. Is it in use?\n", port );
+    _close_socket( _server.listen_sock );
+    return 1;
+  }
+
+  _printlog( _LOG_TYPE_SUCCESS, "Serving `%s` at http://127.0.0.1:%u/ with %u threads.\n", _server.dir_str, port, n_threads );
+  if ( _server.latency_ms ) { _printlog( _LOG_TYPE_INFO, "Latency %u ms per response.\n", _server.latency_ms ); }
+  if ( _server.rate_kib ) { _printlog( _LOG_TYPE_INFO, "Rate limited to %u KiB/s per connection.\n", _server.rate_kib ); }
+  vol_thread_t* threads_ptr[VOL_THREAD_MAX_THREADS];
+  uint32_t n_started = 0;
+  for ( uint32_t i = 1; i < n_threads; i++ ) {
+    threads_ptr[n_started] = vol_thread_create( _server_thread_fn, NULL );
+    if ( threads_ptr[n_started] ) { n_started++; }
+  }
+  _server_thread_fn( NULL ); // Serve on this thread too. Only returns on out of memory.
+  for ( uint32_t i = 0; i < n_started; i++ ) { vol_thread_join( threads_ptr[i] ); }
+  _close_socket( _server.listen_sock );
+  return 1;
+}
@@ -0,0 +1,285 @@
+/** @file main.c
+ * Volograms playback container converter.
+ *
+ * streamvols | Convert a vologram to a playback container, for players that stream frames from disk.
+ * ---------- | ----------------------------------------------------------------
+ * Version    | 0.2.0
+ * Authors    | Anton Gerdelan  <anton@volograms.com>
+ * Copyright  | 2026, Volograms (http://volograms.com/)
+ * Language   | C99
+ * Files      | 1
+ * Licence    | The MIT License. Note that dependencies have separate licences.
+ *            | See LICENSE.md for details.
+ *
+ * A .vols sequence has no index, so players scan every frame header when opening it, and frames start at any byte offset.
+ * This tool writes a vologram's frames to a playback container instead (see "Playback containers" in vol_geom.h),
+ * which has a frame index up front, and each frame in its own chunk aligned to 4096 bytes.
+ * Players open it with `vol_geom_create_file_info_from_file()` as for a single-file vologram, without scanning, and read any frame with one aligned read.
+ *
+ * Each chunk holds a whole frame, including any per-frame texture, such as the Basis Universal textures of v1.3 volograms.
+ * Volograms with a separate texture video keep using that video alongside the container, e.g. `vol2obj -c MYFILE.VOLP -v texture_2048_h264.mp4`,
+ * as this repository has no encoder for per-frame compressed textures.
+ *
+ * With `--compress lz4-shuffle` each frame chunk is compressed on its own, so frames can still be read in any order.
+ * The tool reports the compression ratio. Reads shrink by that ratio, for a decode that runs at over 1 GB/s on one core; see benchvols' `chunk_decode`.
+ *
+ * Usage Instructions
+ * ------------------
+ *     ./streamvols.bin -c MYFILE.VOLS -o MYFILE.VOLP
+ *     ./streamvols.bin -h HEADER.VOLS -s SEQUENCE.VOLS -o MYFILE.VOLP
+ *     ./streamvols.bin -c MYFILE.VOLS -o MYFILE.VOLP --compress lz4-shuffle
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make streamvols`
+ *
+ * History
+ * -----------
+ * - 0.2.0   (2026/10/18) - New --compress option for LZ4 or byte-shuffled LZ4 frame chunks.
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_geom.h"       // Volograms' .vols file parsing library.
+#include "vol_geom_write.h" // Volograms' .vols file writing library.
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_COMBINED, CL_COMPRESS, CL_HEADER, CL_HELP, CL_OUTPUT, CL_SEQUENCE, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
+  { "--compress", "-z", "Optional. The next argument is the frame chunk codec: none (default), lz4, or lz4-shuffle.\n", 1 },       // CL_COMPRESS
+  { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output", "-o", "Required. The next argument gives the path of the playback container to write, e.g. myfile.volp.\n", 1 },   // CL_OUTPUT
+  { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }  // CL_SEQUENCE
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_geom_info_t _geom_info; // Mesh information from vol_geom library.
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** Write every frame of the open vologram to a playback container. Frames are read and written one at a time. */
+static bool _write_container( const char* seq_filename, const char* output_filename, vol_geom_codec_t codec ) {
+  uint32_t n_frames                      = _geom_info.hdr.frame_count;
+  vol_geom_playback_entry_t* entries_ptr = calloc( n_frames > 0 ? n_frames : 1, sizeof( vol_geom_playback_entry_t ) );
+  if ( !entries_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory.\n" );
+    return false;
+  }
+  FILE* f_ptr = fopen( output_filename, "wb" );
+  if ( !f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", output_filename );
+    free( entries_ptr );
+    return false;
+  }
+  if ( !vol_geom_write_playback_hdr( f_ptr, &_geom_info.hdr, _geom_info.audio_data_ptr, _geom_info.audio_data_ptr ? _geom_info.audio_data_sz : 0 ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Writing header to `%s`.\n", output_filename );
+    goto _wc_fail;
+  }
+
+  for ( uint32_t i = 0; i < n_frames; i++ ) {
+    vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+    vol_geom_write_frame_t write_frame;
+    if ( !vol_geom_read_frame( seq_filename, &_geom_info, i, &frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %u.\n", i );
+      goto _wc_fail;
+    }
+    vol_geom_write_frame_from_data( &_geom_info, i, frame_data.block_data_ptr, &frame_data, &write_frame );
+    if ( !vol_geom_write_playback_frame( f_ptr, &_geom_info.hdr, &write_frame, codec, &entries_ptr[i] ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame %u to `%s`. Check disk space and permissions.\n", i, output_filename );
+      goto _wc_fail;
+    }
+  }
+  if ( !vol_geom_write_playback_index( f_ptr, entries_ptr, n_frames ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame index to `%s`.\n", output_filename );
+    goto _wc_fail;
+  }
+
+  if ( 0 != fclose( f_ptr ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Closing `%s`. Check disk space.\n", output_filename );
+    free( entries_ptr );
+    return false;
+  }
+  uint64_t raw_sz = 0, stored_sz = 0;
+  for ( uint32_t i = 0; i < n_frames; i++ ) {
+    raw_sz += entries_ptr[i].raw_sz;
+    stored_sz += entries_ptr[i].stored_sz;
+  }
+  free( entries_ptr );
+  _printlog( _LOG_TYPE_INFO, "Wrote %u frames to `%s`\n", n_frames, output_filename );
+  if ( VOL_GEOM_CODEC_NONE != codec && stored_sz > 0 ) {
+    _printlog( _LOG_TYPE_INFO, "Frames compressed from %llu to %llu bytes (%.2fx)\n", (unsigned long long)raw_sz, (unsigned long long)stored_sz,
+      (double)raw_sz / (double)stored_sz );
+  }
+  return true;
+
+_wc_fail:
+  fclose( f_ptr );
+  free( entries_ptr );
+  return false;
+}
+
+int main( int argc, char** argv ) {
+  const char* combined_filename = NULL;
+  const char* header_filename   = NULL;
+  const char* sequence_filename = NULL;
+  const char* output_filename   = NULL;
+  vol_geom_codec_t codec        = VOL_GEOM_CODEC_NONE;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf( "Usage for single-file volograms:\n%s -c MYFILE.VOLS -o MYFILE.VOLP\n\n", argv[0] );
+    printf( "Usage for multi-file volograms:\n%s -h HEADER.VOLS -s SEQUENCE.VOLS -o MYFILE.VOLP\n\n", argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_HEADER] ) { header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_filename = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( !output_filename || !( combined_filename || ( header_filename && sequence_filename ) ) ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --combined, or --header and --sequence, or --output is missing. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( _option_arg_indices[CL_COMPRESS] ) {
+    const char* codec_str = my_argv[_option_arg_indices[CL_COMPRESS] + 1];
+    if ( 0 == strcasecmp( codec_str, "lz4" ) ) {
+      codec = VOL_GEOM_CODEC_LZ4;
+    } else if ( 0 == strcasecmp( codec_str, "lz4-shuffle" ) ) {
+      codec = VOL_GEOM_CODEC_LZ4_SHUFFLE;
+    } else if ( 0 != strcasecmp( codec_str, "none" ) ) {
+      _printlog( _LOG_TYPE_WARNING, "Unknown --compress codec '%s'. Use none, lz4, or lz4-shuffle.\n", codec_str );
+      return 1;
+    }
+  }
+
+  if ( combined_filename ) {
+    if ( !vol_geom_create_file_info_from_file( combined_filename, &_geom_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open combined vologram file=%s.\n", combined_filename );
+      return 1;
+    }
+    if ( _geom_info.playback_version > 0 ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: `%s` is already a playback container.\n", combined_filename );
+      vol_geom_free_file_info( &_geom_info );
+      return 1;
+    }
+  } else if ( !vol_geom_create_file_info( header_filename, sequence_filename, &_geom_info, true ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open geometry files header=%s sequence=%s.\n", header_filename, sequence_filename );
+    return 1;
+  }
+  if ( !_geom_info.hdr.textured ) {
+    _printlog( _LOG_TYPE_INFO, "Vologram has no per-frame textures. Keep its texture video, if any, alongside `%s`.\n", output_filename );
+  }
+
+  bool success = _write_container( combined_filename ? combined_filename : sequence_filename, output_filename, codec );
+  vol_geom_free_file_info( &_geom_info );
+  if ( !success ) { return 1; }
+
+  _printlog( _LOG_TYPE_SUCCESS, "Vologram conversion completed.\n" );
+  return 0;
+}
@@ -0,0 +1,415 @@
+/** @file main.c
+ * Volograms texture variants tool.
+ *
+ * texvols   | Write downscaled texture videos for a vologram in a single pass.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99, C++11
+ * Files     | 1
+ * Licence   | The MIT License. Note that dependencies have separate licences.
+ *           | See LICENSE.md for details.
+ *
+ * Delivery needs a vologram's texture at several resolutions, e.g. 2048, 1024, and 512.
+ * This tool decodes each texture frame once, resizes it for every requested size, and encodes each size to its own H.264 video, in parallel.
+ * Outputs are named like the textures of multi-file volograms, e.g. `texture_1024_h264.mp4`, so they can be used with the original header and sequence files.
+ *
+ * The input can be the video texture of a multi-file vologram, or a single-file v1.3 vologram with Basis Universal textures.
+ * Writing Basis Universal textures is not supported because this repository only includes the Basis Universal transcoder, not the encoder,
+ * so both kinds of input produce H.264 videos.
+ *
+ * Usage Instructions
+ * ------------------
+ * For older multi-file volograms:
+ *     ./texvols.bin -v texture_2048_h264.mp4 -o OUTPUT_DIR
+ *
+ * For single-file volograms with Basis Universal textures:
+ *     ./texvols.bin -c MYFILE.VOLS -o OUTPUT_DIR
+ *
+ * To choose the sizes:
+ *     ./texvols.bin -v texture_2048_h264.mp4 --sizes 1024,512,256
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make texvols`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_av.h"     // Volograms' texture video library.
+#include "vol_basis.h"  // Volograms' Basis Universal wrapper library.
+#include "vol_geom.h"   // Volograms' .vols file parsing library.
+#include "vol_image.h"  // Volograms' image processing library.
+#include "vol_thread.h" // Volograms' threading helpers.
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define MAX_FILENAME_LEN 4096
+#define MAX_VARIANTS 8
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_BIT_RATE, CL_COMBINED, CL_HELP, CL_OUTPUT_DIR, CL_SIZES, CL_VIDEO, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** One output size, with its encoder and working memory. */
+typedef struct _variant_t {
+  int w, h;
+  uint8_t* pixels_ptr; // Resized image. NULL if the variant is the same size as the source.
+  vol_av_encoder_t encoder;
+  bool failed;
+} _variant_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--bit-rate", "-b",                                                                                                            // CL_BIT_RATE
+    "The next argument gives the target bit rate, in kilobits per second per megapixel of texture.\n"                              //
+    "Each size gets the same quality. Default 2000, which is about 8 Mbps for 2048x2048.\n",                                       //
+    1 },                                                                                                                           //
+  { "--combined", "-c", "For single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },                 // CL_COMBINED
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output-dir", "-o",                                                                                                          // CL_OUTPUT_DIR
+    "The next argument gives the path to an existing directory to write output files into.\n"                                      //
+    "Default is the current working directory.\n",                                                                                 //
+    1 },                                                                                                                           //
+  { "--sizes", "-z",                                                                                                               // CL_SIZES
+    "The next argument gives a comma-separated list of the widths to write, e.g. 2048,1024,512.\n"                                 //
+    "Heights keep the aspect ratio of the input. Default 2048,1024,512.\n",                                                        //
+    1 },                                                                                                                           //
+  { "--video", "-v", "For multi-file volograms. The next argument gives the path to the video texture file.\n", 1 }                // CL_VIDEO
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_av_video_t _av_info;    // Audio-video information from vol_av library.
+static vol_geom_info_t _geom_info; // Mesh information from vol_geom library.
+
+static _variant_t _variants[MAX_VARIANTS];
+static int _n_variants;
+
+// Current source frame, shared read-only by the variant workers.
+static const uint8_t* _src_pixels_ptr;
+static int _src_w, _src_h, _src_n_chans;
+
+// Basis Universal.
+static uint8_t* _basis_rgba_ptr; // Transcoded RGBA image of the current frame.
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** Parse a list like "2048,1024,512" into `widths_ptr`. Returns the number of widths, or 0 on error. */
+static int _parse_sizes( const char* sizes_str, int* widths_ptr, int max_widths ) {
+  int n         = 0;
+  const char* c = sizes_str;
+  while ( *c ) {
+    char* end_ptr = NULL;
+    long w        = strtol( c, &end_ptr, 10 );
+    if ( end_ptr == c || w < 16 || w > 16384 || n >= max_widths ) { return 0; }
+    widths_ptr[n++] = (int)w;
+    c               = end_ptr;
+    if ( ',' == *c ) { c++; }
+  }
+  return n;
+}
+
+/** Resize the current source frame for one variant and encode it. Called from worker threads, one variant each. */
+static void _encode_variant( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  (void)user_ptr;
+  _variant_t* v_ptr         = &_variants[item_idx];
+  const uint8_t* pixels_ptr = _src_pixels_ptr;
+  if ( v_ptr->failed ) { return; }
+  if ( v_ptr->pixels_ptr ) {
+    if ( !vol_image_resize( _src_pixels_ptr, _src_w, _src_h, _src_n_chans, v_ptr->pixels_ptr, v_ptr->w, v_ptr->h ) ) {
+      v_ptr->failed = true;
+      return;
+    }
+    pixels_ptr = v_ptr->pixels_ptr;
+  }
+  if ( !vol_av_encoder_write_frame( &v_ptr->encoder, pixels_ptr ) ) { v_ptr->failed = true; }
+}
+
+/** Decode the texture of frame `frame_idx` into `_src_pixels_ptr`. Frames must be requested in order. */
+static bool _decode_frame( const char* combined_filename, int frame_idx ) {
+  if ( !combined_filename ) {
+    if ( !vol_av_read_next_frame( &_av_info ) ) { return false; }
+    _src_pixels_ptr = _av_info.pixels_ptr;
+    _src_w          = _av_info.w;
+    _src_h          = _av_info.h;
+    _src_n_chans    = 3;
+    return true;
+  }
+
+  vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+  if ( !vol_geom_read_frame( combined_filename, &_geom_info, frame_idx, &frame_data ) ) { return false; }
+  int w = 0, h = 0;
+
+  int format      = 13; // { 13 = cTFRGBA32, 3 = cTFBC3_RGBA }. Defined in basis_transcoder.h.
+  uint32_t out_sz = _geom_info.hdr.texture_width * _geom_info.hdr.texture_height * 4;
+  if ( !vol_basis_transcode( format, &frame_data.block_data_ptr[frame_data.texture_offset], frame_data.texture_sz, _basis_rgba_ptr, out_sz, &w, &h ) ) {
+    return false;
+  }
+  if ( w != (int)_geom_info.hdr.texture_width || h != (int)_geom_info.hdr.texture_height ) { return false; }
+  _src_pixels_ptr = _basis_rgba_ptr;
+  _src_w          = w;
+  _src_h          = h;
+  _src_n_chans    = 4;
+  return true;
+}
+
+static bool _process_vologram( const char* combined_filename, const char* video_filename, const char* output_dir, const int* widths_ptr, int n_widths,
+  int64_t kbps_per_mp ) {
+  int src_w = 0, src_h = 0, n_chans = 3, n_frames = 0;
+  double fps = 0.0;
+
+  // Open the source.
+  if ( combined_filename ) {
+    if ( !vol_geom_create_file_info_from_file( combined_filename, &_geom_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open combined vologram file=%s.\n", combined_filename );
+      return false;
+    }
+    if ( _geom_info.hdr.version < 13 || !_geom_info.hdr.textured || 1 != _geom_info.hdr.texture_compression ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: `%s` does not have Basis Universal textures. For older volograms use --video.\n", combined_filename );
+      return false;
+    }
+    if ( !vol_basis_init() ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to initialise Basis transcoder.\n" );
+      return false;
+    }
+    src_w           = (int)_geom_info.hdr.texture_width;
+    src_h           = (int)_geom_info.hdr.texture_height;
+    n_chans         = 4;
+    n_frames        = (int)_geom_info.hdr.frame_count;
+    fps             = _geom_info.hdr.fps;
+    _basis_rgba_ptr = malloc( (size_t)src_w * src_h * 4 );
+    if ( !_basis_rgba_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory allocating texture of %ix%i.\n", src_w, src_h );
+      return false;
+    }
+  } else {
+    if ( !vol_av_open( video_filename, &_av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open video file %s.\n", video_filename );
+      return false;
+    }
+    vol_av_dimensions( &_av_info, &src_w, &src_h );
+    n_frames = (int)vol_av_frame_count( &_av_info );
+    fps      = vol_av_frame_rate( &_av_info );
+  }
+  if ( src_w <= 0 || src_h <= 0 || n_frames <= 0 || fps <= 0.0 ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Input texture has invalid dimensions (%ix%i), frame count (%i), or frame rate (%f).\n", src_w, src_h, n_frames, fps );
+    return false;
+  }
+  _printlog( _LOG_TYPE_INFO, "Input texture is %ix%i, %i frames at %.2f fps.\n", src_w, src_h, n_frames, fps );
+
+  // Open an encoder per size.
+  for ( int i = 0; i < n_widths; i++ ) {
+    _variant_t* v_ptr = &_variants[_n_variants];
+    char filename[MAX_FILENAME_LEN];
+    v_ptr->w = widths_ptr[i];
+    v_ptr->h = (int)( (int64_t)src_h * widths_ptr[i] / src_w ) & ~1; // H.264 with 4:2:0 chroma needs even dimensions.
+    _n_variants++;                                                   // Counted now so that anything allocated is released on failure.
+    if ( v_ptr->w > src_w ) { _printlog( _LOG_TYPE_WARNING, "WARNING: Size %i is bigger than the input texture. It will be upscaled.\n", v_ptr->w ); }
+    if ( v_ptr->w != src_w || v_ptr->h != src_h ) {
+      v_ptr->pixels_ptr = malloc( (size_t)v_ptr->w * v_ptr->h * n_chans );
+      if ( !v_ptr->pixels_ptr ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory allocating texture of %ix%i.\n", v_ptr->w, v_ptr->h );
+        return false;
+      }
+    }
+    snprintf( filename, MAX_FILENAME_LEN, "%stexture_%i_h264.mp4", output_dir, v_ptr->w );
+    int64_t bit_rate = kbps_per_mp * 1000 * v_ptr->w * v_ptr->h / ( 1000 * 1000 );
+    if ( !vol_av_encoder_open( filename, v_ptr->w, v_ptr->h, n_chans, fps, bit_rate > 0 ? bit_rate : 1, &v_ptr->encoder ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open `%s` for encoding.\n", filename );
+      return false;
+    }
+    _printlog( _LOG_TYPE_INFO, "Writing `%s` at %ix%i, %lld kbps.\n", filename, v_ptr->w, v_ptr->h, (long long)( bit_rate / 1000 ) );
+  }
+
+  // Decode each frame once, then resize and encode every size in parallel.
+  for ( int i = 0; i < n_frames; i++ ) {
+    if ( !_decode_frame( combined_filename, i ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Decoding texture frame %i.\n", i );
+      return false;
+    }
+    if ( _src_w != src_w || _src_h != src_h ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Texture frame %i is %ix%i, but the first frame was %ix%i.\n", i, _src_w, _src_h, src_w, src_h );
+      return false;
+    }
+    vol_thread_parallel_for( (uint32_t)_n_variants, (uint32_t)_n_variants, _encode_variant, NULL );
+    for ( int v = 0; v < _n_variants; v++ ) {
+      if ( _variants[v].failed ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Encoding frame %i of the %ix%i texture.\n", i, _variants[v].w, _variants[v].h );
+        return false;
+      }
+    }
+    if ( 0 == ( i + 1 ) % 100 || i + 1 == n_frames ) { _printlog( _LOG_TYPE_INFO, "Frame %i/%i\n", i + 1, n_frames ); }
+  }
+
+  return true;
+}
+
+int main( int argc, char** argv ) {
+  const char* combined_filename = NULL;
+  const char* video_filename    = NULL;
+  char output_dir[MAX_FILENAME_LEN];
+  int widths[MAX_VARIANTS] = { 2048, 1024, 512 };
+  int n_widths             = 3;
+  int64_t kbps_per_mp      = 2000;
+
+  output_dir[0] = '\0';
+  my_argc       = argc;
+  my_argv       = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf(
+      "Usage for single-file volograms:\n"
+      "%s [OPTIONS] -c MYFILE.VOLS\n\n"
+      "Usage for multi-file volograms:\n"
+      "%s [OPTIONS] -v VIDEO.MP4\n\n",
+      argv[0], argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_VIDEO] ) { video_filename = my_argv[_option_arg_indices[CL_VIDEO] + 1]; }
+  if ( !combined_filename == !video_filename ) {
+    _printlog( _LOG_TYPE_WARNING, "One of --combined or --video is required. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( _option_arg_indices[CL_OUTPUT_DIR] ) {
+    const char* dir_str = my_argv[_option_arg_indices[CL_OUTPUT_DIR] + 1];
+    size_t len          = strlen( dir_str );
+    if ( len > MAX_FILENAME_LEN - 64 ) {
+      _printlog( _LOG_TYPE_WARNING, "Output directory path is too long.\n" );
+      return 1;
+    }
+    strcpy( output_dir, dir_str );
+    if ( len > 0 && output_dir[len - 1] != '/' && output_dir[len - 1] != '\\' ) { strcat( output_dir, "/" ); }
+  }
+  if ( _option_arg_indices[CL_SIZES] ) {
+    n_widths = _parse_sizes( my_argv[_option_arg_indices[CL_SIZES] + 1], widths, MAX_VARIANTS );
+    if ( 0 == n_widths ) {
+      _printlog( _LOG_TYPE_WARNING, "--sizes must be a comma-separated list of up to %i widths between 16 and 16384.\n", MAX_VARIANTS );
+      return 1;
+    }
+  }
+  if ( _option_arg_indices[CL_BIT_RATE] ) {
+    kbps_per_mp = atoll( my_argv[_option_arg_indices[CL_BIT_RATE] + 1] );
+    if ( kbps_per_mp <= 0 ) {
+      _printlog( _LOG_TYPE_WARNING, "--bit-rate must be a positive number.\n" );
+      return 1;
+    }
+  }
+
+  bool success = _process_vologram( combined_filename, video_filename, output_dir, widths, n_widths, kbps_per_mp );
+
+  for ( int i = 0; i < _n_variants; i++ ) {
+    if ( !vol_av_encoder_close( &_variants[i].encoder ) ) { success = false; }
+    free( _variants[i].pixels_ptr );
+  }
+  if ( _av_info._context_ptr ) { vol_av_close( &_av_info ); }
+  if ( combined_filename ) { vol_geom_free_file_info( &_geom_info ); }
+  free( _basis_rgba_ptr );
+  if ( !success ) { return 1; }
+
+  _printlog( _LOG_TYPE_SUCCESS, "Texture variants completed.\n" );
+  return 0;
+}
@@ -0,0 +1,914 @@
+/** @file main.c
+ * Volograms thumbnail and preview renderer.
+ *
+ * thumbvols | Render textured thumbnails, contact sheets, and preview videos of a vologram on the CPU.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99, C++11
+ * Files     | 1
+ * Licence   | The MIT License. Note that dependencies have separate licences.
+ *           | See LICENSE.md for details.
+ *
+ * Asset browsers need a posed picture of every vologram, and render nodes often have no GPU, so this tool has a small software rasteriser.
+ * It renders frame N, or every Kth frame, to images, to a single contact sheet image, and/or to an H.264 preview video.
+ *
+ * The camera looks at the first rendered frame's bounding box, from the front (-Z in vologram space), and can orbit with `--yaw`.
+ * The same camera is used for every frame so that motion is visible in a contact sheet.
+ * Textures come from per-frame Basis Universal textures (v1.3), or a video texture given with `--video`. Untextured volograms are shaded grey.
+ *
+ * Rendering a frame has three parallel steps, each split across the same number of lanes (threads):
+ *  1. Vertices are projected to screen space, with 1/z, u/z, and v/z for perspective-correct interpolation.
+ *  2. Triangles are set up four at a time with SSE2, where available, to reject back faces and off-screen triangles and to find their bounding boxes.
+ *     Each lane bins its contiguous range of triangles into per-lane lists for the screen tiles they overlap.
+ *  3. Each lane rasterises every Nth tile, reading every lane's list for that tile in lane order, so output doesn't depend on the thread count.
+ * Large textures are first downscaled to about twice the output size, which acts as a cheap mip level.
+ *
+ * Usage Instructions
+ * ------------------
+ * A 256x256 thumbnail of frame 0 of a single-file vologram, written to `thumb_00000000.jpg`:
+ *     ./thumbvols.bin -c MYFILE.VOLS
+ *
+ * A contact sheet of every 10th frame of a multi-file vologram:
+ *     ./thumbvols.bin -h HEADER.VOLS -s SEQUENCE.VOLS -v VIDEO.MP4 --every 10 --sheet sheet.jpg
+ *
+ * A 320x240 preview video of every 2nd frame:
+ *     ./thumbvols.bin -c MYFILE.VOLS --every 2 --size 320x240 --preview preview.mp4
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make thumbvols`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_av.h"     // Volograms' texture video library.
+#include "vol_basis.h"  // Volograms' Basis Universal wrapper library.
+#include "vol_geom.h"   // Volograms' .vols file parsing library.
+#include "vol_image.h"  // Volograms' image processing library.
+#include "vol_thread.h" // Volograms' threading helpers.
+#include "vol_trace.h"  // Volograms' profiling markers.
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb/stb_image_write.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define THUMB_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define MAX_FILENAME_LEN 4096
+#define THUMB_TILE_DIMS 32              // Width and height of a rasteriser tile, in pixels.
+#define THUMB_VFOV_DEG 30.0f            // Vertical field of view.
+#define THUMB_NEAR 0.01f                // Vertices closer to the camera than this are not drawn.
+#define THUMB_JPEG_QUALITY 90           //
+#define THUMB_BACKGROUND_RGB 0x202020   // Clear colour.
+#define THUMB_MAX_DIMS 8192             // Largest allowed output width or height.
+#define THUMB_SUBPIXELS 256             // Fixed-point subpixel steps per pixel, for edge functions.
+#define THUMB_GUARD_BAND 65536.0f       // Triangles with a vertex further off-screen than this, in pixels, are dropped, to keep within fixed-point range.
+#define THUMB_PREVIEW_KBPS_PER_MP 2000  // Preview video bit rate, in kilobits per second per megapixel, as texvols' default.
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t {
+  CL_COLUMNS,
+  CL_COMBINED,
+  CL_EVERY,
+  CL_FRAME,
+  CL_HEADER,
+  CL_HELP,
+  CL_OUTPUT,
+  CL_PNG,
+  CL_PREVIEW,
+  CL_SEQUENCE,
+  CL_SHEET,
+  CL_SIZE,
+  CL_THREADS,
+  CL_VIDEO,
+  CL_YAW,
+  CL_MAX
+} cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** A growable list of the triangles that overlap one tile, written by one lane. */
+typedef struct _bin_t {
+  uint32_t* tris_ptr;
+  uint32_t n, capacity;
+} _bin_t;
+
+/** Everything needed to render the current frame. Shared read-only by the worker threads, except where noted. */
+typedef struct _renderer_t {
+  int w, h, n_tiles_x, n_tiles_y;
+  uint32_t n_lanes;
+  uint8_t* rgb_ptr;  // Colour buffer, 3 bytes per pixel. Each tile is only written by the lane that rasterises it.
+  float* depth_ptr;  // 1/z per pixel. 0 is infinitely far away.
+  _bin_t* bins_ptr;  // `n_lanes` * `n_tiles` bins. Lane L writes bins [L * n_tiles, (L + 1) * n_tiles).
+  bool* lane_failed; // Set by a lane that ran out of memory binning.
+
+  // Camera. Vologram space is left-handed, Y up, as in Unity.
+  float eye[3], right[3], fwd[3], focal_px;
+
+  // Current frame mesh.
+  const float* vertices_ptr;
+  const float* uvs_ptr; // NULL if untextured.
+  const void* indices_ptr;
+  uint32_t n_vertices, n_tris;
+  bool u32_indices;
+
+  // Per-vertex projection of the current frame. `iz` is 0 for vertices behind the near plane.
+  float *sx_ptr, *sy_ptr, *iz_ptr, *uz_ptr, *vz_ptr;
+
+  // Current frame texture. NULL if untextured.
+  const uint8_t* tex_ptr;
+  int tex_w, tex_h, tex_n;
+} _renderer_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--columns", NULL,                                                                                                             // CL_COLUMNS
+    "The next argument gives the number of columns in the --sheet. Default is enough to make the sheet about square.\n",           //
+    1 },                                                                                                                           //
+  { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
+  { "--every", "-e", "The next argument gives K, to render every Kth frame, starting from --frame.\n", 1 },                        // CL_EVERY
+  { "--frame", "-f",                                                                                                               // CL_FRAME
+    "The next argument gives the frame number to render, or the first frame if --every is given. Default 0.\n",                    //
+    1 },                                                                                                                           //
+  { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output", "-o",                                                                                                              // CL_OUTPUT
+    "The next argument gives a prefix for per-frame image files, e.g. `my_dir/thumb_` writes `my_dir/thumb_00000000.jpg`.\n"       //
+    "Default `thumb_`. Per-frame images are written if this is given, or if neither --sheet nor --preview are given.\n",           //
+    1 },                                                                                                                           //
+  { "--png", NULL, "Write per-frame images as PNG instead of JPEG.\n", 0 },                                                        // CL_PNG
+  { "--preview", "-p", "The next argument gives the path to write an H.264 .mp4 preview video of the rendered frames to.\n", 1 },  // CL_PREVIEW
+  { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }, // CL_SEQUENCE
+  { "--sheet", NULL,                                                                                                               // CL_SHEET
+    "The next argument gives the path to write a contact sheet of all rendered frames to.\n"                                       //
+    "PNG if the path ends in .png, otherwise JPEG.\n",                                                                             //
+    1 },                                                                                                                           //
+  { "--size", "-z", "The next argument gives the size of each rendered frame, e.g. 320x240. Default 256x256.\n", 1 },              // CL_SIZE
+  { "--threads", "-t",                                                                                                             // CL_THREADS
+    "The next argument gives the number of threads to render with. Default is one per logical processor.\n",                       //
+    1 },                                                                                                                           //
+  { "--video", "-v",                                                                                                               // CL_VIDEO
+    "The next argument gives the path to the video texture file, for multi-file volograms or packvols output.\n",                  //
+    1 },                                                                                                                           //
+  { "--yaw", "-y", "The next argument gives the camera's angle around the vologram in degrees. Default 0, the front.\n", 1 }       // CL_YAW
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_av_video_t _av_info;    // Audio-video information from vol_av library.
+static vol_geom_info_t _geom_info; // Mesh information from vol_geom library.
+static int _av_frame_idx = -1;     // Index of the video frame currently in `_av_info.pixels_ptr`.
+
+// Keyframes hold the indices and UVs for the frames that follow them, so a copy of the most recent one is kept.
+static uint8_t* _key_blob_ptr;
+static vol_geom_frame_data_t _key_frame_data;
+static int _prev_key_frame_loaded_idx = -1;
+
+static uint8_t* _basis_rgba_ptr; // Transcoded texture of the current frame, for Basis Universal textures.
+static uint8_t* _tex_small_ptr;  // Downscaled texture of the current frame. NULL if textures are used at their original size.
+static int _tex_small_w, _tex_small_h;
+
+static _renderer_t _rdr;
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        // Negative numbers are allowed as parameters, e.g. `--yaw -90`.
+        const char* param_str = argv_idx + following_idx < my_argc ? my_argv[argv_idx + following_idx] : NULL;
+        if ( !param_str || ( '-' == param_str[0] && !( param_str[1] >= '0' && param_str[1] <= '9' ) ) ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** @returns A monotonic time in seconds. */
+static double _time_s( void ) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency( &freq );
+  QueryPerformanceCounter( &count );
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static uint32_t _index( uint32_t i ) {
+  return _rdr.u32_indices ? ( (const uint32_t*)_rdr.indices_ptr )[i] : ( (const uint16_t*)_rdr.indices_ptr )[i];
+}
+
+/** Step 1. Project one lane's range of vertices to screen space. */
+static void _project_lane( uint32_t lane_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  (void)user_ptr;
+  uint32_t first_idx = (uint32_t)( (uint64_t)_rdr.n_vertices * lane_idx / _rdr.n_lanes );
+  uint32_t end_idx   = (uint32_t)( (uint64_t)_rdr.n_vertices * ( lane_idx + 1 ) / _rdr.n_lanes );
+  float half_w = 0.5f * (float)_rdr.w, half_h = 0.5f * (float)_rdr.h;
+  for ( uint32_t i = first_idx; i < end_idx; i++ ) {
+    const float* p_ptr = &_rdr.vertices_ptr[i * 3];
+    float d[3]         = { p_ptr[0] - _rdr.eye[0], p_ptr[1] - _rdr.eye[1], p_ptr[2] - _rdr.eye[2] };
+    float x            = d[0] * _rdr.right[0] + d[2] * _rdr.right[2];
+    float z            = d[0] * _rdr.fwd[0] + d[2] * _rdr.fwd[2];
+    float iz           = z > THUMB_NEAR ? 1.0f / z : 0.0f;
+    _rdr.sx_ptr[i]     = half_w + x * _rdr.focal_px * iz;
+    _rdr.sy_ptr[i]     = half_h - d[1] * _rdr.focal_px * iz;
+    _rdr.iz_ptr[i]     = iz;
+    if ( _rdr.uvs_ptr ) {
+      _rdr.uz_ptr[i] = _rdr.uvs_ptr[i * 2 + 0] * iz;
+      _rdr.vz_ptr[i] = _rdr.uvs_ptr[i * 2 + 1] * iz;
+    }
+  }
+}
+
+/** Add a triangle to the bins of the tiles its bounding box overlaps. */
+static void _bin_tri( uint32_t lane_idx, uint32_t tri_idx, float min_x, float min_y, float max_x, float max_y ) {
+  int tx0 = (int)min_x / THUMB_TILE_DIMS, ty0 = (int)min_y / THUMB_TILE_DIMS;
+  int tx1 = (int)max_x / THUMB_TILE_DIMS, ty1 = (int)max_y / THUMB_TILE_DIMS;
+  tx0     = tx0 < 0 ? 0 : tx0;
+  ty0     = ty0 < 0 ? 0 : ty0;
+  tx1     = tx1 < _rdr.n_tiles_x ? tx1 : _rdr.n_tiles_x - 1;
+  ty1     = ty1 < _rdr.n_tiles_y ? ty1 : _rdr.n_tiles_y - 1;
+  _bin_t* lane_bins_ptr = &_rdr.bins_ptr[lane_idx * _rdr.n_tiles_x * _rdr.n_tiles_y];
+  for ( int ty = ty0; ty <= ty1; ty++ ) {
+    for ( int tx = tx0; tx <= tx1; tx++ ) {
+      _bin_t* bin_ptr = &lane_bins_ptr[ty * _rdr.n_tiles_x + tx];
+      if ( bin_ptr->n == bin_ptr->capacity ) {
+        uint32_t capacity = bin_ptr->capacity ? bin_ptr->capacity * 2 : 256;
+        uint32_t* new_ptr = realloc( bin_ptr->tris_ptr, capacity * sizeof( uint32_t ) );
+        if ( !new_ptr ) {
+          _rdr.lane_failed[lane_idx] = true;
+          return;
+        }
+        bin_ptr->tris_ptr = new_ptr;
+        bin_ptr->capacity = capacity;
+      }
+      bin_ptr->tris_ptr[bin_ptr->n++] = tri_idx;
+    }
+  }
+}
+
+/** Fetch a triangle's screen-space corners into lane `k` of the setup arrays. Out-of-range indices get an `iz` of 0, so the triangle is rejected. */
+static void _gather_tri( uint32_t tri_idx, int k, float* x0, float* y0, float* x1, float* y1, float* x2, float* y2, float* iz ) {
+  uint32_t a = _index( tri_idx * 3 + 0 ), b = _index( tri_idx * 3 + 1 ), c = _index( tri_idx * 3 + 2 );
+  if ( a >= _rdr.n_vertices || b >= _rdr.n_vertices || c >= _rdr.n_vertices ) {
+    x0[k] = y0[k] = x1[k] = y1[k] = x2[k] = y2[k] = iz[k] = 0.0f;
+    return;
+  }
+  x0[k] = _rdr.sx_ptr[a];
+  y0[k] = _rdr.sy_ptr[a];
+  x1[k] = _rdr.sx_ptr[b];
+  y1[k] = _rdr.sy_ptr[b];
+  x2[k] = _rdr.sx_ptr[c];
+  y2[k] = _rdr.sy_ptr[c];
+  float iz_min = _rdr.iz_ptr[a] < _rdr.iz_ptr[b] ? _rdr.iz_ptr[a] : _rdr.iz_ptr[b];
+  iz[k]        = iz_min < _rdr.iz_ptr[c] ? iz_min : _rdr.iz_ptr[c];
+}
+
+/** Step 2. Set up and bin one lane's contiguous range of triangles.
+ * Vologram triangles are clockwise when front-facing with Y up, which is anticlockwise, a positive area below, on a Y-down screen.
+ */
+static void _bin_lane( uint32_t lane_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  (void)user_ptr;
+  uint32_t n_tiles   = (uint32_t)( _rdr.n_tiles_x * _rdr.n_tiles_y );
+  uint32_t first_idx = (uint32_t)( (uint64_t)_rdr.n_tris * lane_idx / _rdr.n_lanes );
+  uint32_t end_idx   = (uint32_t)( (uint64_t)_rdr.n_tris * ( lane_idx + 1 ) / _rdr.n_lanes );
+  float w = (float)_rdr.w, h = (float)_rdr.h;
+  for ( uint32_t i = 0; i < n_tiles; i++ ) { _rdr.bins_ptr[lane_idx * n_tiles + i].n = 0; }
+
+  float x0[4], y0[4], x1[4], y1[4], x2[4], y2[4], iz[4];
+  uint32_t t = first_idx;
+#ifdef THUMB_SSE2
+  for ( ; t + 4 <= end_idx; t += 4 ) {
+    for ( int k = 0; k < 4; k++ ) { _gather_tri( t + k, k, x0, y0, x1, y1, x2, y2, iz ); }
+    __m128 X0 = _mm_loadu_ps( x0 ), Y0 = _mm_loadu_ps( y0 );
+    __m128 X1 = _mm_loadu_ps( x1 ), Y1 = _mm_loadu_ps( y1 );
+    __m128 X2 = _mm_loadu_ps( x2 ), Y2 = _mm_loadu_ps( y2 );
+    __m128 area  = _mm_sub_ps( _mm_mul_ps( _mm_sub_ps( X1, X0 ), _mm_sub_ps( Y2, Y0 ) ), _mm_mul_ps( _mm_sub_ps( X2, X0 ), _mm_sub_ps( Y1, Y0 ) ) );
+    __m128 min_x = _mm_min_ps( _mm_min_ps( X0, X1 ), X2 ), max_x = _mm_max_ps( _mm_max_ps( X0, X1 ), X2 );
+    __m128 min_y = _mm_min_ps( _mm_min_ps( Y0, Y1 ), Y2 ), max_y = _mm_max_ps( _mm_max_ps( Y0, Y1 ), Y2 );
+    __m128 zero  = _mm_setzero_ps();
+    __m128 guard = _mm_set1_ps( THUMB_GUARD_BAND );
+    __m128 keep  = _mm_and_ps( _mm_cmpgt_ps( area, zero ), _mm_cmpgt_ps( _mm_loadu_ps( iz ), zero ) );
+    keep         = _mm_and_ps( keep, _mm_and_ps( _mm_cmpge_ps( max_x, zero ), _mm_cmplt_ps( min_x, _mm_set1_ps( w ) ) ) );
+    keep         = _mm_and_ps( keep, _mm_and_ps( _mm_cmpge_ps( max_y, zero ), _mm_cmplt_ps( min_y, _mm_set1_ps( h ) ) ) );
+    keep         = _mm_and_ps( keep, _mm_and_ps( _mm_cmpgt_ps( min_x, _mm_sub_ps( zero, guard ) ), _mm_cmplt_ps( max_x, guard ) ) );
+    keep         = _mm_and_ps( keep, _mm_and_ps( _mm_cmpgt_ps( min_y, _mm_sub_ps( zero, guard ) ), _mm_cmplt_ps( max_y, guard ) ) );
+    int mask     = _mm_movemask_ps( keep );
+    if ( !mask ) { continue; }
+    float bb[4][4];
+    _mm_storeu_ps( bb[0], min_x );
+    _mm_storeu_ps( bb[1], min_y );
+    _mm_storeu_ps( bb[2], max_x );
+    _mm_storeu_ps( bb[3], max_y );
+    for ( int k = 0; k < 4; k++ ) {
+      if ( mask & ( 1 << k ) ) { _bin_tri( lane_idx, t + k, bb[0][k], bb[1][k], bb[2][k], bb[3][k] ); }
+    }
+  }
+#endif
+  for ( ; t < end_idx; t++ ) {
+    _gather_tri( t, 0, x0, y0, x1, y1, x2, y2, iz );
+    float area  = ( x1[0] - x0[0] ) * ( y2[0] - y0[0] ) - ( x2[0] - x0[0] ) * ( y1[0] - y0[0] );
+    float min_x = fminf( fminf( x0[0], x1[0] ), x2[0] ), max_x = fmaxf( fmaxf( x0[0], x1[0] ), x2[0] );
+    float min_y = fminf( fminf( y0[0], y1[0] ), y2[0] ), max_y = fmaxf( fmaxf( y0[0], y1[0] ), y2[0] );
+    bool on_screen = max_x >= 0.0f && min_x < w && max_y >= 0.0f && min_y < h;
+    bool in_guard  = min_x > -THUMB_GUARD_BAND && max_x < THUMB_GUARD_BAND && min_y > -THUMB_GUARD_BAND && max_y < THUMB_GUARD_BAND;
+    if ( area > 0.0f && iz[0] > 0.0f && on_screen && in_guard ) { _bin_tri( lane_idx, t, min_x, min_y, max_x, max_y ); }
+  }
+}
+
+/** Bilinear texture lookup. V is up, so row 0 of the image is at v = 1. */
+static void _sample_texture( float u, float v, uint8_t* rgb_ptr ) {
+  float fx = u * (float)_rdr.tex_w - 0.5f, fy = ( 1.0f - v ) * (float)_rdr.tex_h - 0.5f;
+  float fx0 = floorf( fx ), fy0 = floorf( fy );
+  float ax = fx - fx0, ay = fy - fy0;
+  int x0 = (int)fx0, y0 = (int)fy0, x1 = x0 + 1, y1 = y0 + 1;
+  x0     = x0 < 0 ? 0 : ( x0 >= _rdr.tex_w ? _rdr.tex_w - 1 : x0 );
+  x1     = x1 < 0 ? 0 : ( x1 >= _rdr.tex_w ? _rdr.tex_w - 1 : x1 );
+  y0     = y0 < 0 ? 0 : ( y0 >= _rdr.tex_h ? _rdr.tex_h - 1 : y0 );
+  y1     = y1 < 0 ? 0 : ( y1 >= _rdr.tex_h ? _rdr.tex_h - 1 : y1 );
+  const uint8_t* r0_ptr = &_rdr.tex_ptr[(size_t)y0 * _rdr.tex_w * _rdr.tex_n];
+  const uint8_t* r1_ptr = &_rdr.tex_ptr[(size_t)y1 * _rdr.tex_w * _rdr.tex_n];
+  for ( int c = 0; c < 3; c++ ) {
+    float top    = r0_ptr[x0 * _rdr.tex_n + c] + ( r0_ptr[x1 * _rdr.tex_n + c] - r0_ptr[x0 * _rdr.tex_n + c] ) * ax;
+    float bottom = r1_ptr[x0 * _rdr.tex_n + c] + ( r1_ptr[x1 * _rdr.tex_n + c] - r1_ptr[x0 * _rdr.tex_n + c] ) * ax;
+    rgb_ptr[c]   = (uint8_t)( top + ( bottom - top ) * ay + 0.5f );
+  }
+}
+
+/** @returns The fixed-point edge function of edge `p0` to `p1` at `p`. Positive inside a front-facing triangle. */
+static int64_t _edge( int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t px, int32_t py ) {
+  return (int64_t)( x1 - x0 ) * ( py - y0 ) - (int64_t)( y1 - y0 ) * ( px - x0 );
+}
+
+/** Top-left fill rule, for clockwise triangles on a Y-down screen: pixel centres exactly on an edge belong to the triangle only if it's a top or left edge,
+ * so that a pixel on an edge shared by two triangles is drawn once. @returns 0 for top or left edges, and -1 otherwise, to add to the edge function. */
+static int64_t _edge_bias( int32_t x0, int32_t y0, int32_t x1, int32_t y1 ) { return ( y1 < y0 || ( y1 == y0 && x1 > x0 ) ) ? 0 : -1; }
+
+/** Rasterise one triangle, clipped to a tile, with a depth test and perspective-correct UVs.
+ * Edge functions use 24.8 fixed-point coordinates, so stepping them across pixels is exact and adjacent triangles meet without cracks.
+ */
+static void _raster_tri( uint32_t tri_idx, int tile_x0, int tile_y0, int tile_x1, int tile_y1 ) {
+  uint32_t a = _index( tri_idx * 3 + 0 ), b = _index( tri_idx * 3 + 1 ), c = _index( tri_idx * 3 + 2 );
+  int32_t xa = (int32_t)lrintf( _rdr.sx_ptr[a] * THUMB_SUBPIXELS ), ya = (int32_t)lrintf( _rdr.sy_ptr[a] * THUMB_SUBPIXELS );
+  int32_t xb = (int32_t)lrintf( _rdr.sx_ptr[b] * THUMB_SUBPIXELS ), yb = (int32_t)lrintf( _rdr.sy_ptr[b] * THUMB_SUBPIXELS );
+  int32_t xc = (int32_t)lrintf( _rdr.sx_ptr[c] * THUMB_SUBPIXELS ), yc = (int32_t)lrintf( _rdr.sy_ptr[c] * THUMB_SUBPIXELS );
+  int64_t area = _edge( xa, ya, xb, yb, xc, yc );
+  if ( area <= 0 ) { return; } // Became degenerate when snapped to subpixels.
+  float inv_area = 1.0f / (float)area;
+
+  int min_x = xa < xb ? ( xa < xc ? xa : xc ) : ( xb < xc ? xb : xc ), max_x = xa > xb ? ( xa > xc ? xa : xc ) : ( xb > xc ? xb : xc );
+  int min_y = ya < yb ? ( ya < yc ? ya : yc ) : ( yb < yc ? yb : yc ), max_y = ya > yb ? ( ya > yc ? ya : yc ) : ( yb > yc ? yb : yc );
+  int px0 = min_x / THUMB_SUBPIXELS, px1 = max_x / THUMB_SUBPIXELS + 1;
+  int py0 = min_y / THUMB_SUBPIXELS, py1 = max_y / THUMB_SUBPIXELS + 1;
+  px0     = px0 > tile_x0 ? px0 : tile_x0;
+  py0     = py0 > tile_y0 ? py0 : tile_y0;
+  px1     = px1 < tile_x1 ? px1 : tile_x1;
+  py1     = py1 < tile_y1 ? py1 : tile_y1;
+  if ( px0 >= px1 || py0 >= py1 ) { return; }
+
+  uint8_t flat_rgb[3] = { 0 };
+  if ( !_rdr.tex_ptr ) { // Headlight shading from the face normal, as there's no texture to show.
+    const float *pa = &_rdr.vertices_ptr[a * 3], *pb = &_rdr.vertices_ptr[b * 3], *pc = &_rdr.vertices_ptr[c * 3];
+    float e1[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] }, e2[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+    float n[3]  = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    float len   = sqrtf( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] );
+    float ndotv = len > 0.0f ? fabsf( n[0] * _rdr.fwd[0] + n[2] * _rdr.fwd[2] ) / len : 0.0f;
+    flat_rgb[0] = flat_rgb[1] = flat_rgb[2] = (uint8_t)( 48.0f + 192.0f * ndotv );
+  }
+
+  // Edge functions at the first pixel centre, with the fill rule applied. Each is proportional to the barycentric weight of the opposite vertex.
+  int32_t fx = px0 * THUMB_SUBPIXELS + THUMB_SUBPIXELS / 2, fy = py0 * THUMB_SUBPIXELS + THUMB_SUBPIXELS / 2;
+  int64_t row_a = _edge( xb, yb, xc, yc, fx, fy ) + _edge_bias( xb, yb, xc, yc );
+  int64_t row_b = _edge( xc, yc, xa, ya, fx, fy ) + _edge_bias( xc, yc, xa, ya );
+  int64_t row_c = _edge( xa, ya, xb, yb, fx, fy ) + _edge_bias( xa, ya, xb, yb );
+  int64_t dx_a = -(int64_t)( yc - yb ) * THUMB_SUBPIXELS, dy_a = (int64_t)( xc - xb ) * THUMB_SUBPIXELS;
+  int64_t dx_b = -(int64_t)( ya - yc ) * THUMB_SUBPIXELS, dy_b = (int64_t)( xa - xc ) * THUMB_SUBPIXELS;
+  int64_t dx_c = -(int64_t)( yb - ya ) * THUMB_SUBPIXELS, dy_c = (int64_t)( xb - xa ) * THUMB_SUBPIXELS;
+  float iza = _rdr.iz_ptr[a], izb = _rdr.iz_ptr[b], izc = _rdr.iz_ptr[c];
+
+  for ( int py = py0; py < py1; py++, row_a += dy_a, row_b += dy_b, row_c += dy_c ) {
+    int64_t ea = row_a, eb = row_b, ec = row_c;
+    size_t idx = (size_t)py * _rdr.w + px0;
+    for ( int px = px0; px < px1; px++, idx++, ea += dx_a, eb += dx_b, ec += dx_c ) {
+      if ( ( ea | eb | ec ) < 0 ) { continue; }
+      float wa = (float)ea * inv_area, wb = (float)eb * inv_area, wc = (float)ec * inv_area;
+      float iz = wa * iza + wb * izb + wc * izc;
+      if ( iz <= _rdr.depth_ptr[idx] ) { continue; }
+      _rdr.depth_ptr[idx] = iz;
+      uint8_t* rgb_ptr    = &_rdr.rgb_ptr[idx * 3];
+      if ( _rdr.tex_ptr ) {
+        float z = 1.0f / iz;
+        float u = ( wa * _rdr.uz_ptr[a] + wb * _rdr.uz_ptr[b] + wc * _rdr.uz_ptr[c] ) * z;
+        float v = ( wa * _rdr.vz_ptr[a] + wb * _rdr.vz_ptr[b] + wc * _rdr.vz_ptr[c] ) * z;
+        _sample_texture( u, v, rgb_ptr );
+      } else {
+        memcpy( rgb_ptr, flat_rgb, 3 );
+      }
+    }
+  }
+}
+
+/** Step 3. Clear and rasterise every `n_lanes`th tile, starting from tile `lane_idx`, so that busy tiles in the middle of the image are spread out. */
+static void _raster_lane( uint32_t lane_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  (void)user_ptr;
+  uint32_t n_tiles = (uint32_t)( _rdr.n_tiles_x * _rdr.n_tiles_y );
+  for ( uint32_t tile_idx = lane_idx; tile_idx < n_tiles; tile_idx += _rdr.n_lanes ) {
+    int x0 = (int)( tile_idx % _rdr.n_tiles_x ) * THUMB_TILE_DIMS, y0 = (int)( tile_idx / _rdr.n_tiles_x ) * THUMB_TILE_DIMS;
+    int x1 = x0 + THUMB_TILE_DIMS < _rdr.w ? x0 + THUMB_TILE_DIMS : _rdr.w;
+    int y1 = y0 + THUMB_TILE_DIMS < _rdr.h ? y0 + THUMB_TILE_DIMS : _rdr.h;
+    for ( int y = y0; y < y1; y++ ) {
+      for ( int x = x0; x < x1; x++ ) {
+        size_t idx                  = (size_t)y * _rdr.w + x;
+        _rdr.depth_ptr[idx]         = 0.0f;
+        _rdr.rgb_ptr[idx * 3 + 0]   = ( THUMB_BACKGROUND_RGB >> 16 ) & 0xFF;
+        _rdr.rgb_ptr[idx * 3 + 1]   = ( THUMB_BACKGROUND_RGB >> 8 ) & 0xFF;
+        _rdr.rgb_ptr[idx * 3 + 2]   = THUMB_BACKGROUND_RGB & 0xFF;
+      }
+    }
+    for ( uint32_t l = 0; l < _rdr.n_lanes; l++ ) {
+      const _bin_t* bin_ptr = &_rdr.bins_ptr[l * n_tiles + tile_idx];
+      for ( uint32_t i = 0; i < bin_ptr->n; i++ ) { _raster_tri( bin_ptr->tris_ptr[i], x0, y0, x1, y1 ); }
+    }
+  }
+}
+
+/** Render the mesh and texture set in `_rdr` to `_rdr.rgb_ptr`. */
+static bool _render_frame( void ) {
+  VOL_TRACE_BEGIN( "thumbvols_project" );
+  vol_thread_parallel_for( _rdr.n_lanes, _rdr.n_lanes, _project_lane, NULL );
+  VOL_TRACE_END( "thumbvols_project" );
+  VOL_TRACE_BEGIN( "thumbvols_bin" );
+  vol_thread_parallel_for( _rdr.n_lanes, _rdr.n_lanes, _bin_lane, NULL );
+  VOL_TRACE_END( "thumbvols_bin" );
+  for ( uint32_t l = 0; l < _rdr.n_lanes; l++ ) {
+    if ( _rdr.lane_failed[l] ) { return false; }
+  }
+  VOL_TRACE_BEGIN( "thumbvols_raster" );
+  vol_thread_parallel_for( _rdr.n_lanes, _rdr.n_lanes, _raster_lane, NULL );
+  VOL_TRACE_END( "thumbvols_raster" );
+  return true;
+}
+
+/** Point the camera at the centre of the current frame's bounding box, far enough away for the box's bounding sphere to fit the view. */
+static void _fit_camera( float yaw_deg ) {
+  float min[3] = { HUGE_VALF, HUGE_VALF, HUGE_VALF }, max[3] = { -HUGE_VALF, -HUGE_VALF, -HUGE_VALF };
+  for ( uint32_t i = 0; i < _rdr.n_vertices; i++ ) {
+    for ( int c = 0; c < 3; c++ ) {
+      min[c] = fminf( min[c], _rdr.vertices_ptr[i * 3 + c] );
+      max[c] = fmaxf( max[c], _rdr.vertices_ptr[i * 3 + c] );
+    }
+  }
+  if ( 0 == _rdr.n_vertices ) { min[0] = min[1] = min[2] = max[0] = max[1] = max[2] = 0.0f; }
+  float centre[3] = { 0.5f * ( min[0] + max[0] ), 0.5f * ( min[1] + max[1] ), 0.5f * ( min[2] + max[2] ) };
+  float ext[3]    = { max[0] - centre[0], max[1] - centre[1], max[2] - centre[2] };
+  float radius    = sqrtf( ext[0] * ext[0] + ext[1] * ext[1] + ext[2] * ext[2] );
+  radius          = radius > 1e-3f ? radius : 1.0f;
+
+  float half_vfov = 0.5f * THUMB_VFOV_DEG * 3.14159265f / 180.0f;
+  _rdr.focal_px   = 0.5f * (float)_rdr.h / tanf( half_vfov );
+  float half_hfov = atanf( 0.5f * (float)_rdr.w / _rdr.focal_px );
+  float half_fov  = half_vfov < half_hfov ? half_vfov : half_hfov;
+  float dist      = radius / sinf( half_fov );
+
+  float yaw   = yaw_deg * 3.14159265f / 180.0f;
+  _rdr.fwd[0] = sinf( yaw ), _rdr.fwd[1] = 0.0f, _rdr.fwd[2] = cosf( yaw );
+  // Left-handed: right = up x forward.
+  _rdr.right[0] = _rdr.fwd[2], _rdr.right[1] = 0.0f, _rdr.right[2] = -_rdr.fwd[0];
+  for ( int c = 0; c < 3; c++ ) { _rdr.eye[c] = centre[c] - _rdr.fwd[c] * dist; }
+}
+
+/** Use `pixels_ptr` as the current texture, downscaling it first if it's much bigger than the output. */
+static bool _set_texture( const uint8_t* pixels_ptr, int w, int h, int n_chans ) {
+  int target = 2 * ( _rdr.w > _rdr.h ? _rdr.w : _rdr.h );
+  int small_w = w, small_h = h;
+  while ( small_w / 2 >= target && small_h / 2 >= target ) {
+    small_w /= 2;
+    small_h /= 2;
+  }
+  _rdr.tex_ptr = pixels_ptr;
+  _rdr.tex_w   = w;
+  _rdr.tex_h   = h;
+  _rdr.tex_n   = n_chans;
+  if ( small_w == w && small_h == h ) { return true; }
+
+  if ( !_tex_small_ptr || small_w != _tex_small_w || small_h != _tex_small_h ) {
+    free( _tex_small_ptr );
+    _tex_small_ptr = malloc( (size_t)small_w * small_h * 4 );
+    if ( !_tex_small_ptr ) { return false; }
+    _tex_small_w = small_w;
+    _tex_small_h = small_h;
+  }
+  if ( !vol_image_resize( pixels_ptr, w, h, n_chans, _tex_small_ptr, small_w, small_h ) ) { return false; }
+  _rdr.tex_ptr = _tex_small_ptr;
+  _rdr.tex_w   = small_w;
+  _rdr.tex_h   = small_h;
+  return true;
+}
+
+/** Point `_rdr` at the mesh, and any Basis Universal texture, of frame `frame_idx`. */
+static bool _load_geom_frame( const char* filename, int frame_idx ) {
+  int key_idx = vol_geom_find_previous_keyframe( &_geom_info, frame_idx );
+  if ( key_idx < 0 ) { return false; }
+  if ( _prev_key_frame_loaded_idx != key_idx ) {
+    if ( !vol_geom_read_frame( filename, &_geom_info, key_idx, &_key_frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry keyframe %i.\n", key_idx );
+      return false;
+    }
+    memcpy( _key_blob_ptr, _key_frame_data.block_data_ptr, _key_frame_data.block_data_sz );
+    _prev_key_frame_loaded_idx = key_idx;
+  }
+  vol_geom_frame_data_t frame_data = _key_frame_data;
+  const uint8_t* frame_ptr         = _key_blob_ptr;
+  if ( key_idx != frame_idx ) {
+    if ( !vol_geom_read_frame( filename, &_geom_info, frame_idx, &frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %i.\n", frame_idx );
+      return false;
+    }
+    frame_ptr = frame_data.block_data_ptr;
+  }
+
+  _rdr.vertices_ptr = (const float*)&frame_ptr[frame_data.vertices_offset];
+  _rdr.n_vertices   = frame_data.vertices_sz / ( sizeof( float ) * 3 );
+  _rdr.u32_indices  = _rdr.n_vertices >= 65535; // As in the .vols spec.
+  _rdr.indices_ptr  = &_key_blob_ptr[_key_frame_data.indices_offset];
+  _rdr.n_tris       = _key_frame_data.indices_sz / ( _rdr.u32_indices ? 4 : 2 ) / 3;
+  bool has_uvs      = _key_frame_data.uvs_sz >= _rdr.n_vertices * sizeof( float ) * 2;
+  _rdr.uvs_ptr      = has_uvs ? (const float*)&_key_blob_ptr[_key_frame_data.uvs_offset] : NULL;
+
+  if ( _basis_rgba_ptr && frame_data.texture_sz > 0 ) {
+    int w = 0, h = 0;
+    int format      = 13; // { 13 = cTFRGBA32, 3 = cTFBC3_RGBA }. Defined in basis_transcoder.h.
+    uint32_t out_sz = _geom_info.hdr.texture_width * _geom_info.hdr.texture_height * 4;
+    VOL_TRACE_BEGIN( "thumbvols_texture" );
+    bool ok = vol_basis_transcode( format, (void*)&frame_ptr[frame_data.texture_offset], frame_data.texture_sz, _basis_rgba_ptr, out_sz, &w, &h );
+    ok      = ok && _set_texture( _basis_rgba_ptr, w, h, 4 );
+    VOL_TRACE_END( "thumbvols_texture" );
+    if ( !ok ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Transcoding texture of frame %i.\n", frame_idx );
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Decode video frames up to `frame_idx` and use it as the current texture. Frames must be requested in order. */
+static bool _load_video_frame( int frame_idx ) {
+  while ( _av_frame_idx < frame_idx ) {
+    if ( !vol_av_read_next_frame( &_av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frame %i from video texture.\n", _av_frame_idx + 1 );
+      return false;
+    }
+    _av_frame_idx++;
+  }
+  VOL_TRACE_BEGIN( "thumbvols_texture" );
+  bool ok = _set_texture( _av_info.pixels_ptr, _av_info.w, _av_info.h, 3 );
+  VOL_TRACE_END( "thumbvols_texture" );
+  return ok;
+}
+
+/** Write an RGB image as PNG if `filename` ends in .png, or JPEG otherwise. */
+static bool _write_image( const char* filename, const uint8_t* rgb_ptr, int w, int h, bool png ) {
+  if ( png ) { return 0 != stbi_write_png( filename, w, h, 3, rgb_ptr, w * 3 ); }
+  return 0 != stbi_write_jpg( filename, w, h, 3, rgb_ptr, THUMB_JPEG_QUALITY );
+}
+
+static bool _has_png_extension( const char* filename ) {
+  size_t len = strlen( filename );
+  return len >= 4 && 0 == strcasecmp( &filename[len - 4], ".png" );
+}
+
+static bool _alloc_renderer( uint32_t max_vertices ) {
+  size_t n_pixels = (size_t)_rdr.w * _rdr.h;
+  size_t n_bins   = (size_t)_rdr.n_lanes * _rdr.n_tiles_x * _rdr.n_tiles_y;
+  _rdr.rgb_ptr     = malloc( n_pixels * 3 );
+  _rdr.depth_ptr   = malloc( n_pixels * sizeof( float ) );
+  _rdr.bins_ptr    = calloc( n_bins, sizeof( _bin_t ) );
+  _rdr.lane_failed = calloc( _rdr.n_lanes, sizeof( bool ) );
+  _rdr.sx_ptr      = malloc( max_vertices * sizeof( float ) );
+  _rdr.sy_ptr      = malloc( max_vertices * sizeof( float ) );
+  _rdr.iz_ptr      = malloc( max_vertices * sizeof( float ) );
+  _rdr.uz_ptr      = malloc( max_vertices * sizeof( float ) );
+  _rdr.vz_ptr      = malloc( max_vertices * sizeof( float ) );
+  return _rdr.rgb_ptr && _rdr.depth_ptr && _rdr.bins_ptr && _rdr.lane_failed && _rdr.sx_ptr && _rdr.sy_ptr && _rdr.iz_ptr && _rdr.uz_ptr && _rdr.vz_ptr;
+}
+
+static void _free_renderer( void ) {
+  if ( _rdr.bins_ptr ) {
+    size_t n_bins = (size_t)_rdr.n_lanes * _rdr.n_tiles_x * _rdr.n_tiles_y;
+    for ( size_t i = 0; i < n_bins; i++ ) { free( _rdr.bins_ptr[i].tris_ptr ); }
+  }
+  free( _rdr.rgb_ptr );
+  free( _rdr.depth_ptr );
+  free( _rdr.bins_ptr );
+  free( _rdr.lane_failed );
+  free( _rdr.sx_ptr );
+  free( _rdr.sy_ptr );
+  free( _rdr.iz_ptr );
+  free( _rdr.uz_ptr );
+  free( _rdr.vz_ptr );
+}
+
+int main( int argc, char** argv ) {
+  const char* combined_filename = NULL;
+  const char* header_filename   = NULL;
+  const char* sequence_filename = NULL;
+  const char* video_filename    = NULL;
+  const char* output_prefix     = "thumb_";
+  const char* sheet_filename    = NULL;
+  const char* preview_filename  = NULL;
+  int first_frame = 0, every = 0, n_columns = 0, w = 256, h = 256;
+  uint32_t n_threads = 0;
+  float yaw_deg      = 0.0f;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf(
+      "Usage for single-file volograms:\n"
+      "%s [OPTIONS] -c MYFILE.VOLS\n\n"
+      "Usage for multi-file volograms:\n"
+      "%s [OPTIONS] -h HEADER.VOLS -s SEQUENCE.VOLS -v VIDEO.MP4\n\n",
+      argv[0], argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_HEADER] ) { header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_VIDEO] ) { video_filename = my_argv[_option_arg_indices[CL_VIDEO] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_prefix = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( _option_arg_indices[CL_SHEET] ) { sheet_filename = my_argv[_option_arg_indices[CL_SHEET] + 1]; }
+  if ( _option_arg_indices[CL_PREVIEW] ) { preview_filename = my_argv[_option_arg_indices[CL_PREVIEW] + 1]; }
+  if ( _option_arg_indices[CL_FRAME] ) { first_frame = atoi( my_argv[_option_arg_indices[CL_FRAME] + 1] ); }
+  if ( _option_arg_indices[CL_EVERY] ) { every = atoi( my_argv[_option_arg_indices[CL_EVERY] + 1] ); }
+  if ( _option_arg_indices[CL_COLUMNS] ) { n_columns = atoi( my_argv[_option_arg_indices[CL_COLUMNS] + 1] ); }
+  if ( _option_arg_indices[CL_THREADS] ) { n_threads = (uint32_t)atoi( my_argv[_option_arg_indices[CL_THREADS] + 1] ); }
+  if ( _option_arg_indices[CL_YAW] ) { yaw_deg = (float)atof( my_argv[_option_arg_indices[CL_YAW] + 1] ); }
+  if ( _option_arg_indices[CL_SIZE] && 2 != sscanf( my_argv[_option_arg_indices[CL_SIZE] + 1], "%ix%i", &w, &h ) ) { w = h = 0; }
+  bool write_frames = _option_arg_indices[CL_OUTPUT] || ( !sheet_filename && !preview_filename );
+  bool png_frames   = _option_arg_indices[CL_PNG] > 0;
+
+  if ( !combined_filename && ( !header_filename || !sequence_filename ) ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --combined, or --header and --sequence, is missing. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( w < 16 || h < 16 || w > THUMB_MAX_DIMS || h > THUMB_MAX_DIMS ) {
+    _printlog( _LOG_TYPE_WARNING, "--size must be WIDTHxHEIGHT, e.g. 320x240, with each between 16 and %i.\n", THUMB_MAX_DIMS );
+    return 1;
+  }
+  if ( first_frame < 0 || every < 0 || n_columns < 0 ) {
+    _printlog( _LOG_TYPE_WARNING, "--frame, --every, and --columns must not be negative.\n" );
+    return 1;
+  }
+  if ( preview_filename && ( w % 2 || h % 2 ) ) {
+    _printlog( _LOG_TYPE_WARNING, "--preview needs an even width and height, for H.264.\n" );
+    return 1;
+  }
+
+  bool success          = false;
+  uint8_t* sheet_ptr    = NULL;
+  vol_av_encoder_t encoder = ( vol_av_encoder_t ){ ._context_ptr = NULL };
+  const char* filename  = combined_filename ? combined_filename : sequence_filename;
+  int sheet_w = 0, sheet_h = 0, n_rendered = 0;
+  double render_s = 0.0;
+
+  if ( combined_filename ) {
+    if ( !vol_geom_create_file_info_from_file( combined_filename, &_geom_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open combined vologram file=%s.\n", combined_filename );
+      return 1;
+    }
+  } else if ( !vol_geom_create_file_info( header_filename, sequence_filename, &_geom_info, true ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open geometry files header=%s sequence=%s.\n", header_filename, sequence_filename );
+    return 1;
+  }
+  int n_frames = (int)_geom_info.hdr.frame_count;
+  if ( first_frame >= n_frames ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %i is not in range of geometry's %i frames.\n", first_frame, n_frames );
+    goto _main_end;
+  }
+  int last_frame = every > 0 ? n_frames - 1 : first_frame;
+  int step       = every > 0 ? every : 1;
+  int n_selected = ( last_frame - first_frame ) / step + 1;
+
+  // Textures.
+  if ( video_filename ) {
+    if ( !vol_av_open( video_filename, &_av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open video file %s.\n", video_filename );
+      goto _main_end;
+    }
+  } else if ( _geom_info.hdr.version >= 13 && _geom_info.hdr.textured && 1 == _geom_info.hdr.texture_compression ) {
+    if ( !vol_basis_init() ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to initialise Basis transcoder.\n" );
+      goto _main_end;
+    }
+    _basis_rgba_ptr = malloc( (size_t)_geom_info.hdr.texture_width * _geom_info.hdr.texture_height * 4 );
+    if ( !_basis_rgba_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory allocating texture.\n" );
+      goto _main_end;
+    }
+  } else {
+    _printlog( _LOG_TYPE_WARNING, "WARNING: No texture. Rendering untextured. Use --video to give a video texture file.\n" );
+  }
+
+  // Renderer.
+  _rdr.w         = w;
+  _rdr.h         = h;
+  _rdr.n_tiles_x = ( w + THUMB_TILE_DIMS - 1 ) / THUMB_TILE_DIMS;
+  _rdr.n_tiles_y = ( h + THUMB_TILE_DIMS - 1 ) / THUMB_TILE_DIMS;
+  _rdr.n_lanes   = n_threads > 0 ? n_threads : vol_thread_hardware_concurrency();
+  _rdr.n_lanes   = _rdr.n_lanes < VOL_THREAD_MAX_THREADS ? _rdr.n_lanes : VOL_THREAD_MAX_THREADS;
+  _key_blob_ptr  = malloc( _geom_info.biggest_frame_blob_sz );
+  // A frame's vertex array is never bigger than its blob.
+  if ( !_key_blob_ptr || !_alloc_renderer( (uint32_t)( _geom_info.biggest_frame_blob_sz / ( sizeof( float ) * 3 ) ) ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory allocating renderer.\n" );
+    goto _main_end;
+  }
+
+  // Outputs.
+  if ( sheet_filename ) {
+    n_columns = n_columns > 0 ? n_columns : (int)ceil( sqrt( (double)n_selected ) );
+    n_columns = n_columns < n_selected ? n_columns : n_selected;
+    sheet_w   = n_columns * w;
+    sheet_h   = ( n_selected + n_columns - 1 ) / n_columns * h;
+    sheet_ptr = malloc( (size_t)sheet_w * sheet_h * 3 );
+    if ( !sheet_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory allocating %ix%i contact sheet.\n", sheet_w, sheet_h );
+      goto _main_end;
+    }
+    memset( sheet_ptr, 0, (size_t)sheet_w * sheet_h * 3 );
+  }
+  if ( preview_filename ) {
+    double fps       = _geom_info.hdr.fps > 0.0f ? _geom_info.hdr.fps / step : 30.0 / step;
+    int64_t bit_rate = (int64_t)THUMB_PREVIEW_KBPS_PER_MP * 1000 * w * h / ( 1000 * 1000 );
+    if ( !vol_av_encoder_open( preview_filename, w, h, 3, fps, bit_rate > 0 ? bit_rate : 1, &encoder ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open `%s` for encoding.\n", preview_filename );
+      goto _main_end;
+    }
+  }
+
+  for ( int i = first_frame; i <= last_frame; i += step ) {
+    if ( !_load_geom_frame( filename, i ) ) { goto _main_end; }
+    if ( video_filename && !_load_video_frame( i ) ) { goto _main_end; }
+    if ( !_rdr.uvs_ptr ) { _rdr.tex_ptr = NULL; }
+    if ( i == first_frame ) { _fit_camera( yaw_deg ); }
+
+    double t0 = _time_s();
+    VOL_TRACE_BEGIN( "thumbvols_render" );
+    bool render_ok = _render_frame();
+    VOL_TRACE_END( "thumbvols_render" );
+    render_s += _time_s() - t0;
+    if ( !render_ok ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory rendering frame %i.\n", i );
+      goto _main_end;
+    }
+
+    if ( write_frames ) {
+      char frame_filename[MAX_FILENAME_LEN];
+      snprintf( frame_filename, MAX_FILENAME_LEN, "%s%08i.%s", output_prefix, i, png_frames ? "png" : "jpg" );
+      if ( !_write_image( frame_filename, _rdr.rgb_ptr, w, h, png_frames ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Writing `%s`.\n", frame_filename );
+        goto _main_end;
+      }
+    }
+    if ( sheet_ptr ) {
+      int cell_x = n_rendered % n_columns, cell_y = n_rendered / n_columns;
+      for ( int y = 0; y < h; y++ ) {
+        memcpy( &sheet_ptr[( (size_t)( cell_y * h + y ) * sheet_w + (size_t)cell_x * w ) * 3], &_rdr.rgb_ptr[(size_t)y * w * 3], (size_t)w * 3 );
+      }
+    }
+    if ( preview_filename && !vol_av_encoder_write_frame( &encoder, _rdr.rgb_ptr ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Encoding preview frame %i.\n", i );
+      goto _main_end;
+    }
+    n_rendered++;
+  }
+
+  if ( sheet_ptr && !_write_image( sheet_filename, sheet_ptr, sheet_w, sheet_h, _has_png_extension( sheet_filename ) ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Writing contact sheet `%s`.\n", sheet_filename );
+    goto _main_end;
+  }
+  success = true;
+
+_main_end:
+  if ( encoder._context_ptr && !vol_av_encoder_close( &encoder ) ) { success = false; }
+  if ( _av_info._context_ptr ) { vol_av_close( &_av_info ); }
+  vol_geom_free_file_info( &_geom_info );
+  _free_renderer();
+  free( _key_blob_ptr );
+  free( _basis_rgba_ptr );
+  free( _tex_small_ptr );
+  free( sheet_ptr );
+  if ( !success ) { return 1; }
+
+  _printlog( _LOG_TYPE_SUCCESS, "Rendered %i frames at %ix%i in %.3f s (%.1f frames/s, excluding file I/O and decoding).\n", n_rendered, w, h, render_s,
+    render_s > 0.0 ? n_rendered / render_s : 0.0 );
+  return 0;
+}
@@ -3,7 +3,7 @@
  *
  * vol2obj   | Vologram frame to OBJ+image converter.
  * --------- | ----------------------------------------------------------------
- * Version   | 0.8.0
+ * Version   | 0.16.1
  * Authors   | Anton Gerdelan  <anton@volograms.com>
  *           | Jan Ondřej      <jan@volograms.com>
  * Copyright | 2023-2021, Volograms (http://volograms.com/)
@@ -17,6 +17,9 @@
  * For single-file volograms:
  *     ./vol2obj.bin -c MYFILE.VOLS -f FRAME_NUMBER
  *
+ * For single-file volograms converted from multi-file volograms with packvols, give the video texture too:
+ *     ./vol2obj.bin -c MYFILE.VOLS -v VIDEO.MP4 -f FRAME_NUMBER
+ *
  * For older multi-file volograms:
  *     ./vol2obj.bin -h HEADER.VOLS -s SEQUENCE.VOLS -v VIDEO.MP4 -f FRAME_NUMBER
  *
@@ -25,6 +28,10 @@
  *   - You can also output every frame with the `--all` option, or a specific range of frames using
  *     `-f FIRST -l LAST`
  *     for frame numbers `FIRST` to `LAST`, inclusive.
+ *   - To write coloured point clouds instead of meshes, add `--points ply` or `--points xyzrgb`.
+ *   - To write the frames as a single animated glTF file instead, add `--gltf-sequence MYFILE.GLTF`.
+ *   - To write the frames as a single mesh cache file for VFX tools instead, add `--cache MYFILE.VOLCACHE`.
+ *     Add `--upsample 3` to write it at 3 times the frame rate, e.g. 90 fps for a 30 fps capture, with in-between frames interpolated.
  *
  * Compilation
  * ------------------
@@ -33,6 +40,16 @@
  *
  * History
  * -----------
+ * - 0.16.1  (2026/10/18) - v1.2 volograms with a negative header scale keep their front faces, as the scale's reflection undoes X's.
+ * - 0.16.0  (2026/10/18) - `--upsample` flag to write mesh caches at a multiple of the frame rate, interpolating between tracked frames.
+ * - 0.15.1  (2026/10/18) - glTF and mesh cache winding reversal and UV flips use vol_mesh's vectorised kernels.
+ * - 0.15.0  (2026/10/18) - v1.2 headers' translation, rotation, and scale are applied to exported frames, with vol_mesh's vectorised transforms.
+ * - 0.14.0  (2026/10/18) - `--cache` flag to write a frame range as one seekable, time-sampled mesh cache file for VFX tools.
+ * - 0.13.0  (2026/10/18) - `--gltf-sequence` flag to write a frame range as one animated glTF file with an external binary buffer.
+ * - 0.12.0  (2026/10/18) - `--points` flag to write point clouds coloured from the texture, as PLY or raw xyzrgb, without writing images.
+ * - 0.11.0  (2026/10/18) - `--trace` flag to write a Chrome trace of where time is spent, in builds made with `VOL_TRACE=1`.
+ * - 0.10.0  (2026/10/18) - `--combined` files without textures, as written by packvols, can use `--video` for their texture.
+ * - 0.9.0   (2026/10/18) - `--gen-normals` flag to compute vertex normals for volograms captured without them.
  * - 0.8.0   (2023/07/05) - `--combined` and `--no-normals` flags. vols v1.3 and Basis Universal texture support. Expanded drag-and-drop. Disk space check.
  * - 0.7.1   (2023/06/20) - Support for Volograms without normals.
  * - 0.7.0   (2022/07/29) - `--prefix` flag, and updated vol_libs, updated cl param parsing system.
@@ -49,7 +66,11 @@
 
 #include "vol_av.h"    // Volograms' texture video library.
 #include "vol_basis.h" // Volograms' Basis Universal wrapper library.
+#include "vol_cache.h" // Volograms' mesh cache library.
 #include "vol_geom.h"  // Volograms' .vols file parsing library.
+#include "vol_image.h" // Volograms' image processing library.
+#include "vol_mesh.h"  // Volograms' mesh processing library.
+#include "vol_trace.h" // Volograms' profiling markers.
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb/stb_image_write.h"
@@ -87,18 +108,27 @@
 
 typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
 
+/** Point cloud formats for the `--points` flag. */
+typedef enum _points_format_t { _POINTS_FORMAT_NONE = 0, _POINTS_FORMAT_PLY, _POINTS_FORMAT_XYZRGB } _points_format_t;
+
 /** Convience enum to index into the array of command-line flags by readable name. */
 typedef enum cl_flag_enum_t {
   CL_ALL_FRAMES,
+  CL_CACHE,
   CL_COMBINED,
   CL_HEADER,
   CL_HELP,
   CL_FIRST,
   CL_LAST,
+  CL_GEN_NORMALS,
+  CL_GLTF_SEQUENCE,
   CL_NO_NORMALS,
   CL_OUTPUT_DIR,
+  CL_POINTS,
   CL_PREFIX,
   CL_SEQUENCE,
+  CL_TRACE,
+  CL_UPSAMPLE,
   CL_VIDEO,
   CL_MAX
 } cl_flag_enum_t;
@@ -120,6 +150,11 @@ static const char* STRC_YELLOW  = "\x1B[33m";
 /** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
 static cl_flag_t _cl_flags[CL_MAX] = {
   { "--all", "-a", "Create output files for, and process, all frames found in the sequence.\nIf given, then paramters -f and -l are ignored.\n", 0 }, // CL_ALL_FRAMES
+  { "--cache", NULL,                                                                                                               // CL_CACHE
+    "The next argument gives a filename, e.g. my_capture.volcache, to write the frames to as one time-sampled mesh cache, instead of .obj files.\n" //
+    "Indices and UVs are written once per keyframe, and positions and normals once per frame. Textures are not included.\n"        //
+    "The format is described in lib/vol_cache.h. Use with --all or -f and -l to choose the frames.\n",                             //
+    1 },                                                                                                                           //
   { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
   { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
   { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
@@ -132,16 +167,40 @@ static cl_flag_t _cl_flags[CL_MAX] = {
     "The next argument gives the frame number of the last frame to process.\n"                                                     //
     "Can be used with -f to process a range of frames from first to last, inclusive.\n",                                           //
     1 },                                                                                                                           //
+  { "--gen-normals", "-g",                                                                                                         // CL_GEN_NORMALS
+    "Compute smooth vertex normals from each frame's triangles, replacing any normals stored in the vologram.\n"                   //
+    "Use this for volograms captured without normals.\n",                                                                          //
+    0 },                                                                                                                           //
+  { "--gltf-sequence", NULL,                                                                                                       // CL_GLTF_SEQUENCE
+    "The next argument gives a filename, e.g. my_capture.gltf, to write the frames to as one animated glTF file, instead of .obj files.\n" //
+    "Mesh data and JPEG textures go in a matching .bin file, written in one pass. Each keyframe's indices and UVs are shared by its frames.\n" //
+    "Each frame is a node that is only visible at its frame time. Use with --all or -f and -l to choose the frames.\n",            //
+    1 },                                                                                                                           //
   { "--no-normals", "-n", "Strip normals from the mesh before exporting.\n", 0 },                                                  // CL_NO_NORMALS
   { "--output-dir", "-o",                                                                                                          // CL_OUTPUT_DIR
     "The next argument gives the path to a directory to write output files into.\n"                                                //
     "Default is the current working directory.\n",                                                                                 //
     1 },                                                                                                                           //
+  { "--points", NULL,                                                                                                              // CL_POINTS
+    "The next argument gives a point cloud format, `ply` or `xyzrgb`, to write instead of .obj, .mtl, and image files.\n"          //
+    "Each vertex becomes a point, coloured by bilinear sampling of the frame's texture at its UV.\n"                               //
+    "`ply` writes binary PLY files.\n"                                                                                             //
+    "`xyzrgb` writes raw files of packed 15-byte points: x, y, z as little-endian floats, then r, g, b bytes.\n",                  //
+    1 },                                                                                                                           //
   { "--prefix", "-p",                                                                                                              // CL_PREFIX
     "The next argument gives the prefix to use for output filenames.\n"                                                            //
     "Default is output_frame_.\n",                                                                                                 //
     1 },                                                                                                                           //
   { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }, // CL_SEQUENCE
+  { "--trace", "-t",                                                                                                               // CL_TRACE
+    "The next argument gives a path to write a Chrome trace event JSON file to, showing where processing time was spent.\n"         //
+    "Open it in https://ui.perfetto.dev or chrome://tracing. Requires a build made with `make -e VOL_TRACE=1 vol2obj`.\n",          //
+    1 },                                                                                                                           //
+  { "--upsample", "-u",                                                                                                            // CL_UPSAMPLE
+    "The next argument gives a number of samples, e.g. 3, to write per frame with --cache, at that multiple of the frame rate.\n"  //
+    "In-between samples have positions and normals interpolated from the frames either side, within each keyframe segment.\n"      //
+    "Default value 1.\n",                                                                                                          //
+    1 },                                                                                                                           //
   { "--video", "-v", "Required for multi-file volograms. The next argument gives the path to the video texture file.\n", 1 }       // CL_VIDEO
 };
 
@@ -152,19 +211,20 @@ static char** my_argv;
 static int _option_arg_indices[CL_MAX];
 
 // Filenames.
-static char* _input_header_filename;                 // e.g. `header.vols`
-static char* _input_sequence_filename;               // e.g. `sequence.vols`
-static char* _input_combined_filename;               // e.g. `combined.vols`
-static char* _input_video_filename;                  // e.g. `texture_1024.webm`
-static char _output_dir_path[MAX_SUBPATH_LEN];       // e.g. `my_output/`
-static char _output_mesh_filename[MAX_FILENAME_LEN]; // e.g. `output_frame_00000000.obj`
-static char _output_mtl_filename[MAX_FILENAME_LEN];  // e.g. `output_frame_00000000.mtl`
-static char _output_img_filename[MAX_FILENAME_LEN];  // e.g. `output_frame_00000000.jpg`
-static char _material_name[MAX_SUBPATH_LEN];         // e.g. `volograms_mtl_00000000`
-static char _prefix_str[MAX_SUBPATH_LEN];            // defaults to `output_frame_`
-
-static vol_av_video_t _av_info;                      // Audio-video information from vol_av library.
-static vol_geom_info_t _geom_info;                   // Mesh information from vol_geom library.
+static char* _input_header_filename;                   // e.g. `header.vols`
+static char* _input_sequence_filename;                 // e.g. `sequence.vols`
+static char* _input_combined_filename;                 // e.g. `combined.vols`
+static char* _input_video_filename;                    // e.g. `texture_1024.webm`
+static char _output_dir_path[MAX_SUBPATH_LEN];         // e.g. `my_output/`
+static char _output_mesh_filename[MAX_FILENAME_LEN];   // e.g. `output_frame_00000000.obj`
+static char _output_mtl_filename[MAX_FILENAME_LEN];    // e.g. `output_frame_00000000.mtl`
+static char _output_img_filename[MAX_FILENAME_LEN];    // e.g. `output_frame_00000000.jpg`
+static char _output_points_filename[MAX_FILENAME_LEN]; // e.g. `output_frame_00000000.ply`
+static char _material_name[MAX_SUBPATH_LEN];           // e.g. `volograms_mtl_00000000`
+static char _prefix_str[MAX_SUBPATH_LEN];              // defaults to `output_frame_`
+
+static vol_av_video_t _av_info;                        // Audio-video information from vol_av library.
+static vol_geom_info_t _geom_info;                     // Mesh information from vol_geom library.
 
 // stb_image_write.
 static int _jpeg_quality = 95; // Arbitrary choice of 95% quality v size based on GIMP's default.
@@ -174,7 +234,12 @@ static const int _dims_presize = 8192; // Maximum texture size for Basis Univers
 static uint8_t* _output_blocks_ptr;    // Temporary memory used to gather Basis Universal output.
 
 // Working memory.
-static uint8_t* _key_blob_ptr; // For retaining memory of most recent key frame for re-use.
+static uint8_t* _key_blob_ptr;  // For retaining memory of most recent key frame for re-use.
+static float* _gen_normals_ptr; // Output of normals generation, big enough for any frame's vertices.
+// Header transform, with X reversed, applied to every exported frame. Could instead reverse Z but then need to import in blender as "Z forward".
+static vol_mesh_transform_t _xform;
+static float* _xform_points_ptr;  // Transformed vertices, big enough for any frame's.
+static float* _xform_normals_ptr; // Transformed normals, big enough for any frame's.
 static vol_geom_frame_data_t _key_frame_data;
 static int _prev_key_frame_loaded_idx = -1;
 
@@ -330,7 +395,10 @@ static bool _write_video_frame_to_image( const char* output_image_filename, cons
   char full_path[MAX_FILENAME_LEN];
   sprintf( full_path, "%s%s", _output_dir_path, output_image_filename );
 
-  if ( !stbi_write_jpg( full_path, w, h, n, pixels_ptr, _jpeg_quality ) ) {
+  VOL_TRACE_BEGIN( "vol2obj_write_jpg" );
+  int write_ok = stbi_write_jpg( full_path, w, h, n, pixels_ptr, _jpeg_quality );
+  VOL_TRACE_END( "vol2obj_write_jpg" );
+  if ( !write_ok ) {
     _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame image file `%s`.\n", full_path );
     return false;
   }
@@ -383,6 +451,16 @@ the map_Kd value is multiplied by the Kd value.
   return true;
 }
 
+/** Copy a keyframe's triangles to `dst_ptr`, reversing their winding if the export transform mirrors the mesh, so front faces stay in front.
+ * @returns False if the indices aren't a whole number of triangles.
+ */
+static bool _copy_indices_for_xform( const void* src_ptr, void* dst_ptr, uint32_t n_indices, vol_mesh_index_type_t index_type ) {
+  if ( _xform.flips_winding ) { return vol_mesh_reverse_winding( src_ptr, dst_ptr, n_indices, index_type ); }
+  if ( 0 != n_indices % 3 ) { return false; }
+  memcpy( dst_ptr, src_ptr, (size_t)n_indices * vol_mesh_index_sz( index_type ) );
+  return true;
+}
+
 /**
  * @param output_mtl_filename
  * If NULL then no MTL section or link is added to the Obj.
@@ -399,7 +477,8 @@ static bool _write_mesh_to_obj_file( //
   uint32_t n_normals,                //
   const void* indices_ptr,           //
   uint32_t n_indices,                //
-  int index_type                     //
+  int index_type,                    //
+  bool reverse_winding               //
 ) {
   if ( !output_mesh_filename ) { return false; }
 
@@ -425,8 +504,7 @@ static bool _write_mesh_to_obj_file( //
       float x = vertices_ptr[i * 3 + 0];
       float y = vertices_ptr[i * 3 + 1];
       float z = vertices_ptr[i * 3 + 2];
-      // Reversed X. could instead reverse Z but then need to import in blender as "Z forward".
-      if ( 0 == fprintf( f_ptr, "v %0.3f %0.3f %0.3f\n", -x, y, z ) ) { goto _wmo2f_fail; }
+      if ( 0 == fprintf( f_ptr, "v %0.3f %0.3f %0.3f\n", x, y, z ) ) { goto _wmo2f_fail; }
     }
   }
   assert( texcoords_ptr && "No texture coords in vologram frame." );
@@ -442,7 +520,7 @@ static bool _write_mesh_to_obj_file( //
       float x = normals_ptr[i * 3 + 0];
       float y = normals_ptr[i * 3 + 1];
       float z = normals_ptr[i * 3 + 2];
-      if ( 0 == fprintf( f_ptr, "vn %0.3f %0.3f %0.3f\n", -x, y, z ) ) { goto _wmo2f_fail; }
+      if ( 0 == fprintf( f_ptr, "vn %0.3f %0.3f %0.3f\n", x, y, z ) ) { goto _wmo2f_fail; }
     }
   }
   assert( indices_ptr && "No vertex indices in vologram frame." );
@@ -461,6 +539,12 @@ static bool _write_mesh_to_obj_file( //
       int b = (int)( i_u16_ptr[i * 3 + 1] ) + 1;
       int c = (int)( i_u16_ptr[i * 3 + 2] ) + 1;
       // NOTE VOLS winding order is CW (similar to Unity) rather than typical CCW so let's reverse it for OBJ.
+      // Unless a negative header scale has mirrored the mesh back again, which the transform reports.
+      if ( !reverse_winding ) {
+        int tmp = a;
+        a       = c;
+        c       = tmp;
+      }
       if ( normals_ptr ) {
         // f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3 ...
         if ( 0 == fprintf( f_ptr, "f %i/%i/%i %i/%i/%i %i/%i/%i\n", c, c, c, b, b, b, a, a, a ) ) { goto _wmo2f_fail; }
@@ -482,6 +566,65 @@ _wmo2f_fail:
   return false;
 }
 
+/** Pointers to one frame's mesh data. They point into `_key_blob_ptr` or vol_geom's frame buffer, so stay valid until the next frame is read. */
+typedef struct _geom_frame_t {
+  float* points_ptr;
+  float* texcoords_ptr;
+  float* normals_ptr; // NULL if the vologram has no normals.
+  uint8_t* indices_ptr;
+  uint8_t* texture_data_ptr; // NULL unless the vologram has per-frame compressed textures.
+  uint32_t points_sz, texcoords_sz, normals_sz, indices_sz, texture_data_sz;
+} _geom_frame_t;
+
+/** Reads a frame, and its keyframe first if that isn't the most recent keyframe read.
+ * @param filename
+ * Sequence filename (older multi-file Volograms), or combined Vologram filename.
+ * @return
+ * Returns false on error.
+ */
+static bool _read_geom_frame( const char* filename, int frame_idx, _geom_frame_t* frame_ptr ) {
+  int key_idx = vol_geom_find_previous_keyframe( &_geom_info, frame_idx );
+  *frame_ptr  = ( _geom_frame_t ){ .points_ptr = NULL };
+
+  // If our frame isn't a keyframe then we need to load the previous keyframe's data first.
+  if ( _prev_key_frame_loaded_idx != key_idx ) {
+    if ( !vol_geom_read_frame( filename, &_geom_info, key_idx, &_key_frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry keyframe %i.\n", key_idx );
+      return false;
+    }
+    assert( _key_frame_data.block_data_sz <= _geom_info.biggest_frame_blob_sz && "Frame was bigger than pre-allocated biggest blob size." );
+    memcpy( _key_blob_ptr, _key_frame_data.block_data_ptr, _key_frame_data.block_data_sz );
+    _prev_key_frame_loaded_idx = key_idx;
+  }
+  // Data that always comes from the frame's keyframe.
+  frame_ptr->texcoords_sz  = _key_frame_data.uvs_sz;
+  frame_ptr->indices_sz    = _key_frame_data.indices_sz;
+  frame_ptr->texcoords_ptr = (float*)&_key_blob_ptr[_key_frame_data.uvs_offset];
+  frame_ptr->indices_ptr   = &_key_blob_ptr[_key_frame_data.indices_offset];
+
+  vol_geom_frame_data_t frame_data = _key_frame_data;
+  uint8_t* blob_ptr                = _key_blob_ptr;
+  // Read intermediate frame if necessary.
+  if ( key_idx != frame_idx ) {
+    if ( !vol_geom_read_frame( filename, &_geom_info, frame_idx, &frame_data ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %i.\n", frame_idx );
+      return false;
+    }
+    blob_ptr = frame_data.block_data_ptr;
+  }
+
+  // Data that comes from current frame (which may be a keyframe).
+  frame_ptr->points_sz   = frame_data.vertices_sz;
+  frame_ptr->normals_sz  = frame_data.normals_sz;
+  frame_ptr->points_ptr  = (float*)&blob_ptr[frame_data.vertices_offset];
+  frame_ptr->normals_ptr = 0 == frame_data.normals_sz ? NULL : (float*)&blob_ptr[frame_data.normals_offset];
+  if ( _geom_info.hdr.textured && _geom_info.hdr.texture_compression > 0 ) {
+    frame_ptr->texture_data_sz  = frame_data.texture_sz;
+    frame_ptr->texture_data_ptr = &blob_ptr[frame_data.texture_offset];
+  }
+  return true;
+}
+
 /**
  * @param seq_filename,combined_filename
  * Either a sequence filename (older multi-file Volograms), or combined Vologram filename, must point to a valid string.
@@ -498,6 +641,8 @@ _wmo2f_fail:
  * If true then output_image_filename must not be NULL.
  * @param no_normals
  * If true then don't include vertex normals in the output.
+ * @param gen_normals
+ * If true then compute vertex normals from the triangles instead of using any stored in the vologram. Ignored if `no_normals` is set.
  * @return
  * Returns false on error.
  */
@@ -507,58 +652,21 @@ static bool _write_geom_frame_to_mesh( //
   const char* output_mesh_filename,    //
   const char* output_mtl_filename,     //
   const char* material_name,           //
-  int frame_idx,
-  bool no_normals                      //
+  int frame_idx,                       //
+  bool no_normals,                     //
+  bool gen_normals                     //
 ) {
   if ( !( seq_filename || combined_filename ) || !output_mesh_filename || frame_idx < 0 ) { return false; }
 
   const char* filename = combined_filename ? combined_filename : seq_filename;
   bool success         = true;
-  int key_idx          = vol_geom_find_previous_keyframe( &_geom_info, frame_idx );
-
-  float *points_ptr = NULL, *texcoords_ptr = NULL, *normals_ptr = NULL;
-  uint8_t *indices_ptr = NULL, *texture_data_ptr = NULL;
-  uint32_t points_sz = 0, texcoords_sz = 0, normals_sz = 0, indices_sz = 0, texture_data_sz = 0;
-  vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
-
-  { // Get data pointers.
-    // If our frame isn't a keyframe then we need to load the previous keyframe's data first.
-    if ( _prev_key_frame_loaded_idx != key_idx ) {
-      if ( !vol_geom_read_frame( filename, &_geom_info, key_idx, &_key_frame_data ) ) {
-        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry keyframe %i.\n", key_idx );
-        return false;
-      }
-      frame_data = _key_frame_data;
-      assert( _key_frame_data.block_data_sz <= _geom_info.biggest_frame_blob_sz && "Frame was bigger than pre-allocated biggest blob size." );
-      memcpy( _key_blob_ptr, _key_frame_data.block_data_ptr, _key_frame_data.block_data_sz );
-      _prev_key_frame_loaded_idx = key_idx;
-    }
-    // Data that always comes from the frame's keyframe.
-    texcoords_sz  = _key_frame_data.uvs_sz;
-    indices_sz    = _key_frame_data.indices_sz;
-    texcoords_ptr = (float*)&_key_blob_ptr[_key_frame_data.uvs_offset];
-    indices_ptr   = &_key_blob_ptr[_key_frame_data.indices_offset];
-
-    uint8_t* frame_ptr = _key_blob_ptr;
-    // Read intermediate frame if necessary.
-    if ( key_idx != frame_idx ) {
-      if ( !vol_geom_read_frame( filename, &_geom_info, frame_idx, &frame_data ) ) {
-        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %i.\n", frame_idx );
-        return false;
-      }
-      frame_ptr = frame_data.block_data_ptr;
-    }
 
-    // Data that comes from current frame (which may be a keyframe).
-    points_sz   = frame_data.vertices_sz;
-    normals_sz  = frame_data.normals_sz;
-    points_ptr  = (float*)&frame_ptr[frame_data.vertices_offset];
-    normals_ptr = no_normals ? NULL : (float*)&frame_ptr[frame_data.normals_offset];
-    if ( _geom_info.hdr.textured && _geom_info.hdr.texture_compression > 0 ) {
-      texture_data_sz  = frame_data.texture_sz;
-      texture_data_ptr = &frame_ptr[frame_data.texture_offset];
-    }
-  } // endblock get data pointers.
+  _geom_frame_t frame;
+  if ( !_read_geom_frame( filename, frame_idx, &frame ) ) { return false; }
+  float *points_ptr = frame.points_ptr, *texcoords_ptr = frame.texcoords_ptr, *normals_ptr = no_normals ? NULL : frame.normals_ptr;
+  uint8_t *indices_ptr = frame.indices_ptr, *texture_data_ptr = frame.texture_data_ptr;
+  uint32_t points_sz = frame.points_sz, texcoords_sz = frame.texcoords_sz, normals_sz = frame.normals_sz, indices_sz = frame.indices_sz;
+  uint32_t texture_data_sz = frame.texture_data_sz;
 
   // Write the .obj.
   uint32_t n_points    = points_sz / ( sizeof( float ) * 3 );
@@ -567,19 +675,42 @@ static bool _write_geom_frame_to_mesh( //
   // NOTE(Anton) hacked this in so only supporting uint16_t indices for now.
   int indices_type   = 1;                               // 1 is uint16_t.
   uint32_t n_indices = indices_sz / sizeof( uint16_t ); // NOTE change if type changes!!!
-  if ( !_write_mesh_to_obj_file(                        //
-         output_mesh_filename,                          //
-         output_mtl_filename,                           //
-         material_name,                                 //
-         points_ptr,                                    //
-         n_points,                                      //
-         texcoords_ptr,                                 //
-         n_texcoords,                                   //
-         normals_ptr,                                   //
-         n_normals,                                     //
-         indices_ptr,                                   //
-         n_indices,                                     //
-         indices_type ) ) {
+  if ( gen_normals && !no_normals ) {
+    VOL_TRACE_BEGIN( "vol2obj_gen_normals" );
+    bool normals_ok = vol_mesh_compute_normals( points_ptr, n_points, indices_ptr, n_indices, VOL_MESH_INDEX_TYPE_U16, _gen_normals_ptr );
+    VOL_TRACE_END( "vol2obj_gen_normals" );
+    if ( !normals_ok ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to compute normals for frame %i.\n", frame_idx );
+      return false;
+    }
+    normals_ptr = _gen_normals_ptr;
+    n_normals   = n_points;
+  }
+  VOL_TRACE_BEGIN( "vol2obj_transform" );
+  vol_mesh_transform_vertices( &_xform, points_ptr, _xform_points_ptr, n_points );
+  points_ptr = _xform_points_ptr;
+  if ( normals_ptr ) {
+    vol_mesh_transform_normals( &_xform, normals_ptr, _xform_normals_ptr, n_normals );
+    normals_ptr = _xform_normals_ptr;
+  }
+  VOL_TRACE_END( "vol2obj_transform" );
+  VOL_TRACE_BEGIN( "vol2obj_write_obj" );
+  bool obj_ok = _write_mesh_to_obj_file( //
+    output_mesh_filename,                //
+    output_mtl_filename,                 //
+    material_name,                       //
+    points_ptr,                          //
+    n_points,                            //
+    texcoords_ptr,                       //
+    n_texcoords,                         //
+    normals_ptr,                         //
+    n_normals,                           //
+    indices_ptr,                         //
+    n_indices,                           //
+    indices_type,                        //
+    _xform.flips_winding );
+  VOL_TRACE_END( "vol2obj_write_obj" );
+  if ( !obj_ok ) {
     _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write mesh file `%s`\n", output_mesh_filename );
     // Not returning false yet, but just setting a flag, because we still want to release resources.
     success = false;
@@ -602,14 +733,731 @@ static bool _write_geom_frame_to_mesh( //
   return success;
 }
 
+/** Writes coloured points to a binary PLY file, or to a raw file of packed x, y, z floats and r, g, b bytes, depending on `points_format`.
+ * Points are written as given, so should have the header transform applied, as for meshes, for point clouds to line up with them.
+ */
+static bool _write_points_file(      //
+  const char* output_points_filename, //
+  _points_format_t points_format,     //
+  const float* points_ptr,            //
+  const uint8_t* rgb_ptr,             //
+  uint32_t n_points                   //
+) {
+  if ( !output_points_filename || !points_ptr || !rgb_ptr ) { return false; }
+
+  char full_path[MAX_FILENAME_LEN];
+  sprintf( full_path, "%s%s", _output_dir_path, output_points_filename );
+
+  FILE* f_ptr = fopen( full_path, "wb" );
+  if ( !f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", full_path );
+    return false;
+  }
+  if ( _POINTS_FORMAT_PLY == points_format ) {
+    // Floats are written in the machine's byte order, which is little-endian on every platform the vols format is read on.
+    if ( fprintf( f_ptr,
+           "ply\nformat binary_little_endian 1.0\ncomment Exported by Volograms vol2obj\nelement vertex %u\n"
+           "property float x\nproperty float y\nproperty float z\nproperty uchar red\nproperty uchar green\nproperty uchar blue\nend_header\n",
+           n_points ) < 0 ) {
+      goto _wpf_fail;
+    }
+  }
+  for ( uint32_t i = 0; i < n_points; i++ ) {
+    uint8_t record[15];
+    memcpy( record, &points_ptr[i * 3], 12 );
+    memcpy( &record[12], &rgb_ptr[i * 3], 3 );
+    if ( 1 != fwrite( record, sizeof( record ), 1, f_ptr ) ) { goto _wpf_fail; }
+  }
+
+  fclose( f_ptr );
+  _printlog( _LOG_TYPE_INFO, "Wrote point cloud file `%s`.\n", full_path );
+  return true;
+
+_wpf_fail:
+  fclose( f_ptr );
+  _printlog( _LOG_TYPE_ERROR, "ERROR: Could not write point cloud file `%s`.\n", full_path );
+  return false;
+}
+
+/** Write frames between `first_frame_idx` and `last_frame_idx` to point cloud files, coloured from the texture.
+ * Each video texture frame is decoded in step with its geometry frame and sampled straight from vol_av's pixel buffer, so no images are written.
+ * Points are white if the vologram has no texture.
+ *
+ * @return
+ * Returns false on error.
+ */
+static bool _process_points( int first_frame_idx, int last_frame_idx, bool use_vol_av, _points_format_t points_format ) {
+  const char* filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  bool success         = false;
+  bool opened_video    = false;
+
+  // A frame's vertex array is never bigger than its blob, and there are 3 bytes of colour per 12-byte vertex.
+  uint8_t* rgb_ptr = malloc( _geom_info.biggest_frame_blob_sz );
+  if ( !rgb_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Allocating memory for point colours.\n" );
+    return false;
+  }
+
+  if ( use_vol_av ) {
+    if ( !vol_av_open( _input_video_filename, &_av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open video file %s.\n", _input_video_filename );
+      goto _pp_end;
+    }
+    opened_video = true;
+    int n_frames = (int)vol_av_frame_count( &_av_info );
+    if ( last_frame_idx >= n_frames ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %i is not in range of video's %i frames\n", last_frame_idx, n_frames );
+      goto _pp_end;
+    }
+    // Skip up to first frame to write.
+    for ( int i = 0; i < first_frame_idx; i++ ) {
+      if ( !vol_av_read_next_frame( &_av_info ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frames from video sequence.\n" );
+        goto _pp_end;
+      }
+    }
+  }
+
+  for ( int i = first_frame_idx; i <= last_frame_idx; i++ ) {
+    _geom_frame_t frame;
+    VOL_TRACE_BEGIN( "vol2obj_geom_frame" );
+    bool frame_ok = _read_geom_frame( filename, i, &frame );
+    VOL_TRACE_END( "vol2obj_geom_frame" );
+    if ( !frame_ok ) { goto _pp_end; }
+    uint32_t n_points    = frame.points_sz / ( sizeof( float ) * 3 );
+    uint32_t n_texcoords = frame.texcoords_sz / ( sizeof( float ) * 2 );
+
+    const uint8_t* texture_ptr = NULL;
+    int w = 0, h = 0, n = 3;
+    if ( use_vol_av ) {
+      VOL_TRACE_BEGIN( "vol2obj_decode_video" );
+      bool read_ok = vol_av_read_next_frame( &_av_info );
+      VOL_TRACE_END( "vol2obj_decode_video" );
+      if ( !read_ok ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frames from video sequence.\n" );
+        goto _pp_end;
+      }
+      texture_ptr = _av_info.pixels_ptr;
+      w           = _av_info.w;
+      h           = _av_info.h;
+    } else if ( frame.texture_data_ptr ) {
+      n          = 4;
+      int format = 13; // { 13 = cTFRGBA32, 3 = cTFBC3_RGBA }. Defined in basis_transcoder.h.
+      VOL_TRACE_BEGIN( "vol2obj_transcode_basis" );
+      bool transcode_ok =
+        vol_basis_transcode( format, frame.texture_data_ptr, frame.texture_data_sz, _output_blocks_ptr, _dims_presize * _dims_presize * n, &w, &h );
+      VOL_TRACE_END( "vol2obj_transcode_basis" );
+      if ( !transcode_ok ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Transcoding image %i failed.\n", i );
+        goto _pp_end;
+      }
+      texture_ptr = _output_blocks_ptr;
+    }
+
+    if ( texture_ptr && n_texcoords >= n_points ) {
+      VOL_TRACE_BEGIN( "vol2obj_sample_colours" );
+      vol_image_sample_rgb( texture_ptr, w, h, n, frame.texcoords_ptr, n_points, rgb_ptr );
+      VOL_TRACE_END( "vol2obj_sample_colours" );
+    } else {
+      memset( rgb_ptr, 0xFF, (size_t)n_points * 3 );
+    }
+
+    sprintf( _output_points_filename, "%s%08i.%s", _prefix_str, i, _POINTS_FORMAT_PLY == points_format ? "ply" : "xyzrgb" );
+    VOL_TRACE_BEGIN( "vol2obj_write_points" );
+    vol_mesh_transform_vertices( &_xform, frame.points_ptr, _xform_points_ptr, n_points );
+    bool points_ok = _write_points_file( _output_points_filename, points_format, _xform_points_ptr, rgb_ptr, n_points );
+    VOL_TRACE_END( "vol2obj_write_points" );
+    if ( !points_ok ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write point cloud frame %i to file\n", i );
+      goto _pp_end;
+    }
+  } // endfor frames.
+  success = true;
+
+_pp_end:
+  if ( opened_video && !vol_av_close( &_av_info ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to close video info\n" );
+    success = false;
+  }
+  free( rgb_ptr );
+  return success;
+}
+
+/** Where one glTF buffer view sits in the .bin file, and the layout of the accessor that reads it. */
+typedef struct _gltf_view_t {
+  uint64_t offset;
+  uint32_t length;
+  int target;           // 34962 for vertex attributes, 34963 for indices, or 0.
+  int component_type;   // 5126 float, 5123 unsigned short, 5125 unsigned int, or 0 for images, which have no accessor.
+  uint32_t count;       // Number of accessor elements.
+  const char* type_str; // Accessor element type e.g. "VEC3".
+  bool has_bounds;      // glTF requires min and max for positions.
+  float min[3], max[3];
+} _gltf_view_t;
+
+/** One frame of a glTF sequence, as indices into the array of views, or -1 if absent. */
+typedef struct _gltf_frame_t {
+  int frame_idx;
+  int position_view, normal_view, texcoord_view, index_view, image_view;
+  int anim_input_view, anim_output_view;
+} _gltf_frame_t;
+
+/** Streams a sequence into a glTF .bin file in a single pass, keeping only the small per-frame layout in memory for the JSON written at the end. */
+typedef struct _gltf_writer_t {
+  FILE* bin_ptr;
+  uint64_t bin_sz;
+  bool write_failed;
+  _gltf_view_t* views_ptr;
+  uint32_t n_views, views_capacity;
+  _gltf_frame_t* frames_ptr;
+  uint32_t n_frames, frames_capacity;
+} _gltf_writer_t;
+
+static void _gltf_write_bytes( _gltf_writer_t* gw_ptr, const void* data_ptr, size_t sz ) {
+  if ( sz > 0 && 1 != fwrite( data_ptr, sz, 1, gw_ptr->bin_ptr ) ) { gw_ptr->write_failed = true; }
+  gw_ptr->bin_sz += sz;
+}
+
+/** stb_image_write callback, so JPEGs go straight into the .bin. */
+static void _gltf_jpeg_callback( void* context_ptr, void* data_ptr, int sz ) { _gltf_write_bytes( (_gltf_writer_t*)context_ptr, data_ptr, (size_t)sz ); }
+
+/** Ends the view started at `view.offset`, padding the .bin to 4 bytes as glTF requires for the next view.
+ * @returns The view's index, or -1 if out of memory.
+ */
+static int _gltf_end_view( _gltf_writer_t* gw_ptr, _gltf_view_t view ) {
+  static const uint8_t zeros[4] = { 0 };
+  view.length                   = (uint32_t)( gw_ptr->bin_sz - view.offset );
+  _gltf_write_bytes( gw_ptr, zeros, ( 4 - view.length % 4 ) % 4 );
+  if ( gw_ptr->n_views == gw_ptr->views_capacity ) {
+    uint32_t capacity       = gw_ptr->views_capacity ? gw_ptr->views_capacity * 2 : 256;
+    _gltf_view_t* views_ptr = realloc( gw_ptr->views_ptr, capacity * sizeof( _gltf_view_t ) );
+    if ( !views_ptr ) { return -1; }
+    gw_ptr->views_ptr      = views_ptr;
+    gw_ptr->views_capacity = capacity;
+  }
+  gw_ptr->views_ptr[gw_ptr->n_views] = view;
+  return (int)gw_ptr->n_views++;
+}
+
+static int _gltf_add_view( _gltf_writer_t* gw_ptr, const void* data_ptr, uint32_t sz, int target, int component_type, uint32_t count, const char* type_str ) {
+  _gltf_view_t view = { .offset = gw_ptr->bin_sz, .target = target, .component_type = component_type, .count = count, .type_str = type_str };
+  _gltf_write_bytes( gw_ptr, data_ptr, sz );
+  return _gltf_end_view( gw_ptr, view );
+}
+
+static int _gltf_add_image( _gltf_writer_t* gw_ptr, const uint8_t* pixels_ptr, int w, int h, int n ) {
+  _gltf_view_t view = { .offset = gw_ptr->bin_sz };
+  VOL_TRACE_BEGIN( "vol2obj_write_jpg" );
+  int write_ok = stbi_write_jpg_to_func( _gltf_jpeg_callback, gw_ptr, w, h, n, pixels_ptr, _jpeg_quality );
+  VOL_TRACE_END( "vol2obj_write_jpg" );
+  if ( !write_ok ) { return -1; }
+  return _gltf_end_view( gw_ptr, view );
+}
+
+static bool _gltf_push_frame( _gltf_writer_t* gw_ptr, _gltf_frame_t frame ) {
+  if ( gw_ptr->n_frames == gw_ptr->frames_capacity ) {
+    uint32_t capacity         = gw_ptr->frames_capacity ? gw_ptr->frames_capacity * 2 : 64;
+    _gltf_frame_t* frames_ptr = realloc( gw_ptr->frames_ptr, capacity * sizeof( _gltf_frame_t ) );
+    if ( !frames_ptr ) { return false; }
+    gw_ptr->frames_ptr      = frames_ptr;
+    gw_ptr->frames_capacity = capacity;
+  }
+  gw_ptr->frames_ptr[gw_ptr->n_frames++] = frame;
+  return true;
+}
+
+/** Writes a filename as a relative URI, percent-encoding anything that isn't an unreserved character. */
+static void _gltf_print_uri( FILE* f_ptr, const char* filename ) {
+  for ( const unsigned char* c_ptr = (const unsigned char*)filename; *c_ptr; c_ptr++ ) {
+    if ( ( *c_ptr >= 'a' && *c_ptr <= 'z' ) || ( *c_ptr >= 'A' && *c_ptr <= 'Z' ) || ( *c_ptr >= '0' && *c_ptr <= '9' ) || strchr( "-._~", *c_ptr ) ) {
+      fputc( *c_ptr, f_ptr );
+    } else {
+      fprintf( f_ptr, "%%%02X", *c_ptr );
+    }
+  }
+}
+
+/** Appends each frame's visibility animation to the .bin, then writes the .gltf JSON that describes everything in the .bin.
+ * Each frame is a node that is scaled to 0 except during its own frame time. Frame 0's node is the only one visible when the animation is not playing.
+ */
+static bool _gltf_finish( _gltf_writer_t* gw_ptr, const char* gltf_path, const char* bin_uri, double fps ) {
+  uint32_t n_frames = gw_ptr->n_frames;
+  for ( uint32_t k = 0; k < n_frames; k++ ) {
+    // STEP keys: hidden from the start, visible from this frame's time, and hidden again from the next frame's. The last frame stays visible to the end.
+    float times[3], scales[9];
+    uint32_t n_keys = 0;
+    if ( k > 0 ) { times[n_keys++] = 0.0f; }
+    times[n_keys++] = (float)( k / fps );
+    times[n_keys++] = (float)( ( k + 1 ) / fps );
+    for ( uint32_t j = 0; j < n_keys; j++ ) {
+      float s           = ( k > 0 && 0 == j ) || ( k + 1 < n_frames && j == n_keys - 1 ) ? 0.0f : 1.0f;
+      scales[j * 3 + 0] = scales[j * 3 + 1] = scales[j * 3 + 2] = s;
+    }
+    int input_view  = _gltf_add_view( gw_ptr, times, n_keys * sizeof( float ), 0, 5126, n_keys, "SCALAR" );
+    int output_view = _gltf_add_view( gw_ptr, scales, n_keys * 3 * sizeof( float ), 0, 5126, n_keys, "VEC3" );
+    if ( input_view < 0 || output_view < 0 ) { return false; }
+    _gltf_view_t* input_ptr                = &gw_ptr->views_ptr[input_view];
+    input_ptr->has_bounds                  = true; // glTF requires min and max for animation inputs too.
+    input_ptr->min[0]                      = times[0];
+    input_ptr->max[0]                      = times[n_keys - 1];
+    gw_ptr->frames_ptr[k].anim_input_view  = input_view;
+    gw_ptr->frames_ptr[k].anim_output_view = output_view;
+  }
+  // The .bin is complete, so close it before describing it.
+  bool bin_ok     = 0 == fclose( gw_ptr->bin_ptr ) && !gw_ptr->write_failed;
+  gw_ptr->bin_ptr = NULL;
+  if ( !bin_ok ) { return false; }
+
+  // Accessors are numbered in view order, skipping image views.
+  int* accessor_of_view_ptr = malloc( ( gw_ptr->n_views + 1 ) * sizeof( int ) );
+  if ( !accessor_of_view_ptr ) { return false; }
+  int n_accessors = 0;
+  for ( uint32_t v = 0; v < gw_ptr->n_views; v++ ) { accessor_of_view_ptr[v] = gw_ptr->views_ptr[v].component_type ? n_accessors++ : -1; }
+
+  FILE* f_ptr = fopen( gltf_path, "w" );
+  if ( !f_ptr ) {
+    free( accessor_of_view_ptr );
+    return false;
+  }
+  const _gltf_frame_t* frames_ptr = gw_ptr->frames_ptr;
+  int n_images                    = 0;
+  for ( uint32_t k = 0; k < n_frames; k++ ) { n_images += frames_ptr[k].image_view >= 0 ? 1 : 0; }
+
+  fprintf( f_ptr, "{\n  \"asset\": { \"version\": \"2.0\", \"generator\": \"Volograms vol2obj\" },\n" );
+  // Captures have their lighting baked into the texture, so shouldn't be lit again.
+  if ( n_images > 0 ) { fprintf( f_ptr, "  \"extensionsUsed\": [ \"KHR_materials_unlit\" ],\n" ); }
+  fprintf( f_ptr, "  \"scene\": 0,\n  \"scenes\": [ { \"nodes\": [ " );
+  for ( uint32_t k = 0; k < n_frames; k++ ) { fprintf( f_ptr, "%s%u", k ? ", " : "", k ); }
+  fprintf( f_ptr, " ] } ],\n  \"nodes\": [\n" );
+  for ( uint32_t k = 0; k < n_frames; k++ ) {
+    fprintf( f_ptr, "    { \"name\": \"frame_%08i\", \"mesh\": %u%s }%s\n", frames_ptr[k].frame_idx, k, k > 0 ? ", \"scale\": [ 0, 0, 0 ]" : "",
+      k + 1 < n_frames ? "," : "" );
+  }
+  fprintf( f_ptr, "  ],\n  \"meshes\": [\n" );
+  for ( uint32_t k = 0, material_idx = 0; k < n_frames; k++ ) {
+    const _gltf_frame_t* fr_ptr = &frames_ptr[k];
+    fprintf( f_ptr, "    { \"primitives\": [ { \"attributes\": { \"POSITION\": %i", accessor_of_view_ptr[fr_ptr->position_view] );
+    if ( fr_ptr->normal_view >= 0 ) { fprintf( f_ptr, ", \"NORMAL\": %i", accessor_of_view_ptr[fr_ptr->normal_view] ); }
+    if ( fr_ptr->texcoord_view >= 0 ) { fprintf( f_ptr, ", \"TEXCOORD_0\": %i", accessor_of_view_ptr[fr_ptr->texcoord_view] ); }
+    fprintf( f_ptr, " }, \"indices\": %i", accessor_of_view_ptr[fr_ptr->index_view] );
+    if ( fr_ptr->image_view >= 0 ) { fprintf( f_ptr, ", \"material\": %u", material_idx++ ); }
+    fprintf( f_ptr, " } ] }%s\n", k + 1 < n_frames ? "," : "" );
+  }
+  fprintf( f_ptr, "  ],\n" );
+  if ( n_images > 0 ) {
+    fprintf( f_ptr, "  \"materials\": [\n" );
+    for ( int m = 0; m < n_images; m++ ) {
+      fprintf( f_ptr, "    { \"pbrMetallicRoughness\": { \"baseColorTexture\": { \"index\": %i }, \"metallicFactor\": 0 }, ", m );
+      fprintf( f_ptr, "\"extensions\": { \"KHR_materials_unlit\": {} } }%s\n", m + 1 < n_images ? "," : "" );
+    }
+    fprintf( f_ptr, "  ],\n  \"textures\": [\n" );
+    for ( int m = 0; m < n_images; m++ ) { fprintf( f_ptr, "    { \"sampler\": 0, \"source\": %i }%s\n", m, m + 1 < n_images ? "," : "" ); }
+    fprintf( f_ptr, "  ],\n  \"images\": [\n" );
+    for ( uint32_t k = 0, m = 0; k < n_frames; k++ ) {
+      if ( frames_ptr[k].image_view < 0 ) { continue; }
+      fprintf( f_ptr, "    { \"bufferView\": %i, \"mimeType\": \"image/jpeg\" }%s\n", frames_ptr[k].image_view, (int)++m < n_images ? "," : "" );
+    }
+    fprintf( f_ptr, "  ],\n  \"samplers\": [ { \"magFilter\": 9729, \"minFilter\": 9729, \"wrapS\": 33071, \"wrapT\": 33071 } ],\n" );
+  }
+  fprintf( f_ptr, "  \"animations\": [ {\n    \"name\": \"vologram\",\n    \"samplers\": [\n" );
+  for ( uint32_t k = 0; k < n_frames; k++ ) {
+    fprintf( f_ptr, "      { \"input\": %i, \"output\": %i, \"interpolation\": \"STEP\" }%s\n", accessor_of_view_ptr[frames_ptr[k].anim_input_view],
+      accessor_of_view_ptr[frames_ptr[k].anim_output_view], k + 1 < n_frames ? "," : "" );
+  }
+  fprintf( f_ptr, "    ],\n    \"channels\": [\n" );
+  for ( uint32_t k = 0; k < n_frames; k++ ) {
+    fprintf( f_ptr, "      { \"sampler\": %u, \"target\": { \"node\": %u, \"path\": \"scale\" } }%s\n", k, k, k + 1 < n_frames ? "," : "" );
+  }
+  fprintf( f_ptr, "    ]\n  } ],\n  \"buffers\": [ { \"uri\": \"" );
+  _gltf_print_uri( f_ptr, bin_uri );
+  fprintf( f_ptr, "\", \"byteLength\": %llu } ],\n  \"bufferViews\": [\n", (unsigned long long)gw_ptr->bin_sz );
+  for ( uint32_t v = 0; v < gw_ptr->n_views; v++ ) {
+    const _gltf_view_t* view_ptr = &gw_ptr->views_ptr[v];
+    fprintf( f_ptr, "    { \"buffer\": 0, \"byteOffset\": %llu, \"byteLength\": %u", (unsigned long long)view_ptr->offset, view_ptr->length );
+    if ( view_ptr->target ) { fprintf( f_ptr, ", \"target\": %i", view_ptr->target ); }
+    fprintf( f_ptr, " }%s\n", v + 1 < gw_ptr->n_views ? "," : "" );
+  }
+  fprintf( f_ptr, "  ],\n  \"accessors\": [\n" );
+  for ( uint32_t v = 0, a = 0; v < gw_ptr->n_views; v++ ) {
+    const _gltf_view_t* view_ptr = &gw_ptr->views_ptr[v];
+    if ( !view_ptr->component_type ) { continue; }
+    fprintf( f_ptr, "    { \"bufferView\": %u, \"componentType\": %i, \"count\": %u, \"type\": \"%s\"", v, view_ptr->component_type, view_ptr->count,
+      view_ptr->type_str );
+    if ( view_ptr->has_bounds ) {
+      int n_comps = 0 == strcmp( view_ptr->type_str, "VEC3" ) ? 3 : 1;
+      fprintf( f_ptr, ", \"min\": [ " );
+      for ( int c = 0; c < n_comps; c++ ) { fprintf( f_ptr, "%s%.9g", c ? ", " : "", view_ptr->min[c] ); }
+      fprintf( f_ptr, " ], \"max\": [ " );
+      for ( int c = 0; c < n_comps; c++ ) { fprintf( f_ptr, "%s%.9g", c ? ", " : "", view_ptr->max[c] ); }
+      fprintf( f_ptr, " ]" );
+    }
+    fprintf( f_ptr, " }%s\n", (int)++a < n_accessors ? "," : "" );
+  }
+  fprintf( f_ptr, "  ]\n}\n" );
+
+  free( accessor_of_view_ptr );
+  return 0 == fclose( f_ptr );
+}
+
+/** Write frames between `first_frame_idx` and `last_frame_idx` to a single glTF file, with one external .bin buffer, that plays back the sequence.
+ * Each keyframe's indices and UVs are written once and shared by the frames that follow it. Each frame has its own positions, normals, and JPEG texture,
+ * and is shown at its frame time by a visibility animation. Video texture frames are decoded in step with geometry frames, and everything goes to the
+ * .bin as it is read, so memory use doesn't grow with the sequence's length, apart from a few bytes per frame to describe the layout.
+ *
+ * @return
+ * Returns false on error.
+ */
+static bool _process_gltf_sequence( int first_frame_idx, int last_frame_idx, bool use_vol_av, const char* gltf_filename, bool no_normals, bool gen_normals ) {
+  const char* filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  bool success         = false;
+  bool opened_video    = false;
+  char gltf_path[MAX_FILENAME_LEN], bin_path[MAX_FILENAME_LEN];
+  _gltf_writer_t gw = { .bin_ptr = NULL };
+
+  { // The .bin goes next to the .gltf, with the same name.
+    size_t len        = strlen( gltf_filename );
+    bool has_gltf_ext = len > 5 && 0 == strcasecmp( &gltf_filename[len - 5], ".gltf" );
+    int stem_len      = (int)( has_gltf_ext ? len - 5 : len );
+    snprintf( gltf_path, MAX_FILENAME_LEN, "%s%.*s.gltf", _output_dir_path, stem_len, gltf_filename );
+    snprintf( bin_path, MAX_FILENAME_LEN, "%s%.*s.bin", _output_dir_path, stem_len, gltf_filename );
+  }
+  const char* bin_uri = bin_path;
+  for ( const char* c_ptr = bin_path; *c_ptr; c_ptr++ ) {
+    if ( '/' == *c_ptr || '\\' == *c_ptr ) { bin_uri = c_ptr + 1; }
+  }
+
+  // Positions, normals, UVs, and indices are each converted here before writing. None are bigger than a frame's blob.
+  uint8_t* scratch_ptr = malloc( _geom_info.biggest_frame_blob_sz );
+  if ( !scratch_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Allocating memory for glTF conversion.\n" );
+    return false;
+  }
+  gw.bin_ptr = fopen( bin_path, "wb" );
+  if ( !gw.bin_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", bin_path );
+    goto _pgs_end;
+  }
+
+  double fps = _geom_info.hdr.fps > 0.0f ? _geom_info.hdr.fps : 30.0;
+  if ( use_vol_av ) {
+    if ( !vol_av_open( _input_video_filename, &_av_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open video file %s.\n", _input_video_filename );
+      goto _pgs_end;
+    }
+    opened_video = true;
+    if ( _geom_info.hdr.fps <= 0.0f && vol_av_frame_rate( &_av_info ) > 0.0 ) { fps = vol_av_frame_rate( &_av_info ); }
+    int n_frames = (int)vol_av_frame_count( &_av_info );
+    if ( last_frame_idx >= n_frames ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %i is not in range of video's %i frames\n", last_frame_idx, n_frames );
+      goto _pgs_end;
+    }
+    // Skip up to first frame to write.
+    for ( int i = 0; i < first_frame_idx; i++ ) {
+      if ( !vol_av_read_next_frame( &_av_info ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frames from video sequence.\n" );
+        goto _pgs_end;
+      }
+    }
+  }
+
+  int segment_key_idx = -1, segment_index_view = -1, segment_texcoord_view = -1;
+  for ( int i = first_frame_idx; i <= last_frame_idx; i++ ) {
+    _geom_frame_t frame;
+    VOL_TRACE_BEGIN( "vol2obj_geom_frame" );
+    bool frame_ok = _read_geom_frame( filename, i, &frame );
+    VOL_TRACE_END( "vol2obj_geom_frame" );
+    if ( !frame_ok ) { goto _pgs_end; }
+    uint32_t n_points    = frame.points_sz / ( sizeof( float ) * 3 );
+    uint32_t n_texcoords = frame.texcoords_sz / ( sizeof( float ) * 2 );
+    bool u32_indices     = n_points >= 65535; // As in the .vols spec.
+    uint32_t index_sz    = u32_indices ? 4 : 2;
+    uint32_t n_indices   = frame.indices_sz / index_sz;
+
+    VOL_TRACE_BEGIN( "vol2obj_write_gltf_frame" );
+    _gltf_frame_t gf = { .frame_idx = i, .normal_view = -1, .texcoord_view = -1, .image_view = -1 };
+    // Keyframe data is written once, at the first frame of each keyframe's segment.
+    int key_idx = vol_geom_find_previous_keyframe( &_geom_info, i );
+    if ( key_idx != segment_key_idx ) {
+      // Reverse the winding order, as for .obj files, if the export transform mirrors the mesh.
+      if ( !_copy_indices_for_xform( frame.indices_ptr, scratch_ptr, n_indices, u32_indices ? VOL_MESH_INDEX_TYPE_U32 : VOL_MESH_INDEX_TYPE_U16 ) ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %i's index count %u is not a whole number of triangles.\n", i, n_indices );
+        VOL_TRACE_END( "vol2obj_write_gltf_frame" );
+        goto _pgs_end;
+      }
+      segment_index_view = _gltf_add_view( &gw, scratch_ptr, n_indices * index_sz, 34963, u32_indices ? 5125 : 5123, n_indices, "SCALAR" );
+      segment_texcoord_view = -1;
+      if ( n_texcoords >= n_points ) {
+        // glTF's UVs start at the top of the image.
+        float* uvs_ptr = (float*)scratch_ptr;
+        vol_mesh_flip_v( frame.texcoords_ptr, uvs_ptr, n_points );
+        segment_texcoord_view = _gltf_add_view( &gw, uvs_ptr, n_points * 2 * sizeof( float ), 34962, 5126, n_points, "VEC2" );
+      }
+      segment_key_idx = key_idx;
+    }
+    gf.index_view    = segment_index_view;
+    gf.texcoord_view = segment_texcoord_view;
+
+    { // Positions, transformed as for .obj files.
+      float* xyz_ptr = (float*)scratch_ptr;
+      float min[3] = { 0.0f }, max[3] = { 0.0f };
+      vol_mesh_transform_vertices( &_xform, frame.points_ptr, xyz_ptr, n_points );
+      for ( uint32_t v = 0; v < n_points; v++ ) {
+        for ( int c = 0; c < 3; c++ ) {
+          if ( 0 == v || xyz_ptr[v * 3 + c] < min[c] ) { min[c] = xyz_ptr[v * 3 + c]; }
+          if ( 0 == v || xyz_ptr[v * 3 + c] > max[c] ) { max[c] = xyz_ptr[v * 3 + c]; }
+        }
+      }
+      gf.position_view = _gltf_add_view( &gw, xyz_ptr, n_points * 3 * sizeof( float ), 34962, 5126, n_points, "VEC3" );
+      if ( gf.position_view >= 0 ) {
+        gw.views_ptr[gf.position_view].has_bounds = true;
+        memcpy( gw.views_ptr[gf.position_view].min, min, sizeof( min ) );
+        memcpy( gw.views_ptr[gf.position_view].max, max, sizeof( max ) );
+      }
+    }
+
+    const float* normals_ptr = NULL;
+    if ( gen_normals && !no_normals ) {
+      VOL_TRACE_BEGIN( "vol2obj_gen_normals" );
+      bool normals_ok = vol_mesh_compute_normals(
+        frame.points_ptr, n_points, frame.indices_ptr, n_indices, u32_indices ? VOL_MESH_INDEX_TYPE_U32 : VOL_MESH_INDEX_TYPE_U16, _gen_normals_ptr );
+      VOL_TRACE_END( "vol2obj_gen_normals" );
+      if ( !normals_ok ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to compute normals for frame %i.\n", i );
+        goto _pgs_end;
+      }
+      normals_ptr = _gen_normals_ptr;
+    } else if ( !no_normals && frame.normals_sz >= n_points * 3 * sizeof( float ) ) {
+      normals_ptr = frame.normals_ptr;
+    }
+    if ( normals_ptr ) {
+      float* xyz_ptr = (float*)scratch_ptr;
+      vol_mesh_transform_normals( &_xform, normals_ptr, xyz_ptr, n_points );
+      gf.normal_view = _gltf_add_view( &gw, xyz_ptr, n_points * 3 * sizeof( float ), 34962, 5126, n_points, "VEC3" );
+    }
+    VOL_TRACE_END( "vol2obj_write_gltf_frame" );
+
+    if ( use_vol_av ) {
+      VOL_TRACE_BEGIN( "vol2obj_decode_video" );
+      bool read_ok = vol_av_read_next_frame( &_av_info );
+      VOL_TRACE_END( "vol2obj_decode_video" );
+      if ( !read_ok ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Reading frames from video sequence.\n" );
+        goto _pgs_end;
+      }
+      if ( gf.texcoord_view >= 0 ) { gf.image_view = _gltf_add_image( &gw, _av_info.pixels_ptr, _av_info.w, _av_info.h, 3 ); }
+    } else if ( frame.texture_data_ptr && gf.texcoord_view >= 0 ) {
+      int w = 0, h = 0, n = 4;
+      int format = 13; // { 13 = cTFRGBA32, 3 = cTFBC3_RGBA }. Defined in basis_transcoder.h.
+      VOL_TRACE_BEGIN( "vol2obj_transcode_basis" );
+      bool transcode_ok =
+        vol_basis_transcode( format, frame.texture_data_ptr, frame.texture_data_sz, _output_blocks_ptr, _dims_presize * _dims_presize * n, &w, &h );
+      VOL_TRACE_END( "vol2obj_transcode_basis" );
+      if ( !transcode_ok ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Transcoding image %i failed.\n", i );
+        goto _pgs_end;
+      }
+      gf.image_view = _gltf_add_image( &gw, _output_blocks_ptr, w, h, n );
+    }
+    bool texture_ok = gf.image_view >= 0 || gf.texcoord_view < 0 || !( use_vol_av || frame.texture_data_ptr ); // Textures need UVs.
+
+    if ( gf.index_view < 0 || gf.position_view < 0 || !texture_ok || gw.write_failed || !_gltf_push_frame( &gw, gf ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame %i to glTF buffer `%s`.\n", i, bin_path );
+      goto _pgs_end;
+    }
+  } // endfor frames.
+
+  VOL_TRACE_BEGIN( "vol2obj_write_gltf" );
+  bool finish_ok = _gltf_finish( &gw, gltf_path, bin_uri, fps );
+  VOL_TRACE_END( "vol2obj_write_gltf" );
+  if ( !finish_ok ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Could not write glTF file `%s`.\n", gltf_path );
+    goto _pgs_end;
+  }
+  _printlog( _LOG_TYPE_INFO, "Wrote %u frames to glTF file `%s` and buffer `%s`.\n", gw.n_frames, gltf_path, bin_path );
+  success = true;
+
+_pgs_end:
+  if ( gw.bin_ptr ) { fclose( gw.bin_ptr ); } // Only still open on failure.
+  if ( opened_video && !vol_av_close( &_av_info ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to close video info\n" );
+    success = false;
+  }
+  free( gw.views_ptr );
+  free( gw.frames_ptr );
+  free( scratch_ptr );
+  return success;
+}
+
+/** Write frames between `first_frame_idx` and `last_frame_idx` to a vol_cache mesh cache file, for import into VFX tools.
+ * Each keyframe's indices and UVs are written once, as a cache segment, then each frame's positions and normals are written as a time sample.
+ * Frames are streamed from the vologram one at a time. Textures are not included in the cache.
+ *
+ * @param upsample
+ * Number of samples to write per frame, at that multiple of the frame rate. Samples between two frames of a keyframe segment
+ * are interpolated from them, and the last frame before a keyframe, or of the range, is held.
+ * @return
+ * Returns false on error.
+ */
+static bool _process_cache(
+  int first_frame_idx, int last_frame_idx, bool use_vol_av, const char* cache_filename, bool no_normals, bool gen_normals, uint32_t upsample ) {
+  const char* filename = _input_combined_filename ? _input_combined_filename : _input_sequence_filename;
+  char cache_path[MAX_FILENAME_LEN];
+  snprintf( cache_path, MAX_FILENAME_LEN, "%s%s", _output_dir_path, cache_filename );
+
+  float fps = _geom_info.hdr.fps;
+  if ( fps <= 0.0f && use_vol_av ) { // Older volograms only have a frame rate in their video texture.
+    if ( vol_av_open( _input_video_filename, &_av_info ) ) {
+      fps = (float)vol_av_frame_rate( &_av_info );
+      vol_av_close( &_av_info );
+    }
+  }
+  fps = ( fps > 0.0f ? fps : 30.0f ) * upsample;
+
+  // Indices, then positions and normals, are converted here before writing. None of the arrays is bigger than a frame's blob.
+  // When upsampling, the previous frame's positions and normals are kept too, and in-between samples' normals need their own array.
+  // In-between samples' positions reuse the indices' array, as they are written before any new segment.
+  // Each array starts on a 16-byte boundary, for the vector kernels.
+  size_t blob_sz       = ( (size_t)_geom_info.biggest_frame_blob_sz + 15 ) & ~(size_t)15;
+  uint8_t* scratch_ptr = malloc( blob_sz * ( upsample > 1 ? 6 : 3 ) );
+  if ( !scratch_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Allocating memory for cache conversion.\n" );
+    return false;
+  }
+  float* xyz_ptr         = (float*)&scratch_ptr[blob_sz];
+  float* nml_ptr         = (float*)&scratch_ptr[blob_sz * 2];
+  float* prev_xyz_ptr    = (float*)&scratch_ptr[blob_sz * 3];
+  float* prev_nml_ptr    = (float*)&scratch_ptr[blob_sz * 4];
+  float* lerp_xyz_ptr    = (float*)scratch_ptr;
+  float* lerp_nml_ptr    = (float*)&scratch_ptr[blob_sz * 5];
+  uint32_t prev_n_points = 0;
+  bool prev_has_normals  = false;
+
+  vol_cache_writer_t* writer_ptr = NULL;
+  bool success                   = false;
+  int segment_key_idx            = -1;
+  for ( int i = first_frame_idx; i <= last_frame_idx; i++ ) {
+    _geom_frame_t frame;
+    VOL_TRACE_BEGIN( "vol2obj_geom_frame" );
+    bool frame_ok = _read_geom_frame( filename, i, &frame );
+    VOL_TRACE_END( "vol2obj_geom_frame" );
+    if ( !frame_ok ) { goto _pc_end; }
+    uint32_t n_points    = frame.points_sz / ( sizeof( float ) * 3 );
+    uint32_t n_texcoords = frame.texcoords_sz / ( sizeof( float ) * 2 );
+    bool u32_indices     = n_points >= 65535; // As in the .vols spec.
+    uint32_t index_sz    = u32_indices ? 4 : 2;
+    uint32_t n_indices   = frame.indices_sz / index_sz;
+
+    const float* normals_ptr = NULL;
+    if ( gen_normals && !no_normals ) {
+      VOL_TRACE_BEGIN( "vol2obj_gen_normals" );
+      bool normals_ok = vol_mesh_compute_normals(
+        frame.points_ptr, n_points, frame.indices_ptr, n_indices, u32_indices ? VOL_MESH_INDEX_TYPE_U32 : VOL_MESH_INDEX_TYPE_U16, _gen_normals_ptr );
+      VOL_TRACE_END( "vol2obj_gen_normals" );
+      if ( !normals_ok ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to compute normals for frame %i.\n", i );
+        goto _pc_end;
+      }
+      normals_ptr = _gen_normals_ptr;
+    } else if ( !no_normals && frame.normals_sz >= n_points * 3 * sizeof( float ) ) {
+      normals_ptr = frame.normals_ptr;
+    }
+
+    // Which arrays the cache has is set by the first frame. All frames of a vologram have the same ones.
+    if ( !writer_ptr ) {
+      uint32_t flags = ( normals_ptr ? VOL_CACHE_FLAG_NORMALS : 0 ) | ( n_texcoords >= n_points ? VOL_CACHE_FLAG_UVS : 0 );
+      writer_ptr     = vol_cache_writer_open( cache_path, fps, flags );
+      if ( !writer_ptr ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", cache_path );
+        goto _pc_end;
+      }
+    }
+
+    VOL_TRACE_BEGIN( "vol2obj_write_cache_frame" );
+    bool write_ok = true;
+    int key_idx   = vol_geom_find_previous_keyframe( &_geom_info, i );
+    // Positions and normals, transformed as for .obj files.
+    if ( normals_ptr ) { vol_mesh_transform_normals( &_xform, normals_ptr, nml_ptr, n_points ); }
+    vol_mesh_transform_vertices( &_xform, frame.points_ptr, xyz_ptr, n_points );
+    if ( upsample > 1 && i > first_frame_idx ) {
+      // The previous frame's in-between samples, which go in its segment, so before any new one.
+      bool interpolate              = key_idx == segment_key_idx && n_points == prev_n_points;
+      vol_mesh_frame_view_t prev    = { .vertices_ptr = prev_xyz_ptr, .n_vertices = prev_n_points, .normals_ptr = prev_nml_ptr };
+      vol_mesh_frame_view_t current = { .vertices_ptr = xyz_ptr, .n_vertices = n_points, .normals_ptr = nml_ptr };
+      float* lerp_normals_ptr       = prev_has_normals && normals_ptr ? lerp_nml_ptr : NULL;
+      for ( uint32_t s = 1; s < upsample && write_ok; s++ ) {
+        if ( interpolate ) {
+          write_ok = vol_mesh_interpolate_frames( &prev, &current, (float)s / (float)upsample, lerp_xyz_ptr, lerp_normals_ptr );
+          write_ok = write_ok && vol_cache_write_sample( writer_ptr, lerp_xyz_ptr, lerp_normals_ptr );
+        } else {
+          write_ok = vol_cache_write_sample( writer_ptr, prev_xyz_ptr, prev_has_normals ? prev_nml_ptr : NULL );
+        }
+      }
+    }
+    if ( key_idx != segment_key_idx ) {
+      // Reverse the winding order, as for .obj files, if the export transform mirrors the mesh.
+      vol_mesh_index_type_t index_type = u32_indices ? VOL_MESH_INDEX_TYPE_U32 : VOL_MESH_INDEX_TYPE_U16;
+      uint8_t* indices_ptr             = scratch_ptr;
+      const float* uvs_ptr             = n_texcoords >= n_points ? frame.texcoords_ptr : NULL;
+      write_ok                         = write_ok && _copy_indices_for_xform( frame.indices_ptr, indices_ptr, n_indices, index_type );
+      write_ok                         = write_ok && vol_cache_write_segment( writer_ptr, indices_ptr, n_indices, index_sz, uvs_ptr, n_points );
+      segment_key_idx                  = key_idx;
+    }
+    write_ok = write_ok && vol_cache_write_sample( writer_ptr, xyz_ptr, normals_ptr ? nml_ptr : NULL );
+    if ( upsample > 1 ) {
+      // Keep this frame to interpolate from, by swapping arrays rather than copying.
+      float* tmp_ptr   = prev_xyz_ptr;
+      prev_xyz_ptr     = xyz_ptr;
+      xyz_ptr          = tmp_ptr;
+      tmp_ptr          = prev_nml_ptr;
+      prev_nml_ptr     = nml_ptr;
+      nml_ptr          = tmp_ptr;
+      prev_n_points    = n_points;
+      prev_has_normals = normals_ptr != NULL;
+      // The last frame of the range is held for its in-between samples, so the cache lasts as long as the frames did.
+      for ( uint32_t s = 1; i == last_frame_idx && s < upsample && write_ok; s++ ) {
+        write_ok = vol_cache_write_sample( writer_ptr, prev_xyz_ptr, prev_has_normals ? prev_nml_ptr : NULL );
+      }
+    }
+    VOL_TRACE_END( "vol2obj_write_cache_frame" );
+    if ( !write_ok ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Writing frame %i to cache file `%s`.\n", i, cache_path );
+      goto _pc_end;
+    }
+  } // endfor frames.
+  success = true;
+
+_pc_end:
+  if ( writer_ptr && !vol_cache_writer_close( writer_ptr ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Could not finish cache file `%s`.\n", cache_path );
+    success = false;
+  }
+  if ( success ) {
+    _printlog( _LOG_TYPE_INFO, "Wrote %i frames, as %i samples at %g fps, to cache file `%s`.\n", last_frame_idx - first_frame_idx + 1,
+      ( last_frame_idx - first_frame_idx + 1 ) * (int)upsample, fps, cache_path );
+  }
+  free( scratch_ptr );
+  return success;
+}
+
 /** Write frames between `first_frame_idx` and `last_frame_idx`,
  * or all of them, if `all_frames` is set,
- * to mesh, material, and image files.
+ * to mesh, material, and image files, or to point cloud files if `points_format` is set, or to one glTF file if `gltf_filename` is set,
+ * or to one mesh cache file if `cache_filename` is set, with `upsample` samples per frame.
  *
  * @return
  * Returns false on error.
  */
-static bool _process_vologram( int first_frame_idx, int last_frame_idx, bool all_frames, bool no_normals ) {
+static bool _process_vologram(    //
+  int first_frame_idx,            //
+  int last_frame_idx,             //
+  bool all_frames,                //
+  bool no_normals,                //
+  bool gen_normals,               //
+  _points_format_t points_format, //
+  const char* gltf_filename,      //
+  const char* cache_filename,     //
+  uint32_t upsample               //
+) {
   bool use_vol_av = false;
 
   // Mesh processing.
@@ -630,10 +1478,28 @@ static bool _process_vologram( int first_frame_idx, int last_frame_idx, bool all
       _printlog( _LOG_TYPE_ERROR, "ERROR: Allocating memory for maximally-sized frame blob.\n" );
       goto _pv_fail;
     }
+    _xform             = vol_mesh_transform_from_hdr( &_geom_info.hdr, true );
+    _xform_points_ptr  = malloc( _geom_info.biggest_frame_blob_sz );
+    _xform_normals_ptr = malloc( _geom_info.biggest_frame_blob_sz );
+    if ( !_xform_points_ptr || !_xform_normals_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Allocating memory for transformed vertices.\n" );
+      goto _pv_fail;
+    }
+    if ( gen_normals ) {
+      // A frame's vertex array is never bigger than its blob, and there is one normal per vertex.
+      _gen_normals_ptr = malloc( _geom_info.biggest_frame_blob_sz );
+      if ( !_gen_normals_ptr ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Allocating memory for generated normals.\n" );
+        goto _pv_fail;
+      }
+    }
 
-    if ( _geom_info.hdr.version < 13 ) {
+    // Single-file volograms made with packvols have no per-frame textures and keep the video texture alongside.
+    if ( _geom_info.hdr.version < 13 || ( !_geom_info.hdr.textured && _input_video_filename ) ) {
       use_vol_av = true;
-    } else {
+    } else if ( !_geom_info.hdr.textured ) {
+      _printlog( _LOG_TYPE_WARNING, "WARNING: Vologram has no textures. Use --video to give its video texture file.\n" );
+    } else if ( _geom_info.hdr.texture_compression > 0 ) {
       if ( !vol_basis_init() ) {
         _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to initialise Basis transcoder.\n" );
         goto _pv_fail;
@@ -647,23 +1513,40 @@ static bool _process_vologram( int first_frame_idx, int last_frame_idx, bool all
     }
     last_frame_idx = all_frames ? n_frames - 1 : last_frame_idx;
 
-    for ( int i = first_frame_idx; i <= last_frame_idx; i++ ) {
-      sprintf( _output_mesh_filename, "%s%08i.obj", _prefix_str, i );
-      sprintf( _output_mtl_filename, "%s%08i.mtl", _prefix_str, i );
-      sprintf( _material_name, "vol_mtl_%08i", i );
-      sprintf( _output_img_filename, "%s%08i.jpg", _prefix_str, i );
-
-      // And geometry.
-      if ( !_write_geom_frame_to_mesh( _input_sequence_filename, _input_combined_filename, _output_mesh_filename, _output_mtl_filename, _material_name, i, no_normals ) ) {
-        _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write geometry frame %i to file\n", i );
-        goto _pv_fail;
-      }
-      // Material file.
-      if ( !_write_mtl_file( _output_mtl_filename, _material_name, _output_img_filename ) ) {
-        _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write material file for frame %i\n", i );
-        goto _pv_fail;
-      }
-    } // endfor frames.
+    if ( points_format ) {
+      // In these modes video texture frames are consumed as they are decoded, so skip the video processing step below.
+      if ( !_process_points( first_frame_idx, last_frame_idx, use_vol_av, points_format ) ) { goto _pv_fail; }
+      use_vol_av = false;
+    } else if ( gltf_filename ) {
+      if ( !_process_gltf_sequence( first_frame_idx, last_frame_idx, use_vol_av, gltf_filename, no_normals, gen_normals ) ) { goto _pv_fail; }
+      use_vol_av = false;
+    } else if ( cache_filename ) {
+      // Caches hold geometry only, so there are no textures to process.
+      if ( !_process_cache( first_frame_idx, last_frame_idx, use_vol_av, cache_filename, no_normals, gen_normals, upsample ) ) { goto _pv_fail; }
+      use_vol_av = false;
+    } else {
+      for ( int i = first_frame_idx; i <= last_frame_idx; i++ ) {
+        sprintf( _output_mesh_filename, "%s%08i.obj", _prefix_str, i );
+        sprintf( _output_mtl_filename, "%s%08i.mtl", _prefix_str, i );
+        sprintf( _material_name, "vol_mtl_%08i", i );
+        sprintf( _output_img_filename, "%s%08i.jpg", _prefix_str, i );
+
+        // And geometry.
+        VOL_TRACE_BEGIN( "vol2obj_geom_frame" );
+        bool frame_ok = _write_geom_frame_to_mesh(
+          _input_sequence_filename, _input_combined_filename, _output_mesh_filename, _output_mtl_filename, _material_name, i, no_normals, gen_normals );
+        VOL_TRACE_END( "vol2obj_geom_frame" );
+        if ( !frame_ok ) {
+          _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write geometry frame %i to file\n", i );
+          goto _pv_fail;
+        }
+        // Material file.
+        if ( !_write_mtl_file( _output_mtl_filename, _material_name, _output_img_filename ) ) {
+          _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write material file for frame %i\n", i );
+          goto _pv_fail;
+        }
+      } // endfor frames.
+    } // endif points.
 
     if ( !vol_geom_free_file_info( &_geom_info ) ) {
       _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to free geometry info\n" );
@@ -717,20 +1600,31 @@ static bool _process_vologram( int first_frame_idx, int last_frame_idx, bool all
   } // endblock Video Processing.
 
   if ( _key_blob_ptr ) { free( _key_blob_ptr ); }
+  if ( _gen_normals_ptr ) { free( _gen_normals_ptr ); }
+  free( _xform_points_ptr );
+  free( _xform_normals_ptr );
   return true;
 
 _pv_fail:
   if ( _key_blob_ptr ) { free( _key_blob_ptr ); }
+  if ( _gen_normals_ptr ) { free( _gen_normals_ptr ); }
+  free( _xform_points_ptr );
+  free( _xform_normals_ptr );
   return false;
 }
 
 int main( int argc, char** argv ) {
   // Paths for drag-and-drop directory.
   char dad_hdr_str[MAX_FILENAME_LEN], dad_seq_str[MAX_FILENAME_LEN], dad_vid_str[MAX_FILENAME_LEN], test_vid_str[MAX_FILENAME_LEN];
-  int first_frame = 0;
-  int last_frame  = 0;
-  bool all_frames = false;
-  bool no_normals = false;
+  int first_frame                = 0;
+  int last_frame                 = 0;
+  bool all_frames                = false;
+  bool no_normals                = false;
+  bool gen_normals               = false;
+  _points_format_t points_format = _POINTS_FORMAT_NONE;
+  const char* gltf_filename      = NULL;
+  const char* cache_filename     = NULL;
+  uint32_t upsample              = 1;
 
   _output_blocks_ptr = (uint8_t*)malloc( _dims_presize * _dims_presize * 4 );
   if ( !_output_blocks_ptr ) {
@@ -794,8 +1688,9 @@ int main( int argc, char** argv ) {
         _print_cl_flags();
         return 0;
       }
-      all_frames = _option_arg_indices[CL_ALL_FRAMES] > 0;
-      no_normals = _option_arg_indices[CL_NO_NORMALS] > 0;
+      all_frames  = _option_arg_indices[CL_ALL_FRAMES] > 0;
+      no_normals  = _option_arg_indices[CL_NO_NORMALS] > 0;
+      gen_normals = _option_arg_indices[CL_GEN_NORMALS] > 0;
       if ( _option_arg_indices[CL_COMBINED] ) {
         _input_combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1];
         got_inputs               = true;
@@ -836,6 +1731,39 @@ int main( int argc, char** argv ) {
         }
         _printlog( _LOG_TYPE_INFO, "Using output directory = `%s`\n", _output_dir_path );
       }
+      if ( _option_arg_indices[CL_CACHE] ) { cache_filename = my_argv[_option_arg_indices[CL_CACHE] + 1]; }
+      if ( _option_arg_indices[CL_GLTF_SEQUENCE] ) { gltf_filename = my_argv[_option_arg_indices[CL_GLTF_SEQUENCE] + 1]; }
+      if ( cache_filename && ( gltf_filename || _option_arg_indices[CL_POINTS] ) ) {
+        _printlog( _LOG_TYPE_WARNING, "Argument --cache can't be used with --points or --gltf-sequence. Run with --help for details.\n" );
+        return 1;
+      }
+      if ( _option_arg_indices[CL_UPSAMPLE] ) {
+        int upsample_arg = atoi( my_argv[_option_arg_indices[CL_UPSAMPLE] + 1] );
+        if ( upsample_arg < 1 || upsample_arg > 100 ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument --upsample must be followed by a number from 1 to 100. Run with --help for details.\n" );
+          return 1;
+        }
+        if ( !cache_filename ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument --upsample can only be used with --cache. Run with --help for details.\n" );
+          return 1;
+        }
+        upsample = (uint32_t)upsample_arg;
+      }
+      if ( _option_arg_indices[CL_POINTS] ) {
+        const char* format_str = my_argv[_option_arg_indices[CL_POINTS] + 1];
+        if ( 0 == strcasecmp( format_str, "ply" ) ) {
+          points_format = _POINTS_FORMAT_PLY;
+        } else if ( 0 == strcasecmp( format_str, "xyzrgb" ) ) {
+          points_format = _POINTS_FORMAT_XYZRGB;
+        } else {
+          _printlog( _LOG_TYPE_WARNING, "Argument --points must be followed by `ply` or `xyzrgb`. Run with --help for details.\n" );
+          return 1;
+        }
+        if ( gltf_filename ) {
+          _printlog( _LOG_TYPE_WARNING, "Arguments --points and --gltf-sequence can't be used together. Run with --help for details.\n" );
+          return 1;
+        }
+      }
       if ( _option_arg_indices[CL_PREFIX] ) {
         _prefix_str[0] = '\0';
         int plen       = (int)strlen( my_argv[_option_arg_indices[CL_PREFIX] + 1] );
@@ -870,7 +1798,23 @@ int main( int argc, char** argv ) {
       _input_header_filename, _input_sequence_filename, _input_video_filename );
   }
 
-  if ( !_process_vologram( first_frame, last_frame, all_frames, no_normals ) ) { return 1; }
+  const char* trace_filename = _option_arg_indices[CL_TRACE] ? my_argv[_option_arg_indices[CL_TRACE] + 1] : NULL;
+#ifdef VOL_TRACE
+  vol_trace_set_thread_name( "vol2obj main" );
+#else
+  if ( trace_filename ) { _printlog( _LOG_TYPE_WARNING, "WARNING: --trace ignored. Rebuild with `make -e VOL_TRACE=1 vol2obj` to record traces.\n" ); }
+  trace_filename = NULL;
+#endif
+
+  bool processed_ok = _process_vologram( first_frame, last_frame, all_frames, no_normals, gen_normals, points_format, gltf_filename, cache_filename, upsample );
+  if ( trace_filename ) {
+    if ( vol_trace_write_json( trace_filename ) ) {
+      _printlog( _LOG_TYPE_INFO, "Wrote trace file `%s`\n", trace_filename );
+    } else {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to write trace file `%s`\n", trace_filename );
+    }
+  }
+  if ( !processed_ok ) { return 1; }
 
   _printlog( _LOG_TYPE_SUCCESS, "Vologram processing completed.\n" );
 
@@ -0,0 +1,670 @@
+/** @file main.c
+ * Volograms inspection tool.
+ *
+ * volsinfo  | Print a vologram's header, frame directory statistics, and optionally per-frame mesh statistics, as JSON.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * For checking customer files quickly, without printing every frame's contents as cutvols' `-p` does.
+ *
+ * By default only the header and vol_geom's frame directory are read. The directory is built from each frame's few header bytes, seeking past
+ * the frame data, and playback containers have it in their index, so this takes milliseconds even for very large files.
+ * The output has the header's fields, counts of keyframes and tracked frames, keyframe segment lengths, frame size statistics,
+ * and a histogram of frame sizes in power-of-two buckets, split into keyframes and tracked frames.
+ *
+ * With `--frames` every frame's data is read too, for per-frame vertex and triangle counts and bounding boxes.
+ * Frames are split into contiguous ranges, one per thread. Each thread has its own copy of the `vol_geom_info_t`, sharing its directory
+ * but with its own frame blob, so that `vol_geom_read_frame()` can run on all of them at once.
+ * Bounding boxes are of the positions as stored, before any v1.2 header transform. Problems found on the way are counted:
+ * non-finite positions, indices out of range of the keyframe's vertices, and tracked frames whose vertex count differs from their keyframe's.
+ *
+ * Usage Instructions
+ * ------------------
+ *     ./volsinfo.bin -c MYFILE.VOLS
+ *     ./volsinfo.bin -h HEADER.VOLS -s SEQUENCE.VOLS --frames -o info.json
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make volsinfo`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_geom.h"   // Volograms' .vols file parsing library.
+#include "vol_thread.h" // Volograms' threading helpers.
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#define fseeko _fseeki64
+#define ftello _ftelli64
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define VINFO_N_BUCKETS 64 // Frame size histogram buckets. Bucket `b` counts frames of 2^b to 2^(b+1) - 1 bytes.
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_COMBINED, CL_FRAMES, CL_HEADER, CL_HELP, CL_OUTPUT, CL_SEQUENCE, CL_THREADS, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** Statistics of one frame's data, filled in on a worker thread. */
+typedef struct _frame_stats_t {
+  uint32_t n_vertices;
+  uint32_t n_indices;          // Only keyframes have indices. Tracked frames use their keyframe's.
+  uint32_t n_triangles;        // The keyframe's, for tracked frames. Filled in on the main thread afterwards.
+  uint32_t texture_sz;
+  uint32_t n_non_finite;       // Positions with a NaN or infinite component. They are left out of the bounding box.
+  uint32_t n_bad_indices;      // Indices of vertices past the end of the keyframe's vertices.
+  float aabb_min[3], aabb_max[3];
+  bool has_aabb;               // False if the frame has no finite positions.
+  bool vertex_count_mismatch;  // A tracked frame with a different number of vertices than its keyframe. Filled in on the main thread.
+  bool failed;
+} _frame_stats_t;
+
+/** A worker thread's own view of the vologram, for reading frames in parallel. */
+typedef struct _reader_t {
+  vol_geom_info_t info; // A copy of `_geom_info`, with its own frame blob and chunk scratch memory.
+} _reader_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
+  { "--frames", "-f", "Also read every frame's data, for per-frame vertex and triangle counts and bounding boxes.\n", 0 },          // CL_FRAMES
+  { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output", "-o", "The next argument gives the path of the JSON file to write. Default is to write JSON to stdout.\n", 1 },    // CL_OUTPUT
+  { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }, // CL_SEQUENCE
+  { "--threads", "-t", "The next argument gives the number of threads to read frames with. Default is one per logical processor.\n", 1 } // CL_THREADS
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_geom_info_t _geom_info;  // Mesh information from vol_geom library.
+static const char* _seq_filename;   // The file frames are read from.
+static _reader_t* _readers_ptr;     // One per thread, for `--frames`.
+static _frame_stats_t* _stats_ptr;  // One per frame, for `--frames`.
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** @returns A monotonic time in seconds. */
+static double _time_s( void ) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency( &freq );
+  QueryPerformanceCounter( &count );
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/** @returns The size of a file in bytes, or -1 if it can't be opened. */
+static int64_t _file_sz( const char* filename ) {
+  FILE* f_ptr = fopen( filename, "rb" );
+  if ( !f_ptr ) { return -1; }
+  int64_t sz = 0 == fseeko( f_ptr, 0, SEEK_END ) ? (int64_t)ftello( f_ptr ) : -1;
+  fclose( f_ptr );
+  return sz;
+}
+
+/** @returns Index of the highest set bit of `sz`, i.e. the histogram bucket for a frame of `sz` bytes. 0 for 0 and 1. */
+static uint32_t _size_bucket( uint64_t sz ) {
+  uint32_t b = 0;
+  while ( sz > 1 ) {
+    sz >>= 1;
+    b++;
+  }
+  return b;
+}
+
+/*************************************************************************************************************************************************
+ * JSON output
+ *************************************************************************************************************************************************/
+
+/** Write a JSON string, with quotes, escaping anything that isn't printable ASCII. */
+static void _write_json_bytes( FILE* f_ptr, const char* bytes_ptr, size_t n ) {
+  fputc( '"', f_ptr );
+  for ( size_t i = 0; i < n; i++ ) {
+    unsigned char c = (unsigned char)bytes_ptr[i];
+    if ( '"' == c || '\\' == c ) {
+      fputc( '\\', f_ptr );
+      fputc( c, f_ptr );
+    } else if ( c < 0x20 || c >= 0x7F ) {
+      fprintf( f_ptr, "\\u%04x", c );
+    } else {
+      fputc( c, f_ptr );
+    }
+  }
+  fputc( '"', f_ptr );
+}
+
+static void _write_json_str( FILE* f_ptr, const char* key_str, const char* value_str ) {
+  fprintf( f_ptr, "    \"%s\": ", key_str );
+  _write_json_bytes( f_ptr, value_str, strlen( value_str ) );
+  fprintf( f_ptr, ",\n" );
+}
+
+/** Header strings are length-prefixed in the file, and aren't always NUL-terminated. */
+static void _write_json_short_str( FILE* f_ptr, const char* key_str, const vol_geom_short_str_t* str_ptr ) {
+  size_t n = str_ptr->sz < sizeof( str_ptr->bytes ) ? str_ptr->sz : sizeof( str_ptr->bytes );
+  fprintf( f_ptr, "    \"%s\": ", key_str );
+  _write_json_bytes( f_ptr, str_ptr->bytes, n );
+  fprintf( f_ptr, ",\n" );
+}
+
+/** JSON has no NaN or infinity, so those are written as null. */
+static void _write_json_floats( FILE* f_ptr, const float* values_ptr, int n ) {
+  fprintf( f_ptr, "[" );
+  for ( int i = 0; i < n; i++ ) {
+    if ( isfinite( values_ptr[i] ) ) {
+      fprintf( f_ptr, "%s%.9g", i > 0 ? ", " : "", values_ptr[i] );
+    } else {
+      fprintf( f_ptr, "%snull", i > 0 ? ", " : "" );
+    }
+  }
+  fprintf( f_ptr, "]" );
+}
+
+static const char* _codec_str( uint8_t codec ) {
+  switch ( codec ) {
+  case VOL_GEOM_CODEC_NONE: return "none";
+  case VOL_GEOM_CODEC_LZ4: return "lz4";
+  case VOL_GEOM_CODEC_LZ4_SHUFFLE: return "lz4-shuffle";
+  default: return "unknown";
+  }
+}
+
+/** @returns True if the header has a frame rate. Versions before 1.3 have none, and playback containers converted from them store 0. */
+static bool _has_fps( void ) {
+  if ( _geom_info.playback_version ) { return _geom_info.hdr.fps > 0.0f; }
+  return _geom_info.hdr.version >= 13;
+}
+
+/** Fields a vologram's version or container doesn't have are left out, rather than written as zeros. */
+static void _write_header_json( FILE* f_ptr, int64_t file_sz, bool combined ) {
+  const vol_geom_file_hdr_t* hdr_ptr = &_geom_info.hdr;
+  fprintf( f_ptr, "  \"header\": {\n" );
+  fprintf( f_ptr, "    \"file_bytes\": %lld,\n", (long long)file_sz );
+  fprintf( f_ptr, "    \"container\": \"%s\",\n", _geom_info.playback_version ? "playback" : "vols" );
+  if ( _geom_info.playback_version ) { fprintf( f_ptr, "    \"playback_version\": %u,\n", _geom_info.playback_version ); }
+  fprintf( f_ptr, "    \"version\": %u,\n    \"compression\": %u,\n", hdr_ptr->version, hdr_ptr->compression );
+  // Playback containers don't keep these, and v1.3 removed them.
+  if ( !_geom_info.playback_version && hdr_ptr->version < 13 ) {
+    _write_json_short_str( f_ptr, "format", &hdr_ptr->format );
+    _write_json_short_str( f_ptr, "mesh_name", &hdr_ptr->mesh_name );
+    _write_json_short_str( f_ptr, "material", &hdr_ptr->material );
+    _write_json_short_str( f_ptr, "shader", &hdr_ptr->shader );
+    fprintf( f_ptr, "    \"topology\": %u,\n", hdr_ptr->topology );
+  }
+  fprintf( f_ptr, "    \"frame_count\": %u,\n    \"normals\": %s,\n    \"textured\": %s,\n", hdr_ptr->frame_count, hdr_ptr->normals ? "true" : "false",
+    hdr_ptr->textured ? "true" : "false" );
+  fprintf( f_ptr, "    \"texture_compression\": %u,\n    \"texture_container_format\": %u,\n    \"texture_width\": %u,\n    \"texture_height\": %u,\n",
+    hdr_ptr->texture_compression, hdr_ptr->texture_container_format, hdr_ptr->texture_width, hdr_ptr->texture_height );
+  if ( 12 == hdr_ptr->version || _geom_info.playback_version ) {
+    fprintf( f_ptr, "    \"texture_format\": %u,\n    \"translation\": ", hdr_ptr->texture_format );
+    _write_json_floats( f_ptr, hdr_ptr->translation, 3 );
+    fprintf( f_ptr, ",\n    \"rotation\": " );
+    _write_json_floats( f_ptr, hdr_ptr->rotation, 4 );
+    fprintf( f_ptr, ",\n    \"scale\": %g,\n", hdr_ptr->scale );
+  }
+  if ( _has_fps() ) { fprintf( f_ptr, "    \"fps\": %g,\n", hdr_ptr->fps ); }
+  // v1.3 added frame_body_start. Sequence files and playback containers' chunk offsets start from byte 0, so only combined .vols have an offset.
+  if ( !_geom_info.playback_version && hdr_ptr->version >= 13 ) { fprintf( f_ptr, "    \"frame_body_start\": %u,\n", hdr_ptr->frame_body_start ); }
+  if ( !_geom_info.playback_version && combined ) { fprintf( f_ptr, "    \"sequence_offset\": %lld,\n", (long long)_geom_info.sequence_offset ); }
+  fprintf( f_ptr, "    \"audio\": %s,\n    \"audio_bytes\": %u\n  },\n", hdr_ptr->audio ? "true" : "false", _geom_info.audio_data_sz );
+}
+
+/** Frame counts, keyframe segments, sizes, and the size histogram, all from the frame directory. */
+static void _write_directory_json( FILE* f_ptr ) {
+  uint32_t n_frames                     = _geom_info.hdr.frame_count;
+  uint32_t n_keyframes                  = 0, n_last_tracked = 0, n_segments = 0, segment_min = UINT32_MAX, segment_max = 0, segment_start = 0;
+  uint32_t key_buckets[VINFO_N_BUCKETS] = { 0 }, tracked_buckets[VINFO_N_BUCKETS] = { 0 }, codec_counts[VOL_GEOM_CODEC_MAX + 1] = { 0 };
+  uint64_t total_sz                     = 0, key_total_sz = 0, stored_sz = 0, min_sz = UINT64_MAX, max_sz = 0;
+
+  for ( uint32_t i = 0; i < n_frames; i++ ) {
+    uint64_t sz  = (uint64_t)_geom_info.frames_directory_ptr[i].total_sz;
+    bool is_key  = vol_geom_is_keyframe( &_geom_info, i );
+    uint8_t type = _geom_info.frame_headers_ptr[i].keyframe;
+    uint32_t b   = _size_bucket( sz );
+    total_sz += sz;
+    min_sz = sz < min_sz ? sz : min_sz;
+    max_sz = sz > max_sz ? sz : max_sz;
+    if ( is_key ) {
+      n_keyframes++;
+      key_total_sz += sz;
+      key_buckets[b]++;
+    } else {
+      tracked_buckets[b]++;
+    }
+    if ( 2 == type ) { n_last_tracked++; }
+    // A segment runs from a first keyframe (1) up to the next one. "Last tracked frame" (2) keyframes end a segment, they don't start one.
+    if ( i > 0 && 1 == type ) {
+      uint32_t n    = i - segment_start;
+      segment_min   = n < segment_min ? n : segment_min;
+      segment_max   = n > segment_max ? n : segment_max;
+      segment_start = i;
+      n_segments++;
+    }
+    if ( _geom_info.playback_entries_ptr ) {
+      uint8_t codec = _geom_info.playback_entries_ptr[i].codec;
+      codec_counts[codec < VOL_GEOM_CODEC_MAX ? codec : VOL_GEOM_CODEC_MAX]++;
+      stored_sz += _geom_info.playback_entries_ptr[i].stored_sz;
+    }
+  }
+  if ( n_frames > 0 ) {
+    uint32_t n  = n_frames - segment_start;
+    segment_min = n < segment_min ? n : segment_min;
+    segment_max = n > segment_max ? n : segment_max;
+    n_segments++;
+  }
+
+  uint32_t n_tracked = n_frames - n_keyframes;
+  bool fps_known     = _has_fps() && _geom_info.hdr.fps > 0.0f;
+  float fps          = fps_known ? _geom_info.hdr.fps : 30.0f; // Files without an fps are captured at 30.
+  fprintf( f_ptr, "  \"frames\": {\n    \"count\": %u,\n    \"duration_s\": %.3f,\n", n_frames, n_frames / fps );
+  fprintf( f_ptr, "    \"duration_fps\": %g,\n    \"duration_fps_assumed\": %s,\n", fps, fps_known ? "false" : "true" );
+  fprintf( f_ptr, "    \"keyframes\": %u,\n    \"tracked_frames\": %u,\n    \"last_tracked_keyframes\": %u,\n", n_keyframes, n_tracked, n_last_tracked );
+  fprintf( f_ptr, "    \"first_frame_is_keyframe\": %s,\n", n_frames > 0 && 1 == _geom_info.frame_headers_ptr[0].keyframe ? "true" : "false" );
+  fprintf( f_ptr, "    \"segments\": %u,\n    \"segment_frames_min\": %u,\n    \"segment_frames_max\": %u,\n    \"segment_frames_mean\": %.2f\n  },\n",
+    n_segments, n_segments ? segment_min : 0, segment_max, n_segments ? (double)n_frames / n_segments : 0.0 );
+
+  fprintf( f_ptr, "  \"sizes\": {\n    \"total_bytes\": %llu,\n    \"frame_bytes_min\": %llu,\n    \"frame_bytes_max\": %llu,\n", (unsigned long long)total_sz,
+    (unsigned long long)( n_frames ? min_sz : 0 ), (unsigned long long)max_sz );
+  fprintf( f_ptr, "    \"frame_bytes_mean\": %.1f,\n    \"keyframe_bytes_mean\": %.1f,\n    \"tracked_frame_bytes_mean\": %.1f,\n",
+    n_frames ? (double)total_sz / n_frames : 0.0, n_keyframes ? (double)key_total_sz / n_keyframes : 0.0,
+    n_tracked ? (double)( total_sz - key_total_sz ) / n_tracked : 0.0 );
+  fprintf( f_ptr, "    \"bytes_per_s\": %.1f,\n", n_frames ? (double)total_sz * fps / n_frames : 0.0 );
+  if ( _geom_info.playback_entries_ptr ) {
+    fprintf( f_ptr, "    \"stored_bytes\": %llu,\n    \"compression_ratio\": %.3f,\n", (unsigned long long)stored_sz,
+      stored_sz ? (double)total_sz / stored_sz : 0.0 );
+    fprintf( f_ptr, "    \"codecs\": { \"none\": %u, \"lz4\": %u, \"lz4-shuffle\": %u, \"unknown\": %u },\n", codec_counts[VOL_GEOM_CODEC_NONE],
+      codec_counts[VOL_GEOM_CODEC_LZ4], codec_counts[VOL_GEOM_CODEC_LZ4_SHUFFLE], codec_counts[VOL_GEOM_CODEC_MAX] );
+  }
+  // Only the buckets from the smallest frame's to the biggest's, so the histogram stays short.
+  uint32_t first_b = _size_bucket( min_sz ), last_b = _size_bucket( max_sz );
+  fprintf( f_ptr, "    \"histogram\": [" );
+  for ( uint32_t b = first_b; n_frames && b <= last_b; b++ ) {
+    uint64_t bytes_max = b < 63 ? ( 1ull << ( b + 1 ) ) - 1 : UINT64_MAX;
+    fprintf( f_ptr, "%s\n      { \"bytes_min\": %llu, \"bytes_max\": %llu, \"keyframes\": %u, \"tracked_frames\": %u }", b > first_b ? "," : "",
+      (unsigned long long)( b > 0 ? 1ull << b : 0 ), (unsigned long long)bytes_max, key_buckets[b], tracked_buckets[b] );
+  }
+  fprintf( f_ptr, "%s]\n  }", n_frames ? "\n    " : "" );
+}
+
+/*************************************************************************************************************************************************
+ * Per-frame statistics
+ *************************************************************************************************************************************************/
+
+static void _scan_frame( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)user_ptr;
+  _frame_stats_t* stats_ptr        = &_stats_ptr[item_idx];
+  vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+  if ( !vol_geom_read_frame( _seq_filename, &_readers_ptr[thread_idx].info, item_idx, &frame_data ) ) {
+    stats_ptr->failed = true;
+    return;
+  }
+  stats_ptr->n_vertices = frame_data.vertices_sz / ( sizeof( float ) * 3 );
+  stats_ptr->texture_sz = frame_data.texture_sz;
+
+  // Frame data isn't guaranteed to be aligned for floats, so positions and indices are read with memcpy.
+  const uint8_t* vertices_ptr = &frame_data.block_data_ptr[frame_data.vertices_offset];
+  float mn[3]                 = { INFINITY, INFINITY, INFINITY }, mx[3] = { -INFINITY, -INFINITY, -INFINITY };
+  for ( uint32_t v = 0; v < stats_ptr->n_vertices; v++ ) {
+    float p[3];
+    memcpy( p, &vertices_ptr[v * sizeof( p )], sizeof( p ) );
+    if ( !isfinite( p[0] ) || !isfinite( p[1] ) || !isfinite( p[2] ) ) {
+      stats_ptr->n_non_finite++;
+      continue;
+    }
+    for ( int c = 0; c < 3; c++ ) {
+      mn[c] = p[c] < mn[c] ? p[c] : mn[c];
+      mx[c] = p[c] > mx[c] ? p[c] : mx[c];
+    }
+  }
+  stats_ptr->has_aabb = stats_ptr->n_vertices > stats_ptr->n_non_finite;
+  memcpy( stats_ptr->aabb_min, mn, sizeof( mn ) );
+  memcpy( stats_ptr->aabb_max, mx, sizeof( mx ) );
+
+  // Keyframes of 65535 or more vertices have 32-bit indices, others 16-bit.
+  if ( frame_data.indices_sz > 0 ) {
+    uint32_t index_sz      = stats_ptr->n_vertices >= 65535 ? sizeof( uint32_t ) : sizeof( uint16_t );
+    const uint8_t* src_ptr = &frame_data.block_data_ptr[frame_data.indices_offset];
+    stats_ptr->n_indices   = frame_data.indices_sz / index_sz;
+    for ( uint32_t i = 0; i < stats_ptr->n_indices; i++ ) {
+      uint32_t index = 0;
+      if ( sizeof( uint16_t ) == index_sz ) {
+        uint16_t index16;
+        memcpy( &index16, &src_ptr[i * sizeof( uint16_t )], sizeof( uint16_t ) );
+        index = index16;
+      } else {
+        memcpy( &index, &src_ptr[i * sizeof( uint32_t )], sizeof( uint32_t ) );
+      }
+      if ( index >= stats_ptr->n_vertices ) { stats_ptr->n_bad_indices++; }
+    }
+  }
+}
+
+/** Set up one reader per thread, sharing `_geom_info`'s directory. @returns False if out of memory. */
+static bool _create_readers( uint32_t n_threads ) {
+  _readers_ptr = calloc( n_threads, sizeof( _reader_t ) );
+  if ( !_readers_ptr ) { return false; }
+  // Compressed chunks are read into the end of the chunk scratch, after the room to decode them, so it needs room for the biggest stored chunk too.
+  size_t chunk_scratch_sz = 0;
+  if ( _geom_info.chunk_scratch_ptr ) {
+    uint32_t biggest_stored_sz = 0;
+    for ( uint32_t i = 0; i < _geom_info.hdr.frame_count; i++ ) {
+      uint32_t sz       = _geom_info.playback_entries_ptr[i].stored_sz;
+      biggest_stored_sz = sz > biggest_stored_sz ? sz : biggest_stored_sz;
+    }
+    chunk_scratch_sz = (size_t)_geom_info.biggest_frame_blob_sz + biggest_stored_sz;
+  }
+  for ( uint32_t t = 0; t < n_threads; t++ ) {
+    _readers_ptr[t].info                             = _geom_info;
+    _readers_ptr[t].info.preallocated_frame_blob_ptr = malloc( (size_t)_geom_info.biggest_frame_blob_sz );
+    _readers_ptr[t].info.chunk_scratch_ptr           = chunk_scratch_sz ? malloc( chunk_scratch_sz ) : NULL;
+    if ( !_readers_ptr[t].info.preallocated_frame_blob_ptr || ( chunk_scratch_sz && !_readers_ptr[t].info.chunk_scratch_ptr ) ) { return false; }
+  }
+  return true;
+}
+
+/** Free the readers' own memory only. The rest of each `vol_geom_info_t` belongs to `_geom_info`. */
+static void _free_readers( uint32_t n_threads ) {
+  for ( uint32_t t = 0; _readers_ptr && t < n_threads; t++ ) {
+    free( _readers_ptr[t].info.preallocated_frame_blob_ptr );
+    free( _readers_ptr[t].info.chunk_scratch_ptr );
+  }
+  free( _readers_ptr );
+  _readers_ptr = NULL;
+}
+
+/** Read every frame on `n_threads` threads, then fill in what depends on each frame's keyframe, and write the per-frame JSON and its summary.
+ * @returns False if any frame couldn't be read. The JSON is written either way, with the failed frames marked.
+ */
+static bool _write_frames_json( FILE* f_ptr, uint32_t n_threads, double* seconds_ptr ) {
+  uint32_t n_frames = _geom_info.hdr.frame_count;
+  double t0         = _time_s();
+  vol_thread_parallel_for( n_frames, n_threads, _scan_frame, NULL );
+  *seconds_ptr = _time_s() - t0;
+
+  uint32_t n_failed      = 0, n_mismatches = 0, key_n_vertices = 0, key_n_triangles = 0, vertices_min = UINT32_MAX, vertices_max = 0;
+  uint32_t triangles_min = UINT32_MAX, triangles_max = 0;
+  uint64_t vertices_sum  = 0, n_non_finite = 0, n_bad_indices = 0;
+  float mn[3]            = { INFINITY, INFINITY, INFINITY }, mx[3] = { -INFINITY, -INFINITY, -INFINITY };
+  bool have_key          = false, have_aabb = false;
+
+  fprintf( f_ptr, ",\n  \"frame_stats\": [" );
+  for ( uint32_t i = 0; i < n_frames; i++ ) {
+    _frame_stats_t* stats_ptr = &_stats_ptr[i];
+    const char* sep_str       = i > 0 ? "," : "";
+    if ( stats_ptr->failed ) {
+      n_failed++;
+      fprintf( f_ptr, "%s\n    { \"frame\": %u, \"error\": true }", sep_str, i );
+      continue;
+    }
+    if ( stats_ptr->n_indices > 0 ) {
+      have_key        = true;
+      key_n_vertices  = stats_ptr->n_vertices;
+      key_n_triangles = stats_ptr->n_indices / 3;
+    } else if ( have_key && stats_ptr->n_vertices != key_n_vertices ) {
+      stats_ptr->vertex_count_mismatch = true;
+      n_mismatches++;
+    }
+    stats_ptr->n_triangles = have_key ? key_n_triangles : 0;
+
+    vertices_sum += stats_ptr->n_vertices;
+    vertices_min  = stats_ptr->n_vertices < vertices_min ? stats_ptr->n_vertices : vertices_min;
+    vertices_max  = stats_ptr->n_vertices > vertices_max ? stats_ptr->n_vertices : vertices_max;
+    triangles_min = stats_ptr->n_triangles < triangles_min ? stats_ptr->n_triangles : triangles_min;
+    triangles_max = stats_ptr->n_triangles > triangles_max ? stats_ptr->n_triangles : triangles_max;
+    n_non_finite += stats_ptr->n_non_finite;
+    n_bad_indices += stats_ptr->n_bad_indices;
+
+    fprintf( f_ptr, "%s\n    { \"frame\": %u, \"keyframe\": %u, \"bytes\": %lld, ", sep_str, i, _geom_info.frame_headers_ptr[i].keyframe,
+      (long long)_geom_info.frames_directory_ptr[i].total_sz );
+    if ( _geom_info.playback_entries_ptr ) {
+      fprintf( f_ptr, "\"stored_bytes\": %u, \"codec\": \"%s\", ", _geom_info.playback_entries_ptr[i].stored_sz,
+        _codec_str( _geom_info.playback_entries_ptr[i].codec ) );
+    }
+    fprintf( f_ptr, "\"vertices\": %u, \"triangles\": %u, \"texture_bytes\": %u, ", stats_ptr->n_vertices, stats_ptr->n_triangles, stats_ptr->texture_sz );
+    if ( stats_ptr->has_aabb ) {
+      have_aabb = true;
+      for ( int c = 0; c < 3; c++ ) {
+        mn[c] = stats_ptr->aabb_min[c] < mn[c] ? stats_ptr->aabb_min[c] : mn[c];
+        mx[c] = stats_ptr->aabb_max[c] > mx[c] ? stats_ptr->aabb_max[c] : mx[c];
+      }
+      fprintf( f_ptr, "\"aabb_min\": " );
+      _write_json_floats( f_ptr, stats_ptr->aabb_min, 3 );
+      fprintf( f_ptr, ", \"aabb_max\": " );
+      _write_json_floats( f_ptr, stats_ptr->aabb_max, 3 );
+    } else {
+      fprintf( f_ptr, "\"aabb_min\": null, \"aabb_max\": null" );
+    }
+    fprintf( f_ptr, ", \"non_finite_vertices\": %u, \"bad_indices\": %u, \"vertex_count_mismatch\": %s }", stats_ptr->n_non_finite,
+      stats_ptr->n_bad_indices, stats_ptr->vertex_count_mismatch ? "true" : "false" );
+  }
+  fprintf( f_ptr, "%s],\n", n_frames ? "\n  " : "" );
+
+  uint32_t n_read = n_frames - n_failed;
+  fprintf( f_ptr, "  \"frame_summary\": {\n    \"frames_read\": %u,\n    \"unreadable_frames\": %u,\n", n_read, n_failed );
+  fprintf( f_ptr, "    \"vertices_min\": %u,\n    \"vertices_max\": %u,\n    \"vertices_mean\": %.1f,\n", n_read ? vertices_min : 0, vertices_max,
+    n_read ? (double)vertices_sum / n_read : 0.0 );
+  fprintf( f_ptr, "    \"triangles_min\": %u,\n    \"triangles_max\": %u,\n", n_read ? triangles_min : 0, triangles_max );
+  if ( have_aabb ) {
+    fprintf( f_ptr, "    \"aabb_min\": " );
+    _write_json_floats( f_ptr, mn, 3 );
+    fprintf( f_ptr, ",\n    \"aabb_max\": " );
+    _write_json_floats( f_ptr, mx, 3 );
+    fprintf( f_ptr, ",\n" );
+  } else {
+    fprintf( f_ptr, "    \"aabb_min\": null,\n    \"aabb_max\": null,\n" );
+  }
+  fprintf( f_ptr, "    \"non_finite_vertices\": %llu,\n    \"bad_indices\": %llu,\n    \"vertex_count_mismatches\": %u\n  }",
+    (unsigned long long)n_non_finite, (unsigned long long)n_bad_indices, n_mismatches );
+  return 0 == n_failed;
+}
+
+int main( int argc, char** argv ) {
+  const char* combined_filename = NULL;
+  const char* header_filename   = NULL;
+  const char* sequence_filename = NULL;
+  const char* output_filename   = NULL;
+  uint32_t n_threads            = 0;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf(
+      "Usage for single-file volograms:\n"
+      "%s [OPTIONS] -c MYFILE.VOLS\n\n"
+      "Usage for multi-file volograms:\n"
+      "%s [OPTIONS] -h HEADER.VOLS -s SEQUENCE.VOLS\n\n",
+      argv[0], argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_HEADER] ) { header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_filename = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( _option_arg_indices[CL_THREADS] ) { n_threads = (uint32_t)atoi( my_argv[_option_arg_indices[CL_THREADS] + 1] ); }
+  bool read_frames = _option_arg_indices[CL_FRAMES] > 0;
+  if ( !combined_filename && ( !header_filename || !sequence_filename ) ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --combined, or --header and --sequence, is missing. Run with --help for details.\n" );
+    return 1;
+  }
+
+  // vol_geom's info and debug messages go to stdout, which may be where the JSON is going. Warnings and errors go to stderr.
+  // Multi-file volograms are opened in streaming mode, so the sequence isn't read into memory unless `--frames` reads it.
+  vol_geom_set_log_level( VOL_GEOM_LOG_TYPE_WARNING );
+  double t_start = _time_s();
+  if ( combined_filename ) {
+    if ( !vol_geom_create_file_info_from_file( combined_filename, &_geom_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open combined vologram file=%s.\n", combined_filename );
+      return 1;
+    }
+  } else if ( !vol_geom_create_file_info( header_filename, sequence_filename, &_geom_info, true ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open geometry files header=%s sequence=%s.\n", header_filename, sequence_filename );
+    return 1;
+  }
+  double open_s = _time_s() - t_start;
+
+  bool success      = false;
+  bool frames_ok    = true;
+  double frames_s   = 0.0;
+  FILE* f_ptr       = NULL;
+  uint32_t n_frames = _geom_info.hdr.frame_count;
+  _seq_filename     = combined_filename ? combined_filename : sequence_filename;
+  n_threads         = n_threads > 0 ? n_threads : vol_thread_hardware_concurrency();
+  n_threads         = n_threads < VOL_THREAD_MAX_THREADS ? n_threads : VOL_THREAD_MAX_THREADS;
+  n_threads         = n_threads < n_frames ? n_threads : ( n_frames > 0 ? n_frames : 1 );
+
+  if ( read_frames && ( !( _stats_ptr = calloc( n_frames > 0 ? n_frames : 1, sizeof( _frame_stats_t ) ) ) || !_create_readers( n_threads ) ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory.\n" );
+    goto _main_end;
+  }
+  f_ptr = output_filename ? fopen( output_filename, "w" ) : stdout;
+  if ( !f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", output_filename );
+    goto _main_end;
+  }
+
+  fprintf( f_ptr, "{\n  \"tool\": \"volsinfo\",\n  \"tool_version\": \"0.1.0\",\n  \"input\": {\n" );
+  if ( combined_filename ) {
+    _write_json_str( f_ptr, "combined", combined_filename );
+  } else {
+    _write_json_str( f_ptr, "header", header_filename );
+    _write_json_str( f_ptr, "sequence", sequence_filename );
+  }
+  fprintf( f_ptr, "    \"open_s\": %.6f\n  },\n", open_s );
+  // For multi-file volograms this is the header and sequence files together.
+  int64_t file_sz = combined_filename ? _file_sz( combined_filename ) : _file_sz( header_filename ) + _file_sz( sequence_filename );
+  _write_header_json( f_ptr, file_sz, NULL != combined_filename );
+  _write_directory_json( f_ptr );
+  if ( read_frames ) {
+    frames_ok = _write_frames_json( f_ptr, n_threads, &frames_s );
+    fprintf( f_ptr, ",\n  \"frames_s\": %.6f,\n  \"threads\": %u", frames_s, n_threads );
+  }
+  fprintf( f_ptr, "\n}\n" );
+  if ( ferror( f_ptr ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Writing output. Check disk space and permissions.\n" );
+    goto _main_end;
+  }
+  if ( !frames_ok ) { _printlog( _LOG_TYPE_ERROR, "ERROR: Some frames could not be read. They are marked with \"error\" in the output.\n" ); }
+  success = frames_ok;
+
+_main_end:
+  if ( f_ptr && f_ptr != stdout && 0 != fclose( f_ptr ) ) { success = false; }
+  _free_readers( n_threads );
+  free( _stats_ptr );
+  vol_geom_free_file_info( &_geom_info );
+  return success ? 0 : 1;
+}
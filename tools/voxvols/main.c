@@ -0,0 +1,812 @@
+/** @file main.c
+ * Volograms occupancy grid tool.
+ *
+ * voxvols   | Voxelise every frame of a vologram into an occupancy grid, with volume and motion statistics.
+ * --------- | ----------------------------------------------------------------
+ * Version   | 0.1.0
+ * Authors   | Anton Gerdelan  <anton@volograms.com>
+ * Copyright | 2026, Volograms (http://volograms.com/)
+ * Language  | C99
+ * Files     | 1
+ * Licence   | The MIT License. See LICENSE.md for details.
+ *
+ * Analytics such as body volume, floor occupancy, and motion heatmaps work on voxels rather than triangles.
+ * This tool marks every voxel, of a chosen size, that any triangle of a frame touches, using an exact triangle-box overlap test.
+ * With `--solid` the voxels enclosed by the surface are marked too, by flood-filling the outside. Holes smaller than a voxel don't leak.
+ *
+ * Voxels are on one world-space grid, aligned to the origin, so grids of different frames line up: voxel (i, j, k) spans
+ * `i * size` to `( i + 1 ) * size` on X, and so on. Each frame's grid only covers that frame's bounding box, so it stays small however the vologram moves.
+ * v1.2 headers' translation, rotation, and scale are applied first.
+ *
+ * Frames are read from vol_geom in order, one at a time, into batches. The frames of a batch are voxelised in parallel,
+ * each on its own thread, then their grids are compared with the previous frame's to count voxels entered and left, also in parallel.
+ *
+ * Outputs
+ * -------
+ * Statistics are written as JSON, to stdout or the `--stats` file: for each frame its occupied voxels, their volume, the voxels entered and left
+ * since the previous frame, and its grid's origin and size, then a summary of the sequence.
+ *
+ * With `--output` the grids are written to a binary occupancy file, in little-endian order:
+ *
+ *     24-byte file header: char magic[4] = "VOCC", uint32 version = 1, float voxel_size, uint32 frame_count, uint32 flags (1 = solid), uint32 reserved.
+ *     Then for each frame, a 32-byte frame header: uint32 frame_idx, int32 origin[3], uint32 dims[3], uint32 n_bytes,
+ *     followed by `n_bytes` = `ceil( dims[0] * dims[1] * dims[2] / 8 )` bytes of bits. Voxel (x, y, z) of the frame's grid, which is world voxel
+ *     `origin + ( x, y, z )`, is bit `b % 8` of byte `b / 8`, where `b = x + dims[0] * ( y + dims[1] * z )`. Frames with no triangles have zero dims.
+ *
+ * Usage Instructions
+ * ------------------
+ *     ./voxvols.bin -c MYFILE.VOLS --voxel-size 0.02 --stats stats.json -o occupancy.bin
+ *     ./voxvols.bin -h HEADER.VOLS -s SEQUENCE.VOLS --solid
+ *
+ * Compilation
+ * ------------------
+ *
+ * `make voxvols`
+ *
+ * History
+ * -----------
+ * - 0.1.0   (2026/10/18) - First version.
+ */
+
+#include "vol_geom.h"   // Volograms' .vols file parsing library.
+#include "vol_mesh.h"   // Volograms' mesh processing library, for header transforms.
+#include "vol_thread.h" // Volograms' threading helpers.
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef _MSC_VER
+#define strcasecmp _stricmp
+#else
+#include <strings.h> // strcasecmp
+#endif               /* endif _MSC_VER. */
+
+#define VOX_DEFAULT_VOXEL_SZ 0.01f     // 1 cm.
+#define VOX_MAX_GRID_VOXELS ( 1u << 30 ) // Largest grid for one frame, which takes 128 MB of bits, or twice that with `--solid`.
+#define VOX_FRAMES_PER_THREAD 4          // Frames read into each batch, per thread, so that threads with quicker frames have more to do.
+#define VOX_FILE_VERSION 1               // Of the binary occupancy file.
+#define VOX_FLAG_SOLID 1                 // Set in the occupancy file's flags if interiors were filled.
+
+typedef enum _log_type { _LOG_TYPE_INFO = 0, _LOG_TYPE_DEBUG, _LOG_TYPE_WARNING, _LOG_TYPE_ERROR, _LOG_TYPE_SUCCESS } _log_type;
+
+/** Convience enum to index into the array of command-line flags by readable name. */
+typedef enum cl_flag_enum_t { CL_COMBINED, CL_HEADER, CL_HELP, CL_OUTPUT, CL_SEQUENCE, CL_SOLID, CL_STATS, CL_THREADS, CL_VOXEL_SIZE, CL_MAX } cl_flag_enum_t;
+
+/** Command-line flags. */
+typedef struct cl_flag_t {
+  const char* long_str;  // e.g. "--header"
+  const char* short_str; // e.g. "-h"
+  const char* help_str;  // e.g. "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n"
+  int n_required_args;   // Number of parameters following that are required.
+} cl_flag_t;
+
+/** A frame's occupancy grid: one bit per voxel of the box of voxels that the frame's triangles touch. */
+typedef struct _grid_t {
+  int32_t origin[3]; // World voxel coordinates of the grid's first voxel.
+  uint32_t dims[3];  // All 0 for a frame with no triangles.
+  /// Bit `b % 64` of word `b / 64` is voxel `b = x + dims[0] * ( y + dims[1] * z )`. There is a spare zero word at the end.
+  uint64_t* bits_ptr;
+  size_t n_words, words_capacity;
+} _grid_t;
+
+/** A frame in a batch, read on the main thread, voxelised on a worker thread. Buffers are kept and re-used by later batches. */
+typedef struct _slot_t {
+  uint32_t frame_idx;
+  bool is_keyframe;
+  float* vertices_ptr;
+  uint32_t n_vertices, vertices_capacity;
+  uint32_t* indices_ptr;
+  uint32_t n_indices, indices_capacity;
+  _grid_t grid;
+  uint32_t* stack_ptr; // For `--solid` flood fills.
+  size_t stack_capacity;
+  uint64_t n_occupied, n_entered, n_left;
+  bool too_big, failed;
+} _slot_t;
+
+/** Colour formatting of printfs for status messages. */
+static const char* STRC_DEFAULT = "\x1B[0m";
+static const char* STRC_RED     = "\x1B[31m";
+static const char* STRC_GREEN   = "\x1B[32m";
+static const char* STRC_YELLOW  = "\x1B[33m";
+
+/** All command line flags are specified here. Note that this order must correspond to the ordering in cl_flag_enum_t. */
+static cl_flag_t _cl_flags[CL_MAX] = {
+  { "--combined", "-c", "Required for single-file volograms. The next argument gives the path to your myfile.vols.\n", 1 },        // CL_COMBINED
+  { "--header", "-h", "Required for multi-file volograms. The next argument gives the path to the header.vols file.\n", 1 },       // CL_HEADER
+  { "--help", NULL, "Prints this text.\n", 0 },                                                                                    // CL_HELP
+  { "--output", "-o", "The next argument gives the path of a binary occupancy file to write the grids of every frame to.\n", 1 },  // CL_OUTPUT
+  { "--sequence", "-s", "Required for multi-file volograms. The next argument gives the path to the sequence_0.vols file.\n", 1 }, // CL_SEQUENCE
+  { "--solid", NULL, "Also mark the voxels inside each frame's surface, so that volumes are of the enclosed space, not of the surface.\n", 0 }, // CL_SOLID
+  { "--stats", "-j", "The next argument gives the path of the JSON statistics file to write. Default is to write JSON to stdout.\n", 1 },      // CL_STATS
+  { "--threads", "-t", "The next argument gives the number of threads to use. Default is one per logical processor.\n", 1 },      // CL_THREADS
+  { "--voxel-size", "-v", "The next argument gives the width of a voxel, in metres. Default is 0.01.\n", 1 }                      // CL_VOXEL_SIZE
+};
+
+/// Globals for parsing the command line arguments when in a function outside main().
+static int my_argc;
+static char** my_argv;
+/** If command-line options are valid, their index in argv is stored here, otherwise it is 0. */
+static int _option_arg_indices[CL_MAX];
+
+static vol_geom_info_t _geom_info;  // Mesh information from vol_geom library.
+static vol_mesh_transform_t _xform; // From the header, applied to every frame's vertices.
+static float _voxel_sz = VOX_DEFAULT_VOXEL_SZ;
+static bool _solid;
+
+static _slot_t* _slots_ptr;
+static uint32_t _n_slots;
+static _grid_t _prev_grid; // The previous batch's last frame's grid, for counting voxels entered and left by the next batch's first frame.
+static bool _have_prev_grid;
+static uint32_t* _key_indices_ptr; // The current keyframe's indices, as 32-bit.
+static uint32_t _n_key_indices, _key_indices_capacity;
+
+static void _printlog( _log_type log_type, const char* message_str, ... ) {
+  FILE* stream_ptr = stdout;
+  if ( _LOG_TYPE_ERROR == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_RED );
+  } else if ( _LOG_TYPE_WARNING == log_type ) {
+    stream_ptr = stderr;
+    fprintf( stderr, "%s", STRC_YELLOW );
+  } else if ( _LOG_TYPE_SUCCESS == log_type ) {
+    fprintf( stderr, "%s", STRC_GREEN );
+  }
+  va_list arg_ptr;
+  va_start( arg_ptr, message_str );
+  vfprintf( stream_ptr, message_str, arg_ptr );
+  va_end( arg_ptr );
+  fprintf( stream_ptr, "%s", STRC_DEFAULT );
+}
+
+/** Used to print all the options in the command line flags struct for the help text. */
+static void _print_cl_flags( void ) {
+  printf( "Options:\n" );
+  for ( int i = 0; i < CL_MAX; i++ ) {
+    if ( _cl_flags[i].long_str ) { printf( "%s", _cl_flags[i].long_str ); }
+    if ( _cl_flags[i].long_str && _cl_flags[i].short_str ) { printf( ", " ); }
+    if ( _cl_flags[i].short_str ) { printf( "%s", _cl_flags[i].short_str ); }
+    if ( _cl_flags[i].long_str || _cl_flags[i].short_str ) { printf( "\n" ); }
+    if ( _cl_flags[i].help_str ) { printf( "%s\n", _cl_flags[i].help_str ); }
+  }
+}
+
+static bool _check_cl_option( int argv_idx, const char* long_str, const char* short_str ) {
+  if ( long_str && ( 0 == strcasecmp( long_str, my_argv[argv_idx] ) ) ) { return true; }
+  if ( short_str && ( 0 == strcasecmp( short_str, my_argv[argv_idx] ) ) ) { return true; }
+  return false;
+}
+
+/** Loop over all the command line arguments and make sure they all have the right bits with them and there are not unknowns.
+ * Registers any valid params found, with their index in argv, in _option_arg_indices.
+ * @returns Returns false if anything is out of order, or an unrecognised flag is found.
+ */
+static bool _evaluate_params( int start_from_arg_idx ) {
+  for ( int argv_idx = start_from_arg_idx; argv_idx < my_argc; argv_idx++ ) {
+    bool found_valid_arg = false;
+    if ( '-' != my_argv[argv_idx][0] ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an invalid option. Perhaps a '-' is missing? Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+    for ( int clo_idx = 0; clo_idx < CL_MAX; clo_idx++ ) {
+      if ( !_check_cl_option( argv_idx, _cl_flags[clo_idx].long_str, _cl_flags[clo_idx].short_str ) ) { continue; }
+      for ( int following_idx = 1; following_idx < _cl_flags[clo_idx].n_required_args + 1; following_idx++ ) {
+        if ( argv_idx + _cl_flags[clo_idx].n_required_args >= my_argc || '-' == my_argv[argv_idx + following_idx][0] ) {
+          _printlog( _LOG_TYPE_WARNING, "Argument '%s' is not followed by a valid parameter. Run with --help for details.\n", my_argv[argv_idx] );
+          return false;
+        }
+      }
+      _option_arg_indices[clo_idx] = argv_idx;
+      argv_idx += _cl_flags[clo_idx].n_required_args;
+      found_valid_arg = true;
+      break;
+    } // endfor clo_idx
+    if ( !found_valid_arg ) {
+      _printlog( _LOG_TYPE_WARNING, "Argument '%s' is an unknown option. Run with --help for details.\n", my_argv[argv_idx] );
+      return false;
+    }
+  } // endfor argv_idx
+  return true;
+}
+
+/** @returns A monotonic time in seconds. */
+static double _time_s( void ) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency( &freq );
+  QueryPerformanceCounter( &count );
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+/** Helper to grow a working buffer, keeping it if it's already big enough. */
+static bool _reserve( void** ptr_ptr, size_t* capacity_ptr, size_t sz ) {
+  if ( sz <= *capacity_ptr ) { return true; }
+  void* ptr = realloc( *ptr_ptr, sz );
+  if ( !ptr ) { return false; }
+  *ptr_ptr      = ptr;
+  *capacity_ptr = sz;
+  return true;
+}
+
+static uint32_t _popcount64( uint64_t x ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return (uint32_t)__builtin_popcountll( x );
+#else
+  x = x - ( ( x >> 1 ) & 0x5555555555555555ull );
+  x = ( x & 0x3333333333333333ull ) + ( ( x >> 2 ) & 0x3333333333333333ull );
+  x = ( x + ( x >> 4 ) ) & 0x0F0F0F0F0F0F0F0Full;
+  return (uint32_t)( ( x * 0x0101010101010101ull ) >> 56 );
+#endif
+}
+
+/*************************************************************************************************************************************************
+ * Voxelisation
+ *************************************************************************************************************************************************/
+
+static bool _grid_get( const _grid_t* grid_ptr, size_t b ) { return 0 != ( grid_ptr->bits_ptr[b >> 6] & ( 1ull << ( b & 63 ) ) ); }
+
+static void _grid_set( _grid_t* grid_ptr, size_t b ) { grid_ptr->bits_ptr[b >> 6] |= 1ull << ( b & 63 ); }
+
+/** @returns 64 bits of a grid from bit `b` on. Reads the word after, so relies on the spare word at the end of the grid. */
+static uint64_t _grid_get64( const _grid_t* grid_ptr, size_t b ) {
+  uint64_t lo = grid_ptr->bits_ptr[b >> 6] >> ( b & 63 );
+  if ( 0 == ( b & 63 ) ) { return lo; }
+  return lo | grid_ptr->bits_ptr[( b >> 6 ) + 1] << ( 64 - ( b & 63 ) );
+}
+
+/** Size a grid to cover voxels [min_voxel, max_voxel], with all voxels clear.
+ * @returns False if the grid would be bigger than VOX_MAX_GRID_VOXELS, or out of memory.
+ */
+static bool _grid_resize( _grid_t* grid_ptr, const int64_t* min_voxel, const int64_t* max_voxel, bool* too_big_ptr ) {
+  uint64_t n_voxels = 1;
+  for ( int a = 0; a < 3; a++ ) {
+    int64_t dims = max_voxel[a] - min_voxel[a] + 1;
+    if ( min_voxel[a] < INT32_MIN || max_voxel[a] > INT32_MAX || dims > VOX_MAX_GRID_VOXELS ) { n_voxels = UINT64_MAX; }
+    if ( n_voxels != UINT64_MAX ) { n_voxels *= (uint64_t)dims; }
+    if ( n_voxels > VOX_MAX_GRID_VOXELS ) { n_voxels = UINT64_MAX; }
+    grid_ptr->origin[a] = (int32_t)min_voxel[a];
+    grid_ptr->dims[a]   = (uint32_t)dims;
+  }
+  if ( UINT64_MAX == n_voxels ) {
+    *too_big_ptr = true;
+    return false;
+  }
+  grid_ptr->n_words = (size_t)( ( n_voxels + 63 ) / 64 ) + 1;
+  size_t capacity   = grid_ptr->words_capacity * sizeof( uint64_t );
+  if ( !_reserve( (void**)&grid_ptr->bits_ptr, &capacity, grid_ptr->n_words * sizeof( uint64_t ) ) ) { return false; }
+  grid_ptr->words_capacity = capacity / sizeof( uint64_t );
+  memset( grid_ptr->bits_ptr, 0, grid_ptr->n_words * sizeof( uint64_t ) );
+  return true;
+}
+
+/** A triangle's separating axes, from Tomas Akenine-Möller's triangle-box overlap test, "Fast 3D Triangle-Box Overlap Testing", 2001.
+ * The terms that only depend on the triangle are worked out once, so testing each voxel against it is a few multiply-adds.
+ * A voxel overlaps the triangle if the projection of its centre onto every axis is inside that axis' range. The box axes are left to the caller,
+ * which only visits voxels inside the triangle's bounding box.
+ */
+typedef struct _tri_axes_t {
+  float n[3];           // The triangle's plane normal.
+  float n_lo, n_hi;     // Range of the plane axis.
+  float axis[9][2];     // Cross product of box axis `a = k % 3` with edge `k / 3`. Component `a` is 0, so only components `a + 1` and `a + 2` are kept.
+  float lo[9], hi[9];   // Range of each cross product axis.
+} _tri_axes_t;
+
+/**
+ * @param v  Triangle vertices.
+ * @param hs Half the box's width.
+ */
+static void _tri_axes_setup( const float v[3][3], float hs, _tri_axes_t* t_ptr ) {
+  const float e[3][3] = {
+    { v[1][0] - v[0][0], v[1][1] - v[0][1], v[1][2] - v[0][2] }, //
+    { v[2][0] - v[1][0], v[2][1] - v[1][1], v[2][2] - v[1][2] }, //
+    { v[0][0] - v[2][0], v[0][1] - v[2][1], v[0][2] - v[2][2] }  //
+  };
+  for ( int k = 0; k < 9; k++ ) {
+    int a = k % 3, b = ( a + 1 ) % 3, c = ( a + 2 ) % 3;
+    // Unit vector a x edge, which has -e[c] in component b, and e[b] in c.
+    float axis_b      = -e[k / 3][c], axis_c = e[k / 3][b];
+    float p0          = axis_b * v[0][b] + axis_c * v[0][c];
+    float p1          = axis_b * v[1][b] + axis_c * v[1][c];
+    float p2          = axis_b * v[2][b] + axis_c * v[2][c];
+    float r           = hs * ( fabsf( axis_b ) + fabsf( axis_c ) );
+    t_ptr->axis[k][0] = axis_b;
+    t_ptr->axis[k][1] = axis_c;
+    t_ptr->lo[k]      = fminf( p0, fminf( p1, p2 ) ) - r;
+    t_ptr->hi[k]      = fmaxf( p0, fmaxf( p1, p2 ) ) + r;
+  }
+  t_ptr->n[0] = e[0][1] * e[1][2] - e[0][2] * e[1][1];
+  t_ptr->n[1] = e[0][2] * e[1][0] - e[0][0] * e[1][2];
+  t_ptr->n[2] = e[0][0] * e[1][1] - e[0][1] * e[1][0];
+  float d     = t_ptr->n[0] * v[0][0] + t_ptr->n[1] * v[0][1] + t_ptr->n[2] * v[0][2];
+  float r     = hs * ( fabsf( t_ptr->n[0] ) + fabsf( t_ptr->n[1] ) + fabsf( t_ptr->n[2] ) );
+  t_ptr->n_lo = d - r;
+  t_ptr->n_hi = d + r;
+}
+
+/** @returns True if the box centred on `c` overlaps the triangle, given that it overlaps its bounding box. */
+static bool _tri_axes_overlap( const _tri_axes_t* t_ptr, const float c[3] ) {
+  float d = t_ptr->n[0] * c[0] + t_ptr->n[1] * c[1] + t_ptr->n[2] * c[2];
+  if ( d < t_ptr->n_lo || d > t_ptr->n_hi ) { return false; }
+  for ( int k = 0; k < 9; k++ ) {
+    int a   = k % 3;
+    float p = t_ptr->axis[k][0] * c[( a + 1 ) % 3] + t_ptr->axis[k][1] * c[( a + 2 ) % 3];
+    if ( p < t_ptr->lo[k] || p > t_ptr->hi[k] ) { return false; }
+  }
+  return true;
+}
+
+/** Mark every voxel outside the surface by flood-filling from the grid's corner, which the padding keeps outside, then mark everything else.
+ * A scanline fill: each seed fills the whole run of empty voxels along X that it's in, then seeds the runs next to that in the 4 neighbouring rows,
+ * so the stack holds a seed per run rather than per voxel.
+ */
+static bool _fill_interior( _slot_t* slot_ptr ) {
+  _grid_t* g_ptr  = &slot_ptr->grid;
+  const size_t sx = g_ptr->dims[0], sy = g_ptr->dims[1], sz = g_ptr->dims[2], sxy = sx * sy;
+  const size_t n  = sxy * sz;
+  // Outside voxels are marked in a second grid, after the surface grid's words.
+  size_t capacity = g_ptr->words_capacity * sizeof( uint64_t );
+  if ( !_reserve( (void**)&g_ptr->bits_ptr, &capacity, g_ptr->n_words * 2 * sizeof( uint64_t ) ) ) { return false; }
+  g_ptr->words_capacity = capacity / sizeof( uint64_t );
+  _grid_t outside       = *g_ptr;
+  outside.bits_ptr      = &g_ptr->bits_ptr[g_ptr->n_words];
+  memset( outside.bits_ptr, 0, g_ptr->n_words * sizeof( uint64_t ) );
+
+  size_t stack_sz = slot_ptr->stack_capacity * sizeof( uint32_t );
+  size_t n_stack  = 0;
+  if ( !_reserve( (void**)&slot_ptr->stack_ptr, &stack_sz, 1024 * sizeof( uint32_t ) ) ) { return false; }
+  slot_ptr->stack_capacity       = stack_sz / sizeof( uint32_t );
+  slot_ptr->stack_ptr[n_stack++] = 0;
+  while ( n_stack > 0 ) {
+    size_t b = slot_ptr->stack_ptr[--n_stack];
+    if ( _grid_get( &outside, b ) ) { continue; } // Filled from another seed since it was pushed.
+    size_t row = b - b % sx, x0 = b % sx, x1 = x0;
+    while ( x0 > 0 && !_grid_get( g_ptr, row + x0 - 1 ) && !_grid_get( &outside, row + x0 - 1 ) ) { x0--; }
+    while ( x1 + 1 < sx && !_grid_get( g_ptr, row + x1 + 1 ) && !_grid_get( &outside, row + x1 + 1 ) ) { x1++; }
+    for ( size_t x = x0; x <= x1; x++ ) { _grid_set( &outside, row + x ); }
+
+    size_t y = ( row / sx ) % sy, z = row / sxy;
+    size_t neighbour_rows[4];
+    int n_neighbours = 0;
+    if ( y > 0 ) { neighbour_rows[n_neighbours++] = row - sx; }
+    if ( y + 1 < sy ) { neighbour_rows[n_neighbours++] = row + sx; }
+    if ( z > 0 ) { neighbour_rows[n_neighbours++] = row - sxy; }
+    if ( z + 1 < sz ) { neighbour_rows[n_neighbours++] = row + sxy; }
+    // Up to one seed per run of empty voxels, alongside the filled run, in each neighbouring row. Grows by doubling.
+    size_t max_stack = n_stack + 4 * ( ( x1 - x0 ) / 2 + 1 );
+    if ( max_stack > slot_ptr->stack_capacity && !_reserve( (void**)&slot_ptr->stack_ptr, &stack_sz, max_stack * 2 * sizeof( uint32_t ) ) ) { return false; }
+    slot_ptr->stack_capacity = stack_sz / sizeof( uint32_t );
+    for ( int i = 0; i < n_neighbours; i++ ) {
+      bool in_run = false;
+      for ( size_t x = x0; x <= x1; x++ ) {
+        bool is_empty = !_grid_get( g_ptr, neighbour_rows[i] + x ) && !_grid_get( &outside, neighbour_rows[i] + x );
+        if ( is_empty && !in_run ) { slot_ptr->stack_ptr[n_stack++] = (uint32_t)( neighbour_rows[i] + x ); }
+        in_run = is_empty;
+      }
+    }
+  }
+  // Occupied is everything not outside. Bits past the last voxel stay clear.
+  for ( size_t w = 0; w < n / 64; w++ ) { g_ptr->bits_ptr[w] = ~outside.bits_ptr[w]; }
+  if ( n % 64 ) { g_ptr->bits_ptr[n / 64] = ~outside.bits_ptr[n / 64] & ( ( 1ull << ( n % 64 ) ) - 1 ); }
+  return true;
+}
+
+static void _voxelise_slot( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  (void)user_ptr;
+  _slot_t* slot_ptr     = &_slots_ptr[item_idx];
+  _grid_t* g_ptr        = &slot_ptr->grid;
+  const float* v_ptr    = slot_ptr->vertices_ptr;
+  const uint32_t n_tris = slot_ptr->n_indices / 3;
+  const float inv_sz    = 1.0f / _voxel_sz;
+  slot_ptr->n_occupied  = 0;
+
+  // Bounds of the vertices that triangles use, in voxels.
+  float lo[3] = { INFINITY, INFINITY, INFINITY }, hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+  for ( uint32_t i = 0; i < n_tris * 3; i++ ) {
+    if ( slot_ptr->indices_ptr[i] >= slot_ptr->n_vertices ) {
+      slot_ptr->failed = true;
+      return;
+    }
+    const float* p = &v_ptr[slot_ptr->indices_ptr[i] * 3];
+    for ( int a = 0; a < 3; a++ ) {
+      lo[a] = p[a] < lo[a] ? p[a] : lo[a];
+      hi[a] = p[a] > hi[a] ? p[a] : hi[a];
+    }
+  }
+  if ( 0 == n_tris ) {
+    *g_ptr = ( _grid_t ){ .bits_ptr = g_ptr->bits_ptr, .words_capacity = g_ptr->words_capacity };
+    return;
+  }
+  int64_t min_voxel[3], max_voxel[3];
+  for ( int a = 0; a < 3; a++ ) {
+    if ( !isfinite( lo[a] ) || !isfinite( hi[a] ) || fabsf( lo[a] * inv_sz ) > (float)INT32_MAX || fabsf( hi[a] * inv_sz ) > (float)INT32_MAX ) {
+      slot_ptr->too_big = true;
+      return;
+    }
+    // With --solid a layer of empty voxels all round connects all of the outside, for the flood fill.
+    min_voxel[a] = (int64_t)floorf( lo[a] * inv_sz ) - ( _solid ? 1 : 0 );
+    max_voxel[a] = (int64_t)floorf( hi[a] * inv_sz ) + ( _solid ? 1 : 0 );
+  }
+  if ( !_grid_resize( g_ptr, min_voxel, max_voxel, &slot_ptr->too_big ) ) {
+    slot_ptr->failed = !slot_ptr->too_big;
+    return;
+  }
+
+  const size_t sx = g_ptr->dims[0], sxy = (size_t)g_ptr->dims[0] * g_ptr->dims[1];
+  for ( uint32_t t = 0; t < n_tris; t++ ) {
+    // Vertices in voxel units, relative to the grid's first voxel.
+    float tv[3][3];
+    int64_t t_lo[3], t_hi[3];
+    for ( int j = 0; j < 3; j++ ) {
+      const float* p = &v_ptr[slot_ptr->indices_ptr[t * 3 + j] * 3];
+      for ( int a = 0; a < 3; a++ ) { tv[j][a] = p[a] * inv_sz - (float)g_ptr->origin[a]; }
+    }
+    bool one_voxel = true;
+    for ( int a = 0; a < 3; a++ ) {
+      float t_min = fminf( tv[0][a], fminf( tv[1][a], tv[2][a] ) ), t_max = fmaxf( tv[0][a], fmaxf( tv[1][a], tv[2][a] ) );
+      t_lo[a]     = (int64_t)floorf( t_min );
+      t_hi[a]     = (int64_t)floorf( t_max );
+      t_lo[a]     = t_lo[a] < 0 ? 0 : ( t_lo[a] >= (int64_t)g_ptr->dims[a] ? (int64_t)g_ptr->dims[a] - 1 : t_lo[a] );
+      t_hi[a]     = t_hi[a] < 0 ? 0 : ( t_hi[a] >= (int64_t)g_ptr->dims[a] ? (int64_t)g_ptr->dims[a] - 1 : t_hi[a] );
+      one_voxel   = one_voxel && t_lo[a] == t_hi[a];
+    }
+    // Most triangles are smaller than a voxel, and inside one, which needs no test.
+    if ( one_voxel ) {
+      _grid_set( g_ptr, (size_t)t_lo[0] + sx * (size_t)t_lo[1] + sxy * (size_t)t_lo[2] );
+      continue;
+    }
+    // A little over half a voxel, so that rounding can't drop voxels that a triangle only just touches.
+    _tri_axes_t axes;
+    _tri_axes_setup( (const float( * )[3])tv, 0.5f + 1e-4f, &axes );
+    for ( int64_t z = t_lo[2]; z <= t_hi[2]; z++ ) {
+      for ( int64_t y = t_lo[1]; y <= t_hi[1]; y++ ) {
+        int64_t x_lo = t_lo[0], x_hi = t_hi[0];
+        float c[3]   = { 0.0f, (float)y + 0.5f, (float)z + 0.5f };
+        // Along a row, only voxels near where the row crosses the triangle's plane can overlap. Rounded out, as each voxel is tested fully below.
+        if ( fabsf( axes.n[0] ) > 1e-12f ) {
+          float rest  = axes.n[1] * c[1] + axes.n[2] * c[2];
+          float x0    = ( axes.n_lo - rest ) / axes.n[0] - 0.5f, x1 = ( axes.n_hi - rest ) / axes.n[0] - 0.5f;
+          float x_min = fminf( x0, x1 ), x_max = fmaxf( x0, x1 );
+          if ( x_max < (float)x_lo || x_min > (float)x_hi ) { continue; }
+          x_lo = x_min > (float)x_lo ? (int64_t)floorf( x_min ) : x_lo;
+          x_hi = x_max < (float)x_hi ? (int64_t)ceilf( x_max ) : x_hi;
+        }
+        size_t row = sx * (size_t)y + sxy * (size_t)z;
+        for ( int64_t x = x_lo; x <= x_hi; x++ ) {
+          if ( _grid_get( g_ptr, row + (size_t)x ) ) { continue; }
+          c[0] = (float)x + 0.5f;
+          if ( _tri_axes_overlap( &axes, c ) ) { _grid_set( g_ptr, row + (size_t)x ); }
+        }
+      }
+    }
+  }
+
+  if ( _solid && !_fill_interior( slot_ptr ) ) {
+    slot_ptr->failed = true;
+    return;
+  }
+  for ( size_t w = 0; w < g_ptr->n_words; w++ ) { slot_ptr->n_occupied += _popcount64( g_ptr->bits_ptr[w] ); }
+}
+
+/** @returns The number of voxels occupied in both grids, by comparing the rows of the box where they overlap 64 voxels at a time. */
+static uint64_t _count_common( const _grid_t* a_ptr, const _grid_t* b_ptr ) {
+  int64_t lo[3], hi[3];
+  for ( int i = 0; i < 3; i++ ) {
+    lo[i] = a_ptr->origin[i] > b_ptr->origin[i] ? a_ptr->origin[i] : b_ptr->origin[i];
+    hi[i] = (int64_t)a_ptr->origin[i] + a_ptr->dims[i] < (int64_t)b_ptr->origin[i] + b_ptr->dims[i] ? (int64_t)a_ptr->origin[i] + a_ptr->dims[i] :
+                                                                                                    (int64_t)b_ptr->origin[i] + b_ptr->dims[i];
+    if ( hi[i] <= lo[i] ) { return 0; }
+  }
+  uint64_t n = 0;
+  for ( int64_t z = lo[2]; z < hi[2]; z++ ) {
+    for ( int64_t y = lo[1]; y < hi[1]; y++ ) {
+      size_t a_row = (size_t)( ( z - a_ptr->origin[2] ) * a_ptr->dims[1] + ( y - a_ptr->origin[1] ) ) * a_ptr->dims[0] + (size_t)( lo[0] - a_ptr->origin[0] );
+      size_t b_row = (size_t)( ( z - b_ptr->origin[2] ) * b_ptr->dims[1] + ( y - b_ptr->origin[1] ) ) * b_ptr->dims[0] + (size_t)( lo[0] - b_ptr->origin[0] );
+      for ( int64_t x = 0; x < hi[0] - lo[0]; x += 64 ) {
+        uint64_t both = _grid_get64( a_ptr, a_row + (size_t)x ) & _grid_get64( b_ptr, b_row + (size_t)x );
+        if ( hi[0] - lo[0] - x < 64 ) { both &= ( 1ull << ( hi[0] - lo[0] - x ) ) - 1; }
+        n += _popcount64( both );
+      }
+    }
+  }
+  return n;
+}
+
+static void _compare_slot( uint32_t item_idx, uint32_t thread_idx, void* user_ptr ) {
+  (void)thread_idx;
+  (void)user_ptr;
+  _slot_t* slot_ptr = &_slots_ptr[item_idx];
+  if ( 0 == item_idx && !_have_prev_grid ) { // The first frame has no previous frame to compare with.
+    slot_ptr->n_entered = slot_ptr->n_left = 0;
+    return;
+  }
+  const _grid_t* prev_ptr  = 0 == item_idx ? &_prev_grid : &_slots_ptr[item_idx - 1].grid;
+  uint64_t n_prev_occupied = 0 == item_idx ? 0 : _slots_ptr[item_idx - 1].n_occupied;
+  if ( 0 == item_idx ) {
+    for ( size_t w = 0; w < _prev_grid.n_words; w++ ) { n_prev_occupied += _popcount64( _prev_grid.bits_ptr[w] ); }
+  }
+  uint64_t n_common   = _count_common( prev_ptr, &slot_ptr->grid );
+  slot_ptr->n_entered = slot_ptr->n_occupied - n_common;
+  slot_ptr->n_left    = n_prev_occupied - n_common;
+}
+
+/*************************************************************************************************************************************************
+ * Reading and writing
+ *************************************************************************************************************************************************/
+
+/** Read a frame into a slot, with its keyframe's indices, transformed by the header. */
+static bool _read_slot( const char* filename, uint32_t frame_idx, _slot_t* slot_ptr ) {
+  vol_geom_frame_data_t frame_data = ( vol_geom_frame_data_t ){ .block_data_sz = 0 };
+  if ( !vol_geom_read_frame( filename, &_geom_info, frame_idx, &frame_data ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Reading geometry frame %u.\n", frame_idx );
+    return false;
+  }
+  uint32_t n_vertices = frame_data.vertices_sz / ( sizeof( float ) * 3 );
+  // Keyframes, including "last tracked frame" (2) keyframes, start a new topology.
+  slot_ptr->is_keyframe = frame_data.indices_sz > 0;
+  if ( slot_ptr->is_keyframe ) {
+    vol_mesh_index_type_t index_type = vol_mesh_index_type( n_vertices );
+    uint32_t n_indices               = frame_data.indices_sz / vol_mesh_index_sz( index_type );
+    size_t capacity                  = (size_t)_key_indices_capacity * sizeof( uint32_t );
+    if ( !_reserve( (void**)&_key_indices_ptr, &capacity, (size_t)n_indices * sizeof( uint32_t ) ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory at frame %u.\n", frame_idx );
+      return false;
+    }
+    _key_indices_capacity  = (uint32_t)( capacity / sizeof( uint32_t ) );
+    const uint8_t* src_ptr = &frame_data.block_data_ptr[frame_data.indices_offset];
+    // Indices aren't guaranteed to be aligned in the frame data either, so are read with memcpy.
+    for ( uint32_t i = 0; i < n_indices; i++ ) {
+      if ( VOL_MESH_INDEX_TYPE_U16 == index_type ) {
+        uint16_t index;
+        memcpy( &index, &src_ptr[i * sizeof( uint16_t )], sizeof( uint16_t ) );
+        _key_indices_ptr[i] = index;
+      } else {
+        memcpy( &_key_indices_ptr[i], &src_ptr[i * sizeof( uint32_t )], sizeof( uint32_t ) );
+      }
+    }
+    _n_key_indices = n_indices - n_indices % 3;
+  }
+
+  size_t vertices_capacity = (size_t)slot_ptr->vertices_capacity * sizeof( float ) * 3;
+  size_t indices_capacity  = (size_t)slot_ptr->indices_capacity * sizeof( uint32_t );
+  if ( !_reserve( (void**)&slot_ptr->vertices_ptr, &vertices_capacity, (size_t)n_vertices * sizeof( float ) * 3 ) ||
+       !_reserve( (void**)&slot_ptr->indices_ptr, &indices_capacity, (size_t)_n_key_indices * sizeof( uint32_t ) ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory at frame %u.\n", frame_idx );
+    return false;
+  }
+  slot_ptr->vertices_capacity = (uint32_t)( vertices_capacity / ( sizeof( float ) * 3 ) );
+  slot_ptr->indices_capacity  = (uint32_t)( indices_capacity / sizeof( uint32_t ) );
+  slot_ptr->frame_idx         = frame_idx;
+  slot_ptr->n_vertices        = n_vertices;
+  slot_ptr->n_indices         = _n_key_indices;
+  if ( n_vertices > 0 ) {
+    // Frame data isn't guaranteed to be aligned for floats, so copy it in before transforming it.
+    memcpy( slot_ptr->vertices_ptr, &frame_data.block_data_ptr[frame_data.vertices_offset], (size_t)n_vertices * sizeof( float ) * 3 );
+    if ( !vol_mesh_transform_is_identity( &_xform ) ) { vol_mesh_transform_vertices( &_xform, slot_ptr->vertices_ptr, slot_ptr->vertices_ptr, n_vertices ); }
+  }
+  if ( _n_key_indices > 0 ) { memcpy( slot_ptr->indices_ptr, _key_indices_ptr, (size_t)_n_key_indices * sizeof( uint32_t ) ); }
+  slot_ptr->too_big = slot_ptr->failed = false;
+  return true;
+}
+
+static bool _write_u32s( FILE* f_ptr, const uint32_t* values_ptr, size_t n ) { return n == fwrite( values_ptr, sizeof( uint32_t ), n, f_ptr ); }
+
+static bool _write_grid( FILE* f_ptr, const _slot_t* slot_ptr ) {
+  const _grid_t* g_ptr = &slot_ptr->grid;
+  uint64_t n_voxels    = (uint64_t)g_ptr->dims[0] * g_ptr->dims[1] * g_ptr->dims[2];
+  uint32_t n_bytes     = (uint32_t)( ( n_voxels + 7 ) / 8 );
+  uint32_t frame_hdr[8];
+  frame_hdr[0] = slot_ptr->frame_idx;
+  memcpy( &frame_hdr[1], g_ptr->origin, sizeof( g_ptr->origin ) );
+  memcpy( &frame_hdr[4], g_ptr->dims, sizeof( g_ptr->dims ) );
+  frame_hdr[7] = n_bytes;
+  if ( !_write_u32s( f_ptr, frame_hdr, 8 ) ) { return false; }
+  // The words are little-endian on every platform vol_geom supports, so their bytes are in the file's bit order.
+  return 0 == n_bytes || 1 == fwrite( g_ptr->bits_ptr, n_bytes, 1, f_ptr );
+}
+
+static void _write_json_str( FILE* f_ptr, const char* key_str, const char* value_str ) {
+  fprintf( f_ptr, "    \"%s\": \"", key_str );
+  for ( const char* c = value_str; *c; c++ ) {
+    if ( '"' == *c || '\\' == *c ) { fputc( '\\', f_ptr ); }
+    fputc( *c, f_ptr );
+  }
+  fprintf( f_ptr, "\",\n" );
+}
+
+static void _write_frame_json( FILE* f_ptr, const _slot_t* slot_ptr ) {
+  const _grid_t* g_ptr = &slot_ptr->grid;
+  double voxel_volume  = (double)_voxel_sz * _voxel_sz * _voxel_sz;
+  fprintf( f_ptr,
+    "%s\n    { \"frame\": %u, \"keyframe\": %s, \"triangles\": %u, \"occupied\": %llu, \"volume_m3\": %.6f, \"entered\": %llu, \"left\": %llu, "
+    "\"grid_origin\": [%i, %i, %i], \"grid_dims\": [%u, %u, %u] }",
+    slot_ptr->frame_idx > 0 ? "," : "", slot_ptr->frame_idx, slot_ptr->is_keyframe ? "true" : "false", slot_ptr->n_indices / 3,
+    (unsigned long long)slot_ptr->n_occupied, slot_ptr->n_occupied * voxel_volume, (unsigned long long)slot_ptr->n_entered,
+    (unsigned long long)slot_ptr->n_left, g_ptr->origin[0], g_ptr->origin[1], g_ptr->origin[2], g_ptr->dims[0], g_ptr->dims[1], g_ptr->dims[2] );
+}
+
+static void _free_slots( void ) {
+  for ( uint32_t i = 0; _slots_ptr && i < _n_slots; i++ ) {
+    free( _slots_ptr[i].vertices_ptr );
+    free( _slots_ptr[i].indices_ptr );
+    free( _slots_ptr[i].grid.bits_ptr );
+    free( _slots_ptr[i].stack_ptr );
+  }
+  free( _slots_ptr );
+  free( _prev_grid.bits_ptr );
+  free( _key_indices_ptr );
+}
+
+int main( int argc, char** argv ) {
+  const char* combined_filename = NULL;
+  const char* header_filename   = NULL;
+  const char* sequence_filename = NULL;
+  const char* output_filename   = NULL;
+  const char* stats_filename    = NULL;
+  uint32_t n_threads            = 0;
+
+  my_argc = argc;
+  my_argv = argv;
+  if ( !_evaluate_params( 1 ) ) { return 1; }
+  if ( argc < 2 || _option_arg_indices[CL_HELP] ) {
+    printf(
+      "Usage for single-file volograms:\n"
+      "%s [OPTIONS] -c MYFILE.VOLS\n\n"
+      "Usage for multi-file volograms:\n"
+      "%s [OPTIONS] -h HEADER.VOLS -s SEQUENCE.VOLS\n\n",
+      argv[0], argv[0] );
+    _print_cl_flags();
+    return 0;
+  }
+  if ( _option_arg_indices[CL_COMBINED] ) { combined_filename = my_argv[_option_arg_indices[CL_COMBINED] + 1]; }
+  if ( _option_arg_indices[CL_HEADER] ) { header_filename = my_argv[_option_arg_indices[CL_HEADER] + 1]; }
+  if ( _option_arg_indices[CL_SEQUENCE] ) { sequence_filename = my_argv[_option_arg_indices[CL_SEQUENCE] + 1]; }
+  if ( _option_arg_indices[CL_OUTPUT] ) { output_filename = my_argv[_option_arg_indices[CL_OUTPUT] + 1]; }
+  if ( _option_arg_indices[CL_STATS] ) { stats_filename = my_argv[_option_arg_indices[CL_STATS] + 1]; }
+  if ( _option_arg_indices[CL_THREADS] ) { n_threads = (uint32_t)atoi( my_argv[_option_arg_indices[CL_THREADS] + 1] ); }
+  if ( _option_arg_indices[CL_VOXEL_SIZE] ) { _voxel_sz = (float)atof( my_argv[_option_arg_indices[CL_VOXEL_SIZE] + 1] ); }
+  _solid = _option_arg_indices[CL_SOLID] > 0;
+  if ( !combined_filename && ( !header_filename || !sequence_filename ) ) {
+    _printlog( _LOG_TYPE_WARNING, "Required argument --combined, or --header and --sequence, is missing. Run with --help for details.\n" );
+    return 1;
+  }
+  if ( !( _voxel_sz > 0.0f ) || !isfinite( _voxel_sz ) ) {
+    _printlog( _LOG_TYPE_WARNING, "--voxel-size must be a positive number of metres, e.g. 0.01.\n" );
+    return 1;
+  }
+
+  // vol_geom's info and debug messages go to stdout, which may be where the JSON is going. Warnings and errors go to stderr.
+  vol_geom_set_log_level( VOL_GEOM_LOG_TYPE_WARNING );
+  if ( combined_filename ) {
+    if ( !vol_geom_create_file_info_from_file( combined_filename, &_geom_info ) ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open combined vologram file=%s.\n", combined_filename );
+      return 1;
+    }
+  } else if ( !vol_geom_create_file_info( header_filename, sequence_filename, &_geom_info, true ) ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Failed to open geometry files header=%s sequence=%s.\n", header_filename, sequence_filename );
+    return 1;
+  }
+
+  bool success          = false;
+  const char* filename  = combined_filename ? combined_filename : sequence_filename;
+  FILE* out_f_ptr       = NULL;
+  FILE* stats_f_ptr     = NULL;
+  uint32_t n_frames     = _geom_info.hdr.frame_count;
+  uint64_t occupied_sum = 0, occupied_min = UINT64_MAX, occupied_max = 0, changed_sum = 0;
+  double voxelise_s     = 0.0;
+  double t_start        = _time_s();
+
+  _xform     = vol_mesh_transform_from_hdr( &_geom_info.hdr, false );
+  n_threads  = n_threads > 0 ? n_threads : vol_thread_hardware_concurrency();
+  n_threads  = n_threads < VOL_THREAD_MAX_THREADS ? n_threads : VOL_THREAD_MAX_THREADS;
+  _n_slots   = n_threads * VOX_FRAMES_PER_THREAD;
+  _slots_ptr = calloc( _n_slots, sizeof( _slot_t ) );
+  if ( !_slots_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Out of memory.\n" );
+    goto _main_end;
+  }
+
+  if ( output_filename ) {
+    out_f_ptr = fopen( output_filename, "wb" );
+    if ( !out_f_ptr ) {
+      _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", output_filename );
+      goto _main_end;
+    }
+    uint32_t file_hdr[6] = { 0, VOX_FILE_VERSION, 0, n_frames, _solid ? VOX_FLAG_SOLID : 0, 0 };
+    memcpy( &file_hdr[0], "VOCC", 4 );
+    memcpy( &file_hdr[2], &_voxel_sz, sizeof( float ) );
+    if ( !_write_u32s( out_f_ptr, file_hdr, 6 ) ) { goto _main_write_fail; }
+  }
+  stats_f_ptr = stats_filename ? fopen( stats_filename, "w" ) : stdout;
+  if ( !stats_f_ptr ) {
+    _printlog( _LOG_TYPE_ERROR, "ERROR: Opening file for writing `%s`\n", stats_filename );
+    goto _main_end;
+  }
+  fprintf( stats_f_ptr, "{\n  \"tool\": \"voxvols\",\n  \"tool_version\": \"0.1.0\",\n  \"input\": {\n" );
+  if ( combined_filename ) {
+    _write_json_str( stats_f_ptr, "combined", combined_filename );
+  } else {
+    _write_json_str( stats_f_ptr, "header", header_filename );
+    _write_json_str( stats_f_ptr, "sequence", sequence_filename );
+  }
+  fprintf( stats_f_ptr, "    \"version\": %u,\n    \"frame_count\": %u\n  },\n", _geom_info.hdr.version, n_frames );
+  fprintf( stats_f_ptr, "  \"voxel_size\": %g,\n  \"solid\": %s,\n  \"frames\": [", _voxel_sz, _solid ? "true" : "false" );
+
+  for ( uint32_t first = 0; first < n_frames; first += _n_slots ) {
+    uint32_t n_batch = n_frames - first < _n_slots ? n_frames - first : _n_slots;
+    for ( uint32_t i = 0; i < n_batch; i++ ) {
+      if ( !_read_slot( filename, first + i, &_slots_ptr[i] ) ) { goto _main_end; }
+    }
+    double t0 = _time_s();
+    vol_thread_parallel_for( n_batch, n_threads, _voxelise_slot, NULL );
+    for ( uint32_t i = 0; i < n_batch; i++ ) {
+      if ( _slots_ptr[i].too_big ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Frame %u needs more than %u voxels. Use a larger --voxel-size.\n", first + i, VOX_MAX_GRID_VOXELS );
+        goto _main_end;
+      }
+      if ( _slots_ptr[i].failed ) {
+        _printlog( _LOG_TYPE_ERROR, "ERROR: Voxelising frame %u. Check for out-of-range indices, or out of memory.\n", first + i );
+        goto _main_end;
+      }
+    }
+    vol_thread_parallel_for( n_batch, n_threads, _compare_slot, NULL );
+    voxelise_s += _time_s() - t0;
+
+    for ( uint32_t i = 0; i < n_batch; i++ ) {
+      const _slot_t* slot_ptr = &_slots_ptr[i];
+      if ( out_f_ptr && !_write_grid( out_f_ptr, slot_ptr ) ) { goto _main_write_fail; }
+      _write_frame_json( stats_f_ptr, slot_ptr );
+      occupied_sum += slot_ptr->n_occupied;
+      occupied_min = slot_ptr->n_occupied < occupied_min ? slot_ptr->n_occupied : occupied_min;
+      occupied_max = slot_ptr->n_occupied > occupied_max ? slot_ptr->n_occupied : occupied_max;
+      changed_sum += slot_ptr->n_entered + slot_ptr->n_left;
+    }
+    // Keep the batch's last grid to compare the next batch's first frame with, by swapping buffers rather than copying.
+    _grid_t tmp                  = _prev_grid;
+    _prev_grid                   = _slots_ptr[n_batch - 1].grid;
+    _slots_ptr[n_batch - 1].grid = tmp;
+    _have_prev_grid              = true;
+  }
+
+  double total_s      = _time_s() - t_start;
+  double voxel_volume = (double)_voxel_sz * _voxel_sz * _voxel_sz;
+  fprintf( stats_f_ptr, "\n  ],\n  \"summary\": {\n    \"frames\": %u,\n", n_frames );
+  if ( n_frames > 0 ) {
+    fprintf( stats_f_ptr, "    \"occupied_mean\": %.1f,\n    \"occupied_min\": %llu,\n    \"occupied_max\": %llu,\n    \"volume_m3_mean\": %.6f,\n",
+      (double)occupied_sum / n_frames, (unsigned long long)occupied_min, (unsigned long long)occupied_max, (double)occupied_sum / n_frames * voxel_volume );
+    fprintf( stats_f_ptr, "    \"changed_mean\": %.1f,\n", n_frames > 1 ? (double)changed_sum / ( n_frames - 1 ) : 0.0 );
+  }
+  fprintf( stats_f_ptr, "    \"seconds\": %.3f,\n    \"frames_per_s\": %.1f\n  }\n}\n", total_s, total_s > 0.0 ? n_frames / total_s : 0.0 );
+  if ( ferror( stats_f_ptr ) ) { goto _main_write_fail; }
+  success = true;
+  goto _main_end;
+
+_main_write_fail:
+  _printlog( _LOG_TYPE_ERROR, "ERROR: Writing output. Check disk space and permissions.\n" );
+_main_end:
+  if ( out_f_ptr && 0 != fclose( out_f_ptr ) ) { success = false; }
+  if ( stats_f_ptr && stats_f_ptr != stdout && 0 != fclose( stats_f_ptr ) ) { success = false; }
+  vol_geom_free_file_info( &_geom_info );
+  _free_slots();
+  if ( !success ) { return 1; }
+
+  // Status goes to stderr when the statistics are on stdout, to keep them valid JSON.
+  fprintf( stats_filename ? stdout : stderr,"Voxelised %u frames in %.3f s (%.1f frames/s, %.1f frames/s excluding file I/O).\n", n_frames, total_s,
+    total_s > 0.0 ? n_frames / total_s : 0.0, voxelise_s > 0.0 ? n_frames / voxelise_s : 0.0 );
+  return 0;
+}